@@ -66,15 +66,43 @@
 # define MIC_ARRAY_CONFIG_USE_DDR         ((MIC_ARRAY_CONFIG_MIC_COUNT)==2)
 #endif
 
+#ifndef MIC_ARRAY_CONFIG_DECIMATOR
+# define MIC_ARRAY_CONFIG_DECIMATOR       (MIC_ARRAY_DECIMATOR_TWO_STAGE)
+#endif
+
+#ifndef MIC_ARRAY_CONFIG_USE_PDM_THREAD
+# define MIC_ARRAY_CONFIG_USE_PDM_THREAD  (0)
+#endif
+
+#ifndef MIC_ARRAY_CONFIG_STATE_ATTRIBUTES
+# define MIC_ARRAY_CONFIG_STATE_ATTRIBUTES
+#endif
+
+#ifndef MIC_ARRAY_CONFIG_MIC_IN_COUNT
+# define MIC_ARRAY_CONFIG_MIC_IN_COUNT    (mic_array::PdmCaptureChannels<     \
+                                              MIC_ARRAY_CONFIG_MIC_COUNT>::value)
+#endif
+
 ////// Additional macros derived from others
 
 #define MIC_ARRAY_CONFIG_MCLK_DIVIDER     ((MIC_ARRAY_CONFIG_MCLK_FREQ)       \
                                               /(MIC_ARRAY_CONFIG_PDM_FREQ))
-#define MIC_ARRAY_CONFIG_OUT_SAMPLE_RATE    ((MIC_ARRAY_CONFIG_PDM_FREQ)      \
-                                              /(STAGE2_DEC_FACTOR))
+#if ((MIC_ARRAY_CONFIG_DECIMATOR) == (MIC_ARRAY_DECIMATOR_ONE_STAGE_192))
+# define MIC_ARRAY_CONFIG_OUT_SAMPLE_RATE   ((MIC_ARRAY_CONFIG_PDM_FREQ)      \
+                                              /(16))
+#else
+# define MIC_ARRAY_CONFIG_OUT_SAMPLE_RATE   ((MIC_ARRAY_CONFIG_PDM_FREQ)      \
+                                              /(STAGE1_DEC_FACTOR             \
+                                                * STAGE2_DEC_FACTOR))
+#endif
 
 ////// Any Additional correctness checks
 
+#if ((MIC_ARRAY_CONFIG_DECIMATOR) != (MIC_ARRAY_DECIMATOR_TWO_STAGE)) \
+    && ((MIC_ARRAY_CONFIG_DECIMATOR) != (MIC_ARRAY_DECIMATOR_ONE_STAGE_192))
+# error MIC_ARRAY_CONFIG_DECIMATOR must be MIC_ARRAY_DECIMATOR_TWO_STAGE or MIC_ARRAY_DECIMATOR_ONE_STAGE_192.
+#endif
+
 
 
 ////// Allocate needed objects
@@ -96,11 +124,21 @@ pdm_rx_resources_t pdm_res = PDM_RX_RESOURCES_DDR(
 
 
 
+#if ((MIC_ARRAY_CONFIG_DECIMATOR) == (MIC_ARRAY_DECIMATOR_ONE_STAGE_192))
+using TMicArray = mic_array::prefab::Basic192MicArray<
+                        MIC_ARRAY_CONFIG_MIC_COUNT,
+                        MIC_ARRAY_CONFIG_SAMPLES_PER_FRAME,
+                        MIC_ARRAY_CONFIG_USE_DC_ELIMINATION,
+                        MIC_ARRAY_CONFIG_MIC_IN_COUNT>;
+#else
 using TMicArray = mic_array::prefab::BasicMicArray<
                         MIC_ARRAY_CONFIG_MIC_COUNT,
                         MIC_ARRAY_CONFIG_SAMPLES_PER_FRAME,
-                        MIC_ARRAY_CONFIG_USE_DC_ELIMINATION>;
+                        MIC_ARRAY_CONFIG_USE_DC_ELIMINATION,
+                        MIC_ARRAY_CONFIG_MIC_IN_COUNT>;
+#endif
 
+MIC_ARRAY_CONFIG_STATE_ATTRIBUTES
 TMicArray mics;
 
 
@@ -108,8 +146,11 @@ void ma_vanilla_init()
 {
   mics.Init();
   mics.SetPort(pdm_res.p_pdm_mics);
+#if (MIC_ARRAY_CONFIG_USE_PDM_THREAD)
+  mics.PdmRx.DeinterleaveInThread(true);
+#endif
   mic_array_resources_configure(&pdm_res, MIC_ARRAY_CONFIG_MCLK_DIVIDER);
-  mic_array_pdm_clock_start(&pdm_res);
+  mic_array_pdm_clock_start(&pdm_res, MIC_ARRAY_CONFIG_MCLK_DIVIDER);
 }
 
 
@@ -118,8 +159,18 @@ void ma_vanilla_task(
 {
   mics.SetOutputChannel(c_frames_out);
 
+#if (!(MIC_ARRAY_CONFIG_USE_PDM_THREAD))
   mics.InstallPdmRxISR();
   mics.UnmaskPdmRxISR();
+#endif
 
   mics.ThreadEntry();
-}
\ No newline at end of file
+}
+
+
+#if (MIC_ARRAY_CONFIG_USE_PDM_THREAD)
+void ma_vanilla_pdm_rx_task()
+{
+  mics.PdmRxThreadEntry();
+}
+#endif
@@ -5,6 +5,26 @@
 
 #include "mic_array.h"
 
+/**
+ * @brief Value of `MIC_ARRAY_CONFIG_DECIMATOR` selecting the two stage
+ *        decimator. (Vanilla API only)
+ * 
+ * The mic array unit is a @ref mic_array::prefab::BasicMicArray, with an
+ * output sample rate of `MIC_ARRAY_CONFIG_PDM_FREQ / 192` (16 kHz with a
+ * 3.072 MHz PDM clock). This is the default.
+ */
+#define MIC_ARRAY_DECIMATOR_TWO_STAGE       (0)
+
+/**
+ * @brief Value of `MIC_ARRAY_CONFIG_DECIMATOR` selecting the one stage 
+ *        192 kHz decimator. (Vanilla API only)
+ * 
+ * The mic array unit is a @ref mic_array::prefab::Basic192MicArray, with an
+ * output sample rate of `MIC_ARRAY_CONFIG_PDM_FREQ / 16` (192 kHz with a
+ * 3.072 MHz PDM clock).
+ */
+#define MIC_ARRAY_DECIMATOR_ONE_STAGE_192   (1)
+
 
 C_API_START
 
@@ -28,7 +48,10 @@ void ma_vanilla_init();
  * @brief Entry point for decimator thread and PDM rx. (Vanilla API only)
  * 
  * This function sets up and activates the PDM rx service in ISR mode, and then
- * immediately begins executing the decimator.
+ * immediately begins executing the decimator. If 
+ * `MIC_ARRAY_CONFIG_USE_PDM_THREAD` is `1`, no ISR is installed, and
+ * `ma_vanilla_pdm_rx_task()` must instead be run on another thread of the same
+ * tile.
  * 
  * After calling this the real-time condition is active, meaning there must be
  * another thread waiting to pull frames from the other end of `c_frames_out`
@@ -40,5 +63,20 @@ void ma_vanilla_init();
 MA_C_API
 void ma_vanilla_task(chanend_t c_frames_out);
 
+
+/**
+ * @brief Entry point for the PDM rx thread. (Vanilla API only)
+ * 
+ * Only available if `MIC_ARRAY_CONFIG_USE_PDM_THREAD` is `1`. Runs the PDM rx
+ * service, which also deinterleaves each block of PDM data for the decimator
+ * (see @ref mic_array::StandardPdmRxService::DeinterleaveInThread()). It must
+ * be run on its own thread, on the same tile as `ma_vanilla_task()`, after
+ * `ma_vanilla_init()` has been called.
+ * 
+ * @note This call does not return.
+ */
+MA_C_API
+void ma_vanilla_pdm_rx_task();
+
     
 C_API_END
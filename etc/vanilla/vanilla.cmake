@@ -26,4 +26,17 @@ function( mic_array_vanilla_add
   target_compile_definitions( ${TARGET_NAME}
       PRIVATE MIC_ARRAY_CONFIG_SAMPLES_PER_FRAME=${SAMPLES_PER_FRAME} )
 
+  # Optional: DECIMATOR <TWO_STAGE|ONE_STAGE_192> and USE_PDM_THREAD
+  cmake_parse_arguments( VANILLA "USE_PDM_THREAD" "DECIMATOR" "" ${ARGN} )
+
+  if( DEFINED VANILLA_DECIMATOR )
+    target_compile_definitions( ${TARGET_NAME}
+        PRIVATE MIC_ARRAY_CONFIG_DECIMATOR=MIC_ARRAY_DECIMATOR_${VANILLA_DECIMATOR} )
+  endif()
+
+  if( VANILLA_USE_PDM_THREAD )
+    target_compile_definitions( ${TARGET_NAME}
+        PRIVATE MIC_ARRAY_CONFIG_USE_PDM_THREAD=1 )
+  endif()
+
 endfunction()
\ No newline at end of file
@@ -6,7 +6,7 @@
 #include <type_traits>
 
 #include "mic_array.h"
-#include "app_decimator.hpp"
+#include "app_config.h"
 #include "mic_array/etc/filters_default.h"
 
 // This has caused problems previously, so just catch the problems here.
@@ -15,16 +15,17 @@
 #endif
 
 /**
- * A copy of Prefab with TwoStageDecimator replaced with a custom MyTwoStageDecimator.
- * This implementation provides support for > 8 mics by using multiple cores to
- * perform the decimation process.
+ * A copy of Prefab with TwoStageDecimator replaced with
+ * ParallelTwoStageDecimator. This provides support for > 8 mics by using
+ * NUM_DECIMATOR_SUBTASKS cores to perform the decimation process.
  */
 namespace par_mic_array {
   template <unsigned MIC_COUNT, unsigned FRAME_SIZE, bool USE_DCOE, unsigned MICS_IN=MIC_COUNT>
   class ParMicArray
       : public mic_array::MicArray<MIC_COUNT,
-                        MyTwoStageDecimator<MIC_COUNT, STAGE2_DEC_FACTOR,
-                                  STAGE2_TAP_COUNT>,
+                        mic_array::ParallelTwoStageDecimator<MIC_COUNT,
+                                  STAGE2_DEC_FACTOR, STAGE2_TAP_COUNT,
+                                  NUM_DECIMATOR_SUBTASKS>,
                         mic_array::StandardPdmRxService<MICS_IN,MIC_COUNT,STAGE2_DEC_FACTOR>,
                         // std::conditional uses USE_DCOE to determine which
                         // sample filter is used.
@@ -41,8 +42,9 @@ namespace par_mic_array {
        * template inherits.
        */
       using TParent = mic_array::MicArray<MIC_COUNT,
-                                MyTwoStageDecimator<MIC_COUNT, STAGE2_DEC_FACTOR,
-                                          STAGE2_TAP_COUNT>,
+                                mic_array::ParallelTwoStageDecimator<MIC_COUNT,
+                                          STAGE2_DEC_FACTOR, STAGE2_TAP_COUNT,
+                                          NUM_DECIMATOR_SUBTASKS>,
                                 mic_array::StandardPdmRxService<MICS_IN,MIC_COUNT,STAGE2_DEC_FACTOR>,
                                 typename std::conditional<USE_DCOE,
                                           mic_array::DcoeSampleFilter<MIC_COUNT>,
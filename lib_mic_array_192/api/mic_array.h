@@ -8,15 +8,28 @@
 #include "mic_array/pdm_resources.h"
 #include "mic_array/dc_elimination.h"
 #include "mic_array/frame_transfer.h"
+#include "mic_array/instance.h"
 #include "mic_array/setup.h"
 
 #ifdef __cplusplus
+# include "mic_array/cpp/ClockGovernor.hpp"
 # include "mic_array/cpp/Decimator.hpp"
 # include "mic_array/cpp/Decimator192.hpp"
+# include "mic_array/cpp/DecimatorCic.hpp"
+# include "mic_array/cpp/DecimatorMultiRate.hpp"
+# include "mic_array/cpp/DecimatorParallel.hpp"
+# include "mic_array/cpp/DecimatorPassthrough.hpp"
+# include "mic_array/cpp/DecimatorPipelined.hpp"
+# include "mic_array/cpp/Instance.hpp"
 # include "mic_array/cpp/MicArray.hpp"
+# include "mic_array/cpp/Mips.hpp"
 # include "mic_array/cpp/OutputHandler.hpp"
+# include "mic_array/cpp/OutputScaler.hpp"
+# include "mic_array/cpp/PdmHistory.hpp"
 # include "mic_array/cpp/PdmRx.hpp"
+# include "mic_array/cpp/PdmTap.hpp"
 # include "mic_array/cpp/Prefab.hpp"
 # include "mic_array/cpp/SampleFilter.hpp"
+# include "mic_array/cpp/Stage2Filter.hpp"
 #endif
 
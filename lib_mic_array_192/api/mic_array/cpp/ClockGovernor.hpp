@@ -0,0 +1,173 @@
+// Copyright 2022-2024 XMOS LIMITED.
+// This Software is subject to the terms of the XMOS Public Licence: Version 1.
+
+#pragma once
+
+#include <cstdint>
+
+#include "PdmRx.hpp"
+
+/**
+ * Default value of @ref mic_array::ClockGovernor::MaxDivide.
+ */
+#ifndef MIC_ARRAY_CONFIG_GOVERNOR_MAX_DIVIDE
+# define MIC_ARRAY_CONFIG_GOVERNOR_MAX_DIVIDE   (4)
+#endif
+
+/**
+ * Default value of @ref mic_array::ClockGovernor::TargetLoad, in percent.
+ */
+#ifndef MIC_ARRAY_CONFIG_GOVERNOR_TARGET_LOAD
+# define MIC_ARRAY_CONFIG_GOVERNOR_TARGET_LOAD  (75)
+#endif
+
+
+namespace  mic_array {
+
+  /**
+   * @brief Chooses a tile clock divider from the decimation thread's slack.
+   *
+   * The decimation thread is idle for whatever part of each block period it
+   * does not need, which @ref StandardPdmRxService::GetSlack() measures. When
+   * that slack is large, the tile can run on a divided clock instead (see
+   * `mic_array_tile_clock_divide()`), giving the idle cycles back as power.
+   *
+   * The busiest block of the latest slack window, scaled by the current
+   * divider, estimates the undivided work per block. @ref Update() picks the
+   * largest divider, up to @ref MaxDivide, for which that work fills no more
+   * than @ref TargetLoad percent of the block period. The divider is raised
+   * one step at a time, and lowered straight to the chosen value, so the mic
+   * array backs off quickly if its load rises; a window without any idle
+   * time at all returns the clock to full speed. After each change, the
+   * governor waits for two complete windows, so that it only acts on slack
+   * measured at the new clock rate.
+   *
+   * The governor does not touch the hardware itself. Typically a thread
+   * other than the decimation thread calls @ref Update() every few windows
+   * and applies any change:
+   *
+   * @code{.cpp}
+   *  const PdmRxStats stats = mics.PdmRx.GetStats();
+   *  if(governor.Update(mics.PdmRx.GetSlack(), stats.blocks))
+   *    mic_array_tile_clock_divide(governor.Divide());
+   * @endcode
+   *
+   * The divided clock slows every thread on the tile, so this is only
+   * appropriate on a tile whose other threads can tolerate it.
+   */
+  class ClockGovernor
+  {
+    public:
+
+      /**
+       * @brief Largest divider chosen.
+       *
+       * Defaults to @ref MIC_ARRAY_CONFIG_GOVERNOR_MAX_DIVIDE.
+       */
+      unsigned MaxDivide = MIC_ARRAY_CONFIG_GOVERNOR_MAX_DIVIDE;
+
+      /**
+       * @brief Largest fraction of the block period, in percent, the
+       *        decimation thread may be busy for at the chosen divider.
+       *
+       * Defaults to @ref MIC_ARRAY_CONFIG_GOVERNOR_TARGET_LOAD.
+       */
+      unsigned TargetLoad = MIC_ARRAY_CONFIG_GOVERNOR_TARGET_LOAD;
+
+    private:
+
+      /**
+       * Current divider.
+       */
+      unsigned divide = 1;
+
+      /**
+       * Block count when the divider last changed.
+       */
+      unsigned change_blocks = 0;
+
+    public:
+
+      constexpr ClockGovernor() noexcept { }
+
+      /**
+       * @brief Re-evaluate the divider.
+       *
+       * Nothing changes if no slack window has completed yet, or if fewer
+       * than two windows of @ref MIC_ARRAY_SLACK_WINDOW_BLOCKS blocks have
+       * passed since the last change.
+       *
+       * @param slack   Current slack of the decimation thread.
+       * @param blocks  Number of blocks received so far (see
+       *                @ref PdmRxStats::blocks).
+       *
+       * @returns `true` if @ref Divide() has changed.
+       */
+      bool Update(
+          const PdmRxSlack& slack,
+          unsigned blocks);
+
+      /**
+       * @brief Get the current divider.
+       *
+       * `1` until @ref Update() first changes it.
+       */
+      unsigned Divide() const;
+  };
+
+}
+
+//////////////////////////////////////////////
+// Template function implementations below. //
+//////////////////////////////////////////////
+
+
+inline
+bool mic_array::ClockGovernor::Update(
+    const PdmRxSlack& slack,
+    unsigned blocks)
+{
+  if(slack.recent_min_idle == UINT32_MAX || slack.block_period == 0)
+    return false;
+
+  if(blocks - this->change_blocks < 2 * MIC_ARRAY_SLACK_WINDOW_BLOCKS)
+    return false;
+
+  unsigned target = 1;
+
+  // Without any idle time the thread's real load is unknown, so the clock
+  // goes straight back to full speed.
+  if(slack.recent_min_idle != 0 && slack.recent_min_idle < slack.block_period){
+    const uint32_t busy = slack.block_period - slack.recent_min_idle;
+
+    // Busy time per block at the undivided clock, times 100.
+    const uint64_t work = (100ULL * busy + this->divide - 1) / this->divide;
+    const uint64_t budget = (uint64_t) slack.block_period * this->TargetLoad;
+
+    target = (unsigned) (budget / work);
+    if(target > this->MaxDivide) target = this->MaxDivide;
+    if(target < 1) target = 1;
+  } else if(slack.recent_min_idle >= slack.block_period) {
+    target = this->MaxDivide;
+  }
+
+  unsigned next = this->divide;
+  if(target > this->divide)
+    next = this->divide + 1;
+  else if(target < this->divide)
+    next = target;
+
+  if(next == this->divide)
+    return false;
+
+  this->divide = next;
+  this->change_blocks = blocks;
+  return true;
+}
+
+
+inline
+unsigned mic_array::ClockGovernor::Divide() const
+{
+  return this->divide;
+}
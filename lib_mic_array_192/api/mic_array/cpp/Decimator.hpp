@@ -3,21 +3,78 @@
 
 #pragma once
 
+#include <atomic>
 #include <cstdint>
 #include <string>
 #include <cassert>
+#include <cstring>
+#include <type_traits>
 
 #include "xmath/xmath.h"
 #include "mic_array/etc/fir_1x16_bit.h"
+#include "mic_array/etc/filters_default.h"
+#include "PdmHistory.hpp"
+#include "Stage2Filter.hpp"
+#include "OutputScaler.hpp"
+#include "SampleFilter.hpp"
+#include "Profiler.hpp"
+#include "Mips.hpp"
 
 // This has caused problems previously, so just catch the problems here.
-#if defined(MIC_COUNT) || defined(S2_DEC_FACTOR) || defined(S2_TAP_COUNT)
-# error Application must not define the following as precompiler macros: MIC_COUNT, S2_DEC_FACTOR, S2_TAP_COUNT.
+#if defined(MIC_COUNT) || defined(S2_DEC_FACTOR) || defined(S2_TAP_COUNT) \
+    || defined(S2_COEF_BITS) || defined(TS2Coef)
+# error Application must not define the following as precompiler macros: MIC_COUNT, S2_DEC_FACTOR, S2_TAP_COUNT, S2_COEF_BITS, TS2Coef.
 #endif
 
 
 namespace  mic_array {
 
+/**
+ * @brief Number of output samples a decimator produces per PDM block.
+ * 
+ * Most decimators (e.g. @ref TwoStageDecimator) produce exactly one
+ * (multi-channel) output sample for each block of PDM data they are given.
+ * A decimator which produces more than one sample per block (e.g. 
+ * @ref OneStageDecimator192) advertises this with a
+ * `static constexpr unsigned SamplesPerBlock` member.
+ * 
+ * `value` is `TDecimator::SamplesPerBlock` if that member exists, and `1`
+ * otherwise.
+ * 
+ * @tparam TDecimator Decimator type.
+ */
+template <class TDecimator, class = void>
+struct DecimatorSamplesPerBlock 
+    : std::integral_constant<unsigned, 1> { };
+
+template <class TDecimator>
+struct DecimatorSamplesPerBlock<TDecimator, 
+                                decltype((void) TDecimator::SamplesPerBlock)>
+    : std::integral_constant<unsigned, TDecimator::SamplesPerBlock> { };
+
+/**
+ * @brief Output of a decimator for a full scale PDM signal.
+ * 
+ * The magnitude of the samples a decimator outputs, with its default filters
+ * and output shift, for a PDM signal of all ones or all zeros. A decimator
+ * advertises this with a `static constexpr int32_t FullScale` member, e.g.
+ * @ref TwoStageDecimator::FullScale. This gives the normalisation of
+ * @ref FrameFormatF32 which maps a full scale signal to `+/-1.0`.
+ * 
+ * `value` is `TDecimator::FullScale` if that member exists, and `INT32_MAX`
+ * otherwise, i.e. samples are taken to be Q1.31.
+ * 
+ * @tparam TDecimator Decimator type.
+ */
+template <class TDecimator, class = void>
+struct DecimatorFullScale 
+    : std::integral_constant<int32_t, INT32_MAX> { };
+
+template <class TDecimator>
+struct DecimatorFullScale<TDecimator, 
+                          decltype((void) TDecimator::FullScale)>
+    : std::integral_constant<int32_t, TDecimator::FullScale> { };
+
 /**
  * @brief Rotate 8-word buffer 1 word up.
  * 
@@ -29,6 +86,244 @@ static inline
 void shift_buffer(uint32_t* buff);
 
 
+/**
+ * @brief OutputHandler which discards its samples.
+ * 
+ * The default `TStage1Output` of @ref TwoStageDecimator, for when no stage 1
+ * output is wanted. Calls to `NopOutputHandler::OutputSample()` are intended
+ * to be optimized out at compile time.
+ * 
+ * @tparam MIC_COUNT  Number of audio channels in each sample.
+ */
+template <unsigned MIC_COUNT>
+class NopOutputHandler
+{
+  public:
+    /**
+     * @brief Do nothing.
+     */
+    void OutputSample(int32_t sample[MIC_COUNT]) {};
+};
+
+
+/**
+ * @brief `COEF_BITS` value which selects the table-driven stage 1 kernel.
+ * 
+ * With this value, @ref Fir1xNBit uses `fir_1x16_bit_lut()`, and the stage 1
+ * "coefficients" are a table of `FIR_1X16_BIT_LUT_WORDS` words built from the
+ * real coefficients by `fir_1x16_bit_lut_init()` (or `python/stage1_lut.py`).
+ * The output is identical to that of the kernel the table was built for.
+ */
+constexpr unsigned STAGE1_LUT = 0;
+
+/**
+ * @brief The 1-bit FIR kernels for stage 1 coefficients of `COEF_BITS` bits.
+ * 
+ * Specialized for 16 (`fir_1x16_bit()`), 12 (`fir_1x12_bit()`) and 8
+ * (`fir_1x8_bit()`) bit coefficients. Each issues one `VLMACCR1` per
+ * coefficient bit, so `COEF_BITS` is the stage 1 filter's MIPS knob. All
+ * three return results on the same scale.
+ * 
+ * Also specialized for @ref STAGE1_LUT (`fir_1x16_bit_lut()`), whose cost
+ * does not depend on the coefficient precision.
+ * 
+ * @tparam COEF_BITS  Bits per stage 1 filter coefficient.
+ */
+template <unsigned COEF_BITS>
+struct Fir1xNBit;
+
+template <>
+struct Fir1xNBit<16> {
+  /** Number of words in a 256-tap coefficient table. */
+  static constexpr unsigned CoefWords = 128;
+  static inline int Filter(uint32_t* signal, const uint32_t* coef)
+    { return fir_1x16_bit(signal, coef); }
+  static inline void FilterMulti(const uint32_t* signal, const uint32_t* coef,
+                                 int32_t* out, unsigned count, unsigned stride)
+    { fir_1x16_bit_multi(signal, coef, out, count, stride); }
+};
+
+template <>
+struct Fir1xNBit<12> {
+  /** Number of words in a 256-tap coefficient table. */
+  static constexpr unsigned CoefWords = 96;
+  static inline int Filter(uint32_t* signal, const uint32_t* coef)
+    { return fir_1x12_bit(signal, coef); }
+  static inline void FilterMulti(const uint32_t* signal, const uint32_t* coef,
+                                 int32_t* out, unsigned count, unsigned stride)
+    { fir_1x12_bit_multi(signal, coef, out, count, stride); }
+};
+
+template <>
+struct Fir1xNBit<8> {
+  /** Number of words in a 256-tap coefficient table. */
+  static constexpr unsigned CoefWords = 64;
+  static inline int Filter(uint32_t* signal, const uint32_t* coef)
+    { return fir_1x8_bit(signal, coef); }
+  static inline void FilterMulti(const uint32_t* signal, const uint32_t* coef,
+                                 int32_t* out, unsigned count, unsigned stride)
+    { fir_1x8_bit_multi(signal, coef, out, count, stride); }
+};
+
+template <>
+struct Fir1xNBit<STAGE1_LUT> {
+  /** Number of words in a stage 1 look-up table. */
+  static constexpr unsigned CoefWords = FIR_1X16_BIT_LUT_WORDS;
+  static inline int Filter(uint32_t* signal, const uint32_t* coef)
+    { return fir_1x16_bit_lut(signal, coef); }
+  static inline void FilterMulti(const uint32_t* signal, const uint32_t* coef,
+                                 int32_t* out, unsigned count, unsigned stride)
+    { fir_1x16_bit_lut_multi(signal, coef, out, count, stride); }
+};
+
+
+/**
+ * @brief Apply the same 1-bit FIR to several channels' PDM histories.
+ * 
+ * `out[k]` receives the result of filtering the 8 words at
+ * `&signal[k * stride]` with `coef`. If `CHANNELS` is at least
+ * `FIR_1X16_BIT_MULTI_MIN_CHANNELS` the channels are filtered in batches with
+ * `fir_1x16_bit_multi()`, otherwise with one call to `fir_1x16_bit()` per
+ * channel (or their 12 and 8-bit counterparts, see @ref Fir1xNBit).
+ * 
+ * @tparam CHANNELS   Number of channels.
+ * @tparam COEF_BITS  Bits per filter coefficient.
+ * 
+ * @param out     Output, one filter result per channel.
+ * @param signal  PDM history window of the first channel.
+ * @param stride  Distance in words between consecutive channels' windows.
+ * @param coef    Filter coefficients.
+ */
+template <unsigned CHANNELS, unsigned COEF_BITS = 16>
+static inline 
+void fir_1x16_bit_channels(
+    int32_t out[CHANNELS],
+    uint32_t* signal,
+    const unsigned stride,
+    const uint32_t* coef);
+
+
+/**
+ * @brief Apply the same 1-bit FIR to a run-time number of channels.
+ * 
+ * As `fir_1x16_bit_channels()`, but with the number of channels given at run
+ * time, for decimators in which only some of the channels are active.
+ * 
+ * @tparam COEF_BITS  Bits per filter coefficient.
+ * 
+ * @param out       Output, one filter result per channel.
+ * @param signal    PDM history window of the first channel.
+ * @param stride    Distance in words between consecutive channels' windows.
+ * @param coef      Filter coefficients.
+ * @param channels  Number of channels.
+ */
+template <unsigned COEF_BITS = 16>
+static inline 
+void fir_1x16_bit_channels_n(
+    int32_t* out,
+    uint32_t* signal,
+    const unsigned stride,
+    const uint32_t* coef,
+    const unsigned channels);
+
+
+/**
+ * @brief Hand-off of new filter coefficients to a running decimator.
+ * 
+ * `Init()` must not be called on a decimator while another thread is
+ * running it: the decimation thread may filter a block with a mix of old and
+ * new coefficients. Instead, another thread on the same tile (e.g. the one
+ * handling a control interface) posts the new coefficients with
+ * @ref Request(), and the decimator picks them up with @ref Take() between
+ * blocks, when no filter is being evaluated. The decimator's own state
+ * (PDM and stage 2 histories) is kept, so the output does not restart.
+ * 
+ * Only one request can be outstanding: @ref Request() fails until the
+ * decimator has taken the previous one. It is the decimator which applies
+ * the optional crossfade, over `fade_samples` output samples, during which
+ * it evaluates both the old and new filters; see 
+ * @ref TwoStageDecimator::SwapCoefficients().
+ */
+template <class TS2Coef = int32_t>
+class CoefficientSwap
+{
+  private:
+
+    const uint32_t* volatile s1_coef = nullptr;
+    const TS2Coef* volatile s2_coef = nullptr;
+    volatile right_shift_t s2_shr = 0;
+    volatile unsigned fade_samples = 0;
+    volatile bool pending = false;
+
+  public:
+
+    /**
+     * @brief Post new coefficients to the decimator.
+     * 
+     * The coefficient tables are not copied here, and must stay valid until
+     * @ref Pending() returns `false` (stage 2 coefficients) or for as long as
+     * they are in use (stage 1 coefficients, which the decimator only points
+     * to).
+     * 
+     * @param s1_coef       New stage 1 coefficients, or `nullptr` to keep
+     *                      the current ones.
+     * @param s2_coef       New stage 2 coefficients, or `nullptr` to keep
+     *                      the current ones.
+     * @param s2_shr        New stage 2 output right-shift. Ignored if 
+     *                      `s2_coef` is `nullptr`.
+     * @param fade_samples  Number of output samples to crossfade over, or
+     *                      `0` to switch at once.
+     * 
+     * @returns `false`, and nothing is posted, if the previous request has
+     *          not yet been taken.
+     */
+    bool Request(
+        const uint32_t* s1_coef,
+        const TS2Coef* s2_coef,
+        const right_shift_t s2_shr,
+        const unsigned fade_samples);
+
+    /**
+     * @brief Whether a request has been posted and not yet taken.
+     */
+    bool Pending() const;
+
+    /**
+     * @brief Take the posted request, if any.
+     * 
+     * Called by the decimator, between blocks.
+     * 
+     * @returns `false`, and the outputs are untouched, if there is no
+     *          request.
+     */
+    bool Take(
+        const uint32_t*& s1_coef,
+        const TS2Coef*& s2_coef,
+        right_shift_t& s2_shr,
+        unsigned& fade_samples);
+};
+
+
+/**
+ * @brief Mix two samples for a crossfade.
+ * 
+ * The weight of `to` is `step / (length + 1)`, so it rises linearly over
+ * `length` output samples from just above `0` to just below `1`, for 
+ * `step` from `1` to `length`.
+ * 
+ * @param from    Sample of the old filter.
+ * @param to      Sample of the new filter.
+ * @param step    Number of the sample within the crossfade, from `1`.
+ * @param length  Length of the crossfade, in samples.
+ */
+static inline
+int32_t crossfade_sample(
+    const int32_t from,
+    const int32_t to,
+    const unsigned step,
+    const unsigned length);
+
+
 /**
  * @brief First and Second Stage Decimator
  * 
@@ -38,14 +333,81 @@ void shift_buffer(uint32_t* buff);
  * Concrete implementations of this class template are meant to be used as the
  * `TDecimator` template parameter in the @ref MicArray class template.
  * 
+ * `TSampleFilter` is applied to each stage 2 output sample as it is 
+ * produced, through its `FilterChannel()` method, before the sample is 
+ * stored. Using e.g. @ref DcoeSampleFilter here (with @ref NopSampleFilter as
+ * the @ref MicArray's own `TSampleFilter`) gives the same output as using it
+ * in the @ref MicArray, without a second pass over each output sample.
+ * 
+ * `S1_COEF_BITS` selects the precision of the stage 1 filter coefficients,
+ * and with it the stage 1 kernel (see @ref Fir1xNBit). 12 and 8-bit tables
+ * cost 12 or 8 `VLMACCR1` per stage 1 output rather than 16, in exchange for
+ * a higher stopband floor, and must be generated in the matching format
+ * (`python/stage1.py --coef-bits`). The default `stage1_coef` is 16-bit.
+ * 
+ * `S1_COEF_BITS` may also be @ref STAGE1_LUT, in which case `Init()` takes a
+ * look-up table built from the stage 1 coefficients rather than the
+ * coefficients themselves, e.g.
+ * 
+ * @code{.cpp}
+ *  static uint32_t stage1_lut[FIR_1X16_BIT_LUT_WORDS];
+ *  fir_1x16_bit_lut_init(stage1_lut, stage1_coef, 16);
+ *  decimator.Init(stage1_lut, stage2_coef, stage2_shr);
+ * @endcode
+ * 
+ * The table costs 32 KB, shared by all of the decimator's channels, and the
+ * output is unchanged. This replaces the `VLMACCR1` bit-plane kernels with a
+ * scalar look-up per byte of PDM history, which only saves time on targets
+ * without the vector unit; see `fir_1x16_bit_lut()`.
+ * 
+ * `S2_COEF_BITS` selects the precision of the stage 2 filter. With 16, 
+ * stage 2 is a @ref Stage2FilterS16, whose coefficients and history are
+ * `int16_t` and which filters 16 taps per `VLMACCR` rather than 8, halving
+ * the stage 2 memory and (roughly) instructions, for outputs such as 16 kHz
+ * voice which do not need 32-bit SNR. `Init()` then takes 16-bit
+ * coefficients, e.g. @ref stage2_coef_s16 with @ref stage2_shr_s16
+ * (`python/stage2.py --coef-bits 16`), and `S2_DEC_FACTOR` must be even.
+ * 
+ * `TStage1Output` receives the stage 1 output, at `S2_DEC_FACTOR` times the
+ * decimator's output rate (e.g. 96 kHz from 3.072 MHz PDM), through its
+ * `OutputSample()` method. Each multi-channel stage 1 sample is passed to
+ * @ref Stage1Output as soon as it is computed, before the rest of the block
+ * is filtered and before stage 2 runs, so a low latency consumer such as a
+ * feedback loop does not wait for the decimator's output sample and needs
+ * no second decimation pipeline. The samples are not passed through
+ * `TSampleFilter`. @ref Stage1Output is called from the decimator's thread,
+ * so it must return quickly, e.g. by writing to a channel or a buffer. The
+ * default, @ref NopOutputHandler, costs nothing.
+ * 
  * @tparam MIC_COUNT      Number of microphone channels.
  * @tparam S2_DEC_FACTOR  Stage 2 decimation factor.
  * @tparam S2_TAP_COUNT   Stage 2 tap count.
+ * @tparam TSampleFilter  Sample filter applied to the decimator output.
+ * @tparam S1_COEF_BITS   Bits per stage 1 coefficient: 16, 12 or 8, or
+ *                        @ref STAGE1_LUT.
+ * @tparam TStage1Output  OutputHandler which receives the stage 1 output.
+ * @tparam S2_COEF_BITS  Bits per stage 2 coefficient: 32 or 16.
  */
-template <unsigned MIC_COUNT, unsigned S2_DEC_FACTOR, unsigned S2_TAP_COUNT>
+template <unsigned MIC_COUNT, unsigned S2_DEC_FACTOR, unsigned S2_TAP_COUNT,
+          class TSampleFilter = NopSampleFilter<MIC_COUNT>,
+          unsigned S1_COEF_BITS = 16,
+          class TStage1Output = NopOutputHandler<MIC_COUNT>,
+          unsigned S2_COEF_BITS = 32>
 class TwoStageDecimator 
 {
 
+  static_assert(S1_COEF_BITS == 16 || S1_COEF_BITS == 12 || S1_COEF_BITS == 8
+                  || S1_COEF_BITS == STAGE1_LUT,
+                "S1_COEF_BITS must be 16, 12, 8 or STAGE1_LUT.");
+  static_assert(S2_COEF_BITS == 32 || S2_COEF_BITS == 16,
+                "S2_COEF_BITS must be 32 or 16.");
+
+  /**
+   * Type of the stage 2 filter.
+   */
+  using TStage2Filter = typename Stage2FilterOf<S2_COEF_BITS>::template Type<
+                            MIC_COUNT, S2_TAP_COUNT, S2_DEC_FACTOR>;
+
   public:
     /**
      * Size of a block of PDM data in words.
@@ -57,6 +419,73 @@ class TwoStageDecimator
      */
     static constexpr unsigned MicCount = MIC_COUNT;
 
+    /**
+     * Mask with a bit set for each microphone. See @ref SetActiveChannels().
+     */
+    static constexpr uint32_t AllChannels = (MIC_COUNT >= 32)? 0xFFFFFFFF 
+                                              : ((1u << (MIC_COUNT % 32)) - 1);
+
+    /**
+     * Number of words in the stage 1 filter coefficient table.
+     */
+    static constexpr unsigned Stage1CoefWords = 
+        Fir1xNBit<S1_COEF_BITS>::CoefWords;
+
+    /**
+     * Type of the stage 2 filter coefficients: `int32_t`, or `int16_t` if
+     * `S2_COEF_BITS` is 16.
+     */
+    using Stage2Coef = typename TStage2Filter::Coef;
+
+    /**
+     * Output sample period, in PDM clock periods.
+     */
+    static constexpr unsigned SamplePeriod = STAGE1_DEC_FACTOR * S2_DEC_FACTOR;
+
+    /**
+     * Output for a full scale PDM signal, with the default filters and no
+     * output shift. See @ref DecimatorFullScale.
+     */
+    static constexpr int32_t FullScale = STAGE2_FULL_SCALE;
+
+    /**
+     * @brief Latency of the decimator, in PDM clock periods.
+     * 
+     * This is the time from the sound represented by an output sample to the
+     * capture of the last PDM sample of the block it is produced from, i.e.
+     * the sum of the two filters' group delays. @ref MicArray::Latency() adds
+     * the buffering in the rest of the mic array.
+     * 
+     * The filters given to @ref Init() are not known at compile time, so 
+     * their group delays are parameters. The defaults are those of the 
+     * filters in `mic_array/etc/filters_default.h` (the minimum phase ones if
+     * @ref MIC_ARRAY_CONFIG_MIN_PHASE_FILTERS is enabled), and only apply when
+     * `S2_DEC_FACTOR` is 6. For a minimum phase filter, whose group delay 
+     * varies with frequency, the value at 1 kHz is used.
+     * 
+     * @param s1_group_delay  Stage 1 filter group delay, in PDM clock periods.
+     * @param s2_group_delay  Stage 2 filter group delay, in PDM clock periods.
+     */
+    static constexpr unsigned Latency(
+        const unsigned s1_group_delay = MIC_ARRAY_CONFIG_MIN_PHASE_FILTERS?
+                            STAGE1_GROUP_DELAY_MIN_PHASE : STAGE1_GROUP_DELAY,
+        const unsigned s2_group_delay = MIC_ARRAY_CONFIG_MIN_PHASE_FILTERS?
+                            STAGE2_GROUP_DELAY_MIN_PHASE : STAGE2_GROUP_DELAY);
+
+    /**
+     * @brief Estimated MIPS of the decimator.
+     * 
+     * Built from @ref KernelCost: for each PDM word of each mic, a stage 1
+     * output of `S1_COEF_BITS` bit planes, the PDM history and a stage 2
+     * push; for each output sample of each mic, a stage 2 output of
+     * `S2_TAP_COUNT` taps and the output shift. `TSampleFilter` is not
+     * included. See @ref FitsThreadMips().
+     * 
+     * @param pdm_freq  PDM clock frequency, in Hz.
+     */
+    static constexpr float RequiredMips(
+        const unsigned pdm_freq = 3072000);
+
     /**
      * Stage 2 decimator parameters
      */
@@ -83,22 +512,11 @@ class TwoStageDecimator
       const uint32_t* filter_coef;
       /**
        * Filter state (PDM history) for stage 1 filters.
+       * 
+       * Each block carries `S2_DEC_FACTOR` words per mic, so the history's
+       * windows are moved back once per block.
        */
-      uint32_t pdm_history[MIC_COUNT][8]
-#ifndef __DOXYGEN__ // doxygen breaks if it encounters this.
-      // Must be initialized in this way. Initializing the history values in the
-      // constructor causes an XCore-specific problem. Specifically, if the
-      // MicArray instance where this decimator is used is declared outside of a
-      // function scope (that is, as a global- or module-scope object; which it
-      // ordinarily will be), initializing the PDM history within the
-      // constructor forces the compiler to allocate the object on _all tiles_.
-      // Being allocated on a tile where it is not used does not by itself break
-      // anything, but it does result in less memory being available for other
-      // things on that tile. Initializing the history in this way prevents
-      // that.
-        = {[0 ... (MIC_COUNT-1)] = { [0 ... 7] = 0x55555555 } }
-#endif
-      ;
+      PdmHistory<MIC_COUNT, S2_DEC_FACTOR> pdm_history;
     } stage1;
     
     /**
@@ -106,24 +524,121 @@ class TwoStageDecimator
      */
     struct {
       /**
-       * Stage 2 FIR filters
+       * Stage 2 FIR filter and history for all mics.
        */
-      filter_fir_s32_t filters[MIC_COUNT];
+      TStage2Filter filter;
+    } stage2;
+
+    /**
+     * Coefficients posted by @ref SwapCoefficients().
+     */
+    CoefficientSwap<Stage2Coef> swap;
+
+    /**
+     * Crossfade from the coefficients replaced by the last swap.
+     */
+    struct {
       /**
-       * Stage 2 filter stage.
+       * Output samples in the crossfade; `0` if none is in progress.
        */
-      int32_t filter_state[MIC_COUNT][S2_TAP_COUNT] = {{0}};
-    } stage2;
+      unsigned length = 0;
+      /**
+       * Output samples of the crossfade produced so far.
+       */
+      unsigned step = 0;
+      /**
+       * Old stage 1 coefficients, or `nullptr` if stage 1 did not change.
+       */
+      const uint32_t* s1_coef = nullptr;
+      /**
+       * Whether stage 2 changed.
+       */
+      bool s2 = false;
+      /**
+       * Old stage 2 output right-shift.
+       */
+      right_shift_t s2_shr = 0;
+      /**
+       * Old stage 2 coefficients.
+       */
+      Stage2Coef WORD_ALIGNED s2_coef[TStage2Filter::PaddedTaps] = {0};
+    } fade;
+
+    /**
+     * Microphones decimated, as posted by @ref SetActiveChannels().
+     */
+    volatile uint32_t requested_active = AllChannels;
+
+    /**
+     * Microphones currently decimated.
+     */
+    uint32_t active = AllChannels;
+
+    /**
+     * Number of microphones currently decimated.
+     * 
+     * Their state is packed into filter channels `0` to `active_count - 1`,
+     * in ascending order of microphone, so that the stage 1 and stage 2 
+     * kernels still evaluate them together.
+     */
+    unsigned active_count = MIC_COUNT;
+
+    /**
+     * Microphone whose state is in each filter channel. Only used while
+     * `active_count` is less than `MIC_COUNT`.
+     */
+    unsigned slot_mic[MIC_COUNT] = {0};
 
   public:
 
+    /**
+     * @brief The sample filter applied to the decimator output.
+     * 
+     * It is initialized by `Init()`.
+     */
+    TSampleFilter SampleFilter;
+
+    /**
+     * @brief The OutputHandler which receives each stage 1 output sample.
+     * 
+     * See `TStage1Output`. It is not initialized by `Init()`.
+     */
+    TStage1Output Stage1Output;
+
+    /**
+     * @brief The output shift applied to the stage 2 output, before
+     *        @ref SampleFilter.
+     * 
+     * The stage 2 filter already saturates its output, so by default the
+     * shift is `0` and `Scaler.ClippedSamples()` just counts the samples at
+     * the saturation limits. A non-zero shift adds gain (or attenuation) to
+     * that of `s2_filter_shr` (see @ref Init()) without touching the filter.
+     * See @ref OutputScaler. It is not reset by `Init()`.
+     */
+    OutputScaler Scaler;
+
+#if MIC_ARRAY_CONFIG_PROFILE
+    /**
+     * @brief Profiler into which each block's stage 1 and stage 2 time is
+     *        recorded, if not null.
+     * 
+     * Only present when @ref MIC_ARRAY_CONFIG_PROFILE is enabled. @ref
+     * MicArray::ThreadEntry() points this at @ref MicArray::Profiler.
+     */
+    StageProfiler* Profiler = nullptr;
+#endif
+
     constexpr TwoStageDecimator() noexcept { }
 
     /**
      * @brief Initialize the decimator.
      * 
-     * Sets the stage 1 and 2 filter coefficients. The decimator must be 
-     * initialized before any calls to `ProcessBlock()`.
+     * Sets the stage 1 and 2 filter coefficients, and initializes
+     * @ref SampleFilter. The decimator must be initialized before any calls
+     * to `ProcessBlock()`.
+     * 
+     * It must not be called while another thread is running the decimator;
+     * @ref SwapCoefficients() changes the coefficients of a running one.
      * 
      * `s1_filter_coef` points to a block of coefficients for the first stage
      * decimator. This library provides coefficients for the first stage
@@ -142,8 +657,9 @@ class TwoStageDecimator
      * @param s1_filter_coef  @parblock 
      *        Stage 1 filter coefficients.
      *        
-     *        This points to a block of coefficients for the first stage 
-     *        decimator. This library provides coefficients for the first stage 
+     *        This points to a block of `Stage1CoefWords` coefficient words for
+     *        the first stage decimator, with `S1_COEF_BITS` bit coefficients.
+     *        This library provides 16-bit coefficients for the first stage 
      *        decimator. \verbatim embed:rst 
               See :c:var:`stage1_coef`.\endverbatim
      *        @endparblock
@@ -165,9 +681,86 @@ class TwoStageDecimator
      */
     void Init(
         const uint32_t* s1_filter_coef,
-        const int32_t* s2_filter_coef,
+        const Stage2Coef* s2_filter_coef,
         const right_shift_t s2_filter_shr);
 
+    /**
+     * @brief Switch to new filter coefficients while the decimator runs.
+     * 
+     * Unlike @ref Init(), this may be called from another thread (on the 
+     * same tile) while the decimator is processing blocks. The new 
+     * coefficients take effect between two output samples, all at once, and
+     * the PDM and stage 2 histories are kept. See @ref CoefficientSwap.
+     * 
+     * Stage 1 coefficients are switched by pointer, so `s1_filter_coef` must
+     * stay valid while in use. Stage 2 coefficients are copied into the
+     * filter, so `s2_filter_coef` need only stay valid until 
+     * @ref SwapPending() returns `false`.
+     * 
+     * With a non-zero `fade_samples`, the output crossfades linearly from
+     * the old coefficients to the new over that many output samples (see
+     * `crossfade_sample()`), to avoid a click if the filters' gain or phase
+     * differ. During the crossfade each stage whose coefficients changed is
+     * evaluated twice, so the thread must have the spare MIPS for it. A 
+     * further swap is only taken once the crossfade is over.
+     * 
+     * @param s1_filter_coef  New stage 1 coefficients, or `nullptr` to keep
+     *                        the current ones.
+     * @param s2_filter_coef  New stage 2 coefficients, or `nullptr` to keep
+     *                        the current ones.
+     * @param s2_filter_shr   New stage 2 filter right-shift.
+     * @param fade_samples    Length of the crossfade, in output samples.
+     * 
+     * @returns `false`, and nothing changes, if a previous swap is still
+     *          pending.
+     */
+    bool SwapCoefficients(
+        const uint32_t* s1_filter_coef,
+        const Stage2Coef* s2_filter_coef,
+        const right_shift_t s2_filter_shr,
+        const unsigned fade_samples = 0);
+
+    /**
+     * @brief Whether the last @ref SwapCoefficients() has yet to take 
+     *        effect.
+     */
+    bool SwapPending() const;
+
+    /**
+     * @brief Choose the microphones which are decimated.
+     * 
+     * Bit `k` of `mask` is set for microphone `k` to be decimated; bits from
+     * `MIC_COUNT` up are ignored. All microphones are active by default.
+     * 
+     * An inactive microphone skips stage 1 and stage 2 altogether, and its
+     * output samples (and those given to @ref Stage1Output) are zero. The
+     * state of the active microphones is packed into the first channels of
+     * the filters, so the cost of decimation scales with the number of 
+     * active microphones, e.g. when a beamformer which has settled on one 
+     * direction only needs the few microphones which contribute to it.
+     * 
+     * Like @ref SwapCoefficients(), this may be called from another thread
+     * on the same tile while the decimator is processing blocks. The mask
+     * takes effect at the start of the next @ref ProcessBlock() or
+     * @ref ProcessFrame(). The state of microphones which stay active is
+     * kept; a microphone switched back on is primed from its first PDM word
+     * of that block, as by @ref Prime(), so that it does not start with the
+     * whole filter transient. That block must hold current PDM data for it,
+     * which @ref MicArray::SetActiveChannels() makes sure of when the PDM rx
+     * component skips inactive microphones.
+     * 
+     * Only available if `MIC_COUNT` is at most `32`.
+     * 
+     * @param mask  Mask of the microphones to decimate.
+     */
+    void SetActiveChannels(
+        const uint32_t mask);
+
+    /**
+     * @brief Get the mask most recently set with @ref SetActiveChannels().
+     */
+    uint32_t ActiveChannels() const;
+
     /**
      * @brief Process one block of PDM data.
      * 
@@ -197,6 +790,167 @@ class TwoStageDecimator
     void ProcessBlock(
         int32_t sample_out[MIC_COUNT],
         uint32_t pdm_block[BLOCK_SIZE]);
+
+    /**
+     * @brief Process one frame of PDM data.
+     * 
+     * Processes `SAMPLE_COUNT` blocks' worth of PDM data to produce an entire
+     * frame of output samples from the second stage decimator. The result is
+     * identical to `SAMPLE_COUNT` consecutive calls to @ref ProcessBlock(),
+     * but the output is written directly in the `[MIC][SAMPLE]` order used by
+     * @ref FrameOutputHandler, so no per-sample hand-off is required.
+     * 
+     * The layout of `pdm_frame` should (effectively) be:
+     * 
+     * @code{.cpp}
+     *  struct {
+     *    struct {
+     *      // lower word indices are older samples.
+     *      // less significant bits in a word are older samples.
+     *      uint32_t samples[SAMPLE_COUNT * S2_DEC_FACTOR];
+     *    } microphone[MIC_COUNT]; // mic channels are in ascending order
+     *  } pdm_frame;
+     * @endcode
+     * 
+     * This is the layout produced by @ref StandardPdmRxService when its
+     * `SUBBLOCKS` template parameter is `SAMPLE_COUNT * S2_DEC_FACTOR`.
+     * 
+     * @tparam SAMPLE_COUNT Number of output samples per frame.
+     * 
+     * @param frame_out   Output frame.
+     * @param pdm_frame   PDM data to be processed.
+     */
+    template <unsigned SAMPLE_COUNT>
+    void ProcessFrame(
+        int32_t frame_out[MIC_COUNT][SAMPLE_COUNT],
+        uint32_t pdm_frame[SAMPLE_COUNT * BLOCK_SIZE]);
+
+    /**
+     * @brief Snapshot of the state of both decimator stages.
+     * 
+     * Captured with @ref SaveState() and restored with @ref LoadState(), e.g.
+     * to carry the steady state of one capture session over to the next so
+     * that the filters do not have to settle again. The coefficients and 
+     * @ref SampleFilter are not part of the snapshot. Nor is the state of
+     * microphones which are inactive (see @ref SetActiveChannels()); it is
+     * saved as silence, and ignored on loading.
+     */
+    struct State {
+      /**
+       * Stage 1 PDM history, newest word first.
+       */
+      uint32_t pdm_history[MIC_COUNT][8];
+      /**
+       * Stage 2 filter history, newest sample first (16-bit if 
+       * `S2_COEF_BITS` is 16).
+       */
+      Stage2Coef stage2_history[MIC_COUNT][TStage2Filter::PaddedTaps];
+    };
+
+    /**
+     * @brief Prime both decimator stages from a block of PDM data.
+     * 
+     * After `Init()`, the stage 1 history holds silence (`0x55555555`) and
+     * the stage 2 history zeros, so the first outputs of the decimator are
+     * the transient of the filters settling onto the signal, which lasts for
+     * their combined length (see @ref Latency()). 
+     * 
+     * This instead fills each microphone's stage 1 history with the oldest
+     * PDM word of `pdm_block` and its stage 2 history with the stage 1 output
+     * for that history, i.e. the state the decimator would have reached had
+     * that word been repeated indefinitely. Passing the same `pdm_block` to
+     * @ref ProcessBlock() afterwards then yields a sample close to the 
+     * signal's level straight away.
+     * 
+     * `pdm_block` has the layout described for @ref ProcessBlock(); it is not
+     * modified.
+     * 
+     * @param pdm_block   PDM data to prime from.
+     */
+    void Prime(
+        const uint32_t pdm_block[BLOCK_SIZE]);
+
+    /**
+     * @brief Prime both decimator stages from a frame of PDM data.
+     * 
+     * As @ref Prime(), for a `pdm_frame` with the layout described for 
+     * @ref ProcessFrame().
+     * 
+     * @tparam SAMPLE_COUNT Number of output samples per frame.
+     * 
+     * @param pdm_frame   PDM data to prime from.
+     */
+    template <unsigned SAMPLE_COUNT>
+    void PrimeFrame(
+        const uint32_t pdm_frame[SAMPLE_COUNT * BLOCK_SIZE]);
+
+    /**
+     * @brief Capture the state of both decimator stages.
+     * 
+     * @param state   Destination for the snapshot.
+     */
+    void SaveState(
+        State& state) const;
+
+    /**
+     * @brief Restore the state of both decimator stages.
+     * 
+     * Must be called after `Init()`. The next output is computed as though
+     * the data preceding the snapshot had been processed by this decimator.
+     * 
+     * @param state   Snapshot previously captured by @ref SaveState().
+     */
+    void LoadState(
+        const State& state);
+
+  private:
+
+    /**
+     * @brief Apply any swap posted by @ref SwapCoefficients(), or advance
+     *        the crossfade in progress.
+     * 
+     * Called before each output sample.
+     * 
+     * @returns Whether the sample is part of a crossfade.
+     */
+    bool NextSample();
+
+    /**
+     * @brief Decimate `SAMPLES` output samples per microphone.
+     * 
+     * Shared implementation of @ref ProcessBlock() and @ref ProcessFrame().
+     * Output sample `s` of microphone `mic` is written to `out[mic][s]`.
+     */
+    template <unsigned SAMPLES>
+    void Decimate(
+        int32_t out[MIC_COUNT][SAMPLES],
+        uint32_t pdm[MIC_COUNT][SAMPLES * S2_DEC_FACTOR]);
+
+    /**
+     * @brief As @ref Decimate(), with only the active microphones.
+     */
+    template <unsigned SAMPLES>
+    void DecimateActive(
+        int32_t out[MIC_COUNT][SAMPLES],
+        uint32_t pdm[MIC_COUNT][SAMPLES * S2_DEC_FACTOR]);
+
+    /**
+     * @brief Switch to the active microphones in `mask`.
+     * 
+     * Moves the state of the microphones which stay active to their new
+     * filter channels, and primes those switched on from their first word
+     * of `pdm`, in which each microphone has `words` words.
+     */
+    void ApplyActiveChannels(
+        const uint32_t mask,
+        const uint32_t* pdm,
+        const unsigned words);
+
+    /**
+     * @brief Microphone whose state is in filter channel `slot`.
+     */
+    unsigned SlotMic(
+        const unsigned slot) const;
   };
 }
 
@@ -205,53 +959,657 @@ class TwoStageDecimator
 //////////////////////////////////////////////
 
 
-template <unsigned MIC_COUNT, unsigned S2_DEC_FACTOR, unsigned S2_TAP_COUNT>
-void mic_array::TwoStageDecimator<MIC_COUNT,S2_DEC_FACTOR,S2_TAP_COUNT>::Init(
+template <class TS2Coef>
+bool mic_array::CoefficientSwap<TS2Coef>::Request(
+    const uint32_t* s1_coef,
+    const TS2Coef* s2_coef,
+    const right_shift_t s2_shr,
+    const unsigned fade_samples)
+{
+  if(this->pending)
+    return false;
+
+  this->s1_coef = s1_coef;
+  this->s2_coef = s2_coef;
+  this->s2_shr = s2_shr;
+  this->fade_samples = fade_samples;
+  // Keep the compiler from publishing the request before it is written.
+  std::atomic_signal_fence(std::memory_order_seq_cst);
+  this->pending = true;
+  return true;
+}
+
+
+template <class TS2Coef>
+bool mic_array::CoefficientSwap<TS2Coef>::Pending() const
+{
+  return this->pending;
+}
+
+
+template <class TS2Coef>
+bool mic_array::CoefficientSwap<TS2Coef>::Take(
+    const uint32_t*& s1_coef,
+    const TS2Coef*& s2_coef,
+    right_shift_t& s2_shr,
+    unsigned& fade_samples)
+{
+  if(!this->pending)
+    return false;
+
+  std::atomic_signal_fence(std::memory_order_seq_cst);
+  s1_coef = this->s1_coef;
+  s2_coef = this->s2_coef;
+  s2_shr = this->s2_shr;
+  fade_samples = this->fade_samples;
+  // Keep the compiler from releasing the request before it is read.
+  std::atomic_signal_fence(std::memory_order_seq_cst);
+  this->pending = false;
+  return true;
+}
+
+
+static inline
+int32_t mic_array::crossfade_sample(
+    const int32_t from,
+    const int32_t to,
+    const unsigned step,
+    const unsigned length)
+{
+  return from + (int32_t) ((((int64_t) to) - from) * step 
+                              / (int64_t) (length + 1));
+}
+
+
+template <unsigned MIC_COUNT, unsigned S2_DEC_FACTOR, unsigned S2_TAP_COUNT,
+          class TSampleFilter, unsigned S1_COEF_BITS,
+          class TStage1Output, unsigned S2_COEF_BITS>
+constexpr unsigned mic_array::TwoStageDecimator<MIC_COUNT,S2_DEC_FACTOR,
+                                                S2_TAP_COUNT,TSampleFilter,
+                                                S1_COEF_BITS,TStage1Output,
+                                                S2_COEF_BITS>
+    ::Latency(
+    const unsigned s1_group_delay,
+    const unsigned s2_group_delay)
+{
+  return s1_group_delay + s2_group_delay;
+}
+
+
+template <unsigned MIC_COUNT, unsigned S2_DEC_FACTOR, unsigned S2_TAP_COUNT,
+          class TSampleFilter, unsigned S1_COEF_BITS,
+          class TStage1Output, unsigned S2_COEF_BITS>
+constexpr float mic_array::TwoStageDecimator<MIC_COUNT,S2_DEC_FACTOR,
+                                             S2_TAP_COUNT,TSampleFilter,
+                                             S1_COEF_BITS,TStage1Output,
+                                             S2_COEF_BITS>
+    ::RequiredMips(
+    const unsigned pdm_freq)
+{
+  return MIC_COUNT * ((pdm_freq / 32.0f) 
+                          * (S1_COEF_BITS * KernelCost::FirPlane 
+                             + KernelCost::FirOutput + KernelCost::HistoryWord
+                             + KernelCost::FirS32Push)
+                    + (pdm_freq / float(SamplePeriod)) 
+                          * (KernelCost::FirS32Output + KernelCost::ScaleSample
+                             + float(S2_TAP_COUNT) 
+                                / Stage2FilterOf<S2_COEF_BITS>::TapsPerInstr)) 
+                  / 1e6f;
+}
+
+
+template <unsigned MIC_COUNT, unsigned S2_DEC_FACTOR, unsigned S2_TAP_COUNT,
+          class TSampleFilter, unsigned S1_COEF_BITS,
+          class TStage1Output, unsigned S2_COEF_BITS>
+void mic_array::TwoStageDecimator<MIC_COUNT,S2_DEC_FACTOR,S2_TAP_COUNT,
+                                  TSampleFilter,S1_COEF_BITS,
+                                  TStage1Output,S2_COEF_BITS>::Init(
     const uint32_t* s1_filter_coef,
-    const int32_t* s2_filter_coef,
+    const Stage2Coef* s2_filter_coef,
     const right_shift_t s2_shr) 
 {      
   this->stage1.filter_coef = s1_filter_coef;
 
-  for(int k = 0; k < MIC_COUNT; k++){
-    filter_fir_s32_init(&this->stage2.filters[k], &this->stage2.filter_state[k][0],
-                        S2_TAP_COUNT, s2_filter_coef, s2_shr);
+  this->stage2.filter.Init(s2_filter_coef, s2_shr);
+
+  // Any crossfade in progress is cut short.
+  this->fade.length = 0;
+  this->fade.step = 0;
+
+  this->SampleFilter.Init();
+}
+
+
+template <unsigned MIC_COUNT, unsigned S2_DEC_FACTOR, unsigned S2_TAP_COUNT,
+          class TSampleFilter, unsigned S1_COEF_BITS,
+          class TStage1Output, unsigned S2_COEF_BITS>
+bool mic_array::TwoStageDecimator<MIC_COUNT,S2_DEC_FACTOR,S2_TAP_COUNT,
+                                  TSampleFilter,S1_COEF_BITS,
+                                  TStage1Output,S2_COEF_BITS>::SwapCoefficients(
+    const uint32_t* s1_filter_coef,
+    const Stage2Coef* s2_filter_coef,
+    const right_shift_t s2_filter_shr,
+    const unsigned fade_samples)
+{
+  return this->swap.Request(s1_filter_coef, s2_filter_coef, s2_filter_shr,
+                            fade_samples);
+}
+
+
+template <unsigned MIC_COUNT, unsigned S2_DEC_FACTOR, unsigned S2_TAP_COUNT,
+          class TSampleFilter, unsigned S1_COEF_BITS,
+          class TStage1Output, unsigned S2_COEF_BITS>
+bool mic_array::TwoStageDecimator<MIC_COUNT,S2_DEC_FACTOR,S2_TAP_COUNT,
+                                  TSampleFilter,S1_COEF_BITS,
+                                  TStage1Output,S2_COEF_BITS>::SwapPending() const
+{
+  return this->swap.Pending();
+}
+
+
+template <unsigned MIC_COUNT, unsigned S2_DEC_FACTOR, unsigned S2_TAP_COUNT,
+          class TSampleFilter, unsigned S1_COEF_BITS,
+          class TStage1Output, unsigned S2_COEF_BITS>
+bool mic_array::TwoStageDecimator<MIC_COUNT,S2_DEC_FACTOR,S2_TAP_COUNT,
+                                  TSampleFilter,S1_COEF_BITS,
+                                  TStage1Output,S2_COEF_BITS>::NextSample()
+{
+  if(this->fade.step < this->fade.length){
+    this->fade.step++;
+    return true;
+  }
+
+  const uint32_t* s1_coef;
+  const Stage2Coef* s2_coef;
+  right_shift_t s2_shr;
+  unsigned fade_samples;
+
+  if(!this->swap.Take(s1_coef, s2_coef, s2_shr, fade_samples))
+    return false;
+
+  this->fade.length = fade_samples;
+  this->fade.step = 0;
+  this->fade.s1_coef = (s1_coef != nullptr)? this->stage1.filter_coef : nullptr;
+  this->fade.s2 = (s2_coef != nullptr);
+
+  if(s1_coef != nullptr)
+    this->stage1.filter_coef = s1_coef;
+
+  if(s2_coef != nullptr){
+    if(fade_samples)
+      this->stage2.filter.SaveCoef(this->fade.s2_coef, this->fade.s2_shr);
+    this->stage2.filter.Init(s2_coef, s2_shr);
   }
+
+  if(fade_samples == 0)
+    return false;
+
+  this->fade.step = 1;
+  return true;
+}
+
+
+
+template <unsigned MIC_COUNT, unsigned S2_DEC_FACTOR, unsigned S2_TAP_COUNT,
+          class TSampleFilter, unsigned S1_COEF_BITS,
+          class TStage1Output, unsigned S2_COEF_BITS>
+void mic_array::TwoStageDecimator<MIC_COUNT,S2_DEC_FACTOR,S2_TAP_COUNT,
+                                  TSampleFilter,S1_COEF_BITS,
+                                  TStage1Output,S2_COEF_BITS>
+    ::SetActiveChannels(
+        const uint32_t mask)
+{
+  static_assert(MIC_COUNT <= 32, 
+                "SetActiveChannels() requires MIC_COUNT of at most 32.");
+  // A single word store, picked up by the decimator at its next block.
+  this->requested_active = mask & AllChannels;
+}
+
+
+template <unsigned MIC_COUNT, unsigned S2_DEC_FACTOR, unsigned S2_TAP_COUNT,
+          class TSampleFilter, unsigned S1_COEF_BITS,
+          class TStage1Output, unsigned S2_COEF_BITS>
+uint32_t mic_array::TwoStageDecimator<MIC_COUNT,S2_DEC_FACTOR,S2_TAP_COUNT,
+                                  TSampleFilter,S1_COEF_BITS,
+                                  TStage1Output,S2_COEF_BITS>
+    ::ActiveChannels() const
+{
+  return this->requested_active;
+}
+
+
+template <unsigned MIC_COUNT, unsigned S2_DEC_FACTOR, unsigned S2_TAP_COUNT,
+          class TSampleFilter, unsigned S1_COEF_BITS,
+          class TStage1Output, unsigned S2_COEF_BITS>
+unsigned mic_array::TwoStageDecimator<MIC_COUNT,S2_DEC_FACTOR,S2_TAP_COUNT,
+                                  TSampleFilter,S1_COEF_BITS,
+                                  TStage1Output,S2_COEF_BITS>
+    ::SlotMic(
+        const unsigned slot) const
+{
+  return (this->active_count == MIC_COUNT)? slot : this->slot_mic[slot];
 }
 
 
+template <unsigned MIC_COUNT, unsigned S2_DEC_FACTOR, unsigned S2_TAP_COUNT,
+          class TSampleFilter, unsigned S1_COEF_BITS,
+          class TStage1Output, unsigned S2_COEF_BITS>
+void mic_array::TwoStageDecimator<MIC_COUNT,S2_DEC_FACTOR,S2_TAP_COUNT,
+                                  TSampleFilter,S1_COEF_BITS,
+                                  TStage1Output,S2_COEF_BITS>
+    ::ApplyActiveChannels(
+        const uint32_t mask,
+        const uint32_t* pdm,
+        const unsigned words)
+{
+  const uint32_t kept = this->active & mask;
+
+  // Filter channel of each microphone before and after the change.
+  unsigned old_slot[MIC_COUNT];
+  unsigned new_slot[MIC_COUNT];
+  unsigned count = 0;
+  for(unsigned mic = 0, prev = 0; mic < MIC_COUNT; mic++){
+    old_slot[mic] = prev;
+    new_slot[mic] = count;
+    prev += (this->active >> mic) & 1;
+    count += (mask >> mic) & 1;
+  }
+
+  // A microphone's channel only moves down when microphones below it are
+  // switched off, and up when they are switched on. The channels stay in
+  // the order of the microphones, so moving the former in ascending order
+  // and then the latter in descending order never overwrites a channel
+  // which is still to be moved.
+  uint32_t window[8];
+  Stage2Coef history[TStage2Filter::PaddedTaps];
+
+  for(unsigned pass = 0; pass < 2; pass++){
+    for(unsigned k = 0; k < MIC_COUNT; k++){
+      const unsigned mic = pass? (MIC_COUNT - 1 - k) : k;
+      const unsigned from = old_slot[mic];
+      const unsigned to = new_slot[mic];
+      if(!((kept >> mic) & 1) || (pass? (to <= from) : (to >= from)))
+        continue;
+      this->stage1.pdm_history.Save(from, window);
+      this->stage1.pdm_history.Load(to, window);
+      this->stage2.filter.Save(from, history);
+      this->stage2.filter.Load(to, history);
+    }
+  }
+
+  // Microphones switched on are primed from their first word, as Prime()
+  // does, rather than picking up whatever their channel last held.
+  for(unsigned mic = 0; mic < MIC_COUNT; mic++){
+    if(!((mask >> mic) & 1))
+      continue;
+
+    const unsigned slot = new_slot[mic];
+    this->slot_mic[slot] = mic;
+
+    if((kept >> mic) & 1)
+      continue;
 
-template <unsigned MIC_COUNT, unsigned S2_DEC_FACTOR, unsigned S2_TAP_COUNT>
-void mic_array::TwoStageDecimator<MIC_COUNT,S2_DEC_FACTOR,S2_TAP_COUNT>
+    int32_t streamA_sample;
+    this->stage1.pdm_history.Fill(slot, pdm[mic * words]);
+    fir_1x16_bit_channels_n<S1_COEF_BITS>(&streamA_sample, 
+                                          this->stage1.pdm_history.Window(slot),
+                                          this->stage1.pdm_history.Stride,
+                                          this->stage1.filter_coef, 1);
+    this->stage2.filter.Fill(slot, streamA_sample);
+  }
+
+  this->active = mask;
+  this->active_count = count;
+}
+
+
+template <unsigned MIC_COUNT, unsigned S2_DEC_FACTOR, unsigned S2_TAP_COUNT,
+          class TSampleFilter, unsigned S1_COEF_BITS,
+          class TStage1Output, unsigned S2_COEF_BITS>
+void mic_array::TwoStageDecimator<MIC_COUNT,S2_DEC_FACTOR,S2_TAP_COUNT,
+                                  TSampleFilter,S1_COEF_BITS,
+                                  TStage1Output,S2_COEF_BITS>
     ::ProcessBlock(
         int32_t sample_out[MIC_COUNT],
         uint32_t pdm_block[BLOCK_SIZE])
 {
-  uint32_t (*pdm_data)[S2_DEC_FACTOR] = (uint32_t (*)[S2_DEC_FACTOR]) pdm_block;
+  this->Decimate<1>((int32_t (*)[1]) sample_out, 
+                    (uint32_t (*)[S2_DEC_FACTOR]) pdm_block);
+}
 
-  for(unsigned mic = 0; mic < MIC_COUNT; mic++){
-    uint32_t* hist = &this->stage1.pdm_history[mic][0];
+
+template <unsigned MIC_COUNT, unsigned S2_DEC_FACTOR, unsigned S2_TAP_COUNT,
+          class TSampleFilter, unsigned S1_COEF_BITS,
+          class TStage1Output, unsigned S2_COEF_BITS>
+template <unsigned SAMPLE_COUNT>
+void mic_array::TwoStageDecimator<MIC_COUNT,S2_DEC_FACTOR,S2_TAP_COUNT,
+                                  TSampleFilter,S1_COEF_BITS,
+                                  TStage1Output,S2_COEF_BITS>
+    ::ProcessFrame(
+        int32_t frame_out[MIC_COUNT][SAMPLE_COUNT],
+        uint32_t pdm_frame[SAMPLE_COUNT * BLOCK_SIZE])
+{
+  this->Decimate<SAMPLE_COUNT>(frame_out, 
+      (uint32_t (*)[SAMPLE_COUNT * S2_DEC_FACTOR]) pdm_frame);
+}
+
+
+template <unsigned MIC_COUNT, unsigned S2_DEC_FACTOR, unsigned S2_TAP_COUNT,
+          class TSampleFilter, unsigned S1_COEF_BITS,
+          class TStage1Output, unsigned S2_COEF_BITS>
+void mic_array::TwoStageDecimator<MIC_COUNT,S2_DEC_FACTOR,S2_TAP_COUNT,
+                                  TSampleFilter,S1_COEF_BITS,
+                                  TStage1Output,S2_COEF_BITS>
+    ::Prime(
+        const uint32_t pdm_block[BLOCK_SIZE])
+{
+  this->PrimeFrame<1>(pdm_block);
+}
+
+
+template <unsigned MIC_COUNT, unsigned S2_DEC_FACTOR, unsigned S2_TAP_COUNT,
+          class TSampleFilter, unsigned S1_COEF_BITS,
+          class TStage1Output, unsigned S2_COEF_BITS>
+template <unsigned SAMPLE_COUNT>
+void mic_array::TwoStageDecimator<MIC_COUNT,S2_DEC_FACTOR,S2_TAP_COUNT,
+                                  TSampleFilter,S1_COEF_BITS,
+                                  TStage1Output,S2_COEF_BITS>
+    ::PrimeFrame(
+        const uint32_t pdm_frame[SAMPLE_COUNT * BLOCK_SIZE])
+{
+  int32_t streamA_sample[MIC_COUNT];
+  const unsigned mics = this->active_count;
+
+  for(unsigned slot = 0; slot < mics; slot++)
+    this->stage1.pdm_history.Fill(slot, 
+        pdm_frame[this->SlotMic(slot) * SAMPLE_COUNT * S2_DEC_FACTOR]);
+
+  fir_1x16_bit_channels_n<S1_COEF_BITS>(streamA_sample, 
+                                        this->stage1.pdm_history.Window(0),
+                                        this->stage1.pdm_history.Stride,
+                                        this->stage1.filter_coef, mics);
+
+  for(unsigned slot = 0; slot < mics; slot++)
+    this->stage2.filter.Fill(slot, streamA_sample[slot]);
+}
+
+
+template <unsigned MIC_COUNT, unsigned S2_DEC_FACTOR, unsigned S2_TAP_COUNT,
+          class TSampleFilter, unsigned S1_COEF_BITS,
+          class TStage1Output, unsigned S2_COEF_BITS>
+void mic_array::TwoStageDecimator<MIC_COUNT,S2_DEC_FACTOR,S2_TAP_COUNT,
+                                  TSampleFilter,S1_COEF_BITS,
+                                  TStage1Output,S2_COEF_BITS>
+    ::SaveState(
+        State& state) const
+{
+  // Inactive microphones are saved as silence.
+  if(this->active_count != MIC_COUNT){
+    for(unsigned mic = 0; mic < MIC_COUNT; mic++)
+      for(unsigned k = 0; k < 8; k++)
+        state.pdm_history[mic][k] = 0x55555555;
+    std::memset(state.stage2_history, 0, sizeof(state.stage2_history));
+  }
+
+  for(unsigned slot = 0; slot < this->active_count; slot++){
+    const unsigned mic = this->SlotMic(slot);
+    this->stage1.pdm_history.Save(slot, state.pdm_history[mic]);
+    this->stage2.filter.Save(slot, state.stage2_history[mic]);
+  }
+}
+
+
+template <unsigned MIC_COUNT, unsigned S2_DEC_FACTOR, unsigned S2_TAP_COUNT,
+          class TSampleFilter, unsigned S1_COEF_BITS,
+          class TStage1Output, unsigned S2_COEF_BITS>
+void mic_array::TwoStageDecimator<MIC_COUNT,S2_DEC_FACTOR,S2_TAP_COUNT,
+                                  TSampleFilter,S1_COEF_BITS,
+                                  TStage1Output,S2_COEF_BITS>
+    ::LoadState(
+        const State& state)
+{
+  for(unsigned slot = 0; slot < this->active_count; slot++){
+    const unsigned mic = this->SlotMic(slot);
+    this->stage1.pdm_history.Load(slot, state.pdm_history[mic]);
+    this->stage2.filter.Load(slot, state.stage2_history[mic]);
+  }
+}
+
+
+template <unsigned MIC_COUNT, unsigned S2_DEC_FACTOR, unsigned S2_TAP_COUNT,
+          class TSampleFilter, unsigned S1_COEF_BITS,
+          class TStage1Output, unsigned S2_COEF_BITS>
+template <unsigned SAMPLES>
+void mic_array::TwoStageDecimator<MIC_COUNT,S2_DEC_FACTOR,S2_TAP_COUNT,
+                                  TSampleFilter,S1_COEF_BITS,
+                                  TStage1Output,S2_COEF_BITS>
+    ::Decimate(
+        int32_t out[MIC_COUNT][SAMPLES],
+        uint32_t pdm[MIC_COUNT][SAMPLES * S2_DEC_FACTOR])
+{
+  // Only a single word is read from `requested_active`, so a concurrent
+  // SetActiveChannels() is either seen now or at the next call.
+  const uint32_t requested = this->requested_active;
+  if(requested != this->active)
+    this->ApplyActiveChannels(requested, &pdm[0][0], 
+                              SAMPLES * S2_DEC_FACTOR);
+
+  if(this->active_count != MIC_COUNT){
+    this->DecimateActive<SAMPLES>(out, pdm);
+    return;
+  }
+
+  MIC_ARRAY_PROFILE(const uint32_t start = StageProfiler::Now());
+  MIC_ARRAY_PROFILE(uint32_t stage1_ticks = 0);
+
+  for(unsigned s = 0; s < SAMPLES; s++){
+    // Coefficients only change between output samples.
+    const bool fading = this->NextSample();
+
+    MIC_ARRAY_PROFILE(const uint32_t stage1_start = StageProfiler::Now());
 
     for(unsigned k = 0; k < S2_DEC_FACTOR; k++){
-      hist[0] = pdm_data[mic][k];
-      int32_t streamA_sample = fir_1x16_bit(hist, this->stage1.filter_coef);
-      shift_buffer(hist);
-
-      if(k < (S2_DEC_FACTOR-1)){
-        filter_fir_s32_add_sample(&this->stage2.filters[mic], streamA_sample);
-      } else {
-        sample_out[mic] = filter_fir_s32(&this->stage2.filters[mic], streamA_sample);
+      int32_t streamA_sample[MIC_COUNT];
+
+      this->stage1.pdm_history.Advance();
+      for(unsigned mic = 0; mic < MIC_COUNT; mic++)
+        this->stage1.pdm_history.Set(mic, pdm[mic][s * S2_DEC_FACTOR + k]);
+
+      fir_1x16_bit_channels<MIC_COUNT,S1_COEF_BITS>(streamA_sample, 
+                                                    this->stage1.pdm_history.Window(0),
+                                                    this->stage1.pdm_history.Stride,
+                                                    this->stage1.filter_coef);
+
+      if(fading && this->fade.s1_coef != nullptr){
+        int32_t old_sample[MIC_COUNT];
+        fir_1x16_bit_channels<MIC_COUNT,S1_COEF_BITS>(old_sample, 
+                                                      this->stage1.pdm_history.Window(0),
+                                                      this->stage1.pdm_history.Stride,
+                                                      this->fade.s1_coef);
+        for(unsigned mic = 0; mic < MIC_COUNT; mic++)
+          streamA_sample[mic] = crossfade_sample(old_sample[mic], 
+                                                 streamA_sample[mic],
+                                                 this->fade.step, 
+                                                 this->fade.length);
       }
+
+      this->Stage1Output.OutputSample(streamA_sample);
+
+      this->stage2.filter.Advance();
+      for(unsigned mic = 0; mic < MIC_COUNT; mic++)
+        this->stage2.filter.Set(mic, streamA_sample[mic]);
+    }
+
+    MIC_ARRAY_PROFILE(stage1_ticks += StageProfiler::Now() - stage1_start);
+
+    // Stage 2 is only evaluated for the samples which are kept.
+    int32_t sample[MIC_COUNT];
+    this->stage2.filter.Filter(sample);
+
+    if(fading && this->fade.s2){
+      int32_t old_sample[MIC_COUNT];
+      this->stage2.filter.Filter(old_sample, this->fade.s2_coef, 
+                                 this->fade.s2_shr);
+      for(unsigned mic = 0; mic < MIC_COUNT; mic++)
+        sample[mic] = crossfade_sample(old_sample[mic], sample[mic], 
+                                       this->fade.step, this->fade.length);
     }
+
+    this->Scaler.Apply(sample, MIC_COUNT);
+
+    for(unsigned mic = 0; mic < MIC_COUNT; mic++)
+      out[mic][s] = this->SampleFilter.FilterChannel(mic, sample[mic]);
   }
+
+  MIC_ARRAY_PROFILE(
+    if(this->Profiler){
+      this->Profiler->Add(PROFILE_STAGE1, stage1_ticks);
+      this->Profiler->Add(PROFILE_STAGE2, 
+                          StageProfiler::Now() - start - stage1_ticks);
+    });
 }
 
 
+
+template <unsigned MIC_COUNT, unsigned S2_DEC_FACTOR, unsigned S2_TAP_COUNT,
+          class TSampleFilter, unsigned S1_COEF_BITS,
+          class TStage1Output, unsigned S2_COEF_BITS>
+template <unsigned SAMPLES>
+void mic_array::TwoStageDecimator<MIC_COUNT,S2_DEC_FACTOR,S2_TAP_COUNT,
+                                  TSampleFilter,S1_COEF_BITS,
+                                  TStage1Output,S2_COEF_BITS>
+    ::DecimateActive(
+        int32_t out[MIC_COUNT][SAMPLES],
+        uint32_t pdm[MIC_COUNT][SAMPLES * S2_DEC_FACTOR])
+{
+  MIC_ARRAY_PROFILE(const uint32_t start = StageProfiler::Now());
+  MIC_ARRAY_PROFILE(uint32_t stage1_ticks = 0);
+
+  // Filter channel `slot` holds microphone `slot_mic[slot]`.
+  const unsigned mics = this->active_count;
+
+  for(unsigned s = 0; s < SAMPLES; s++){
+    const bool fading = this->NextSample();
+
+    MIC_ARRAY_PROFILE(const uint32_t stage1_start = StageProfiler::Now());
+
+    for(unsigned k = 0; k < S2_DEC_FACTOR; k++){
+      int32_t streamA_sample[MIC_COUNT];
+
+      this->stage1.pdm_history.Advance();
+      for(unsigned slot = 0; slot < mics; slot++)
+        this->stage1.pdm_history.Set(slot, 
+            pdm[this->slot_mic[slot]][s * S2_DEC_FACTOR + k]);
+
+      fir_1x16_bit_channels_n<S1_COEF_BITS>(streamA_sample, 
+                                            this->stage1.pdm_history.Window(0),
+                                            this->stage1.pdm_history.Stride,
+                                            this->stage1.filter_coef, mics);
+
+      if(fading && this->fade.s1_coef != nullptr){
+        int32_t old_sample[MIC_COUNT];
+        fir_1x16_bit_channels_n<S1_COEF_BITS>(old_sample, 
+                                              this->stage1.pdm_history.Window(0),
+                                              this->stage1.pdm_history.Stride,
+                                              this->fade.s1_coef, mics);
+        for(unsigned slot = 0; slot < mics; slot++)
+          streamA_sample[slot] = crossfade_sample(old_sample[slot], 
+                                                  streamA_sample[slot],
+                                                  this->fade.step, 
+                                                  this->fade.length);
+      }
+
+      int32_t stage1_sample[MIC_COUNT] = {0};
+      for(unsigned slot = 0; slot < mics; slot++)
+        stage1_sample[this->slot_mic[slot]] = streamA_sample[slot];
+
+      this->Stage1Output.OutputSample(stage1_sample);
+
+      this->stage2.filter.Advance();
+      for(unsigned slot = 0; slot < mics; slot++)
+        this->stage2.filter.Set(slot, streamA_sample[slot]);
+    }
+
+    MIC_ARRAY_PROFILE(stage1_ticks += StageProfiler::Now() - stage1_start);
+
+    for(unsigned mic = 0; mic < MIC_COUNT; mic++)
+      out[mic][s] = 0;
+
+    if(mics == 0)
+      continue;
+
+    int32_t sample[MIC_COUNT];
+    this->stage2.filter.Filter(sample, mics);
+
+    if(fading && this->fade.s2){
+      // The old coefficients are applied to every channel.
+      int32_t old_sample[MIC_COUNT];
+      this->stage2.filter.Filter(old_sample, this->fade.s2_coef, 
+                                 this->fade.s2_shr);
+      for(unsigned slot = 0; slot < mics; slot++)
+        sample[slot] = crossfade_sample(old_sample[slot], sample[slot], 
+                                        this->fade.step, this->fade.length);
+    }
+
+    this->Scaler.Apply(sample, mics);
+
+    for(unsigned slot = 0; slot < mics; slot++){
+      const unsigned mic = this->slot_mic[slot];
+      out[mic][s] = this->SampleFilter.FilterChannel(mic, sample[slot]);
+    }
+  }
+
+  MIC_ARRAY_PROFILE(
+    if(this->Profiler){
+      this->Profiler->Add(PROFILE_STAGE1, stage1_ticks);
+      this->Profiler->Add(PROFILE_STAGE2, 
+                          StageProfiler::Now() - start - stage1_ticks);
+    });
+}
+
 static inline 
 void mic_array::shift_buffer(uint32_t* buff)
 {
   uint32_t* src = &buff[-1];
+#if defined(__XS3A__)
   asm volatile("vldd %0[0]; vstd %1[0];" :: "r"(src), "r"(buff) : "memory" );
+#else
+  std::memmove(buff, src, 8 * sizeof(uint32_t));
+#endif
+}
+
+
+template <unsigned CHANNELS, unsigned COEF_BITS>
+static inline 
+void mic_array::fir_1x16_bit_channels(
+    int32_t out[CHANNELS],
+    uint32_t* signal,
+    const unsigned stride,
+    const uint32_t* coef)
+{
+  fir_1x16_bit_channels_n<COEF_BITS>(out, signal, stride, coef, CHANNELS);
 }
 
 
+template <unsigned COEF_BITS>
+static inline 
+void mic_array::fir_1x16_bit_channels_n(
+    int32_t* out,
+    uint32_t* signal,
+    const unsigned stride,
+    const uint32_t* coef,
+    const unsigned channels)
+{
+  using Fir = Fir1xNBit<COEF_BITS>;
+
+  if(channels >= FIR_1X16_BIT_MULTI_MIN_CHANNELS){
+    for(unsigned c = 0; c < channels; c += FIR_1X16_BIT_MULTI_MAX_CHANNELS){
+      const unsigned count = ((channels - c) < FIR_1X16_BIT_MULTI_MAX_CHANNELS)?
+                                (channels - c) : FIR_1X16_BIT_MULTI_MAX_CHANNELS;
+      Fir::FilterMulti(&signal[c * stride], coef, &out[c], count, stride);
+    }
+  } else {
+    for(unsigned c = 0; c < channels; c++)
+      out[c] = Fir::Filter(&signal[c * stride], coef);
+  }
+}
@@ -4,8 +4,9 @@
  * This design implements a decimation factor of 16 to achieve 192kHz sample rate
  * from the 3.072MHz PDM sample rate. As the PdmRx implementation captures the
  * incoming PDM stream in blocks of 32 samples, this decimator filters each
- * 32 sample block twice. Once at the beginning with a padding of 16 samples at
- * the end, and with a padding of 16 samples at the beginning. So each call for
+ * 32 sample block twice: once against the PDM history, and once against the
+ * PDM history offset by half a word (16 samples). Both use the same 240-tap
+ * filter, which is padded with 16 zero taps at the end. So each call for
  * OneStageDecimator192:ProcessBlock() will produce two output samples.
  *
  * @author Christoph Kiener
@@ -23,53 +24,15 @@
 
 #include "xmath/filter.h"
 #include "mic_array/etc/fir_1x16_bit.h"
+#include "mic_array/etc/filters_default.h"
+#include "Decimator.hpp"
+#include "OutputScaler.hpp"
+#include "Mips.hpp"
+
+// The 192 kHz filter tables, s1_fir_coef and s1_fir_coef_min_phase, are
+// declared in filters_default.h and defined once, in 
+// src/etc/stage1_192_fir_coef.c.
 
-#define S1_TAP_COUNT 256
-#define S1_WORDS (S1_TAP_COUNT) / 2
-
-// taps=240, fc=80kHz, window=("kaiser", 4.0), a_stop=-44dB, 16 samples padding at the end
-// clang-format off
-static const uint32_t WORD_ALIGNED s1_fir_zero_after[S1_WORDS] = {
-  0xFFFFDA39, 0xBFF03D14, 0x538A5CDE, 0xCE092678, 0xAA551E64, 0x90737B3A, 0x51CA28BC, 0x0FFD9C5B, 
-  0xFFFF0B0A, 0x66F123BA, 0x52CDEEBC, 0x9ABFF4AE, 0xF66F752F, 0xFD593D77, 0xB34A5DC4, 0x8F6650D0, 
-  0xFFFFE5F6, 0x6942B926, 0xA4759759, 0x7664D0A0, 0xA815050B, 0x266E9AE9, 0xAE25649D, 0x42966FA7, 
-  0xFFFF9207, 0xCF40DCF9, 0x3DBEE8B1, 0xBF02757E, 0xF00F7EAE, 0x40FD8D17, 0x7DBC9F3B, 0x02F3E049, 
-  0xFFFFA150, 0xE96BC170, 0x45B01821, 0x3D7A8121, 0xEE778481, 0x5EBC8418, 0x0DA20E83, 0xD6970A85, 
-  0xFFFF959A, 0x0626D835, 0x1E635D0D, 0x75D96DDB, 0xF24FDBB6, 0x9BAEB0BA, 0xC678AC1B, 0x646059A9, 
-  0xFFFF8CB6, 0x0AE19A19, 0xBB279875, 0xCD6B6F6F, 0x8001F6F6, 0xD6B3AE19, 0xE4DD9859, 0x87506D31, 
-  0xFFFF7C71, 0xF34AE6A1, 0xD79AB09E, 0x821667F1, 0xD42B8FE6, 0x6841790D, 0x59EB8567, 0x52CF8E3E, 
-  0xFFFFFC0F, 0xFC730194, 0xB0298AF7, 0xAAEDFBAA, 0x7E7E55DF, 0xB755EF51, 0x940D2980, 0xCE3FF03F, 
-  0xFFFFFC00, 0x007C0073, 0x8FCD2CF2, 0xCCA10833, 0xDC3BCC10, 0x85334F34, 0xB3F1CE00, 0x3E00003F, 
-  0xFFFFFC00, 0x007FFFF0, 0x7FF1CF0E, 0x5A61A7C3, 0xC813C3E5, 0x865A70F3, 0x8FFE0FFF, 0xFE00003F, 
-  0xFFFFFC00, 0x007FFFF0, 0x0001F001, 0xC61E3556, 0x90096AAC, 0x7863800F, 0x80000FFF, 0xFE00003F, 
-  0xFFFFFC00, 0x007FFFF0, 0x0001FFFF, 0xC1FFC664, 0xE0072663, 0xFF83FFFF, 0x80000FFF, 0xFE00003F, 
-  0xFFFFFC00, 0x007FFFF0, 0x0001FFFF, 0xC0000787, 0x0000E1E0, 0x0003FFFF, 0x80000FFF, 0xFE00003F, 
-  0xFFFFFC00, 0x007FFFF0, 0x0001FFFF, 0xC00007F8, 0x00001FE0, 0x0003FFFF, 0x80000FFF, 0xFE00003F, 
-  0x000003FF, 0xFF80000F, 0xFFFE0000, 0x3FFFF800, 0x0000001F, 0xFFFC0000, 0x7FFFF000, 0x01FFFFC0,
-};
-// clang-format on
-
-// taps=240, fc=80kHz, window=("kaiser", 4.0), a_stop=-44dB, 16 samples padding at the beginning
-// clang-format off
-static const uint32_t WORD_ALIGNED s1_fir_zero_before[S1_WORDS] = {
-  0xDA39BFF0, 0x3D14538A, 0x5CDECE09, 0x2678AA55, 0x1E649073, 0x7B3A51CA, 0x28BC0FFD, 0x9C5BFFFF, 
-  0x0B0A66F1, 0x23BA52CD, 0xEEBC9ABF, 0xF4AEF66F, 0x752FFD59, 0x3D77B34A, 0x5DC48F66, 0x50D0FFFF, 
-  0xE5F66942, 0xB926A475, 0x97597664, 0xD0A0A815, 0x050B266E, 0x9AE9AE25, 0x649D4296, 0x6FA7FFFF, 
-  0x9207CF40, 0xDCF93DBE, 0xE8B1BF02, 0x757EF00F, 0x7EAE40FD, 0x8D177DBC, 0x9F3B02F3, 0xE049FFFF, 
-  0xA150E96B, 0xC17045B0, 0x18213D7A, 0x8121EE77, 0x84815EBC, 0x84180DA2, 0x0E83D697, 0x0A85FFFF, 
-  0x959A0626, 0xD8351E63, 0x5D0D75D9, 0x6DDBF24F, 0xDBB69BAE, 0xB0BAC678, 0xAC1B6460, 0x59A9FFFF, 
-  0x8CB60AE1, 0x9A19BB27, 0x9875CD6B, 0x6F6F8001, 0xF6F6D6B3, 0xAE19E4DD, 0x98598750, 0x6D31FFFF, 
-  0x7C71F34A, 0xE6A1D79A, 0xB09E8216, 0x67F1D42B, 0x8FE66841, 0x790D59EB, 0x856752CF, 0x8E3EFFFF, 
-  0xFC0FFC73, 0x0194B029, 0x8AF7AAED, 0xFBAA7E7E, 0x55DFB755, 0xEF51940D, 0x2980CE3F, 0xF03FFFFF, 
-  0xFC00007C, 0x00738FCD, 0x2CF2CCA1, 0x0833DC3B, 0xCC108533, 0x4F34B3F1, 0xCE003E00, 0x003FFFFF, 
-  0xFC00007F, 0xFFF07FF1, 0xCF0E5A61, 0xA7C3C813, 0xC3E5865A, 0x70F38FFE, 0x0FFFFE00, 0x003FFFFF, 
-  0xFC00007F, 0xFFF00001, 0xF001C61E, 0x35569009, 0x6AAC7863, 0x800F8000, 0x0FFFFE00, 0x003FFFFF, 
-  0xFC00007F, 0xFFF00001, 0xFFFFC1FF, 0xC664E007, 0x2663FF83, 0xFFFF8000, 0x0FFFFE00, 0x003FFFFF, 
-  0xFC00007F, 0xFFF00001, 0xFFFFC000, 0x07870000, 0xE1E00003, 0xFFFF8000, 0x0FFFFE00, 0x003FFFFF, 
-  0xFC00007F, 0xFFF00001, 0xFFFFC000, 0x07F80000, 0x1FE00003, 0xFFFF8000, 0x0FFFFE00, 0x003FFFFF, 
-  0x03FFFF80, 0x000FFFFE, 0x00003FFF, 0xF8000000, 0x001FFFFC, 0x00007FFF, 0xF00001FF, 0xFFC00000, 
-};
-// clang-format on
 
 namespace mic_array
 {
@@ -80,81 +43,278 @@ namespace mic_array
    * This class template represents a one stage decimator which converts a stream
    * of PDM samples to a 1/16th sample rate stream of PCM samples.
    *
+   * The two output samples for each PDM block are the two phases of a single
+   * polyphase filter. Rather than keeping a separate coefficient table per
+   * phase, the second phase is computed by filtering a copy of the PDM history
+   * delayed by half a word (16 PDM samples) with the same coefficients. The
+   * 16 zero taps at the end of the filter line up with the 16 samples the
+   * delayed copy is missing.
+   *
+   * The delayed copy is kept up to date incrementally: when a new PDM word
+   * `w` arrives, its upper half completes the delayed copy's previous newest
+   * word, and `w >> 16` becomes the delayed copy's newest word.
+   *
    * Concrete implementations of this class template are meant to be used as the
    * `TDecimator` template parameter in the @ref MicArray class template.
    *
+   * As with @ref TwoStageDecimator, `TSampleFilter` is applied to each output
+   * sample, through its `FilterChannel()` method, after the block's samples
+   * have been scaled for output by @ref Scaler. At 192 kHz this avoids a
+   * second pass over the samples of every block.
+   *
+   * As with @ref TwoStageDecimator, `S1_COEF_BITS` selects the precision of
+   * the filter coefficients and with it the kernel (see @ref Fir1xNBit). 12
+   * and 8-bit tables cost 12 or 8 `VLMACCR1` per output sample rather than
+   * 16, in exchange for a higher stopband floor, and must be generated in the
+   * matching format (`python/stage1_192.py --coef-bits`).
+   *
+   * By default each block holds one PDM word per mic, so the PDM rx service
+   * hands a block over every 32 PDM clock periods. With `SUBBLOCKS` greater
+   * than `1` each block holds `SUBBLOCKS` words per mic, in the
+   * `[MIC_COUNT][SUBBLOCKS]` layout @ref StandardPdmRxService delivers with
+   * the same `SUBBLOCKS`, and `ProcessBlock()` produces `2*SUBBLOCKS` 
+   * samples, oldest first. The output is the same either way, but blocks,
+   * and the hand-offs and wake-ups of the decimation thread that come with
+   * them, are `SUBBLOCKS` times less frequent, at the cost of
+   * `32*(SUBBLOCKS-1)` PDM clock periods more latency (see @ref Latency()).
+   *
    * @tparam MIC_COUNT      Number of microphone channels.
+   * @tparam TSampleFilter  Sample filter applied to the decimator output.
+   * @tparam S1_COEF_BITS   Bits per filter coefficient: 16, 12 or 8.
+   * @tparam SUBBLOCKS      Number of PDM words per mic in each block.
    */
-  template <unsigned MIC_COUNT>
+  template <unsigned MIC_COUNT, 
+            class TSampleFilter = NopSampleFilter<MIC_COUNT>,
+            unsigned S1_COEF_BITS = 16,
+            unsigned SUBBLOCKS = 1>
   class OneStageDecimator192
   {
 
+    static_assert(S1_COEF_BITS == 16 || S1_COEF_BITS == 12 || S1_COEF_BITS == 8,
+                  "S1_COEF_BITS must be 16, 12 or 8.");
+    static_assert(SUBBLOCKS >= 1, "SUBBLOCKS must be at least 1.");
+
   public:
+    /**
+     * Size of a block of PDM data in words.
+     */
+    static constexpr unsigned BLOCK_SIZE = MIC_COUNT * SUBBLOCKS;
+
     /**
      * Number of microphone channels.
      */
     static constexpr unsigned MicCount = MIC_COUNT;
 
+    /**
+     * Number of output samples produced by each call to `ProcessBlock()`.
+     * 
+     * @ref MicArray uses this to pass every sample through its sample filter
+     * and output handler. See @ref DecimatorSamplesPerBlock.
+     */
+    static constexpr unsigned SamplesPerBlock = 2 * SUBBLOCKS;
+
+    /**
+     * Number of words in the filter coefficient table.
+     */
+    static constexpr unsigned Stage1CoefWords = 
+        Fir1xNBit<S1_COEF_BITS>::CoefWords;
+
+    /**
+     * Output sample period, in PDM clock periods.
+     */
+    static constexpr unsigned SamplePeriod = 16;
+
+    /**
+     * Output for a full scale PDM signal, with the default filter and
+     * @ref Scaler shift. See @ref DecimatorFullScale.
+     */
+    static constexpr int32_t FullScale = S1_FULL_SCALE;
+
+    /**
+     * @brief Latency of the decimator, in PDM clock periods.
+     * 
+     * This is the time from the sound represented by the older output sample
+     * of a block (`sample_out[0]`) to the capture of the block's last PDM
+     * sample, i.e. the filter's group delay, measured from the newest tap
+     * (including the 16 zero taps), plus `32*(SUBBLOCKS-1)` for the words
+     * of the block after the first. Each later sample's is `SamplePeriod`
+     * less. @ref MicArray::Latency() adds the buffering in the rest of the
+     * mic array.
+     * 
+     * The filter given to @ref Init() is not known at compile time, so its 
+     * group delay is a parameter. The default is that of the default filter
+     * of @ref Init(). For a minimum phase filter, whose group delay varies 
+     * with frequency, the value at 1 kHz is used.
+     * 
+     * @param group_delay Filter group delay, in PDM clock periods.
+     */
+    static constexpr unsigned Latency(
+        const unsigned group_delay = MIC_ARRAY_CONFIG_MIN_PHASE_FILTERS?
+                                        S1_GROUP_DELAY_MIN_PHASE : S1_GROUP_DELAY);
+
+    /**
+     * @brief Estimated MIPS of the decimator.
+     * 
+     * Built from @ref KernelCost: for each PDM word of each mic, two filter
+     * outputs of `S1_COEF_BITS` bit planes and the PDM history; for each
+     * output sample of each mic, the output shift. `TSampleFilter` is not
+     * included. See @ref FitsThreadMips().
+     * 
+     * @param pdm_freq  PDM clock frequency, in Hz.
+     */
+    static constexpr float RequiredMips(
+        const unsigned pdm_freq = 3072000);
+
   private:
+    /**
+     * Number of blocks between moves of the PDM history windows. See
+     * @ref PdmHistory.
+     */
+    static constexpr unsigned HISTORY_STEPS = 4;
+
     /**
      * Stage 1 decimator configuration and state.
      */
     struct
     {
       /**
-       * Pointer to alternating filter coefficients for Stage 1
+       * Pointer to filter coefficients for Stage 1, shared by both phases.
        */
-      const uint32_t *filter_coef[2];
+      const uint32_t *filter_coef;
       /**
        * Filter state (PDM history) for stage 1 filters.
+       *
+       * Channels `0` to `MIC_COUNT-1` hold each mic's PDM history, channels
+       * `MIC_COUNT` to `2*MIC_COUNT-1` the half-word delayed copy of it.
        */
-      uint32_t pdm_history[MIC_COUNT][8]
-#ifndef __DOXYGEN__ // doxygen breaks if it encounters this.
-                    // Must be initialized in this way. Initializing the history values in the
-                    // constructor causes an XCore-specific problem. Specifically, if the
-                    // MicArray instance where this decimator is used is declared outside of a
-                    // function scope (that is, as a global- or module-scope object; which it
-                    // ordinarily will be), initializing the PDM history within the
-                    // constructor forces the compiler to allocate the object on _all tiles_.
-                    // Being allocated on a tile where it is not used does not by itself break
-                    // anything, but it does result in less memory being available for other
-                    // things on that tile. Initializing the history in this way prevents
-                    // that.
-          = {[0 ...(MIC_COUNT - 1)] = {[0 ... 7] = 0x55555555}}
-#endif
-      ;
+      PdmHistory<2 * MIC_COUNT, HISTORY_STEPS> pdm_history;
     } stage1;
 
+    /**
+     * Coefficients posted by @ref SwapCoefficients().
+     */
+    CoefficientSwap<> swap;
+
+    /**
+     * Crossfade from the coefficients replaced by the last swap.
+     */
+    struct {
+      /**
+       * Output samples in the crossfade; `0` if none is in progress.
+       */
+      unsigned length = 0;
+      /**
+       * Output samples of the crossfade produced so far.
+       */
+      unsigned step = 0;
+      /**
+       * Old filter coefficients.
+       */
+      const uint32_t* coef = nullptr;
+    } fade;
+
+    /**
+     * @brief Compute both phases' outputs for the newest PDM word of each
+     *        mic, with the given coefficients.
+     */
+    void Filter(
+        int32_t out[2][MIC_COUNT],
+        const uint32_t* coef);
+
   public:
+    /**
+     * @brief The sample filter applied to the decimator output.
+     *
+     * It is initialized by `Init()`.
+     */
+    TSampleFilter SampleFilter;
+
+    /**
+     * @brief The output shift applied to the filter output, before
+     *        @ref SampleFilter.
+     *
+     * The filter output is shifted left 3 bits, saturating, by default. 
+     * `Scaler.SetShift()` trades headroom for resolution, and 
+     * `Scaler.ClippedSamples()` counts the samples which saturated. See
+     * @ref OutputScaler. It is not reset by `Init()`.
+     */
+    OutputScaler Scaler{3};
+
     constexpr OneStageDecimator192() noexcept {}
 
     /**
      * @brief Initialize the decimator.
      *
-     * Sets the stage 1 filter coefficients. The decimator must be
-     * initialized before any calls to `ProcessBlock()`.
+     * Sets the stage 1 filter coefficients, and initializes
+     * @ref SampleFilter. The decimator must be initialized before any calls
+     * to `ProcessBlock()`.
+     *
+     * It must not be called while another thread is running the decimator;
+     * @ref SwapCoefficients() changes the coefficients of a running one.
+     *
+     * `filter_coef` is a single 256-tap block in the format described for
+     * `fir_1x16_bit()` (with `S1_COEF_BITS` bit-planes), and the 16 taps
+     * applied to the newest PDM samples must be zero (see above).
+     * `python/stage1_192.py` generates such tables, as a header, from filter
+     * design parameters. The table must stay valid for as long as the
+     * decimator is used. The default, `s1_fir_coef` (or
+     * `s1_fir_coef_min_phase` if @ref MIC_ARRAY_CONFIG_MIN_PHASE_FILTERS is
+     * enabled), is only valid when `S1_COEF_BITS` is 16.
      *
+     * @param filter_coef Stage 1 filter coefficients, shared by both phases.
      */
-    void Init();
+    void Init(
+        const uint32_t* filter_coef = MIC_ARRAY_CONFIG_MIN_PHASE_FILTERS? 
+                                          s1_fir_coef_min_phase : s1_fir_coef);
+
+    /**
+     * @brief Switch to new filter coefficients while the decimator runs.
+     *
+     * As @ref TwoStageDecimator::SwapCoefficients(): this may be called from
+     * another thread on the same tile while the decimator is running, and
+     * the new coefficients take effect at the start of a block, keeping the
+     * PDM history. `filter_coef` is switched to by pointer, so must stay 
+     * valid while in use, and must meet the requirements of @ref Init().
+     *
+     * With a non-zero `fade_samples`, the output crossfades linearly from
+     * the old coefficients to the new over that many output samples, during
+     * which the filter is evaluated twice.
+     *
+     * @param filter_coef   New filter coefficients.
+     * @param fade_samples  Length of the crossfade, in output samples.
+     *
+     * @returns `false`, and nothing changes, if a previous swap is still
+     *          pending.
+     */
+    bool SwapCoefficients(
+        const uint32_t* filter_coef,
+        const unsigned fade_samples = 0);
+
+    /**
+     * @brief Whether the last @ref SwapCoefficients() has yet to take 
+     *        effect.
+     */
+    bool SwapPending() const;
 
     /**
      * @brief Process one block of PDM data.
      *
-     * Processes a block of PDM data to produce two output sample from the
-     * first stage decimator.
+     * Processes a block of PDM data to produce two output samples per PDM
+     * word of each mic.
      *
-     * One `pdm_block` (32bit) contains enough PDM samples to produce two output
-     * samples from the first stage decimator. (32 / 16 = 2)
+     * Each 32-bit word of `pdm_block` contains enough PDM samples to produce
+     * two output samples. (32 / 16 = 2)
      *
-     * Two output samples from the first stage decimator are computed and
-     * written to `sample_out[2][]`.
+     * `pdm_block` holds `SUBBLOCKS` words for each mic, oldest first, as
+     * `[MIC_COUNT][SUBBLOCKS]`. The `2*SUBBLOCKS` output samples are written
+     * to `sample_out[][]`, oldest first.
      *
      * @param sample_out  Output sample vector.
      * @param pdm_block   PDM data to be processed.
      */
     void ProcessBlock(
-        int32_t sample_out[2][MIC_COUNT],
-        uint32_t pdm_block[MIC_COUNT]);
+        int32_t sample_out[SamplesPerBlock][MIC_COUNT],
+        uint32_t pdm_block[BLOCK_SIZE]);
   };
 
 }
@@ -163,25 +323,150 @@ namespace mic_array
 // Template function implementations below. //
 //////////////////////////////////////////////
 
-template <unsigned MIC_COUNT>
-void mic_array::OneStageDecimator192<MIC_COUNT>::Init()
+template <unsigned MIC_COUNT, class TSampleFilter, unsigned S1_COEF_BITS,
+          unsigned SUBBLOCKS>
+constexpr unsigned mic_array::OneStageDecimator192<MIC_COUNT, TSampleFilter, 
+                                                   S1_COEF_BITS, 
+                                                   SUBBLOCKS>::Latency(
+    const unsigned group_delay)
 {
-  this->stage1.filter_coef[0] = s1_fir_zero_after;
-  this->stage1.filter_coef[1] = s1_fir_zero_before;
+  return group_delay + 32 * (SUBBLOCKS - 1);
 }
 
-template <unsigned MIC_COUNT>
-void mic_array::OneStageDecimator192<MIC_COUNT>::ProcessBlock(
-    int32_t sample_out[2][MIC_COUNT],
-    uint32_t pdm_block[MIC_COUNT])
+template <unsigned MIC_COUNT, class TSampleFilter, unsigned S1_COEF_BITS,
+          unsigned SUBBLOCKS>
+constexpr float mic_array::OneStageDecimator192<MIC_COUNT, TSampleFilter, 
+                                                S1_COEF_BITS, 
+                                                SUBBLOCKS>::RequiredMips(
+    const unsigned pdm_freq)
 {
-  for (size_t mic = 0; mic < MIC_COUNT; mic++)
-  {
-    uint32_t *hist = &this->stage1.pdm_history[mic][0];
+  return MIC_COUNT * ((pdm_freq / 32.0f) 
+                          * (2 * (S1_COEF_BITS * KernelCost::FirPlane 
+                                  + KernelCost::FirOutput) 
+                             + KernelCost::HistoryWord)
+                    + (pdm_freq / float(SamplePeriod)) 
+                          * KernelCost::ScaleSample) / 1e6f;
+}
+
+template <unsigned MIC_COUNT, class TSampleFilter, unsigned S1_COEF_BITS,
+          unsigned SUBBLOCKS>
+void mic_array::OneStageDecimator192<MIC_COUNT, TSampleFilter, 
+                                     S1_COEF_BITS, SUBBLOCKS>::Init(
+    const uint32_t* filter_coef)
+{
+  assert(S1_COEF_BITS == 16 || (filter_coef != s1_fir_coef && 
+                                filter_coef != s1_fir_coef_min_phase));
+  this->stage1.filter_coef = filter_coef;
+  this->fade.length = 0;
+  this->fade.step = 0;
+  this->SampleFilter.Init();
+}
+
+template <unsigned MIC_COUNT, class TSampleFilter, unsigned S1_COEF_BITS,
+          unsigned SUBBLOCKS>
+bool mic_array::OneStageDecimator192<MIC_COUNT, TSampleFilter, 
+                                     S1_COEF_BITS, SUBBLOCKS>::SwapCoefficients(
+    const uint32_t* filter_coef,
+    const unsigned fade_samples)
+{
+  assert(filter_coef != nullptr);
+  assert(S1_COEF_BITS == 16 || (filter_coef != s1_fir_coef && 
+                                filter_coef != s1_fir_coef_min_phase));
+  return this->swap.Request(filter_coef, nullptr, 0, fade_samples);
+}
+
+template <unsigned MIC_COUNT, class TSampleFilter, unsigned S1_COEF_BITS,
+          unsigned SUBBLOCKS>
+bool mic_array::OneStageDecimator192<MIC_COUNT, TSampleFilter, 
+                                     S1_COEF_BITS, SUBBLOCKS>::SwapPending() const
+{
+  return this->swap.Pending();
+}
+
+template <unsigned MIC_COUNT, class TSampleFilter, unsigned S1_COEF_BITS,
+          unsigned SUBBLOCKS>
+void mic_array::OneStageDecimator192<MIC_COUNT, TSampleFilter, 
+                                     S1_COEF_BITS, SUBBLOCKS>::Filter(
+    int32_t out[2][MIC_COUNT],
+    const uint32_t* coef)
+{
+  auto& hist = this->stage1.pdm_history;
 
-    hist[0] = pdm_block[mic];
-    sample_out[0][mic] = (fir_1x16_bit(hist, this->stage1.filter_coef[0]) << 3);
-    sample_out[1][mic] = (fir_1x16_bit(hist, this->stage1.filter_coef[1]) << 3);
-    shift_buffer(hist);
+  if(2 * MIC_COUNT >= FIR_1X16_BIT_MULTI_MIN_CHANNELS || S1_COEF_BITS != 16){
+    fir_1x16_bit_channels<2 * MIC_COUNT, S1_COEF_BITS>(&out[0][0], 
+                                                       hist.Window(0), hist.Stride, 
+                                                       coef);
+  } else {
+    for(unsigned mic = 0; mic < MIC_COUNT; mic++){
+      int32_t streams[2];
+      fir_1x16_bit_dual_signal(streams, hist.Window(mic), 
+                               hist.Window(MIC_COUNT + mic),
+                               coef);
+      out[0][mic] = streams[0];
+      out[1][mic] = streams[1];
+    }
   }
 }
+
+template <unsigned MIC_COUNT, class TSampleFilter, unsigned S1_COEF_BITS,
+          unsigned SUBBLOCKS>
+void mic_array::OneStageDecimator192<MIC_COUNT, TSampleFilter, 
+                                     S1_COEF_BITS, SUBBLOCKS>::ProcessBlock(
+    int32_t sample_out[SamplesPerBlock][MIC_COUNT],
+    uint32_t pdm_block[BLOCK_SIZE])
+{
+  auto& hist = this->stage1.pdm_history;
+
+  // Coefficients only change between blocks, once any crossfade is over.
+  const uint32_t* new_coef;
+  const int32_t* unused_coef;
+  right_shift_t unused_shr;
+  unsigned fade_samples;
+  if(this->fade.step >= this->fade.length
+      && this->swap.Take(new_coef, unused_coef, unused_shr, fade_samples)){
+    this->fade.coef = this->stage1.filter_coef;
+    this->fade.length = fade_samples;
+    this->fade.step = 0;
+    this->stage1.filter_coef = new_coef;
+  }
+
+  for(unsigned sb = 0; sb < SUBBLOCKS; sb++){
+    int32_t (*out)[MIC_COUNT] = &sample_out[2 * sb];
+
+    // The upper half of each new PDM word completes the delayed copy's
+    // previous newest word.
+    for(unsigned mic = 0; mic < MIC_COUNT; mic++){
+      uint32_t* newest = &hist.Window(MIC_COUNT + mic)[0];
+      newest[0] = (newest[0] & 0xFFFF) | (pdm_block[mic * SUBBLOCKS + sb] << 16);
+    }
+
+    hist.Advance();
+
+    for(unsigned mic = 0; mic < MIC_COUNT; mic++){
+      const uint32_t word = pdm_block[mic * SUBBLOCKS + sb];
+      hist.Set(mic, word);
+      hist.Set(MIC_COUNT + mic, word >> 16);
+    }
+
+    this->Filter(out, this->stage1.filter_coef);
+
+    if(this->fade.step < this->fade.length){
+      int32_t old_out[2][MIC_COUNT];
+      this->Filter(old_out, this->fade.coef);
+      for(unsigned p = 0; p < 2; p++){
+        this->fade.step++;
+        for(unsigned mic = 0; mic < MIC_COUNT; mic++)
+          out[p][mic] = crossfade_sample(old_out[p][mic], out[p][mic],
+                                         this->fade.step, this->fade.length);
+      }
+    }
+  }
+
+  // One output shift for the whole block.
+  this->Scaler.Apply(&sample_out[0][0], SamplesPerBlock * MIC_COUNT);
+
+  for(unsigned s = 0; s < SamplesPerBlock; s++)
+    for(unsigned mic = 0; mic < MIC_COUNT; mic++)
+      sample_out[s][mic] = this->SampleFilter.FilterChannel(mic, 
+                                                            sample_out[s][mic]);
+}
@@ -0,0 +1,294 @@
+// Copyright 2022-2024 XMOS LIMITED.
+// This Software is subject to the terms of the XMOS Public Licence: Version 1.
+
+#pragma once
+
+#include <cstdint>
+#include <cassert>
+
+#include "xmath/xmath.h"
+#include "mic_array/etc/fir_1x16_bit.h"
+#include "mic_array/etc/filters_default.h"
+#include "Decimator.hpp"
+#include "PdmHistory.hpp"
+#include "Stage2Filter.hpp"
+#include "SampleFilter.hpp"
+#include "Profiler.hpp"
+
+// This has caused problems previously, so just catch the problems here.
+#if defined(MIC_COUNT) || defined(S2_DEC_FACTOR) || defined(S2_TAP_COUNT) \
+    || defined(S1_DEC_WORDS)
+# error Application must not define the following as precompiler macros: MIC_COUNT, S2_DEC_FACTOR, S2_TAP_COUNT, S1_DEC_WORDS.
+#endif
+
+
+namespace  mic_array {
+
+/**
+ * @brief Two stage decimator with a CIC first stage.
+ *
+ * This decimator has the same structure as @ref TwoStageDecimator, but its
+ * first stage is meant for a CIC (`sinc^N`) filter, which decimates by
+ * `32 * S1_DEC_WORDS` rather than by 32, followed by a second stage FIR
+ * which compensates the CIC's passband droop. It is intended for arrays of
+ * many microphones where the stopband requirements are modest, since stage
+ * 1 is most of the cost of @ref TwoStageDecimator.
+ *
+ * The CIC is evaluated in its non-recursive form, with the same 1-bit
+ * `VLMACCR1` kernels as the other decimators, on all channels together (see
+ * `fir_1x16_bit_channels()`). Its impulse response is short and has small
+ * integer taps, so an order 4 CIC decimating by 64 fits in the 256 taps of
+ * a single call, with 8-bit coefficients. With the default filters
+ * (@ref cic_stage1_coef and @ref cic_stage2_coef, `S1_DEC_WORDS` of 2 and
+ * `S2_DEC_FACTOR` of 3) each 16 kHz output sample costs 3 stage 1 outputs of
+ * 8 `VLMACCR1` each per microphone, against 6 of 16 for
+ * @ref TwoStageDecimator with its default filters: a quarter of the stage 1
+ * work. Stage 2 runs at half the rate, but with a longer filter, so costs
+ * about the same.
+ *
+ * The price is the stopband of stage 1: the default CIC attenuates
+ * everything which can alias into a 16 kHz output by at least 58 dB, against
+ * about 100 dB for @ref stage1_coef. The decimator's output is otherwise a
+ * drop-in replacement for that of @ref TwoStageDecimator, with the same PDM
+ * block layout when `S1_DEC_WORDS * S2_DEC_FACTOR` is the same, and the same
+ * DC gain with the default filters.
+ *
+ * As with @ref TwoStageDecimator, `TSampleFilter` is applied to each output
+ * sample as it is produced.
+ *
+ * @tparam MIC_COUNT      Number of microphone channels.
+ * @tparam S2_DEC_FACTOR  Stage 2 decimation factor.
+ * @tparam S2_TAP_COUNT   Stage 2 tap count.
+ * @tparam TSampleFilter  Sample filter applied to the decimator output.
+ * @tparam S1_DEC_WORDS   PDM words per microphone per stage 1 output.
+ * @tparam S1_COEF_BITS   Bits per stage 1 coefficient: 16, 12 or 8.
+ */
+template <unsigned MIC_COUNT,
+          unsigned S2_DEC_FACTOR = CIC_STAGE2_DEC_FACTOR,
+          unsigned S2_TAP_COUNT = CIC_STAGE2_TAP_COUNT,
+          class TSampleFilter = NopSampleFilter<MIC_COUNT>,
+          unsigned S1_DEC_WORDS = CIC_STAGE1_DEC_WORDS,
+          unsigned S1_COEF_BITS = CIC_STAGE1_COEF_BITS>
+class CicDecimator
+{
+
+  static_assert(S1_COEF_BITS == 16 || S1_COEF_BITS == 12 || S1_COEF_BITS == 8,
+                "S1_COEF_BITS must be 16, 12 or 8.");
+  static_assert(S1_DEC_WORDS >= 1 && S1_DEC_WORDS <= 8,
+                "S1_DEC_WORDS must be from 1 to 8.");
+
+  public:
+    /**
+     * Size of a block of PDM data in words.
+     */
+    static constexpr unsigned BLOCK_SIZE = MIC_COUNT * S1_DEC_WORDS
+                                                     * S2_DEC_FACTOR;
+
+    /**
+     * Number of microphone channels.
+     */
+    static constexpr unsigned MicCount = MIC_COUNT;
+
+    /**
+     * Number of words in the stage 1 filter coefficient table.
+     */
+    static constexpr unsigned Stage1CoefWords =
+        Fir1xNBit<S1_COEF_BITS>::CoefWords;
+
+    /**
+     * Output sample period, in PDM clock periods.
+     */
+    static constexpr unsigned SamplePeriod = 32 * S1_DEC_WORDS * S2_DEC_FACTOR;
+
+    /**
+     * Output for a full scale PDM signal, with the default filters and no
+     * output shift; the same as @ref TwoStageDecimator::FullScale. See
+     * @ref DecimatorFullScale.
+     */
+    static constexpr int32_t FullScale = STAGE2_FULL_SCALE;
+
+    /**
+     * @brief Latency of the decimator, in PDM clock periods.
+     *
+     * As @ref TwoStageDecimator::Latency(). The defaults are the group delays
+     * of @ref cic_stage1_coef and @ref cic_stage2_coef.
+     *
+     * @param s1_group_delay  Stage 1 filter group delay, in PDM clock periods.
+     * @param s2_group_delay  Stage 2 filter group delay, in PDM clock periods.
+     */
+    static constexpr unsigned Latency(
+        const unsigned s1_group_delay = CIC_STAGE1_GROUP_DELAY,
+        const unsigned s2_group_delay = CIC_STAGE2_GROUP_DELAY);
+
+  private:
+
+    /**
+     * Stage 1 decimator configuration and state.
+     */
+    struct {
+      /**
+       * Pointer to filter coefficients for Stage 1
+       */
+      const uint32_t* filter_coef;
+      /**
+       * Filter state (PDM history) for stage 1 filters.
+       */
+      PdmHistory<MIC_COUNT, S1_DEC_WORDS * S2_DEC_FACTOR> pdm_history;
+    } stage1;
+
+    /**
+     * Stage 2 decimation configuration and state.
+     */
+    struct {
+      /**
+       * Stage 2 FIR filter and history for all mics.
+       */
+      Stage2Filter<MIC_COUNT, S2_TAP_COUNT, S2_DEC_FACTOR> filter;
+    } stage2;
+
+  public:
+
+    /**
+     * @brief The sample filter applied to the decimator output.
+     *
+     * It is initialized by `Init()`.
+     */
+    TSampleFilter SampleFilter;
+
+#if MIC_ARRAY_CONFIG_PROFILE
+    /**
+     * @brief Profiler into which each block's stage 1 and stage 2 time is
+     *        recorded, if not null.
+     *
+     * Only present when @ref MIC_ARRAY_CONFIG_PROFILE is enabled.
+     */
+    StageProfiler* Profiler = nullptr;
+#endif
+
+    constexpr CicDecimator() noexcept { }
+
+    /**
+     * @brief Initialize the decimator.
+     *
+     * Sets the stage 1 and 2 filter coefficients, and initializes
+     * @ref SampleFilter. The decimator must be initialized before any calls
+     * to `ProcessBlock()`.
+     *
+     * The stage 1 filter is `Stage1CoefWords` words in the format described
+     * for `fir_1x16_bit()`, with `S1_COEF_BITS` bit-planes. Its output is
+     * evaluated once every `S1_DEC_WORDS` PDM words, so its impulse response
+     * should span at most 256 PDM samples. `python/stage1_cic.py` generates
+     * CIC stage 1 filters and their compensating stage 2 filters. The
+     * defaults, @ref cic_stage1_coef, @ref cic_stage2_coef and
+     * @ref cic_stage2_shr, are for the default template parameters.
+     *
+     * @param s1_filter_coef  Stage 1 filter coefficients.
+     * @param s2_filter_coef  Stage 2 filter coefficients.
+     * @param s2_filter_shr   Stage 2 filter right-shift.
+     */
+    void Init(
+        const uint32_t* s1_filter_coef = cic_stage1_coef,
+        const int32_t* s2_filter_coef = cic_stage2_coef,
+        const right_shift_t s2_filter_shr = cic_stage2_shr);
+
+    /**
+     * @brief Process one block of PDM data.
+     *
+     * Processes a block of PDM data to produce an output sample from the
+     * second stage decimator. The layout of `pdm_block` is that described for
+     * @ref TwoStageDecimator::ProcessBlock(), with
+     * `S1_DEC_WORDS * S2_DEC_FACTOR` words per microphone.
+     *
+     * @param sample_out  Output sample vector.
+     * @param pdm_block   PDM data to be processed.
+     */
+    void ProcessBlock(
+        int32_t sample_out[MIC_COUNT],
+        uint32_t pdm_block[BLOCK_SIZE]);
+  };
+}
+
+//////////////////////////////////////////////
+// Template function implementations below. //
+//////////////////////////////////////////////
+
+
+template <unsigned MIC_COUNT, unsigned S2_DEC_FACTOR, unsigned S2_TAP_COUNT,
+          class TSampleFilter, unsigned S1_DEC_WORDS, unsigned S1_COEF_BITS>
+constexpr unsigned mic_array::CicDecimator<MIC_COUNT,S2_DEC_FACTOR,
+                                           S2_TAP_COUNT,TSampleFilter,
+                                           S1_DEC_WORDS,S1_COEF_BITS>::Latency(
+    const unsigned s1_group_delay,
+    const unsigned s2_group_delay)
+{
+  return s1_group_delay + s2_group_delay;
+}
+
+
+template <unsigned MIC_COUNT, unsigned S2_DEC_FACTOR, unsigned S2_TAP_COUNT,
+          class TSampleFilter, unsigned S1_DEC_WORDS, unsigned S1_COEF_BITS>
+void mic_array::CicDecimator<MIC_COUNT,S2_DEC_FACTOR,S2_TAP_COUNT,
+                             TSampleFilter,S1_DEC_WORDS,S1_COEF_BITS>::Init(
+    const uint32_t* s1_filter_coef,
+    const int32_t* s2_filter_coef,
+    const right_shift_t s2_shr)
+{
+  assert(S1_COEF_BITS == CIC_STAGE1_COEF_BITS
+      || s1_filter_coef != cic_stage1_coef);
+
+  this->stage1.filter_coef = s1_filter_coef;
+
+  this->stage2.filter.Init(s2_filter_coef, s2_shr);
+
+  this->SampleFilter.Init();
+}
+
+
+template <unsigned MIC_COUNT, unsigned S2_DEC_FACTOR, unsigned S2_TAP_COUNT,
+          class TSampleFilter, unsigned S1_DEC_WORDS, unsigned S1_COEF_BITS>
+void mic_array::CicDecimator<MIC_COUNT,S2_DEC_FACTOR,S2_TAP_COUNT,
+                             TSampleFilter,S1_DEC_WORDS,S1_COEF_BITS>
+    ::ProcessBlock(
+        int32_t sample_out[MIC_COUNT],
+        uint32_t pdm_block[BLOCK_SIZE])
+{
+  constexpr unsigned BLOCK_WORDS = S1_DEC_WORDS * S2_DEC_FACTOR;
+
+  MIC_ARRAY_PROFILE(const uint32_t start = StageProfiler::Now());
+
+  for(unsigned k = 0; k < S2_DEC_FACTOR; k++){
+    int32_t streamA_sample[MIC_COUNT];
+
+    // Every word enters the history, but stage 1 is only evaluated once
+    // per S1_DEC_WORDS words.
+    for(unsigned w = 0; w < S1_DEC_WORDS; w++){
+      this->stage1.pdm_history.Advance();
+      for(unsigned mic = 0; mic < MIC_COUNT; mic++)
+        this->stage1.pdm_history.Set(mic,
+            pdm_block[mic * BLOCK_WORDS + k * S1_DEC_WORDS + w]);
+    }
+
+    fir_1x16_bit_channels<MIC_COUNT,S1_COEF_BITS>(streamA_sample,
+                                                  this->stage1.pdm_history.Window(0),
+                                                  this->stage1.pdm_history.Stride,
+                                                  this->stage1.filter_coef);
+
+    this->stage2.filter.Advance();
+    for(unsigned mic = 0; mic < MIC_COUNT; mic++)
+      this->stage2.filter.Set(mic, streamA_sample[mic]);
+  }
+
+  MIC_ARRAY_PROFILE(const uint32_t stage1_end = StageProfiler::Now());
+
+  int32_t sample[MIC_COUNT];
+  this->stage2.filter.Filter(sample);
+
+  for(unsigned mic = 0; mic < MIC_COUNT; mic++)
+    sample_out[mic] = this->SampleFilter.FilterChannel(mic, sample[mic]);
+
+  MIC_ARRAY_PROFILE(
+    if(this->Profiler){
+      this->Profiler->Add(PROFILE_STAGE1, stage1_end - start);
+      this->Profiler->Add(PROFILE_STAGE2, StageProfiler::Now() - stage1_end);
+    });
+}
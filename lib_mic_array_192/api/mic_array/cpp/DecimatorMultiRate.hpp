@@ -0,0 +1,362 @@
+// Copyright 2022-2024 XMOS LIMITED.
+// This Software is subject to the terms of the XMOS Public Licence: Version 1.
+
+#pragma once
+
+#include <cstdint>
+#include <cassert>
+
+#include "xmath/xmath.h"
+#include "Decimator.hpp"
+#include "PdmHistory.hpp"
+#include "Stage2Filter.hpp"
+
+// This has caused problems previously, so just catch the problems here.
+#if defined(MIC_COUNT) || defined(BLOCK_WORDS) || defined(MAX_S2_TAP_COUNT)
+# error Application must not define the following as precompiler macros: MIC_COUNT, BLOCK_WORDS, MAX_S2_TAP_COUNT.
+#endif
+
+
+namespace  mic_array {
+
+/**
+ * @brief Two stage decimator whose output sample rate can be changed while
+ *        it is running.
+ *
+ * This decimator has the same structure as @ref TwoStageDecimator; a fixed
+ * 1-bit first stage filter decimating by 32, followed by a 32-bit second stage
+ * FIR. The second stage's coefficients and decimation factor are not fixed at
+ * compile time but given by a @ref Stage2Config, which can be replaced with
+ * @ref SetStage2() at any time. The new configuration is applied at the start
+ * of the next PDM block.
+ *
+ * Switching rates keeps all of the decimator's state. The stage 1 PDM history
+ * is unaffected, and the stage 2 history holds stage 1 output samples, which
+ * do not depend on the stage 2 configuration. The first output sample after a
+ * switch is therefore already fully converged; the only discontinuity is the
+ * change of sample rate itself.
+ *
+ * Each PDM block carries `BLOCK_WORDS` PDM words per microphone (so
+ * `BLOCK_WORDS` stage 1 samples), and the number of output samples produced
+ * from it depends on the current stage 2 decimation factor.
+ * @ref ProcessBlock() returns that number, which is how @ref MicArray knows
+ * how many of the samples it should pass on (see @ref MicArray::Decimator).
+ * Where the decimation factor divides `BLOCK_WORDS`, every block produces the
+ * same number of samples.
+ *
+ * A configuration may also restrict decimation to the first few microphones
+ * (see @ref Stage2Config::mic_count), for a low-power mode. Together with a
+ * change of PDM clock rate (see `mic_array_pdm_clock_set_divide()`), this
+ * lets an application switch between e.g. a single microphone at a reduced
+ * PDM clock and output rate, and the full array, without restarting the mic
+ * array. See \verbatim embed:rst :ref:`power_modes` \endverbatim.
+ *
+ * @tparam MIC_COUNT        Number of microphone channels.
+ * @tparam BLOCK_WORDS      PDM words per microphone in each block.
+ * @tparam MAX_S2_TAP_COUNT @parblock
+ * Largest stage 2 tap count of any configuration which will be used. The
+ * stage 2 history and coefficient buffers are sized for this many taps.
+ * @endparblock
+ */
+template <unsigned MIC_COUNT, unsigned BLOCK_WORDS, unsigned MAX_S2_TAP_COUNT>
+class MultiRateDecimator
+{
+
+  public:
+    /**
+     * Size of a block of PDM data in words.
+     */
+    static constexpr unsigned BLOCK_SIZE = MIC_COUNT * BLOCK_WORDS;
+
+    /**
+     * Number of microphone channels.
+     */
+    static constexpr unsigned MicCount = MIC_COUNT;
+
+    /**
+     * Maximum number of output samples produced per block (with a stage 2
+     * decimation factor of 1).
+     */
+    static constexpr unsigned SamplesPerBlock = BLOCK_WORDS;
+
+    /**
+     * @brief Stage 2 filter configuration.
+     *
+     * Objects of this type are referenced, not copied, by the decimator, so
+     * they must remain valid while in use. Usually they will be `static
+     * const` tables, one per supported output rate.
+     */
+    struct Stage2Config {
+      /**
+       * Stage 2 filter coefficients, `tap_count` words.
+       */
+      const int32_t* coef;
+      /**
+       * Number of stage 2 filter taps, at most `MAX_S2_TAP_COUNT`.
+       */
+      unsigned tap_count;
+      /**
+       * Stage 2 decimation factor, at least 1.
+       */
+      unsigned dec_factor;
+      /**
+       * Stage 2 output right-shift.
+       */
+      right_shift_t shr;
+      /**
+       * @brief Number of microphones decimated, or `0` for all `MIC_COUNT`.
+       *
+       * Only microphones `0` to `mic_count - 1` are decimated while this
+       * configuration is applied; the output samples of the others are zero,
+       * and their filter state is reset to silence when they are switched
+       * back on, so they start with the usual filter transient. At most
+       * `MIC_COUNT`.
+       */
+      unsigned mic_count;
+    };
+
+  private:
+
+    /**
+     * Stage 1 decimator configuration and state.
+     */
+    struct {
+      /**
+       * Pointer to filter coefficients for Stage 1
+       */
+      const uint32_t* filter_coef;
+      /**
+       * Filter state (PDM history) for stage 1 filters.
+       */
+      PdmHistory<MIC_COUNT, BLOCK_WORDS> pdm_history;
+    } stage1;
+
+    /**
+     * Stage 2 decimation configuration and state.
+     */
+    struct {
+      /**
+       * Stage 2 FIR filter and history for all mics.
+       */
+      Stage2Filter<MIC_COUNT, MAX_S2_TAP_COUNT, BLOCK_WORDS> filter;
+      /**
+       * Current stage 2 decimation factor.
+       */
+      unsigned dec_factor = 1;
+      /**
+       * Stage 1 samples since the last output sample.
+       */
+      unsigned phase = 0;
+    } stage2;
+
+    /**
+     * Number of microphones currently decimated.
+     */
+    unsigned mic_count = MIC_COUNT;
+
+    /**
+     * Configuration most recently requested with @ref SetStage2().
+     */
+    const Stage2Config* volatile requested = nullptr;
+
+    /**
+     * Configuration currently in use.
+     */
+    const Stage2Config* applied = nullptr;
+
+  public:
+
+    constexpr MultiRateDecimator() noexcept { }
+
+    /**
+     * @brief Initialize the decimator.
+     *
+     * Sets the stage 1 filter coefficients and the initial stage 2
+     * configuration. The decimator must be initialized before
+     * @ref ProcessBlock() is called.
+     *
+     * @param s1_filter_coef  @parblock
+     *        Stage 1 filter coefficients.
+     *        \verbatim embed:rst
+              See :c:var:`stage1_coef`.\endverbatim
+     *        @endparblock
+     * @param s2_config       Initial stage 2 configuration.
+     */
+    void Init(
+        const uint32_t* s1_filter_coef,
+        const Stage2Config* s2_config);
+
+    /**
+     * @brief Request a new stage 2 configuration.
+     *
+     * The configuration is applied at the start of the next call to
+     * @ref ProcessBlock(). This may be called from any thread on the same
+     * tile as the decimator, e.g. the thread which receives the mic array's
+     * output, instead of sending a command over a channel. If it is called
+     * more than once before the next block, only the most recent request is
+     * applied.
+     *
+     * @param s2_config New stage 2 configuration.
+     */
+    void SetStage2(
+        const Stage2Config* s2_config);
+
+    /**
+     * @brief Get the stage 2 configuration currently in use.
+     *
+     * @returns The configuration applied at the start of the most recent
+     *          block.
+     */
+    const Stage2Config* GetStage2() const;
+
+    /**
+     * @brief Process one block of PDM data.
+     *
+     * The layout of `pdm_block` is that of @ref TwoStageDecimator, with
+     * `BLOCK_WORDS` words per microphone:
+     *
+     * @code{.cpp}
+     *  struct {
+     *    struct {
+     *      // lower word indices are older samples.
+     *      // less significant bits in a word are older samples.
+     *      uint32_t samples[BLOCK_WORDS];
+     *    } microphone[MIC_COUNT]; // mic channels are in ascending order
+     *  } pdm_block;
+     * @endcode
+     *
+     * The output samples are written to `sample_out[0]` onwards, oldest
+     * first.
+     *
+     * @param sample_out  Output samples.
+     * @param pdm_block   PDM data to be processed.
+     *
+     * @returns Number of output samples written to `sample_out`.
+     */
+    unsigned ProcessBlock(
+        int32_t sample_out[BLOCK_WORDS][MIC_COUNT],
+        uint32_t pdm_block[BLOCK_SIZE]);
+
+  private:
+
+    /**
+     * @brief Switch stage 2 to a new configuration.
+     */
+    void ApplyStage2(
+        const Stage2Config* s2_config);
+};
+
+}
+
+//////////////////////////////////////////////
+// Template function implementations below. //
+//////////////////////////////////////////////
+
+
+template <unsigned MIC_COUNT, unsigned BLOCK_WORDS, unsigned MAX_S2_TAP_COUNT>
+void mic_array::MultiRateDecimator<MIC_COUNT,BLOCK_WORDS,MAX_S2_TAP_COUNT>::Init(
+    const uint32_t* s1_filter_coef,
+    const Stage2Config* s2_config)
+{
+  this->stage1.filter_coef = s1_filter_coef;
+  this->requested = s2_config;
+  this->ApplyStage2(s2_config);
+}
+
+
+template <unsigned MIC_COUNT, unsigned BLOCK_WORDS, unsigned MAX_S2_TAP_COUNT>
+void mic_array::MultiRateDecimator<MIC_COUNT,BLOCK_WORDS,MAX_S2_TAP_COUNT>
+    ::SetStage2(
+        const Stage2Config* s2_config)
+{
+  this->requested = s2_config;
+}
+
+
+template <unsigned MIC_COUNT, unsigned BLOCK_WORDS, unsigned MAX_S2_TAP_COUNT>
+const typename mic_array::MultiRateDecimator<MIC_COUNT,BLOCK_WORDS,
+                                             MAX_S2_TAP_COUNT>::Stage2Config*
+    mic_array::MultiRateDecimator<MIC_COUNT,BLOCK_WORDS,MAX_S2_TAP_COUNT>
+    ::GetStage2() const
+{
+  return this->applied;
+}
+
+
+template <unsigned MIC_COUNT, unsigned BLOCK_WORDS, unsigned MAX_S2_TAP_COUNT>
+void mic_array::MultiRateDecimator<MIC_COUNT,BLOCK_WORDS,MAX_S2_TAP_COUNT>
+    ::ApplyStage2(
+        const Stage2Config* s2_config)
+{
+  assert(s2_config->dec_factor >= 1);
+  assert(s2_config->mic_count <= MIC_COUNT);
+
+  const unsigned mic_count = s2_config->mic_count? s2_config->mic_count 
+                                                 : MIC_COUNT;
+
+  // Microphones being switched back on start from silence rather than from
+  // whatever they last held.
+  for(unsigned mic = this->mic_count; mic < mic_count; mic++){
+    this->stage1.pdm_history.Fill(mic, 0x55555555);
+    this->stage2.filter.Fill(mic, 0);
+  }
+  this->mic_count = mic_count;
+
+  this->stage2.filter.Init(s2_config->coef, s2_config->tap_count,
+                           s2_config->shr);
+  this->stage2.dec_factor = s2_config->dec_factor;
+  this->stage2.phase = 0;
+  this->applied = s2_config;
+}
+
+
+template <unsigned MIC_COUNT, unsigned BLOCK_WORDS, unsigned MAX_S2_TAP_COUNT>
+unsigned mic_array::MultiRateDecimator<MIC_COUNT,BLOCK_WORDS,MAX_S2_TAP_COUNT>
+    ::ProcessBlock(
+        int32_t sample_out[BLOCK_WORDS][MIC_COUNT],
+        uint32_t pdm_block[BLOCK_SIZE])
+{
+  // Only a single word is read from `requested`, so a concurrent
+  // SetStage2() is either seen now or at the next block.
+  const Stage2Config* s2_config = this->requested;
+  if(s2_config != this->applied)
+    this->ApplyStage2(s2_config);
+
+  uint32_t (*pdm_data)[BLOCK_WORDS] = (uint32_t (*)[BLOCK_WORDS]) pdm_block;
+  const unsigned mics = this->mic_count;
+  unsigned count = 0;
+
+  for(unsigned k = 0; k < BLOCK_WORDS; k++){
+    int32_t streamA_sample[MIC_COUNT];
+
+    this->stage1.pdm_history.Advance();
+    for(unsigned mic = 0; mic < mics; mic++)
+      this->stage1.pdm_history.Set(mic, pdm_data[mic][k]);
+
+    if(mics == MIC_COUNT){
+      fir_1x16_bit_channels<MIC_COUNT>(streamA_sample,
+                                       this->stage1.pdm_history.Window(0),
+                                       this->stage1.pdm_history.Stride,
+                                       this->stage1.filter_coef);
+    } else {
+      fir_1x16_bit_channels_n(streamA_sample,
+                              this->stage1.pdm_history.Window(0),
+                              this->stage1.pdm_history.Stride,
+                              this->stage1.filter_coef, mics);
+    }
+
+    this->stage2.filter.Advance();
+    for(unsigned mic = 0; mic < mics; mic++)
+      this->stage2.filter.Set(mic, streamA_sample[mic]);
+
+    if(++this->stage2.phase == this->stage2.dec_factor){
+      this->stage2.phase = 0;
+      int32_t* sample = sample_out[count++];
+      this->stage2.filter.Filter(sample, mics);
+      for(unsigned mic = mics; mic < MIC_COUNT; mic++)
+        sample[mic] = 0;
+    }
+  }
+
+  return count;
+}
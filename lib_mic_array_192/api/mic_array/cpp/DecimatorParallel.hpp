@@ -0,0 +1,690 @@
+// Copyright 2022-2024 XMOS LIMITED.
+// This Software is subject to the terms of the XMOS Public Licence: Version 1.
+
+#pragma once
+
+#include <cstdint>
+#include <cassert>
+#include <type_traits>
+
+#include <xcore/thread.h>
+#include <xcore/channel_streaming.h>
+
+#include "Decimator.hpp"
+#include "Decimator192.hpp"
+
+/**
+ * Stack size, in words, given to each worker thread of a
+ * @ref mic_array::ParallelDecimator.
+ */
+#ifndef MIC_ARRAY_PARALLEL_WORKER_STACK_WORDS
+# define MIC_ARRAY_PARALLEL_WORKER_STACK_WORDS   (400)
+#endif
+
+// This has caused problems previously, so just catch the problems here.
+#if defined(MIC_COUNT) || defined(WORKERS) || defined(FIRST_MIC) \
+    || defined(S2_DEC_FACTOR) || defined(S2_TAP_COUNT) || defined(SHARE) \
+    || defined(LEAD_MICS)
+# error Application must not define the following as precompiler macros: MIC_COUNT, WORKERS, FIRST_MIC, S2_DEC_FACTOR, S2_TAP_COUNT, SHARE, LEAD_MICS.
+#endif
+
+
+namespace  mic_array {
+
+/**
+ * @brief The share of a @ref ParallelDecimator's microphones handled by one
+ *        worker, followed by the shares of the remaining workers.
+ *
+ * The microphones `FIRST_MIC` to `MIC_COUNT-1` are split between `WORKERS`
+ * workers. This worker decimates the first @ref MicCount of them with its own
+ * `TDecimator<MicCount>`, and @ref Rest holds the remaining workers' shares.
+ * Unless `SHARE` says otherwise, shares differ in size by at most one 
+ * microphone.
+ *
+ * @tparam FIRST_MIC  Index of this worker's first microphone.
+ * @tparam MIC_COUNT  Total number of microphones in the array.
+ * @tparam WORKERS    Number of workers sharing microphones `FIRST_MIC` on.
+ * @tparam TDecimator Decimator class template, parameterized by mic count.
+ * @tparam SHARE      Number of microphones decimated by this worker.
+ */
+template <unsigned FIRST_MIC, unsigned MIC_COUNT, unsigned WORKERS,
+          template <unsigned> class TDecimator,
+          unsigned SHARE = WORKERS ? (MIC_COUNT - FIRST_MIC) / WORKERS : 0>
+class DecimatorPartition
+{
+  public:
+
+    /**
+     * Number of microphones decimated by this worker.
+     */
+    static constexpr unsigned MicCount = SHARE;
+
+    static_assert(MicCount >= 1, "Every worker needs at least one microphone.");
+    static_assert(MicCount + WORKERS - 1 <= MIC_COUNT - FIRST_MIC,
+                  "Every worker needs at least one microphone.");
+    static_assert(WORKERS > 1 || MicCount == MIC_COUNT - FIRST_MIC,
+                  "The last worker must take the remaining microphones.");
+
+    /**
+     * Type of this worker's decimator.
+     */
+    using TSubDecimator = TDecimator<MicCount>;
+
+    /**
+     * PDM words per microphone in each block.
+     */
+    static constexpr unsigned WordsPerMic = TSubDecimator::BLOCK_SIZE / MicCount;
+
+    /**
+     * Output samples produced per block.
+     */
+    static constexpr unsigned SamplesPerBlock =
+        DecimatorSamplesPerBlock<TSubDecimator>::value;
+
+    /**
+     * This worker's decimator.
+     */
+    TSubDecimator Decimator;
+
+    /**
+     * The remaining workers' shares.
+     */
+    DecimatorPartition<FIRST_MIC + MicCount, MIC_COUNT, WORKERS - 1,
+                       TDecimator> Rest;
+
+  private:
+
+    /**
+     * Output of the whole array for the current block,
+     * `int32_t[SamplesPerBlock][MIC_COUNT]`.
+     */
+    int32_t* sample_out = nullptr;
+
+    /**
+     * PDM data of the whole array for the current block.
+     */
+    uint32_t* pdm_block = nullptr;
+
+    /**
+     * Streaming channel on which this worker is woken for each block (and
+     * on which it reports that the block is done), if it runs on its own
+     * thread.
+     */
+    streaming_channel_t c_worker = {0, 0};
+
+  public:
+
+    constexpr DecimatorPartition() noexcept { }
+
+    /**
+     * @brief Initialize this and the remaining workers' decimators.
+     *
+     * `args` are passed to each decimator's `Init()`.
+     */
+    template <class... Args>
+    void Init(Args... args);
+
+    /**
+     * @brief Set the block processed by this and the remaining workers.
+     */
+    void SetBlock(
+        int32_t* sample_out,
+        uint32_t* pdm_block);
+
+    /**
+     * @brief Decimate this worker's microphones of the current block.
+     */
+    void Process();
+
+    /**
+     * @brief Add a thread for this and each of the remaining workers to
+     *        `group`.
+     *
+     * Each thread waits on its own streaming channel for blocks to process.
+     * `stacks` must have room for `stack_words` words per worker.
+     */
+    void Start(
+        threadgroup_t group,
+        uint32_t* stacks,
+        unsigned stack_words);
+
+    /**
+     * @brief Send `command` to this and each of the remaining workers'
+     *        threads.
+     *
+     * A non-zero `command` makes each thread process the current block, and
+     * zero makes it return.
+     */
+    void Signal(
+        uint32_t command);
+
+    /**
+     * @brief Wait until this and each of the remaining workers' threads have
+     *        processed the current block.
+     */
+    void Wait();
+
+    /**
+     * @brief Free this and the remaining workers' channels, once their
+     *        threads have returned.
+     */
+    void Free();
+
+  private:
+
+    /**
+     * @brief Thread entry point, calls `Process()` on `partition` for each
+     *        block until told to stop.
+     */
+    static void Entry(void* partition);
+
+    /**
+     * @brief Decimate with a decimator which produces one sample per block.
+     *
+     * The sub-decimator writes straight into its slice of the output.
+     */
+    template <class T>
+    void ProcessShare(T& decimator, std::true_type);
+
+    /**
+     * @brief Decimate with a decimator which produces several samples per
+     *        block.
+     *
+     * The sub-decimator's output is copied into its columns of the output.
+     */
+    template <class T>
+    void ProcessShare(T& decimator, std::false_type);
+};
+
+// Terminates the chain of partitions; no microphones are left.
+template <unsigned FIRST_MIC, unsigned MIC_COUNT,
+          template <unsigned> class TDecimator, unsigned SHARE>
+class DecimatorPartition<FIRST_MIC, MIC_COUNT, 0, TDecimator, SHARE>
+{
+  public:
+    constexpr DecimatorPartition() noexcept { }
+    template <class... Args> void Init(Args... args) { }
+    void SetBlock(int32_t* sample_out, uint32_t* pdm_block) { }
+    void Start(threadgroup_t group, uint32_t* stacks, unsigned stack_words) { }
+    void Signal(uint32_t command) { }
+    void Wait() { }
+    void Free() { }
+};
+
+
+/**
+ * @brief Decimator which splits the microphones between several hardware
+ *        threads.
+ *
+ * The microphones are partitioned at compile time into `WORKERS` contiguous
+ * groups, and each group is decimated by its own `TDecimator<N>` (see 
+ * @ref DecimatorPartition). The first group, of `LEAD_MICS` microphones, is
+ * decimated by the thread calling @ref ProcessBlock() and the others, whose
+ * sizes differ by at most one, by `WORKERS-1` worker threads. The output is
+ * identical to that of a single `TDecimator<MIC_COUNT>`.
+ *
+ * The calling thread usually has more to do than the workers, such as
+ * getting the PDM blocks and outputting the samples, so a `LEAD_MICS` 
+ * smaller than the default can even out the load (as 
+ * @ref prefab::ScalableMicArray does).
+ *
+ * The worker threads are long-lived. They are started by the first call to
+ * @ref ProcessBlock() (or by @ref StartWorkers()), on the calling thread's
+ * tile, and are then parked on a streaming channel each. For each block,
+ * @ref ProcessBlock() only publishes the block, wakes each worker with one
+ * channel word, decimates its own group and then collects one word from each
+ * worker. No threads are allocated, and no stacks are set up, per block. The
+ * workers hold `WORKERS-1` hardware threads and `WORKERS-1` streaming
+ * channels until @ref StopWorkers() is called.
+ *
+ * `TDecimator` must accept a PDM block laid out as `[MIC][WORDS]`, so that
+ * each group's PDM data is a contiguous part of the block (as is the case for
+ * @ref TwoStageDecimator and @ref OneStageDecimator192), and must produce
+ * the same number of samples for every block.
+ *
+ * Concrete implementations of this class template are meant to be used as
+ * the `TDecimator` template parameter in the @ref MicArray class template.
+ * See also @ref ParallelTwoStageDecimator and
+ * @ref ParallelOneStageDecimator192.
+ *
+ * @tparam MIC_COUNT    Number of microphone channels.
+ * @tparam WORKERS      @parblock
+ * Number of threads the decimation is split between, including the calling
+ * thread; between 1 and `MIC_COUNT`.
+ * @endparblock
+ * @tparam TDecimator   Decimator class template, parameterized by mic count
+ *                      (see e.g. @ref OneStageDecimator192Of).
+ * @tparam STACK_WORDS  Stack size, in words, of each worker thread.
+ * @tparam LEAD_MICS    @parblock
+ * Number of microphones decimated by the calling thread. By default the
+ * smallest of `WORKERS` even shares.
+ * @endparblock
+ */
+template <unsigned MIC_COUNT, unsigned WORKERS,
+          template <unsigned> class TDecimator,
+          unsigned STACK_WORDS = MIC_ARRAY_PARALLEL_WORKER_STACK_WORDS,
+          unsigned LEAD_MICS = MIC_COUNT / WORKERS>
+class ParallelDecimator
+{
+  static_assert(WORKERS >= 1, "WORKERS must be at least 1.");
+  static_assert(WORKERS <= MIC_COUNT, "WORKERS must not exceed MIC_COUNT.");
+
+  /**
+   * Type of @ref partitions.
+   */
+  using TPartitions = DecimatorPartition<0, MIC_COUNT, WORKERS, TDecimator,
+                                         LEAD_MICS>;
+
+  private:
+
+    /**
+     * The workers' shares of the microphones.
+     */
+    TPartitions partitions;
+
+    /**
+     * Stacks of the worker threads.
+     */
+    uint32_t __attribute__((aligned(8)))
+        stacks[(WORKERS > 1)? (WORKERS-1) : 1][STACK_WORDS] = {{0}};
+
+    /**
+     * Thread group of the worker threads, while they are running.
+     */
+    threadgroup_t workers = 0;
+
+    /**
+     * Whether the worker threads are running.
+     */
+    bool running = false;
+
+  public:
+
+    /**
+     * Size of a block of PDM data in words.
+     */
+    static constexpr unsigned BLOCK_SIZE = 
+        MIC_COUNT * TPartitions::WordsPerMic;
+
+    /**
+     * Number of microphone channels.
+     */
+    static constexpr unsigned MicCount = MIC_COUNT;
+
+    /**
+     * Number of output samples produced by each call to `ProcessBlock()`.
+     */
+    static constexpr unsigned SamplesPerBlock = TPartitions::SamplesPerBlock;
+
+    /**
+     * Output sample period, in PDM clock periods.
+     */
+    static constexpr unsigned SamplePeriod = TDecimator<1>::SamplePeriod;
+
+    /**
+     * Output for a full scale PDM signal, that of `TDecimator`. See
+     * @ref DecimatorFullScale.
+     */
+    static constexpr int32_t FullScale = 
+        DecimatorFullScale<TDecimator<1>>::value;
+
+    /**
+     * @brief Latency of the decimator, in PDM clock periods.
+     * 
+     * The same as that of `TDecimator`, whose `Latency()` takes the same
+     * arguments.
+     */
+    template <class... Args>
+    static constexpr unsigned Latency(Args... args);
+
+    constexpr ParallelDecimator() noexcept { }
+
+    /**
+     * @brief Initialize the decimator.
+     *
+     * Initializes every worker's decimator with the same arguments, which
+     * are those of `TDecimator`'s `Init()`.
+     */
+    template <class... Args>
+    void Init(Args... args);
+
+    /**
+     * @brief Start the worker threads.
+     *
+     * This is done by the first call to @ref ProcessBlock() if it has not
+     * been done already. It may be called beforehand so that the first block
+     * is processed in the usual time. It must be called on the same tile as
+     * @ref ProcessBlock(). Does nothing if the workers are already running.
+     */
+    void StartWorkers();
+
+    /**
+     * @brief Stop the worker threads.
+     *
+     * Waits for the worker threads to return and frees their threads and
+     * channels. They are started again by the next call to
+     * @ref ProcessBlock(). Must not be called concurrently with
+     * @ref ProcessBlock(). Does nothing if the workers are not running.
+     */
+    void StopWorkers();
+
+    /**
+     * @brief Process one block of PDM data.
+     *
+     * Used when `SamplesPerBlock` is `1`. See the `TDecimator` type's
+     * `ProcessBlock()` for the layout of `pdm_block`.
+     *
+     * @param sample_out  Output sample vector.
+     * @param pdm_block   PDM data to be processed.
+     */
+    void ProcessBlock(
+        int32_t sample_out[MIC_COUNT],
+        uint32_t pdm_block[BLOCK_SIZE]);
+
+    /**
+     * @brief Process one block of PDM data.
+     *
+     * Used when `SamplesPerBlock` is greater than `1`. See the `TDecimator`
+     * type's `ProcessBlock()` for the layout of `pdm_block`.
+     *
+     * @param sample_out  Output samples, oldest first.
+     * @param pdm_block   PDM data to be processed.
+     */
+    void ProcessBlock(
+        int32_t sample_out[][MIC_COUNT],
+        uint32_t pdm_block[BLOCK_SIZE]);
+
+  private:
+
+    /**
+     * @brief Decimate a block with all workers.
+     */
+    void Run(
+        int32_t* sample_out,
+        uint32_t* pdm_block);
+};
+
+
+/**
+ * @brief Adapts @ref TwoStageDecimator to a class template of the mic count
+ *        only, for use with @ref ParallelDecimator.
+ */
+template <unsigned S2_DEC_FACTOR, unsigned S2_TAP_COUNT>
+struct TwoStageDecimatorOf
+{
+  /**
+   * @ref TwoStageDecimator with `MIC_COUNT` microphones.
+   */
+  template <unsigned MIC_COUNT>
+  using Type = TwoStageDecimator<MIC_COUNT, S2_DEC_FACTOR, S2_TAP_COUNT>;
+};
+
+/**
+ * @brief @ref TwoStageDecimator split between `WORKERS` threads.
+ *
+ * `Init()` takes the same arguments as @ref TwoStageDecimator::Init().
+ */
+template <unsigned MIC_COUNT, unsigned S2_DEC_FACTOR, unsigned S2_TAP_COUNT,
+          unsigned WORKERS>
+using ParallelTwoStageDecimator = ParallelDecimator<MIC_COUNT, WORKERS,
+    TwoStageDecimatorOf<S2_DEC_FACTOR, S2_TAP_COUNT>::template Type>;
+
+/**
+ * @brief Adapts @ref OneStageDecimator192 to a class template of the mic
+ *        count only, for use with @ref ParallelDecimator.
+ */
+struct OneStageDecimator192Of
+{
+  /**
+   * @ref OneStageDecimator192 with `MIC_COUNT` microphones.
+   */
+  template <unsigned MIC_COUNT>
+  using Type = OneStageDecimator192<MIC_COUNT>;
+};
+
+/**
+ * @brief @ref OneStageDecimator192 split between `WORKERS` threads.
+ *
+ * `Init()` takes the same arguments as @ref OneStageDecimator192::Init().
+ */
+template <unsigned MIC_COUNT, unsigned WORKERS>
+using ParallelOneStageDecimator192 = ParallelDecimator<MIC_COUNT, WORKERS,
+    OneStageDecimator192Of::Type>;
+
+}
+
+//////////////////////////////////////////////
+// Template function implementations below. //
+//////////////////////////////////////////////
+
+
+template <unsigned FIRST_MIC, unsigned MIC_COUNT, unsigned WORKERS,
+          template <unsigned> class TDecimator, unsigned SHARE>
+template <class... Args>
+void mic_array::DecimatorPartition<FIRST_MIC,MIC_COUNT,WORKERS,TDecimator,SHARE>
+    ::Init(Args... args)
+{
+  this->Decimator.Init(args...);
+  this->Rest.Init(args...);
+}
+
+
+template <unsigned FIRST_MIC, unsigned MIC_COUNT, unsigned WORKERS,
+          template <unsigned> class TDecimator, unsigned SHARE>
+void mic_array::DecimatorPartition<FIRST_MIC,MIC_COUNT,WORKERS,TDecimator,SHARE>
+    ::SetBlock(
+        int32_t* sample_out,
+        uint32_t* pdm_block)
+{
+  this->sample_out = sample_out;
+  this->pdm_block = pdm_block;
+  this->Rest.SetBlock(sample_out, pdm_block);
+}
+
+
+template <unsigned FIRST_MIC, unsigned MIC_COUNT, unsigned WORKERS,
+          template <unsigned> class TDecimator, unsigned SHARE>
+void mic_array::DecimatorPartition<FIRST_MIC,MIC_COUNT,WORKERS,TDecimator,SHARE>
+    ::Process()
+{
+  this->ProcessShare(this->Decimator,
+                     std::integral_constant<bool, SamplesPerBlock == 1>());
+}
+
+
+template <unsigned FIRST_MIC, unsigned MIC_COUNT, unsigned WORKERS,
+          template <unsigned> class TDecimator, unsigned SHARE>
+void mic_array::DecimatorPartition<FIRST_MIC,MIC_COUNT,WORKERS,TDecimator,SHARE>
+    ::Start(
+        threadgroup_t group,
+        uint32_t* stacks,
+        unsigned stack_words)
+{
+  this->c_worker = s_chan_alloc();
+  thread_group_add(group, Entry, this, stack_base(stacks, stack_words));
+  this->Rest.Start(group, &stacks[stack_words], stack_words);
+}
+
+
+template <unsigned FIRST_MIC, unsigned MIC_COUNT, unsigned WORKERS,
+          template <unsigned> class TDecimator, unsigned SHARE>
+void mic_array::DecimatorPartition<FIRST_MIC,MIC_COUNT,WORKERS,TDecimator,SHARE>
+    ::Signal(
+        uint32_t command)
+{
+  s_chan_out_word(this->c_worker.end_a, command);
+  this->Rest.Signal(command);
+}
+
+
+template <unsigned FIRST_MIC, unsigned MIC_COUNT, unsigned WORKERS,
+          template <unsigned> class TDecimator, unsigned SHARE>
+void mic_array::DecimatorPartition<FIRST_MIC,MIC_COUNT,WORKERS,TDecimator,SHARE>
+    ::Wait()
+{
+  s_chan_in_word(this->c_worker.end_a);
+  this->Rest.Wait();
+}
+
+
+template <unsigned FIRST_MIC, unsigned MIC_COUNT, unsigned WORKERS,
+          template <unsigned> class TDecimator, unsigned SHARE>
+void mic_array::DecimatorPartition<FIRST_MIC,MIC_COUNT,WORKERS,TDecimator,SHARE>
+    ::Free()
+{
+  s_chan_free(this->c_worker);
+  this->Rest.Free();
+}
+
+
+template <unsigned FIRST_MIC, unsigned MIC_COUNT, unsigned WORKERS,
+          template <unsigned> class TDecimator, unsigned SHARE>
+void mic_array::DecimatorPartition<FIRST_MIC,MIC_COUNT,WORKERS,TDecimator,SHARE>
+    ::Entry(void* partition)
+{
+  auto* self = reinterpret_cast<DecimatorPartition*>(partition);
+
+  // The block pointers are written before the word which wakes this thread
+  // is sent, so they are up to date once it has been received.
+  while(s_chan_in_word(self->c_worker.end_b)){
+    self->Process();
+    s_chan_out_word(self->c_worker.end_b, 1);
+  }
+}
+
+
+template <unsigned FIRST_MIC, unsigned MIC_COUNT, unsigned WORKERS,
+          template <unsigned> class TDecimator, unsigned SHARE>
+template <class T>
+void mic_array::DecimatorPartition<FIRST_MIC,MIC_COUNT,WORKERS,TDecimator,SHARE>
+    ::ProcessShare(T& decimator, std::true_type)
+{
+  decimator.ProcessBlock(&this->sample_out[FIRST_MIC],
+                         &this->pdm_block[FIRST_MIC * WordsPerMic]);
+}
+
+
+template <unsigned FIRST_MIC, unsigned MIC_COUNT, unsigned WORKERS,
+          template <unsigned> class TDecimator, unsigned SHARE>
+template <class T>
+void mic_array::DecimatorPartition<FIRST_MIC,MIC_COUNT,WORKERS,TDecimator,SHARE>
+    ::ProcessShare(T& decimator, std::false_type)
+{
+  int32_t samples[SamplesPerBlock][MicCount];
+
+  decimator.ProcessBlock(samples, &this->pdm_block[FIRST_MIC * WordsPerMic]);
+
+  for(unsigned s = 0; s < SamplesPerBlock; s++)
+    for(unsigned mic = 0; mic < MicCount; mic++)
+      this->sample_out[s * MIC_COUNT + FIRST_MIC + mic] = samples[s][mic];
+}
+
+
+template <unsigned MIC_COUNT, unsigned WORKERS,
+          template <unsigned> class TDecimator, unsigned STACK_WORDS,
+          unsigned LEAD_MICS>
+template <class... Args>
+void mic_array::ParallelDecimator<MIC_COUNT,WORKERS,TDecimator,STACK_WORDS,
+                                 LEAD_MICS>
+    ::Init(Args... args)
+{
+  this->partitions.Init(args...);
+}
+
+
+template <unsigned MIC_COUNT, unsigned WORKERS,
+          template <unsigned> class TDecimator, unsigned STACK_WORDS,
+          unsigned LEAD_MICS>
+template <class... Args>
+constexpr unsigned mic_array::ParallelDecimator<MIC_COUNT,WORKERS,TDecimator,
+                                                STACK_WORDS,LEAD_MICS>
+    ::Latency(Args... args)
+{
+  return TDecimator<1>::Latency(args...);
+}
+
+
+template <unsigned MIC_COUNT, unsigned WORKERS,
+          template <unsigned> class TDecimator, unsigned STACK_WORDS,
+          unsigned LEAD_MICS>
+void mic_array::ParallelDecimator<MIC_COUNT,WORKERS,TDecimator,STACK_WORDS,
+                                 LEAD_MICS>
+    ::StartWorkers()
+{
+  if(WORKERS == 1 || this->running)
+    return;
+
+  this->workers = thread_group_alloc();
+  assert(this->workers);
+
+  this->partitions.Rest.Start(this->workers, &this->stacks[0][0], STACK_WORDS);
+  thread_group_start(this->workers);
+  this->running = true;
+}
+
+
+template <unsigned MIC_COUNT, unsigned WORKERS,
+          template <unsigned> class TDecimator, unsigned STACK_WORDS,
+          unsigned LEAD_MICS>
+void mic_array::ParallelDecimator<MIC_COUNT,WORKERS,TDecimator,STACK_WORDS,
+                                 LEAD_MICS>
+    ::StopWorkers()
+{
+  if(!this->running)
+    return;
+
+  this->partitions.Rest.Signal(0);
+  thread_group_wait_and_free(this->workers);
+  this->partitions.Rest.Free();
+  this->running = false;
+}
+
+
+template <unsigned MIC_COUNT, unsigned WORKERS,
+          template <unsigned> class TDecimator, unsigned STACK_WORDS,
+          unsigned LEAD_MICS>
+void mic_array::ParallelDecimator<MIC_COUNT,WORKERS,TDecimator,STACK_WORDS,
+                                 LEAD_MICS>
+    ::ProcessBlock(
+        int32_t sample_out[MIC_COUNT],
+        uint32_t pdm_block[BLOCK_SIZE])
+{
+  this->Run(sample_out, pdm_block);
+}
+
+
+template <unsigned MIC_COUNT, unsigned WORKERS,
+          template <unsigned> class TDecimator, unsigned STACK_WORDS,
+          unsigned LEAD_MICS>
+void mic_array::ParallelDecimator<MIC_COUNT,WORKERS,TDecimator,STACK_WORDS,
+                                 LEAD_MICS>
+    ::ProcessBlock(
+        int32_t sample_out[][MIC_COUNT],
+        uint32_t pdm_block[BLOCK_SIZE])
+{
+  this->Run(&sample_out[0][0], pdm_block);
+}
+
+
+template <unsigned MIC_COUNT, unsigned WORKERS,
+          template <unsigned> class TDecimator, unsigned STACK_WORDS,
+          unsigned LEAD_MICS>
+void mic_array::ParallelDecimator<MIC_COUNT,WORKERS,TDecimator,STACK_WORDS,
+                                 LEAD_MICS>
+    ::Run(
+        int32_t* sample_out,
+        uint32_t* pdm_block)
+{
+  this->partitions.SetBlock(sample_out, pdm_block);
+
+  if(WORKERS == 1){
+    this->partitions.Process();
+    return;
+  }
+
+  this->StartWorkers();
+
+  this->partitions.Rest.Signal(1);
+  this->partitions.Process();
+  this->partitions.Rest.Wait();
+}
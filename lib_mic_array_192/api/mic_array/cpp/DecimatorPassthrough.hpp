@@ -0,0 +1,153 @@
+// Copyright 2022-2024 XMOS LIMITED.
+// This Software is subject to the terms of the XMOS Public Licence: Version 1.
+
+#pragma once
+
+#include <cstdint>
+
+// This has caused problems previously, so just catch the problems here.
+#if defined(MIC_COUNT) || defined(SUBBLOCKS)
+# error Application must not define the following as precompiler macros: MIC_COUNT, SUBBLOCKS.
+#endif
+
+
+namespace  mic_array {
+
+/**
+ * @brief Stand-in decimator which passes raw PDM data through.
+ *
+ * `PdmPassthroughDecimator` takes the place of a decimator in a
+ * @ref MicArray whose purpose is to capture the raw PDM bitstreams of its
+ * microphones, e.g. for bulk recording or for analysis off the device. No
+ * filtering is done at all: each "sample" it outputs is one PDM word of a
+ * mic, 32 PDM samples with the oldest in the least significant bit, and a
+ * set bit meaning `-1`. The words only change order, from the
+ * `[MIC_COUNT][SUBBLOCKS]` layout of a PDM block to the
+ * `[SUBBLOCKS][MIC_COUNT]` of the mic array's samples, so the rest of the
+ * mic array (e.g. @ref FrameOutputHandler) moves them on unchanged.
+ *
+ * The output "sample rate" is the PDM clock divided by 32 (e.g. 96 kHz for
+ * a 3.072 MHz PDM clock), with `SUBBLOCKS` words per mic per block. The
+ * mic array's sample filter must not alter the words, so must be a
+ * @ref NopSampleFilter. @ref MicArray::SettlingSamples still applies, and
+ * counts words.
+ *
+ * See @ref prefab::PdmCaptureMicArray for a complete mic array built on
+ * this class, and @ref PdmTap for recording raw PDM alongside a decimating
+ * mic array instead.
+ *
+ * @tparam MIC_COUNT  Number of microphone channels.
+ * @tparam SUBBLOCKS  Number of PDM words per mic in each block.
+ */
+template <unsigned MIC_COUNT, unsigned SUBBLOCKS = 1>
+class PdmPassthroughDecimator
+{
+  static_assert(SUBBLOCKS >= 1, "SUBBLOCKS must be at least 1.");
+
+  public:
+
+    /**
+     * Size of a block of PDM data in words.
+     */
+    static constexpr unsigned BLOCK_SIZE = MIC_COUNT * SUBBLOCKS;
+
+    /**
+     * Number of microphone channels.
+     */
+    static constexpr unsigned MicCount = MIC_COUNT;
+
+    /**
+     * Number of output samples (PDM words per mic) produced by each call to
+     * `ProcessBlock()`.
+     */
+    static constexpr unsigned SamplesPerBlock = SUBBLOCKS;
+
+    /**
+     * Number of PDM clock periods per output sample.
+     */
+    static constexpr unsigned SamplePeriod = 32;
+
+    /**
+     * @brief Latency, in PDM clock periods.
+     *
+     * There is no filter, so this is only the spread of the block's words:
+     * the oldest is handed over `32*(SUBBLOCKS-1)` PDM clock periods after
+     * its last sample was captured.
+     */
+    static constexpr unsigned Latency();
+
+    constexpr PdmPassthroughDecimator() noexcept {}
+
+    /**
+     * @brief Initialize the decimator.
+     *
+     * There is nothing to initialize; this is provided for symmetry with the
+     * other decimators.
+     */
+    void Init();
+
+    /**
+     * @brief Process one block of PDM data.
+     *
+     * Copies the `SUBBLOCKS` words of each mic of `pdm_block`, in the
+     * `[MIC_COUNT][SUBBLOCKS]` layout, to `sample_out[][]`, oldest first.
+     *
+     * @param sample_out  Output PDM words.
+     * @param pdm_block   PDM data to be passed through.
+     */
+    void ProcessBlock(
+        int32_t sample_out[SUBBLOCKS][MIC_COUNT],
+        uint32_t pdm_block[BLOCK_SIZE]);
+
+    /**
+     * @brief Process one block of PDM data, when `SUBBLOCKS` is `1`.
+     *
+     * @param sample_out  Output PDM words, one per mic.
+     * @param pdm_block   PDM data to be passed through.
+     */
+    void ProcessBlock(
+        int32_t sample_out[MIC_COUNT],
+        uint32_t pdm_block[BLOCK_SIZE]);
+};
+
+}
+
+//////////////////////////////////////////////
+// Template function implementations below. //
+//////////////////////////////////////////////
+
+
+template <unsigned MIC_COUNT, unsigned SUBBLOCKS>
+constexpr unsigned mic_array::PdmPassthroughDecimator<MIC_COUNT, SUBBLOCKS>
+    ::Latency()
+{
+  return 32 * (SUBBLOCKS - 1);
+}
+
+
+template <unsigned MIC_COUNT, unsigned SUBBLOCKS>
+void mic_array::PdmPassthroughDecimator<MIC_COUNT, SUBBLOCKS>::Init()
+{
+}
+
+
+template <unsigned MIC_COUNT, unsigned SUBBLOCKS>
+void mic_array::PdmPassthroughDecimator<MIC_COUNT, SUBBLOCKS>::ProcessBlock(
+    int32_t sample_out[SUBBLOCKS][MIC_COUNT],
+    uint32_t pdm_block[BLOCK_SIZE])
+{
+  for(unsigned mic = 0; mic < MIC_COUNT; mic++)
+    for(unsigned s = 0; s < SUBBLOCKS; s++)
+      sample_out[s][mic] = (int32_t) pdm_block[mic * SUBBLOCKS + s];
+}
+
+
+template <unsigned MIC_COUNT, unsigned SUBBLOCKS>
+void mic_array::PdmPassthroughDecimator<MIC_COUNT, SUBBLOCKS>::ProcessBlock(
+    int32_t sample_out[MIC_COUNT],
+    uint32_t pdm_block[BLOCK_SIZE])
+{
+  static_assert(SUBBLOCKS == 1, "Only for SUBBLOCKS == 1.");
+  this->ProcessBlock(reinterpret_cast<int32_t (*)[MIC_COUNT]>(sample_out),
+                     pdm_block);
+}
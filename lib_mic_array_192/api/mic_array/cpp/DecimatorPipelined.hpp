@@ -0,0 +1,413 @@
+// Copyright 2022-2024 XMOS LIMITED.
+// This Software is subject to the terms of the XMOS Public Licence: Version 1.
+
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include <cassert>
+
+#include <xcore/thread.h>
+#include <xcore/channel_streaming.h>
+
+#include "xmath/xmath.h"
+#include "mic_array/etc/fir_1x16_bit.h"
+#include "Decimator.hpp"
+#include "DecimatorParallel.hpp"
+#include "PdmHistory.hpp"
+#include "Stage2Filter.hpp"
+
+// This has caused problems previously, so just catch the problems here.
+#if defined(MIC_COUNT) || defined(S2_DEC_FACTOR) || defined(S2_TAP_COUNT) \
+    || defined(STACK_WORDS)
+# error Application must not define the following as precompiler macros: MIC_COUNT, S2_DEC_FACTOR, S2_TAP_COUNT, STACK_WORDS.
+#endif
+
+
+namespace  mic_array {
+
+/**
+ * @brief Two stage decimator with its stages pipelined across two threads.
+ *
+ * This decimator computes the same filters as @ref TwoStageDecimator, but
+ * splits the work by stage rather than by microphone (compare
+ * @ref ParallelDecimator). Stage 1, for all microphones, runs on a worker
+ * thread. Stage 2 runs on the thread calling @ref ProcessBlock(), which in a
+ * @ref MicArray is also the thread running the `SampleFilter` and
+ * `OutputHandler`. The load is split the same way whatever the microphone
+ * count.
+ *
+ * Each call to @ref ProcessBlock() hands the block's PDM data to the worker
+ * and, while the worker runs stage 1 on it, runs stage 2 on the stage 1
+ * output of the previous block. The worker's output is double-buffered, so
+ * it is only waited for at the start of the next call, and its stage 1 work
+ * also overlaps the caller's sample filter, output handler and wait for the
+ * next PDM block. The PDM block is copied before it is handed over, so it
+ * need not remain valid after @ref ProcessBlock() returns.
+ *
+ * This adds one block of latency: the sample output by @ref ProcessBlock()
+ * is the one @ref TwoStageDecimator would have output for the previous
+ * block, and the first call outputs the stage 2 filter's response to
+ * silence (zeros).
+ *
+ * The worker thread is started by the first call to @ref ProcessBlock() (or
+ * by @ref StartWorker()), on the calling thread's tile, and holds one
+ * hardware thread and one streaming channel until @ref StopWorker() is
+ * called.
+ *
+ * Concrete implementations of this class template are meant to be used as
+ * the `TDecimator` template parameter in the @ref MicArray class template.
+ *
+ * @tparam MIC_COUNT      Number of microphone channels.
+ * @tparam S2_DEC_FACTOR  Stage 2 decimation factor.
+ * @tparam S2_TAP_COUNT   Stage 2 tap count.
+ * @tparam STACK_WORDS    Stack size, in words, of the stage 1 thread.
+ */
+template <unsigned MIC_COUNT, unsigned S2_DEC_FACTOR, unsigned S2_TAP_COUNT,
+          unsigned STACK_WORDS = MIC_ARRAY_PARALLEL_WORKER_STACK_WORDS>
+class PipelinedTwoStageDecimator
+{
+
+  public:
+    /**
+     * Size of a block of PDM data in words.
+     */
+    static constexpr unsigned BLOCK_SIZE = MIC_COUNT * S2_DEC_FACTOR;
+
+    /**
+     * Number of microphone channels.
+     */
+    static constexpr unsigned MicCount = MIC_COUNT;
+
+    /**
+     * Output sample period, in PDM clock periods.
+     */
+    static constexpr unsigned SamplePeriod = STAGE1_DEC_FACTOR * S2_DEC_FACTOR;
+
+    /**
+     * Output for a full scale PDM signal, with the default filters and no
+     * output shift. See @ref DecimatorFullScale.
+     */
+    static constexpr int32_t FullScale = STAGE2_FULL_SCALE;
+
+    /**
+     * @brief Latency of the decimator, in PDM clock periods.
+     * 
+     * As @ref TwoStageDecimator::Latency(), plus the block (`SamplePeriod`)
+     * by which stage 2 lags stage 1.
+     * 
+     * @param s1_group_delay  Stage 1 filter group delay, in PDM clock periods.
+     * @param s2_group_delay  Stage 2 filter group delay, in PDM clock periods.
+     */
+    static constexpr unsigned Latency(
+        const unsigned s1_group_delay = MIC_ARRAY_CONFIG_MIN_PHASE_FILTERS?
+                            STAGE1_GROUP_DELAY_MIN_PHASE : STAGE1_GROUP_DELAY,
+        const unsigned s2_group_delay = MIC_ARRAY_CONFIG_MIN_PHASE_FILTERS?
+                            STAGE2_GROUP_DELAY_MIN_PHASE : STAGE2_GROUP_DELAY);
+
+  private:
+
+    /**
+     * Stage 1 decimator configuration and state. Only used by the worker
+     * thread.
+     */
+    struct {
+      /**
+       * Pointer to filter coefficients for Stage 1
+       */
+      const uint32_t* filter_coef;
+      /**
+       * Filter state (PDM history) for stage 1 filters.
+       */
+      PdmHistory<MIC_COUNT, S2_DEC_FACTOR> pdm_history;
+    } stage1;
+
+    /**
+     * Stage 2 decimation configuration and state. Only used by the thread
+     * calling @ref ProcessBlock().
+     */
+    struct {
+      /**
+       * Stage 2 FIR filter and history for all mics.
+       */
+      Stage2Filter<MIC_COUNT, S2_TAP_COUNT, S2_DEC_FACTOR> filter;
+    } stage2;
+
+    /**
+     * Copy of the PDM block being processed by stage 1.
+     */
+    uint32_t WORD_ALIGNED pdm_block[MIC_COUNT][S2_DEC_FACTOR] = {{0}};
+
+    /**
+     * Stage 1 output, double-buffered. Stage 1 writes one buffer while
+     * stage 2 reads the other.
+     */
+    int32_t stage1_out[2][MIC_COUNT][S2_DEC_FACTOR] = {{{0}}};
+
+    /**
+     * Index of the `stage1_out` buffer stage 1 writes next.
+     */
+    unsigned current = 0;
+
+    /**
+     * Whether stage 1 is processing a block which has not yet been waited
+     * for.
+     */
+    bool pending = false;
+
+    /**
+     * Whether the worker thread is running.
+     */
+    bool running = false;
+
+    /**
+     * Thread group of the worker thread, while it is running.
+     */
+    threadgroup_t worker = 0;
+
+    /**
+     * Streaming channel on which the worker is woken for each block, and on
+     * which it reports that the block is done.
+     */
+    streaming_channel_t c_worker = {0, 0};
+
+    /**
+     * Stack of the worker thread.
+     */
+    uint32_t __attribute__((aligned(8))) stack[STACK_WORDS] = {0};
+
+  public:
+
+    constexpr PipelinedTwoStageDecimator() noexcept { }
+
+    /**
+     * @brief Initialize the decimator.
+     *
+     * Takes the same arguments as @ref TwoStageDecimator::Init(). The
+     * decimator must be initialized before any calls to `ProcessBlock()`.
+     *
+     * @param s1_filter_coef  Stage 1 filter coefficients.
+     * @param s2_filter_coef  Stage 2 filter coefficients.
+     * @param s2_filter_shr   Stage 2 filter right-shift.
+     */
+    void Init(
+        const uint32_t* s1_filter_coef,
+        const int32_t* s2_filter_coef,
+        const right_shift_t s2_filter_shr);
+
+    /**
+     * @brief Start the stage 1 worker thread.
+     *
+     * This is done by the first call to @ref ProcessBlock() if it has not
+     * been done already. It must be called on the same tile as
+     * @ref ProcessBlock(). Does nothing if the worker is already running.
+     */
+    void StartWorker();
+
+    /**
+     * @brief Stop the stage 1 worker thread.
+     *
+     * Waits for the worker to finish any block it is processing, then for it
+     * to return, and frees its thread and channel. No decimator state is
+     * lost; the worker is started again by the next call to
+     * @ref ProcessBlock(). Must not be called concurrently with
+     * @ref ProcessBlock(). Does nothing if the worker is not running.
+     */
+    void StopWorker();
+
+    /**
+     * @brief Process one block of PDM data.
+     *
+     * The layout of `pdm_block` is that of
+     * @ref TwoStageDecimator::ProcessBlock(). Stage 1 processing of this
+     * block is started, and the output sample for the previous block is
+     * written to `sample_out[]`.
+     *
+     * @param sample_out  Output sample vector.
+     * @param pdm_block   PDM data to be processed.
+     */
+    void ProcessBlock(
+        int32_t sample_out[MIC_COUNT],
+        uint32_t pdm_block[BLOCK_SIZE]);
+
+  private:
+
+    /**
+     * @brief Run stage 1 on the copied PDM block.
+     */
+    void Stage1(
+        int32_t out[MIC_COUNT][S2_DEC_FACTOR]);
+
+    /**
+     * @brief Wait for stage 1 to finish its current block, if any.
+     */
+    void WaitStage1();
+
+    /**
+     * @brief Worker thread entry point. Runs stage 1 for each block until
+     *        told to stop.
+     */
+    static void Entry(void* decimator);
+};
+
+}
+
+//////////////////////////////////////////////
+// Template function implementations below. //
+//////////////////////////////////////////////
+
+
+template <unsigned MIC_COUNT, unsigned S2_DEC_FACTOR, unsigned S2_TAP_COUNT,
+          unsigned STACK_WORDS>
+constexpr unsigned mic_array::PipelinedTwoStageDecimator<MIC_COUNT,
+                                                         S2_DEC_FACTOR,
+                                                         S2_TAP_COUNT,
+                                                         STACK_WORDS>::Latency(
+    const unsigned s1_group_delay,
+    const unsigned s2_group_delay)
+{
+  return s1_group_delay + s2_group_delay + SamplePeriod;
+}
+
+
+template <unsigned MIC_COUNT, unsigned S2_DEC_FACTOR, unsigned S2_TAP_COUNT,
+          unsigned STACK_WORDS>
+void mic_array::PipelinedTwoStageDecimator<MIC_COUNT,S2_DEC_FACTOR,
+                                           S2_TAP_COUNT,STACK_WORDS>::Init(
+    const uint32_t* s1_filter_coef,
+    const int32_t* s2_filter_coef,
+    const right_shift_t s2_shr)
+{
+  this->stage1.filter_coef = s1_filter_coef;
+
+  this->stage2.filter.Init(s2_filter_coef, s2_shr);
+}
+
+
+template <unsigned MIC_COUNT, unsigned S2_DEC_FACTOR, unsigned S2_TAP_COUNT,
+          unsigned STACK_WORDS>
+void mic_array::PipelinedTwoStageDecimator<MIC_COUNT,S2_DEC_FACTOR,
+                                           S2_TAP_COUNT,STACK_WORDS>
+    ::StartWorker()
+{
+  if(this->running)
+    return;
+
+  this->c_worker = s_chan_alloc();
+
+  this->worker = thread_group_alloc();
+  assert(this->worker);
+
+  thread_group_add(this->worker, Entry, this,
+                   stack_base(this->stack, STACK_WORDS));
+  thread_group_start(this->worker);
+  this->running = true;
+}
+
+
+template <unsigned MIC_COUNT, unsigned S2_DEC_FACTOR, unsigned S2_TAP_COUNT,
+          unsigned STACK_WORDS>
+void mic_array::PipelinedTwoStageDecimator<MIC_COUNT,S2_DEC_FACTOR,
+                                           S2_TAP_COUNT,STACK_WORDS>
+    ::StopWorker()
+{
+  if(!this->running)
+    return;
+
+  this->WaitStage1();
+
+  s_chan_out_word(this->c_worker.end_a, 0);
+  thread_group_wait_and_free(this->worker);
+  s_chan_free(this->c_worker);
+  this->running = false;
+}
+
+
+template <unsigned MIC_COUNT, unsigned S2_DEC_FACTOR, unsigned S2_TAP_COUNT,
+          unsigned STACK_WORDS>
+void mic_array::PipelinedTwoStageDecimator<MIC_COUNT,S2_DEC_FACTOR,
+                                           S2_TAP_COUNT,STACK_WORDS>
+    ::ProcessBlock(
+        int32_t sample_out[MIC_COUNT],
+        uint32_t pdm_block[BLOCK_SIZE])
+{
+  this->StartWorker();
+
+  // Stage 1 must have finished the previous block before its PDM copy and
+  // output buffer are reused.
+  this->WaitStage1();
+
+  memcpy(this->pdm_block, pdm_block, sizeof(this->pdm_block));
+
+  // The word sent tells the worker which buffer to write.
+  s_chan_out_word(this->c_worker.end_a, this->current + 1);
+  this->pending = true;
+
+  int32_t (*prev)[S2_DEC_FACTOR] = this->stage1_out[this->current ^ 1];
+
+  for(unsigned k = 0; k < S2_DEC_FACTOR; k++){
+    this->stage2.filter.Advance();
+    for(unsigned mic = 0; mic < MIC_COUNT; mic++)
+      this->stage2.filter.Set(mic, prev[mic][k]);
+  }
+
+  this->stage2.filter.Filter(sample_out);
+
+  this->current ^= 1;
+}
+
+
+template <unsigned MIC_COUNT, unsigned S2_DEC_FACTOR, unsigned S2_TAP_COUNT,
+          unsigned STACK_WORDS>
+void mic_array::PipelinedTwoStageDecimator<MIC_COUNT,S2_DEC_FACTOR,
+                                           S2_TAP_COUNT,STACK_WORDS>
+    ::Stage1(
+        int32_t out[MIC_COUNT][S2_DEC_FACTOR])
+{
+  for(unsigned k = 0; k < S2_DEC_FACTOR; k++){
+    int32_t streamA_sample[MIC_COUNT];
+
+    this->stage1.pdm_history.Advance();
+    for(unsigned mic = 0; mic < MIC_COUNT; mic++)
+      this->stage1.pdm_history.Set(mic, this->pdm_block[mic][k]);
+
+    fir_1x16_bit_channels<MIC_COUNT>(streamA_sample,
+                                     this->stage1.pdm_history.Window(0),
+                                     this->stage1.pdm_history.Stride,
+                                     this->stage1.filter_coef);
+
+    for(unsigned mic = 0; mic < MIC_COUNT; mic++)
+      out[mic][k] = streamA_sample[mic];
+  }
+}
+
+
+template <unsigned MIC_COUNT, unsigned S2_DEC_FACTOR, unsigned S2_TAP_COUNT,
+          unsigned STACK_WORDS>
+void mic_array::PipelinedTwoStageDecimator<MIC_COUNT,S2_DEC_FACTOR,
+                                           S2_TAP_COUNT,STACK_WORDS>
+    ::WaitStage1()
+{
+  if(!this->pending)
+    return;
+
+  s_chan_in_word(this->c_worker.end_a);
+  this->pending = false;
+}
+
+
+template <unsigned MIC_COUNT, unsigned S2_DEC_FACTOR, unsigned S2_TAP_COUNT,
+          unsigned STACK_WORDS>
+void mic_array::PipelinedTwoStageDecimator<MIC_COUNT,S2_DEC_FACTOR,
+                                           S2_TAP_COUNT,STACK_WORDS>
+    ::Entry(void* decimator)
+{
+  auto* self = reinterpret_cast<PipelinedTwoStageDecimator*>(decimator);
+
+  // A non-zero word is the index (plus one) of the buffer to write; zero
+  // means stop.
+  while(unsigned buffer = s_chan_in_word(self->c_worker.end_b)){
+    self->Stage1(self->stage1_out[buffer - 1]);
+    s_chan_out_word(self->c_worker.end_b, 1);
+  }
+}
@@ -0,0 +1,160 @@
+// Copyright 2022-2024 XMOS LIMITED.
+// This Software is subject to the terms of the XMOS Public Licence: Version 1.
+
+#pragma once
+
+#include "mic_array/instance.h"
+#include "mic_array/setup.h"
+
+/**
+ * @brief Define a mic array instance for the handle-based C API.
+ *
+ * Allocates a mic array object of type `...` (e.g.
+ * `mic_array::prefab::BasicMicArray<8, 16, true>`) and defines `NAME`, a
+ * `ma_instance_t` with C linkage, through which `ma_init()`, `ma_task()` and
+ * `ma_pdm_rx_task()` operate on it. Must be used at file scope in a C++ file.
+ *
+ * The type must provide `Init()`, `SetPort()`, `SetOutputChannel()`,
+ * `InstallPdmRxISR()`, `UnmaskPdmRxISR()`, `PdmRxThreadEntry()` and
+ * `ThreadEntry()`, as the prefab classes do, and its `PdmRx` must be a
+ * @ref mic_array::StandardPdmRxService.
+ *
+ * @param NAME  Name of the instance.
+ * @param ...   Mic array type.
+ */
+#define MA_INSTANCE_DEFINE(NAME, ...)                                         \
+  static __VA_ARGS__ NAME##_mics;                                             \
+  extern "C" ma_instance_t NAME;                                              \
+  ma_instance_t NAME = mic_array::Instance<__VA_ARGS__>(&NAME##_mics)
+
+
+/**
+ * @brief Mic array instance behind a `ma_instance_t` handle.
+ *
+ * Holds a pointer to the mic array object and type-erased entry points for
+ * its type. Defined with `MA_INSTANCE_DEFINE()`; applications should not need
+ * to use it directly.
+ */
+struct ma_instance {
+  /**
+   * @brief The mic array object.
+   */
+  void* mics;
+
+  /**
+   * @brief Initializes `mics`. See `ma_init()`.
+   */
+  void (*init)(void* mics, const ma_config_t* cfg);
+
+  /**
+   * @brief Runs the decimation thread of `mics`. See `ma_task()`.
+   */
+  void (*task)(void* mics, chanend_t c_frames_out, unsigned use_pdm_thread);
+
+  /**
+   * @brief Runs the PDM rx thread of `mics`. See `ma_pdm_rx_task()`.
+   */
+  void (*pdm_rx_task)(void* mics);
+
+  /**
+   * @brief `ma_config_t::use_pdm_thread`, as passed to `ma_init()`.
+   */
+  unsigned use_pdm_thread;
+};
+
+
+namespace mic_array {
+
+  /**
+   * @brief Type-erased entry points of the C instance API for a mic array
+   *        type.
+   *
+   * @tparam TMicArray  Mic array type. See `MA_INSTANCE_DEFINE()`.
+   */
+  template <class TMicArray>
+  struct InstanceOps
+  {
+    /**
+     * @brief Initialize `*mics` and start its PDM clock.
+     */
+    static void Init(void* mics, const ma_config_t* cfg);
+
+    /**
+     * @brief Run the decimation thread of `*mics`.
+     */
+    static void Task(void* mics, chanend_t c_frames_out,
+                     unsigned use_pdm_thread);
+
+    /**
+     * @brief Run the PDM rx thread of `*mics`.
+     */
+    static void PdmRxTask(void* mics);
+  };
+
+  /**
+   * @brief Make the `ma_instance_t` of mic array object `mics`.
+   *
+   * Used by `MA_INSTANCE_DEFINE()`.
+   */
+  template <class TMicArray>
+  constexpr ma_instance_t Instance(TMicArray* mics);
+
+}
+
+//////////////////////////////////////////////
+// Template function implementations below. //
+//////////////////////////////////////////////
+
+
+template <class TMicArray>
+void mic_array::InstanceOps<TMicArray>::Init(
+    void* mics,
+    const ma_config_t* cfg)
+{
+  TMicArray& m = *static_cast<TMicArray*>(mics);
+
+  m.Init();
+  m.SetPort(cfg->pdm_res->p_pdm_mics);
+  m.PdmRx.DeinterleaveInThread(cfg->use_pdm_thread != 0);
+  mic_array_resources_configure(cfg->pdm_res, cfg->mclk_divider);
+  mic_array_pdm_clock_start(cfg->pdm_res, cfg->mclk_divider);
+}
+
+
+template <class TMicArray>
+void mic_array::InstanceOps<TMicArray>::Task(
+    void* mics,
+    chanend_t c_frames_out,
+    unsigned use_pdm_thread)
+{
+  TMicArray& m = *static_cast<TMicArray*>(mics);
+
+  m.SetOutputChannel(c_frames_out);
+
+  if(!use_pdm_thread){
+    m.InstallPdmRxISR();
+    m.UnmaskPdmRxISR();
+  }
+
+  m.ThreadEntry();
+}
+
+
+template <class TMicArray>
+void mic_array::InstanceOps<TMicArray>::PdmRxTask(
+    void* mics)
+{
+  static_cast<TMicArray*>(mics)->PdmRxThreadEntry();
+}
+
+
+template <class TMicArray>
+constexpr ma_instance_t mic_array::Instance(
+    TMicArray* mics)
+{
+  return ma_instance_t{ mics,
+                        &InstanceOps<TMicArray>::Init,
+                        &InstanceOps<TMicArray>::Task,
+                        &InstanceOps<TMicArray>::PdmRxTask,
+                        0 };
+}
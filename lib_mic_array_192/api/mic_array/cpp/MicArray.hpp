@@ -12,12 +12,16 @@
 
 #include "PdmRx.hpp"
 #include "Decimator.hpp"
+#include "Decimator192.hpp"
 #include "SampleFilter.hpp"
 #include "OutputHandler.hpp"
+#include "Profiler.hpp"
+#include "Mips.hpp"
 
 #include "mic_array.h"
 
 #include <xcore/channel.h>
+#include <xcore/hwtimer.h>
 
 using namespace std;
 
@@ -26,6 +30,30 @@ using namespace std;
 # error Application must not define the following as precompiler macros: MIC_COUNT.
 #endif
 
+/**
+ * Default value of @ref mic_array::MicArray::SettlingSamples, the number of
+ * output samples discarded when the decimation thread starts.
+ */
+#ifndef MIC_ARRAY_CONFIG_SETTLING_SAMPLES
+# define MIC_ARRAY_CONFIG_SETTLING_SAMPLES    (0)
+#endif
+
+/**
+ * Default value of @ref mic_array::MicArray::PrimeDecimator. If non-zero, the
+ * decimator is primed from the first PDM block it processes.
+ */
+#ifndef MIC_ARRAY_CONFIG_PRIME_DECIMATOR
+# define MIC_ARRAY_CONFIG_PRIME_DECIMATOR     (0)
+#endif
+
+/**
+ * Default value of @ref mic_array::MicArray::ReleaseDelay, in reference timer
+ * ticks. If zero, output samples are released as soon as they are ready.
+ */
+#ifndef MIC_ARRAY_CONFIG_RELEASE_DELAY
+# define MIC_ARRAY_CONFIG_RELEASE_DELAY       (0)
+#endif
+
 
 namespace  mic_array {
 
@@ -65,6 +93,112 @@ namespace  mic_array {
        */
       static constexpr unsigned MicCount = MIC_COUNT;
 
+      /**
+       * @brief Whether `ThreadEntry()` decimates a whole frame per PDM block.
+       * 
+       * Set if each block from @ref PdmRx holds the PDM data of a whole
+       * frame of @ref OutputHandler (see @ref PdmRxSubBlocks and 
+       * @ref OutputHandlerFrameSize), where @ref Decimator would otherwise
+       * make one sample per block. E.g. a @ref StandardPdmRxService with
+       * `SUBBLOCKS` of `SAMPLE_COUNT * S2_DEC_FACTOR`, a 
+       * @ref TwoStageDecimator and a @ref FrameOutputHandler of 
+       * `SAMPLE_COUNT` samples.
+       * 
+       * Each block is then decimated by `TDecimator::ProcessFrame()` (see
+       * @ref TwoStageDecimator::ProcessFrame()) straight into a frame, which
+       * is handed to `TOutputHandler::OutputFrame()` (see 
+       * @ref FrameOutputHandler::OutputFrame()), saving the per-sample 
+       * hand-off. There is no per-sample @ref SampleFilter, so 
+       * `TSampleFilter` must be @ref NopSampleFilter; the decimator's own
+       * `TSampleFilter` still applies.
+       */
+      static constexpr bool FrameMode = 
+          OutputHandlerFrameSize<TOutputHandler>::value > 1
+          && DecimatorSamplesPerBlock<TDecimator>::value == 1
+          && PdmRxSubBlocks<TPdmRx>::value 
+              == OutputHandlerFrameSize<TOutputHandler>::value 
+                  * (TDecimator::BLOCK_SIZE / MIC_COUNT);
+
+      /**
+       * @brief Latency of the mic array, in PDM clock periods.
+       * 
+       * This is the time from the sound represented by the oldest sample of
+       * an output frame to that frame being handed to @ref OutputHandler's
+       * frame transmitter. It is the sum of
+       * 
+       * - `TDecimator::Latency(args...)`, the decimator's filter group delay
+       *   and any spread of its output samples within a PDM block, measured
+       *   to the capture of the block's last PDM sample. @ref PdmRx
+       *   delivers each block as soon as that sample is captured, so this
+       *   also covers the PDM block buffering.
+       * - The time the frame's oldest sample then waits for the PDM blocks
+       *   carrying the rest of the frame, if @ref OutputHandler gathers more
+       *   samples per frame (see @ref OutputHandlerFrameSize) than the
+       *   decimator produces per block.
+       * 
+       * The `n`th sample of a frame (counting from `0`, the oldest) has a
+       * latency `n * TDecimator::SamplePeriod` less. If the frame size is
+       * not a multiple of the decimator's @ref DecimatorSamplesPerBlock, the
+       * value is for frames which start at the beginning of a block, which
+       * is the worst case.
+       * 
+       * Not included are the decimation thread's processing time (up to one
+       * PDM block), the transfer of the frame to its receiver, and any delay
+       * added by @ref SampleFilter (e.g. @ref DelaySampleFilter).
+       * 
+       * `TDecimator` must provide `SamplePeriod` and a `constexpr`
+       * `Latency()`, as @ref TwoStageDecimator::Latency() and
+       * @ref OneStageDecimator192::Latency() do.
+       * 
+       * @param args  Arguments for `TDecimator::Latency()`, e.g. the group 
+       *              delays of custom filters. By default, those of the
+       *              default filters are used.
+       */
+      template <class... Args>
+      static constexpr unsigned Latency(Args... args);
+
+      /**
+       * @brief Memory used by an instance of this configuration, in bytes.
+       * 
+       * This is `sizeof` the mic array object, i.e. the buffers and state of
+       * @ref PdmRx, @ref Decimator, @ref SampleFilter and 
+       * @ref OutputHandler together. It can be checked against a memory 
+       * budget at compile time:
+       * 
+       * @code{.cpp}
+       *  static_assert(TMicArray::MemoryFootprint() <= 8192, "Too big");
+       * @endcode
+       * 
+       * Not included are the filter coefficient tables (which are shared
+       * by all instances), the stacks of the mic array's threads, and any
+       * buffers outside the object, such as frames held by the receiver of
+       * @ref OutputHandler's output.
+       */
+      static constexpr unsigned MemoryFootprint();
+
+      /**
+       * @brief Estimated MIPS of the decimation thread.
+       * 
+       * The sum of the `RequiredMips()` of @ref Decimator, @ref PdmRx and
+       * @ref OutputHandler, as of @ref TwoStageDecimator::RequiredMips(),
+       * @ref StandardPdmRxService::RequiredMips() and 
+       * @ref FrameOutputHandler::RequiredMips(). It can be checked against
+       * a thread's budget at compile time:
+       * 
+       * @code{.cpp}
+       *  static_assert(mic_array::FitsThreadMips(TMicArray::RequiredMips()),
+       *                "The decimation thread cannot keep up.");
+       * @endcode
+       * 
+       * @ref SampleFilter is not included.
+       * 
+       * @param pdm_freq  PDM clock frequency, in Hz.
+       * @param isr       Whether the PDM rx ISR runs on the decimation thread.
+       */
+      static constexpr float RequiredMips(
+          const unsigned pdm_freq = 3072000,
+          const bool isr = true);
+
 
       /**
        * @brief The PDM rx service.
@@ -87,6 +221,12 @@ namespace  mic_array {
        * a pointer to a block of PDM data from a streaming channel. The pointer
        * is sent from the PdmRx interrupt (or thread) when the block has been
        * completed. This is used for capturing PDM data from a port.
+       *
+       * If `TPdmRx` also implements `PdmBlockStamp GetBlockStamp()` and
+       * `TOutputHandler` implements
+       * `void SetBlockStamp(uint32_t sample_index, uint32_t timestamp)`, the
+       * stamp of each block is passed on to the output handler before the
+       * samples decimated from it. See @ref FrameOutputHandler::SetBlockStamp().
        */
       TPdmRx PdmRx;
 
@@ -108,8 +248,32 @@ namespace  mic_array {
        * The size and formatting of the PDM block expected by the decimator
        * depends on its particular implementation.
        * 
+       * A decimator may instead produce several output samples from each
+       * block of PDM data. Such a decimator declares how many with a
+       * `static constexpr unsigned SamplesPerBlock` member, and its
+       * `ProcessBlock()` takes a 2D output array:
+       * @code{.cpp}
+       * void ProcessBlock(
+       *     int32_t sample_out[SamplesPerBlock][MIC_COUNT],
+       *     uint32_t pdm_block[BLOCK_SIZE]);
+       * @endcode
+       * 
+       * `sample_out[0]` is the oldest of the output samples. Each of them is
+       * passed through @ref SampleFilter and @ref OutputHandler in order.
+       * 
+       * If the number of output samples can vary from block to block (e.g.
+       * @ref MultiRateDecimator), `SamplesPerBlock` is the maximum and
+       * `ProcessBlock()` returns the number of samples it actually wrote:
+       * @code{.cpp}
+       * unsigned ProcessBlock(
+       *     int32_t sample_out[SamplesPerBlock][MIC_COUNT],
+       *     uint32_t pdm_block[BLOCK_SIZE]);
+       * @endcode
+       * 
        * A concrete class based on the @ref mic_array::TwoStageDecimator class
-       * template is used in the @ref prefab::BasicMicArray prefab.
+       * template is used in the @ref prefab::BasicMicArray prefab, and
+       * @ref mic_array::OneStageDecimator192 (with `SamplesPerBlock = 2`) is
+       * used in the @ref prefab::Basic192MicArray prefab.
        */
       TDecimator Decimator;
 
@@ -128,6 +292,16 @@ namespace  mic_array {
        * `Filter()` takes a single (multi-channel) sample from the decimator
        * component's output and may update the sample in-place.
        * 
+       * A sample filter may optionally also implement `FilterSamples()`,
+       * which filters all of the samples produced from one PDM block in a
+       * single call:
+       * @code{.cpp}
+       * template <unsigned SAMPLES>
+       * void FilterSamples(int32_t (&samples)[SAMPLES][MIC_COUNT]);
+       * @endcode
+       * 
+       * If present, `FilterSamples()` is used instead of `Filter()`.
+       * 
        * For example a sample filter based on the @ref DcoeSampleFilter class
        * template applies a simple first-order IIR filter to the output of the
        * decimator, in order to eliminate the DC component of the audio signals.
@@ -143,6 +317,12 @@ namespace  mic_array {
        * filtering, they are separate components of the `MicArray` because they
        * are conceptually independent.
        * 
+       * Where the cost of a separate pass over each output sample matters (e.g.
+       * at 192 kHz), @ref TwoStageDecimator and @ref OneStageDecimator192 can
+       * instead apply a sample filter themselves, as each sample is produced,
+       * through its `TSampleFilter` template parameter. `TSampleFilter` of the
+       * `MicArray` is then @ref NopSampleFilter.
+       * 
        * A concrete class based on either the @ref DcoeSampleFilter class
        * template or the @ref NopSampleFilter class template is used in the 
        * @ref prefab::BasicMicArray prefab, depending on the
@@ -167,8 +347,17 @@ namespace  mic_array {
        * void OutputSample(int32_t sample[MIC_COUNT]);
        * @endcode
        * 
-       * `OutputSample()` is called exactly once for each mic array output
-       * sample. `OutputSample()` may block if necessary until the subsequent
+       * An output handler may optionally also implement `OutputSamples()`,
+       * which accepts all of the samples produced from one PDM block in a
+       * single call:
+       * @code{.cpp}
+       * template <unsigned SAMPLES>
+       * void OutputSamples(int32_t (&samples)[SAMPLES][MIC_COUNT]);
+       * @endcode
+       * 
+       * If present, `OutputSamples()` is used instead of `OutputSample()`.
+       * Otherwise `OutputSample()` is called exactly once for each mic array
+       * output sample. `OutputSample()` may block if necessary until the subsequent
        * processing stage ready to receive new data. However, the decimator
        * thread (in which `OutputSample()` is called) as a whole has a real-time
        * constraint - it must be ready to pull the next block of PDM data while
@@ -179,6 +368,96 @@ namespace  mic_array {
        */
       TOutputHandler OutputHandler;
 
+      /**
+       * @brief Number of samples discarded when `ThreadEntry()` starts.
+       * 
+       * The first `SettlingSamples` samples out of the decimator are dropped
+       * before reaching the @ref SampleFilter and @ref OutputHandler, so that
+       * whatever the decimator makes of the microphones settling, or of PDM
+       * data captured during a warm-up started by 
+       * `mic_array_pdm_clock_start_async()`, is never seen downstream. Whole
+       * PDM blocks are dropped, so this is rounded up to a multiple of the
+       * decimator's samples per block, or of the frame size in 
+       * @ref FrameMode. The sample index of each frame header
+       * (see @ref FrameOutputHandler::SetBlockStamp()) still counts the
+       * dropped samples.
+       * 
+       * Defaults to @ref MIC_ARRAY_CONFIG_SETTLING_SAMPLES. Must be set before
+       * `ThreadEntry()` is called.
+       */
+      unsigned SettlingSamples = MIC_ARRAY_CONFIG_SETTLING_SAMPLES;
+
+      /**
+       * @brief Whether to prime the decimator from the first PDM block.
+       * 
+       * If set, and @ref Decimator has a `Prime()` method (e.g.
+       * @ref TwoStageDecimator::Prime()), the decimator's filter state is 
+       * primed from the first PDM block which is not dropped under
+       * @ref SettlingSamples, just before that block is decimated. In
+       * @ref FrameMode, `PrimeFrame()` (see 
+       * @ref TwoStageDecimator::PrimeFrame()) is used instead. The
+       * decimator's start-up transient is skipped, so the first samples 
+       * output already track the signal.
+       * 
+       * Defaults to @ref MIC_ARRAY_CONFIG_PRIME_DECIMATOR. Must be set before
+       * `ThreadEntry()` is called.
+       */
+      bool PrimeDecimator = MIC_ARRAY_CONFIG_PRIME_DECIMATOR;
+
+      /**
+       * @brief Fixed delay from the first PDM word of a block to the release
+       *        of the samples decimated from it, in reference timer ticks.
+       * 
+       * If non-zero, and `TPdmRx` has a `GetBlockStamp()` method (e.g.
+       * @ref StandardPdmRxService), the samples decimated from each PDM block
+       * are held back after filtering until `ReleaseDelay` ticks after the 
+       * block's timestamp, and only then handed to @ref OutputHandler. A
+       * frame is sent from the block which completes it, so each frame then
+       * leaves the decimation thread at a fixed offset from its first PDM
+       * word, whatever the jitter in delivering blocks to and decimating them
+       * in this thread. Boards whose PDM clocks share a word clock thus
+       * release their frames with bounded jitter relative to one another.
+       * 
+       * The delay must cover the worst case time to get, decimate and filter
+       * a block, and leave time to output the samples before the next block
+       * is due. A block whose release time has already passed when its
+       * samples are ready is released at once and counted in
+       * @ref LateReleases.
+       * 
+       * A hardware timer is allocated for the wait when `ThreadEntry()` 
+       * starts. Defaults to @ref MIC_ARRAY_CONFIG_RELEASE_DELAY. Must be set
+       * before `ThreadEntry()` is called.
+       */
+      uint32_t ReleaseDelay = MIC_ARRAY_CONFIG_RELEASE_DELAY;
+
+      /**
+       * @brief Number of PDM blocks whose samples were ready only after
+       *        their release time.
+       * 
+       * Only counted when @ref ReleaseDelay is in use. Any non-zero count
+       * means @ref ReleaseDelay is too short to bound the output jitter. May
+       * be read from any thread on the same tile.
+       */
+      volatile unsigned LateReleases = 0;
+
+#if MIC_ARRAY_CONFIG_PROFILE
+      /**
+       * @brief Per-phase timing of the decimation thread.
+       * 
+       * Only present when @ref MIC_ARRAY_CONFIG_PROFILE is enabled. Each pass
+       * of `ThreadEntry()`'s loop charges the time spent getting the PDM
+       * block, decimating it, filtering the samples and outputting them to
+       * the corresponding @ref ProfileStage. If @ref Decimator has a
+       * `StageProfiler* Profiler` member (as @ref TwoStageDecimator does), it
+       * is pointed at this object so that the decimator's own stages are
+       * recorded too.
+       * 
+       * The time charged to `PROFILE_PDM_RX` includes waiting for the block,
+       * so it is also a measure of the thread's headroom.
+       */
+      StageProfiler Profiler;
+#endif
+
     public:
 
       /**
@@ -233,8 +512,355 @@ namespace  mic_array {
        * output sample rate, applies any post-processing with @ref SampleFilter,
        * and then delivers the stream of output samples through @ref
        * OutputHandler.
+       * 
+       * If @ref Decimator produces more than one output sample per PDM block
+       * (see @ref DecimatorSamplesPerBlock), all of those samples are
+       * filtered and output before the next PDM block is requested. Where
+       * @ref SampleFilter or @ref OutputHandler provide the batched
+       * `FilterSamples()` or `OutputSamples()` methods, the whole block of
+       * samples is handed over in a single call. If @ref Decimator reports
+       * fewer samples than `SamplesPerBlock` for a block, those samples are
+       * handed over one at a time.
+       * 
+       * If @ref ReleaseDelay is set, the samples decimated from each block
+       * are held back until their release time before being output.
+       * 
+       * In @ref FrameMode, each PDM block is instead decimated into a whole
+       * frame, which is output in a single call.
        */
       void ThreadEntry();
+
+      /**
+       * @brief Choose the microphones which are decimated.
+       * 
+       * Bit `k` of `mask` is set for microphone `k` to be decimated. The
+       * mask is passed to @ref Decimator if it has a `SetActiveChannels()`
+       * method (e.g. @ref TwoStageDecimator::SetActiveChannels()), and then
+       * to @ref PdmRx if it has one too (e.g. 
+       * @ref StandardPdmRxService::SetActiveChannels()), so that the work of
+       * decimating, and where possible of copying out, the microphones which
+       * are not in use is saved. The output samples of those microphones 
+       * are zero. Otherwise, every microphone is still decimated.
+       * 
+       * May be called from any thread on the same tile while the mic array
+       * runs, e.g. when a beamformer has settled on a direction to which 
+       * only a few microphones contribute. The mask is passed on by 
+       * `ThreadEntry()` before its next block. A microphone switched back on
+       * is only decimated again from the first block @ref PdmRx has wholly
+       * copied it into (see @ref StandardPdmRxService::CopiedChannels()),
+       * which may be a block or two later.
+       * 
+       * Only available if `MIC_COUNT` is at most `32`.
+       * 
+       * @param mask  Mask of the microphones to decimate.
+       */
+      void SetActiveChannels(uint32_t mask);
+
+    private:
+
+      /**
+       * @brief Number of output samples decimated from each PDM block.
+       */
+      static constexpr unsigned BlockSamples = FrameMode
+          ? OutputHandlerFrameSize<TOutputHandler>::value
+          : DecimatorSamplesPerBlock<TDecimator>::value;
+
+      /**
+       * @brief Mask with a bit set for each microphone.
+       */
+      static constexpr uint32_t AllChannels = (MIC_COUNT >= 32)? 0xFFFFFFFF 
+                                                : ((1u << (MIC_COUNT % 32)) - 1);
+
+      /**
+       * @brief Microphones to decimate, as set by `SetActiveChannels()`.
+       */
+      volatile uint32_t requested_channels = AllChannels;
+
+      /**
+       * @brief Microphones last passed to @ref Decimator by `ThreadEntry()`.
+       */
+      uint32_t decimated_channels = AllChannels;
+
+      /**
+       * @brief Pass `requested_channels` on to @ref Decimator and @ref PdmRx.
+       * 
+       * Called by `ThreadEntry()` after getting a PDM block. @ref PdmRx is
+       * told to copy the requested microphones, while @ref Decimator is only
+       * given those of them which are whole in the block just received, so
+       * a microphone switched back on is never primed from stale PDM words.
+       */
+      void UpdateActiveChannels(std::true_type);
+
+      /**
+       * @brief Do nothing, for more than 32 microphones.
+       */
+      void UpdateActiveChannels(std::false_type);
+
+      /**
+       * @brief Decimation loop, one or more samples per PDM block.
+       */
+      void ThreadEntry(std::false_type);
+
+      /**
+       * @brief Decimation loop, one frame per PDM block. See @ref FrameMode.
+       */
+      void ThreadEntry(std::true_type);
+
+      /**
+       * @brief Decimate a PDM block into at most one output sample.
+       * 
+       * @returns Number of output samples.
+       */
+      template <unsigned SAMPLES>
+      unsigned DecimateBlock(
+          int32_t (&sample_out)[SAMPLES][MIC_COUNT],
+          uint32_t* pdm_samples,
+          std::true_type);
+
+      /**
+       * @brief Decimate a PDM block into up to `SAMPLES` output samples.
+       * 
+       * @returns Number of output samples.
+       */
+      template <unsigned SAMPLES>
+      unsigned DecimateBlock(
+          int32_t (&sample_out)[SAMPLES][MIC_COUNT],
+          uint32_t* pdm_samples,
+          std::false_type);
+
+      /**
+       * @brief Decimate a PDM block into the single sample vector
+       *        `samples[0]`.
+       * 
+       * Only participates in overload resolution if `TDecimator`'s
+       * `ProcessBlock()` takes a sample vector.
+       * 
+       * @returns Number of output samples, i.e. `1`.
+       */
+      template <class T, unsigned SAMPLES>
+      static auto ProcessSample(
+          T& decimator,
+          int32_t (&samples)[SAMPLES][MIC_COUNT],
+          uint32_t* pdm_samples,
+          int) -> decltype(decimator.ProcessBlock(samples[0], pdm_samples),
+                           unsigned());
+
+      /**
+       * @brief Decimate a PDM block with a decimator which takes an array of
+       *        sample vectors, though it makes at most one sample per block.
+       * 
+       * E.g. @ref MultiRateDecimator with a `BLOCK_WORDS` of `1`, which
+       * outputs a sample only every `dec_factor` blocks.
+       */
+      template <class T, unsigned SAMPLES>
+      static unsigned ProcessSample(
+          T& decimator,
+          int32_t (&samples)[SAMPLES][MIC_COUNT],
+          uint32_t* pdm_samples,
+          long);
+
+      /**
+       * @brief Decimate a PDM block with a decimator which reports how many
+       *        samples it produced.
+       * 
+       * Only participates in overload resolution if `TDecimator`'s
+       * `ProcessBlock()` returns a value.
+       */
+      template <class T, unsigned SAMPLES>
+      static auto ProcessSamples(
+          T& decimator,
+          int32_t (&samples)[SAMPLES][MIC_COUNT],
+          uint32_t* pdm_samples,
+          int) -> typename std::enable_if<
+              !std::is_void<decltype(decimator.ProcessBlock(samples, 
+                                                            pdm_samples))>::value,
+              unsigned>::type;
+
+      /**
+       * @brief Decimate a PDM block with a decimator which always produces
+       *        `SAMPLES` samples.
+       */
+      template <class T, unsigned SAMPLES>
+      static unsigned ProcessSamples(
+          T& decimator,
+          int32_t (&samples)[SAMPLES][MIC_COUNT],
+          uint32_t* pdm_samples,
+          long);
+
+      /**
+       * @brief Filter a block of samples with `FilterSamples()`.
+       * 
+       * Only participates in overload resolution if `TSampleFilter`
+       * implements `FilterSamples()`.
+       */
+      template <class T, unsigned SAMPLES>
+      static auto FilterBlock(
+          T& filter,
+          int32_t (&samples)[SAMPLES][MIC_COUNT],
+          int) -> decltype(filter.FilterSamples(samples));
+
+      /**
+       * @brief Filter a block of samples one sample at a time.
+       */
+      template <class T, unsigned SAMPLES>
+      static void FilterBlock(
+          T& filter,
+          int32_t (&samples)[SAMPLES][MIC_COUNT],
+          long);
+
+      /**
+       * @brief Output a block of samples with `OutputSamples()`.
+       * 
+       * Only participates in overload resolution if `TOutputHandler`
+       * implements `OutputSamples()`.
+       */
+      template <class T, unsigned SAMPLES>
+      static auto OutputBlock(
+          T& handler,
+          int32_t (&samples)[SAMPLES][MIC_COUNT],
+          int) -> decltype(handler.OutputSamples(samples));
+
+      /**
+       * @brief Output a block of samples one sample at a time.
+       */
+      template <class T, unsigned SAMPLES>
+      static void OutputBlock(
+          T& handler,
+          int32_t (&samples)[SAMPLES][MIC_COUNT],
+          long);
+
+      /**
+       * @brief Point the decimator's `Profiler` member at `profiler`.
+       * 
+       * Only participates in overload resolution if `TDecimator` has a
+       * `Profiler` member.
+       */
+      template <class T>
+      static auto AttachProfiler(
+          T& decimator,
+          StageProfiler* profiler,
+          int) -> decltype(void(decimator.Profiler = profiler));
+
+      /**
+       * @brief Do nothing, for decimators without a `Profiler` member.
+       */
+      template <class T>
+      static void AttachProfiler(
+          T& decimator,
+          StageProfiler* profiler,
+          long);
+
+      /**
+       * @brief Prime the decimator from a block of PDM data.
+       * 
+       * Only participates in overload resolution if `TDecimator` has a 
+       * `Prime()` method.
+       */
+      template <class T>
+      static auto PrimeFromBlock(
+          T& decimator,
+          uint32_t* pdm_samples,
+          int) -> decltype(decimator.Prime(pdm_samples));
+
+      /**
+       * @brief Do nothing, for decimators which cannot be primed.
+       */
+      template <class T>
+      static void PrimeFromBlock(
+          T& decimator,
+          uint32_t* pdm_samples,
+          long);
+
+      /**
+       * @brief Pass a mask of active microphones to a component.
+       * 
+       * Only participates in overload resolution if `T` has a 
+       * `SetActiveChannels()` method.
+       * 
+       * @returns `true`.
+       */
+      template <class T>
+      static auto ForwardActiveChannels(
+          T& component,
+          uint32_t mask,
+          int) -> decltype(component.SetActiveChannels(mask), bool());
+
+      /**
+       * @brief Do nothing, for components which always process every
+       *        microphone.
+       * 
+       * @returns `false`.
+       */
+      template <class T>
+      static bool ForwardActiveChannels(
+          T& component,
+          uint32_t mask,
+          long);
+
+      /**
+       * @brief Get the microphones copied into the latest PDM block.
+       * 
+       * Only participates in overload resolution if `T` has a 
+       * `CopiedChannels()` method.
+       */
+      template <class T>
+      static auto BlockChannels(
+          T& pdm_rx,
+          int) -> decltype(pdm_rx.CopiedChannels());
+
+      /**
+       * @brief Get every microphone, for components which always copy them
+       *        all.
+       */
+      template <class T>
+      static uint32_t BlockChannels(
+          T& pdm_rx,
+          long);
+
+      /**
+       * @brief Pass the stamp of the latest PDM block to the output handler.
+       * 
+       * Only participates in overload resolution if `TPdmRx` has a
+       * `GetBlockStamp()` method and `TOutputHandler` a `SetBlockStamp()`
+       * method (e.g. @ref StandardPdmRxService and @ref FrameOutputHandler).
+       */
+      template <class R, class H>
+      static auto StampBlock(
+          R& pdm_rx,
+          H& handler,
+          int) -> decltype(handler.SetBlockStamp(0u, 
+                                                 pdm_rx.GetBlockStamp().timestamp));
+
+      /**
+       * @brief Do nothing, for components without block stamps.
+       */
+      template <class R, class H>
+      static void StampBlock(
+          R& pdm_rx,
+          H& handler,
+          long);
+
+      /**
+       * @brief Wait until @ref ReleaseDelay ticks after the timestamp of the
+       *        latest PDM block.
+       * 
+       * Only participates in overload resolution if `TPdmRx` has a
+       * `GetBlockStamp()` method.
+       */
+      template <class R>
+      auto ReleaseBlock(
+          R& pdm_rx,
+          hwtimer_t timer,
+          int) -> decltype(void(pdm_rx.GetBlockStamp()));
+
+      /**
+       * @brief Do nothing, for components without block stamps.
+       */
+      template <class R>
+      void ReleaseBlock(
+          R& pdm_rx,
+          hwtimer_t timer,
+          long);
   };
 
 }
@@ -244,6 +870,56 @@ namespace  mic_array {
 //////////////////////////////////////////////
 
 
+template <unsigned MIC_COUNT, 
+          class TDecimator,
+          class TPdmRx, 
+          class TSampleFilter, 
+          class TOutputHandler> 
+template <class... Args>
+constexpr unsigned mic_array::MicArray<MIC_COUNT,TDecimator,TPdmRx,
+                                       TSampleFilter,
+                                       TOutputHandler>::Latency(Args... args)
+{
+  // The PDM blocks a frame spans after the one holding its oldest sample.
+  return TDecimator::Latency(args...) 
+      + ((OutputHandlerFrameSize<TOutputHandler>::value 
+            + DecimatorSamplesPerBlock<TDecimator>::value - 1) 
+          / DecimatorSamplesPerBlock<TDecimator>::value - 1) 
+        * DecimatorSamplesPerBlock<TDecimator>::value 
+        * TDecimator::SamplePeriod;
+}
+
+
+template <unsigned MIC_COUNT, 
+          class TDecimator,
+          class TPdmRx, 
+          class TSampleFilter, 
+          class TOutputHandler> 
+constexpr unsigned mic_array::MicArray<MIC_COUNT,TDecimator,TPdmRx,
+                                       TSampleFilter,
+                                       TOutputHandler>::MemoryFootprint()
+{
+  return sizeof(MicArray);
+}
+
+
+template <unsigned MIC_COUNT, 
+          class TDecimator,
+          class TPdmRx, 
+          class TSampleFilter, 
+          class TOutputHandler> 
+constexpr float mic_array::MicArray<MIC_COUNT,TDecimator,TPdmRx,
+                                    TSampleFilter,
+                                    TOutputHandler>::RequiredMips(
+    const unsigned pdm_freq,
+    const bool isr)
+{
+  return TDecimator::RequiredMips(pdm_freq) 
+       + TPdmRx::RequiredMips(pdm_freq, isr)
+       + TOutputHandler::RequiredMips(pdm_freq / TDecimator::SamplePeriod);
+}
+
+
 
 template <unsigned MIC_COUNT, 
           class TDecimator,
@@ -254,12 +930,566 @@ void mic_array::MicArray<MIC_COUNT,TDecimator,TPdmRx,
                                    TSampleFilter,
                                    TOutputHandler>::ThreadEntry()
 {
-  int32_t sample_out[MIC_COUNT] = {0};
+  this->ThreadEntry(std::integral_constant<bool, FrameMode>());
+}
+
+
+template <unsigned MIC_COUNT, 
+          class TDecimator,
+          class TPdmRx, 
+          class TSampleFilter, 
+          class TOutputHandler> 
+void mic_array::MicArray<MIC_COUNT,TDecimator,TPdmRx,
+                                   TSampleFilter,
+                                   TOutputHandler>::ThreadEntry(
+    std::false_type)
+{
+  constexpr unsigned SAMPLES = DecimatorSamplesPerBlock<TDecimator>::value;
+
+  int32_t sample_out[SAMPLES][MIC_COUNT] = {{0}};
+
+  unsigned settling = this->SettlingSamples;
+  bool prime = this->PrimeDecimator;
+
+  // Never freed, as this function does not return.
+  const hwtimer_t release_timer = this->ReleaseDelay? hwtimer_alloc() : 0;
+
+  MIC_ARRAY_PROFILE(AttachProfiler(Decimator, &Profiler, 0));
+  MIC_ARRAY_PROFILE(Profiler.Start());
 
   while(1){
     uint32_t* pdm_samples = PdmRx.GetPdmBlock();
-    Decimator.ProcessBlock(sample_out, pdm_samples);
-    SampleFilter.Filter(sample_out);
-    OutputHandler.OutputSample(sample_out);
+    StampBlock(PdmRx, OutputHandler, 0);
+    if(this->requested_channels != this->decimated_channels)
+      UpdateActiveChannels(std::integral_constant<bool, MIC_COUNT <= 32>());
+    MIC_ARRAY_PROFILE(Profiler.Mark(PROFILE_PDM_RX));
+    if(prime && !settling){
+      PrimeFromBlock(Decimator, pdm_samples, 0);
+      prime = false;
+    }
+    unsigned count = DecimateBlock(sample_out, pdm_samples, 
+                                   std::integral_constant<bool, SAMPLES == 1>());
+    MIC_ARRAY_PROFILE(Profiler.Mark(PROFILE_DECIMATOR));
+    if(settling){
+      settling = (count < settling)? settling - count : 0;
+      continue;
+    }
+    if(count == SAMPLES){
+      FilterBlock(SampleFilter, sample_out, 0);
+      MIC_ARRAY_PROFILE(Profiler.Mark(PROFILE_SAMPLE_FILTER));
+      ReleaseBlock(PdmRx, release_timer, 0);
+      OutputBlock(OutputHandler, sample_out, 0);
+      MIC_ARRAY_PROFILE(Profiler.Mark(PROFILE_OUTPUT));
+    } else {
+      ReleaseBlock(PdmRx, release_timer, 0);
+      for(unsigned s = 0; s < count; s++){
+        SampleFilter.Filter(sample_out[s]);
+        MIC_ARRAY_PROFILE(Profiler.Mark(PROFILE_SAMPLE_FILTER));
+        OutputHandler.OutputSample(sample_out[s]);
+        MIC_ARRAY_PROFILE(Profiler.Mark(PROFILE_OUTPUT));
+      }
+    }
   }
-}
\ No newline at end of file
+}
+
+
+template <unsigned MIC_COUNT, 
+          class TDecimator,
+          class TPdmRx, 
+          class TSampleFilter, 
+          class TOutputHandler> 
+void mic_array::MicArray<MIC_COUNT,TDecimator,TPdmRx,
+                                   TSampleFilter,
+                                   TOutputHandler>::ThreadEntry(
+    std::true_type)
+{
+  static_assert(std::is_same<TSampleFilter, NopSampleFilter<MIC_COUNT>>::value,
+      "FrameMode does not filter per sample. Use NopSampleFilter<MIC_COUNT> "
+      "as TSampleFilter, and the decimator's TSampleFilter instead.");
+
+  constexpr unsigned FRAME_SIZE = OutputHandlerFrameSize<TOutputHandler>::value;
+
+  int32_t frame_out[MIC_COUNT][FRAME_SIZE];
+
+  unsigned settling = this->SettlingSamples;
+  bool prime = this->PrimeDecimator;
+
+  // Never freed, as this function does not return.
+  const hwtimer_t release_timer = this->ReleaseDelay? hwtimer_alloc() : 0;
+
+  MIC_ARRAY_PROFILE(AttachProfiler(Decimator, &Profiler, 0));
+  MIC_ARRAY_PROFILE(Profiler.Start());
+
+  while(1){
+    uint32_t* pdm_frame = PdmRx.GetPdmBlock();
+    StampBlock(PdmRx, OutputHandler, 0);
+    if(this->requested_channels != this->decimated_channels)
+      UpdateActiveChannels(std::integral_constant<bool, MIC_COUNT <= 32>());
+    MIC_ARRAY_PROFILE(Profiler.Mark(PROFILE_PDM_RX));
+    if(prime && !settling){
+      Decimator.template PrimeFrame<FRAME_SIZE>(pdm_frame);
+      prime = false;
+    }
+    Decimator.template ProcessFrame<FRAME_SIZE>(frame_out, pdm_frame);
+    MIC_ARRAY_PROFILE(Profiler.Mark(PROFILE_DECIMATOR));
+    if(settling){
+      settling = (FRAME_SIZE < settling)? settling - FRAME_SIZE : 0;
+      continue;
+    }
+    ReleaseBlock(PdmRx, release_timer, 0);
+    OutputHandler.OutputFrame(frame_out);
+    MIC_ARRAY_PROFILE(Profiler.Mark(PROFILE_OUTPUT));
+  }
+}
+
+
+template <unsigned MIC_COUNT, 
+          class TDecimator,
+          class TPdmRx, 
+          class TSampleFilter, 
+          class TOutputHandler> 
+void mic_array::MicArray<MIC_COUNT,TDecimator,TPdmRx,
+                                   TSampleFilter,
+                                   TOutputHandler>::SetActiveChannels(
+    uint32_t mask)
+{
+  static_assert(MIC_COUNT <= 32, 
+                "SetActiveChannels() requires MIC_COUNT of at most 32.");
+  // A single word store, picked up by ThreadEntry() at its next block.
+  this->requested_channels = mask & AllChannels;
+}
+
+
+template <unsigned MIC_COUNT, 
+          class TDecimator,
+          class TPdmRx, 
+          class TSampleFilter, 
+          class TOutputHandler> 
+void mic_array::MicArray<MIC_COUNT,TDecimator,TPdmRx,
+                                   TSampleFilter,
+                                   TOutputHandler>::UpdateActiveChannels(
+    std::true_type)
+{
+  const uint32_t requested = this->requested_channels;
+  // A microphone switched back on waits until PdmRx has copied a whole
+  // block of it; those still decimated were never skipped by PdmRx.
+  uint32_t decimated = requested & BlockChannels(this->PdmRx, 0);
+
+  // PdmRx may only skip channels which the decimator will not read. The
+  // decimator drops the others from this block on, and PdmRx from the next.
+  if(ForwardActiveChannels(this->Decimator, decimated, 0))
+    ForwardActiveChannels(this->PdmRx, requested, 0);
+  else
+    decimated = requested;
+
+  this->decimated_channels = decimated;
+}
+
+
+template <unsigned MIC_COUNT, 
+          class TDecimator,
+          class TPdmRx, 
+          class TSampleFilter, 
+          class TOutputHandler> 
+void mic_array::MicArray<MIC_COUNT,TDecimator,TPdmRx,
+                                   TSampleFilter,
+                                   TOutputHandler>::UpdateActiveChannels(
+    std::false_type)
+{
+}
+
+
+template <unsigned MIC_COUNT, 
+          class TDecimator,
+          class TPdmRx, 
+          class TSampleFilter, 
+          class TOutputHandler> 
+template <unsigned SAMPLES>
+unsigned mic_array::MicArray<MIC_COUNT,TDecimator,TPdmRx,
+                                   TSampleFilter,
+                                   TOutputHandler>::DecimateBlock(
+    int32_t (&sample_out)[SAMPLES][MIC_COUNT],
+    uint32_t* pdm_samples,
+    std::true_type)
+{
+  return ProcessSample(Decimator, sample_out, pdm_samples, 0);
+}
+
+
+template <unsigned MIC_COUNT, 
+          class TDecimator,
+          class TPdmRx, 
+          class TSampleFilter, 
+          class TOutputHandler> 
+template <unsigned SAMPLES>
+unsigned mic_array::MicArray<MIC_COUNT,TDecimator,TPdmRx,
+                                   TSampleFilter,
+                                   TOutputHandler>::DecimateBlock(
+    int32_t (&sample_out)[SAMPLES][MIC_COUNT],
+    uint32_t* pdm_samples,
+    std::false_type)
+{
+  return ProcessSamples(Decimator, sample_out, pdm_samples, 0);
+}
+
+
+template <unsigned MIC_COUNT, 
+          class TDecimator,
+          class TPdmRx, 
+          class TSampleFilter, 
+          class TOutputHandler> 
+template <class T, unsigned SAMPLES>
+auto mic_array::MicArray<MIC_COUNT,TDecimator,TPdmRx,
+                                   TSampleFilter,
+                                   TOutputHandler>::ProcessSample(
+    T& decimator,
+    int32_t (&samples)[SAMPLES][MIC_COUNT],
+    uint32_t* pdm_samples,
+    int) -> decltype(decimator.ProcessBlock(samples[0], pdm_samples),
+                     unsigned())
+{
+  decimator.ProcessBlock(samples[0], pdm_samples);
+  return 1;
+}
+
+
+template <unsigned MIC_COUNT, 
+          class TDecimator,
+          class TPdmRx, 
+          class TSampleFilter, 
+          class TOutputHandler> 
+template <class T, unsigned SAMPLES>
+unsigned mic_array::MicArray<MIC_COUNT,TDecimator,TPdmRx,
+                                   TSampleFilter,
+                                   TOutputHandler>::ProcessSample(
+    T& decimator,
+    int32_t (&samples)[SAMPLES][MIC_COUNT],
+    uint32_t* pdm_samples,
+    long)
+{
+  return ProcessSamples(decimator, samples, pdm_samples, 0);
+}
+
+
+template <unsigned MIC_COUNT, 
+          class TDecimator,
+          class TPdmRx, 
+          class TSampleFilter, 
+          class TOutputHandler> 
+template <class T, unsigned SAMPLES>
+auto mic_array::MicArray<MIC_COUNT,TDecimator,TPdmRx,
+                                   TSampleFilter,
+                                   TOutputHandler>::ProcessSamples(
+    T& decimator,
+    int32_t (&samples)[SAMPLES][MIC_COUNT],
+    uint32_t* pdm_samples,
+    int) -> typename std::enable_if<
+        !std::is_void<decltype(decimator.ProcessBlock(samples, 
+                                                      pdm_samples))>::value,
+        unsigned>::type
+{
+  return decimator.ProcessBlock(samples, pdm_samples);
+}
+
+
+template <unsigned MIC_COUNT, 
+          class TDecimator,
+          class TPdmRx, 
+          class TSampleFilter, 
+          class TOutputHandler> 
+template <class T, unsigned SAMPLES>
+unsigned mic_array::MicArray<MIC_COUNT,TDecimator,TPdmRx,
+                                   TSampleFilter,
+                                   TOutputHandler>::ProcessSamples(
+    T& decimator,
+    int32_t (&samples)[SAMPLES][MIC_COUNT],
+    uint32_t* pdm_samples,
+    long)
+{
+  decimator.ProcessBlock(samples, pdm_samples);
+  return SAMPLES;
+}
+
+
+template <unsigned MIC_COUNT, 
+          class TDecimator,
+          class TPdmRx, 
+          class TSampleFilter, 
+          class TOutputHandler> 
+template <class T, unsigned SAMPLES>
+auto mic_array::MicArray<MIC_COUNT,TDecimator,TPdmRx,
+                                   TSampleFilter,
+                                   TOutputHandler>::FilterBlock(
+    T& filter,
+    int32_t (&samples)[SAMPLES][MIC_COUNT],
+    int) -> decltype(filter.FilterSamples(samples))
+{
+  return filter.FilterSamples(samples);
+}
+
+
+template <unsigned MIC_COUNT, 
+          class TDecimator,
+          class TPdmRx, 
+          class TSampleFilter, 
+          class TOutputHandler> 
+template <class T, unsigned SAMPLES>
+void mic_array::MicArray<MIC_COUNT,TDecimator,TPdmRx,
+                                   TSampleFilter,
+                                   TOutputHandler>::FilterBlock(
+    T& filter,
+    int32_t (&samples)[SAMPLES][MIC_COUNT],
+    long)
+{
+  for(unsigned s = 0; s < SAMPLES; s++)
+    filter.Filter(samples[s]);
+}
+
+
+template <unsigned MIC_COUNT, 
+          class TDecimator,
+          class TPdmRx, 
+          class TSampleFilter, 
+          class TOutputHandler> 
+template <class T, unsigned SAMPLES>
+auto mic_array::MicArray<MIC_COUNT,TDecimator,TPdmRx,
+                                   TSampleFilter,
+                                   TOutputHandler>::OutputBlock(
+    T& handler,
+    int32_t (&samples)[SAMPLES][MIC_COUNT],
+    int) -> decltype(handler.OutputSamples(samples))
+{
+  return handler.OutputSamples(samples);
+}
+
+
+template <unsigned MIC_COUNT, 
+          class TDecimator,
+          class TPdmRx, 
+          class TSampleFilter, 
+          class TOutputHandler> 
+template <class T, unsigned SAMPLES>
+void mic_array::MicArray<MIC_COUNT,TDecimator,TPdmRx,
+                                   TSampleFilter,
+                                   TOutputHandler>::OutputBlock(
+    T& handler,
+    int32_t (&samples)[SAMPLES][MIC_COUNT],
+    long)
+{
+  for(unsigned s = 0; s < SAMPLES; s++)
+    handler.OutputSample(samples[s]);
+}
+
+
+template <unsigned MIC_COUNT, 
+          class TDecimator,
+          class TPdmRx, 
+          class TSampleFilter, 
+          class TOutputHandler> 
+template <class T>
+auto mic_array::MicArray<MIC_COUNT,TDecimator,TPdmRx,
+                                   TSampleFilter,
+                                   TOutputHandler>::AttachProfiler(
+    T& decimator,
+    StageProfiler* profiler,
+    int) -> decltype(void(decimator.Profiler = profiler))
+{
+  decimator.Profiler = profiler;
+}
+
+
+template <unsigned MIC_COUNT, 
+          class TDecimator,
+          class TPdmRx, 
+          class TSampleFilter, 
+          class TOutputHandler> 
+template <class T>
+void mic_array::MicArray<MIC_COUNT,TDecimator,TPdmRx,
+                                   TSampleFilter,
+                                   TOutputHandler>::AttachProfiler(
+    T& decimator,
+    StageProfiler* profiler,
+    long)
+{
+}
+
+
+template <unsigned MIC_COUNT, 
+          class TDecimator,
+          class TPdmRx, 
+          class TSampleFilter, 
+          class TOutputHandler> 
+template <class T>
+auto mic_array::MicArray<MIC_COUNT,TDecimator,TPdmRx,
+                                   TSampleFilter,
+                                   TOutputHandler>::PrimeFromBlock(
+    T& decimator,
+    uint32_t* pdm_samples,
+    int) -> decltype(decimator.Prime(pdm_samples))
+{
+  return decimator.Prime(pdm_samples);
+}
+
+
+template <unsigned MIC_COUNT, 
+          class TDecimator,
+          class TPdmRx, 
+          class TSampleFilter, 
+          class TOutputHandler> 
+template <class T>
+void mic_array::MicArray<MIC_COUNT,TDecimator,TPdmRx,
+                                   TSampleFilter,
+                                   TOutputHandler>::PrimeFromBlock(
+    T& decimator,
+    uint32_t* pdm_samples,
+    long)
+{
+}
+
+
+template <unsigned MIC_COUNT, 
+          class TDecimator,
+          class TPdmRx, 
+          class TSampleFilter, 
+          class TOutputHandler> 
+template <class T>
+auto mic_array::MicArray<MIC_COUNT,TDecimator,TPdmRx,
+                                   TSampleFilter,
+                                   TOutputHandler>::ForwardActiveChannels(
+    T& component,
+    uint32_t mask,
+    int) -> decltype(component.SetActiveChannels(mask), bool())
+{
+  component.SetActiveChannels(mask);
+  return true;
+}
+
+
+template <unsigned MIC_COUNT, 
+          class TDecimator,
+          class TPdmRx, 
+          class TSampleFilter, 
+          class TOutputHandler> 
+template <class T>
+bool mic_array::MicArray<MIC_COUNT,TDecimator,TPdmRx,
+                                   TSampleFilter,
+                                   TOutputHandler>::ForwardActiveChannels(
+    T& component,
+    uint32_t mask,
+    long)
+{
+  return false;
+}
+
+
+template <unsigned MIC_COUNT, 
+          class TDecimator,
+          class TPdmRx, 
+          class TSampleFilter, 
+          class TOutputHandler> 
+template <class T>
+auto mic_array::MicArray<MIC_COUNT,TDecimator,TPdmRx,
+                                   TSampleFilter,
+                                   TOutputHandler>::BlockChannels(
+    T& pdm_rx,
+    int) -> decltype(pdm_rx.CopiedChannels())
+{
+  return pdm_rx.CopiedChannels();
+}
+
+
+template <unsigned MIC_COUNT, 
+          class TDecimator,
+          class TPdmRx, 
+          class TSampleFilter, 
+          class TOutputHandler> 
+template <class T>
+uint32_t mic_array::MicArray<MIC_COUNT,TDecimator,TPdmRx,
+                                   TSampleFilter,
+                                   TOutputHandler>::BlockChannels(
+    T& pdm_rx,
+    long)
+{
+  return 0xFFFFFFFF;
+}
+
+
+template <unsigned MIC_COUNT, 
+          class TDecimator,
+          class TPdmRx, 
+          class TSampleFilter, 
+          class TOutputHandler> 
+template <class R, class H>
+auto mic_array::MicArray<MIC_COUNT,TDecimator,TPdmRx,
+                                   TSampleFilter,
+                                   TOutputHandler>::StampBlock(
+    R& pdm_rx,
+    H& handler,
+    int) -> decltype(handler.SetBlockStamp(0u, 
+                                           pdm_rx.GetBlockStamp().timestamp))
+{
+  const PdmBlockStamp stamp = pdm_rx.GetBlockStamp();
+  return handler.SetBlockStamp(
+      stamp.block_index * BlockSamples,
+      stamp.timestamp);
+}
+
+
+template <unsigned MIC_COUNT, 
+          class TDecimator,
+          class TPdmRx, 
+          class TSampleFilter, 
+          class TOutputHandler> 
+template <class R, class H>
+void mic_array::MicArray<MIC_COUNT,TDecimator,TPdmRx,
+                                   TSampleFilter,
+                                   TOutputHandler>::StampBlock(
+    R& pdm_rx,
+    H& handler,
+    long)
+{
+}
+
+
+template <unsigned MIC_COUNT, 
+          class TDecimator,
+          class TPdmRx, 
+          class TSampleFilter, 
+          class TOutputHandler> 
+template <class R>
+auto mic_array::MicArray<MIC_COUNT,TDecimator,TPdmRx,
+                                   TSampleFilter,
+                                   TOutputHandler>::ReleaseBlock(
+    R& pdm_rx,
+    hwtimer_t timer,
+    int) -> decltype(void(pdm_rx.GetBlockStamp()))
+{
+  if(!this->ReleaseDelay)
+    return;
+
+  const uint32_t release = pdm_rx.GetBlockStamp().timestamp 
+                         + this->ReleaseDelay;
+
+  if(((int32_t) (release - get_reference_time())) <= 0){
+    this->LateReleases = this->LateReleases + 1;
+    return;
+  }
+
+  hwtimer_wait_until(timer, release);
+}
+
+
+template <unsigned MIC_COUNT, 
+          class TDecimator,
+          class TPdmRx, 
+          class TSampleFilter, 
+          class TOutputHandler> 
+template <class R>
+void mic_array::MicArray<MIC_COUNT,TDecimator,TPdmRx,
+                                   TSampleFilter,
+                                   TOutputHandler>::ReleaseBlock(
+    R& pdm_rx,
+    hwtimer_t timer,
+    long)
+{
+}
@@ -0,0 +1,91 @@
+// Copyright 2022-2024 XMOS LIMITED.
+// This Software is subject to the terms of the XMOS Public Licence: Version 1.
+
+#pragma once
+
+/**
+ * Instruction rate, in MIPS, which the mic array's compile-time MIPS budget
+ * assumes each thread gets (see @ref mic_array::FitsThreadMips()). The
+ * default, `75`, is the least a thread is offered with a 600 MHz core clock
+ * and all 8 threads of the tile busy (see
+ * \verbatim embed:rst :ref:`resource_usage`\endverbatim). Raise it if the
+ * core clock is faster or fewer threads will be running.
+ */
+#ifndef MIC_ARRAY_CONFIG_THREAD_MIPS
+# define MIC_ARRAY_CONFIG_THREAD_MIPS   (75)
+#endif
+
+
+namespace  mic_array {
+
+  /**
+   * @brief Instruction counts of the mic array's kernels, from which the
+   *        components' `RequiredMips()` estimates are built.
+   *
+   * The kernel counts are taken from the instruction listings of the
+   * kernels (including the call and return), and the per-block and
+   * per-word overheads are fitted so that the estimates of
+   * @ref TwoStageDecimator, @ref StandardPdmRxService and
+   * @ref FrameOutputHandler together land within 5% of the figures
+   * measured with `app_measure_mips` in
+   * \verbatim embed:rst :ref:`resource_usage`\endverbatim. They are for
+   * planning; measure the slack of the running mic array (see
+   * @ref StandardPdmRxService::GetSlack()) to confirm a configuration.
+   */
+  struct KernelCost {
+    /** `fir_1x16_bit()` and `fir_1xN_bit()` per output, per coefficient
+     *  bit plane (one `VLMACCR1` each). */
+    static constexpr unsigned FirPlane = 1;
+    /** `fir_1x16_bit()` and `fir_1xN_bit()` per output, other than the bit
+     *  planes: VPU set-up, the `macc_coeffs` reduction, call and return. */
+    static constexpr unsigned FirOutput = 16;
+    /** @ref PdmHistory per PDM word per mic. */
+    static constexpr unsigned HistoryWord = 12;
+    /** `filter_fir_s32_add_sample()` per stage 1 output per mic. */
+    static constexpr unsigned FirS32Push = 25;
+    /** `filter_fir_s32()` per output per mic, other than the taps. */
+    static constexpr unsigned FirS32Output = 80;
+    /** `filter_fir_s32()` taps per instruction. */
+    static constexpr unsigned FirS32TapsPerInstr = 2;
+    /** `fir_s16_multi()` taps per instruction, for
+     *  @ref Stage2FilterS16. */
+    static constexpr unsigned FirS16TapsPerInstr = 4;
+    /** @ref OutputScaler per output sample per mic. */
+    static constexpr unsigned ScaleSample = 8;
+    /** Deinterleaving and channel mapping per PDM word per channel. */
+    static constexpr unsigned DeinterleaveWord = 8;
+    /** Handing a PDM block to the decimation thread, and its loop. */
+    static constexpr unsigned PdmBlock = 20;
+    /** PDM rx ISR per port read. */
+    static constexpr unsigned IsrWord = 14;
+    /** `ma_frame_tx()` and the frame copy per sample per mic. */
+    static constexpr unsigned FrameTxSample = 5;
+    /** `ma_frame_tx()` per frame, other than the samples. */
+    static constexpr unsigned FrameTxFrame = 40;
+    /** Waking and collecting one worker thread of a
+     *  @ref ParallelDecimator, per block. */
+    static constexpr unsigned WorkerBlock = 30;
+  };
+
+  /**
+   * @brief Whether an estimated load fits in one thread.
+   *
+   * For use in a `static_assert`, with the `RequiredMips()` of a mic array
+   * or of its components, e.g.
+   *
+   * @code{.cpp}
+   * static_assert(mic_array::FitsThreadMips(AppMicArray::RequiredMips()),
+   *               "The decimation thread cannot keep up.");
+   * @endcode
+   *
+   * @param required_mips Estimated load, in MIPS.
+   * @param thread_mips   MIPS available to the thread.
+   */
+  constexpr bool FitsThreadMips(
+      const float required_mips,
+      const float thread_mips = MIC_ARRAY_CONFIG_THREAD_MIPS)
+  {
+    return required_mips <= thread_mips;
+  }
+
+}
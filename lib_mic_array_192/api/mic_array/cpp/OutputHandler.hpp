@@ -3,7 +3,9 @@
 
 #pragma once
 
+#include <atomic>
 #include <cstdint>
+#include <cstring>
 #include <string>
 #include <cassert>
 #include <iostream>
@@ -11,19 +13,351 @@
 #include <functional>
 
 #include "mic_array/frame_transfer.h"
+#include "mic_array/etc/fir_s32_multi.h"
+#include "Stage2Filter.hpp"
+#include "Mips.hpp"
 
 #include <xcore/channel.h>
+#include <xcore/channel_streaming.h>
+#include <xcore/channel_transaction.h>
+#include <xcore/interrupt.h>
+#include <xcore/port.h>
 
 
 // This has caused problems previously, so just catch the problems here.
-#if defined(MIC_COUNT) || defined(SAMPLE_COUNT) || defined(FRAME_COUNT)
-# error Application must not define the following as precompiler macros: MIC_COUNT, SAMPLE_COUNT, FRAME_COUNT.
+#if defined(MIC_COUNT) || defined(SAMPLE_COUNT) || defined(FRAME_COUNT) \
+    || defined(S2_DEC_FACTOR) || defined(S2_TAP_COUNT) \
+    || defined(OVERWRITE_OLDEST) || defined(SAMPLE_MAJOR) \
+    || defined(FRAME_FORMAT) || defined(BEAMS) || defined(TAP_COUNT) \
+    || defined(PREROLL_FRAMES) || defined(UP) || defined(DOWN) \
+    || defined(PHASE_TAPS) || defined(CAPACITY) || defined(SLOTS) \
+    || defined(FRAMES) || defined(WINDOW) || defined(HOP) \
+    || defined(FFT_SIZE) || defined(FIRST_BIN) || defined(BIN_COUNT) \
+    || defined(CONSUMERS) || defined(DEPTH) || defined(FULL_SCALE)
+# error Application must not define the following as precompiler macros: MIC_COUNT, SAMPLE_COUNT, FRAME_COUNT, S2_DEC_FACTOR, S2_TAP_COUNT, OVERWRITE_OLDEST, SAMPLE_MAJOR, FRAME_FORMAT, BEAMS, TAP_COUNT, PREROLL_FRAMES, UP, DOWN, PHASE_TAPS, CAPACITY, SLOTS, FRAMES, WINDOW, HOP, FFT_SIZE, FIRST_BIN, BIN_COUNT, CONSUMERS, DEPTH, FULL_SCALE.
 #endif
 
 using namespace std;
+extern "C" {
+
+  /**
+   * @brief TDM tx interrupt configuration and context.
+   * 
+   * Each time the TDM data port is ready for another word, `tdm_tx_isr` 
+   * (`tdm_tx_isr.S`) outputs `buffer[index]` to it, and the frame sync
+   * pattern of the current slot to the frame sync port (if any), and then
+   * moves on to the next word, wrapping at the end of the buffer. It never
+   * waits for, nor signals, anything else. 
+   * 
+   * @ref mic_array::TdmOutputHandler sets this up.
+   */
+  typedef struct {
+
+    /** 
+     * Port the TDM slots are output on. 
+     */
+    port_t p_tdm_out;
+
+    /**
+     * Port the frame sync is output on, or `0` for none.
+     */
+    port_t p_fsync;
+
+    /**
+     * Ring of slot words, `slots` per TDM frame, in the order they are 
+     * output.
+     */
+    const uint32_t* buffer;
+
+    /**
+     * Number of words in `buffer`.
+     */
+    unsigned words;
+
+    /**
+     * Index within `buffer` of the next word to output.
+     */
+    volatile unsigned index;
+
+    /**
+     * Frame sync word to output with each of the `slots` slots of a frame.
+     */
+    const uint32_t* fsync;
+
+    /**
+     * Number of slots in each TDM frame.
+     */
+    unsigned slots;
+
+    /**
+     * Slot of the next frame sync word to output.
+     */
+    unsigned slot;
+  } tdm_tx_context_t;
+
+  /**
+   * Configuration and context of the TDM tx ISR.
+   * 
+   * `tdm_tx_isr` (`tdm_tx_isr.S`) directly allocates this object.
+   */
+  extern tdm_tx_context_t tdm_tx_isr_context;
+
+  /**
+   * @brief Configure port to use `tdm_tx_isr` as an interrupt routine.
+   * 
+   * This function configures `p_tdm_out` to use `tdm_tx_isr` as its 
+   * interrupt vector and enables the interrupt on the current hardware 
+   * thread.
+   * 
+   * This function does NOT unmask interrupts.
+   * 
+   * @param p_tdm_out Port resource to enable ISR on.
+   */
+  static inline 
+  void enable_tdm_tx_isr(
+      const port_t p_tdm_out)
+  {
+    asm volatile(
+      "setc res[%0], %1       \n"
+      "ldap r11, tdm_tx_isr   \n"
+      "setv res[%0], r11      \n"
+      "eeu res[%0]              "
+        :
+        : "r"(p_tdm_out), "r"(XS1_SETC_IE_MODE_INTERRUPT)
+        : "r11" );
+  }
+
+}
 
 namespace  mic_array {
 
+  /**
+   * @brief Number of samples an output handler gathers into each frame.
+   * 
+   * An output handler which gathers samples into frames before passing them
+   * on (e.g. @ref FrameOutputHandler) advertises how many with a
+   * `static constexpr unsigned FrameSize` member. @ref MicArray::Latency()
+   * uses this to account for the time the oldest sample of each frame waits
+   * for the rest.
+   * 
+   * `value` is `TOutputHandler::FrameSize` if that member exists, and `1`
+   * otherwise.
+   * 
+   * @tparam TOutputHandler Output handler type.
+   */
+  template <class TOutputHandler, class = void>
+  struct OutputHandlerFrameSize 
+      : std::integral_constant<unsigned, 1> { };
+
+  template <class TOutputHandler>
+  struct OutputHandlerFrameSize<TOutputHandler, 
+                                decltype((void) TOutputHandler::FrameSize)>
+      : std::integral_constant<unsigned, TOutputHandler::FrameSize> { };
+
+  /**
+   * @brief Fewest frame buffers a frame transmitter needs from
+   *        @ref FrameOutputHandler.
+   * 
+   * A frame transmitter which hands frames to the consumer by pointer
+   * (e.g. @ref SharedMemoryFrameTransmitter) needs the frame being read to be
+   * left alone while the next is filled. It advertises how many frame
+   * buffers that takes with a `static constexpr unsigned MinFrameCount`
+   * member, which @ref FrameOutputHandler checks its `FRAME_COUNT` against.
+   * 
+   * `value` is `TFrameTransmitter::MinFrameCount` if that member exists, and
+   * `1` otherwise.
+   * 
+   * @tparam TFrameTransmitter Frame transmitter type.
+   */
+  template <class TFrameTransmitter, class = void>
+  struct FrameTransmitterMinFrames 
+      : std::integral_constant<unsigned, 1> { };
+
+  template <class TFrameTransmitter>
+  struct FrameTransmitterMinFrames<TFrameTransmitter, 
+                           decltype((void) TFrameTransmitter::MinFrameCount)>
+      : std::integral_constant<unsigned, 
+                               TFrameTransmitter::MinFrameCount> { };
+
+  /**
+   * @brief Frame format storing each sample as an `int32_t`.
+   * 
+   * This is the default `FRAME_FORMAT` of @ref FrameOutputHandler. Samples are
+   * stored unchanged.
+   */
+  struct FrameFormatS32
+  {
+    /**
+     * @brief Element type of a frame in this format.
+     */
+    using sample_t = int32_t;
+
+    /**
+     * @brief Number of bytes each sample occupies in a frame.
+     */
+    static constexpr unsigned BYTES_PER_SAMPLE = 4;
+
+    /**
+     * @brief Store `value` as sample `index` of `frame`.
+     */
+    static void Store(sample_t frame[], unsigned index, int32_t value)
+    {
+      frame[index] = value;
+    }
+
+    /**
+     * @brief Store `count` samples from `values` as samples `index` onwards of
+     *        `frame`.
+     */
+    static void Store(sample_t frame[], unsigned index, 
+                      const int32_t values[], unsigned count)
+    {
+      memcpy(&frame[index], values, sizeof(int32_t) * count);
+    }
+  };
+
+  /**
+   * @brief Frame format storing each sample as an `int16_t`.
+   * 
+   * For use as the `FRAME_FORMAT` of @ref FrameOutputHandler. Each sample is
+   * shifted right 16 bits, rounding and saturating, halving the frame's size.
+   * See `ma_s32_to_s16()`.
+   */
+  struct FrameFormatS16
+  {
+    /**
+     * @brief Element type of a frame in this format.
+     */
+    using sample_t = int16_t;
+
+    /**
+     * @brief Number of bytes each sample occupies in a frame.
+     */
+    static constexpr unsigned BYTES_PER_SAMPLE = 2;
+
+    /**
+     * @brief Store `value` as sample `index` of `frame`.
+     */
+    static void Store(sample_t frame[], unsigned index, int32_t value)
+    {
+      frame[index] = (value >= 0x7FFF8000)? 0x7FFF : ((value + 0x8000) >> 16);
+    }
+
+    /**
+     * @brief Store `count` samples from `values` as samples `index` onwards of
+     *        `frame`.
+     */
+    static void Store(sample_t frame[], unsigned index, 
+                      const int32_t values[], unsigned count)
+    {
+      ma_s32_to_s16(&frame[index], values, count);
+    }
+  };
+
+  /**
+   * @brief Frame format storing each sample as a packed 24-bit integer.
+   * 
+   * For use as the `FRAME_FORMAT` of @ref FrameOutputHandler. Each sample is
+   * shifted right 8 bits, rounding and saturating, and stored as 3 bytes, 
+   * least significant first, cutting the frame's size by a quarter. See
+   * `ma_s32_to_s24()`.
+   */
+  struct FrameFormatS24
+  {
+    /**
+     * @brief Element type of a frame in this format.
+     */
+    using sample_t = uint8_t;
+
+    /**
+     * @brief Number of bytes each sample occupies in a frame.
+     */
+    static constexpr unsigned BYTES_PER_SAMPLE = 3;
+
+    /**
+     * @brief Store `value` as sample `index` of `frame`.
+     */
+    static void Store(sample_t frame[], unsigned index, int32_t value)
+    {
+      const int32_t v = (value >= 0x7FFFFF80)? 0x7FFFFF : ((value + 0x80) >> 8);
+      frame[3*index + 0] = uint8_t(v);
+      frame[3*index + 1] = uint8_t(v >> 8);
+      frame[3*index + 2] = uint8_t(v >> 16);
+    }
+
+    /**
+     * @brief Store `count` samples from `values` as samples `index` onwards of
+     *        `frame`.
+     */
+    static void Store(sample_t frame[], unsigned index, 
+                      const int32_t values[], unsigned count)
+    {
+      ma_s32_to_s24(&frame[3*index], values, count);
+    }
+  };
+
+  /**
+   * @brief Frame format storing each sample as a `float`, normalised to full
+   *        scale.
+   * 
+   * For use as the `FRAME_FORMAT` of @ref FrameOutputHandler. Each sample is
+   * converted to `float` and divided by `FULL_SCALE`, so that a full scale
+   * PDM signal comes out as `+/-1.0`, as it is stored into the frame. See
+   * `ma_s32_to_f32()`.
+   * 
+   * `FULL_SCALE` should be the decimator's output for a full scale signal,
+   * e.g. 
+   * 
+   * @code{.cpp}
+   * FrameFormatF32<DecimatorFullScale<TDecimator>::value>
+   * @endcode
+   * 
+   * which is @ref STAGE2_FULL_SCALE for @ref TwoStageDecimator with its
+   * default filters, or @ref S1_FULL_SCALE for @ref OneStageDecimator192.
+   * The normalisation includes the decimator's default output shift, so it
+   * must be adjusted if that or the filters' gain are changed.
+   * 
+   * @tparam FULL_SCALE Decimator output which is converted to `1.0`.
+   */
+  template <int32_t FULL_SCALE = INT32_MAX>
+  struct FrameFormatF32
+  {
+    static_assert(FULL_SCALE > 0, "FULL_SCALE must be positive.");
+
+    /**
+     * @brief Element type of a frame in this format.
+     */
+    using sample_t = float;
+
+    /**
+     * @brief Number of bytes each sample occupies in a frame.
+     */
+    static constexpr unsigned BYTES_PER_SAMPLE = 4;
+
+    /**
+     * @brief Factor by which each sample is multiplied.
+     */
+    static constexpr float Scale() { return 1.0f / FULL_SCALE; }
+
+    /**
+     * @brief Store `value` as sample `index` of `frame`.
+     */
+    static void Store(sample_t frame[], unsigned index, int32_t value)
+    {
+      frame[index] = ((float) value) * Scale();
+    }
+
+    /**
+     * @brief Store `count` samples from `values` as samples `index` onwards of
+     *        `frame`.
+     */
+    static void Store(sample_t frame[], unsigned index, 
+                      const int32_t values[], unsigned count)
+    {
+      ma_s32_to_f32(&frame[index], values, count, Scale());
+    }
+  };
+
   /**
    * @brief OutputHandler implementation which groups samples into
    *        non-overlapping multi-sample audio frames and sends entire frames to
@@ -75,13 +409,48 @@ namespace  mic_array {
    * processing stages through shared memory, the default value of `1` is usualy
    * ideal.
    * @endparblock
+   * 
+   * @tparam SAMPLE_MAJOR @parblock
+   * If `true`, frames are assembled in `[SAMPLE_COUNT][MIC_COUNT]` order, i.e.
+   * each sample's channels are contiguous, rather than the default
+   * `[MIC_COUNT][SAMPLE_COUNT]`. The frame passed to @ref FrameTx still has
+   * the type `int32_t[MIC_COUNT][SAMPLE_COUNT]`, but its memory holds the
+   * sample-major layout. With @ref ChannelFrameTransmitter, a consumer which
+   * wants sample-major frames can then receive them with the bulk
+   * `ma_frame_rx()` instead of `ma_frame_rx_transpose()`, and the transpose
+   * costs nothing: each sample is stored in place as it arrives.
+   * @endparblock
+   * 
+   * @tparam FRAME_FORMAT @parblock
+   * The format in which samples are stored in frames; one of 
+   * @ref FrameFormatS32 (the default), @ref FrameFormatS16, 
+   * @ref FrameFormatS24 or @ref FrameFormatF32. The 16- and 24-bit formats
+   * reduce the frame buffers' size and the data transmitted per frame to a
+   * half or three quarters respectively. `FrameFormatF32` converts samples
+   * to normalised `float` as they are stored, for consumers which work in
+   * floating point, saving them a pass over each frame.
+   * 
+   * With `FrameFormatS32` frames are passed to @ref FrameTx as 
+   * `int32_t[MIC_COUNT][SAMPLE_COUNT]`. Otherwise they are passed as a 
+   * word-aligned `const FRAME_FORMAT::sample_t[]` holding 
+   * `MIC_COUNT * SAMPLE_COUNT` samples, and the `FrameTransmitter` must have
+   * an `OutputFrame()` overload taking that. @ref ChannelFrameTransmitter
+   * does.
+   * @endparblock
    */ 
   template <unsigned MIC_COUNT, 
             unsigned SAMPLE_COUNT, 
             template <unsigned, unsigned> class FrameTransmitter,
-            unsigned FRAME_COUNT = 1>
+            unsigned FRAME_COUNT = 1,
+            bool SAMPLE_MAJOR = false,
+            class FRAME_FORMAT = FrameFormatS32>
   class FrameOutputHandler
   {
+    static_assert(FRAME_COUNT >= FrameTransmitterMinFrames<
+                      FrameTransmitter<MIC_COUNT, SAMPLE_COUNT>>::value,
+                  "FRAME_COUNT is too small for FrameTransmitter, which "
+                  "would overwrite a frame its consumer is still reading.");
+
     private:
 
       /**
@@ -94,13 +463,106 @@ namespace  mic_array {
        */
       unsigned current_sample = 0;
 
+      /**
+       * @brief Number of words in each frame buffer.
+       */
+      static constexpr unsigned FRAME_WORDS = 
+          (MIC_COUNT * SAMPLE_COUNT * FRAME_FORMAT::BYTES_PER_SAMPLE + 3) / 4;
+
       /**
        * @brief Frame buffers for transmitted frames.
+       * 
+       * Each frame holds `MIC_COUNT * SAMPLE_COUNT` samples in 
+       * `FRAME_FORMAT`, in `[MIC_COUNT][SAMPLE_COUNT]` order, or 
+       * `[SAMPLE_COUNT][MIC_COUNT]` order if `SAMPLE_MAJOR`. Frames are 
+       * rounded up to whole words so that each is word-aligned.
+       */
+      uint32_t frames[FRAME_COUNT][FRAME_WORDS];
+
+      /**
+       * @brief Index of the next sample in the output stream.
+       */
+      uint32_t sample_index = 0;
+
+      /**
+       * @brief Timestamp of the latest block passed to `SetBlockStamp()`.
+       */
+      uint32_t block_time = 0;
+
+      /**
+       * @brief Header of the current frame.
+       */
+      ma_frame_header_t header = {0, 0};
+
+      /**
+       * @brief Get frame buffer `f` as an array of `FRAME_FORMAT` samples.
+       */
+      typename FRAME_FORMAT::sample_t* Frame(unsigned f);
+
+      /**
+       * @brief Store a sample at `current_sample` of the current frame.
+       *
+       * The frame's header is taken when its first sample is stored.
+       */
+      void StoreSample(const int32_t sample[MIC_COUNT]);
+
+      /**
+       * @brief Pass `frame` and its header to `tx`.
+       *
+       * Only participates in overload resolution if `T` has an
+       * `OutputFrame()` taking a header.
+       */
+      template <class T, class F>
+      static auto Deliver(
+          T& tx,
+          const ma_frame_header_t& header,
+          F frame,
+          int) -> decltype(tx.OutputFrame(header, frame));
+
+      /**
+       * @brief Pass `frame` to `tx`, for transmitters without headers.
+       */
+      template <class T, class F>
+      static void Deliver(
+          T& tx,
+          const ma_frame_header_t& header,
+          F frame,
+          long);
+
+      /**
+       * @brief Pass frame buffer `f` to @ref FrameTx as a 32-bit frame.
+       */
+      void Transmit(unsigned f, std::true_type);
+
+      /**
+       * @brief Pass frame buffer `f` to @ref FrameTx as a packed frame.
+       */
+      void Transmit(unsigned f, std::false_type);
+
+      /**
+       * @brief Pass `frame` straight to @ref FrameTx.
+       */
+      void OutputFrame(int32_t frame[MIC_COUNT][SAMPLE_COUNT], std::true_type);
+
+      /**
+       * @brief Convert `frame` into the current frame buffer and transmit it.
+       */
+      void OutputFrame(int32_t frame[MIC_COUNT][SAMPLE_COUNT], std::false_type);
+
+      /**
+       * @brief Transmit the current frame and move on to the next one.
        */
-      int32_t frames[FRAME_COUNT][MIC_COUNT][SAMPLE_COUNT];
+      void SendFrame();
 
     public:
 
+      /**
+       * @brief Number of samples in each frame.
+       * 
+       * See @ref OutputHandlerFrameSize.
+       */
+      static constexpr unsigned FrameSize = SAMPLE_COUNT;
+
       /**
        * @brief `FrameTransmitter` used to transmit frames to the
        *        next stage for processing.
@@ -129,6 +591,16 @@ namespace  mic_array {
        * Alternative implementations might use shared memory or an RTOS queue to
        * transmit the frame data, or might even use a port to signal the samples
        * directly to an external DAC.
+       *
+       * If `FrameTransmitter` instead implements
+       *
+       * @code{.cpp}
+       * void OutputFrame(const ma_frame_header_t& header,
+       *                  int32_t frame[MIC_COUNT][SAMPLE_COUNT]);
+       * @endcode
+       *
+       * that is called in its place, with the frame's header (see
+       * @ref SetBlockStamp()). @ref StampedChannelFrameTransmitter does this.
        */
       FrameTransmitter<MIC_COUNT, SAMPLE_COUNT> FrameTx;
 
@@ -152,135 +624,2812 @@ namespace  mic_array {
       FrameOutputHandler(FrameTransmitter<MIC_COUNT, SAMPLE_COUNT> frame_tx)
           : FrameTx(frame_tx) { }
 
+      /**
+       * @brief Estimated MIPS of this output handler.
+       * 
+       * Built from @ref KernelCost: storing and transmitting each sample of
+       * each mic, and transmitting each frame. See @ref FitsThreadMips().
+       * 
+       * @param sample_rate Output sample rate, in Hz.
+       */
+      static constexpr float RequiredMips(
+          const unsigned sample_rate);
+
       /**
        * @brief Add new sample to current frame and output frame if filled.
        * 
        * @param sample Sample to be added to current frame.
        */
       void OutputSample(int32_t sample[MIC_COUNT]);
+
+      /**
+       * @brief Add a block of samples to the current frame, outputting
+       *        frames as they are filled.
+       * 
+       * Equivalent to calling `OutputSample()` on each of `samples[0]`
+       * through `samples[SAMPLES-1]`, in that order.
+       * 
+       * @param samples Samples to be added to current frame.
+       */
+      template <unsigned SAMPLES>
+      void OutputSamples(int32_t (&samples)[SAMPLES][MIC_COUNT]);
+
+      /**
+       * @brief Output an already complete frame.
+       * 
+       * Hands `frame` directly to @ref FrameTx, bypassing this object's frame
+       * buffers. This is intended for decimators which write a whole frame at
+       * once (see @ref TwoStageDecimator::ProcessFrame()).
+       * 
+       * This must not be mixed with a partially filled frame; i.e. the number
+       * of samples previously supplied through @ref OutputSample() and 
+       * @ref OutputSamples() must be a multiple of `SAMPLE_COUNT`.
+       * 
+       * `frame` must remain valid for as long as the `FrameTransmitter` 
+       * requires. @ref ChannelFrameTransmitter sends frames by value, so with
+       * it `frame` may be reused as soon as this call returns.
+       * 
+       * If `SAMPLE_MAJOR`, `frame` (which is always in `[MIC][SAMPLE]` order)
+       * is instead transposed into this object's next frame buffer, which is
+       * then transmitted. Likewise, if `FRAME_FORMAT` is not 
+       * @ref FrameFormatS32, `frame` is first converted into the next frame
+       * buffer.
+       * 
+       * @param frame Frame to be transmitted.
+       */
+      void OutputFrame(int32_t frame[MIC_COUNT][SAMPLE_COUNT]);
+
+      /**
+       * @brief Set the position in time of the samples which follow.
+       *
+       * The next sample output becomes sample `sample_index` of the output
+       * stream, and subsequent samples follow on from it. The header of each
+       * frame (see `ma_frame_header_t`) holds the index of its first sample,
+       * and the `timestamp` most recently set when that sample was output.
+       *
+       * @ref MicArray calls this before outputting the samples decimated from
+       * each PDM block, if its PDM rx component provides a `GetBlockStamp()`
+       * (see @ref StandardPdmRxService::GetBlockStamp()), with
+       * `sample_index` the block's index times the decimator's samples per
+       * block (or the frame size, in @ref MicArray::FrameMode). Dropped PDM blocks then show up as a jump of the frame's
+       * `sample_index`. Otherwise, samples are simply counted from `0`.
+       *
+       * @param sample_index  Index of the next sample.
+       * @param timestamp     Reference time of the first PDM word of the
+       *                      block the next sample is decimated from.
+       */
+      void SetBlockStamp(uint32_t sample_index, uint32_t timestamp);
   };
 
 
   /**
-   * @brief Frame transmitter which transmits frame over a channel.
+   * @brief OutputHandler implementation which delivers overlapping, 
+   *        optionally windowed frames, e.g. for an STFT.
    * 
-   * This class template is meant for use as the `FrameTransmitter` template
-   * parameter of @ref FrameOutputHandler.
+   * This class template can be used as an OutputHandler with the @ref MicArray
+   * class template. See @ref MicArray::OutputHandler.
    * 
-   * When using this frame transmitter, frames are transmitted over a channel
-   * using the frame transfer API in `mic_array/frame_transfer.h`.
-   * \verbatim embed:rst
-     Usually, a call to :c:func:`ma_frame_rx()` (with the other end of 
-     `c_frame_out` as argument) should be used to receive the frame on 
-     another thread. \endverbatim
+   * Every `HOP` samples, a frame (window) of the last `WINDOW` samples of
+   * each channel is passed to @ref FrameTx, in `[MIC_COUNT][WINDOW]` order.
+   * With a `WINDOW` of twice the `HOP`, consecutive frames overlap by 50%.
+   * The consumer therefore needs no history buffer of its own, and does not
+   * copy the overlap out of each frame.
    * 
-   * If the receiving thread is not waiting to receive the frame when @ref
-   * OutputFrame() is called, that method will block until the frame has been
-   * transmitted. In order to ensure there are no violations of the mic array's
-   * real-time constraints, the receiver should be ready to receive a frame as
-   * soon as it becomes available.
+   * The handler keeps a ring of `WINDOW / HOP + 1` frames (@ref frames), of
+   * which `WINDOW / HOP` are being filled at any time, the oldest starting
+   * one hop before the next. Each sample is stored in each of them at its 
+   * offset in that frame, so a frame is complete, and contiguous, without
+   * being copied. The remaining frame is the one last passed to 
+   * @ref FrameTx, which the consumer may hold until the next is passed on. 
+   * With @ref SharedMemoryFrameTransmitter, frames are passed by pointer
+   * and read in place:
    * 
-   * @note While @ref OutputFrame() is blocking, it will not prevent the PDM rx
-   * interrupt from firing.
+   * @code{.cpp}
+   *  // 512-sample windows every 256 samples
+   *  mic_array::OverlapFrameOutputHandler<4, 512, 256, 
+   *      mic_array::SharedMemoryFrameTransmitter> output_handler;
+   * @endcode
    * 
-   * Frames can be transmitted between tiles using this class.
+   * If a window has been set with @ref SetWindow(), each frame is multiplied
+   * by it, channel by channel on the VPU, just before it is passed on, so 
+   * the consumer does not apply it sample by sample either.
    * 
-   * @tparam MIC_COUNT    Number of audio channels in each frame.
-   * @tparam SAMPLE_COUNT Number of samples per frame.
+   * Frames which start before the first sample are padded with `0`.
+   * 
+   * @tparam MIC_COUNT        Number of audio channels in each sample.
+   * @tparam WINDOW           Number of samples in each frame.
+   * @tparam HOP              Number of samples between the starts of 
+   *                          consecutive frames. `WINDOW` must be a multiple
+   *                          of it.
+   * @tparam FrameTransmitter The concrete type of @ref FrameTx, as for
+   *                          @ref FrameOutputHandler.
    */
-  template <unsigned MIC_COUNT, unsigned SAMPLE_COUNT>
-  class ChannelFrameTransmitter
+  template <unsigned MIC_COUNT, 
+            unsigned WINDOW, 
+            unsigned HOP,
+            template <unsigned, unsigned> class FrameTransmitter>
+  class OverlapFrameOutputHandler
   {
+    static_assert(HOP >= 1 && HOP <= WINDOW, 
+                  "HOP must be between 1 and WINDOW.");
+    static_assert(WINDOW % HOP == 0, "WINDOW must be a multiple of HOP.");
+
     private:
 
       /**
-       * @brief Channel over which frames are transmitted.
-       * 
-       * If the default constructor is used, @ref SetChannel() must be called to
-       * configure the channel over which frames are transmitted prior to any
-       * calls to @ref OutputFrame(). 
+       * @brief Number of frames being filled at any time.
        */
-      chanend_t c_frame_out;
+      static constexpr unsigned OVERLAPS = WINDOW / HOP;
+
+      /**
+       * @brief Number of frames in @ref frames.
+       */
+      static constexpr unsigned FRAME_COUNT = OVERLAPS + 1;
+
+      /**
+       * @brief Ring of frames.
+       */
+      int32_t frames[FRAME_COUNT][MIC_COUNT][WINDOW] = {{{0}}};
+
+      /**
+       * @brief Frame which started most recently.
+       */
+      unsigned newest = OVERLAPS - 1;
+
+      /**
+       * @brief Offset of the next sample in the newest frame.
+       */
+      unsigned offset = 0;
+
+      /**
+       * @brief Window coefficients, or `nullptr` for none.
+       */
+      const int32_t* window = nullptr;
 
     public:
 
       /**
-       * @brief Construct a `ChannelFrameTransmitter`.
+       * @brief Number of samples in each frame.
        * 
-       * If this constructor is used, @ref SetChannel() must be called to
-       * configure the channel over which frames are transmitted prior to any
-       * calls to @ref OutputFrame(). 
+       * See @ref OutputHandlerFrameSize.
        */
-      ChannelFrameTransmitter() : c_frame_out(0) { }
+      static constexpr unsigned FrameSize = WINDOW;
 
       /**
-       * @brief Construct a `ChannelFrameTransmitter`.
+       * @brief `FrameTransmitter` used to transmit frames.
+       */
+      FrameTransmitter<MIC_COUNT, WINDOW> FrameTx;
+
+      /**
+       * @brief Construct new `OverlapFrameOutputHandler`.
        * 
-       * The supplied value of `c_frame_out` must be a valid chanend.
+       * The default no-argument constructor for `FrameTransmitter` is used
+       * to create @ref FrameTx.
+       */
+      OverlapFrameOutputHandler() { }
+
+      /**
+       * @brief Construct new `OverlapFrameOutputHandler`.
        * 
-       * @param c_frame_out Chanend over which frames will be transmitted.
+       * @param frame_tx Frame transmitter for sending frames.
        */
-      ChannelFrameTransmitter(chanend_t c_frame_out) : c_frame_out(c_frame_out) { }
+      OverlapFrameOutputHandler(FrameTransmitter<MIC_COUNT, WINDOW> frame_tx)
+          : FrameTx(frame_tx) { }
 
       /**
-       * @brief Set channel used for frame transfers.
+       * @brief Set the window applied to each frame.
        * 
-       * The supplied value of `c_frame_out` must be a valid chanend.
+       * `window` holds `WINDOW` coefficients in Q1.31 format (e.g. a Hann
+       * window scaled by `2^31`, with `0x7FFFFFFF` for `1.0`). Only the 
+       * pointer is kept, so `window` must outlive the handler's use of it.
        * 
-       * @param c_frame_out Chanend over which frames will be transmitted.
+       * @param window Window coefficients, or `nullptr` to pass frames on
+       *               unwindowed.
        */
-      void SetChannel(chanend_t c_frame_out);
+      void SetWindow(
+          const int32_t window[WINDOW]);
 
       /**
-       * @brief Get the chanend used for frame transfers.
+       * @brief Add a new sample to the frames being filled, and pass on the
+       *        oldest of them once complete.
        * 
-       * @returns Channel to be used for frame transfers.
+       * @param sample Sample to be added.
        */
-      chanend_t GetChannel();
+      void OutputSample(int32_t sample[MIC_COUNT]);
 
       /**
-       * @brief Transmit the specified frame.
+       * @brief Add a block of samples.
        * 
-       * See @ref ChannelFrameTransmitter for additional details.
+       * Equivalent to calling `OutputSample()` on each of `samples[0]`
+       * through `samples[SAMPLES-1]`, in that order.
        * 
-       * @param frame Frame to be transmitted.
+       * @param samples Samples to be added.
        */
-      void OutputFrame(int32_t frame[MIC_COUNT][SAMPLE_COUNT]);
+      template <unsigned SAMPLES>
+      void OutputSamples(int32_t (&samples)[SAMPLES][MIC_COUNT]);
   };
 
-}  
 
+  /**
+   * @brief OutputHandler implementation which delivers the spectrum of each
+   *        frame instead of its samples.
+   * 
+   * This class template can be used as an OutputHandler with the @ref MicArray
+   * class template. See @ref MicArray::OutputHandler.
+   * 
+   * Samples are collected into frames of `FFT_SIZE` samples per channel, as
+   * by @ref FrameOutputHandler. Once a frame is complete, each channel is
+   * transformed in place with lib_xcore_math's real FFT, two channels at a
+   * time with `bfp_fft_forward_stereo()` (and the last, for an odd
+   * `MIC_COUNT`, with `bfp_fft_forward_mono()`), and the spectra are passed
+   * to @ref FrameTx. The FFT thus runs in the mic array's thread, on the
+   * tile which receives the PDM, rather than in the consumer's.
+   * 
+   * Each channel's spectrum in the frame is `BIN_COUNT` bins, from bin
+   * `FIRST_BIN`, as `BIN_COUNT` `complex_s32_t` (real part first) in the
+   * `2 * BIN_COUNT` words of the channel's row. So only the bins the 
+   * consumer needs are transmitted. As with lib_xcore_math's mono FFT, the 
+   * imaginary part of bin `0` holds the real part of bin `FFT_SIZE / 2` 
+   * (whose imaginary part, like that of bin `0`, is always zero).
+   * 
+   * The spectra are in a fixed format, rather than each with its own block
+   * floating-point exponent: with the samples taken as Q1.31, each bin is
+   * the DFT of the frame divided by `FFT_SIZE`, as Q1.31. That is, a full 
+   * scale DC input gives `0x7FFFFFFF` in bin `0`, and a full scale sinusoid
+   * centred on a bin gives a magnitude of half that.
+   * 
+   * The handler has two frames, filling one while the other, last passed to
+   * @ref FrameTx, may still be read by the consumer (e.g. through a
+   * @ref SharedMemoryFrameTransmitter).
+   * 
+   * @code{.cpp}
+   *  // Bins 0 to 63 of 256-point spectra of 4 channels
+   *  mic_array::FftOutputHandler<4, 256, 
+   *      mic_array::ChannelFrameTransmitter, 0, 64> output_handler;
+   * @endcode
+   * 
+   * @tparam MIC_COUNT        Number of audio channels in each sample.
+   * @tparam FFT_SIZE         Number of samples in each frame. Must be a power
+   *                          of `2`, and no smaller than `16`, nor larger 
+   *                          than lib_xcore_math's FFT supports 
+   *                          (`2 << MAX_DIT_FFT_LOG2`).
+   * @tparam FrameTransmitter The concrete type of @ref FrameTx, as for
+   *                          @ref FrameOutputHandler. Its `SAMPLE_COUNT` is
+   *                          `2 * BIN_COUNT`.
+   * @tparam FIRST_BIN        First bin of each spectrum passed on.
+   * @tparam BIN_COUNT        Number of bins of each spectrum passed on.
+   */
+  template <unsigned MIC_COUNT, 
+            unsigned FFT_SIZE, 
+            template <unsigned, unsigned> class FrameTransmitter,
+            unsigned FIRST_BIN = 0,
+            unsigned BIN_COUNT = FFT_SIZE / 2>
+  class FftOutputHandler
+  {
+    static_assert(FFT_SIZE >= 16 && (FFT_SIZE & (FFT_SIZE - 1)) == 0, 
+                  "FFT_SIZE must be a power of 2, of at least 16.");
+    static_assert(BIN_COUNT >= 1 && FIRST_BIN + BIN_COUNT <= FFT_SIZE / 2,
+                  "Bins must be within the FFT_SIZE / 2 bins of the spectrum.");
 
-//////////////////////////////////////////////
-// Template function implementations below. //
-//////////////////////////////////////////////
+    private:
 
+      /**
+       * @brief Frame buffers, spectra being computed in place.
+       */
+      alignas(8) int32_t frames[2][MIC_COUNT][FFT_SIZE] = {{{0}}};
+
+      /**
+       * @brief Scratch buffer of `bfp_fft_forward_stereo()`.
+       */
+      complex_s32_t scratch[(MIC_COUNT > 1)? FFT_SIZE : 1];
+
+      /**
+       * @brief Index of the frame being filled.
+       */
+      unsigned current_frame = 0;
+
+      /**
+       * @brief Index of the next sample in the frame being filled.
+       */
+      unsigned current_sample = 0;
+
+      /**
+       * @brief Convert the frame being filled into spectra, in the layout
+       *        passed to @ref FrameTx.
+       */
+      void Transform();
+
+    public:
+
+      /**
+       * @brief Number of samples in each frame.
+       * 
+       * See @ref OutputHandlerFrameSize.
+       */
+      static constexpr unsigned FrameSize = FFT_SIZE;
+
+      /**
+       * @brief Exponent of the spectra passed to @ref FrameTx.
+       * 
+       * A value `v` in a spectrum stands for `v * 2^SpectrumExponent` where
+       * the samples are taken to be Q1.31 (`2^-31` per LSB).
+       */
+      static constexpr int SpectrumExponent = -31;
+
+      /**
+       * @brief `FrameTransmitter` used to transmit spectra.
+       */
+      FrameTransmitter<MIC_COUNT, 2 * BIN_COUNT> FrameTx;
+
+      /**
+       * @brief Construct new `FftOutputHandler`.
+       * 
+       * The default no-argument constructor for `FrameTransmitter` is used
+       * to create @ref FrameTx.
+       */
+      FftOutputHandler() { }
+
+      /**
+       * @brief Construct new `FftOutputHandler`.
+       * 
+       * @param frame_tx Frame transmitter for sending spectra.
+       */
+      FftOutputHandler(FrameTransmitter<MIC_COUNT, 2 * BIN_COUNT> frame_tx)
+          : FrameTx(frame_tx) { }
+
+      /**
+       * @brief Add a new sample to the current frame, and transform and pass
+       *        on the frame once complete.
+       * 
+       * @param sample Sample to be added.
+       */
+      void OutputSample(int32_t sample[MIC_COUNT]);
+
+      /**
+       * @brief Add a block of samples.
+       * 
+       * Equivalent to calling `OutputSample()` on each of `samples[0]`
+       * through `samples[SAMPLES-1]`, in that order.
+       * 
+       * @param samples Samples to be added.
+       */
+      template <unsigned SAMPLES>
+      void OutputSamples(int32_t (&samples)[SAMPLES][MIC_COUNT]);
+  };
+
+
+  /**
+   * @brief OutputHandler implementation which delivers the mic array's output
+   *        at two sample rates.
+   * 
+   * This class template can be used as an OutputHandler with the @ref MicArray
+   * class template. See @ref MicArray::OutputHandler.
+   * 
+   * Every sample received is passed on unchanged to @ref FullRate. The samples
+   * are also decimated by a further factor of `S2_DEC_FACTOR` with a 32-bit
+   * FIR filter (see @ref Stage2Filter), and the decimated samples are passed to
+   * @ref LowRate. Both streams therefore share a single PDM receive and
+   * decimation pass. For example, with @ref OneStageDecimator192 as the mic
+   * array's decimator and `S2_DEC_FACTOR = 12`, @ref FullRate receives a 192
+   * kHz stream and @ref LowRate a 16 kHz stream of the same microphones.
+   * 
+   * Any @ref MicArray::SampleFilter is applied at the full rate, before the
+   * streams are split.
+   * 
+   * @tparam MIC_COUNT      Number of audio channels in each sample.
+   * @tparam S2_DEC_FACTOR  Decimation factor of the low rate stream.
+   * @tparam S2_TAP_COUNT   Tap count of the low rate stream's filter.
+   * @tparam TFullRate      OutputHandler type of the full rate stream.
+   * @tparam TLowRate       OutputHandler type of the low rate stream.
+   */
+  template <unsigned MIC_COUNT, 
+            unsigned S2_DEC_FACTOR, 
+            unsigned S2_TAP_COUNT,
+            class TFullRate,
+            class TLowRate>
+  class DualRateOutputHandler
+  {
+    private:
+
+      /**
+       * @brief Low rate decimation filter.
+       */
+      Stage2Filter<MIC_COUNT, S2_TAP_COUNT, S2_DEC_FACTOR> filter;
+
+      /**
+       * @brief Full rate samples since the last low rate sample.
+       */
+      unsigned phase = 0;
+
+    public:
+
+      /**
+       * @brief OutputHandler which receives every sample.
+       */
+      TFullRate FullRate;
+
+      /**
+       * @brief OutputHandler which receives the decimated samples.
+       */
+      TLowRate LowRate;
+
+      /**
+       * @brief Initialize the low rate decimation filter.
+       * 
+       * Must be called before the first call to @ref OutputSample().
+       * 
+       * @param coef  Low rate filter coefficients, `S2_TAP_COUNT` words.
+       * @param shr   Low rate filter output right-shift.
+       */
+      void Init(
+          const int32_t* coef,
+          const right_shift_t shr);
+
+      /**
+       * @brief Output a full rate sample, and a low rate sample once every
+       *        `S2_DEC_FACTOR` calls.
+       * 
+       * @param sample Full rate sample.
+       */
+      void OutputSample(int32_t sample[MIC_COUNT]);
+  };
+
+
+  /**
+   * @brief OutputHandler implementation which resamples the mic array's
+   *        output by a rational factor.
+   * 
+   * This class template can be used as an OutputHandler with the @ref MicArray
+   * class template. See @ref MicArray::OutputHandler.
+   * 
+   * The decimators only produce integer divisions of the PDM clock. This
+   * polyphase resampler converts their output by a further factor of
+   * `UP / DOWN`, without a separate sample rate converter thread. For
+   * example, with a 3.072 MHz PDM clock, a @ref TwoStageDecimator with
+   * `S2_DEC_FACTOR = 2` and this class with @ref resample_147_160_coef 
+   * deliver 44.1 kHz:
+   * 
+   * @code{.cpp}
+   * using TResampler = mic_array::ResamplingOutputHandler<MIC_COUNT, 
+   *     RESAMPLE_147_160_UP, RESAMPLE_147_160_DOWN, RESAMPLE_147_160_PHASE_TAPS,
+   *     mic_array::FrameOutputHandler<MIC_COUNT, 441, 
+   *                                   mic_array::ChannelFrameTransmitter>>;
+   * 
+   * mics.OutputHandler.Init(&resample_147_160_coef[0][0], resample_147_160_shr);
+   * mics.OutputHandler.Output.FrameTx.SetChannel(c_frames_out);
+   * @endcode
+   * 
+   * The filter is split into `UP` phases of `PHASE_TAPS` taps. Output `n` is
+   * due once the input sample at or before time `n * DOWN / UP` has arrived,
+   * and is computed from the latest `PHASE_TAPS` input samples of each 
+   * channel with phase `(n * DOWN) % UP`, all channels together by
+   * `fir_s32_multi()`. Each input sample therefore yields 
+   * `floor` or `ceil` of `UP / DOWN` samples to @ref Output, which at 
+   * 147/160 means that 13 of every 160 input samples yield none.
+   * 
+   * Any @ref MicArray::SampleFilter is applied before resampling.
+   * @ref MicArray::Latency() does not include the resampler's group delay,
+   * or the framing of @ref Output.
+   * 
+   * @tparam MIC_COUNT  Number of audio channels in each sample.
+   * @tparam UP         Interpolation factor.
+   * @tparam DOWN       Decimation factor.
+   * @tparam PHASE_TAPS Number of taps per phase, a multiple of 8.
+   * @tparam TOutput    OutputHandler type of the resampled stream.
+   */
+  template <unsigned MIC_COUNT, 
+            unsigned UP, 
+            unsigned DOWN,
+            unsigned PHASE_TAPS,
+            class TOutput>
+  class ResamplingOutputHandler
+  {
+    static_assert(UP >= 1 && DOWN >= 1, "UP and DOWN must be at least 1.");
+    static_assert(PHASE_TAPS >= 8 && (PHASE_TAPS % 8) == 0, 
+                  "PHASE_TAPS must be a non-zero multiple of 8.");
+
+    private:
+
+      /**
+       * @brief History of the input samples, and the filter evaluation.
+       */
+      Stage2Filter<MIC_COUNT, PHASE_TAPS, (DOWN + UP - 1) / UP> filter;
+
+      /**
+       * @brief Polyphase filter coefficients, `UP` rows of `PHASE_TAPS`.
+       */
+      const int32_t* coef = nullptr;
+
+      /**
+       * @brief Output right-shift.
+       */
+      right_shift_t shr = 0;
+
+      /**
+       * @brief Time of the next output after the newest input, in units of
+       *        `1 / UP` input sample periods.
+       */
+      unsigned next = 0;
+
+    public:
+
+      /**
+       * @brief OutputHandler which receives the resampled samples.
+       */
+      TOutput Output;
+
+      /**
+       * @brief Initialize the resampling filter.
+       * 
+       * Must be called before the first call to @ref OutputSample().
+       * 
+       * @param coef  Polyphase coefficients, `UP * PHASE_TAPS` words, phase
+       *              `p` at `coef[p * PHASE_TAPS]` with its tap `0` applied
+       *              to the newest sample. Must remain valid while the
+       *              resampler runs.
+       * @param shr   Output right-shift.
+       */
+      void Init(
+          const int32_t* coef,
+          const right_shift_t shr);
+
+      /**
+       * @brief Output the resampled samples due after `sample`.
+       * 
+       * @param sample Input sample.
+       */
+      void OutputSample(int32_t sample[MIC_COUNT]);
+  };
+
+
+  /**
+   * @brief OutputHandler implementation which combines the microphones into
+   *        a few fixed delay-and-sum beams before framing them.
+   * 
+   * This class template can be used as an OutputHandler with the @ref MicArray
+   * class template. See @ref MicArray::OutputHandler.
+   * 
+   * Each beam is the sum, over all microphones, of that microphone's sample
+   * stream delayed by a per-beam, per-microphone delay and scaled by a
+   * per-beam, per-microphone weight. Each (beam, microphone) pair has its own
+   * `TAP_COUNT`-tap FIR, with Q2.30 taps (`TAP_UNITY` is `1.0`), which holds
+   * both. Every beam is then a single dot product of its taps with the last
+   * `TAP_COUNT` samples of every microphone, evaluated by `fir_s32_multi()`
+   * on the VPU, 8 multiply-accumulates per instruction.
+   * 
+   * The `BEAMS`-channel samples this produces are gathered into frames of
+   * `SAMPLE_COUNT` samples exactly as by the @ref FrameOutputHandler this
+   * class derives from, and sent with its @ref FrameOutputHandler::FrameTx.
+   * Compared with framing all `MIC_COUNT` channels and beamforming on another
+   * thread, the frame buffer and the data sent per frame shrink by a factor
+   * of `MIC_COUNT / BEAMS`.
+   * 
+   * `SetSteering()` designs a (beam, microphone) FIR from a weight and a
+   * delay of `0` to `TAP_COUNT-1` samples: a whole number of samples is a
+   * single tap, and a fractional delay a 4-point Lagrange interpolator
+   * (fewer points if `TAP_COUNT < 4`) around it. As only relative delays
+   * matter to a beam, the smallest delay of each beam can usually be `0`.
+   * `SetTaps()` sets a FIR directly.
+   * 
+   * `Init()` clears the history and steers every beam to broadside, i.e. the
+   * mean of all microphones with no delay.
+   * 
+   * Beam sums are accumulated in 40 bits and saturated to 32 bits, so the
+   * weights of a beam should sum to no more than `1.0` in magnitude.
+   * 
+   * @tparam MIC_COUNT        Number of microphone channels.
+   * @tparam BEAMS            Number of beams.
+   * @tparam SAMPLE_COUNT     Number of samples per frame.
+   * @tparam FrameTransmitter See @ref FrameOutputHandler. It is instantiated
+   *                          with `BEAMS` channels.
+   * @tparam TAP_COUNT        Number of FIR taps per (beam, microphone) pair;
+   *                          one more than the longest delay.
+   */
+  template <unsigned MIC_COUNT, 
+            unsigned BEAMS,
+            unsigned SAMPLE_COUNT, 
+            template <unsigned, unsigned> class FrameTransmitter,
+            unsigned TAP_COUNT = 8>
+  class BeamformOutputHandler 
+      : public FrameOutputHandler<BEAMS, SAMPLE_COUNT, FrameTransmitter>
+  {
+    static_assert(BEAMS >= 1, "BEAMS must be at least 1.");
+    static_assert(TAP_COUNT >= 1, "TAP_COUNT must be at least 1.");
+
+    public:
+      /**
+       * @brief Tap value of `1.0`, in Q2.30.
+       */
+      static constexpr int32_t TAP_UNITY = 0x40000000;
+
+    protected:
+      /**
+       * @brief Number of history words each beam is computed from.
+       */
+      static constexpr unsigned WINDOW = TAP_COUNT * MIC_COUNT;
+
+      /**
+       * @brief Number of 8-word blocks `fir_s32_multi()` computes each beam
+       *        from.
+       */
+      static constexpr unsigned WINDOW_BLOCKS = (WINDOW + 7) / 8;
+
+      /**
+       * @brief FIR taps of each beam, in `[TAP][MIC]` order, zero padded to
+       *        `8 * WINDOW_BLOCKS` words.
+       */
+      int32_t coef[BEAMS][8 * WINDOW_BLOCKS];
+
+      /**
+       * @brief History of input samples, in `[SAMPLE][MIC]` order.
+       * 
+       * Each sample is stored twice, `TAP_COUNT` rows apart, so that the 
+       * `TAP_COUNT` most recent samples are always contiguous, newest first,
+       * from row `position`. The words after the last row are padding, read
+       * (against zero taps) by the last 8-word block of the window.
+       */
+      int32_t history[WINDOW + 8 * WINDOW_BLOCKS];
+
+      /**
+       * @brief Row of `history` holding the newest sample.
+       */
+      unsigned position;
+
+    public:
+
+      /**
+       * @brief Clear the history, and steer every beam to broadside.
+       * 
+       * Must be called before the first call to @ref OutputSample().
+       */
+      void Init();
+
+      /**
+       * @brief Set the FIR taps of one microphone in one beam.
+       * 
+       * @param beam  Beam index.
+       * @param mic   Microphone index.
+       * @param taps  `TAP_COUNT` taps, in Q2.30, `taps[0]` applied to the
+       *              newest sample.
+       */
+      void SetTaps(unsigned beam, unsigned mic, const int32_t taps[TAP_COUNT]);
+
+      /**
+       * @brief Set the weight and delay of one microphone in one beam.
+       * 
+       * Taps which do not fit in Q2.30 are saturated.
+       * 
+       * @param beam    Beam index.
+       * @param mic     Microphone index.
+       * @param weight  Linear weight, e.g. `1.0f / MIC_COUNT`.
+       * @param delay   Delay in samples, from `0` to `TAP_COUNT-1`.
+       */
+      void SetSteering(unsigned beam, unsigned mic, float weight, float delay);
+
+      /**
+       * @brief Beamform a sample, and output the beams.
+       * 
+       * @param sample `MIC_COUNT`-channel sample.
+       */
+      void OutputSample(int32_t sample[MIC_COUNT]);
+
+      /**
+       * @brief Beamform and output a block of samples.
+       * 
+       * Equivalent to calling `OutputSample()` on each of `samples[0]`
+       * through `samples[SAMPLES-1]`, in that order.
+       * 
+       * @param samples `MIC_COUNT`-channel samples.
+       */
+      template <unsigned SAMPLES>
+      void OutputSamples(int32_t (&samples)[SAMPLES][MIC_COUNT]);
+  };
+
+
+  /**
+   * @brief OutputHandler implementation which streams each sample over a
+   *        channel as it is computed.
+   * 
+   * This class template can be used as an OutputHandler with the @ref MicArray
+   * class template. See @ref MicArray::OutputHandler.
+   * 
+   * Like a @ref FrameOutputHandler with a @ref ChannelFrameTransmitter, this
+   * delivers frames of `SAMPLE_COUNT` samples, each as a single channel 
+   * transaction, but it holds no frame buffer: the transaction is opened
+   * when the first sample of a frame is output, each sample's `MIC_COUNT`
+   * words are sent as soon as @ref OutputSample() is given them, and the
+   * transaction is closed after the frame's last sample. This saves the 
+   * `MIC_COUNT * SAMPLE_COUNT` word frame buffer of @ref FrameOutputHandler.
+   * 
+   * Samples are sent in `[SAMPLE_COUNT][MIC_COUNT]` order, so the frame
+   * should be received on another thread with `ma_frame_rx()` into a 
+   * sample-major buffer, i.e. `int32_t frame[SAMPLE_COUNT][MIC_COUNT]`.
+   * 
+   * The receiver must remain in `ma_frame_rx()` for the whole frame period:
+   * the channel only buffers a couple of words, so if the receiver is not
+   * ready for a sample, @ref OutputSample() blocks the decimation thread
+   * until it is. Any processing of a frame by the receiver must therefore
+   * fit between the frame's last sample and the next frame's first. Across
+   * tiles, the open transaction also holds its route through the switch
+   * for the whole frame.
+   * 
+   * @tparam MIC_COUNT    Number of audio channels in each sample.
+   * @tparam SAMPLE_COUNT Number of samples per frame.
+   */
+  template <unsigned MIC_COUNT, unsigned SAMPLE_COUNT>
+  class ChannelSampleOutputHandler
+  {
+    private:
+
+      /**
+       * @brief Channel over which frames are transmitted.
+       */
+      chanend_t c_frame_out;
+
+      /**
+       * @brief Transaction of the frame currently being sent.
+       * 
+       * Only valid while `current_sample` is non-zero.
+       */
+      transacting_chanend_t ct_frame;
+
+      /**
+       * @brief Index of the next sample within the current frame.
+       */
+      unsigned current_sample = 0;
+
+    public:
+
+      /**
+       * @brief Number of samples in each frame.
+       * 
+       * See @ref OutputHandlerFrameSize.
+       */
+      static constexpr unsigned FrameSize = SAMPLE_COUNT;
+
+      /**
+       * @brief Construct a `ChannelSampleOutputHandler`.
+       * 
+       * If this constructor is used, @ref SetChannel() must be called to
+       * configure the channel over which frames are transmitted prior to any
+       * calls to @ref OutputSample(). 
+       */
+      ChannelSampleOutputHandler() : c_frame_out(0) { }
+
+      /**
+       * @brief Construct a `ChannelSampleOutputHandler`.
+       * 
+       * The supplied value of `c_frame_out` must be a valid chanend.
+       * 
+       * @param c_frame_out Chanend over which frames will be transmitted.
+       */
+      ChannelSampleOutputHandler(chanend_t c_frame_out) 
+          : c_frame_out(c_frame_out) { }
+
+      /**
+       * @brief Set channel used for frame transfers.
+       * 
+       * Must not be called part way through a frame.
+       * 
+       * @param c_frame_out Chanend over which frames will be transmitted.
+       */
+      void SetChannel(chanend_t c_frame_out);
+
+      /**
+       * @brief Get the chanend used for frame transfers.
+       * 
+       * @returns Channel to be used for frame transfers.
+       */
+      chanend_t GetChannel();
+
+      /**
+       * @brief Send a sample, opening or closing the frame's transaction as
+       *        required.
+       * 
+       * @param sample Sample to be sent.
+       */
+      void OutputSample(int32_t sample[MIC_COUNT]);
+
+      /**
+       * @brief Send a block of samples.
+       * 
+       * Equivalent to calling `OutputSample()` on each of `samples[0]`
+       * through `samples[SAMPLES-1]`, in that order.
+       * 
+       * @param samples Samples to be sent.
+       */
+      template <unsigned SAMPLES>
+      void OutputSamples(int32_t (&samples)[SAMPLES][MIC_COUNT]);
+
+      /**
+       * @brief Send an already complete frame.
+       * 
+       * `frame` (in `[MIC][SAMPLE]` order, as written by 
+       * @ref TwoStageDecimator::ProcessFrame()) is sent as a transaction in
+       * the same sample-major order as frames built by @ref OutputSample().
+       * 
+       * This must not be mixed with a partially sent frame; i.e. the number
+       * of samples previously supplied through @ref OutputSample() and 
+       * @ref OutputSamples() must be a multiple of `SAMPLE_COUNT`.
+       * 
+       * @param frame Frame to be transmitted.
+       */
+      void OutputFrame(int32_t frame[MIC_COUNT][SAMPLE_COUNT]);
+  };
+
+
+  /**
+   * @brief Output handler which sends each sample straight out of a TDM 
+   *        port, through an ISR on the same tile.
+   * 
+   * For applications which only pass the mic array's output on to a TDM
+   * (or I2S) codec. @ref OutputSample() stores each sample in a slot buffer
+   * from which a port-driven ISR (see @ref tdm_tx_context_t) outputs one
+   * slot word each time the port is ready for it. There is no I2S thread,
+   * no channel, and no intermediate frame or ring buffer to copy through.
+   * 
+   * The slot buffer holds `2 * FRAMES` TDM frames of `SLOTS` slots, the
+   * first `MIC_COUNT` of which carry the microphones and the rest `0`. 
+   * It is used as two halves: while the ISR outputs one, the mic array 
+   * fills the other. The first sample is written `FRAMES` frames ahead of
+   * the frame the ISR is outputting, so the TDM output lags by `FRAMES`
+   * samples. The TDM clock and the mic array's output rate must come from
+   * the same master clock. If they drift apart by more than `FRAMES / 2`
+   * samples anyway, the write position is put back `FRAMES` frames ahead of
+   * the ISR, which glitches the output, and counted (see @ref Slips()). As
+   * the decimator outputs samples in bursts, `FRAMES` should be at least 
+   * twice its @ref DecimatorSamplesPerBlock.
+   * 
+   * The data port, and the frame sync port if there is one, must be 1-bit
+   * buffered output ports with a transfer width of 32 bits, clocked by the
+   * TDM bit clock from the same clock block. Each word of the data port 
+   * carries one slot, MSB first, and the first bit of a frame's first slot
+   * goes out with the first bit of the frame sync, i.e. with no bit delay. 
+   * By default the frame sync is a one bit pulse at the start of each 
+   * frame; @ref SetFrameSync() sets other patterns, e.g. a 50% duty cycle
+   * word clock for left-justified I2S.
+   * 
+   * Only one `TdmOutputHandler` may be in use on a tile, as the ISR's 
+   * context is global. Allocation and initialization are as follows:
+   * 
+   * @code{.cpp}
+   *  mics.OutputHandler.SetPorts(p_tdm_dout, p_tdm_fsync);
+   *  // On the thread which is to run the ISR (e.g. the decimation thread):
+   *  mics.OutputHandler.InstallISR();
+   *  mics.OutputHandler.UnmaskISR();
+   *  // Then start the bit clock's clock block.
+   * @endcode
+   * 
+   * @tparam MIC_COUNT  Number of audio channels in each sample.
+   * @tparam SLOTS      Number of slots in each TDM frame, e.g. `8` for TDM8 
+   *                    or `2` for I2S.
+   * @tparam FRAMES     Number of TDM frames in each half of the slot buffer.
+   */
+  template <unsigned MIC_COUNT, unsigned SLOTS = MIC_COUNT, 
+            unsigned FRAMES = 16>
+  class TdmOutputHandler
+  {
+    static_assert(SLOTS >= MIC_COUNT, "SLOTS must be at least MIC_COUNT.");
+    static_assert(FRAMES >= 2, "FRAMES must be at least 2.");
+
+    private:
+
+      /**
+       * @brief Number of TDM frames in the slot buffer.
+       */
+      static constexpr unsigned BUFFER_FRAMES = 2 * FRAMES;
+
+      /**
+       * @brief The slot buffer, with each sample bit-reversed for output.
+       */
+      uint32_t buffer[BUFFER_FRAMES][SLOTS] = {{0}};
+
+      /**
+       * @brief Frame sync word of each slot.
+       */
+      uint32_t fsync[SLOTS] = {1};
+
+      /**
+       * @brief Port the TDM slots are output on.
+       */
+      port_t p_tdm_out = 0;
+
+      /**
+       * @brief Port the frame sync is output on, or `0` for none.
+       */
+      port_t p_fsync = 0;
+
+      /**
+       * @brief Frame of the slot buffer the next sample is written to.
+       */
+      unsigned write_frame = 0;
+
+      /**
+       * @brief Whether a sample has been written since the ISR was attached.
+       */
+      bool started = false;
+
+      /**
+       * @brief Number of times the write position was put back.
+       */
+      volatile unsigned slips = 0;
+
+    public:
+
+      /**
+       * @brief Set the TDM data and frame sync ports.
+       * 
+       * @param p_tdm_out Port the TDM slots are output on.
+       * @param p_fsync   Port the frame sync is output on, or `0` for none.
+       */
+      void SetPorts(
+          port_t p_tdm_out,
+          port_t p_fsync = 0);
+
+      /**
+       * @brief Set the frame sync pattern.
+       * 
+       * `pattern[k]` is output on the frame sync port with slot `k`. Bits
+       * leave the port LSB first. The default, a one bit pulse at the start
+       * of the frame, is `{1, 0, ...}`; a left-justified I2S word clock 
+       * with `SLOTS` of `2` is `{0, 0xFFFFFFFF}`.
+       * 
+       * Must be called before @ref AttachISR().
+       * 
+       * @param pattern Frame sync word of each slot.
+       */
+      void SetFrameSync(
+          const uint32_t pattern[SLOTS]);
+
+      /**
+       * @brief Point the TDM tx ISR's context at this handler.
+       * 
+       * Called by @ref InstallISR(). Output restarts from the beginning of
+       * the (silent) slot buffer.
+       */
+      void AttachISR();
+
+      /**
+       * @brief Attach the TDM tx ISR and install it on the current thread.
+       * 
+       * @note This does not unmask interrupts.
+       */
+      void InstallISR();
+
+      /**
+       * @brief Unmask interrupts on the current core.
+       */
+      void UnmaskISR();
+
+      /**
+       * @brief Store a sample for output.
+       * 
+       * See @ref TdmOutputHandler.
+       * 
+       * @param sample Sample to be output.
+       */
+      void OutputSample(int32_t sample[MIC_COUNT]);
+
+      /**
+       * @brief Store a block of samples for output.
+       * 
+       * Equivalent to calling `OutputSample()` on each of `samples[0]`
+       * through `samples[SAMPLES-1]`, in that order.
+       * 
+       * @param samples Samples to be output.
+       */
+      template <unsigned SAMPLES>
+      void OutputSamples(int32_t (&samples)[SAMPLES][MIC_COUNT]);
+
+      /**
+       * @brief Number of times the mic array and the TDM output drifted too
+       *        far apart, and the write position was put back.
+       */
+      unsigned Slips() const;
+  };
+
+
+  /**
+   * @brief Frame transmitter which transmits frame over a channel.
+   * 
+   * This class template is meant for use as the `FrameTransmitter` template
+   * parameter of @ref FrameOutputHandler.
+   * 
+   * When using this frame transmitter, frames are transmitted over a channel
+   * using the frame transfer API in `mic_array/frame_transfer.h`.
+   * \verbatim embed:rst
+     Usually, a call to :c:func:`ma_frame_rx()` (with the other end of 
+     `c_frame_out` as argument) should be used to receive the frame on 
+     another thread. \endverbatim
+   * 
+   * If the receiving thread is not waiting to receive the frame when @ref
+   * OutputFrame() is called, that method will block until the frame has been
+   * transmitted. In order to ensure there are no violations of the mic array's
+   * real-time constraints, the receiver should be ready to receive a frame as
+   * soon as it becomes available.
+   * 
+   * @note While @ref OutputFrame() is blocking, it will not prevent the PDM rx
+   * interrupt from firing.
+   * 
+   * Frames can be transmitted between tiles using this class.
+   * 
+   * @tparam MIC_COUNT    Number of audio channels in each frame.
+   * @tparam SAMPLE_COUNT Number of samples per frame.
+   */
+  template <unsigned MIC_COUNT, unsigned SAMPLE_COUNT>
+  class ChannelFrameTransmitter
+  {
+    private:
+
+      /**
+       * @brief Channel over which frames are transmitted.
+       * 
+       * If the default constructor is used, @ref SetChannel() must be called to
+       * configure the channel over which frames are transmitted prior to any
+       * calls to @ref OutputFrame(). 
+       */
+      chanend_t c_frame_out;
+
+    public:
+
+      /**
+       * @brief Construct a `ChannelFrameTransmitter`.
+       * 
+       * If this constructor is used, @ref SetChannel() must be called to
+       * configure the channel over which frames are transmitted prior to any
+       * calls to @ref OutputFrame(). 
+       */
+      ChannelFrameTransmitter() : c_frame_out(0) { }
+
+      /**
+       * @brief Construct a `ChannelFrameTransmitter`.
+       * 
+       * The supplied value of `c_frame_out` must be a valid chanend.
+       * 
+       * @param c_frame_out Chanend over which frames will be transmitted.
+       */
+      ChannelFrameTransmitter(chanend_t c_frame_out) : c_frame_out(c_frame_out) { }
+
+      /**
+       * @brief Set channel used for frame transfers.
+       * 
+       * The supplied value of `c_frame_out` must be a valid chanend.
+       * 
+       * @param c_frame_out Chanend over which frames will be transmitted.
+       */
+      void SetChannel(chanend_t c_frame_out);
+
+      /**
+       * @brief Get the chanend used for frame transfers.
+       * 
+       * @returns Channel to be used for frame transfers.
+       */
+      chanend_t GetChannel();
+
+      /**
+       * @brief Transmit the specified frame.
+       * 
+       * See @ref ChannelFrameTransmitter for additional details.
+       * 
+       * @param frame Frame to be transmitted.
+       */
+      void OutputFrame(int32_t frame[MIC_COUNT][SAMPLE_COUNT]);
+
+      /**
+       * @brief Transmit the specified 16-bit frame.
+       * 
+       * Used by a @ref FrameOutputHandler whose `FRAME_FORMAT` is 
+       * @ref FrameFormatS16. The frame is sent with `ma_frame_tx_s16()`, and
+       * should be received with `ma_frame_rx_s16()`.
+       * 
+       * @param frame Word-aligned frame of `MIC_COUNT * SAMPLE_COUNT` samples.
+       */
+      void OutputFrame(const int16_t frame[]);
+
+      /**
+       * @brief Transmit the specified packed 24-bit frame.
+       * 
+       * Used by a @ref FrameOutputHandler whose `FRAME_FORMAT` is 
+       * @ref FrameFormatS24. The frame is sent with `ma_frame_tx_s24()`, and
+       * should be received with `ma_frame_rx_s24()`.
+       * 
+       * @param frame Word-aligned frame of `MIC_COUNT * SAMPLE_COUNT` samples.
+       */
+      void OutputFrame(const uint8_t frame[]);
+
+      /**
+       * @brief Transmit the specified `float` frame.
+       * 
+       * Used by a @ref FrameOutputHandler whose `FRAME_FORMAT` is 
+       * @ref FrameFormatF32. The frame is sent with `ma_frame_tx_f32()`, and
+       * should be received with `ma_frame_rx_f32()`.
+       * 
+       * @param frame Frame of `MIC_COUNT * SAMPLE_COUNT` samples.
+       */
+      void OutputFrame(const float frame[]);
+  };
+
+
+  /**
+   * @brief Frame transmitter which transmits each frame with its header over
+   *        a channel.
+   *
+   * This class template is meant for use as the `FrameTransmitter` template
+   * parameter of @ref FrameOutputHandler, with its default `FRAME_FORMAT` of
+   * @ref FrameFormatS32.
+   *
+   * As @ref ChannelFrameTransmitter, except that each frame is preceded by
+   * its `ma_frame_header_t`, giving the index of its first sample in the
+   * output stream and the reference time at which the PDM data behind that
+   * sample was captured (see @ref FrameOutputHandler::SetBlockStamp()). A
+   * receiver can use this to notice frames lost to an overrun and resync,
+   * e.g. to I2S playback, without restarting the mic array.
+   * \verbatim embed:rst
+     Frames must be received with :c:func:`ma_frame_rx_stamped()` (with the
+     other end of `c_frame_out` as argument). \endverbatim
+   *
+   * The header adds two words to each channel transaction.
+   *
+   * @tparam MIC_COUNT    Number of audio channels in each frame.
+   * @tparam SAMPLE_COUNT Number of samples per frame.
+   */
+  template <unsigned MIC_COUNT, unsigned SAMPLE_COUNT>
+  class StampedChannelFrameTransmitter
+  {
+    private:
+
+      /**
+       * @brief Channel over which frames are transmitted.
+       */
+      chanend_t c_frame_out;
+
+    public:
+
+      /**
+       * @brief Construct a `StampedChannelFrameTransmitter`.
+       *
+       * If this constructor is used, @ref SetChannel() must be called to
+       * configure the channel over which frames are transmitted prior to any
+       * calls to @ref OutputFrame().
+       */
+      StampedChannelFrameTransmitter() : c_frame_out(0) { }
+
+      /**
+       * @brief Construct a `StampedChannelFrameTransmitter`.
+       *
+       * The supplied value of `c_frame_out` must be a valid chanend.
+       *
+       * @param c_frame_out Chanend over which frames will be transmitted.
+       */
+      StampedChannelFrameTransmitter(chanend_t c_frame_out)
+          : c_frame_out(c_frame_out) { }
+
+      /**
+       * @brief Set channel used for frame transfers.
+       *
+       * @param c_frame_out Chanend over which frames will be transmitted.
+       */
+      void SetChannel(chanend_t c_frame_out);
+
+      /**
+       * @brief Get the chanend used for frame transfers.
+       *
+       * @returns Channel to be used for frame transfers.
+       */
+      chanend_t GetChannel();
+
+      /**
+       * @brief Transmit the specified frame, preceded by its header.
+       *
+       * @param header  Header of the frame.
+       * @param frame   Frame to be transmitted.
+       */
+      void OutputFrame(const ma_frame_header_t& header,
+                       int32_t frame[MIC_COUNT][SAMPLE_COUNT]);
+  };
+
+
+  /**
+   * @brief Frame transmitter which hands frames to a consumer on the same tile
+   *        by pointer.
+   * 
+   * This class template is meant for use as the `FrameTransmitter` template
+   * parameter of @ref FrameOutputHandler, with a `FRAME_COUNT` of at least
+   * `2` (see @ref MinFrameCount).
+   * 
+   * Rather than copying each frame word by word through a channel, as
+   * @ref ChannelFrameTransmitter does, @ref OutputFrame() sends only a pointer
+   * to the frame, which is one of the @ref FrameOutputHandler's own frame
+   * buffers, over a streaming channel. The consumer reads the frame in place
+   * and then returns a release token. The mic array thread only waits for
+   * that token, and only when it next outputs a frame, by which time it has
+   * filled another frame buffer. Its cost per frame is therefore independent
+   * of the frame size.
+   * \verbatim embed:rst
+     The consumer receives each frame with :c:func:`ma_frame_rx_ptr()` (with
+     the other end of `c_frame_out` as argument) and, once done with it, calls
+     :c:func:`ma_frame_release()`. \endverbatim
+   * 
+   * The consumer may hold a frame until the next frame is complete. If it has
+   * not released a frame by then, @ref OutputFrame() blocks until it does.
+   * 
+   * Because the frame is shared, producer and consumer must be on the same
+   * tile.
+   * 
+   * @tparam MIC_COUNT    Number of audio channels in each frame.
+   * @tparam SAMPLE_COUNT Number of samples per frame.
+   */
+  template <unsigned MIC_COUNT, unsigned SAMPLE_COUNT>
+  class SharedMemoryFrameTransmitter
+  {
+    public:
+
+      /**
+       * @brief Fewest frame buffers the @ref FrameOutputHandler must have.
+       * 
+       * With one, the next frame would be written over the frame the 
+       * consumer is reading. See @ref FrameTransmitterMinFrames.
+       */
+      static constexpr unsigned MinFrameCount = 2;
+
+    private:
+
+      /**
+       * @brief Streaming chanend over which frame pointers are sent and
+       *        release tokens received.
+       */
+      chanend_t c_frame_out;
+
+      /**
+       * @brief Whether a frame has been sent and not yet released.
+       */
+      bool outstanding = false;
+
+    public:
+
+      /**
+       * @brief Construct a `SharedMemoryFrameTransmitter`.
+       * 
+       * If this constructor is used, @ref SetChannel() must be called to
+       * configure the channel over which frames are transmitted prior to any
+       * calls to @ref OutputFrame(). 
+       */
+      SharedMemoryFrameTransmitter() : c_frame_out(0) { }
+
+      /**
+       * @brief Construct a `SharedMemoryFrameTransmitter`.
+       * 
+       * `c_frame_out` must be one end of a streaming channel (see 
+       * `s_chan_alloc()`), the consumer having the other.
+       * 
+       * @param c_frame_out Chanend over which frames will be transmitted.
+       */
+      SharedMemoryFrameTransmitter(chanend_t c_frame_out) 
+          : c_frame_out(c_frame_out) { }
+
+      /**
+       * @brief Set channel used for frame transfers.
+       * 
+       * `c_frame_out` must be one end of a streaming channel, the consumer
+       * having the other.
+       * 
+       * @param c_frame_out Chanend over which frames will be transmitted.
+       */
+      void SetChannel(chanend_t c_frame_out);
+
+      /**
+       * @brief Get the chanend used for frame transfers.
+       * 
+       * @returns Channel to be used for frame transfers.
+       */
+      chanend_t GetChannel();
+
+      /**
+       * @brief Transmit the specified frame.
+       * 
+       * Waits for the consumer to release the previous frame, if it has not
+       * already, and then sends it a pointer to `frame`. `frame` must not be
+       * modified until the consumer has released it, which is guaranteed if
+       * it is one of the buffers of a @ref FrameOutputHandler with a
+       * `FRAME_COUNT` of at least `2`.
+       * 
+       * @param frame Frame to be transmitted.
+       */
+      void OutputFrame(int32_t frame[MIC_COUNT][SAMPLE_COUNT]);
+
+      /**
+       * @brief Wait for the consumer to release the last frame sent.
+       * 
+       * Returns immediately if there is no such frame. This allows the
+       * streaming channel to be freed, or the frame buffers reused, once the
+       * mic array is stopped.
+       */
+      void Drain();
+  };
+
+
+  /**
+   * @brief Frame transmitter which hands each frame, by pointer, to several
+   *        consumers on the same tile.
+   * 
+   * This class template is meant for use as the `FrameTransmitter` template
+   * parameter of @ref FrameOutputHandler, through 
+   * @ref FanOutFrameTransmitterOf, with a `FRAME_COUNT` of at least 
+   * `DEPTH + 1`.
+   * 
+   * This is @ref SharedMemoryFrameTransmitter for up to `CONSUMERS` 
+   * consumers, each registered with @ref AddConsumer() and each with its own
+   * streaming channel. @ref OutputFrame() sends the same pointer, to one of
+   * the @ref FrameOutputHandler's own frame buffers, to every consumer, so
+   * however many consumers there are no frame is copied, and no relay thread
+   * is needed.
+   * \verbatim embed:rst
+     Each consumer receives frames with :c:func:`ma_frame_rx_ptr()` (with the
+     other end of its channel as argument) and, once done with each, calls
+     :c:func:`ma_frame_release()`. \endverbatim
+   * 
+   * A frame buffer is only handed back to the @ref FrameOutputHandler once 
+   * every consumer has released it. Up to `DEPTH` frames may be outstanding,
+   * i.e. sent and not yet released by every consumer. If sending another
+   * frame would exceed that, @ref OutputFrame() first blocks until the oldest
+   * outstanding frame is released by each consumer which still holds it. A
+   * consumer may therefore hold a frame until `DEPTH` more frames are 
+   * complete, and must release frames in the order it receives them.
+   * 
+   * Because the frames are shared, producer and consumers must be on the 
+   * same tile. Consumers must be registered before the mic array starts.
+   * 
+   * @tparam MIC_COUNT    Number of audio channels in each frame.
+   * @tparam SAMPLE_COUNT Number of samples per frame.
+   * @tparam CONSUMERS    Maximum number of consumers.
+   * @tparam DEPTH        Maximum number of outstanding frames.
+   */
+  template <unsigned MIC_COUNT, unsigned SAMPLE_COUNT, 
+            unsigned CONSUMERS, unsigned DEPTH = 1>
+  class FanOutFrameTransmitter
+  {
+    static_assert(CONSUMERS >= 1, "CONSUMERS must be at least 1.");
+    static_assert(DEPTH >= 1, "DEPTH must be at least 1.");
+
+    public:
+
+      /**
+       * @brief Fewest frame buffers the @ref FrameOutputHandler must have.
+       * 
+       * One for each of the `DEPTH` outstanding frames, and one to fill.
+       * See @ref FrameTransmitterMinFrames.
+       */
+      static constexpr unsigned MinFrameCount = DEPTH + 1;
+
+    private:
+
+      /**
+       * @brief Streaming chanends over which frame pointers are sent to, and
+       *        release tokens received from, each consumer.
+       */
+      chanend_t c_frame_out[CONSUMERS];
+
+      /**
+       * @brief Number of consumers registered.
+       */
+      unsigned consumers = 0;
+
+      /**
+       * @brief Number of frames sent which not every consumer has released.
+       */
+      unsigned outstanding = 0;
+
+      /**
+       * @brief Wait for every consumer to release the oldest outstanding 
+       *        frame.
+       */
+      void Retire();
+
+    public:
+
+      /**
+       * @brief Register a consumer.
+       * 
+       * `c_frame_out` must be one end of a streaming channel (see 
+       * `s_chan_alloc()`), the consumer having the other. Must not be called
+       * while the mic array is running.
+       * 
+       * @param c_frame_out Chanend over which frames will be transmitted to
+       *                    the consumer.
+       * 
+       * @returns `false` if `CONSUMERS` consumers are already registered, 
+       *          otherwise `true`.
+       */
+      bool AddConsumer(chanend_t c_frame_out);
+
+      /**
+       * @brief Get the number of consumers registered.
+       */
+      unsigned Consumers() const;
+
+      /**
+       * @brief Get the chanend used for frame transfers to a consumer.
+       * 
+       * @param consumer  Index of the consumer, in order of registration.
+       * 
+       * @returns Channel to be used for frame transfers to the consumer.
+       */
+      chanend_t GetChannel(unsigned consumer) const;
+
+      /**
+       * @brief Transmit the specified frame to every consumer.
+       * 
+       * If `DEPTH` frames are outstanding, first waits for every consumer to
+       * release the oldest of them. `frame` must not be modified until every
+       * consumer has released it, which is guaranteed if it is one of the
+       * buffers of a @ref FrameOutputHandler with a `FRAME_COUNT` of at least
+       * `DEPTH + 1`. If no consumer is registered the frame is discarded.
+       * 
+       * @param frame Frame to be transmitted.
+       */
+      void OutputFrame(int32_t frame[MIC_COUNT][SAMPLE_COUNT]);
+
+      /**
+       * @brief Wait for every consumer to release every frame sent.
+       * 
+       * Returns immediately if there is no such frame. This allows the
+       * streaming channels to be freed, or the frame buffers reused, once the
+       * mic array is stopped.
+       */
+      void Drain();
+  };
+
+
+  /**
+   * @brief Adapts @ref FanOutFrameTransmitter to a class template of the mic
+   *        and sample counts only, for use with @ref FrameOutputHandler.
+   * 
+   * For example, for three consumers which may each hold up to two frames:
+   * 
+   * @code{.cpp}
+   * mic_array::FrameOutputHandler<8, 32, 
+   *     mic_array::FanOutFrameTransmitterOf<3, 2>::Type, 3> output_handler;
+   * @endcode
+   */
+  template <unsigned CONSUMERS, unsigned DEPTH = 1>
+  struct FanOutFrameTransmitterOf
+  {
+    /**
+     * @ref FanOutFrameTransmitter for up to `CONSUMERS` consumers of frames
+     * with `MIC_COUNT` channels and `SAMPLE_COUNT` samples.
+     */
+    template <unsigned MIC_COUNT, unsigned SAMPLE_COUNT>
+    using Type = FanOutFrameTransmitter<MIC_COUNT, SAMPLE_COUNT, 
+                                        CONSUMERS, DEPTH>;
+  };
+
+
+  /**
+   * @brief Frame transmitter which streams frames over a streaming channel,
+   *        with credit-based flow control.
+   * 
+   * This class template is meant for use as the `FrameTransmitter` template
+   * parameter of @ref FrameOutputHandler.
+   * 
+   * Like @ref ChannelFrameTransmitter, frames are sent by value and may cross
+   * tiles. But where @ref ChannelFrameTransmitter opens and closes a route
+   * for every frame, with a handshake each time, this transmitter's streaming
+   * channel keeps its route open, and each frame goes out as one burst of
+   * words. This makes small, low latency frames much cheaper to send between
+   * tiles.
+   * \verbatim embed:rst
+     The receiver calls :c:func:`ma_frame_stream_rx_init()` once (with the
+     other end of `c_frame_out` as argument), granting a number of credits,
+     and then receives each frame with :c:func:`ma_frame_stream_rx()`. 
+     \endverbatim
+   * 
+   * @ref OutputFrame() uses up one credit per frame, and the receiver returns
+   * one after each frame it takes. If no credits are left, because the 
+   * receiver has fallen that many frames behind, @ref OutputFrame() blocks 
+   * until one is returned.
+   * 
+   * @note While @ref OutputFrame() is blocking, it will not prevent the PDM rx
+   * interrupt from firing.
+   * 
+   * @tparam MIC_COUNT    Number of audio channels in each frame.
+   * @tparam SAMPLE_COUNT Number of samples per frame.
+   */
+  template <unsigned MIC_COUNT, unsigned SAMPLE_COUNT>
+  class StreamingFrameTransmitter
+  {
+    private:
+
+      /**
+       * @brief Streaming chanend over which frames are sent and credits
+       *        received.
+       */
+      chanend_t c_frame_out;
+
+    public:
+
+      /**
+       * @brief Construct a `StreamingFrameTransmitter`.
+       * 
+       * If this constructor is used, @ref SetChannel() must be called to
+       * configure the channel over which frames are transmitted prior to any
+       * calls to @ref OutputFrame(). 
+       */
+      StreamingFrameTransmitter() : c_frame_out(0) { }
+
+      /**
+       * @brief Construct a `StreamingFrameTransmitter`.
+       * 
+       * `c_frame_out` must be one end of a streaming channel (see 
+       * `s_chan_alloc()`), the receiver having the other.
+       * 
+       * @param c_frame_out Chanend over which frames will be transmitted.
+       */
+      StreamingFrameTransmitter(chanend_t c_frame_out) 
+          : c_frame_out(c_frame_out) { }
+
+      /**
+       * @brief Set channel used for frame transfers.
+       * 
+       * `c_frame_out` must be one end of a streaming channel, the receiver
+       * having the other.
+       * 
+       * @param c_frame_out Chanend over which frames will be transmitted.
+       */
+      void SetChannel(chanend_t c_frame_out);
+
+      /**
+       * @brief Get the chanend used for frame transfers.
+       * 
+       * @returns Channel to be used for frame transfers.
+       */
+      chanend_t GetChannel();
+
+      /**
+       * @brief Transmit the specified frame.
+       * 
+       * See @ref StreamingFrameTransmitter for additional details.
+       * 
+       * @param frame Frame to be transmitted.
+       */
+      void OutputFrame(int32_t frame[MIC_COUNT][SAMPLE_COUNT]);
+
+      /**
+       * @brief Wait for the receiver to take every frame sent.
+       * 
+       * `credits` must be the number of credits the receiver granted. Once
+       * this returns the channel holds no data, and may be freed.
+       * 
+       * @param credits Number of credits granted by the receiver.
+       */
+      void Drain(unsigned credits);
+  };
+
+
+  /**
+   * @brief Frame transmitter which never blocks, queueing up to `FRAME_COUNT`
+   *        frames for a consumer on the same tile.
+   * 
+   * This class template is meant for use as the `FrameTransmitter` template
+   * parameter of @ref FrameOutputHandler, through @ref QueuedFrameTransmitterOf
+   * (usually with the handler's default `FRAME_COUNT` of `1`).
+   * 
+   * @ref OutputFrame() copies the frame into a queue of `FRAME_COUNT` frames
+   * and returns at once. If the consumer has fallen so far behind that the
+   * queue is full, the frame is still not waited for. Instead, if 
+   * `OVERWRITE_OLDEST` is `false` the new frame is dropped, and otherwise the
+   * oldest queued frame is replaced by it. Either way the overrun is counted
+   * (see @ref Overruns()). The mic array thread, and so the PDM rx service
+   * feeding it, is therefore never held up by the consumer.
+   * 
+   * The consumer, on another thread of the same tile, takes frames in order
+   * with @ref Receive() or @ref TryReceive(). These copy the frame out, and
+   * retry the copy if the frame was overwritten while it was being read, so
+   * no lock is needed on either side.
+   * 
+   * @tparam MIC_COUNT        Number of audio channels in each frame.
+   * @tparam SAMPLE_COUNT     Number of samples per frame.
+   * @tparam FRAME_COUNT      Number of frames the queue holds.
+   * @tparam OVERWRITE_OLDEST Whether a frame arriving at a full queue replaces
+   *                          the oldest queued frame (`true`) or is dropped
+   *                          (`false`).
+   */
+  template <unsigned MIC_COUNT, unsigned SAMPLE_COUNT, 
+            unsigned FRAME_COUNT, bool OVERWRITE_OLDEST = false>
+  class QueuedFrameTransmitter
+  {
+    static_assert(FRAME_COUNT >= 1, "FRAME_COUNT must be at least 1.");
+
+    private:
+
+      /**
+       * @brief Queued frames.
+       */
+      int32_t queue[FRAME_COUNT][MIC_COUNT][SAMPLE_COUNT];
+
+      /**
+       * @brief Per-frame write sequence numbers; odd while being written.
+       */
+      volatile unsigned seq[FRAME_COUNT] = {0};
+
+      /**
+       * @brief Number of frames queued so far. Written by the producer only,
+       *        before the frame itself.
+       */
+      volatile unsigned head = 0;
+
+      /**
+       * @brief Number of frames taken (or skipped) by the consumer. Written by 
+       *        the consumer only.
+       */
+      volatile unsigned tail = 0;
+
+      /**
+       * @brief Number of frames dropped or overwritten.
+       */
+      volatile unsigned overruns = 0;
+
+    public:
+
+      /**
+       * @brief Queue the specified frame, without blocking.
+       * 
+       * Called on the mic array thread. See @ref QueuedFrameTransmitter.
+       * 
+       * @param frame Frame to be transmitted.
+       */
+      void OutputFrame(int32_t frame[MIC_COUNT][SAMPLE_COUNT]);
+
+      /**
+       * @brief Take the oldest queued frame, waiting for one if necessary.
+       * 
+       * Called on the consumer thread.
+       * 
+       * @param frame Buffer to copy the frame into.
+       */
+      void Receive(int32_t frame[MIC_COUNT][SAMPLE_COUNT]);
+
+      /**
+       * @brief Take the oldest queued frame, if there is one.
+       * 
+       * Called on the consumer thread.
+       * 
+       * @param frame Buffer to copy the frame into.
+       * 
+       * @returns `true` if a frame was copied into `frame`, `false` if the 
+       *          queue was empty.
+       */
+      bool TryReceive(int32_t frame[MIC_COUNT][SAMPLE_COUNT]);
+
+      /**
+       * @brief Number of frames waiting to be received.
+       */
+      unsigned Pending() const;
+
+      /**
+       * @brief Number of frames dropped or overwritten because the queue was
+       *        full.
+       */
+      unsigned Overruns() const;
+  };
+
+
+  /**
+   * @brief Adapts @ref QueuedFrameTransmitter to a class template of the mic
+   *        and sample counts only, for use with @ref FrameOutputHandler.
+   * 
+   * For example:
+   * 
+   * @code{.cpp}
+   * mic_array::FrameOutputHandler<8, 32, 
+   *     mic_array::QueuedFrameTransmitterOf<4>::Type> output_handler;
+   * @endcode
+   */
+  template <unsigned FRAME_COUNT, bool OVERWRITE_OLDEST = false>
+  struct QueuedFrameTransmitterOf
+  {
+    /**
+     * @ref QueuedFrameTransmitter of `FRAME_COUNT` frames with `MIC_COUNT`
+     * channels and `SAMPLE_COUNT` samples.
+     */
+    template <unsigned MIC_COUNT, unsigned SAMPLE_COUNT>
+    using Type = QueuedFrameTransmitter<MIC_COUNT, SAMPLE_COUNT, 
+                                        FRAME_COUNT, OVERWRITE_OLDEST>;
+  };
+
+
+  /**
+   * @brief Frame transmitter which writes frames into a lock-free 
+   *        single-producer, single-consumer ring of samples, for a consumer
+   *        on the same tile which takes one sample at a time.
+   * 
+   * This class template is meant for use as the `FrameTransmitter` template
+   * parameter of @ref FrameOutputHandler, through 
+   * @ref RingBufferFrameTransmitterOf.
+   * 
+   * The ring holds `CAPACITY` samples, each of `MIC_COUNT` channels stored
+   * together. @ref OutputFrame() copies a frame's `SAMPLE_COUNT` samples
+   * into it and returns at once. A consumer such as an I2S or TDM callback,
+   * on another thread of the same tile, takes them one at a time with 
+   * @ref PopSample(). No channel is involved, so neither side ever waits on
+   * a handshake.
+   * 
+   * The producer only writes the head index, and the consumer only writes
+   * the tail index; each reads the other's index to see how much room or 
+   * data there is, and there is no shared count which both update. The 
+   * samples are written before the head is advanced past them, and read 
+   * before the tail is, so neither side needs a lock.
+   * 
+   * If the ring has no room for a whole frame, because the consumer has 
+   * fallen behind, the frame is dropped and counted (see @ref Overruns()).
+   * If the consumer finds the ring empty, @ref PopSample() returns `false`
+   * and that is counted too (see @ref Underruns()). A `CAPACITY` of at least
+   * `2 * SAMPLE_COUNT` lets the consumer run up to a frame behind or ahead
+   * without either.
+   * 
+   * If the @ref FrameOutputHandler builds `SAMPLE_MAJOR` frames, 
+   * `SAMPLE_MAJOR` must be `true` here too, and each frame is then copied
+   * into the ring as it is.
+   * 
+   * @tparam MIC_COUNT    Number of audio channels in each frame.
+   * @tparam SAMPLE_COUNT Number of samples per frame.
+   * @tparam CAPACITY     Number of samples the ring holds. A power of 2, no
+   *                      less than `SAMPLE_COUNT`.
+   * @tparam SAMPLE_MAJOR Whether frames are in `[SAMPLE_COUNT][MIC_COUNT]`
+   *                      order rather than `[MIC_COUNT][SAMPLE_COUNT]`.
+   */
+  template <unsigned MIC_COUNT, unsigned SAMPLE_COUNT, 
+            unsigned CAPACITY, bool SAMPLE_MAJOR = false>
+  class RingBufferFrameTransmitter
+  {
+    static_assert(CAPACITY >= SAMPLE_COUNT, 
+                  "CAPACITY must be at least SAMPLE_COUNT.");
+    static_assert((CAPACITY & (CAPACITY - 1)) == 0, 
+                  "CAPACITY must be a power of 2.");
+
+    private:
+
+      /**
+       * @brief The ring of samples.
+       */
+      int32_t ring[CAPACITY][MIC_COUNT];
+
+      /**
+       * @brief Number of samples written so far. Written by the producer
+       *        only, after the samples themselves.
+       */
+      volatile unsigned head = 0;
+
+      /**
+       * @brief Number of samples taken by the consumer. Written by the 
+       *        consumer only.
+       */
+      volatile unsigned tail = 0;
+
+      /**
+       * @brief Number of frames dropped. Written by the producer only.
+       */
+      volatile unsigned overruns = 0;
+
+      /**
+       * @brief Number of times the ring was found empty. Written by the 
+       *        consumer only.
+       */
+      volatile unsigned underruns = 0;
+
+    public:
+
+      /**
+       * @brief Write the specified frame into the ring, without blocking.
+       * 
+       * Called on the mic array thread. See @ref RingBufferFrameTransmitter.
+       * 
+       * @param frame Frame to be transmitted.
+       */
+      void OutputFrame(int32_t frame[MIC_COUNT][SAMPLE_COUNT]);
+
+      /**
+       * @brief Take the oldest sample in the ring, if there is one.
+       * 
+       * Called on the consumer thread.
+       * 
+       * @param sample Buffer to copy the sample's `MIC_COUNT` channels into.
+       * 
+       * @returns `true` if a sample was copied into `sample`, `false` if the
+       *          ring was empty.
+       */
+      bool PopSample(int32_t sample[MIC_COUNT]);
+
+      /**
+       * @brief Number of samples waiting to be taken.
+       */
+      unsigned Available() const;
+
+      /**
+       * @brief Number of frames dropped because the ring was full.
+       */
+      unsigned Overruns() const;
+
+      /**
+       * @brief Number of calls to @ref PopSample() which found the ring 
+       *        empty.
+       */
+      unsigned Underruns() const;
+  };
+
+
+  /**
+   * @brief Adapts @ref RingBufferFrameTransmitter to a class template of the
+   *        mic and sample counts only, for use with @ref FrameOutputHandler.
+   * 
+   * For example, for an I2S callback taking one sample of 2 channels at a
+   * time from 16-sample frames:
+   * 
+   * @code{.cpp}
+   * mic_array::FrameOutputHandler<2, 16, 
+   *     mic_array::RingBufferFrameTransmitterOf<64>::Type> output_handler;
+   * ...
+   * int32_t sample[2];
+   * if(!output_handler.FrameTx.PopSample(sample))
+   *   sample[0] = sample[1] = 0;
+   * @endcode
+   */
+  template <unsigned CAPACITY, bool SAMPLE_MAJOR = false>
+  struct RingBufferFrameTransmitterOf
+  {
+    /**
+     * @ref RingBufferFrameTransmitter of `CAPACITY` samples with `MIC_COUNT`
+     * channels, taking frames of `SAMPLE_COUNT` samples.
+     */
+    template <unsigned MIC_COUNT, unsigned SAMPLE_COUNT>
+    using Type = RingBufferFrameTransmitter<MIC_COUNT, SAMPLE_COUNT, 
+                                            CAPACITY, SAMPLE_MAJOR>;
+  };
+
+
+  /**
+   * @brief FrameTransmitter which only passes on frames with voice or other
+   *        activity, with hysteresis and a pre-roll.
+   * 
+   * This wraps @ref Inner, another FrameTransmitter, e.g. a
+   * @ref ChannelFrameTransmitter, and can be used wherever the wrapped
+   * transmitter could, via @ref GatedFrameTransmitterOf. In always-on
+   * applications it keeps silent frames off the channel, so the consumer
+   * can sleep until there is something to process.
+   * 
+   * The gate measures each frame's energy, the mean of `(sample >> 8)^2`
+   * over all its channels and samples (the units of 
+   * @ref ChannelLevels::mean_square). While the gate is closed, frames are
+   * not passed on, but the last `PREROLL_FRAMES` of them are kept. The gate
+   * opens on the first frame whose energy reaches the open level; the 
+   * pre-roll is then passed on, oldest first, ahead of that frame, so the
+   * consumer also receives the start of the onset. While the gate is open,
+   * every frame is passed on. It closes again on a frame below the close
+   * level, once `hangover` frames in a row below it have been passed on.
+   * A close level below the open level, and a hangover, keep the gate from
+   * chattering around a single threshold.
+   * 
+   * Both levels are `0` until @ref SetLevels() is called, so by default 
+   * every frame is passed on.
+   * 
+   * Only `int32_t` frames are supported, i.e. @ref FrameOutputHandler with
+   * @ref FrameFormatS32. The frame energy does not depend on the frame's
+   * layout, so `SAMPLE_MAJOR` frames may be gated as well.
+   * 
+   * @tparam MIC_COUNT        Number of channels in each frame.
+   * @tparam SAMPLE_COUNT     Number of samples in each frame.
+   * @tparam FrameTransmitter The wrapped FrameTransmitter.
+   * @tparam PREROLL_FRAMES   Number of frames held while the gate is closed.
+   */
+  template <unsigned MIC_COUNT, unsigned SAMPLE_COUNT, 
+            template <unsigned, unsigned> class FrameTransmitter,
+            unsigned PREROLL_FRAMES>
+  class GatedFrameTransmitter
+  {
+    static_assert(MIC_COUNT * SAMPLE_COUNT <= (1u << 18), 
+                  "Frames of more than 2^18 samples are not supported.");
+
+    public:
+
+      /**
+       * @brief The FrameTransmitter frames are passed on to.
+       */
+      FrameTransmitter<MIC_COUNT, SAMPLE_COUNT> Inner;
+
+    private:
+
+      /**
+       * @brief Number of frame buffers in `preroll`.
+       */
+      static constexpr unsigned PREROLL_BUFFERS = 
+          PREROLL_FRAMES? PREROLL_FRAMES : 1;
+
+      /**
+       * @brief Frames held while the gate is closed, oldest at
+       *        `preroll_head - preroll_count`.
+       */
+      int32_t preroll[PREROLL_BUFFERS][MIC_COUNT][SAMPLE_COUNT];
+
+      /**
+       * @brief Slot of `preroll` the next held frame is written to.
+       */
+      unsigned preroll_head = 0;
+
+      /**
+       * @brief Number of frames in `preroll`.
+       */
+      unsigned preroll_count = 0;
+
+      /**
+       * @brief Energy at or above which the gate opens.
+       */
+      uint64_t open_level = 0;
+
+      /**
+       * @brief Energy below which the open gate starts to close.
+       */
+      uint64_t close_level = 0;
+
+      /**
+       * @brief Frames below `close_level` passed on before the gate closes.
+       */
+      unsigned hangover = 0;
+
+      /**
+       * @brief Frames below `close_level` passed on since the last frame 
+       *        above it.
+       */
+      unsigned quiet = 0;
+
+      /**
+       * @brief Whether the gate is open.
+       */
+      bool open = false;
+
+      /**
+       * @brief Energy of the latest frame.
+       */
+      uint64_t energy = 0;
+
+      /**
+       * @brief Number of frames never passed on.
+       */
+      unsigned suppressed = 0;
+
+    public:
+
+      /**
+       * @brief Set the levels at which the gate opens and closes.
+       * 
+       * Should be called before the mic array thread starts.
+       * 
+       * @param open_level  Frame energy at or above which the gate opens.
+       * @param close_level Frame energy below which the open gate closes;
+       *                    no greater than `open_level`.
+       * @param hangover    Number of frames below `close_level` in a row
+       *                    which are still passed on before the gate closes.
+       */
+      void SetLevels(uint64_t open_level, uint64_t close_level, 
+                     unsigned hangover = 0);
+
+      /**
+       * @brief Pass on or hold the specified frame.
+       * 
+       * Called on the mic array thread.
+       * 
+       * @param frame Frame to be transmitted.
+       */
+      void OutputFrame(int32_t frame[MIC_COUNT][SAMPLE_COUNT]);
+
+      /**
+       * @brief Whether the gate is currently open.
+       */
+      bool IsOpen() const;
+
+      /**
+       * @brief Energy of the latest frame.
+       */
+      uint64_t Energy() const;
+
+      /**
+       * @brief Number of frames dropped by the gate, i.e. held while it was
+       *        closed and then pushed out of the pre-roll.
+       */
+      unsigned Suppressed() const;
+  };
+
+
+  /**
+   * @brief Adapts @ref GatedFrameTransmitter to a class template of the mic
+   *        and sample counts only, for use with @ref FrameOutputHandler.
+   * 
+   * For example:
+   * 
+   * @code{.cpp}
+   * mic_array::FrameOutputHandler<8, 256, 
+   *     mic_array::GatedFrameTransmitterOf<
+   *         mic_array::ChannelFrameTransmitter, 2>::Type> output_handler;
+   * 
+   * output_handler.FrameTx.SetLevels(open_level, open_level / 4, 8);
+   * output_handler.FrameTx.Inner.SetChannel(c_frames_out);
+   * @endcode
+   */
+  template <template <unsigned, unsigned> class FrameTransmitter,
+            unsigned PREROLL_FRAMES = 2>
+  struct GatedFrameTransmitterOf
+  {
+    /**
+     * @ref GatedFrameTransmitter of a `FrameTransmitter` with `MIC_COUNT`
+     * channels and `SAMPLE_COUNT` samples.
+     */
+    template <unsigned MIC_COUNT, unsigned SAMPLE_COUNT>
+    using Type = GatedFrameTransmitter<MIC_COUNT, SAMPLE_COUNT, 
+                                       FrameTransmitter, PREROLL_FRAMES>;
+  };
+
+}  
+
+
+//////////////////////////////////////////////
+// Template function implementations below. //
+//////////////////////////////////////////////
+
+
+
+template <unsigned MIC_COUNT, 
+          unsigned SAMPLE_COUNT, 
+          template <unsigned, unsigned> class FrameTransmitter,
+          unsigned FRAME_COUNT,
+          bool SAMPLE_MAJOR,
+          class FRAME_FORMAT>
+constexpr float mic_array::FrameOutputHandler<MIC_COUNT,SAMPLE_COUNT,
+                        FrameTransmitter,FRAME_COUNT,SAMPLE_MAJOR,
+                        FRAME_FORMAT>::RequiredMips(
+    const unsigned sample_rate)
+{
+  return (float(sample_rate) * MIC_COUNT * KernelCost::FrameTxSample
+        + (float(sample_rate) / SAMPLE_COUNT) * KernelCost::FrameTxFrame) 
+            / 1e6f;
+}
+
+
+template <unsigned MIC_COUNT, 
+          unsigned SAMPLE_COUNT, 
+          template <unsigned, unsigned> class FrameTransmitter,
+          unsigned FRAME_COUNT,
+          bool SAMPLE_MAJOR,
+          class FRAME_FORMAT>
+typename FRAME_FORMAT::sample_t* 
+    mic_array::FrameOutputHandler<MIC_COUNT,SAMPLE_COUNT,FrameTransmitter,
+                        FRAME_COUNT,SAMPLE_MAJOR,FRAME_FORMAT>::Frame(
+    unsigned f)
+{
+  return reinterpret_cast<typename FRAME_FORMAT::sample_t*>(&this->frames[f][0]);
+}
+
+
+template <unsigned MIC_COUNT, 
+          unsigned SAMPLE_COUNT, 
+          template <unsigned, unsigned> class FrameTransmitter,
+          unsigned FRAME_COUNT,
+          bool SAMPLE_MAJOR,
+          class FRAME_FORMAT>
+void mic_array::FrameOutputHandler<MIC_COUNT,SAMPLE_COUNT,FrameTransmitter,
+                        FRAME_COUNT,SAMPLE_MAJOR,FRAME_FORMAT>::Transmit(
+    unsigned f, std::true_type)
+{
+  Deliver(FrameTx, this->header,
+      reinterpret_cast<int32_t (*)[SAMPLE_COUNT]>(&this->frames[f][0]), 0);
+}
+
+
+template <unsigned MIC_COUNT, 
+          unsigned SAMPLE_COUNT, 
+          template <unsigned, unsigned> class FrameTransmitter,
+          unsigned FRAME_COUNT,
+          bool SAMPLE_MAJOR,
+          class FRAME_FORMAT>
+void mic_array::FrameOutputHandler<MIC_COUNT,SAMPLE_COUNT,FrameTransmitter,
+                        FRAME_COUNT,SAMPLE_MAJOR,FRAME_FORMAT>::Transmit(
+    unsigned f, std::false_type)
+{
+  Deliver(FrameTx, this->header,
+      const_cast<const typename FRAME_FORMAT::sample_t*>(this->Frame(f)), 0);
+}
+
+
+template <unsigned MIC_COUNT, 
+          unsigned SAMPLE_COUNT, 
+          template <unsigned, unsigned> class FrameTransmitter,
+          unsigned FRAME_COUNT,
+          bool SAMPLE_MAJOR,
+          class FRAME_FORMAT>
+template <class T, class F>
+auto mic_array::FrameOutputHandler<MIC_COUNT,SAMPLE_COUNT,FrameTransmitter,
+                        FRAME_COUNT,SAMPLE_MAJOR,FRAME_FORMAT>::Deliver(
+    T& tx,
+    const ma_frame_header_t& header,
+    F frame,
+    int) -> decltype(tx.OutputFrame(header, frame))
+{
+  return tx.OutputFrame(header, frame);
+}
+
+
+template <unsigned MIC_COUNT, 
+          unsigned SAMPLE_COUNT, 
+          template <unsigned, unsigned> class FrameTransmitter,
+          unsigned FRAME_COUNT,
+          bool SAMPLE_MAJOR,
+          class FRAME_FORMAT>
+template <class T, class F>
+void mic_array::FrameOutputHandler<MIC_COUNT,SAMPLE_COUNT,FrameTransmitter,
+                        FRAME_COUNT,SAMPLE_MAJOR,FRAME_FORMAT>::Deliver(
+    T& tx,
+    const ma_frame_header_t& header,
+    F frame,
+    long)
+{
+  tx.OutputFrame(frame);
+}
+
+
+template <unsigned MIC_COUNT, 
+          unsigned SAMPLE_COUNT, 
+          template <unsigned, unsigned> class FrameTransmitter,
+          unsigned FRAME_COUNT,
+          bool SAMPLE_MAJOR,
+          class FRAME_FORMAT>
+void mic_array::FrameOutputHandler<MIC_COUNT,SAMPLE_COUNT,FrameTransmitter,
+                        FRAME_COUNT,SAMPLE_MAJOR,FRAME_FORMAT>::StoreSample(
+    const int32_t sample[MIC_COUNT])
+{
+  auto* cur_frame = this->Frame(this->current_frame);
+
+  if(this->current_sample == 0)
+    this->header = {this->sample_index, this->block_time};
+  this->sample_index++;
+
+  if(SAMPLE_MAJOR){
+    // Contiguous, so no scatter.
+    FRAME_FORMAT::Store(cur_frame, this->current_sample * MIC_COUNT, 
+                        sample, MIC_COUNT);
+  } else {
+    for(int k = 0; k < MIC_COUNT; k++) 
+      FRAME_FORMAT::Store(cur_frame, k * SAMPLE_COUNT + this->current_sample, 
+                          sample[k]);
+  }
+}
+
+
+template <unsigned MIC_COUNT, 
+          unsigned SAMPLE_COUNT, 
+          template <unsigned, unsigned> class FrameTransmitter,
+          unsigned FRAME_COUNT,
+          bool SAMPLE_MAJOR,
+          class FRAME_FORMAT>
+void mic_array::FrameOutputHandler<MIC_COUNT,SAMPLE_COUNT,FrameTransmitter,
+                        FRAME_COUNT,SAMPLE_MAJOR,FRAME_FORMAT>::SendFrame()
+{
+  const unsigned f = this->current_frame;
+
+  current_sample = 0;
+  current_frame++;
+  if(current_frame == FRAME_COUNT) current_frame = 0;
+
+  this->Transmit(f, std::is_same<FRAME_FORMAT, FrameFormatS32>());
+}
+
+
+template <unsigned MIC_COUNT, 
+          unsigned SAMPLE_COUNT, 
+          template <unsigned, unsigned> class FrameTransmitter,
+          unsigned FRAME_COUNT,
+          bool SAMPLE_MAJOR,
+          class FRAME_FORMAT>
+void mic_array::FrameOutputHandler<MIC_COUNT,SAMPLE_COUNT,FrameTransmitter,
+                        FRAME_COUNT,SAMPLE_MAJOR,FRAME_FORMAT>::OutputSample(
+    int32_t sample[MIC_COUNT])
+{
+  this->StoreSample(sample);
+  
+  if(++current_sample == SAMPLE_COUNT)
+    this->SendFrame();
+}
+
+
+template <unsigned MIC_COUNT, 
+          unsigned SAMPLE_COUNT, 
+          template <unsigned, unsigned> class FrameTransmitter,
+          unsigned FRAME_COUNT,
+          bool SAMPLE_MAJOR,
+          class FRAME_FORMAT>
+template <unsigned SAMPLES>
+void mic_array::FrameOutputHandler<MIC_COUNT,SAMPLE_COUNT,FrameTransmitter,
+                        FRAME_COUNT,SAMPLE_MAJOR,FRAME_FORMAT>::OutputSamples(
+    int32_t (&samples)[SAMPLES][MIC_COUNT])
+{
+  for(unsigned s = 0; s < SAMPLES; s++){
+    this->StoreSample(samples[s]);
+
+    if(++current_sample == SAMPLE_COUNT)
+      this->SendFrame();
+  }
+}
+
+
+template <unsigned MIC_COUNT, 
+          unsigned SAMPLE_COUNT, 
+          template <unsigned, unsigned> class FrameTransmitter,
+          unsigned FRAME_COUNT,
+          bool SAMPLE_MAJOR,
+          class FRAME_FORMAT>
+void mic_array::FrameOutputHandler<MIC_COUNT,SAMPLE_COUNT,FrameTransmitter,
+                        FRAME_COUNT,SAMPLE_MAJOR,FRAME_FORMAT>::OutputFrame(
+    int32_t frame[MIC_COUNT][SAMPLE_COUNT])
+{
+  assert(this->current_sample == 0);
+
+  this->header = {this->sample_index, this->block_time};
+  this->sample_index += SAMPLE_COUNT;
+
+  this->OutputFrame(frame, std::integral_constant<bool, !SAMPLE_MAJOR 
+                      && std::is_same<FRAME_FORMAT, FrameFormatS32>::value>());
+}
+
+
+template <unsigned MIC_COUNT, 
+          unsigned SAMPLE_COUNT, 
+          template <unsigned, unsigned> class FrameTransmitter,
+          unsigned FRAME_COUNT,
+          bool SAMPLE_MAJOR,
+          class FRAME_FORMAT>
+void mic_array::FrameOutputHandler<MIC_COUNT,SAMPLE_COUNT,FrameTransmitter,
+                        FRAME_COUNT,SAMPLE_MAJOR,FRAME_FORMAT>::OutputFrame(
+    int32_t frame[MIC_COUNT][SAMPLE_COUNT], std::true_type)
+{
+  Deliver(FrameTx, this->header, frame, 0);
+}
+
+
+template <unsigned MIC_COUNT, 
+          unsigned SAMPLE_COUNT, 
+          template <unsigned, unsigned> class FrameTransmitter,
+          unsigned FRAME_COUNT,
+          bool SAMPLE_MAJOR,
+          class FRAME_FORMAT>
+void mic_array::FrameOutputHandler<MIC_COUNT,SAMPLE_COUNT,FrameTransmitter,
+                        FRAME_COUNT,SAMPLE_MAJOR,FRAME_FORMAT>::OutputFrame(
+    int32_t frame[MIC_COUNT][SAMPLE_COUNT], std::false_type)
+{
+  auto* cur_frame = this->Frame(this->current_frame);
+
+  if(SAMPLE_MAJOR){
+    for(int k = 0; k < MIC_COUNT; k++)
+      for(int s = 0; s < SAMPLE_COUNT; s++)
+        FRAME_FORMAT::Store(cur_frame, s * MIC_COUNT + k, frame[k][s]);
+  } else {
+    FRAME_FORMAT::Store(cur_frame, 0, &frame[0][0], MIC_COUNT * SAMPLE_COUNT);
+  }
+
+  this->SendFrame();
+}
+
+
+template <unsigned MIC_COUNT, 
+          unsigned SAMPLE_COUNT, 
+          template <unsigned, unsigned> class FrameTransmitter,
+          unsigned FRAME_COUNT,
+          bool SAMPLE_MAJOR,
+          class FRAME_FORMAT>
+void mic_array::FrameOutputHandler<MIC_COUNT,SAMPLE_COUNT,FrameTransmitter,
+                        FRAME_COUNT,SAMPLE_MAJOR,FRAME_FORMAT>::SetBlockStamp(
+    uint32_t sample_index, 
+    uint32_t timestamp)
+{
+  this->sample_index = sample_index;
+  this->block_time = timestamp;
+}
+
+
+template <unsigned MIC_COUNT, 
+          unsigned WINDOW, 
+          unsigned HOP,
+          template <unsigned, unsigned> class FrameTransmitter>
+void mic_array::OverlapFrameOutputHandler<MIC_COUNT,WINDOW,HOP,
+                                          FrameTransmitter>::SetWindow(
+    const int32_t window[WINDOW])
+{
+  this->window = window;
+}
+
+
+template <unsigned MIC_COUNT, 
+          unsigned WINDOW, 
+          unsigned HOP,
+          template <unsigned, unsigned> class FrameTransmitter>
+void mic_array::OverlapFrameOutputHandler<MIC_COUNT,WINDOW,HOP,
+                                          FrameTransmitter>::OutputSample(
+    int32_t sample[MIC_COUNT])
+{
+  // Frame newest-k started k hops before the newest one.
+  for(unsigned k = 0; k < OVERLAPS; k++){
+    const unsigned f = (this->newest + FRAME_COUNT - k) % FRAME_COUNT;
+    for(unsigned ch = 0; ch < MIC_COUNT; ch++)
+      this->frames[f][ch][this->offset + k * HOP] = sample[ch];
+  }
+
+  if(++this->offset < HOP)
+    return;
+
+  this->offset = 0;
+
+  const unsigned done = (this->newest + FRAME_COUNT - (OVERLAPS - 1)) 
+                          % FRAME_COUNT;
+
+  if(this->window != nullptr){
+    for(unsigned ch = 0; ch < MIC_COUNT; ch++){
+      int32_t* x = this->frames[done][ch];
+#if defined(__XS3A__)
+      // Q1.31 window as Q2.30, so the product needs no further shift.
+      vect_s32_mul(x, x, this->window, WINDOW, 0, 1);
+#else
+      for(unsigned k = 0; k < WINDOW; k++)
+        x[k] = (int32_t) (((int64_t) x[k] * (this->window[k] >> 1) 
+                            + (1 << 29)) >> 30);
+#endif
+    }
+  }
+
+  this->FrameTx.OutputFrame(this->frames[done]);
+
+  // The next frame reuses the one passed on before this, which the 
+  // FrameTransmitter has finished with.
+  this->newest = (this->newest + 1) % FRAME_COUNT;
+}
+
+
+template <unsigned MIC_COUNT, 
+          unsigned WINDOW, 
+          unsigned HOP,
+          template <unsigned, unsigned> class FrameTransmitter>
+template <unsigned SAMPLES>
+void mic_array::OverlapFrameOutputHandler<MIC_COUNT,WINDOW,HOP,
+                                          FrameTransmitter>::OutputSamples(
+    int32_t (&samples)[SAMPLES][MIC_COUNT])
+{
+  for(unsigned k = 0; k < SAMPLES; k++)
+    this->OutputSample(samples[k]);
+}
+
+
+template <unsigned MIC_COUNT, 
+          unsigned FFT_SIZE, 
+          template <unsigned, unsigned> class FrameTransmitter,
+          unsigned FIRST_BIN,
+          unsigned BIN_COUNT>
+void mic_array::FftOutputHandler<MIC_COUNT,FFT_SIZE,FrameTransmitter,
+                                 FIRST_BIN,BIN_COUNT>::Transform()
+{
+  auto& frame = this->frames[this->current_frame];
+
+  // log2(FFT_SIZE)
+  int log2_n = 0;
+  while((1u << log2_n) < FFT_SIZE) log2_n++;
+
+  bfp_s32_t x[MIC_COUNT];
+  for(unsigned ch = 0; ch < MIC_COUNT; ch++)
+    bfp_s32_init(&x[ch], frame[ch], -31, FFT_SIZE, 1);
+
+  // Pairs of channels share an FFT; an odd one out has its own.
+  unsigned k = 0;
+  for(; k + 1 < MIC_COUNT; k += 2)
+    bfp_fft_forward_stereo(&x[k], &x[k + 1], this->scratch);
+  if(k < MIC_COUNT)
+    bfp_fft_forward_mono(&x[k]);
+
+  // Each row's bins go to the start of row ch of a [MIC_COUNT][2*BIN_COUNT]
+  // array over the same buffer. That is never after where they are, so the
+  // rows can be moved in order.
+  int32_t* out = &frame[0][0];
+  for(unsigned ch = 0; ch < MIC_COUNT; ch++){
+    int32_t* bins = &out[ch * 2 * BIN_COUNT];
+    memmove(bins, &frame[ch][2 * FIRST_BIN], 2 * BIN_COUNT * sizeof(int32_t));
+    // The spectrum's mantissas are the DFT scaled by 2^-exp; the output is
+    // the DFT scaled by 2^(31 - log2_n).
+    vect_s32_shl(bins, bins, 2 * BIN_COUNT, x[ch].exp + 31 - log2_n);
+  }
+}
+
+
+template <unsigned MIC_COUNT, 
+          unsigned FFT_SIZE, 
+          template <unsigned, unsigned> class FrameTransmitter,
+          unsigned FIRST_BIN,
+          unsigned BIN_COUNT>
+void mic_array::FftOutputHandler<MIC_COUNT,FFT_SIZE,FrameTransmitter,
+                                 FIRST_BIN,BIN_COUNT>::OutputSample(
+    int32_t sample[MIC_COUNT])
+{
+  auto& frame = this->frames[this->current_frame];
+
+  for(unsigned ch = 0; ch < MIC_COUNT; ch++)
+    frame[ch][this->current_sample] = sample[ch];
+
+  if(++this->current_sample < FFT_SIZE)
+    return;
+
+  this->current_sample = 0;
+  this->Transform();
+
+  this->FrameTx.OutputFrame(
+      reinterpret_cast<int32_t(*)[2 * BIN_COUNT]>(&frame[0][0]));
+
+  this->current_frame = 1 - this->current_frame;
+}
+
+
+template <unsigned MIC_COUNT, 
+          unsigned FFT_SIZE, 
+          template <unsigned, unsigned> class FrameTransmitter,
+          unsigned FIRST_BIN,
+          unsigned BIN_COUNT>
+template <unsigned SAMPLES>
+void mic_array::FftOutputHandler<MIC_COUNT,FFT_SIZE,FrameTransmitter,
+                                 FIRST_BIN,BIN_COUNT>::OutputSamples(
+    int32_t (&samples)[SAMPLES][MIC_COUNT])
+{
+  for(unsigned k = 0; k < SAMPLES; k++)
+    this->OutputSample(samples[k]);
+}
+
+
+template <unsigned MIC_COUNT, 
+          unsigned S2_DEC_FACTOR, 
+          unsigned S2_TAP_COUNT,
+          class TFullRate,
+          class TLowRate>
+void mic_array::DualRateOutputHandler<MIC_COUNT,S2_DEC_FACTOR,S2_TAP_COUNT,
+                                      TFullRate,TLowRate>::Init(
+    const int32_t* coef,
+    const right_shift_t shr)
+{
+  this->filter.Init(coef, shr);
+}
+
+
+template <unsigned MIC_COUNT, 
+          unsigned S2_DEC_FACTOR, 
+          unsigned S2_TAP_COUNT,
+          class TFullRate,
+          class TLowRate>
+void mic_array::DualRateOutputHandler<MIC_COUNT,S2_DEC_FACTOR,S2_TAP_COUNT,
+                                      TFullRate,TLowRate>::OutputSample(
+    int32_t sample[MIC_COUNT])
+{
+  FullRate.OutputSample(sample);
+
+  this->filter.Advance();
+  for(unsigned k = 0; k < MIC_COUNT; k++)
+    this->filter.Set(k, sample[k]);
+
+  if(++this->phase == S2_DEC_FACTOR){
+    this->phase = 0;
+
+    int32_t low_rate_sample[MIC_COUNT];
+    this->filter.Filter(low_rate_sample);
+    LowRate.OutputSample(low_rate_sample);
+  }
+}
+
+
+template <unsigned MIC_COUNT, 
+          unsigned UP, 
+          unsigned DOWN,
+          unsigned PHASE_TAPS,
+          class TOutput>
+void mic_array::ResamplingOutputHandler<MIC_COUNT,UP,DOWN,PHASE_TAPS,
+                                        TOutput>::Init(
+    const int32_t* coef,
+    const right_shift_t shr)
+{
+  this->coef = coef;
+  this->shr = shr;
+  this->next = 0;
+}
+
+
+template <unsigned MIC_COUNT, 
+          unsigned UP, 
+          unsigned DOWN,
+          unsigned PHASE_TAPS,
+          class TOutput>
+void mic_array::ResamplingOutputHandler<MIC_COUNT,UP,DOWN,PHASE_TAPS,
+                                        TOutput>::OutputSample(
+    int32_t sample[MIC_COUNT])
+{
+  this->filter.Advance();
+  for(unsigned k = 0; k < MIC_COUNT; k++)
+    this->filter.Set(k, sample[k]);
+
+  while(this->next < UP){
+    int32_t out[MIC_COUNT];
+    this->filter.Filter(out, &this->coef[this->next * PHASE_TAPS], this->shr);
+    Output.OutputSample(out);
+    this->next += DOWN;
+  }
+  this->next -= UP;
+}
+
+
+template <unsigned MIC_COUNT, 
+          unsigned BEAMS,
+          unsigned SAMPLE_COUNT, 
+          template <unsigned, unsigned> class FrameTransmitter,
+          unsigned TAP_COUNT>
+void mic_array::BeamformOutputHandler<MIC_COUNT,BEAMS,SAMPLE_COUNT,
+                                      FrameTransmitter,TAP_COUNT>::Init()
+{
+  memset(this->history, 0, sizeof(this->history));
+  this->position = 0;
+
+  memset(this->coef, 0, sizeof(this->coef));
+  for(unsigned b = 0; b < BEAMS; b++)
+    for(unsigned k = 0; k < MIC_COUNT; k++)
+      this->coef[b][k] = (TAP_UNITY + MIC_COUNT / 2) / MIC_COUNT;
+}
+
+
+template <unsigned MIC_COUNT, 
+          unsigned BEAMS,
+          unsigned SAMPLE_COUNT, 
+          template <unsigned, unsigned> class FrameTransmitter,
+          unsigned TAP_COUNT>
+void mic_array::BeamformOutputHandler<MIC_COUNT,BEAMS,SAMPLE_COUNT,
+                                      FrameTransmitter,TAP_COUNT>::SetTaps(
+    unsigned beam,
+    unsigned mic,
+    const int32_t taps[TAP_COUNT])
+{
+  for(unsigned t = 0; t < TAP_COUNT; t++)
+    this->coef[beam][t * MIC_COUNT + mic] = taps[t];
+}
+
+
+template <unsigned MIC_COUNT, 
+          unsigned BEAMS,
+          unsigned SAMPLE_COUNT, 
+          template <unsigned, unsigned> class FrameTransmitter,
+          unsigned TAP_COUNT>
+void mic_array::BeamformOutputHandler<MIC_COUNT,BEAMS,SAMPLE_COUNT,
+                                      FrameTransmitter,TAP_COUNT>::SetSteering(
+    unsigned beam,
+    unsigned mic,
+    float weight,
+    float delay)
+{
+  assert(delay >= 0 && delay <= (TAP_COUNT - 1));
+
+  // Interpolate from the POINTS taps nearest the delay, with the delay
+  // between the middle two where possible.
+  constexpr unsigned POINTS = (TAP_COUNT < 4)? TAP_COUNT : 4;
+  const int first = ((int) delay) - (int) (POINTS - 1) / 2;
+  const unsigned t0 = (first < 0)? 0 
+                    : (first + POINTS > TAP_COUNT)? (TAP_COUNT - POINTS) 
+                    : first;
+
+  int32_t taps[TAP_COUNT] = {0};
+  for(unsigned t = t0; t < t0 + POINTS; t++){
+    // Lagrange interpolator: tap t is 1 at delay t and 0 at the other points.
+    float h = weight;
+    for(unsigned j = t0; j < t0 + POINTS; j++)
+      if(j != t)
+        h *= (delay - j) / ((float) t - (float) j);
+
+    const float q = h * TAP_UNITY;
+    taps[t] = (q >= 2147483647.0f)? INT32_MAX 
+            : (q <= -2147483648.0f)? INT32_MIN 
+            : (int32_t) ((q >= 0)? (q + 0.5f) : (q - 0.5f));
+  }
+
+  SetTaps(beam, mic, taps);
+}
+
+
+template <unsigned MIC_COUNT, 
+          unsigned BEAMS,
+          unsigned SAMPLE_COUNT, 
+          template <unsigned, unsigned> class FrameTransmitter,
+          unsigned TAP_COUNT>
+void mic_array::BeamformOutputHandler<MIC_COUNT,BEAMS,SAMPLE_COUNT,
+                                      FrameTransmitter,TAP_COUNT>::OutputSample(
+    int32_t sample[MIC_COUNT])
+{
+  this->position = (this->position == 0)? (TAP_COUNT - 1) 
+                                        : (this->position - 1);
+
+  memcpy(&this->history[this->position * MIC_COUNT], &sample[0], 
+         sizeof(int32_t) * MIC_COUNT);
+  memcpy(&this->history[(this->position + TAP_COUNT) * MIC_COUNT], &sample[0], 
+         sizeof(int32_t) * MIC_COUNT);
+
+  int32_t beams[BEAMS];
+  for(unsigned b = 0; b < BEAMS; b++)
+    fir_s32_multi(&beams[b], &this->history[this->position * MIC_COUNT],
+                  this->coef[b], 1, 0, WINDOW_BLOCKS, 0);
+
+  FrameOutputHandler<BEAMS,SAMPLE_COUNT,FrameTransmitter>::OutputSample(beams);
+}
+
+
+template <unsigned MIC_COUNT, 
+          unsigned BEAMS,
+          unsigned SAMPLE_COUNT, 
+          template <unsigned, unsigned> class FrameTransmitter,
+          unsigned TAP_COUNT>
+template <unsigned SAMPLES>
+void mic_array::BeamformOutputHandler<MIC_COUNT,BEAMS,SAMPLE_COUNT,
+                                      FrameTransmitter,TAP_COUNT>::OutputSamples(
+    int32_t (&samples)[SAMPLES][MIC_COUNT])
+{
+  for(unsigned s = 0; s < SAMPLES; s++)
+    OutputSample(samples[s]);
+}
+
+
+template <unsigned MIC_COUNT, unsigned SAMPLE_COUNT>
+void mic_array::ChannelSampleOutputHandler<MIC_COUNT,SAMPLE_COUNT>::SetChannel(
+    chanend_t c_frame_out)
+{
+  this->c_frame_out = c_frame_out;
+}
+
+
+template <unsigned MIC_COUNT, unsigned SAMPLE_COUNT>
+chanend_t mic_array::ChannelSampleOutputHandler<MIC_COUNT,SAMPLE_COUNT>
+    ::GetChannel()
+{
+  return this->c_frame_out;
+}
+
+
+template <unsigned MIC_COUNT, unsigned SAMPLE_COUNT>
+void mic_array::ChannelSampleOutputHandler<MIC_COUNT,SAMPLE_COUNT>
+    ::OutputSample(int32_t sample[MIC_COUNT])
+{
+  if(this->current_sample == 0)
+    this->ct_frame = chan_init_transaction_master(this->c_frame_out);
+
+  t_chan_out_buf_word(&this->ct_frame, (uint32_t*) sample, MIC_COUNT);
+
+  if(++this->current_sample == SAMPLE_COUNT){
+    chan_complete_transaction(this->ct_frame);
+    this->current_sample = 0;
+  }
+}
+
+
+template <unsigned MIC_COUNT, unsigned SAMPLE_COUNT>
+template <unsigned SAMPLES>
+void mic_array::ChannelSampleOutputHandler<MIC_COUNT,SAMPLE_COUNT>
+    ::OutputSamples(int32_t (&samples)[SAMPLES][MIC_COUNT])
+{
+  for(unsigned k = 0; k < SAMPLES; k++)
+    this->OutputSample(samples[k]);
+}
 
 
-template <unsigned MIC_COUNT, 
-          unsigned SAMPLE_COUNT, 
-          template <unsigned, unsigned> class FrameTransmitter,
-          unsigned FRAME_COUNT>
-void mic_array::FrameOutputHandler<MIC_COUNT,SAMPLE_COUNT,
-                        FrameTransmitter,FRAME_COUNT>::OutputSample(
+template <unsigned MIC_COUNT, unsigned SAMPLE_COUNT>
+void mic_array::ChannelSampleOutputHandler<MIC_COUNT,SAMPLE_COUNT>
+    ::OutputFrame(int32_t frame[MIC_COUNT][SAMPLE_COUNT])
+{
+  transacting_chanend_t ct = chan_init_transaction_master(this->c_frame_out);
+  for(unsigned smp = 0; smp < SAMPLE_COUNT; smp++)
+    for(unsigned ch = 0; ch < MIC_COUNT; ch++)
+      t_chan_out_word(&ct, (uint32_t) frame[ch][smp]);
+  chan_complete_transaction(ct);
+}
+
+
+template <unsigned MIC_COUNT, unsigned SLOTS, unsigned FRAMES>
+void mic_array::TdmOutputHandler<MIC_COUNT,SLOTS,FRAMES>::SetPorts(
+    port_t p_tdm_out,
+    port_t p_fsync)
+{
+  this->p_tdm_out = p_tdm_out;
+  this->p_fsync = p_fsync;
+}
+
+
+template <unsigned MIC_COUNT, unsigned SLOTS, unsigned FRAMES>
+void mic_array::TdmOutputHandler<MIC_COUNT,SLOTS,FRAMES>::SetFrameSync(
+    const uint32_t pattern[SLOTS])
+{
+  for(unsigned k = 0; k < SLOTS; k++)
+    this->fsync[k] = pattern[k];
+}
+
+
+template <unsigned MIC_COUNT, unsigned SLOTS, unsigned FRAMES>
+void mic_array::TdmOutputHandler<MIC_COUNT,SLOTS,FRAMES>::AttachISR()
+{
+  tdm_tx_isr_context.p_tdm_out = this->p_tdm_out;
+  tdm_tx_isr_context.p_fsync = this->p_fsync;
+  tdm_tx_isr_context.buffer = &this->buffer[0][0];
+  tdm_tx_isr_context.words = BUFFER_FRAMES * SLOTS;
+  tdm_tx_isr_context.index = 0;
+  tdm_tx_isr_context.fsync = &this->fsync[0];
+  tdm_tx_isr_context.slots = SLOTS;
+  tdm_tx_isr_context.slot = 0;
+  this->started = false;
+}
+
+
+template <unsigned MIC_COUNT, unsigned SLOTS, unsigned FRAMES>
+void mic_array::TdmOutputHandler<MIC_COUNT,SLOTS,FRAMES>::InstallISR()
+{
+  this->AttachISR();
+  enable_tdm_tx_isr(this->p_tdm_out);
+}
+
+
+template <unsigned MIC_COUNT, unsigned SLOTS, unsigned FRAMES>
+void mic_array::TdmOutputHandler<MIC_COUNT,SLOTS,FRAMES>::UnmaskISR()
+{
+  interrupt_unmask_all();
+}
+
+
+template <unsigned MIC_COUNT, unsigned SLOTS, unsigned FRAMES>
+void mic_array::TdmOutputHandler<MIC_COUNT,SLOTS,FRAMES>::OutputSample(
     int32_t sample[MIC_COUNT])
 {
-  auto* cur_frame = reinterpret_cast<int32_t (*)[SAMPLE_COUNT]>(
-                        &this->frames[this->current_frame][0][0]);
-  
-  for(int k = 0; k < MIC_COUNT; k++) 
-    cur_frame[k][this->current_sample] = sample[k];
-  
-  if(++current_sample == SAMPLE_COUNT){
-    current_sample = 0;
-    current_frame++;
-    if(current_frame == FRAME_COUNT) current_frame = 0;
+  // The frame the ISR is outputting.
+  const unsigned read_frame = tdm_tx_isr_context.index / SLOTS;
+  const unsigned ahead = (this->write_frame + BUFFER_FRAMES - read_frame) 
+                            % BUFFER_FRAMES;
+
+  if(!this->started){
+    this->started = true;
+    this->write_frame = (read_frame + FRAMES) % BUFFER_FRAMES;
+  } else if(ahead < FRAMES / 2 || ahead > FRAMES + FRAMES / 2){
+    this->slips = this->slips + 1;
+    this->write_frame = (read_frame + FRAMES) % BUFFER_FRAMES;
+  }
 
-    FrameTx.OutputFrame( cur_frame );
+  // Ports shift out LSB first, and TDM slots go MSB first.
+  uint32_t* dst = this->buffer[this->write_frame];
+  for(unsigned ch = 0; ch < MIC_COUNT; ch++){
+#if defined(__XS3A__)
+    asm("bitrev %0, %1" : "=r"(dst[ch]) : "r"(sample[ch]));
+#else
+    uint32_t x = (uint32_t) sample[ch];
+    uint32_t y = 0;
+    for(unsigned b = 0; b < 32; b++, x >>= 1)
+      y = (y << 1) | (x & 1);
+    dst[ch] = y;
+#endif
   }
+
+  this->write_frame = (this->write_frame + 1) % BUFFER_FRAMES;
+}
+
+
+template <unsigned MIC_COUNT, unsigned SLOTS, unsigned FRAMES>
+template <unsigned SAMPLES>
+void mic_array::TdmOutputHandler<MIC_COUNT,SLOTS,FRAMES>::OutputSamples(
+    int32_t (&samples)[SAMPLES][MIC_COUNT])
+{
+  for(unsigned k = 0; k < SAMPLES; k++)
+    this->OutputSample(samples[k]);
 }
 
 
+template <unsigned MIC_COUNT, unsigned SLOTS, unsigned FRAMES>
+unsigned mic_array::TdmOutputHandler<MIC_COUNT,SLOTS,FRAMES>::Slips() const
+{
+  return this->slips;
+}
+
 
 template <unsigned MIC_COUNT, unsigned SAMPLE_COUNT>
 void mic_array::ChannelFrameTransmitter<MIC_COUNT,SAMPLE_COUNT>::SetChannel(
@@ -303,4 +3452,481 @@ void mic_array::ChannelFrameTransmitter<MIC_COUNT,SAMPLE_COUNT>::OutputFrame(
   ma_frame_tx(this->c_frame_out, 
                   reinterpret_cast<int32_t*>(frame), 
                   MIC_COUNT, SAMPLE_COUNT);
-}
\ No newline at end of file
+}
+
+
+template <unsigned MIC_COUNT, unsigned SAMPLE_COUNT>
+void mic_array::ChannelFrameTransmitter<MIC_COUNT,SAMPLE_COUNT>::OutputFrame(
+    const int16_t frame[])
+{
+  ma_frame_tx_s16(this->c_frame_out, frame, MIC_COUNT, SAMPLE_COUNT);
+}
+
+
+template <unsigned MIC_COUNT, unsigned SAMPLE_COUNT>
+void mic_array::ChannelFrameTransmitter<MIC_COUNT,SAMPLE_COUNT>::OutputFrame(
+    const uint8_t frame[])
+{
+  ma_frame_tx_s24(this->c_frame_out, frame, MIC_COUNT, SAMPLE_COUNT);
+}
+
+
+template <unsigned MIC_COUNT, unsigned SAMPLE_COUNT>
+void mic_array::ChannelFrameTransmitter<MIC_COUNT,SAMPLE_COUNT>::OutputFrame(
+    const float frame[])
+{
+  ma_frame_tx_f32(this->c_frame_out, frame, MIC_COUNT, SAMPLE_COUNT);
+}
+
+
+template <unsigned MIC_COUNT, unsigned SAMPLE_COUNT>
+void mic_array::StampedChannelFrameTransmitter<MIC_COUNT,SAMPLE_COUNT>::SetChannel(
+    chanend_t c_frame_out)
+{
+  this->c_frame_out = c_frame_out;
+}
+
+
+template <unsigned MIC_COUNT, unsigned SAMPLE_COUNT>
+chanend_t mic_array::StampedChannelFrameTransmitter<MIC_COUNT,SAMPLE_COUNT>::GetChannel()
+{
+  return this->c_frame_out;
+}
+
+
+template <unsigned MIC_COUNT, unsigned SAMPLE_COUNT>
+void mic_array::StampedChannelFrameTransmitter<MIC_COUNT,SAMPLE_COUNT>::OutputFrame(
+    const ma_frame_header_t& header,
+    int32_t frame[MIC_COUNT][SAMPLE_COUNT])
+{
+  ma_frame_tx_stamped(this->c_frame_out, &header,
+                      reinterpret_cast<int32_t*>(frame), 
+                      MIC_COUNT, SAMPLE_COUNT);
+}
+
+
+template <unsigned MIC_COUNT, unsigned SAMPLE_COUNT>
+void mic_array::SharedMemoryFrameTransmitter<MIC_COUNT,SAMPLE_COUNT>::SetChannel(
+    chanend_t c_frame_out)
+{
+  this->c_frame_out = c_frame_out;
+}
+
+template <unsigned MIC_COUNT, unsigned SAMPLE_COUNT>
+chanend_t mic_array::SharedMemoryFrameTransmitter<MIC_COUNT,SAMPLE_COUNT>::GetChannel()
+{
+  return this->c_frame_out;
+}
+
+
+template <unsigned MIC_COUNT, unsigned SAMPLE_COUNT>
+void mic_array::SharedMemoryFrameTransmitter<MIC_COUNT,SAMPLE_COUNT>::OutputFrame(
+    int32_t frame[MIC_COUNT][SAMPLE_COUNT])
+{
+  this->Drain();
+
+  s_chan_out_word(this->c_frame_out, 
+                  reinterpret_cast<uint32_t>( &frame[0][0] ));
+  this->outstanding = true;
+}
+
+
+template <unsigned MIC_COUNT, unsigned SAMPLE_COUNT>
+void mic_array::SharedMemoryFrameTransmitter<MIC_COUNT,SAMPLE_COUNT>::Drain()
+{
+  if(this->outstanding){
+    (void) s_chan_in_word(this->c_frame_out);
+    this->outstanding = false;
+  }
+}
+
+
+template <unsigned MIC_COUNT, unsigned SAMPLE_COUNT, 
+          unsigned CONSUMERS, unsigned DEPTH>
+bool mic_array::FanOutFrameTransmitter<MIC_COUNT,SAMPLE_COUNT,CONSUMERS,DEPTH>
+    ::AddConsumer(chanend_t c_frame_out)
+{
+  if(this->consumers == CONSUMERS)
+    return false;
+
+  this->c_frame_out[this->consumers] = c_frame_out;
+  this->consumers++;
+  return true;
+}
+
+
+template <unsigned MIC_COUNT, unsigned SAMPLE_COUNT, 
+          unsigned CONSUMERS, unsigned DEPTH>
+unsigned mic_array::FanOutFrameTransmitter<MIC_COUNT,SAMPLE_COUNT,CONSUMERS,DEPTH>
+    ::Consumers() const
+{
+  return this->consumers;
+}
+
+
+template <unsigned MIC_COUNT, unsigned SAMPLE_COUNT, 
+          unsigned CONSUMERS, unsigned DEPTH>
+chanend_t mic_array::FanOutFrameTransmitter<MIC_COUNT,SAMPLE_COUNT,CONSUMERS,DEPTH>
+    ::GetChannel(unsigned consumer) const
+{
+  assert(consumer < this->consumers);
+  return this->c_frame_out[consumer];
+}
+
+
+template <unsigned MIC_COUNT, unsigned SAMPLE_COUNT, 
+          unsigned CONSUMERS, unsigned DEPTH>
+void mic_array::FanOutFrameTransmitter<MIC_COUNT,SAMPLE_COUNT,CONSUMERS,DEPTH>
+    ::Retire()
+{
+  // Consumers release frames in the order they receive them, so the next
+  // token from each is for the oldest outstanding frame. Only once the last
+  // of them is taken is the frame free.
+  for(unsigned k = 0; k < this->consumers; k++)
+    (void) s_chan_in_word(this->c_frame_out[k]);
+  this->outstanding--;
+}
+
+
+template <unsigned MIC_COUNT, unsigned SAMPLE_COUNT, 
+          unsigned CONSUMERS, unsigned DEPTH>
+void mic_array::FanOutFrameTransmitter<MIC_COUNT,SAMPLE_COUNT,CONSUMERS,DEPTH>
+    ::OutputFrame(int32_t frame[MIC_COUNT][SAMPLE_COUNT])
+{
+  if(this->consumers == 0)
+    return;
+
+  if(this->outstanding == DEPTH)
+    this->Retire();
+
+  for(unsigned k = 0; k < this->consumers; k++)
+    s_chan_out_word(this->c_frame_out[k], 
+                    reinterpret_cast<uint32_t>( &frame[0][0] ));
+  this->outstanding++;
+}
+
+
+template <unsigned MIC_COUNT, unsigned SAMPLE_COUNT, 
+          unsigned CONSUMERS, unsigned DEPTH>
+void mic_array::FanOutFrameTransmitter<MIC_COUNT,SAMPLE_COUNT,CONSUMERS,DEPTH>
+    ::Drain()
+{
+  while(this->outstanding)
+    this->Retire();
+}
+
+
+template <unsigned MIC_COUNT, unsigned SAMPLE_COUNT>
+void mic_array::StreamingFrameTransmitter<MIC_COUNT,SAMPLE_COUNT>::SetChannel(
+    chanend_t c_frame_out)
+{
+  this->c_frame_out = c_frame_out;
+}
+
+template <unsigned MIC_COUNT, unsigned SAMPLE_COUNT>
+chanend_t mic_array::StreamingFrameTransmitter<MIC_COUNT,SAMPLE_COUNT>::GetChannel()
+{
+  return this->c_frame_out;
+}
+
+
+template <unsigned MIC_COUNT, unsigned SAMPLE_COUNT>
+void mic_array::StreamingFrameTransmitter<MIC_COUNT,SAMPLE_COUNT>::OutputFrame(
+    int32_t frame[MIC_COUNT][SAMPLE_COUNT])
+{
+  ma_frame_stream_tx(this->c_frame_out, 
+                     reinterpret_cast<int32_t*>(frame), 
+                     MIC_COUNT, SAMPLE_COUNT);
+}
+
+
+template <unsigned MIC_COUNT, unsigned SAMPLE_COUNT>
+void mic_array::StreamingFrameTransmitter<MIC_COUNT,SAMPLE_COUNT>::Drain(
+    unsigned credits)
+{
+  ma_frame_stream_tx_end(this->c_frame_out, credits);
+}
+
+
+template <unsigned MIC_COUNT, unsigned SAMPLE_COUNT, 
+          unsigned FRAME_COUNT, bool OVERWRITE_OLDEST>
+void mic_array::QueuedFrameTransmitter<MIC_COUNT,SAMPLE_COUNT,
+                                       FRAME_COUNT,OVERWRITE_OLDEST>::OutputFrame(
+    int32_t frame[MIC_COUNT][SAMPLE_COUNT])
+{
+  const unsigned h = this->head;
+
+  if(h - this->tail >= FRAME_COUNT){
+    this->overruns = this->overruns + 1;
+    if(!OVERWRITE_OLDEST)
+      return;
+    // Otherwise the slot after the newest holds the oldest frame; the
+    // consumer notices it has been lapped and skips ahead.
+  }
+
+  const unsigned slot = h % FRAME_COUNT;
+
+  // Claim the slot before writing it, so a consumer reading it can tell.
+  // Its sequence number must be odd before the new head is published, or a
+  // consumer which had caught up could take the slot's old frame as new.
+  this->seq[slot] = this->seq[slot] + 1;
+  std::atomic_signal_fence(std::memory_order_seq_cst);
+  this->head = h + 1;
+  // Keep the compiler from moving the copy outside the sequence updates.
+  std::atomic_signal_fence(std::memory_order_seq_cst);
+  memcpy(this->queue[slot], frame, sizeof(this->queue[0]));
+  std::atomic_signal_fence(std::memory_order_seq_cst);
+  this->seq[slot] = this->seq[slot] + 1;
+}
+
+
+template <unsigned MIC_COUNT, unsigned SAMPLE_COUNT, 
+          unsigned FRAME_COUNT, bool OVERWRITE_OLDEST>
+bool mic_array::QueuedFrameTransmitter<MIC_COUNT,SAMPLE_COUNT,
+                                       FRAME_COUNT,OVERWRITE_OLDEST>::TryReceive(
+    int32_t frame[MIC_COUNT][SAMPLE_COUNT])
+{
+  while(1){
+    unsigned t = this->tail;
+    const unsigned h = this->head;
+
+    if(h == t)
+      return false;
+
+    // Skip any frames which have been overwritten.
+    if(h - t > FRAME_COUNT)
+      t = h - FRAME_COUNT;
+
+    const unsigned slot = t % FRAME_COUNT;
+    const unsigned before = this->seq[slot];
+
+    // Still being written (by the producer's newest frame)
+    if(before & 1){
+      if(h - t == 1) 
+        return false;
+      continue;
+    }
+
+    std::atomic_signal_fence(std::memory_order_seq_cst);
+    memcpy(frame, this->queue[slot], sizeof(this->queue[0]));
+    std::atomic_signal_fence(std::memory_order_seq_cst);
+
+    // If the slot has since been (or is being) rewritten, the copy may be
+    // torn, so start again from the new oldest frame.
+    if(this->seq[slot] != before || this->head - t > FRAME_COUNT)
+      continue;
+
+    this->tail = t + 1;
+    return true;
+  }
+}
+
+
+template <unsigned MIC_COUNT, unsigned SAMPLE_COUNT, 
+          unsigned FRAME_COUNT, bool OVERWRITE_OLDEST>
+void mic_array::QueuedFrameTransmitter<MIC_COUNT,SAMPLE_COUNT,
+                                       FRAME_COUNT,OVERWRITE_OLDEST>::Receive(
+    int32_t frame[MIC_COUNT][SAMPLE_COUNT])
+{
+  while(!this->TryReceive(frame));
+}
+
+
+template <unsigned MIC_COUNT, unsigned SAMPLE_COUNT, 
+          unsigned FRAME_COUNT, bool OVERWRITE_OLDEST>
+unsigned mic_array::QueuedFrameTransmitter<MIC_COUNT,SAMPLE_COUNT,
+                                           FRAME_COUNT,OVERWRITE_OLDEST>::Pending() const
+{
+  const unsigned pending = this->head - this->tail;
+  return (pending > FRAME_COUNT)? FRAME_COUNT : pending;
+}
+
+
+template <unsigned MIC_COUNT, unsigned SAMPLE_COUNT, 
+          unsigned FRAME_COUNT, bool OVERWRITE_OLDEST>
+unsigned mic_array::QueuedFrameTransmitter<MIC_COUNT,SAMPLE_COUNT,
+                                           FRAME_COUNT,OVERWRITE_OLDEST>::Overruns() const
+{
+  return this->overruns;
+}
+
+
+template <unsigned MIC_COUNT, unsigned SAMPLE_COUNT, 
+          unsigned CAPACITY, bool SAMPLE_MAJOR>
+void mic_array::RingBufferFrameTransmitter<MIC_COUNT,SAMPLE_COUNT,
+                                           CAPACITY,SAMPLE_MAJOR>::OutputFrame(
+    int32_t frame[MIC_COUNT][SAMPLE_COUNT])
+{
+  const unsigned h = this->head;
+
+  if(CAPACITY - (h - this->tail) < SAMPLE_COUNT){
+    this->overruns = this->overruns + 1;
+    return;
+  }
+
+  const int32_t* src = &frame[0][0];
+  for(unsigned s = 0; s < SAMPLE_COUNT; s++){
+    int32_t* dst = this->ring[(h + s) & (CAPACITY - 1)];
+    for(unsigned m = 0; m < MIC_COUNT; m++)
+      dst[m] = SAMPLE_MAJOR? src[s * MIC_COUNT + m] : src[m * SAMPLE_COUNT + s];
+  }
+
+  // Keep the compiler from publishing the samples before they are written.
+  std::atomic_signal_fence(std::memory_order_seq_cst);
+  this->head = h + SAMPLE_COUNT;
+}
+
+
+template <unsigned MIC_COUNT, unsigned SAMPLE_COUNT, 
+          unsigned CAPACITY, bool SAMPLE_MAJOR>
+bool mic_array::RingBufferFrameTransmitter<MIC_COUNT,SAMPLE_COUNT,
+                                           CAPACITY,SAMPLE_MAJOR>::PopSample(
+    int32_t sample[MIC_COUNT])
+{
+  const unsigned t = this->tail;
+
+  if(this->head == t){
+    this->underruns = this->underruns + 1;
+    return false;
+  }
+
+  std::atomic_signal_fence(std::memory_order_seq_cst);
+  const int32_t* src = this->ring[t & (CAPACITY - 1)];
+  for(unsigned m = 0; m < MIC_COUNT; m++)
+    sample[m] = src[m];
+  // Keep the compiler from freeing the slot before it is read.
+  std::atomic_signal_fence(std::memory_order_seq_cst);
+
+  this->tail = t + 1;
+  return true;
+}
+
+
+template <unsigned MIC_COUNT, unsigned SAMPLE_COUNT, 
+          unsigned CAPACITY, bool SAMPLE_MAJOR>
+unsigned mic_array::RingBufferFrameTransmitter<MIC_COUNT,SAMPLE_COUNT,
+                                               CAPACITY,SAMPLE_MAJOR>::Available() const
+{
+  return this->head - this->tail;
+}
+
+
+template <unsigned MIC_COUNT, unsigned SAMPLE_COUNT, 
+          unsigned CAPACITY, bool SAMPLE_MAJOR>
+unsigned mic_array::RingBufferFrameTransmitter<MIC_COUNT,SAMPLE_COUNT,
+                                               CAPACITY,SAMPLE_MAJOR>::Overruns() const
+{
+  return this->overruns;
+}
+
+
+template <unsigned MIC_COUNT, unsigned SAMPLE_COUNT, 
+          unsigned CAPACITY, bool SAMPLE_MAJOR>
+unsigned mic_array::RingBufferFrameTransmitter<MIC_COUNT,SAMPLE_COUNT,
+                                               CAPACITY,SAMPLE_MAJOR>::Underruns() const
+{
+  return this->underruns;
+}
+
+
+template <unsigned MIC_COUNT, unsigned SAMPLE_COUNT, 
+          template <unsigned, unsigned> class FrameTransmitter,
+          unsigned PREROLL_FRAMES>
+void mic_array::GatedFrameTransmitter<MIC_COUNT,SAMPLE_COUNT,
+                                      FrameTransmitter,PREROLL_FRAMES>::SetLevels(
+    uint64_t open_level,
+    uint64_t close_level,
+    unsigned hangover)
+{
+  assert(close_level <= open_level);
+  this->open_level = open_level;
+  this->close_level = close_level;
+  this->hangover = hangover;
+}
+
+
+template <unsigned MIC_COUNT, unsigned SAMPLE_COUNT, 
+          template <unsigned, unsigned> class FrameTransmitter,
+          unsigned PREROLL_FRAMES>
+void mic_array::GatedFrameTransmitter<MIC_COUNT,SAMPLE_COUNT,
+                                      FrameTransmitter,PREROLL_FRAMES>::OutputFrame(
+    int32_t frame[MIC_COUNT][SAMPLE_COUNT])
+{
+  uint64_t sum = 0;
+  for(unsigned k = 0; k < MIC_COUNT; k++){
+    for(unsigned s = 0; s < SAMPLE_COUNT; s++){
+      const int32_t x = frame[k][s] >> 8;
+      sum += (uint64_t) ((int64_t) x * x);
+    }
+  }
+  this->energy = sum / (MIC_COUNT * SAMPLE_COUNT);
+
+  if(this->open){
+    if(this->energy >= this->close_level)
+      this->quiet = 0;
+    else if(this->quiet < this->hangover)
+      this->quiet++;
+    else
+      this->open = false;
+  } else if(this->energy >= this->open_level) {
+    this->open = true;
+    this->quiet = 0;
+
+    // Pass on the pre-roll, oldest first.
+    for(unsigned f = this->preroll_count; f > 0; f--){
+      const unsigned slot = (this->preroll_head + PREROLL_BUFFERS - f) 
+                          % PREROLL_BUFFERS;
+      Inner.OutputFrame(this->preroll[slot]);
+    }
+    this->preroll_count = 0;
+  }
+
+  if(this->open){
+    Inner.OutputFrame(frame);
+    return;
+  }
+
+  if(PREROLL_FRAMES == 0){
+    this->suppressed++;
+    return;
+  }
+
+  if(this->preroll_count == PREROLL_FRAMES)
+    this->suppressed++;
+  else
+    this->preroll_count++;
+
+  memcpy(this->preroll[this->preroll_head], frame, sizeof(this->preroll[0]));
+  this->preroll_head = (this->preroll_head + 1 == PREROLL_BUFFERS)? 0 
+                                                  : (this->preroll_head + 1);
+}
+
+
+template <unsigned MIC_COUNT, unsigned SAMPLE_COUNT, 
+          template <unsigned, unsigned> class FrameTransmitter,
+          unsigned PREROLL_FRAMES>
+bool mic_array::GatedFrameTransmitter<MIC_COUNT,SAMPLE_COUNT,
+                                      FrameTransmitter,PREROLL_FRAMES>::IsOpen() const
+{
+  return this->open;
+}
+
+
+template <unsigned MIC_COUNT, unsigned SAMPLE_COUNT, 
+          template <unsigned, unsigned> class FrameTransmitter,
+          unsigned PREROLL_FRAMES>
+uint64_t mic_array::GatedFrameTransmitter<MIC_COUNT,SAMPLE_COUNT,
+                                          FrameTransmitter,PREROLL_FRAMES>::Energy() const
+{
+  return this->energy;
+}
+
+
+template <unsigned MIC_COUNT, unsigned SAMPLE_COUNT, 
+          template <unsigned, unsigned> class FrameTransmitter,
+          unsigned PREROLL_FRAMES>
+unsigned mic_array::GatedFrameTransmitter<MIC_COUNT,SAMPLE_COUNT,
+                                          FrameTransmitter,PREROLL_FRAMES>::Suppressed() const
+{
+  return this->suppressed;
+}
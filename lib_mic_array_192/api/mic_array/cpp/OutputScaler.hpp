@@ -0,0 +1,173 @@
+// Copyright 2022-2024 XMOS LIMITED.
+// This Software is subject to the terms of the XMOS Public Licence: Version 1.
+
+#pragma once
+
+#include <cstdint>
+
+#include "xmath/xmath.h"
+
+
+namespace  mic_array {
+
+  /**
+   * @brief Final output shift of a decimator, with optional saturation and
+   *        a count of the samples which clipped.
+   *
+   * A decimator applies this to each batch of its output samples, before
+   * its sample filter. Each sample is shifted left by @ref Shift() bits (or
+   * right, if negative), which sets the decimator's output gain in 6 dB
+   * steps, e.g. to recover headroom for microphones driven close to their
+   * acoustic overload point.
+   *
+   * With saturation enabled (the default) the shift is done on the VPU, with
+   * `vect_s32_shl()` (or in portable C when not built for xcore.ai), and
+   * samples which do not fit are saturated to `[-INT32_MAX, INT32_MAX]`.
+   * The VPU shift reports the headroom of its result, so only a batch with
+   * no headroom at all is searched for samples at those limits, each of
+   * which adds one to @ref ClippedSamples(). A sample which already sat at a limit before the shift (e.g. one
+   * saturated by the stage 2 filter) is counted too.
+   *
+   * With saturation disabled the samples are shifted on the CPU, and a
+   * sample which does not fit wraps. This is only safe when the filters'
+   * gain leaves enough headroom for the shift, and nothing is counted.
+   *
+   * @ref ClippedSamples() may be read from any thread on the same tile.
+   */
+  class OutputScaler
+  {
+    private:
+
+      /**
+       * Output left-shift.
+       */
+      left_shift_t shl;
+
+      /**
+       * Whether the shift saturates.
+       */
+      bool saturate = true;
+
+      /**
+       * Number of samples at the saturation limits since the last reset.
+       */
+      volatile unsigned clipped = 0;
+
+    public:
+
+      /**
+       * @brief Create an output scaler.
+       *
+       * @param shl Output left-shift. May be negative.
+       */
+      constexpr OutputScaler(
+          const left_shift_t shl = 0) noexcept : shl(shl) { }
+
+      /**
+       * @brief Set the output shift.
+       *
+       * @param shl       Output left-shift. May be negative.
+       * @param saturate  Whether samples which do not fit are saturated (and
+       *                  counted) rather than left to wrap.
+       */
+      void SetShift(
+          const left_shift_t shl,
+          const bool saturate = true);
+
+      /**
+       * @brief Get the output shift.
+       */
+      left_shift_t Shift() const;
+
+      /**
+       * @brief Get the number of samples at the saturation limits since the
+       *        last @ref ResetClippedSamples().
+       *
+       * Counts each channel's samples separately. Always `0` with
+       * saturation disabled.
+       */
+      unsigned ClippedSamples() const;
+
+      /**
+       * @brief Reset @ref ClippedSamples() to `0`.
+       */
+      void ResetClippedSamples();
+
+      /**
+       * @brief Shift a batch of samples in place.
+       *
+       * @param samples Samples to be shifted. Word-aligned.
+       * @param count   Number of samples.
+       */
+      void Apply(
+          int32_t samples[],
+          const unsigned count);
+  };
+
+}
+
+//////////////////////////////////////////////
+// Template function implementations below. //
+//////////////////////////////////////////////
+
+
+inline
+void mic_array::OutputScaler::SetShift(
+    const left_shift_t shl,
+    const bool saturate)
+{
+  this->shl = shl;
+  this->saturate = saturate;
+}
+
+
+inline
+left_shift_t mic_array::OutputScaler::Shift() const
+{
+  return this->shl;
+}
+
+
+inline
+unsigned mic_array::OutputScaler::ClippedSamples() const
+{
+  return this->clipped;
+}
+
+
+inline
+void mic_array::OutputScaler::ResetClippedSamples()
+{
+  this->clipped = 0;
+}
+
+
+inline
+void mic_array::OutputScaler::Apply(
+    int32_t samples[],
+    const unsigned count)
+{
+  if(this->saturate){
+#if defined(__XS3A__)
+    // Any sample at a limit leaves the batch without headroom.
+    if(vect_s32_shl(samples, samples, count, this->shl) != 0)
+      return;
+#else
+    for(unsigned k = 0; k < count; k++){
+      const int64_t y = (this->shl >= 0)? ((int64_t) samples[k]) << this->shl
+                                        : samples[k] >> (-this->shl);
+      samples[k] = (y > INT32_MAX)? INT32_MAX : (y < -INT32_MAX)? -INT32_MAX : y;
+    }
+#endif
+    unsigned clips = 0;
+    for(unsigned k = 0; k < count; k++)
+      clips += (samples[k] == INT32_MAX) || (samples[k] == -INT32_MAX);
+    this->clipped = this->clipped + clips;
+  } else if(this->shl >= 0) {
+    for(unsigned k = 0; k < count; k++)
+      samples[k] = (int32_t) (((uint32_t) samples[k]) << this->shl);
+  } else {
+    for(unsigned k = 0; k < count; k++)
+      samples[k] = samples[k] >> (-this->shl);
+  }
+}
@@ -0,0 +1,220 @@
+// Copyright 2022-2024 XMOS LIMITED.
+// This Software is subject to the terms of the XMOS Public Licence: Version 1.
+
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+
+#include "xmath/xmath.h"
+
+// This has caused problems previously, so just catch the problems here.
+#if defined(CHANNELS) || defined(STEPS)
+# error Application must not define the following as precompiler macros: CHANNELS, STEPS.
+#endif
+
+namespace  mic_array {
+
+  /**
+   * @brief Stage 1 PDM history for several channels, updated without copying.
+   * 
+   * The first stage filters operate on an 8-word window of PDM history per
+   * channel, with the newest PDM word in the window's first word. Rather than
+   * shifting all 8 words of the window each time a PDM word arrives, each
+   * channel's history is a buffer of `STEPS + 8` words in which the window
+   * slides one word towards the front of the buffer on each @ref Advance().
+   * Only once every `STEPS` calls is the window moved back to the end of the
+   * buffer, with a single 8-word vector copy per channel.
+   * 
+   * All channels share the window position, so the windows of consecutive
+   * channels are always @ref Stride words apart, and can be passed to
+   * `fir_1x16_bit_multi()` in place.
+   * 
+   * @tparam CHANNELS Number of channels of history.
+   * @tparam STEPS    @parblock
+   * Number of words the window can slide before it must be moved back. Costs
+   * `STEPS` words of memory per channel. Decimators which consume `N` PDM
+   * words per channel in each block will usually use `STEPS = N`, so that
+   * the copy happens once per block.
+   * @endparblock
+   */
+  template <unsigned CHANNELS, unsigned STEPS>
+  class PdmHistory
+  {
+    static_assert(STEPS >= 1, "STEPS must be at least 1.");
+
+    public:
+
+      /**
+       * Distance, in words, between consecutive channels' windows.
+       */
+      static constexpr unsigned Stride = STEPS + 8;
+
+    private:
+
+      /**
+       * Index of the window's first (newest) word in each channel's buffer.
+       */
+      unsigned pos = STEPS;
+
+      /**
+       * History buffers.
+       */
+      uint32_t WORD_ALIGNED buff[CHANNELS][Stride]
+#if !defined(__DOXYGEN__) && defined(__clang__) // doxygen breaks if it encounters this.
+      // Must be initialized in this way. Initializing the history values in the
+      // constructor causes an XCore-specific problem. Specifically, if the
+      // MicArray instance where this history is used is declared outside of a
+      // function scope (that is, as a global- or module-scope object; which it
+      // ordinarily will be), initializing the PDM history within the
+      // constructor forces the compiler to allocate the object on _all tiles_.
+      // Being allocated on a tile where it is not used does not by itself break
+      // anything, but it does result in less memory being available for other
+      // things on that tile. Initializing the history in this way prevents
+      // that. (GCC, which host builds may use, has no range designators, so
+      // there the constructor fills the history instead.)
+        = {[0 ... (CHANNELS-1)] = { [0 ... (Stride-1)] = 0x55555555 } }
+#endif
+      ;
+
+    public:
+
+#if defined(__clang__) || defined(__DOXYGEN__)
+      constexpr PdmHistory() noexcept {}
+#else
+      PdmHistory() noexcept
+      {
+        for(unsigned ch = 0; ch < CHANNELS; ch++)
+          for(unsigned k = 0; k < Stride; k++)
+            this->buff[ch][k] = 0x55555555;
+      }
+#endif
+
+      /**
+       * @brief Make room for a new PDM word in each channel's window.
+       * 
+       * The window of each channel moves one word back in time; the window's
+       * first word must then be filled in with @ref Set() before the window
+       * is used.
+       */
+      void Advance();
+
+      /**
+       * @brief Set the newest word in a channel's window.
+       * 
+       * @param channel Channel index.
+       * @param word    New PDM word.
+       */
+      void Set(unsigned channel, uint32_t word);
+
+      /**
+       * @brief Get a channel's current 8-word window.
+       * 
+       * The returned pointer is only valid until the next call to
+       * @ref Advance().
+       * 
+       * @param channel Channel index.
+       * 
+       * @returns Pointer to the window's first (newest) word.
+       */
+      uint32_t* Window(unsigned channel);
+
+      /**
+       * @brief Fill a channel's history with a single PDM word.
+       * 
+       * Every word of the channel's history, including its current window,
+       * is set to `word`, as though `word` had been repeated indefinitely.
+       * 
+       * @param channel Channel index.
+       * @param word    PDM word.
+       */
+      void Fill(unsigned channel, uint32_t word);
+
+      /**
+       * @brief Copy a channel's current 8-word window out.
+       * 
+       * @param channel Channel index.
+       * @param window  Destination, newest word first.
+       */
+      void Save(unsigned channel, uint32_t window[8]) const;
+
+      /**
+       * @brief Replace a channel's current 8-word window.
+       * 
+       * The inverse of @ref Save().
+       * 
+       * @param channel Channel index.
+       * @param window  New window, newest word first.
+       */
+      void Load(unsigned channel, const uint32_t window[8]);
+  };
+
+}
+
+//////////////////////////////////////////////
+// Template function implementations below. //
+//////////////////////////////////////////////
+
+
+template <unsigned CHANNELS, unsigned STEPS>
+void mic_array::PdmHistory<CHANNELS,STEPS>::Advance()
+{
+  if(this->pos == 0){
+    for(unsigned ch = 0; ch < CHANNELS; ch++){
+      uint32_t* src = &this->buff[ch][0];
+      uint32_t* dst = &this->buff[ch][STEPS];
+#if defined(__XS3A__)
+      asm volatile("vldd %0[0]; vstd %1[0];" :: "r"(src), "r"(dst) : "memory" );
+#else
+      std::memmove(dst, src, 8 * sizeof(uint32_t));
+#endif
+    }
+    this->pos = STEPS;
+  }
+  this->pos--;
+}
+
+
+template <unsigned CHANNELS, unsigned STEPS>
+void mic_array::PdmHistory<CHANNELS,STEPS>::Set(
+    unsigned channel, 
+    uint32_t word)
+{
+  this->buff[channel][this->pos] = word;
+}
+
+
+template <unsigned CHANNELS, unsigned STEPS>
+uint32_t* mic_array::PdmHistory<CHANNELS,STEPS>::Window(
+    unsigned channel)
+{
+  return &this->buff[channel][this->pos];
+}
+
+
+template <unsigned CHANNELS, unsigned STEPS>
+void mic_array::PdmHistory<CHANNELS,STEPS>::Fill(
+    unsigned channel,
+    uint32_t word)
+{
+  for(unsigned k = 0; k < Stride; k++)
+    this->buff[channel][k] = word;
+}
+
+
+template <unsigned CHANNELS, unsigned STEPS>
+void mic_array::PdmHistory<CHANNELS,STEPS>::Save(
+    unsigned channel,
+    uint32_t window[8]) const
+{
+  std::memcpy(window, &this->buff[channel][this->pos], 8 * sizeof(uint32_t));
+}
+
+
+template <unsigned CHANNELS, unsigned STEPS>
+void mic_array::PdmHistory<CHANNELS,STEPS>::Load(
+    unsigned channel,
+    const uint32_t window[8])
+{
+  std::memcpy(&this->buff[channel][this->pos], window, 8 * sizeof(uint32_t));
+}
@@ -6,13 +6,16 @@
 #include <cstdint>
 #include <string>
 #include <cassert>
+#include <type_traits>
 
 #include <xcore/interrupt.h>
 #include <xcore/channel_streaming.h>
 #include <xcore/port.h>
+#include <xcore/hwtimer.h>
 
 #include "mic_array.h"
 #include "Util.hpp"
+#include "Mips.hpp"
 
 // This has caused problems previously, so just catch the problems here.
 #if defined(BLOCK_SIZE) || defined(CHANNELS_IN) || defined(CHANNELS_OUT) || defined(SUBBLOCKS)
@@ -128,6 +131,52 @@ extern "C" {
      * have been quietly dropped.
      */
     unsigned missed_blocks;
+
+    /**
+     * Number of blocks dropped for lack of credit, counted whatever the value
+     * of `missed_blocks`. See @ref mic_array::PdmRxStats.
+     */
+    unsigned dropped_blocks;
+
+    /**
+     * Lowest value of `credit` seen after sending a block.
+     */
+    unsigned min_credit;
+
+    /**
+     * Number of blocks sent on `c_pdm_data`.
+     */
+    unsigned sent;
+
+    /**
+     * Reference time at which each of the last two blocks was sent, indexed
+     * by `sent % 2`.
+     */
+    uint32_t send_time[2];
+
+    /**
+     * Reference time at which the first word of the block currently being
+     * captured was read from the port.
+     */
+    uint32_t block_start;
+
+    /**
+     * `block_start` of each of the last two blocks sent, indexed by
+     * `sent % 2`.
+     */
+    uint32_t start_time[2];
+
+    /**
+     * Number of blocks captured, whether sent or dropped.
+     */
+    unsigned captured;
+
+    /**
+     * Value of `captured` before each of the last two blocks sent was
+     * counted, i.e. the index of the block among all blocks captured, indexed
+     * by `sent % 2`.
+     */
+    unsigned block_index[2];
   } pdm_rx_isr_context_t;
 
   /**
@@ -163,11 +212,437 @@ extern "C" {
         : "r11" );
   }
 
+  /**
+   * @brief Configure port to use `pdm_rx_isr_dual` as an interrupt routine.
+   * 
+   * As `enable_pdm_rx_isr()`, but with the dual-issue variant of the PDM rx
+   * ISR, which uses the same `pdm_rx_isr_context` and behaves identically.
+   * Its per-word path is shorter, which matters most with short blocks
+   * (e.g. `SUBBLOCKS` of `1`), where the ISR runs many times per block.
+   * 
+   * @ref mic_array::StandardPdmRxService does not install it yet; it is
+   * compared with `pdm_rx_isr` block for block by the `pdm_rx_isr_dual` unit
+   * tests.
+   * 
+   * This function does NOT unmask interrupts.
+   * 
+   * @param p_pdm_mics Port resource to enable ISR on.
+   */
+  static inline 
+  void enable_pdm_rx_isr_dual(
+      const port_t p_pdm_mics)
+  {
+    asm volatile(
+      "setc res[%0], %1           \n"
+      "ldap r11, pdm_rx_isr_dual  \n"
+      "setv res[%0], r11          \n"
+      "eeu res[%0]                  "
+        :
+        : "r"(p_pdm_mics), "r"(XS1_SETC_IE_MODE_INTERRUPT)
+        : "r11" );
+  }
+
+  /**
+   * @brief Shared memory hand-off of PDM blocks to the decimation thread.
+   * 
+   * Used by @ref mic_array::SharedMemPdmRxService in place of the streaming
+   * channel (and credit) of @ref pdm_rx_isr_context_t. The PDM rx ISR (or
+   * thread) is the only writer of `published` and `ring[]`, and the
+   * decimation thread is the only writer of `consumed`, so no critical
+   * section is needed on either side.
+   * 
+   * There are `depth` PDM buffers, filled in turn. Each completed block is
+   * stored in `ring[published % depth]`, after which `published` is
+   * incremented. The decimation thread waits for `published` to change and
+   * then takes the block from the ring, and increments `consumed` once it no
+   * longer needs the block's buffer.
+   * 
+   * A block is only published if fewer than `depth-1` published blocks are
+   * then unconsumed, so the buffer filled next never holds a block the
+   * decimation thread has yet to take. Otherwise the block is dropped (see
+   * `missed_blocks`) and its buffer refilled. Up to `depth-1` blocks can
+   * therefore wait for the decimation thread.
+   */
+  typedef struct {
+
+    /** 
+     * Port on which PDM samples are received. 
+     */
+    port_t p_pdm_mics;
+
+    /** 
+     * Buffer currently being filled with captured PDM samples.
+     */
+    uint32_t* pdm_buffer;
+
+    /** 
+     * The `depth` consecutive buffers, `block_words` words each, used for
+     * storing captured PDM samples.
+     */
+    uint32_t* buffers;
+
+    /**
+     * Number of port reads left for the buffer currently being filled.
+     */
+    unsigned phase;
+
+    /**
+     * The number of words to read from `p_pdn_mics` to fill a buffer.
+     */
+    unsigned phase_reset;
+
+    /**
+     * Number of blocks published to the decimation thread.
+     */
+    volatile unsigned published;
+
+    /**
+     * Number of blocks the decimation thread has finished with.
+     */
+    volatile unsigned consumed;
+
+    /**
+     * The `depth` most recently published blocks.
+     */
+    uint32_t* volatile * ring;
+
+    /**
+     * Number of PDM buffers and ring slots.
+     */
+    unsigned depth;
+
+    /**
+     * Number of words in each PDM buffer.
+     */
+    unsigned block_words;
+
+    /**
+     * Controls and records what happens when a block cannot be published,
+     * as @ref pdm_rx_isr_context_t::missed_blocks.
+     */
+    unsigned missed_blocks;
+
+    /**
+     * Reference time at which each block in `ring` was published.
+     */
+    volatile uint32_t* send_times;
+
+    /**
+     * Number of blocks dropped, counted whatever the value of
+     * `missed_blocks`. See @ref mic_array::PdmRxStats.
+     */
+    unsigned dropped_blocks;
+
+    /**
+     * Most published blocks seen waiting to be consumed.
+     */
+    unsigned max_backlog;
+  } pdm_rx_shmem_context_t;
+
+  /**
+   * Configuration and context of the PDM rx ISR when @ref
+   * mic_array::SharedMemPdmRxService is used. 
+   * 
+   * `pdm_rx_shmem_isr` (`pdm_rx_shmem_isr.S`) directly allocates this object.
+   * It is also used when that service runs as a thread.
+   */
+  extern pdm_rx_shmem_context_t pdm_rx_shmem_isr_context;
+
+  /**
+   * @brief Configure port to use `pdm_rx_shmem_isr` as an interrupt routine.
+   * 
+   * As @ref enable_pdm_rx_isr(), but for @ref mic_array::SharedMemPdmRxService.
+   * 
+   * This function does NOT unmask interrupts.
+   * 
+   * @param p_pdm_mics Port resource to enable ISR on.
+   */
+  static inline 
+  void enable_pdm_rx_shmem_isr(
+      const port_t p_pdm_mics)
+  {
+    asm volatile(
+      "setc res[%0], %1             \n"
+      "ldap r11, pdm_rx_shmem_isr   \n"
+      "setv res[%0], r11            \n"
+      "eeu res[%0]                    "
+        :
+        : "r"(p_pdm_mics), "r"(XS1_SETC_IE_MODE_INTERRUPT)
+        : "r11" );
+  }
+
 }
 
 
+/**
+ * Number of blocks over which @ref mic_array::PdmRxSlack::recent_min_idle
+ * is taken.
+ */
+#ifndef MIC_ARRAY_SLACK_WINDOW_BLOCKS
+# define MIC_ARRAY_SLACK_WINDOW_BLOCKS    (256)
+#endif
+
+
+/**
+ * Number of PDM words of each channel over which 
+ * @ref mic_array::PdmHealthMonitor judges the channel's health.
+ */
+#ifndef MIC_ARRAY_HEALTH_WINDOW_WORDS
+# define MIC_ARRAY_HEALTH_WINDOW_WORDS    (1024)
+#endif
+
+
 namespace  mic_array {
 
+  /**
+   * @brief Number of PDM words of each microphone in a block delivered by a
+   *        PDM rx service.
+   * 
+   * A PDM rx service which delivers mic-major blocks, `[MIC_COUNT][SUBBLOCKS]`
+   * (e.g. @ref StandardPdmRxService), advertises this with a
+   * `static constexpr unsigned SubBlocks` member. @ref MicArray uses it to
+   * tell whether each block holds a whole output frame.
+   * 
+   * `value` is `TPdmRx::SubBlocks` if that member exists, and `0` otherwise.
+   * 
+   * @tparam TPdmRx PDM rx service type.
+   */
+  template <class TPdmRx, class = void>
+  struct PdmRxSubBlocks 
+      : std::integral_constant<unsigned, 0> { };
+
+  template <class TPdmRx>
+  struct PdmRxSubBlocks<TPdmRx, decltype((void) TPdmRx::SubBlocks)>
+      : std::integral_constant<unsigned, TPdmRx::SubBlocks> { };
+
+  /**
+   * @brief Statistics of the hand-off of PDM blocks to the decimation thread.
+   * 
+   * Returned by `GetStats()` of @ref StandardPdmRxService and
+   * @ref SharedMemPdmRxService. Every field is a single word updated by
+   * exactly one execution context, so these may be read from any thread on
+   * the same tile while the mic array is running, e.g. to correlate audio
+   * glitches with CPU load.
+   */
+  struct PdmRxStats {
+    /**
+     * Number of blocks returned by `GetPdmBlock()`.
+     */
+    unsigned blocks;
+
+    /**
+     * Number of blocks dropped because the decimation thread had fallen
+     * behind. Counted whether or not dropping a block raises an exception
+     * (see `AssertOnDroppedBlock()`).
+     */
+    unsigned dropped_blocks;
+
+    /**
+     * Most blocks seen handed over but not yet taken by the decimation
+     * thread, including the one just handed over. A value which reaches the
+     * service's capacity (2 for @ref StandardPdmRxService; `BUFFER_DEPTH-1`
+     * for @ref SharedMemPdmRxService) means the next late block will be
+     * dropped. Only tracked in interrupt mode for @ref StandardPdmRxService.
+     */
+    unsigned max_backlog;
+
+    /**
+     * Longest time, in reference clock ticks, between a block being handed
+     * over by the PDM rx ISR (or thread) and `GetPdmBlock()` returning it.
+     */
+    uint32_t max_latency;
+  };
+
+
+  /**
+   * @brief How long the decimation thread waits for each PDM block, compared
+   *        to the block period.
+   * 
+   * Returned by `GetSlack()` of @ref StandardPdmRxService. The idle time of a
+   * block is how long `GetPdmBlock()` waited for it to arrive, which is the
+   * time the decimation thread had to spare in the previous block period. As
+   * it approaches zero, the thread is about to fall behind; once it is zero
+   * the block was already waiting, and `PdmRxStats::max_latency` shows by how
+   * much the thread was late. All times are in reference clock ticks.
+   */
+  struct PdmRxSlack {
+    /**
+     * Time between the last two blocks being handed over. `0` until two
+     * blocks have been received.
+     */
+    uint32_t block_period;
+
+    /**
+     * Idle time before the latest block.
+     */
+    uint32_t last_idle;
+
+    /**
+     * Least idle time over the last complete window of
+     * @ref MIC_ARRAY_SLACK_WINDOW_BLOCKS blocks. `UINT32_MAX` until a window
+     * has completed.
+     */
+    uint32_t recent_min_idle;
+
+    /**
+     * Least idle time since the service was initialized or its statistics
+     * were last reset. `UINT32_MAX` if no block has been received since.
+     */
+    uint32_t min_idle;
+  };
+
+
+  /**
+   * @brief Position in time of a PDM block.
+   * 
+   * Returned by `GetBlockStamp()` of @ref StandardPdmRxService, for the block
+   * most recently returned by `GetPdmBlock()`. @ref MicArray passes it on to
+   * an output handler which supports it (see 
+   * @ref FrameOutputHandler::SetBlockStamp()).
+   */
+  struct PdmBlockStamp {
+    /**
+     * Index of the block among all blocks captured since the service was
+     * initialized, counting any dropped blocks. A jump of more than one
+     * between consecutive blocks means blocks were dropped.
+     */
+    unsigned block_index;
+
+    /**
+     * Reference time at which the first word of the block was read from the
+     * port.
+     */
+    uint32_t timestamp;
+  };
+
+
+
+  /**
+   * @brief Health of the PDM channels, judged from their 1-bit data.
+   * 
+   * Returned by `GetHealth()` of @ref StandardPdmRxService (see
+   * @ref PdmHealthMonitor). Bit `k` of each mask refers to output channel
+   * `k`, and reflects the channel's last complete window. Every field is a
+   * single word updated by the decimation thread, so these may be read from
+   * any thread on the same tile.
+   */
+  struct PdmHealth {
+    /**
+     * Channels whose data was (almost) all `0`: a mic without power, or a
+     * pin not driven.
+     */
+    uint32_t stuck_low;
+
+    /**
+     * Channels whose data was (almost) all `1`.
+     */
+    uint32_t stuck_high;
+
+    /**
+     * Channels whose data toggled on (almost) every PDM clock, i.e. a fixed
+     * `0101...` pattern with none of the variation of a live modulator, as
+     * output by some mics which are not running.
+     */
+    uint32_t toggling;
+
+    /**
+     * Number of windows judged, across all channels.
+     */
+    unsigned windows;
+  };
+
+
+  /**
+   * @brief Judges the health of PDM channels from the density of ones and
+   *        of transitions in their 1-bit data.
+   * 
+   * The data of a live PDM mic has a density of ones which follows the 
+   * signal, about half at rest, and a transition density which varies as
+   * the modulator shapes its noise. A mic which has failed or come loose
+   * instead gives data stuck at `0` or `1`, or a perfectly regular
+   * `0101...` pattern. These are told apart by counting bits in the PDM
+   * words, long before a downstream analysis of the decimated audio would
+   * notice.
+   * 
+   * To keep the cost per block low, each call to @ref Update() examines only
+   * one channel's `SUBBLOCKS` words of the block, taking the channels in 
+   * turn. Each channel is judged once it has been examined for
+   * @ref MIC_ARRAY_HEALTH_WINDOW_WORDS words, and its bits of 
+   * @ref PdmHealth updated. A channel is flagged if, over its window, fewer
+   * than `1/64` or more than `63/64` of its bits are `1`, or more than 
+   * `63/64` of adjacent bit pairs within a word differ.
+   * 
+   * @tparam CHANNELS   Number of channels, at most `32`.
+   * @tparam SUBBLOCKS  Number of PDM words of each channel in a block.
+   */
+  template <unsigned CHANNELS, unsigned SUBBLOCKS>
+  class PdmHealthMonitor
+  {
+    static_assert(CHANNELS >= 1 && CHANNELS <= 32, 
+                  "CHANNELS must be between 1 and 32.");
+
+    private:
+
+      /**
+       * @brief Next channel to be examined.
+       */
+      unsigned channel = 0;
+
+      /**
+       * @brief Words of each channel examined in its current window.
+       */
+      unsigned words[CHANNELS] = {0};
+
+      /**
+       * @brief Ones counted in each channel's current window.
+       */
+      unsigned ones[CHANNELS] = {0};
+
+      /**
+       * @brief Transitions counted in each channel's current window.
+       */
+      unsigned transitions[CHANNELS] = {0};
+
+      /**
+       * @brief Health as reported by @ref Get().
+       */
+      volatile PdmHealth health = {0, 0, 0, 0};
+
+      /**
+       * @brief Number of `1` bits in a word.
+       */
+      static inline unsigned PopCount(uint32_t x);
+
+      /**
+       * @brief Judge a channel's complete window, and start the next.
+       */
+      void Judge(unsigned ch);
+
+    public:
+
+      /**
+       * @brief Examine the next channel's data in a block.
+       * 
+       * @param block   Block of PDM data, `[CHANNELS][SUBBLOCKS]`, in the
+       *                layout the decimator receives.
+       */
+      void Update(const uint32_t block[CHANNELS * SUBBLOCKS]);
+
+      /**
+       * @brief Get the health of the channels.
+       * 
+       * May be called from any thread on the same tile.
+       */
+      PdmHealth Get() const;
+
+      /**
+       * @brief Clear the flags and start every channel's window again.
+       * 
+       * Must be called from the thread which calls @ref Update(), or while 
+       * it is not running.
+       */
+      void Reset();
+  };
 
 
   /**
@@ -211,12 +686,19 @@ namespace  mic_array {
    * 
    * @tparam BLOCK_SIZE   Number of words of PDM data per block.
    * @tparam SubType      Subclass of `PdmRxService` actually being used.
+   * @tparam BUFFER_DEPTH @parblock
+   * Number of PDM block buffers. With the default of `2`, one buffer is
+   * filled while the other is processed, swapping each block. A `SubType`
+   * using more buffers chooses the buffer to fill next in `SendBlock()`, by
+   * setting `blocks[0]`.
+   * @endparblock
    */
-  template <unsigned BLOCK_SIZE, class SubType>
+  template <unsigned BLOCK_SIZE, class SubType, unsigned BUFFER_DEPTH = 2>
   class PdmRxService
   {
     // @todo: Use a static assertion to check that SubType is in fact a sub-type
     //        of `PdmRxService`. 
+    static_assert(BUFFER_DEPTH >= 2, "BUFFER_DEPTH must be at least 2.");
 
     public:
 
@@ -247,10 +729,10 @@ namespace  mic_array {
       /**
        * @brief Buffers for PDM data blocks.
        * 
-       * The PDM rx service will swap back and forth between filling these two
-       * buffers.
+       * The PDM rx service will swap back and forth between filling the first
+       * two of these buffers, unless `SubType` uses more of them.
        */
-      uint32_t block_data[2][BLOCK_SIZE];
+      uint32_t block_data[BUFFER_DEPTH][BLOCK_SIZE];
 
       /**
        * @brief PDM block redirection pointers.
@@ -261,6 +743,12 @@ namespace  mic_array {
        */
       uint32_t* blocks[2] = {&block_data[0][0], &block_data[1][0]};
 
+      /**
+       * @brief Reference time at which the first word of the current block
+       *        was read.
+       */
+      uint32_t block_start = 0;
+
     public:
 
       /**
@@ -273,11 +761,26 @@ namespace  mic_array {
        */
       void ProcessNext();
 
+      /**
+       * @brief Read a whole block of PDM data from the port.
+       * 
+       * Words are stored in reverse order of arrival, as by `ProcessNext()`,
+       * and `block_start` is set when the first of them has been read. This
+       * calls `SubType::ReadPort()` once per word; `SubType` may hide it with
+       * a batched version (see @ref StandardPdmRxService::ReadBlock()).
+       * 
+       * @param block Buffer of `BLOCK_SIZE` words to read into.
+       */
+      void ReadBlock(uint32_t block[BLOCK_SIZE]);
+
       /**
        * @brief Entry point for PDM processing thread.
        * 
-       * This function loops forever, calling `ProcessNext()` with each 
-       * iteration.
+       * This function loops forever, capturing a block at a time. The result
+       * is the same as calling `ProcessNext()` once per word, but the port
+       * reads of each block are made back-to-back, without the per-word 
+       * phase checks, so the thread spends as little time as possible 
+       * between them.
        */
       void ThreadEntry();
       
@@ -313,6 +816,10 @@ namespace  mic_array {
    * deinterleaved and copied to another buffer in the format required by the
    * decimator component, which is returned by `GetPdmBlock()`. This buffer
    * contains samples for `CHANNELS_OUT` microphone channels.
+   * 
+   * When run as a thread, the PDM rx thread can instead do this itself, one
+   * sub-block at a time as each completes, and send the decimator a ready
+   * `[CHANNELS_OUT][SUBBLOCKS]` block. See @ref DeinterleaveInThread().
    * @endparblock
    * 
    * @par Channel Filtering
@@ -369,6 +876,19 @@ namespace  mic_array {
    * non-default mapping from input channel indices to output channel indices.
    * It takes a pointer to a `CHANNELS_OUT`-element array specifying the input
    * channel index for each output channel.
+   * 
+   * Where the mapping is fixed (e.g. by the PCB), it may instead be given as
+   * the `CHANNEL_MAP` template parameters, one input channel index per output
+   * channel. Every copy made to map a block then has a fixed source and 
+   * destination, so it is unrolled, with no lookup of the map for each word
+   * (see @ref StaticChannelMap). For example, 6 mics on pins 1 to 6 of an 
+   * 8-bit port:
+   * 
+   * @code{.cpp}
+   *  mic_array::StandardPdmRxService<8, 6, SUBBLOCKS, 1,2,3,4,5,6>
+   * @endcode
+   * 
+   * `MapChannel()` and `MapChannels()` must not be used with a `CHANNEL_MAP`.
    * @endparblock
    * 
    * @tparam CHANNELS_IN  The number of microphone channels to be captured by
@@ -377,21 +897,45 @@ namespace  mic_array {
    *                      this `StandardPdmRxService` instance.
    * @tparam SUBBLOCKS    The number of 32-sample sub-blocks to be captured for
    *                      each microphone channel.
+   * @tparam CHANNEL_MAP  Input channel index of each output channel, fixed at
+   *                      compile time. Either empty (the default) or
+   *                      `CHANNELS_OUT` indices.
    */
-  template <unsigned CHANNELS_IN, unsigned CHANNELS_OUT, unsigned SUBBLOCKS>
+  template <unsigned CHANNELS_IN, unsigned CHANNELS_OUT, unsigned SUBBLOCKS,
+            unsigned... CHANNEL_MAP>
   class StandardPdmRxService : public PdmRxService<CHANNELS_IN * SUBBLOCKS, 
-                                      StandardPdmRxService<CHANNELS_IN, CHANNELS_OUT, SUBBLOCKS>>
+                                      StandardPdmRxService<CHANNELS_IN, CHANNELS_OUT, 
+                                                           SUBBLOCKS, CHANNEL_MAP...>>
   {
     /**
      * @brief Alias for parent class.
      */
     using Super = PdmRxService<CHANNELS_IN * SUBBLOCKS, 
-                    StandardPdmRxService<CHANNELS_IN, CHANNELS_OUT, SUBBLOCKS>>;
+                    StandardPdmRxService<CHANNELS_IN, CHANNELS_OUT, 
+                                         SUBBLOCKS, CHANNEL_MAP...>>;
 
-    private:
-      /**
-       * @brief Streaming channel over which PDM blocks are sent.
-       */
+    /**
+     * @brief The compile-time channel map, if any.
+     */
+    using StaticMap = StaticChannelMap<CHANNEL_MAP...>;
+
+    /**
+     * @brief Whether the channel map is fixed at compile time.
+     */
+    using IsStaticMap = std::integral_constant<bool, (StaticMap::Count != 0)>;
+
+    static_assert(CHANNELS_IN == PdmCaptureChannels<CHANNELS_IN>::value,
+        "CHANNELS_IN must be 1, 2, 4, 8 or 16. For other microphone counts, use "
+        "CHANNELS_IN = PdmCaptureChannels<CHANNELS_OUT>::value.");
+    static_assert(StaticMap::Count == 0 || StaticMap::Count == CHANNELS_OUT,
+        "CHANNEL_MAP must be empty or have CHANNELS_OUT entries.");
+    static_assert(StaticMap::template Fits<CHANNELS_IN>(),
+        "Each CHANNEL_MAP entry must be less than CHANNELS_IN.");
+
+    private:
+      /**
+       * @brief Streaming channel over which PDM blocks are sent.
+       */
       streaming_channel_t c_pdm_blocks;
 
       /**
@@ -401,22 +945,206 @@ namespace  mic_array {
        * 
        * By default, the mapping will be direct (i.e. `channel_map[k] = k`).
        * 
-       * Set with the `MapChannel()` or `MapChannels()` methods.
+       * Set with the `MapChannel()` or `MapChannels()` methods. Not used if
+       * `CHANNEL_MAP` is given.
        */
       unsigned channel_map[CHANNELS_OUT];
 
       /**
-       * @brief Buffer for output PDM data.
+       * @brief Whether `channel_map` is the direct mapping.
        * 
-       * A pointer to this array is delivered to the Decimator component for
-       * decimation. `GetPdmBlock()` (called from the mic array thread)
-       * populates this array (based on `channel_map`) after deinterleaving the
-       * PDM input buffer.
+       * If so, and `CHANNELS_IN == CHANNELS_OUT`, blocks are deinterleaved 
+       * into `out_block` by `deinterleave_pdm_samples_direct()`, without 
+       * looking up `channel_map`.
        */
-      uint32_t out_block[CHANNELS_OUT][SUBBLOCKS];
+      bool direct_map;
+
+      // out_block is only used when the decimator thread deinterleaves, and
+      // ready_blocks only when the PDM rx thread does, so they share storage.
+      union {
+        /**
+         * @brief Buffer for output PDM data.
+         * 
+         * A pointer to this array is delivered to the Decimator component for
+         * decimation. `GetPdmBlock()` (called from the mic array thread)
+         * populates this array (based on `channel_map`) after deinterleaving
+         * the PDM input buffer.
+         */
+        uint32_t out_block[CHANNELS_OUT][SUBBLOCKS];
+
+        /**
+         * @brief Mic-major blocks prepared by the PDM rx thread.
+         * 
+         * Only used if `thread_deinterleave` is set. The thread fills one
+         * while the decimator processes the other.
+         */
+        uint32_t ready_blocks[2][CHANNELS_OUT][SUBBLOCKS];
+      };
+
+      /**
+       * @brief Number of blocks returned by `GetPdmBlock()`.
+       */
+      volatile unsigned received = 0;
+
+      /**
+       * @brief Longest hand-off latency seen, reference clock ticks.
+       */
+      volatile uint32_t max_latency = 0;
+
+      /**
+       * @brief Slack of the latest block and the minima, as reported by
+       *        `GetSlack()`.
+       */
+      volatile PdmRxSlack slack = {0, 0, UINT32_MAX, UINT32_MAX};
+
+      /**
+       * @brief Least idle time in the current slack window.
+       */
+      uint32_t window_min_idle = UINT32_MAX;
+
+      /**
+       * @brief Number of blocks in the current slack window.
+       */
+      unsigned window_blocks = 0;
+
+      /**
+       * @brief Hand-off time of the previous block.
+       */
+      uint32_t prev_send_time = 0;
+
+      /**
+       * @brief Stamp of the block most recently returned by `GetPdmBlock()`.
+       */
+      PdmBlockStamp stamp = {0, 0};
+
+      /**
+       * @brief Whether the PDM rx thread deinterleaves and maps the blocks.
+       * 
+       * Set with `DeinterleaveInThread()`.
+       */
+      bool thread_deinterleave = false;
+
+      /**
+       * @brief Index of the `ready_blocks` buffer being filled.
+       */
+      unsigned ready_index = 0;
+
+      /**
+       * @brief Whether `GetPdmBlock()` reads the port itself.
+       * 
+       * Set with `CaptureInDecimatorThread()`.
+       */
+      bool decimator_capture = false;
+
+      /**
+       * @brief Whether `GetPdmBlock()` checks the channels' health.
+       * 
+       * Set with `MonitorHealth()`.
+       */
+      bool monitor_health = false;
+
+      /**
+       * @brief Health of the output channels.
+       */
+      PdmHealthMonitor<CHANNELS_OUT, SUBBLOCKS> health;
+
+      /**
+       * @brief Output channels copied out of each block.
+       * 
+       * Set with `SetActiveChannels()`.
+       */
+      volatile uint32_t active_channels = 0xFFFFFFFF;
+
+      /**
+       * @brief Output channels copied into each of `ready_blocks`, by every
+       *        one of its sub-blocks.
+       */
+      uint32_t ready_channels[2] = {0xFFFFFFFF, 0xFFFFFFFF};
+
+      /**
+       * @brief Output channels copied into the block most recently returned
+       *        by `GetPdmBlock()`.
+       */
+      uint32_t block_channels = 0xFFFFFFFF;
+
+      /**
+       * @brief Read a whole block from the port on the calling thread.
+       * 
+       * Used by `GetPdmBlock()` when `decimator_capture` is set.
+       */
+      uint32_t* CaptureBlock();
+
+      /**
+       * @brief Record the idle time before a block, and the block period.
+       * 
+       * @param idle      Time `GetPdmBlock()` waited for the block.
+       * @param send_time Time the block was handed over.
+       */
+      void UpdateSlack(uint32_t idle, uint32_t send_time);
+
+      /**
+       * @brief Set `direct_map` from `channel_map`.
+       */
+      void UpdateDirectMap();
+
+      /**
+       * @brief Deinterleave a block and map it into `out_block`, with the
+       *        runtime channel map.
+       * 
+       * @returns Mask of the output channels copied.
+       */
+      uint32_t MapBlock(uint32_t* block, std::false_type);
+
+      /**
+       * @brief Deinterleave a block and map it into `out_block`, with the
+       *        compile-time channel map.
+       * 
+       * @returns Mask of the output channels copied, i.e. all of them.
+       */
+      uint32_t MapBlock(uint32_t* block, std::true_type);
+
+      /**
+       * @brief Map a deinterleaved sub-block into `out[][sb]`, with the
+       *        runtime channel map.
+       * 
+       * @returns Mask of the output channels copied.
+       */
+      uint32_t MapSubblock(uint32_t out[][SUBBLOCKS], unsigned sb, 
+                           const uint32_t* row, std::false_type);
+
+      /**
+       * @brief Map a deinterleaved sub-block into `out[][sb]`, with the
+       *        compile-time channel map.
+       * 
+       * @returns Mask of the output channels copied, i.e. all of them.
+       */
+      uint32_t MapSubblock(uint32_t out[][SUBBLOCKS], unsigned sb, 
+                           const uint32_t* row, std::true_type);
    
     public:
 
+      /**
+       * @brief Number of PDM words of each output channel in a block.
+       * 
+       * See @ref PdmRxSubBlocks.
+       */
+      static constexpr unsigned SubBlocks = SUBBLOCKS;
+
+      /**
+       * @brief Estimated MIPS this service takes from the decimation thread.
+       * 
+       * Built from @ref KernelCost: handing each block over, deinterleaving
+       * and mapping each PDM word of each channel and, if `isr`, the PDM rx 
+       * ISR's port reads. When the service runs as its own thread, that 
+       * thread's load is not included. See @ref FitsThreadMips().
+       * 
+       * @param pdm_freq  PDM clock frequency, in Hz.
+       * @param isr       Whether the PDM rx ISR runs on the decimation thread.
+       */
+      static constexpr float RequiredMips(
+          const unsigned pdm_freq = 3072000,
+          const bool isr = true);
+
       /**
        * @brief Read a word of PDM data from the port.
        * 
@@ -425,6 +1153,20 @@ namespace  mic_array {
        */
       uint32_t ReadPort();
 
+      /**
+       * @brief Read a whole block of PDM data from the port.
+       * 
+       * As `PdmRxService::ReadBlock()`, but the port is read in unrolled
+       * batches of 4 words, so that of the per-word loop overhead only one
+       * count and branch is left per 4 reads. Each read still transfers
+       * 32 bits, the widest a buffered port supports. Used by 
+       * `ThreadEntry()` and by `GetPdmBlock()` when 
+       * `CaptureInDecimatorThread()` is enabled.
+       * 
+       * @param block Buffer of `CHANNELS_IN*SUBBLOCKS` words to read into.
+       */
+      void ReadBlock(uint32_t block[CHANNELS_IN*SUBBLOCKS]);
+
       /**
        * @brief Send a block of PDM data to a listener.
        * 
@@ -475,6 +1217,8 @@ namespace  mic_array {
       /**
        * @brief Install ISR for PDM reception on the current core.
        * 
+       * Installs `pdm_rx_isr`.
+       * 
        * @note This does not unmask interrupts.
        */
       void InstallISR();
@@ -507,152 +1251,1840 @@ namespace  mic_array {
        * `pdm_rx_isr_context.missed_blocks`.
        */
       void AssertOnDroppedBlock(bool doAssert);
-  };
 
-}
+      /**
+       * @brief Get the PDM hand-off statistics.
+       * 
+       * May be called from any thread on the same tile.
+       */
+      PdmRxStats GetStats() const;
 
-//////////////////////////////////////////////
-// Template function implementations below. //
-//////////////////////////////////////////////
+      /**
+       * @brief Get the decimation thread's slack.
+       * 
+       * May be called from any thread on the same tile, e.g. to raise an
+       * alarm while `recent_min_idle` is still a comfortable fraction of
+       * `block_period`, before blocks start being dropped.
+       */
+      PdmRxSlack GetSlack() const;
 
+      /**
+       * @brief Set whether `GetPdmBlock()` checks the health of the mics.
+       * 
+       * If `enable` is `true`, `GetPdmBlock()` passes each block to a
+       * @ref PdmHealthMonitor before returning it, which examines one output
+       * channel's words per block, so the cost is that of counting the bits 
+       * of `SUBBLOCKS` words. The result is read with `GetHealth()`. Disabled
+       * by default.
+       * 
+       * @param enable  Whether to check the mics' health.
+       */
+      void MonitorHealth(bool enable);
 
-//////////////////////////////////////////////
-//              PdmRxService                //
-//////////////////////////////////////////////
+      /**
+       * @brief Get the health of the mics, as judged from their PDM data.
+       * 
+       * Only updated while `MonitorHealth()` is enabled. May be called from
+       * any thread on the same tile.
+       */
+      PdmHealth GetHealth() const;
 
-template <unsigned BLOCK_SIZE, class SubType>
-void mic_array::PdmRxService<BLOCK_SIZE,SubType>::SetPort(port_t p_pdm_mics)
-{
-  this->p_pdm_mics = p_pdm_mics;
-}
+      /**
+       * @brief Get the index and start time of the block most recently
+       *        returned by `GetPdmBlock()`.
+       * 
+       * Only meaningful on the mic array thread, after `GetPdmBlock()`.
+       */
+      PdmBlockStamp GetBlockStamp() const;
 
+      /**
+       * @brief Reset the dropped block count, backlog and latency of the
+       *        PDM hand-off statistics, and the minimum idle time.
+       * 
+       * May be called from any thread on the same tile. A block handed over
+       * during the reset may still be counted in the old values.
+       */
+      void ResetStats();
 
-template <unsigned BLOCK_SIZE, class SubType>
-void mic_array::PdmRxService<BLOCK_SIZE,SubType>::ProcessNext()
-{
-  this->blocks[0][--phase] =  static_cast<SubType*>(this)->ReadPort();
+      /**
+       * @brief Set which output channels are copied out of each block.
+       * 
+       * Bit `k` of `mask` is set for output channel `k` to be copied into
+       * the block returned by `GetPdmBlock()`. The words of the other
+       * channels are left as they were, for a decimator which only decimates
+       * the channels in `mask` (see @ref MicArray::SetActiveChannels()). All
+       * channels are copied by default.
+       * 
+       * This only saves work with the runtime channel map (no `CHANNEL_MAP`)
+       * when it is not the direct one: the bits of all channels are
+       * deinterleaved together in any case, and the direct and compile-time
+       * maps copy a block with a fixed sequence of stores.
+       * 
+       * May be called from any thread on the same tile. It takes effect from
+       * the next block, or sub-block with `DeinterleaveInThread()`, so a
+       * channel added to `mask` is only whole in the blocks for which
+       * `CopiedChannels()` says so.
+       * 
+       * @param mask  Mask of the output channels to copy.
+       */
+      void SetActiveChannels(uint32_t mask);
 
-  if(!phase){
-    this->phase = BLOCK_SIZE;
-    uint32_t* ready_block = this->blocks[0];
-    this->blocks[0] = this->blocks[1];
-    this->blocks[1] = ready_block;
+      /**
+       * @brief Get the output channels copied into every sub-block of the
+       *        block most recently returned by `GetPdmBlock()`.
+       * 
+       * The words of the other channels may be left from an earlier block.
+       * Only meaningful on the mic array thread, after `GetPdmBlock()`.
+       */
+      uint32_t CopiedChannels() const;
 
-    static_cast<SubType*>(this)->SendBlock(ready_block);
-  }
-}
+      /**
+       * @brief Set whether the PDM rx thread deinterleaves the PDM data.
+       * 
+       * By default `GetPdmBlock()` deinterleaves each block and copies it
+       * into `[CHANNELS_OUT][SUBBLOCKS]` order on the mic array thread. If
+       * `enable` is `true`, `ThreadEntry()` does this instead, one sub-block
+       * at a time as each completes, so the work is spread across the port
+       * reads of the (otherwise mostly idle) PDM rx thread and taken off the
+       * mic array thread entirely. `GetPdmBlock()` then only waits for the
+       * block pointer.
+       * 
+       * This only applies when the PDM rx service runs as a thread; the PDM
+       * rx ISR always sends raw blocks, so this must be `false` if
+       * `InstallISR()` is used. Must be called before `ThreadEntry()` is
+       * started.
+       * 
+       * @param enable  Whether to deinterleave on the PDM rx thread.
+       */
+      void DeinterleaveInThread(bool enable);
 
+      /**
+       * @brief Set whether the decimation thread captures the PDM data
+       *        itself.
+       * 
+       * If `enable` is `true`, `GetPdmBlock()` reads each block straight
+       * from the port, so PDM capture and decimation share one thread with
+       * neither an ISR nor a PDM rx thread, and no chanend is used to hand 
+       * blocks over. The thread then spends its idle time paused on the port,
+       * and `GetSlack()` reports that time as idle as usual.
+       * 
+       * This only suits low channel counts: the port only buffers about one
+       * word, so everything the decimation thread does between one call to
+       * `GetPdmBlock()` and the next (decimating, filtering and outputting 
+       * the block) must take less than the time of one port word, 32 PDM
+       * clock periods, or PDM data is lost without being counted as a 
+       * dropped block. Neither `InstallISR()` nor `ThreadEntry()` may be used
+       * in this mode. Must be called before the decimation thread is started.
+       * 
+       * @param enable  Whether `GetPdmBlock()` reads the port.
+       */
+      void CaptureInDecimatorThread(bool enable);
 
-template <unsigned BLOCK_SIZE, class SubType>
-void mic_array::PdmRxService<BLOCK_SIZE,SubType>::ThreadEntry()
-{
-  while(1){
-    this->ProcessNext();
-  }
-}
+      /**
+       * @brief Add a word of PDM data to a block being deinterleaved by the
+       *        PDM rx thread.
+       * 
+       * Used by `ThreadEntry()` when `DeinterleaveInThread()` is enabled, in
+       * place of `ProcessNext()`. Each time a sub-block of `CHANNELS_IN`
+       * words completes it is deinterleaved and mapped into the next output
+       * block, and each time a block completes it is sent to the decimator.
+       * 
+       * @param pdm_word  A word of PDM data, as returned by `ReadPort()`.
+       */
+      void ProcessWord(uint32_t pdm_word);
 
+      /**
+       * @brief Entry point for PDM processing thread.
+       * 
+       * As `PdmRxService::ThreadEntry()`, except that if
+       * `DeinterleaveInThread()` is enabled, each word read is passed to
+       * `ProcessWord()`.
+       */
+      void ThreadEntry();
+  };
 
 
-//////////////////////////////////////////////
-//          StandardPdmRxService            //
-//////////////////////////////////////////////
+  /**
+   * @brief PDM rx service which captures from several ports at once.
+   * 
+   * Where the microphones of one array are split over more than one port
+   * (e.g. 16 microphones on two 8-bit ports), this class reads a word from
+   * each port in turn on a single PDM rx thread, and presents them to the
+   * decimator as one `[CHANNELS_OUT][SUBBLOCKS]` block, so that one
+   * @ref MicArray (and one decimation thread) processes all of them.
+   * 
+   * All ports must be clocked by the same capture clock. Configure the first
+   * with `mic_array_resources_configure()` and each of the others with
+   * `mic_array_resources_configure_port()`, before starting the PDM clock.
+   * 
+   * This class only runs as a thread (see @ref ThreadEntry()); the PDM rx
+   * ISR reads a single port. As with 
+   * @ref StandardPdmRxService::DeinterleaveInThread(), the PDM rx thread
+   * deinterleaves and maps each sub-block as it completes, and hands the
+   * ready block to `GetPdmBlock()` by pointer over a streaming channel.
+   * 
+   * @par Channel Index (Re-)Mapping
+   * @parblock
+   * Input channel `k` of port `p` (see @ref StandardPdmRxService) is input
+   * channel `p * PORT_CHANNELS + k` of this class. By default output channel
+   * `k` is mapped from input channel `k`. Use `MapChannel()` or
+   * `MapChannels()` to specify any other mapping.
+   * @endparblock
+   * 
+   * @tparam PORT_CHANNELS  The number of microphone channels captured by
+   *                        each port.
+   * @tparam PORT_COUNT     The number of ports.
+   * @tparam CHANNELS_OUT   The number of microphone channels to be delivered.
+   * @tparam SUBBLOCKS      The number of 32-sample sub-blocks to be captured
+   *                        for each microphone channel.
+   */
+  template <unsigned PORT_CHANNELS, unsigned PORT_COUNT, 
+            unsigned CHANNELS_OUT, unsigned SUBBLOCKS>
+  class MultiPortPdmRxService
+  {
+    static_assert(PORT_CHANNELS == PdmCaptureChannels<PORT_CHANNELS>::value,
+        "PORT_CHANNELS must be 1, 2, 4, 8 or 16.");
+    static_assert(PORT_COUNT >= 1, "PORT_COUNT must be at least 1.");
+    static_assert(CHANNELS_OUT <= PORT_CHANNELS * PORT_COUNT,
+        "CHANNELS_OUT must not exceed PORT_CHANNELS * PORT_COUNT.");
 
+    public:
 
-template <unsigned CHANNELS_IN, unsigned CHANNELS_OUT, unsigned SUBBLOCKS>
-uint32_t mic_array::StandardPdmRxService<CHANNELS_IN, CHANNELS_OUT, SUBBLOCKS>
-    ::ReadPort()
-{
-  return port_in(this->p_pdm_mics);
-}
+      /**
+       * @brief Number of input channels, over all ports.
+       */
+      static constexpr unsigned ChannelsIn = PORT_CHANNELS * PORT_COUNT;
 
+    private:
+      /**
+       * @brief Ports from which to collect PDM data.
+       */
+      port_t ports[PORT_COUNT];
 
-template <unsigned CHANNELS_IN, unsigned CHANNELS_OUT, unsigned SUBBLOCKS>
-void mic_array::StandardPdmRxService<CHANNELS_IN, CHANNELS_OUT, SUBBLOCKS>
-    ::SendBlock(uint32_t block[CHANNELS_IN*SUBBLOCKS])
-{
-  s_chan_out_word(this->c_pdm_blocks.end_a, 
-                  reinterpret_cast<uint32_t>( &block[0] ));
-}
+      /**
+       * @brief Streaming channel over which PDM blocks are sent.
+       */
+      streaming_channel_t c_pdm_blocks;
 
+      /**
+       * @brief Maps input channel indices to output channel indices.
+       * 
+       * The output channel with index `k` will be derived from the input
+       * channel with index `channel_map[k]`.
+       */
+      unsigned channel_map[CHANNELS_OUT];
 
-template <unsigned CHANNELS_IN, unsigned CHANNELS_OUT, unsigned SUBBLOCKS>
-void mic_array::StandardPdmRxService<CHANNELS_IN, CHANNELS_OUT, SUBBLOCKS>
-    ::Init(port_t p_pdm_mics) 
-{
-  for(int k = 0; k < CHANNELS_OUT; k++)
-    this->channel_map[k] = k;
+      /**
+       * @brief The current sub-block of each port.
+       * 
+       * Words are stored in reverse order of arrival, as by
+       * @ref PdmRxService::ProcessNext(), and deinterleaved in place once the
+       * sub-block completes.
+       */
+      uint32_t rows[PORT_COUNT][PORT_CHANNELS];
 
-  this->c_pdm_blocks = s_chan_alloc();
+      /**
+       * @brief Mic-major blocks prepared by the PDM rx thread.
+       * 
+       * The thread fills one while the decimator processes the other.
+       */
+      uint32_t ready_blocks[2][CHANNELS_OUT][SUBBLOCKS];
 
-  this->SetPort(p_pdm_mics);
-}
+      /**
+       * @brief Index of the `ready_blocks` buffer being filled.
+       */
+      unsigned ready_index = 0;
 
+      /**
+       * @brief Number of words left to capture for the current sub-block.
+       */
+      unsigned phase = PORT_CHANNELS;
 
-template <unsigned CHANNELS_IN, unsigned CHANNELS_OUT, unsigned SUBBLOCKS>
-void mic_array::StandardPdmRxService<CHANNELS_IN, CHANNELS_OUT, SUBBLOCKS>
-    ::MapChannels(unsigned map[CHANNELS_OUT]) 
-{
-  for(int k = 0; k < CHANNELS_OUT; k++)
-    this->channel_map[k] = map[k];
-}
+      /**
+       * @brief Index of the current sub-block within the block.
+       */
+      unsigned subblock = 0;
 
+      /**
+       * @brief Reference time at which the first words of the current block
+       *        were read.
+       */
+      uint32_t block_start = 0;
 
-template <unsigned CHANNELS_IN, unsigned CHANNELS_OUT, unsigned SUBBLOCKS>
-void mic_array::StandardPdmRxService<CHANNELS_IN, CHANNELS_OUT, SUBBLOCKS>
-    ::MapChannel(unsigned out_channel, unsigned in_channel) 
-{
-  this->channel_map[out_channel] = in_channel;
-}
+      /**
+       * @brief Number of blocks sent by `SendBlock()`.
+       */
+      volatile unsigned sent = 0;
 
+      /**
+       * @brief Hand-off and start times of the last two blocks sent.
+       */
+      volatile uint32_t send_time[2];
+      volatile uint32_t start_time[2];
 
-template <unsigned CHANNELS_IN, unsigned CHANNELS_OUT, unsigned SUBBLOCKS>
-void mic_array::StandardPdmRxService<CHANNELS_IN, CHANNELS_OUT, SUBBLOCKS>
+      /**
+       * @brief Number of blocks returned by `GetPdmBlock()`.
+       */
+      volatile unsigned received = 0;
+
+      /**
+       * @brief Longest hand-off latency seen, reference clock ticks.
+       */
+      volatile uint32_t max_latency = 0;
+
+      /**
+       * @brief Stamp of the block most recently returned by `GetPdmBlock()`.
+       */
+      PdmBlockStamp stamp = {0, 0};
+
+      /**
+       * @brief Send a ready block to the decimator.
+       */
+      void SendBlock(uint32_t block[CHANNELS_OUT * SUBBLOCKS]);
+
+    public:
+
+      /**
+       * @brief Initialize this object with its ports.
+       * 
+       * @param ports  The `PORT_COUNT` ports to receive PDM data on. Port `p`
+       *               captures input channels `p * PORT_CHANNELS` to
+       *               `(p+1) * PORT_CHANNELS - 1`.
+       */
+      void Init(const port_t ports[PORT_COUNT]);
+
+      /**
+       * @brief Set the input-output mapping for all output channels.
+       * 
+       * @note Changing the channel mapping while the mic array unit is running
+       *       is not recommended.
+       * 
+       * @param map Array containing new channel map.
+       */
+      void MapChannels(unsigned map[CHANNELS_OUT]);
+
+      /**
+       * @brief Set the input-output mapping for a single output channel.
+       * 
+       * @note Changing the channel mapping while the mic array unit is running
+       *       is not recommended.
+       * 
+       * @param out_channel   Output channel index to be re-mapped.
+       * @param in_channel    New source channel index for `out_channel`.
+       */
+      void MapChannel(unsigned out_channel, unsigned in_channel);
+
+      /**
+       * @brief Add a word of PDM data from each port to the current block.
+       * 
+       * Used by `ThreadEntry()`. Each time a sub-block completes, it is
+       * deinterleaved and mapped into the next output block, and each time a
+       * block completes it is sent to the decimator.
+       * 
+       * @param words   One word of PDM data from each port, as read by
+       *                `port_in()`.
+       */
+      void ProcessWords(const uint32_t words[PORT_COUNT]);
+
+      /**
+       * @brief Entry point for the PDM rx thread.
+       * 
+       * This function loops forever, reading a word from each port in turn
+       * and passing them to `ProcessWords()`. Everything it does between two
+       * reads of the first port must take less than the time of one port
+       * word, 32 PDM clock periods.
+       */
+      void ThreadEntry();
+
+      /**
+       * @brief Get a block of PDM data.
+       * 
+       * Because blocks of PDM samples are delivered by pointer, the caller must
+       * finish processing them before the next block of samples is ready, or
+       * the data will be clobbered.
+       * 
+       * @note This is a blocking call.
+       * 
+       * @returns Pointer to block of PDM data.
+       */
+      uint32_t* GetPdmBlock();
+
+      /**
+       * @brief Get the PDM hand-off statistics.
+       * 
+       * The PDM rx thread waits for the decimation thread rather than drop a
+       * block, so `dropped_blocks` and `max_backlog` are always `0`.
+       */
+      PdmRxStats GetStats() const;
+
+      /**
+       * @brief Get the index and start time of the block most recently
+       *        returned by `GetPdmBlock()`.
+       * 
+       * Only meaningful on the mic array thread, after `GetPdmBlock()`.
+       */
+      PdmBlockStamp GetBlockStamp() const;
+  };
+
+
+  /**
+   * @brief PDM rx service which receives PDM data from another tile.
+   * 
+   * Both @ref StandardPdmRxService and @ref SharedMemPdmRxService hand blocks
+   * to the decimation thread by pointer, so PDM capture and decimation must
+   * be on the same tile. Where the decimation load does not fit on the tile
+   * which owns the PDM port, `mic_array_pdm_forward()` can instead be run on
+   * that tile, streaming each word read from the port over a (cross-tile)
+   * streaming channel, and this class used as the mic array's `TPdmRx` on
+   * the other tile.
+   * 
+   * A receiving thread, @ref ThreadEntry(), assembles the words into blocks
+   * exactly as @ref StandardPdmRxService's PDM rx thread does with words read
+   * from a port, and hands each block by pointer to `GetPdmBlock()` on the
+   * decimation thread of the same tile, which deinterleaves and maps it. The
+   * receiving thread keeps the streaming channel drained while the
+   * decimation thread is busy, so the forwarding thread never waits long
+   * enough on the channel to miss a port word.
+   * 
+   * Channel filtering and mapping are as for @ref StandardPdmRxService, with
+   * `CHANNELS_IN` determined by the port on the other tile.
+   * 
+   * @tparam CHANNELS_IN  The number of microphone channels captured by the
+   *                      port on the other tile.
+   * @tparam CHANNELS_OUT The number of microphone channels to be delivered.
+   * @tparam SUBBLOCKS    The number of 32-sample sub-blocks to be captured for
+   *                      each microphone channel.
+   */
+  template <unsigned CHANNELS_IN, unsigned CHANNELS_OUT, unsigned SUBBLOCKS>
+  class ChannelPdmRxService : public PdmRxService<CHANNELS_IN * SUBBLOCKS, 
+                                     ChannelPdmRxService<CHANNELS_IN, CHANNELS_OUT, SUBBLOCKS>>
+  {
+    static_assert(CHANNELS_IN == PdmCaptureChannels<CHANNELS_IN>::value,
+        "CHANNELS_IN must be 1, 2, 4, 8 or 16. For other microphone counts, use "
+        "CHANNELS_IN = PdmCaptureChannels<CHANNELS_OUT>::value.");
+
+    private:
+      /**
+       * @brief Streaming chanend on which PDM words arrive from the other
+       *        tile.
+       */
+      chanend_t c_pdm_words;
+
+      /**
+       * @brief Streaming channel over which PDM blocks are sent.
+       */
+      streaming_channel_t c_pdm_blocks;
+
+      /**
+       * @brief Maps input channel indices to output channel indices.
+       * 
+       * The output channel with index `k` will be derived from the input
+       * channel with index `channel_map[k]`.
+       */
+      unsigned channel_map[CHANNELS_OUT];
+
+      /**
+       * @brief Buffer for output PDM data.
+       * 
+       * Populated by `GetPdmBlock()` and delivered to the decimator.
+       */
+      uint32_t out_block[CHANNELS_OUT][SUBBLOCKS];
+
+      /**
+       * @brief Number of blocks sent by `SendBlock()`.
+       */
+      volatile unsigned sent = 0;
+
+      /**
+       * @brief Hand-off and start times of the last two blocks sent.
+       */
+      volatile uint32_t send_time[2];
+      volatile uint32_t start_time[2];
+
+      /**
+       * @brief Number of blocks returned by `GetPdmBlock()`.
+       */
+      volatile unsigned received = 0;
+
+      /**
+       * @brief Longest hand-off latency seen, reference clock ticks.
+       */
+      volatile uint32_t max_latency = 0;
+
+      /**
+       * @brief Stamp of the block most recently returned by `GetPdmBlock()`.
+       */
+      PdmBlockStamp stamp = {0, 0};
+
+    public:
+
+      /**
+       * @brief Receive a word of PDM data from the other tile.
+       * 
+       * Used by `PdmRxService::ProcessNext()` in place of a port read.
+       */
+      uint32_t ReadPort();
+
+      /**
+       * @brief Send a block of PDM data to the decimation thread.
+       * 
+       * @param block   PDM data to send.
+       */
+      void SendBlock(uint32_t block[CHANNELS_IN * SUBBLOCKS]);
+
+      /**
+       * @brief Initialize this object with the chanend PDM words arrive on.
+       * 
+       * @param c_pdm_words  Streaming chanend whose other end is passed to
+       *                     `mic_array_pdm_forward()` on the other tile.
+       */
+      void Init(chanend_t c_pdm_words);
+
+      /**
+       * @brief Set the input-output mapping for all output channels.
+       * 
+       * See @ref StandardPdmRxService::MapChannels().
+       * 
+       * @param map Array containing new channel map.
+       */
+      void MapChannels(unsigned map[CHANNELS_OUT]);
+
+      /**
+       * @brief Set the input-output mapping for a single output channel.
+       * 
+       * See @ref StandardPdmRxService::MapChannel().
+       * 
+       * @param out_channel   Output channel index to be re-mapped.
+       * @param in_channel    New source channel index for `out_channel`.
+       */
+      void MapChannel(unsigned out_channel, unsigned in_channel);
+
+      /**
+       * @brief Get a block of PDM data.
+       * 
+       * Because blocks of PDM samples are delivered by pointer, the caller must
+       * finish processing them before the next block of samples is ready, or
+       * the data will be clobbered.
+       * 
+       * @note This is a blocking call.
+       * 
+       * @returns Pointer to block of PDM data.
+       */
+      uint32_t* GetPdmBlock();
+
+      /**
+       * @brief Get the PDM hand-off statistics.
+       * 
+       * The receiving thread waits for the decimation thread rather than drop
+       * a block, so `dropped_blocks` and `max_backlog` are always `0`.
+       */
+      PdmRxStats GetStats() const;
+
+      /**
+       * @brief Get the index and start time of the block most recently
+       *        returned by `GetPdmBlock()`.
+       * 
+       * The start time is when the first word of the block was received on
+       * this tile, by this tile's reference clock.
+       */
+      PdmBlockStamp GetBlockStamp() const;
+  };
+
+
+  /**
+   * @brief PDM rx service which hands blocks to the decimation thread through
+   *        shared memory.
+   * 
+   * This is a drop-in alternative to @ref StandardPdmRxService, with the same
+   * template parameters, layouts, channel mapping and methods, for when the
+   * PDM rx ISR (or thread) is on the same tile as the decimation thread.
+   * 
+   * @par Inter-context Transfer
+   * @parblock
+   * Instead of a streaming channel, completed blocks are published in a
+   * ring of block pointers with a sequence counter, in
+   * @ref pdm_rx_shmem_isr_context (see @ref pdm_rx_shmem_context_t).
+   * 
+   * This uses no chanends, and @ref GetPdmBlock() does not mask interrupts,
+   * so it adds no jitter to the PDM rx ISR. @ref GetPdmBlock() polls the
+   * sequence counter until a new block is published. When the ISR runs on
+   * the decimation thread, it interrupts that loop. When the service runs as
+   * its own thread, the decimation thread uses its issue slots while
+   * polling, where it would have paused on a channel receive.
+   * 
+   * Because the context is a single global object, only one instance of
+   * this class may be in use on each tile.
+   * @endparblock
+   * 
+   * @par Buffer Depth
+   * @parblock
+   * There are `BUFFER_DEPTH` PDM buffers. One is always being filled, and
+   * the others hold blocks waiting for @ref GetPdmBlock(), which has
+   * finished with a block's buffer by the time it returns. With the default
+   * depth of 2, the decimation thread must take each block before the next
+   * one is complete, as with @ref StandardPdmRxService. Each further buffer
+   * lets the decimation thread fall one more block behind, e.g. while it
+   * does heavier per-frame work or is shared with other tasks, without a
+   * block being dropped. Each costs `CHANNELS_IN * SUBBLOCKS` words.
+   * @endparblock
+   * 
+   * @tparam CHANNELS_IN  The number of microphone channels to be captured by
+   *                      the port.
+   * @tparam CHANNELS_OUT The number of microphone channels to be delivered by
+   *                      this `SharedMemPdmRxService` instance.
+   * @tparam SUBBLOCKS    The number of 32-sample sub-blocks to be captured for
+   *                      each microphone channel.
+   * @tparam BUFFER_DEPTH Number of PDM block buffers, at least 2.
+   */
+  template <unsigned CHANNELS_IN, unsigned CHANNELS_OUT, unsigned SUBBLOCKS,
+            unsigned BUFFER_DEPTH = 2>
+  class SharedMemPdmRxService : public PdmRxService<CHANNELS_IN * SUBBLOCKS, 
+                                      SharedMemPdmRxService<CHANNELS_IN, CHANNELS_OUT, SUBBLOCKS, BUFFER_DEPTH>,
+                                      BUFFER_DEPTH>
+  {
+    /**
+     * @brief Alias for parent class.
+     */
+    using Super = PdmRxService<CHANNELS_IN * SUBBLOCKS, 
+                    SharedMemPdmRxService<CHANNELS_IN, CHANNELS_OUT, SUBBLOCKS, BUFFER_DEPTH>,
+                    BUFFER_DEPTH>;
+
+    static_assert(CHANNELS_IN == PdmCaptureChannels<CHANNELS_IN>::value,
+        "CHANNELS_IN must be 1, 2, 4, 8 or 16. For other microphone counts, use "
+        "CHANNELS_IN = PdmCaptureChannels<CHANNELS_OUT>::value.");
+
+    private:
+      /**
+       * @brief Number of blocks taken by `GetPdmBlock()`.
+       */
+      unsigned taken = 0;
+
+      /**
+       * @brief Ring of published block pointers.
+       */
+      uint32_t* volatile ring[BUFFER_DEPTH];
+
+      /**
+       * @brief Reference time at which each block in `ring` was published.
+       */
+      volatile uint32_t send_times[BUFFER_DEPTH];
+
+      /**
+       * @brief Longest hand-off latency seen, reference clock ticks.
+       */
+      volatile uint32_t max_latency = 0;
+
+      /**
+       * @brief Maps input channel indices to output channel indices.
+       * 
+       * See @ref StandardPdmRxService.
+       */
+      unsigned channel_map[CHANNELS_OUT];
+
+      /**
+       * @brief Buffer for output PDM data.
+       * 
+       * See @ref StandardPdmRxService.
+       */
+      uint32_t out_block[CHANNELS_OUT][SUBBLOCKS];
+   
+    public:
+
+      /**
+       * @brief Read a word of PDM data from the port.
+       * 
+       * @return A `uint32_t` containing 32 PDM samples. If `MIC_COUNT >= 2` the
+       *         samples from each port will be interleaved together.
+       */
+      uint32_t ReadPort();
+
+      /**
+       * @brief Publish a block of PDM data to the decimation thread.
+       * 
+       * Used when running as a thread. Does the same as `pdm_rx_shmem_isr`
+       * does for a completed block, including choosing the buffer to fill
+       * next.
+       * 
+       * @param block   PDM data to send.
+       */
+      void SendBlock(uint32_t block[CHANNELS_IN * SUBBLOCKS]);
+
+      /**
+       * @brief Initialize this object with a port.
+       * 
+       * Also resets the shared memory context and points it at this object's
+       * buffers.
+       * 
+       * @param p_pdm_mics Port to receive PDM data on.
+       */
+      void Init(port_t p_pdm_mics);
+
+      /**
+       * @brief Set the input-output mapping for all output channels.
+       * 
+       * See @ref StandardPdmRxService::MapChannels().
+       * 
+       * @param map Array containing new channel map.
+       */
+      void MapChannels(unsigned map[CHANNELS_OUT]);
+
+      /**
+       * @brief Set the input-output mapping for a single output channel.
+       * 
+       * See @ref StandardPdmRxService::MapChannel().
+       * 
+       * @param out_channel   Output channel index to be re-mapped.
+       * @param in_channel    New source channel index for `out_channel`.
+       */
+      void MapChannel(unsigned out_channel, unsigned in_channel);
+
+      /**
+       * @brief Install ISR for PDM reception on the current core.
+       * 
+       * @note This does not unmask interrupts.
+       */
+      void InstallISR();
+
+      /**
+       * @brief Unmask interrupts on the current core.
+       */
+      void UnmaskISR();
+
+      /**
+       * @brief Get a block of PDM data.
+       * 
+       * Waits for the next block to be published. The block is deinterleaved
+       * into a buffer of this object's, and its PDM buffer released for
+       * refilling, before this returns. As with @ref StandardPdmRxService,
+       * the caller must finish with the returned samples before calling this
+       * again.
+       * 
+       * @note This is a blocking call.
+       * 
+       * @returns Pointer to block of PDM data.
+       */
+      uint32_t* GetPdmBlock();
+
+      /**
+       * @brief Set whether dropped PDM samples should cause an assertion.
+       * 
+       * See @ref StandardPdmRxService::AssertOnDroppedBlock(). Dropped blocks
+       * are counted in `pdm_rx_shmem_isr_context.missed_blocks`.
+       */
+      void AssertOnDroppedBlock(bool doAssert);
+
+      /**
+       * @brief Get the PDM hand-off statistics.
+       * 
+       * May be called from any thread on the same tile.
+       */
+      PdmRxStats GetStats() const;
+
+      /**
+       * @brief Reset the dropped block count, backlog and latency of the
+       *        PDM hand-off statistics.
+       * 
+       * See @ref StandardPdmRxService::ResetStats().
+       */
+      void ResetStats();
+  };
+
+}
+
+//////////////////////////////////////////////
+// Template function implementations below. //
+//////////////////////////////////////////////
+
+
+//////////////////////////////////////////////
+//            PdmHealthMonitor              //
+//////////////////////////////////////////////
+
+template <unsigned CHANNELS, unsigned SUBBLOCKS>
+inline unsigned mic_array::PdmHealthMonitor<CHANNELS,SUBBLOCKS>::PopCount(
+    uint32_t x)
+{
+  x = x - ((x >> 1) & 0x55555555);
+  x = (x & 0x33333333) + ((x >> 2) & 0x33333333);
+  x = (x + (x >> 4)) & 0x0F0F0F0F;
+  return (x * 0x01010101) >> 24;
+}
+
+
+template <unsigned CHANNELS, unsigned SUBBLOCKS>
+void mic_array::PdmHealthMonitor<CHANNELS,SUBBLOCKS>::Update(
+    const uint32_t block[CHANNELS * SUBBLOCKS])
+{
+  const unsigned ch = this->channel;
+  const uint32_t* w = &block[ch * SUBBLOCKS];
+
+  for(unsigned k = 0; k < SUBBLOCKS; k++){
+    this->ones[ch] += PopCount(w[k]);
+    // The 31 pairs of adjacent bits within the word.
+    this->transitions[ch] += PopCount((w[k] ^ (w[k] >> 1)) & 0x7FFFFFFF);
+  }
+  this->words[ch] += SUBBLOCKS;
+
+  if(this->words[ch] >= MIC_ARRAY_HEALTH_WINDOW_WORDS)
+    this->Judge(ch);
+
+  this->channel = (ch + 1 == CHANNELS)? 0 : ch + 1;
+}
+
+
+template <unsigned CHANNELS, unsigned SUBBLOCKS>
+void mic_array::PdmHealthMonitor<CHANNELS,SUBBLOCKS>::Judge(
+    unsigned ch)
+{
+  const unsigned bits = 32 * this->words[ch];
+  const unsigned pairs = 31 * this->words[ch];
+  const uint32_t mask = 1u << ch;
+
+  const bool low = 64 * this->ones[ch] < bits;
+  const bool high = 64 * this->ones[ch] > 63 * bits;
+  const bool toggling = 64 * this->transitions[ch] > 63 * pairs;
+
+  this->health.stuck_low = low? (this->health.stuck_low | mask) 
+                              : (this->health.stuck_low & ~mask);
+  this->health.stuck_high = high? (this->health.stuck_high | mask) 
+                                : (this->health.stuck_high & ~mask);
+  this->health.toggling = toggling? (this->health.toggling | mask) 
+                                  : (this->health.toggling & ~mask);
+  this->health.windows = this->health.windows + 1;
+
+  this->words[ch] = 0;
+  this->ones[ch] = 0;
+  this->transitions[ch] = 0;
+}
+
+
+template <unsigned CHANNELS, unsigned SUBBLOCKS>
+mic_array::PdmHealth mic_array::PdmHealthMonitor<CHANNELS,SUBBLOCKS>::Get() const
+{
+  PdmHealth health;
+  health.stuck_low = this->health.stuck_low;
+  health.stuck_high = this->health.stuck_high;
+  health.toggling = this->health.toggling;
+  health.windows = this->health.windows;
+  return health;
+}
+
+
+template <unsigned CHANNELS, unsigned SUBBLOCKS>
+void mic_array::PdmHealthMonitor<CHANNELS,SUBBLOCKS>::Reset()
+{
+  for(unsigned ch = 0; ch < CHANNELS; ch++){
+    this->words[ch] = 0;
+    this->ones[ch] = 0;
+    this->transitions[ch] = 0;
+  }
+  this->channel = 0;
+  this->health.stuck_low = 0;
+  this->health.stuck_high = 0;
+  this->health.toggling = 0;
+  this->health.windows = 0;
+}
+
+
+//////////////////////////////////////////////
+//              PdmRxService                //
+//////////////////////////////////////////////
+
+template <unsigned BLOCK_SIZE, class SubType, unsigned BUFFER_DEPTH>
+void mic_array::PdmRxService<BLOCK_SIZE,SubType,BUFFER_DEPTH>::SetPort(port_t p_pdm_mics)
+{
+  this->p_pdm_mics = p_pdm_mics;
+}
+
+
+template <unsigned BLOCK_SIZE, class SubType, unsigned BUFFER_DEPTH>
+void mic_array::PdmRxService<BLOCK_SIZE,SubType,BUFFER_DEPTH>::ProcessNext()
+{
+  this->blocks[0][--phase] =  static_cast<SubType*>(this)->ReadPort();
+
+  if(phase == BLOCK_SIZE - 1)
+    this->block_start = get_reference_time();
+
+  if(!phase){
+    this->phase = BLOCK_SIZE;
+    uint32_t* ready_block = this->blocks[0];
+    this->blocks[0] = this->blocks[1];
+    this->blocks[1] = ready_block;
+
+    static_cast<SubType*>(this)->SendBlock(ready_block);
+  }
+}
+
+
+template <unsigned BLOCK_SIZE, class SubType, unsigned BUFFER_DEPTH>
+void mic_array::PdmRxService<BLOCK_SIZE,SubType,BUFFER_DEPTH>::ReadBlock(
+    uint32_t block[BLOCK_SIZE])
+{
+  // Words are stored in reverse order of arrival, as in ProcessNext().
+  block[BLOCK_SIZE-1] = static_cast<SubType*>(this)->ReadPort();
+  this->block_start = get_reference_time();
+
+  for(unsigned k = BLOCK_SIZE-1; k; k--)
+    block[k-1] = static_cast<SubType*>(this)->ReadPort();
+}
+
+
+template <unsigned BLOCK_SIZE, class SubType, unsigned BUFFER_DEPTH>
+void mic_array::PdmRxService<BLOCK_SIZE,SubType,BUFFER_DEPTH>::ThreadEntry()
+{
+  // Finish any block begun with ProcessNext().
+  while(this->phase != BLOCK_SIZE)
+    this->ProcessNext();
+
+  while(1){
+    uint32_t* block = this->blocks[0];
+
+    static_cast<SubType*>(this)->ReadBlock(block);
+
+    this->blocks[0] = this->blocks[1];
+    this->blocks[1] = block;
+
+    static_cast<SubType*>(this)->SendBlock(block);
+  }
+}
+
+
+
+//////////////////////////////////////////////
+//          StandardPdmRxService            //
+//////////////////////////////////////////////
+
+
+template <unsigned CHANNELS_IN, unsigned CHANNELS_OUT, unsigned SUBBLOCKS,
+          unsigned... CHANNEL_MAP>
+constexpr float mic_array::StandardPdmRxService<CHANNELS_IN, CHANNELS_OUT, SUBBLOCKS, CHANNEL_MAP...>
+    ::RequiredMips(
+        const unsigned pdm_freq,
+        const bool isr)
+{
+  return ((pdm_freq / (32.0f * SUBBLOCKS)) * KernelCost::PdmBlock
+        + (pdm_freq / 32.0f) * CHANNELS_IN 
+              * (KernelCost::DeinterleaveWord 
+                 + (isr? KernelCost::IsrWord : 0))) / 1e6f;
+}
+
+
+template <unsigned CHANNELS_IN, unsigned CHANNELS_OUT, unsigned SUBBLOCKS,
+          unsigned... CHANNEL_MAP>
+uint32_t mic_array::StandardPdmRxService<CHANNELS_IN, CHANNELS_OUT, SUBBLOCKS, CHANNEL_MAP...>
+    ::ReadPort()
+{
+  return port_in(this->p_pdm_mics);
+}
+
+
+template <unsigned CHANNELS_IN, unsigned CHANNELS_OUT, unsigned SUBBLOCKS,
+          unsigned... CHANNEL_MAP>
+void mic_array::StandardPdmRxService<CHANNELS_IN, CHANNELS_OUT, SUBBLOCKS, CHANNEL_MAP...>
+    ::ReadBlock(uint32_t block[CHANNELS_IN*SUBBLOCKS])
+{
+  constexpr unsigned BLOCK_WORDS = CHANNELS_IN * SUBBLOCKS;
+  const port_t p = this->p_pdm_mics;
+
+  // Words are stored in reverse order of arrival, as in ProcessNext().
+  block[BLOCK_WORDS-1] = port_in(p);
+  this->block_start = get_reference_time();
+
+  // Leave a whole number of batches.
+  unsigned k = BLOCK_WORDS-1;
+  for(; k % 4; k--)
+    block[k-1] = port_in(p);
+
+  for(; k; k -= 4){
+    block[k-1] = port_in(p);
+    block[k-2] = port_in(p);
+    block[k-3] = port_in(p);
+    block[k-4] = port_in(p);
+  }
+}
+
+
+template <unsigned CHANNELS_IN, unsigned CHANNELS_OUT, unsigned SUBBLOCKS,
+          unsigned... CHANNEL_MAP>
+void mic_array::StandardPdmRxService<CHANNELS_IN, CHANNELS_OUT, SUBBLOCKS, CHANNEL_MAP...>
+    ::SendBlock(uint32_t block[CHANNELS_IN*SUBBLOCKS])
+{
+  // Timestamp the block as the ISR does.
+  const unsigned sent = pdm_rx_isr_context.sent;
+  pdm_rx_isr_context.send_time[sent % 2] = get_reference_time();
+  pdm_rx_isr_context.start_time[sent % 2] = this->block_start;
+  pdm_rx_isr_context.block_index[sent % 2] = pdm_rx_isr_context.captured;
+  pdm_rx_isr_context.captured = pdm_rx_isr_context.captured + 1;
+  pdm_rx_isr_context.sent = sent + 1;
+
+  s_chan_out_word(this->c_pdm_blocks.end_a, 
+                  reinterpret_cast<uint32_t>( &block[0] ));
+}
+
+
+template <unsigned CHANNELS_IN, unsigned CHANNELS_OUT, unsigned SUBBLOCKS,
+          unsigned... CHANNEL_MAP>
+void mic_array::StandardPdmRxService<CHANNELS_IN, CHANNELS_OUT, SUBBLOCKS, CHANNEL_MAP...>
+    ::Init(port_t p_pdm_mics) 
+{
+  for(int k = 0; k < CHANNELS_OUT; k++)
+    this->channel_map[k] = k;
+  this->direct_map = true;
+
+  this->c_pdm_blocks = s_chan_alloc();
+
+  this->received = 0;
+  pdm_rx_isr_context.sent = 0;
+  pdm_rx_isr_context.captured = 0;
+  this->stamp = {0, 0};
+
+  this->slack.block_period = 0;
+  this->slack.last_idle = 0;
+  this->slack.recent_min_idle = UINT32_MAX;
+  this->slack.min_idle = UINT32_MAX;
+  this->window_min_idle = UINT32_MAX;
+  this->window_blocks = 0;
+
+  this->SetPort(p_pdm_mics);
+}
+
+
+template <unsigned CHANNELS_IN, unsigned CHANNELS_OUT, unsigned SUBBLOCKS,
+          unsigned... CHANNEL_MAP>
+void mic_array::StandardPdmRxService<CHANNELS_IN, CHANNELS_OUT, SUBBLOCKS, CHANNEL_MAP...>
+    ::MapChannels(unsigned map[CHANNELS_OUT]) 
+{
+  assert(!IsStaticMap::value);
+  for(int k = 0; k < CHANNELS_OUT; k++)
+    this->channel_map[k] = map[k];
+  this->UpdateDirectMap();
+}
+
+
+template <unsigned CHANNELS_IN, unsigned CHANNELS_OUT, unsigned SUBBLOCKS,
+          unsigned... CHANNEL_MAP>
+void mic_array::StandardPdmRxService<CHANNELS_IN, CHANNELS_OUT, SUBBLOCKS, CHANNEL_MAP...>
+    ::MapChannel(unsigned out_channel, unsigned in_channel) 
+{
+  assert(!IsStaticMap::value);
+  this->channel_map[out_channel] = in_channel;
+  this->UpdateDirectMap();
+}
+
+
+template <unsigned CHANNELS_IN, unsigned CHANNELS_OUT, unsigned SUBBLOCKS,
+          unsigned... CHANNEL_MAP>
+void mic_array::StandardPdmRxService<CHANNELS_IN, CHANNELS_OUT, SUBBLOCKS, CHANNEL_MAP...>
+    ::UpdateDirectMap() 
+{
+  this->direct_map = true;
+  for(int k = 0; k < CHANNELS_OUT; k++)
+    this->direct_map = this->direct_map && (this->channel_map[k] == k);
+}
+
+
+template <unsigned CHANNELS_IN, unsigned CHANNELS_OUT, unsigned SUBBLOCKS,
+          unsigned... CHANNEL_MAP>
+void mic_array::StandardPdmRxService<CHANNELS_IN, CHANNELS_OUT, SUBBLOCKS, CHANNEL_MAP...>
     ::InstallISR() 
 {
-  pdm_rx_isr_context.p_pdm_mics = this->p_pdm_mics;
-  pdm_rx_isr_context.c_pdm_data = this->c_pdm_blocks.end_a;
-  pdm_rx_isr_context.pdm_buffer[0] = &this->block_data[0][0];
-  pdm_rx_isr_context.pdm_buffer[1] = &this->block_data[1][0];
-  pdm_rx_isr_context.phase_reset = CHANNELS_IN*SUBBLOCKS-1;
-  pdm_rx_isr_context.phase = CHANNELS_IN*SUBBLOCKS-1;
+  pdm_rx_isr_context.p_pdm_mics = this->p_pdm_mics;
+  pdm_rx_isr_context.c_pdm_data = this->c_pdm_blocks.end_a;
+  pdm_rx_isr_context.pdm_buffer[0] = &this->block_data[0][0];
+  pdm_rx_isr_context.pdm_buffer[1] = &this->block_data[1][0];
+  pdm_rx_isr_context.phase_reset = CHANNELS_IN*SUBBLOCKS-1;
+  pdm_rx_isr_context.phase = CHANNELS_IN*SUBBLOCKS-1;
+
+  enable_pdm_rx_isr(this->p_pdm_mics);
+}
+
+
+template <unsigned CHANNELS_IN, unsigned CHANNELS_OUT, unsigned SUBBLOCKS,
+          unsigned... CHANNEL_MAP>
+void mic_array::StandardPdmRxService<CHANNELS_IN, CHANNELS_OUT, SUBBLOCKS, CHANNEL_MAP...>
+    ::AssertOnDroppedBlock(bool doAssert)
+{
+  pdm_rx_isr_context.missed_blocks = doAssert? -1 : 0;
+}
+
+template <unsigned CHANNELS_IN, unsigned CHANNELS_OUT, unsigned SUBBLOCKS,
+          unsigned... CHANNEL_MAP>
+void mic_array::StandardPdmRxService<CHANNELS_IN, CHANNELS_OUT, SUBBLOCKS, CHANNEL_MAP...>
+    ::UnmaskISR() 
+{
+  interrupt_unmask_all();
+}
+
+template <unsigned CHANNELS_IN, unsigned CHANNELS_OUT, unsigned SUBBLOCKS,
+          unsigned... CHANNEL_MAP>
+uint32_t* mic_array::StandardPdmRxService<CHANNELS_IN, CHANNELS_OUT, SUBBLOCKS, CHANNEL_MAP...>
+    ::GetPdmBlock() 
+{
+  if(this->decimator_capture)
+    return this->CaptureBlock();
+
+  // Has to be in a critical section to avoid race conditions with ISR.
+  interrupt_mask_all();
+  pdm_rx_isr_context.credit = 2;
+  interrupt_unmask_all();
+
+
+  const uint32_t wait_start = get_reference_time();
+  uint32_t* full_block = (uint32_t*) s_chan_in_word(this->c_pdm_blocks.end_b);
+  const uint32_t idle = get_reference_time() - wait_start;
+  // Read straight away, before a later block can reuse the slot.
+  const uint32_t send_time = 
+      pdm_rx_isr_context.send_time[this->received % 2];
+  this->stamp.block_index = 
+      pdm_rx_isr_context.block_index[this->received % 2];
+  this->stamp.timestamp = 
+      pdm_rx_isr_context.start_time[this->received % 2];
+
+  this->UpdateSlack(idle, send_time);
+
+  // The PDM rx thread has already put the block in the decimator's order.
+  uint32_t* out = full_block;
+
+  if(!this->thread_deinterleave){
+    this->block_channels = this->MapBlock(full_block, IsStaticMap());
+    out = &this->out_block[0][0];
+  } else {
+    this->block_channels = this->ready_channels[
+        (full_block == &this->ready_blocks[1][0][0])? 1 : 0];
+  }
+
+  if(this->monitor_health)
+    this->health.Update(out);
+
+  const uint32_t latency = get_reference_time() - send_time;
+  if(latency > this->max_latency)
+    this->max_latency = latency;
+  this->received = this->received + 1;
+
+  return out;
+}
+
+
+template <unsigned CHANNELS_IN, unsigned CHANNELS_OUT, unsigned SUBBLOCKS,
+          unsigned... CHANNEL_MAP>
+uint32_t* mic_array::StandardPdmRxService<CHANNELS_IN, CHANNELS_OUT, SUBBLOCKS, CHANNEL_MAP...>
+    ::CaptureBlock() 
+{
+  const uint32_t wait_start = get_reference_time();
+
+  uint32_t* block = this->blocks[0];
+  this->ReadBlock(block);
+
+  const uint32_t send_time = get_reference_time();
+  this->UpdateSlack(send_time - wait_start, send_time);
+
+  // No block can be dropped, so blocks are numbered as they are returned.
+  this->stamp.block_index = this->received;
+  this->stamp.timestamp = this->block_start;
+
+  this->block_channels = this->MapBlock(block, IsStaticMap());
+
+  if(this->monitor_health)
+    this->health.Update(&this->out_block[0][0]);
+
+  this->received = this->received + 1;
+
+  return &this->out_block[0][0];
+}
+
+
+template <unsigned CHANNELS_IN, unsigned CHANNELS_OUT, unsigned SUBBLOCKS,
+          unsigned... CHANNEL_MAP>
+void mic_array::StandardPdmRxService<CHANNELS_IN, CHANNELS_OUT, SUBBLOCKS, CHANNEL_MAP...>
+    ::UpdateSlack(uint32_t idle, uint32_t send_time)
+{
+  if(this->received)
+    this->slack.block_period = send_time - this->prev_send_time;
+  this->prev_send_time = send_time;
+
+  this->slack.last_idle = idle;
+  if(idle < this->slack.min_idle)
+    this->slack.min_idle = idle;
+
+  if(idle < this->window_min_idle)
+    this->window_min_idle = idle;
+
+  if(++this->window_blocks == MIC_ARRAY_SLACK_WINDOW_BLOCKS){
+    this->slack.recent_min_idle = this->window_min_idle;
+    this->window_min_idle = UINT32_MAX;
+    this->window_blocks = 0;
+  }
+}
+
+
+template <unsigned CHANNELS_IN, unsigned CHANNELS_OUT, unsigned SUBBLOCKS,
+          unsigned... CHANNEL_MAP>
+void mic_array::StandardPdmRxService<CHANNELS_IN, CHANNELS_OUT, SUBBLOCKS, CHANNEL_MAP...>
+    ::DeinterleaveInThread(bool enable)
+{
+  this->thread_deinterleave = enable;
+}
+
+
+template <unsigned CHANNELS_IN, unsigned CHANNELS_OUT, unsigned SUBBLOCKS,
+          unsigned... CHANNEL_MAP>
+void mic_array::StandardPdmRxService<CHANNELS_IN, CHANNELS_OUT, SUBBLOCKS, CHANNEL_MAP...>
+    ::CaptureInDecimatorThread(bool enable)
+{
+  this->decimator_capture = enable;
+}
+
+
+template <unsigned CHANNELS_IN, unsigned CHANNELS_OUT, unsigned SUBBLOCKS,
+          unsigned... CHANNEL_MAP>
+void mic_array::StandardPdmRxService<CHANNELS_IN, CHANNELS_OUT, SUBBLOCKS, CHANNEL_MAP...>
+    ::ProcessWord(uint32_t pdm_word)
+{
+  // Words are stored in reverse order of arrival, as in ProcessNext(), so
+  // sub-block row r (of SUBBLOCKS) is complete once phase reaches
+  // r*CHANNELS_IN, and holds the output sub-block SUBBLOCKS-1-r.
+  this->blocks[0][--this->phase] = pdm_word;
+
+  if(this->phase == CHANNELS_IN * SUBBLOCKS - 1)
+    this->block_start = get_reference_time();
+
+  if(this->phase % CHANNELS_IN)
+    return;
+
+  uint32_t* row = &this->blocks[0][this->phase];
+  const unsigned sb = SUBBLOCKS - 1 - (this->phase / CHANNELS_IN);
+
+  mic_array::deinterleave_pdm_samples<CHANNELS_IN>(row, 1);
+
+  uint32_t (*out)[SUBBLOCKS] = this->ready_blocks[this->ready_index];
+  const uint32_t copied = this->MapSubblock(out, sb, row, IsStaticMap());
+  // A channel is only whole if every sub-block of the block copied it.
+  this->ready_channels[this->ready_index] = sb? 
+      (this->ready_channels[this->ready_index] & copied) : copied;
+
+  if(this->phase)
+    return;
+
+  // Each row has been consumed as it completed, so the same PDM buffer is
+  // refilled.
+  this->phase = CHANNELS_IN * SUBBLOCKS;
+  this->ready_index ^= 1;
+  this->SendBlock(&out[0][0]);
+}
+
+
+template <unsigned CHANNELS_IN, unsigned CHANNELS_OUT, unsigned SUBBLOCKS,
+          unsigned... CHANNEL_MAP>
+uint32_t mic_array::StandardPdmRxService<CHANNELS_IN, CHANNELS_OUT, SUBBLOCKS, CHANNEL_MAP...>
+    ::MapBlock(uint32_t* block, std::false_type)
+{
+  if(CHANNELS_IN == CHANNELS_OUT && this->direct_map){
+    mic_array::deinterleave_pdm_samples_direct<CHANNELS_IN>(
+        &this->out_block[0][0], block, SUBBLOCKS);
+    return 0xFFFFFFFF;
+  }
+
+  constexpr uint32_t ALL = (CHANNELS_OUT >= 32)? 0xFFFFFFFF 
+                              : ((1u << (CHANNELS_OUT % 32)) - 1);
+  const uint32_t active = this->active_channels;
+
+  if((active & ALL) == ALL){
+    mic_array::deinterleave_pdm_samples_mapped<CHANNELS_IN>(
+        &this->out_block[0][0], block, SUBBLOCKS, 
+        this->channel_map, CHANNELS_OUT);
+    return 0xFFFFFFFF;
+  }
+
+  // Only the active channels are copied out; see SetActiveChannels().
+  mic_array::deinterleave_pdm_samples<CHANNELS_IN>(block, SUBBLOCKS);
+
+  for(unsigned ch = 0; ch < CHANNELS_OUT; ch++){
+    if(!((active >> ch) & 1))
+      continue;
+    for(unsigned sb = 0; sb < SUBBLOCKS; sb++)
+      this->out_block[ch][sb] = 
+          block[(SUBBLOCKS - 1 - sb) * CHANNELS_IN + this->channel_map[ch]];
+  }
+
+  return active;
+}
+
+
+template <unsigned CHANNELS_IN, unsigned CHANNELS_OUT, unsigned SUBBLOCKS,
+          unsigned... CHANNEL_MAP>
+uint32_t mic_array::StandardPdmRxService<CHANNELS_IN, CHANNELS_OUT, SUBBLOCKS, CHANNEL_MAP...>
+    ::MapBlock(uint32_t* block, std::true_type)
+{
+  StaticMap::template DeinterleaveMapped<CHANNELS_IN, SUBBLOCKS>(
+      this->out_block, block);
+  return 0xFFFFFFFF;
+}
 
-  enable_pdm_rx_isr(this->p_pdm_mics);
+
+template <unsigned CHANNELS_IN, unsigned CHANNELS_OUT, unsigned SUBBLOCKS,
+          unsigned... CHANNEL_MAP>
+uint32_t mic_array::StandardPdmRxService<CHANNELS_IN, CHANNELS_OUT, SUBBLOCKS, CHANNEL_MAP...>
+    ::MapSubblock(uint32_t out[][SUBBLOCKS], unsigned sb, 
+                  const uint32_t* row, std::false_type)
+{
+  const uint32_t active = this->active_channels;
+
+  for(int ch = 0; ch < CHANNELS_OUT; ch++)
+    if((active >> ch) & 1)
+      out[ch][sb] = row[this->channel_map[ch]];
+
+  return active;
+}
+
+
+template <unsigned CHANNELS_IN, unsigned CHANNELS_OUT, unsigned SUBBLOCKS,
+          unsigned... CHANNEL_MAP>
+uint32_t mic_array::StandardPdmRxService<CHANNELS_IN, CHANNELS_OUT, SUBBLOCKS, CHANNEL_MAP...>
+    ::MapSubblock(uint32_t out[][SUBBLOCKS], unsigned sb, 
+                  const uint32_t* row, std::true_type)
+{
+  StaticMap::template MapSubblock<SUBBLOCKS>(out, sb, row);
+  return 0xFFFFFFFF;
+}
+
+
+template <unsigned CHANNELS_IN, unsigned CHANNELS_OUT, unsigned SUBBLOCKS,
+          unsigned... CHANNEL_MAP>
+void mic_array::StandardPdmRxService<CHANNELS_IN, CHANNELS_OUT, SUBBLOCKS, CHANNEL_MAP...>
+    ::ThreadEntry()
+{
+  if(!this->thread_deinterleave)
+    Super::ThreadEntry();
+
+  while(1){
+    this->ProcessWord(this->ReadPort());
+  }
+}
+
+
+template <unsigned CHANNELS_IN, unsigned CHANNELS_OUT, unsigned SUBBLOCKS,
+          unsigned... CHANNEL_MAP>
+mic_array::PdmRxStats 
+    mic_array::StandardPdmRxService<CHANNELS_IN, CHANNELS_OUT, SUBBLOCKS, CHANNEL_MAP...>
+    ::GetStats() const
+{
+  PdmRxStats stats;
+  stats.blocks = this->received;
+  stats.dropped_blocks = pdm_rx_isr_context.dropped_blocks;
+  stats.max_backlog = 2 - pdm_rx_isr_context.min_credit;
+  stats.max_latency = this->max_latency;
+  return stats;
+}
+
+
+template <unsigned CHANNELS_IN, unsigned CHANNELS_OUT, unsigned SUBBLOCKS,
+          unsigned... CHANNEL_MAP>
+mic_array::PdmRxSlack 
+    mic_array::StandardPdmRxService<CHANNELS_IN, CHANNELS_OUT, SUBBLOCKS, CHANNEL_MAP...>
+    ::GetSlack() const
+{
+  PdmRxSlack slack;
+  slack.block_period = this->slack.block_period;
+  slack.last_idle = this->slack.last_idle;
+  slack.recent_min_idle = this->slack.recent_min_idle;
+  slack.min_idle = this->slack.min_idle;
+  return slack;
+}
+
+
+template <unsigned CHANNELS_IN, unsigned CHANNELS_OUT, unsigned SUBBLOCKS,
+          unsigned... CHANNEL_MAP>
+void mic_array::StandardPdmRxService<CHANNELS_IN, CHANNELS_OUT, SUBBLOCKS, CHANNEL_MAP...>
+    ::MonitorHealth(bool enable)
+{
+  this->monitor_health = enable;
+}
+
+
+template <unsigned CHANNELS_IN, unsigned CHANNELS_OUT, unsigned SUBBLOCKS,
+          unsigned... CHANNEL_MAP>
+mic_array::PdmHealth 
+    mic_array::StandardPdmRxService<CHANNELS_IN, CHANNELS_OUT, SUBBLOCKS, CHANNEL_MAP...>
+    ::GetHealth() const
+{
+  return this->health.Get();
+}
+
+
+template <unsigned CHANNELS_IN, unsigned CHANNELS_OUT, unsigned SUBBLOCKS,
+          unsigned... CHANNEL_MAP>
+mic_array::PdmBlockStamp 
+    mic_array::StandardPdmRxService<CHANNELS_IN, CHANNELS_OUT, SUBBLOCKS, CHANNEL_MAP...>
+    ::GetBlockStamp() const
+{
+  return this->stamp;
+}
+
+
+template <unsigned CHANNELS_IN, unsigned CHANNELS_OUT, unsigned SUBBLOCKS,
+          unsigned... CHANNEL_MAP>
+void mic_array::StandardPdmRxService<CHANNELS_IN, CHANNELS_OUT, SUBBLOCKS, CHANNEL_MAP...>
+    ::SetActiveChannels(uint32_t mask)
+{
+  this->active_channels = mask;
+}
+
+
+template <unsigned CHANNELS_IN, unsigned CHANNELS_OUT, unsigned SUBBLOCKS,
+          unsigned... CHANNEL_MAP>
+uint32_t mic_array::StandardPdmRxService<CHANNELS_IN, CHANNELS_OUT, SUBBLOCKS, CHANNEL_MAP...>
+    ::CopiedChannels() const
+{
+  return this->block_channels;
+}
+
+
+template <unsigned CHANNELS_IN, unsigned CHANNELS_OUT, unsigned SUBBLOCKS,
+          unsigned... CHANNEL_MAP>
+void mic_array::StandardPdmRxService<CHANNELS_IN, CHANNELS_OUT, SUBBLOCKS, CHANNEL_MAP...>
+    ::ResetStats()
+{
+  pdm_rx_isr_context.dropped_blocks = 0;
+  pdm_rx_isr_context.min_credit = 2;
+  this->max_latency = 0;
+  this->slack.min_idle = UINT32_MAX;
+}
+
+
+//////////////////////////////////////////////
+//          MultiPortPdmRxService           //
+//////////////////////////////////////////////
+
+
+template <unsigned PORT_CHANNELS, unsigned PORT_COUNT, 
+          unsigned CHANNELS_OUT, unsigned SUBBLOCKS>
+void mic_array::MultiPortPdmRxService<PORT_CHANNELS, PORT_COUNT, CHANNELS_OUT, SUBBLOCKS>
+    ::Init(const port_t ports[PORT_COUNT]) 
+{
+  for(int p = 0; p < PORT_COUNT; p++)
+    this->ports[p] = ports[p];
+
+  for(int k = 0; k < CHANNELS_OUT; k++)
+    this->channel_map[k] = k;
+
+  this->c_pdm_blocks = s_chan_alloc();
+
+  this->phase = PORT_CHANNELS;
+  this->subblock = 0;
+  this->ready_index = 0;
+  this->sent = 0;
+  this->received = 0;
+  this->max_latency = 0;
+  this->stamp = {0, 0};
+}
+
+
+template <unsigned PORT_CHANNELS, unsigned PORT_COUNT, 
+          unsigned CHANNELS_OUT, unsigned SUBBLOCKS>
+void mic_array::MultiPortPdmRxService<PORT_CHANNELS, PORT_COUNT, CHANNELS_OUT, SUBBLOCKS>
+    ::MapChannels(unsigned map[CHANNELS_OUT]) 
+{
+  for(int k = 0; k < CHANNELS_OUT; k++)
+    this->channel_map[k] = map[k];
+}
+
+
+template <unsigned PORT_CHANNELS, unsigned PORT_COUNT, 
+          unsigned CHANNELS_OUT, unsigned SUBBLOCKS>
+void mic_array::MultiPortPdmRxService<PORT_CHANNELS, PORT_COUNT, CHANNELS_OUT, SUBBLOCKS>
+    ::MapChannel(unsigned out_channel, unsigned in_channel) 
+{
+  this->channel_map[out_channel] = in_channel;
+}
+
+
+template <unsigned PORT_CHANNELS, unsigned PORT_COUNT, 
+          unsigned CHANNELS_OUT, unsigned SUBBLOCKS>
+void mic_array::MultiPortPdmRxService<PORT_CHANNELS, PORT_COUNT, CHANNELS_OUT, SUBBLOCKS>
+    ::SendBlock(uint32_t block[CHANNELS_OUT * SUBBLOCKS])
+{
+  const unsigned sent = this->sent;
+  this->send_time[sent % 2] = get_reference_time();
+  this->start_time[sent % 2] = this->block_start;
+  this->sent = sent + 1;
+
+  s_chan_out_word(this->c_pdm_blocks.end_a, 
+                  reinterpret_cast<uint32_t>( &block[0] ));
+}
+
+
+template <unsigned PORT_CHANNELS, unsigned PORT_COUNT, 
+          unsigned CHANNELS_OUT, unsigned SUBBLOCKS>
+void mic_array::MultiPortPdmRxService<PORT_CHANNELS, PORT_COUNT, CHANNELS_OUT, SUBBLOCKS>
+    ::ProcessWords(const uint32_t words[PORT_COUNT])
+{
+  --this->phase;
+  for(int p = 0; p < PORT_COUNT; p++)
+    this->rows[p][this->phase] = words[p];
+
+  if(this->phase == PORT_CHANNELS - 1 && this->subblock == 0)
+    this->block_start = get_reference_time();
+
+  if(this->phase)
+    return;
+
+  this->phase = PORT_CHANNELS;
+
+  for(int p = 0; p < PORT_COUNT; p++)
+    mic_array::deinterleave_pdm_samples<PORT_CHANNELS>(&this->rows[p][0], 1);
+
+  // Deinterleaved, the rows are indexed by input channel.
+  const uint32_t* row = &this->rows[0][0];
+  uint32_t (*out)[SUBBLOCKS] = this->ready_blocks[this->ready_index];
+  for(int ch = 0; ch < CHANNELS_OUT; ch++)
+    out[ch][this->subblock] = row[this->channel_map[ch]];
+
+  if(++this->subblock < SUBBLOCKS)
+    return;
+
+  this->subblock = 0;
+  this->ready_index ^= 1;
+  this->SendBlock(&out[0][0]);
+}
+
+
+template <unsigned PORT_CHANNELS, unsigned PORT_COUNT, 
+          unsigned CHANNELS_OUT, unsigned SUBBLOCKS>
+void mic_array::MultiPortPdmRxService<PORT_CHANNELS, PORT_COUNT, CHANNELS_OUT, SUBBLOCKS>
+    ::ThreadEntry()
+{
+  uint32_t words[PORT_COUNT];
+
+  while(1){
+    for(int p = 0; p < PORT_COUNT; p++)
+      words[p] = port_in(this->ports[p]);
+    this->ProcessWords(words);
+  }
+}
+
+
+template <unsigned PORT_CHANNELS, unsigned PORT_COUNT, 
+          unsigned CHANNELS_OUT, unsigned SUBBLOCKS>
+uint32_t* mic_array::MultiPortPdmRxService<PORT_CHANNELS, PORT_COUNT, CHANNELS_OUT, SUBBLOCKS>
+    ::GetPdmBlock() 
+{
+  uint32_t* block = (uint32_t*) s_chan_in_word(this->c_pdm_blocks.end_b);
+
+  // Read straight away, before a later block can reuse the slot.
+  const uint32_t send_time = this->send_time[this->received % 2];
+  this->stamp.block_index = this->received;
+  this->stamp.timestamp = this->start_time[this->received % 2];
+
+  const uint32_t latency = get_reference_time() - send_time;
+  if(latency > this->max_latency)
+    this->max_latency = latency;
+  this->received = this->received + 1;
+
+  return block;
+}
+
+
+template <unsigned PORT_CHANNELS, unsigned PORT_COUNT, 
+          unsigned CHANNELS_OUT, unsigned SUBBLOCKS>
+mic_array::PdmRxStats 
+    mic_array::MultiPortPdmRxService<PORT_CHANNELS, PORT_COUNT, CHANNELS_OUT, SUBBLOCKS>
+    ::GetStats() const
+{
+  PdmRxStats stats;
+  stats.blocks = this->received;
+  stats.dropped_blocks = 0;
+  stats.max_backlog = 0;
+  stats.max_latency = this->max_latency;
+  return stats;
+}
+
+
+template <unsigned PORT_CHANNELS, unsigned PORT_COUNT, 
+          unsigned CHANNELS_OUT, unsigned SUBBLOCKS>
+mic_array::PdmBlockStamp 
+    mic_array::MultiPortPdmRxService<PORT_CHANNELS, PORT_COUNT, CHANNELS_OUT, SUBBLOCKS>
+    ::GetBlockStamp() const
+{
+  return this->stamp;
+}
+
+
+//////////////////////////////////////////////
+//           ChannelPdmRxService            //
+//////////////////////////////////////////////
+
+
+template <unsigned CHANNELS_IN, unsigned CHANNELS_OUT, unsigned SUBBLOCKS>
+uint32_t mic_array::ChannelPdmRxService<CHANNELS_IN, CHANNELS_OUT, SUBBLOCKS>
+    ::ReadPort()
+{
+  return s_chan_in_word(this->c_pdm_words);
 }
 
+
 template <unsigned CHANNELS_IN, unsigned CHANNELS_OUT, unsigned SUBBLOCKS>
-void mic_array::StandardPdmRxService<CHANNELS_IN, CHANNELS_OUT, SUBBLOCKS>
-    ::AssertOnDroppedBlock(bool doAssert)
+void mic_array::ChannelPdmRxService<CHANNELS_IN, CHANNELS_OUT, SUBBLOCKS>
+    ::SendBlock(uint32_t block[CHANNELS_IN*SUBBLOCKS])
 {
-  pdm_rx_isr_context.missed_blocks = doAssert? -1 : 0;
+  const unsigned sent = this->sent;
+  this->send_time[sent % 2] = get_reference_time();
+  this->start_time[sent % 2] = this->block_start;
+  this->sent = sent + 1;
+
+  s_chan_out_word(this->c_pdm_blocks.end_a, 
+                  reinterpret_cast<uint32_t>( &block[0] ));
 }
 
+
 template <unsigned CHANNELS_IN, unsigned CHANNELS_OUT, unsigned SUBBLOCKS>
-void mic_array::StandardPdmRxService<CHANNELS_IN, CHANNELS_OUT, SUBBLOCKS>
-    ::UnmaskISR() 
+void mic_array::ChannelPdmRxService<CHANNELS_IN, CHANNELS_OUT, SUBBLOCKS>
+    ::Init(chanend_t c_pdm_words) 
 {
-  interrupt_unmask_all();
+  for(int k = 0; k < CHANNELS_OUT; k++)
+    this->channel_map[k] = k;
+
+  this->c_pdm_words = c_pdm_words;
+  this->c_pdm_blocks = s_chan_alloc();
+
+  this->sent = 0;
+  this->received = 0;
+  this->max_latency = 0;
+  this->stamp = {0, 0};
 }
 
+
 template <unsigned CHANNELS_IN, unsigned CHANNELS_OUT, unsigned SUBBLOCKS>
-uint32_t* mic_array::StandardPdmRxService<CHANNELS_IN, CHANNELS_OUT, SUBBLOCKS>
-    ::GetPdmBlock() 
+void mic_array::ChannelPdmRxService<CHANNELS_IN, CHANNELS_OUT, SUBBLOCKS>
+    ::MapChannels(unsigned map[CHANNELS_OUT]) 
 {
-  // Has to be in a critical section to avoid race conditions with ISR.
-  interrupt_mask_all();
-  pdm_rx_isr_context.credit = 2;
-  interrupt_unmask_all();
+  for(int k = 0; k < CHANNELS_OUT; k++)
+    this->channel_map[k] = map[k];
+}
+
+
+template <unsigned CHANNELS_IN, unsigned CHANNELS_OUT, unsigned SUBBLOCKS>
+void mic_array::ChannelPdmRxService<CHANNELS_IN, CHANNELS_OUT, SUBBLOCKS>
+    ::MapChannel(unsigned out_channel, unsigned in_channel) 
+{
+  this->channel_map[out_channel] = in_channel;
+}
 
 
+template <unsigned CHANNELS_IN, unsigned CHANNELS_OUT, unsigned SUBBLOCKS>
+uint32_t* mic_array::ChannelPdmRxService<CHANNELS_IN, CHANNELS_OUT, SUBBLOCKS>
+    ::GetPdmBlock() 
+{
   uint32_t* full_block = (uint32_t*) s_chan_in_word(this->c_pdm_blocks.end_b);
-  mic_array::deinterleave_pdm_samples<CHANNELS_IN>(full_block, SUBBLOCKS);
 
-  uint32_t (*block)[CHANNELS_IN] = (uint32_t (*)[CHANNELS_IN]) full_block;
+  // Read straight away, before a later block can reuse the slot.
+  const uint32_t send_time = this->send_time[this->received % 2];
+  this->stamp.block_index = this->received;
+  this->stamp.timestamp = this->start_time[this->received % 2];
+
+  mic_array::deinterleave_pdm_samples_mapped<CHANNELS_IN>(
+      &this->out_block[0][0], full_block, SUBBLOCKS, 
+      this->channel_map, CHANNELS_OUT);
+
+  const uint32_t latency = get_reference_time() - send_time;
+  if(latency > this->max_latency)
+    this->max_latency = latency;
+  this->received = this->received + 1;
+
+  return &this->out_block[0][0];
+}
+
+
+template <unsigned CHANNELS_IN, unsigned CHANNELS_OUT, unsigned SUBBLOCKS>
+mic_array::PdmRxStats 
+    mic_array::ChannelPdmRxService<CHANNELS_IN, CHANNELS_OUT, SUBBLOCKS>
+    ::GetStats() const
+{
+  PdmRxStats stats;
+  stats.blocks = this->received;
+  stats.dropped_blocks = 0;
+  stats.max_backlog = 0;
+  stats.max_latency = this->max_latency;
+  return stats;
+}
+
+
+template <unsigned CHANNELS_IN, unsigned CHANNELS_OUT, unsigned SUBBLOCKS>
+mic_array::PdmBlockStamp 
+    mic_array::ChannelPdmRxService<CHANNELS_IN, CHANNELS_OUT, SUBBLOCKS>
+    ::GetBlockStamp() const
+{
+  return this->stamp;
+}
+
+
+//////////////////////////////////////////////
+//          SharedMemPdmRxService           //
+//////////////////////////////////////////////
+
+
+template <unsigned CHANNELS_IN, unsigned CHANNELS_OUT, unsigned SUBBLOCKS,
+          unsigned BUFFER_DEPTH>
+uint32_t mic_array::SharedMemPdmRxService<CHANNELS_IN, CHANNELS_OUT, SUBBLOCKS, BUFFER_DEPTH>
+    ::ReadPort()
+{
+  return port_in(this->p_pdm_mics);
+}
+
 
-  for(int ch = 0; ch < CHANNELS_OUT; ch++) {
-    for(int sb = 0; sb < SUBBLOCKS; sb++) {
-      unsigned d = this->channel_map[ch];
-      this->out_block[ch][sb] = block[SUBBLOCKS-1-sb][d];
-    } 
+template <unsigned CHANNELS_IN, unsigned CHANNELS_OUT, unsigned SUBBLOCKS,
+          unsigned BUFFER_DEPTH>
+void mic_array::SharedMemPdmRxService<CHANNELS_IN, CHANNELS_OUT, SUBBLOCKS, BUFFER_DEPTH>
+    ::SendBlock(uint32_t block[CHANNELS_IN*SUBBLOCKS])
+{
+  pdm_rx_shmem_context_t& ctx = pdm_rx_shmem_isr_context;
+  const unsigned published = ctx.published;
+
+  const unsigned backlog = published - ctx.consumed;
+
+  if(backlog >= BUFFER_DEPTH - 1){
+    ctx.dropped_blocks++;
+    assert(ctx.missed_blocks != (unsigned) -1);
+    ctx.missed_blocks++;
+    // Refill the same buffer.
+    this->blocks[0] = &block[0];
+    return;
   }
+
+  if(backlog + 1 > ctx.max_backlog)
+    ctx.max_backlog = backlog + 1;
+
+  // The pointer must be in the ring before the counter says it is.
+  ctx.ring[published % BUFFER_DEPTH] = &block[0];
+  ctx.send_times[published % BUFFER_DEPTH] = get_reference_time();
+  ctx.published = published + 1;
+
+  this->blocks[0] = &this->block_data[(published + 1) % BUFFER_DEPTH][0];
+}
+
+
+template <unsigned CHANNELS_IN, unsigned CHANNELS_OUT, unsigned SUBBLOCKS,
+          unsigned BUFFER_DEPTH>
+void mic_array::SharedMemPdmRxService<CHANNELS_IN, CHANNELS_OUT, SUBBLOCKS, BUFFER_DEPTH>
+    ::Init(port_t p_pdm_mics) 
+{
+  for(int k = 0; k < CHANNELS_OUT; k++)
+    this->channel_map[k] = k;
+
+  this->taken = 0;
+  this->blocks[0] = &this->block_data[0][0];
+
+  pdm_rx_shmem_isr_context.pdm_buffer = &this->block_data[0][0];
+  pdm_rx_shmem_isr_context.buffers = &this->block_data[0][0];
+  pdm_rx_shmem_isr_context.published = 0;
+  pdm_rx_shmem_isr_context.consumed = 0;
+  pdm_rx_shmem_isr_context.ring = this->ring;
+  pdm_rx_shmem_isr_context.send_times = this->send_times;
+  pdm_rx_shmem_isr_context.dropped_blocks = 0;
+  pdm_rx_shmem_isr_context.max_backlog = 0;
+  this->max_latency = 0;
+  pdm_rx_shmem_isr_context.depth = BUFFER_DEPTH;
+  pdm_rx_shmem_isr_context.block_words = CHANNELS_IN*SUBBLOCKS;
+
+  this->SetPort(p_pdm_mics);
+}
+
+
+template <unsigned CHANNELS_IN, unsigned CHANNELS_OUT, unsigned SUBBLOCKS,
+          unsigned BUFFER_DEPTH>
+void mic_array::SharedMemPdmRxService<CHANNELS_IN, CHANNELS_OUT, SUBBLOCKS, BUFFER_DEPTH>
+    ::MapChannels(unsigned map[CHANNELS_OUT]) 
+{
+  for(int k = 0; k < CHANNELS_OUT; k++)
+    this->channel_map[k] = map[k];
+}
+
+
+template <unsigned CHANNELS_IN, unsigned CHANNELS_OUT, unsigned SUBBLOCKS,
+          unsigned BUFFER_DEPTH>
+void mic_array::SharedMemPdmRxService<CHANNELS_IN, CHANNELS_OUT, SUBBLOCKS, BUFFER_DEPTH>
+    ::MapChannel(unsigned out_channel, unsigned in_channel) 
+{
+  this->channel_map[out_channel] = in_channel;
+}
+
+
+template <unsigned CHANNELS_IN, unsigned CHANNELS_OUT, unsigned SUBBLOCKS,
+          unsigned BUFFER_DEPTH>
+void mic_array::SharedMemPdmRxService<CHANNELS_IN, CHANNELS_OUT, SUBBLOCKS, BUFFER_DEPTH>
+    ::InstallISR() 
+{
+  pdm_rx_shmem_isr_context.p_pdm_mics = this->p_pdm_mics;
+  pdm_rx_shmem_isr_context.phase_reset = CHANNELS_IN*SUBBLOCKS-1;
+  pdm_rx_shmem_isr_context.phase = CHANNELS_IN*SUBBLOCKS-1;
+
+  enable_pdm_rx_shmem_isr(this->p_pdm_mics);
+}
+
+template <unsigned CHANNELS_IN, unsigned CHANNELS_OUT, unsigned SUBBLOCKS,
+          unsigned BUFFER_DEPTH>
+void mic_array::SharedMemPdmRxService<CHANNELS_IN, CHANNELS_OUT, SUBBLOCKS, BUFFER_DEPTH>
+    ::AssertOnDroppedBlock(bool doAssert)
+{
+  pdm_rx_shmem_isr_context.missed_blocks = doAssert? -1 : 0;
+}
+
+template <unsigned CHANNELS_IN, unsigned CHANNELS_OUT, unsigned SUBBLOCKS,
+          unsigned BUFFER_DEPTH>
+void mic_array::SharedMemPdmRxService<CHANNELS_IN, CHANNELS_OUT, SUBBLOCKS, BUFFER_DEPTH>
+    ::UnmaskISR() 
+{
+  interrupt_unmask_all();
+}
+
+template <unsigned CHANNELS_IN, unsigned CHANNELS_OUT, unsigned SUBBLOCKS,
+          unsigned BUFFER_DEPTH>
+uint32_t* mic_array::SharedMemPdmRxService<CHANNELS_IN, CHANNELS_OUT, SUBBLOCKS, BUFFER_DEPTH>
+    ::GetPdmBlock() 
+{
+  pdm_rx_shmem_context_t& ctx = pdm_rx_shmem_isr_context;
+
+  while(ctx.published == this->taken) {}
+
+  uint32_t* full_block = ctx.ring[this->taken % BUFFER_DEPTH];
+  const uint32_t send_time = ctx.send_times[this->taken % BUFFER_DEPTH];
+
+  mic_array::deinterleave_pdm_samples_mapped<CHANNELS_IN>(
+      &this->out_block[0][0], full_block, SUBBLOCKS, 
+      this->channel_map, CHANNELS_OUT);
+
+  const uint32_t latency = get_reference_time() - send_time;
+  if(latency > this->max_latency)
+    this->max_latency = latency;
+
+  // The PDM buffer is no longer needed. A single word store, so no critical
+  // section is needed.
+  ctx.consumed = ++this->taken;
+
   return &this->out_block[0][0];
 }
+
+
+template <unsigned CHANNELS_IN, unsigned CHANNELS_OUT, unsigned SUBBLOCKS,
+          unsigned BUFFER_DEPTH>
+mic_array::PdmRxStats 
+    mic_array::SharedMemPdmRxService<CHANNELS_IN, CHANNELS_OUT, SUBBLOCKS, BUFFER_DEPTH>
+    ::GetStats() const
+{
+  PdmRxStats stats;
+  stats.blocks = pdm_rx_shmem_isr_context.consumed;
+  stats.dropped_blocks = pdm_rx_shmem_isr_context.dropped_blocks;
+  stats.max_backlog = pdm_rx_shmem_isr_context.max_backlog;
+  stats.max_latency = this->max_latency;
+  return stats;
+}
+
+
+template <unsigned CHANNELS_IN, unsigned CHANNELS_OUT, unsigned SUBBLOCKS,
+          unsigned BUFFER_DEPTH>
+void mic_array::SharedMemPdmRxService<CHANNELS_IN, CHANNELS_OUT, SUBBLOCKS, BUFFER_DEPTH>
+    ::ResetStats()
+{
+  pdm_rx_shmem_isr_context.dropped_blocks = 0;
+  pdm_rx_shmem_isr_context.max_backlog = 0;
+  this->max_latency = 0;
+}
@@ -0,0 +1,198 @@
+// Copyright 2022-2024 XMOS LIMITED.
+// This Software is subject to the terms of the XMOS Public Licence: Version 1.
+
+#pragma once
+
+#include <cstdint>
+
+#include <xcore/channel_streaming.h>
+
+#include "PdmRx.hpp"
+
+// This has caused problems previously, so just catch the problems here.
+#if defined(MIC_COUNT) || defined(SUBBLOCKS) || defined(TAP_COUNT)
+# error Application must not define the following as precompiler macros: MIC_COUNT, SUBBLOCKS, TAP_COUNT.
+#endif
+
+
+namespace  mic_array {
+
+  /**
+   * @brief PDM rx service which also forwards raw PDM data of chosen mics.
+   *
+   * `PdmTap` extends a PDM rx service, `TPdmRx` (e.g.
+   * @ref StandardPdmRxService), so that each block it hands to the decimator
+   * is also made available, undecimated, to another thread. This allows the
+   * raw PDM bitstreams of some microphones to be recorded (e.g. for field
+   * diagnostics) at the same time as the mic array produces its usual
+   * output.
+   *
+   * Nothing is copied. Each time `GetPdmBlock()` returns a block, `PdmTap`
+   * records a pointer to the `SUBBLOCKS` PDM words of each tapped mic in
+   * that block (in the `[MIC_COUNT][SUBBLOCKS]` block layout the decimator
+   * receives) and sends the address of that array of `TAP_COUNT` pointers,
+   * a single word, over the tap channel. A receiver gets it with
+   * @ref ReceiveTap(). Each word holds 32 PDM samples, oldest in the least
+   * significant bit, and a set bit is `-1`, as for the decimator.
+   *
+   * As with the block handed to the decimator, the words belong to the PDM
+   * rx service: the receiver must finish with them (e.g. copy them out)
+   * before the next block is returned, one block period later. The tap
+   * channel is a streaming channel, so the decimation thread only waits on
+   * the receiver if it falls a block behind.
+   *
+   * By default mic `k` is tapped as tap `k`; `MapTap()` chooses other mics.
+   * Until `SetTapChannel()` is called nothing is sent, so the tap costs the
+   * decimation thread nothing beyond a test.
+   *
+   * @code{.cpp}
+   *  using TPdmRx = mic_array::PdmTap<
+   *      mic_array::StandardPdmRxService<MICS, MICS, SUBBLOCKS>,
+   *      MICS, SUBBLOCKS, 2>;
+   *  ...
+   *  // On the recording thread
+   *  const uint32_t* const* rows = TPdmRx::ReceiveTap(c_tap.end_b);
+   *  memcpy(buff0, rows[0], SUBBLOCKS * sizeof(uint32_t));
+   *  memcpy(buff1, rows[1], SUBBLOCKS * sizeof(uint32_t));
+   * @endcode
+   *
+   * @tparam TPdmRx     PDM rx service being extended.
+   * @tparam MIC_COUNT  Number of mics in each block `TPdmRx` delivers.
+   * @tparam SUBBLOCKS  Number of PDM words per mic in each block.
+   * @tparam TAP_COUNT  Number of mics tapped.
+   */
+  template <class TPdmRx, unsigned MIC_COUNT, unsigned SUBBLOCKS,
+            unsigned TAP_COUNT = MIC_COUNT>
+  class PdmTap : public TPdmRx
+  {
+    static_assert(TAP_COUNT >= 1 && TAP_COUNT <= MIC_COUNT,
+                  "TAP_COUNT must be from 1 to MIC_COUNT.");
+
+    private:
+
+      /**
+       * @brief Streaming chanend on which the tap is sent, or `0`.
+       */
+      chanend_t c_tap = 0;
+
+      /**
+       * @brief Mic index of each tap.
+       */
+      unsigned tap_map[TAP_COUNT];
+
+      /**
+       * @brief Whether `MapTap()` has set `tap_map`.
+       */
+      bool mapped = false;
+
+      /**
+       * @brief PDM words of each tapped mic in the current block.
+       */
+      const uint32_t* rows[TAP_COUNT];
+
+    public:
+
+      using TPdmRx::TPdmRx;
+
+      /**
+       * @brief Set the chanend the tap is sent on.
+       *
+       * `c_tap` is the transmitting end of a streaming channel. A value of
+       * `0` (the default) stops the tap. Unless `MapTap()` has been called,
+       * tap `k` is mic `k`.
+       *
+       * @param c_tap  Streaming chanend to send the tap on.
+       */
+      void SetTapChannel(chanend_t c_tap);
+
+      /**
+       * @brief Choose the tapped mics.
+       *
+       * Tap `k` becomes mic `map[k]` of the block delivered to the
+       * decimator (i.e. after any mapping by `TPdmRx`).
+       *
+       * @param map  Mic index of each tap.
+       */
+      void MapTap(const unsigned map[TAP_COUNT]);
+
+      /**
+       * @brief Get a block of PDM data, and send it on the tap.
+       *
+       * Calls `TPdmRx::GetPdmBlock()`, and if a tap channel is set, sends
+       * the tapped mics' words on it.
+       *
+       * @returns Pointer to block of PDM data.
+       */
+      uint32_t* GetPdmBlock();
+
+      /**
+       * @brief Receive a block from the tap.
+       *
+       * Waits for the next block sent on the tap. Called on the receiving
+       * thread.
+       *
+       * @param c_tap  Receiving end of the tap's streaming channel.
+       *
+       * @returns Array of `TAP_COUNT` pointers, the `k`th to the `SUBBLOCKS`
+       *          PDM words of tap `k`, oldest first.
+       */
+      static const uint32_t* const* ReceiveTap(chanend_t c_tap);
+  };
+
+}
+
+//////////////////////////////////////////////
+// Template function implementations below. //
+//////////////////////////////////////////////
+
+
+template <class TPdmRx, unsigned MIC_COUNT, unsigned SUBBLOCKS,
+          unsigned TAP_COUNT>
+void mic_array::PdmTap<TPdmRx, MIC_COUNT, SUBBLOCKS, TAP_COUNT>
+    ::SetTapChannel(chanend_t c_tap)
+{
+  if(!this->mapped)
+    for(unsigned k = 0; k < TAP_COUNT; k++)
+      this->tap_map[k] = k;
+  this->c_tap = c_tap;
+}
+
+
+template <class TPdmRx, unsigned MIC_COUNT, unsigned SUBBLOCKS,
+          unsigned TAP_COUNT>
+void mic_array::PdmTap<TPdmRx, MIC_COUNT, SUBBLOCKS, TAP_COUNT>
+    ::MapTap(const unsigned map[TAP_COUNT])
+{
+  for(unsigned k = 0; k < TAP_COUNT; k++){
+    assert(map[k] < MIC_COUNT);
+    this->tap_map[k] = map[k];
+  }
+  this->mapped = true;
+}
+
+
+template <class TPdmRx, unsigned MIC_COUNT, unsigned SUBBLOCKS,
+          unsigned TAP_COUNT>
+uint32_t* mic_array::PdmTap<TPdmRx, MIC_COUNT, SUBBLOCKS, TAP_COUNT>
+    ::GetPdmBlock()
+{
+  uint32_t* block = TPdmRx::GetPdmBlock();
+
+  if(this->c_tap){
+    for(unsigned k = 0; k < TAP_COUNT; k++)
+      this->rows[k] = &block[this->tap_map[k] * SUBBLOCKS];
+    s_chan_out_word(this->c_tap, 
+                    reinterpret_cast<uint32_t>( &this->rows[0] ));
+  }
+
+  return block;
+}
+
+
+template <class TPdmRx, unsigned MIC_COUNT, unsigned SUBBLOCKS,
+          unsigned TAP_COUNT>
+const uint32_t* const* mic_array::PdmTap<TPdmRx, MIC_COUNT, SUBBLOCKS, TAP_COUNT>
+    ::ReceiveTap(chanend_t c_tap)
+{
+  return (const uint32_t* const*) s_chan_in_word(c_tap);
+}
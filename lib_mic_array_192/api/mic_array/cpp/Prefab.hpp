@@ -3,15 +3,22 @@
 
 #pragma once
 
+#include <cstdint>
 #include <type_traits>
 
 #include "MicArray.hpp"
+#include "DecimatorParallel.hpp"
+#include "DecimatorPassthrough.hpp"
+#include "Mips.hpp"
 #include "mic_array/etc/filters_default.h"
 
 // This has caused problems previously, so just catch the problems here.
 #if defined(MIC_COUNT) || defined(MICS_IN) || defined(FRAME_SIZE) || defined(USE_DCOE)
 # error Application must not define the following as precompiler macros: MIC_COUNT, MICS_IN, FRAME_SIZE, USE_DCOE.
 #endif
+#if defined(RATE) || defined(THREADS)
+# error Application must not define the following as precompiler macros: RATE, THREADS.
+#endif
 
 namespace mic_array {
 
@@ -110,7 +117,10 @@ namespace mic_array {
      * microphone per port pin), then `MICS_IN` must be the same as the port
      * width. If the application is running in a DDR microphone configuration,
      * `MICS_IN` must be twice the port width. `MICS_IN` defaults to
-     * `MIC_COUNT`.
+     * `PdmCaptureChannels<MIC_COUNT>::value`, the smallest capturable channel
+     * count (`1`, `2`, `4`, `8` or `16`) which is at least `MIC_COUNT`. So,
+     * e.g., a 6-mic array is captured as 8 channels, deinterleaved, and only
+     * its 6 wired channels are decimated, without having to set `MICS_IN`.
      * @endparblock
      * 
      * @par Allocation
@@ -332,7 +342,8 @@ namespace mic_array {
      * @tparam FRAME_SIZE Number of samples in each output audio frame.
      * @tparam USE_DCOE   Whether DC offset elimination should be used.
      */
-    template <unsigned MIC_COUNT, unsigned FRAME_SIZE, bool USE_DCOE, unsigned MICS_IN=MIC_COUNT>
+    template <unsigned MIC_COUNT, unsigned FRAME_SIZE, bool USE_DCOE,
+              unsigned MICS_IN = PdmCaptureChannels<MIC_COUNT>::value>
     class BasicMicArray 
         : public MicArray<MIC_COUNT,
                           TwoStageDecimator<MIC_COUNT, STAGE2_DEC_FACTOR, 
@@ -450,6 +461,753 @@ namespace mic_array {
 
     };
 
+
+    /**
+     * @brief Class template for a bare-metal 192 kHz mic array unit.
+     * 
+     * This prefab is the 192 kHz counterpart of @ref BasicMicArray. Instead of
+     * the two stage decimator it uses @ref mic_array::OneStageDecimator192,
+     * which decimates the PDM stream by a factor of 16 in a single stage.
+     * 
+     * To get 192 kHz audio output from the `Basic192MicArray` prefab, the PDM
+     * clock must be configured to `3.072 MHz` (`3.072 MHz / 16 = 192 kHz`).
+     * 
+     * Each 32-sample PDM word yields two output samples. By default the PDM
+     * rx service hands a new block to the decimator after every port read
+     * (i.e. `SUBBLOCKS` is `1`); a larger `SUBBLOCKS` hands over `SUBBLOCKS`
+     * words per mic at a time (see @ref OneStageDecimator192). All output
+     * samples of a block are passed through the sample filter and into the
+     * current frame by @ref MicArray::ThreadEntry() directly; no intermediate
+     * copy is made.
+     * 
+     * Allocation, initialization and start-up follow exactly the same steps
+     * as for @ref BasicMicArray, and the template parameters have the same
+     * meaning.
+     * 
+     * When `USE_DCOE` is `true`, the DCOE filter's pole is moved for the 
+     * higher output rate (`DcoePoleShr<40, 192000>::value`), keeping its
+     * corner near the 40 Hz of @ref BasicMicArray. The filter is applied
+     * inside the decimator, as `Decimator.SampleFilter`, as each sample is 
+     * produced; `SampleFilter` is a @ref NopSampleFilter.
+     * 
+     * @note With `SUBBLOCKS` equal to `1` the PDM rx ISR signals the
+     * decimation thread every 32 PDM clock cycles. The real-time constraint
+     * is correspondingly tighter than for @ref BasicMicArray. A `SUBBLOCKS`
+     * of e.g. `6` or `8` relaxes it by that factor, for `32*(SUBBLOCKS-1)`
+     * PDM clock cycles more latency.
+     * 
+     * @tparam MIC_COUNT  Number of microphone channels.
+     * @tparam FRAME_SIZE Number of samples in each output audio frame.
+     * @tparam USE_DCOE   Whether DC offset elimination should be used.
+     * @tparam MICS_IN    Number of microphone channels captured by the port.
+     * @tparam SUBBLOCKS  Number of PDM words per mic in each block.
+     */
+    template <unsigned MIC_COUNT, unsigned FRAME_SIZE, bool USE_DCOE,
+              unsigned MICS_IN = PdmCaptureChannels<MIC_COUNT>::value,
+              unsigned SUBBLOCKS = 1>
+    class Basic192MicArray 
+        : public MicArray<MIC_COUNT,
+                          OneStageDecimator192<MIC_COUNT,
+                              typename std::conditional<USE_DCOE,
+                                  DcoeSampleFilter<MIC_COUNT,
+                                      DcoePoleShr<40, 192000>::value>,
+                                  NopSampleFilter<MIC_COUNT>>::type,
+                              16, SUBBLOCKS>,
+                          StandardPdmRxService<MICS_IN,MIC_COUNT,SUBBLOCKS>, 
+                          NopSampleFilter<MIC_COUNT>,
+                          FrameOutputHandler<MIC_COUNT, FRAME_SIZE, 
+                                             ChannelFrameTransmitter>>
+    {
+
+      public:
+        /**
+         * `TParent` is an alias for this class template from which this class
+         * template inherits.
+         */
+        using TParent = MicArray<MIC_COUNT,
+                                 OneStageDecimator192<MIC_COUNT,
+                                    typename std::conditional<USE_DCOE,
+                                        DcoeSampleFilter<MIC_COUNT,
+                                            DcoePoleShr<40, 192000>::value>,
+                                        NopSampleFilter<MIC_COUNT>>::type,
+                                    16, SUBBLOCKS>,
+                                 StandardPdmRxService<MICS_IN,MIC_COUNT,SUBBLOCKS>, 
+                                 NopSampleFilter<MIC_COUNT>,
+                                 FrameOutputHandler<MIC_COUNT, FRAME_SIZE, 
+                                    ChannelFrameTransmitter>>;
+
+        /**
+         * @brief No-argument constructor.
+         * 
+         * This constructor allocates the mic array and nothing more.
+         * 
+         * Call Basic192MicArray::Init() to initialize the decimator.
+         * 
+         * Subsequent calls to `Basic192MicArray::SetPort()` and
+         * `Basic192MicArray::SetOutputChannel()` will also be required before
+         * any processing begins.
+         */
+        constexpr Basic192MicArray() noexcept {}
+
+        /**
+         * @brief Initialize the decimator.
+         */
+        void Init();
+
+        /**
+         * @brief Initialzing constructor.
+         * 
+         * This constructor initializes the decimator and sets the port and
+         * output channel. It does _not_ install the ISR for PDM rx.
+         * 
+         * @param p_pdm_mics    Port with PDM microphones
+         * @param c_frames_out  (non-streaming) chanend used to transmit frames.
+         */
+        Basic192MicArray(
+            port_t p_pdm_mics,
+            chanend_t c_frames_out);
+
+        /**
+         * @brief Set the PDM data port.
+         * 
+         * This function calls `this->PdmRx.Init(p_pdm_mics)`.
+         * 
+         * @param p_pdm_mics  The port to receive PDM data on.
+         */
+        void SetPort(
+            port_t p_pdm_mics);
+
+        /**
+         * @brief Set the audio frame output channel.
+         * 
+         * This function calls 
+         * `this->OutputHandler.FrameTx.SetChannel(c_frames_out)`.
+         * 
+         * @param c_frames_out The channel to send audio frames on.
+         */
+        void SetOutputChannel(
+            chanend_t c_frames_out);
+
+        /**
+         * @brief Entry point for PDM rx thread.
+         * 
+         * This function calls `this->PdmRx.ThreadEntry()`.
+         * 
+         * @note This call does not return.
+         */
+        void PdmRxThreadEntry();
+
+        /**
+         * @brief Install the PDM rx ISR on the calling thread.
+         * 
+         * This function calls `this->PdmRx.InstallISR()`.
+         */
+        void InstallPdmRxISR();
+
+        /**
+         * @brief Unmask interrupts on the calling thread.
+         * 
+         * This function calls `this->PdmRx.UnmaskISR()`.
+         */
+        void UnmaskPdmRxISR();
+    };
+
+
+    /**
+     * @brief Class template for a mic array unit which captures raw PDM.
+     * 
+     * This prefab does no decimation at all. It delivers the raw PDM
+     * bitstream of each microphone, using @ref PdmPassthroughDecimator in
+     * place of a decimator, for bulk capture of PDM data (e.g. to analyse or
+     * decimate it elsewhere). The decimation thread only deinterleaves the
+     * PDM data and moves it into frames, so it has far more slack than with
+     * either of the other prefabs.
+     * 
+     * Each "sample" of an output frame is a PDM word: 32 PDM samples of a
+     * mic, the oldest in the least significant bit, with a set bit meaning
+     * `-1`. A frame of `FRAME_SIZE` samples per mic therefore holds 
+     * `32 * FRAME_SIZE` PDM samples of each, and frames arrive at the PDM
+     * clock rate divided by `32 * FRAME_SIZE`. Frames are received as for
+     * @ref BasicMicArray (e.g. with `ma_frame_rx()`), as `int32_t`, which
+     * the receiver reinterprets as `uint32_t` PDM words.
+     * 
+     * Allocation, initialization and start-up follow exactly the same steps
+     * as for @ref BasicMicArray, and the template parameters have the same
+     * meaning; there is no DC offset elimination, so no `USE_DCOE`. Set
+     * `SettlingSamples` to `0` to keep the PDM data captured while the
+     * microphones settle.
+     * 
+     * To record raw PDM at the same time as decimating it, use @ref PdmTap
+     * with one of the other prefabs' configurations instead.
+     * 
+     * @tparam MIC_COUNT  Number of microphone channels.
+     * @tparam FRAME_SIZE Number of PDM words per mic in each output frame.
+     * @tparam MICS_IN    Number of microphone channels captured by the port.
+     * @tparam SUBBLOCKS  Number of PDM words per mic in each block.
+     */
+    template <unsigned MIC_COUNT, unsigned FRAME_SIZE,
+              unsigned MICS_IN = PdmCaptureChannels<MIC_COUNT>::value,
+              unsigned SUBBLOCKS = FRAME_SIZE>
+    class PdmCaptureMicArray 
+        : public MicArray<MIC_COUNT,
+                          PdmPassthroughDecimator<MIC_COUNT, SUBBLOCKS>,
+                          StandardPdmRxService<MICS_IN,MIC_COUNT,SUBBLOCKS>, 
+                          NopSampleFilter<MIC_COUNT>,
+                          FrameOutputHandler<MIC_COUNT, FRAME_SIZE, 
+                                             ChannelFrameTransmitter>>
+    {
+
+      public:
+        /**
+         * `TParent` is an alias for this class template from which this class
+         * template inherits.
+         */
+        using TParent = MicArray<MIC_COUNT,
+                                 PdmPassthroughDecimator<MIC_COUNT, SUBBLOCKS>,
+                                 StandardPdmRxService<MICS_IN,MIC_COUNT,SUBBLOCKS>, 
+                                 NopSampleFilter<MIC_COUNT>,
+                                 FrameOutputHandler<MIC_COUNT, FRAME_SIZE, 
+                                    ChannelFrameTransmitter>>;
+
+        /**
+         * @brief No-argument constructor.
+         * 
+         * This constructor allocates the mic array and nothing more.
+         * 
+         * Subsequent calls to `PdmCaptureMicArray::SetPort()` and
+         * `PdmCaptureMicArray::SetOutputChannel()` will be required before
+         * any processing begins.
+         */
+        constexpr PdmCaptureMicArray() noexcept {}
+
+        /**
+         * @brief Initialzing constructor.
+         * 
+         * This constructor sets the port and output channel. It does _not_
+         * install the ISR for PDM rx.
+         * 
+         * @param p_pdm_mics    Port with PDM microphones
+         * @param c_frames_out  (non-streaming) chanend used to transmit frames.
+         */
+        PdmCaptureMicArray(
+            port_t p_pdm_mics,
+            chanend_t c_frames_out);
+
+        /**
+         * @brief Set the PDM data port.
+         * 
+         * This function calls `this->PdmRx.Init(p_pdm_mics)`.
+         * 
+         * @param p_pdm_mics  The port to receive PDM data on.
+         */
+        void SetPort(
+            port_t p_pdm_mics);
+
+        /**
+         * @brief Set the frame output channel.
+         * 
+         * This function calls 
+         * `this->OutputHandler.FrameTx.SetChannel(c_frames_out)`.
+         * 
+         * @param c_frames_out The channel to send frames on.
+         */
+        void SetOutputChannel(
+            chanend_t c_frames_out);
+
+        /**
+         * @brief Entry point for PDM rx thread.
+         * 
+         * This function calls `this->PdmRx.ThreadEntry()`.
+         * 
+         * @note This call does not return.
+         */
+        void PdmRxThreadEntry();
+
+        /**
+         * @brief Install the PDM rx ISR on the calling thread.
+         * 
+         * This function calls `this->PdmRx.InstallISR()`.
+         */
+        void InstallPdmRxISR();
+
+        /**
+         * @brief Unmask interrupts on the calling thread.
+         * 
+         * This function calls `this->PdmRx.UnmaskISR()`.
+         */
+        void UnmaskPdmRxISR();
+    };
+
+
+    /**
+     * @brief How a @ref ScalableMicArray shares its work between threads.
+     */
+    enum ScalableMode : unsigned {
+      /** PDM capture, decimation and output all on the decimation thread, 
+       *  with neither an ISR nor a PDM rx thread (see 
+       *  @ref StandardPdmRxService::CaptureInDecimatorThread()). */
+      SCALABLE_SINGLE_THREAD = 0,
+      /** The PDM rx ISR and the whole decimator on the decimation thread. */
+      SCALABLE_ISR_THREAD,
+      /** The PDM rx ISR on the decimation thread, and the decimator split 
+       *  between it and worker threads (see @ref ParallelDecimator). */
+      SCALABLE_PARALLEL,
+      /** No configuration meets real time with the threads allowed. */
+      SCALABLE_NONE,
+    };
+
+
+    /**
+     * @brief Adapts the decimator of a @ref ScalableMicArray to a class
+     *        template of the mic count only, for use with 
+     *        @ref ParallelDecimator.
+     * 
+     * @tparam RATE       Output sample rate in Hz, `16000` or `192000`.
+     * @tparam USE_DCOE   Whether DC offset elimination should be used.
+     * @tparam SUBBLOCKS  Number of PDM words per mic in each block.
+     */
+    template <unsigned RATE, bool USE_DCOE, unsigned SUBBLOCKS>
+    struct ScalableDecimatorOf
+    {
+      /**
+       * The decimator of @ref BasicMicArray or @ref Basic192MicArray, with
+       * `MIC_COUNT` microphones.
+       */
+      template <unsigned MIC_COUNT>
+      using Type = typename std::conditional<RATE == 192000,
+          OneStageDecimator192<MIC_COUNT,
+              typename std::conditional<USE_DCOE,
+                  DcoeSampleFilter<MIC_COUNT, DcoePoleShr<40, 192000>::value>,
+                  NopSampleFilter<MIC_COUNT>>::type,
+              16, SUBBLOCKS>,
+          TwoStageDecimator<MIC_COUNT, STAGE2_DEC_FACTOR, 
+                            STAGE2_TAP_COUNT>>::type;
+    };
+
+
+    /**
+     * @brief Estimated load of each part of a @ref ScalableMicArray.
+     * 
+     * The decimators are those of @ref BasicMicArray (16 kHz) and 
+     * @ref Basic192MicArray (192 kHz), with a 3.072 MHz PDM clock. The
+     * estimates are the `RequiredMips()` of the components (see
+     * @ref KernelCost), so they are only as good as those; enabling DC 
+     * offset elimination makes little difference to them.
+     * 
+     * @tparam MIC_COUNT  Number of microphone channels.
+     * @tparam RATE       Output sample rate in Hz, `16000` or `192000`.
+     * @tparam FRAME_SIZE Number of samples in each output audio frame.
+     * @tparam MICS_IN    Number of microphone channels captured by the port.
+     */
+    template <unsigned MIC_COUNT, unsigned RATE, unsigned FRAME_SIZE, 
+              unsigned MICS_IN>
+    struct ScalableMicArrayCost
+    {
+      static_assert(RATE == 16000 || RATE == 192000,
+                    "RATE must be 16000 or 192000.");
+
+      /** PDM clock frequency, in Hz. */
+      static constexpr unsigned PdmFreq = 3072000;
+
+      /** PDM words per mic in each block. */
+      static constexpr unsigned SubBlocks = (RATE == 192000)? 8 
+                                                            : STAGE2_DEC_FACTOR;
+
+      /** PDM blocks per second. */
+      static constexpr unsigned BlockRate = PdmFreq / (32 * SubBlocks);
+
+      /** The decimator of one microphone. */
+      using TDecimator1 = typename ScalableDecimatorOf<RATE, false, SubBlocks>
+                              ::template Type<1>;
+
+      /** The PDM rx service. */
+      using TPdmRx = StandardPdmRxService<MICS_IN, MIC_COUNT, SubBlocks>;
+
+      /** The output handler. */
+      using TOutputHandler = FrameOutputHandler<MIC_COUNT, FRAME_SIZE, 
+                                                ChannelFrameTransmitter>;
+
+      /**
+       * @brief MIPS to decimate `mics` microphones.
+       */
+      static constexpr float DecimatorMips(
+          unsigned mics)
+      {
+        return mics * TDecimator1::RequiredMips(PdmFreq);
+      }
+
+      /**
+       * @brief MIPS of the PDM rx ISR.
+       */
+      static constexpr float IsrMips()
+      {
+        return TPdmRx::RequiredMips(PdmFreq, true) 
+             - TPdmRx::RequiredMips(PdmFreq, false);
+      }
+
+      /**
+       * @brief MIPS of the decimation thread, other than the PDM rx ISR, 
+       *        with the decimator split between `workers` threads.
+       * 
+       * The decimation thread decimates `lead` of the microphones (see
+       * @ref ParallelDecimator), and gets, deinterleaves and outputs the 
+       * samples of them all.
+       */
+      static constexpr float ThreadMips(
+          unsigned workers,
+          unsigned lead)
+      {
+        return DecimatorMips(lead) 
+             + TPdmRx::RequiredMips(PdmFreq, false)
+             + TOutputHandler::RequiredMips(RATE)
+             + float(BlockRate) * (workers - 1) * KernelCost::WorkerBlock 
+                  / 1e6f;
+      }
+
+      /**
+       * @brief Largest share of the other microphones decimated by a worker
+       *        thread, when the decimation thread decimates `lead`.
+       */
+      static constexpr unsigned WorkerMics(
+          unsigned workers,
+          unsigned lead)
+      {
+        return (workers == 1)? 0 
+             : (MIC_COUNT - lead + workers - 2) / (workers - 1);
+      }
+
+      /**
+       * @brief Whether the decimation thread can process each block within
+       *        one port word time, and so capture the PDM data itself.
+       */
+      static constexpr bool FitsSingleThread()
+      {
+        // 1 / BlockRate seconds of work per block, within SubBlocks times less
+        return FitsThreadMips(ThreadMips(1, MIC_COUNT) * SubBlocks);
+      }
+
+      /**
+       * @brief The most microphones, up to `lead`, which the decimation 
+       *        thread can decimate alongside the PDM rx ISR with the
+       *        decimator split between `workers` threads, or `0` if that
+       *        does not meet real time.
+       * 
+       * The decimation thread's other work does not shrink with more
+       * workers, so it is given fewer microphones than the workers where
+       * that lets the split fit.
+       */
+      static constexpr unsigned LeadMics(
+          unsigned workers,
+          unsigned lead)
+      {
+        return (lead == 0)? 0
+             : !FitsThreadMips(ThreadMips(workers, lead) + IsrMips())? 
+                  LeadMics(workers, lead - 1)
+             : FitsThreadMips(DecimatorMips(WorkerMics(workers, lead)))? lead
+             : 0;
+      }
+
+      /**
+       * @brief As `LeadMics(workers, lead)`, starting from an even share
+       *        (or all of the microphones, for one thread).
+       */
+      static constexpr unsigned LeadMics(
+          unsigned workers)
+      {
+        return (workers == 1)? 
+              (FitsThreadMips(ThreadMips(1, MIC_COUNT) + IsrMips())? 
+                  MIC_COUNT : 0)
+             : LeadMics(workers, MIC_COUNT / workers);
+      }
+
+      /**
+       * @brief Whether the decimator split between `workers` threads, with
+       *        the PDM rx ISR, meets real time.
+       */
+      static constexpr bool Fits(
+          unsigned workers)
+      {
+        return LeadMics(workers) != 0;
+      }
+
+      /**
+       * @brief The fewest workers, from `workers` up to `threads`, which
+       *        meet real time, or `0` if none do.
+       */
+      static constexpr unsigned FewestWorkers(
+          unsigned workers,
+          unsigned threads)
+      {
+        return (workers > threads || workers > MIC_COUNT)? 0
+             : Fits(workers)? workers 
+             : FewestWorkers(workers + 1, threads);
+      }
+    };
+
+
+    /**
+     * @brief Compile-time choice of how a @ref ScalableMicArray shares its 
+     *        work between at most `THREADS` threads.
+     * 
+     * Using the estimates of @ref ScalableMicArrayCost, and assuming each 
+     * thread gets @ref MIC_ARRAY_CONFIG_THREAD_MIPS, the first of these
+     * which meets real time is chosen as @ref Mode:
+     * 
+     * - @ref SCALABLE_SINGLE_THREAD, if the decimation thread can process
+     *   each block in the time of one port word (the port buffers no more);
+     * - @ref SCALABLE_ISR_THREAD, if the decimation thread can also run the
+     *   PDM rx ISR;
+     * - @ref SCALABLE_PARALLEL, with the fewest @ref Workers (at most 
+     *   `THREADS`) for which neither the decimation thread nor any worker
+     *   is over budget, the decimation thread taking a smaller share of the
+     *   microphones (@ref LeadMics) where that is needed;
+     * 
+     * or otherwise @ref SCALABLE_NONE.
+     * 
+     * @tparam MIC_COUNT  Number of microphone channels.
+     * @tparam RATE       Output sample rate in Hz, `16000` or `192000`.
+     * @tparam THREADS    Most hardware threads the mic array may use.
+     * @tparam FRAME_SIZE Number of samples in each output audio frame.
+     * @tparam MICS_IN    Number of microphone channels captured by the port.
+     */
+    template <unsigned MIC_COUNT, unsigned RATE, unsigned THREADS,
+              unsigned FRAME_SIZE = RATE / 1000,
+              unsigned MICS_IN = PdmCaptureChannels<MIC_COUNT>::value>
+    struct ScalableMicArrayPlan
+    {
+      static_assert(THREADS >= 1, "THREADS must be at least 1.");
+
+      /** The cost model. */
+      using Cost = ScalableMicArrayCost<MIC_COUNT, RATE, FRAME_SIZE, MICS_IN>;
+
+      /** How the work is shared between threads. */
+      static constexpr ScalableMode Mode = 
+          Cost::FitsSingleThread()?         SCALABLE_SINGLE_THREAD
+        : Cost::Fits(1)?                    SCALABLE_ISR_THREAD
+        : Cost::FewestWorkers(2, THREADS)?  SCALABLE_PARALLEL
+        :                                   SCALABLE_NONE;
+
+      /** Number of threads the decimator is split between, including the 
+       *  decimation thread. */
+      static constexpr unsigned Workers = 
+          (Mode == SCALABLE_PARALLEL)? Cost::FewestWorkers(2, THREADS) : 1;
+
+      /** Number of microphones decimated by the decimation thread itself. */
+      static constexpr unsigned LeadMics = 
+          (Mode == SCALABLE_PARALLEL)? Cost::LeadMics(Workers) : MIC_COUNT;
+
+      /** Estimated MIPS of the decimation thread. */
+      static constexpr float ThreadMips = Cost::ThreadMips(Workers, LeadMics) 
+            + ((Mode == SCALABLE_SINGLE_THREAD)? 0 : Cost::IsrMips());
+
+      /** @ref ThreadMips, rounded up. */
+      static constexpr unsigned RequiredMips = 
+          unsigned(ThreadMips) + (ThreadMips > unsigned(ThreadMips));
+    };
+
+
+    /**
+     * @brief The @ref MicArray from which a @ref ScalableMicArray inherits.
+     */
+    template <unsigned MIC_COUNT, unsigned RATE, unsigned THREADS,
+              unsigned FRAME_SIZE, bool USE_DCOE, unsigned MICS_IN>
+    using ScalableMicArrayParent = MicArray<MIC_COUNT,
+        typename std::conditional<
+            ScalableMicArrayPlan<MIC_COUNT, RATE, THREADS, FRAME_SIZE, 
+                                 MICS_IN>::Workers == 1,
+            typename ScalableDecimatorOf<RATE, USE_DCOE,
+                ScalableMicArrayCost<MIC_COUNT, RATE, FRAME_SIZE, 
+                                     MICS_IN>::SubBlocks>
+                ::template Type<MIC_COUNT>,
+            ParallelDecimator<MIC_COUNT, 
+                ScalableMicArrayPlan<MIC_COUNT, RATE, THREADS, FRAME_SIZE,
+                                     MICS_IN>::Workers,
+                ScalableDecimatorOf<RATE, USE_DCOE,
+                    ScalableMicArrayCost<MIC_COUNT, RATE, FRAME_SIZE,
+                                         MICS_IN>::SubBlocks>
+                    ::template Type,
+                MIC_ARRAY_PARALLEL_WORKER_STACK_WORDS,
+                ScalableMicArrayPlan<MIC_COUNT, RATE, THREADS, FRAME_SIZE,
+                                     MICS_IN>::LeadMics>>::type,
+        typename ScalableMicArrayCost<MIC_COUNT, RATE, FRAME_SIZE, 
+                                      MICS_IN>::TPdmRx,
+        typename std::conditional<USE_DCOE && RATE != 192000,
+                                  DcoeSampleFilter<MIC_COUNT>,
+                                  NopSampleFilter<MIC_COUNT>>::type,
+        typename ScalableMicArrayCost<MIC_COUNT, RATE, FRAME_SIZE, 
+                                      MICS_IN>::TOutputHandler>;
+
+
+    /**
+     * @brief Class template for a mic array unit which spreads itself over
+     *        as many threads as it needs.
+     * 
+     * This prefab has the decimator of @ref BasicMicArray (for a `RATE` of
+     * `16000`) or of @ref Basic192MicArray (for a `RATE` of `192000`, with 
+     * blocks of 8 PDM words per mic), and chooses at compile time how to
+     * share the work between at most `THREADS` hardware threads, as
+     * described by @ref ScalableMicArrayPlan: with the PDM data captured on
+     * the decimation thread itself, with the PDM rx ISR on the decimation 
+     * thread, or with the PDM rx ISR and the decimator split between the
+     * decimation thread and worker threads (@ref ParallelDecimator). The
+     * choice is `Plan::Mode`.
+     * 
+     * A configuration which cannot meet real time on `THREADS` threads 
+     * fails to compile, rather than dropping blocks on the hardware. The 
+     * check relies on the estimates of @ref ScalableMicArrayCost and on each
+     * thread getting @ref MIC_ARRAY_CONFIG_THREAD_MIPS, so it is only as
+     * good as those; measure the slack of the running mic array (see 
+     * @ref StandardPdmRxService::GetSlack()) to confirm it.
+     * 
+     * The PDM clock must be 3.072 MHz. Allocation and initialization follow
+     * the same steps as for @ref BasicMicArray, but the decimation thread is
+     * entered with @ref DecimationThreadEntry(), which sets up PDM capture
+     * (and any worker threads) as the plan requires, so there is neither a
+     * PDM rx thread nor any ISR to install:
+     * 
+     * @code{.cpp}
+     * using AppMicArray = mic_array::prefab::ScalableMicArray<8,192000,4>;
+     * AppMicArray mics;
+     * ...
+     * mics.Init();
+     * mics.SetPort(pdm_res.p_pdm_mics);
+     * mics.SetOutputChannel(c_frames_out);
+     * mics.DecimationThreadEntry();
+     * @endcode
+     * 
+     * @tparam MIC_COUNT  Number of microphone channels.
+     * @tparam RATE       Output sample rate in Hz, `16000` or `192000`.
+     * @tparam THREADS    @parblock
+     * Most hardware threads the mic array may use. Each is taken from the 8
+     * of the tile for as long as the mic array runs, besides the PDM rx 
+     * ISR's share of the decimation thread, so a `THREADS` of more than `4` 
+     * leaves little for the application; only allow more where it needs
+     * few threads of its own. The plan uses no more threads than it needs.
+     * @endparblock
+     * @tparam FRAME_SIZE Number of samples in each output audio frame.
+     * @tparam USE_DCOE   Whether DC offset elimination should be used.
+     * @tparam MICS_IN    Number of microphone channels captured by the port.
+     */
+    template <unsigned MIC_COUNT, unsigned RATE, unsigned THREADS,
+              unsigned FRAME_SIZE = RATE / 1000, bool USE_DCOE = true,
+              unsigned MICS_IN = PdmCaptureChannels<MIC_COUNT>::value>
+    class ScalableMicArray 
+        : public ScalableMicArrayParent<MIC_COUNT, RATE, THREADS, FRAME_SIZE,
+                                        USE_DCOE, MICS_IN>
+    {
+
+      public:
+        /**
+         * `TParent` is an alias for this class template from which this class
+         * template inherits.
+         */
+        using TParent = ScalableMicArrayParent<MIC_COUNT, RATE, THREADS, 
+                                               FRAME_SIZE, USE_DCOE, MICS_IN>;
+
+        /**
+         * How this mic array shares its work between threads.
+         */
+        using Plan = ScalableMicArrayPlan<MIC_COUNT, RATE, THREADS, FRAME_SIZE, 
+                                          MICS_IN>;
+
+        static_assert(Plan::Mode != SCALABLE_NONE, 
+            "This mic array cannot meet real time with THREADS threads; "
+            "see ScalableMicArrayPlan.");
+
+        /**
+         * @brief No-argument constructor.
+         * 
+         * This constructor allocates the mic array and nothing more.
+         * 
+         * Call ScalableMicArray::Init() to initialize the decimator.
+         * 
+         * Subsequent calls to `ScalableMicArray::SetPort()` and
+         * `ScalableMicArray::SetOutputChannel()` will also be required before
+         * any processing begins.
+         */
+        constexpr ScalableMicArray() noexcept {}
+
+        /**
+         * @brief Initialize the decimator.
+         */
+        void Init();
+
+        /**
+         * @brief Initialzing constructor.
+         * 
+         * This constructor initializes the decimator and sets the port and
+         * output channel.
+         * 
+         * @param p_pdm_mics    Port with PDM microphones
+         * @param c_frames_out  (non-streaming) chanend used to transmit frames.
+         */
+        ScalableMicArray(
+            port_t p_pdm_mics,
+            chanend_t c_frames_out);
+
+        /**
+         * @brief Set the PDM data port.
+         * 
+         * This function calls `this->PdmRx.Init(p_pdm_mics)`.
+         * 
+         * @param p_pdm_mics  The port to receive PDM data on.
+         */
+        void SetPort(
+            port_t p_pdm_mics);
+
+        /**
+         * @brief Set the audio frame output channel.
+         * 
+         * This function calls 
+         * `this->OutputHandler.FrameTx.SetChannel(c_frames_out)`.
+         * 
+         * @param c_frames_out The channel to send audio frames on.
+         */
+        void SetOutputChannel(
+            chanend_t c_frames_out);
+
+        /**
+         * @brief Entry point for the decimation thread.
+         * 
+         * For @ref SCALABLE_SINGLE_THREAD this enables
+         * `PdmRx.CaptureInDecimatorThread()`. Otherwise it installs and
+         * unmasks the PDM rx ISR on the calling thread and, for
+         * @ref SCALABLE_PARALLEL, starts the worker threads on the calling
+         * thread's tile. It then calls `ThreadEntry()`.
+         * 
+         * @note This call does not return.
+         */
+        void DecimationThreadEntry();
+
+      private:
+
+        /**
+         * @brief Initialize the decimator of @ref Basic192MicArray.
+         */
+        void InitDecimator(std::true_type);
+
+        /**
+         * @brief Initialize the decimator of @ref BasicMicArray.
+         */
+        void InitDecimator(std::false_type);
+
+        /**
+         * @brief Start the worker threads of a @ref ParallelDecimator.
+         */
+        template <class D>
+        static auto StartWorkers(
+            D& decimator,
+            int) -> decltype(decimator.StartWorkers());
+
+        /**
+         * @brief Do nothing, for decimators without worker threads.
+         */
+        template <class D>
+        static void StartWorkers(
+            D& decimator,
+            long);
+    };
+
   }
 }
 
@@ -461,7 +1219,12 @@ namespace mic_array {
 template <unsigned MIC_COUNT, unsigned FRAME_SIZE, bool USE_DCOE, unsigned MICS_IN>
 void mic_array::prefab::BasicMicArray<MIC_COUNT, FRAME_SIZE, USE_DCOE, MICS_IN>::Init()
 {
+#if MIC_ARRAY_CONFIG_MIN_PHASE_FILTERS
+  this->Decimator.Init((uint32_t*) stage1_coef_min_phase, stage2_coef_min_phase, 
+                       stage2_shr_min_phase);
+#else
   this->Decimator.Init((uint32_t*) stage1_coef, stage2_coef, stage2_shr);
+#endif
 }
 
 
@@ -476,7 +1239,12 @@ mic_array::prefab::BasicMicArray<MIC_COUNT, FRAME_SIZE, USE_DCOE, MICS_IN>
                     ChannelFrameTransmitter<MIC_COUNT, FRAME_SIZE>(
                         c_frames_out)))
 {
+#if MIC_ARRAY_CONFIG_MIN_PHASE_FILTERS
+  this->Decimator.Init((uint32_t*) stage1_coef_min_phase, stage2_coef_min_phase, 
+                       stage2_shr_min_phase);
+#else
   this->Decimator.Init((uint32_t*) stage1_coef, stage2_coef, stage2_shr);
+#endif
 }
 
 
@@ -518,3 +1286,240 @@ void mic_array::prefab::BasicMicArray<MIC_COUNT, FRAME_SIZE, USE_DCOE, MICS_IN>
 {
   this->PdmRx.UnmaskISR();
 }
+
+
+
+template <unsigned MIC_COUNT, unsigned FRAME_SIZE, bool USE_DCOE, unsigned MICS_IN,
+          unsigned SUBBLOCKS>
+void mic_array::prefab::Basic192MicArray<MIC_COUNT, FRAME_SIZE, USE_DCOE, MICS_IN,
+                                     SUBBLOCKS>::Init()
+{
+  this->Decimator.Init();
+}
+
+
+template <unsigned MIC_COUNT, unsigned FRAME_SIZE, bool USE_DCOE, unsigned MICS_IN,
+          unsigned SUBBLOCKS>
+mic_array::prefab::Basic192MicArray<MIC_COUNT, FRAME_SIZE, USE_DCOE, MICS_IN,
+                                     SUBBLOCKS>
+    ::Basic192MicArray(
+        port_t p_pdm_mics,
+        chanend_t c_frames_out)
+{
+  this->Decimator.Init();
+  this->PdmRx.Init(p_pdm_mics);
+  this->OutputHandler.FrameTx.SetChannel(c_frames_out);
+}
+
+
+template <unsigned MIC_COUNT, unsigned FRAME_SIZE, bool USE_DCOE, unsigned MICS_IN,
+          unsigned SUBBLOCKS>
+void mic_array::prefab::Basic192MicArray<MIC_COUNT, FRAME_SIZE, USE_DCOE, MICS_IN,
+                                     SUBBLOCKS>
+    ::SetOutputChannel(chanend_t c_frames_out)
+{
+  this->OutputHandler.FrameTx.SetChannel(c_frames_out);
+}
+
+
+template <unsigned MIC_COUNT, unsigned FRAME_SIZE, bool USE_DCOE, unsigned MICS_IN,
+          unsigned SUBBLOCKS>
+void mic_array::prefab::Basic192MicArray<MIC_COUNT, FRAME_SIZE, USE_DCOE, MICS_IN,
+                                     SUBBLOCKS>
+    ::SetPort(port_t p_pdm_mics)
+{
+  this->PdmRx.Init(p_pdm_mics);
+}
+
+
+template <unsigned MIC_COUNT, unsigned FRAME_SIZE, bool USE_DCOE, unsigned MICS_IN,
+          unsigned SUBBLOCKS>
+void mic_array::prefab::Basic192MicArray<MIC_COUNT, FRAME_SIZE, USE_DCOE, MICS_IN,
+                                     SUBBLOCKS>
+    ::PdmRxThreadEntry()
+{
+  this->PdmRx.ThreadEntry();
+}
+
+
+template <unsigned MIC_COUNT, unsigned FRAME_SIZE, bool USE_DCOE, unsigned MICS_IN,
+          unsigned SUBBLOCKS>
+void mic_array::prefab::Basic192MicArray<MIC_COUNT, FRAME_SIZE, USE_DCOE, MICS_IN,
+                                     SUBBLOCKS>
+    ::InstallPdmRxISR()
+{
+  this->PdmRx.InstallISR();
+}
+
+
+template <unsigned MIC_COUNT, unsigned FRAME_SIZE, bool USE_DCOE, unsigned MICS_IN,
+          unsigned SUBBLOCKS>
+void mic_array::prefab::Basic192MicArray<MIC_COUNT, FRAME_SIZE, USE_DCOE, MICS_IN,
+                                     SUBBLOCKS>
+    ::UnmaskPdmRxISR()
+{
+  this->PdmRx.UnmaskISR();
+}
+
+
+
+template <unsigned MIC_COUNT, unsigned FRAME_SIZE, unsigned MICS_IN, unsigned SUBBLOCKS>
+mic_array::prefab::PdmCaptureMicArray<MIC_COUNT, FRAME_SIZE, MICS_IN, SUBBLOCKS>
+    ::PdmCaptureMicArray(
+        port_t p_pdm_mics,
+        chanend_t c_frames_out)
+{
+  this->PdmRx.Init(p_pdm_mics);
+  this->OutputHandler.FrameTx.SetChannel(c_frames_out);
+}
+
+
+template <unsigned MIC_COUNT, unsigned FRAME_SIZE, unsigned MICS_IN, unsigned SUBBLOCKS>
+void mic_array::prefab::PdmCaptureMicArray<MIC_COUNT, FRAME_SIZE, MICS_IN, SUBBLOCKS>
+    ::SetOutputChannel(chanend_t c_frames_out)
+{
+  this->OutputHandler.FrameTx.SetChannel(c_frames_out);
+}
+
+
+template <unsigned MIC_COUNT, unsigned FRAME_SIZE, unsigned MICS_IN, unsigned SUBBLOCKS>
+void mic_array::prefab::PdmCaptureMicArray<MIC_COUNT, FRAME_SIZE, MICS_IN, SUBBLOCKS>
+    ::SetPort(port_t p_pdm_mics)
+{
+  this->PdmRx.Init(p_pdm_mics);
+}
+
+
+template <unsigned MIC_COUNT, unsigned FRAME_SIZE, unsigned MICS_IN, unsigned SUBBLOCKS>
+void mic_array::prefab::PdmCaptureMicArray<MIC_COUNT, FRAME_SIZE, MICS_IN, SUBBLOCKS>
+    ::PdmRxThreadEntry()
+{
+  this->PdmRx.ThreadEntry();
+}
+
+
+template <unsigned MIC_COUNT, unsigned FRAME_SIZE, unsigned MICS_IN, unsigned SUBBLOCKS>
+void mic_array::prefab::PdmCaptureMicArray<MIC_COUNT, FRAME_SIZE, MICS_IN, SUBBLOCKS>
+    ::InstallPdmRxISR()
+{
+  this->PdmRx.InstallISR();
+}
+
+
+template <unsigned MIC_COUNT, unsigned FRAME_SIZE, unsigned MICS_IN, unsigned SUBBLOCKS>
+void mic_array::prefab::PdmCaptureMicArray<MIC_COUNT, FRAME_SIZE, MICS_IN, SUBBLOCKS>
+    ::UnmaskPdmRxISR()
+{
+  this->PdmRx.UnmaskISR();
+}
+
+
+
+template <unsigned MIC_COUNT, unsigned RATE, unsigned THREADS,
+          unsigned FRAME_SIZE, bool USE_DCOE, unsigned MICS_IN>
+void mic_array::prefab::ScalableMicArray<MIC_COUNT, RATE, THREADS, FRAME_SIZE,
+                                         USE_DCOE, MICS_IN>::Init()
+{
+  this->InitDecimator(std::integral_constant<bool, RATE == 192000>());
+}
+
+
+template <unsigned MIC_COUNT, unsigned RATE, unsigned THREADS,
+          unsigned FRAME_SIZE, bool USE_DCOE, unsigned MICS_IN>
+mic_array::prefab::ScalableMicArray<MIC_COUNT, RATE, THREADS, FRAME_SIZE,
+                                    USE_DCOE, MICS_IN>
+    ::ScalableMicArray(
+        port_t p_pdm_mics,
+        chanend_t c_frames_out)
+{
+  this->Init();
+  this->PdmRx.Init(p_pdm_mics);
+  this->OutputHandler.FrameTx.SetChannel(c_frames_out);
+}
+
+
+template <unsigned MIC_COUNT, unsigned RATE, unsigned THREADS,
+          unsigned FRAME_SIZE, bool USE_DCOE, unsigned MICS_IN>
+void mic_array::prefab::ScalableMicArray<MIC_COUNT, RATE, THREADS, FRAME_SIZE,
+                                         USE_DCOE, MICS_IN>
+    ::SetOutputChannel(chanend_t c_frames_out)
+{
+  this->OutputHandler.FrameTx.SetChannel(c_frames_out);
+}
+
+
+template <unsigned MIC_COUNT, unsigned RATE, unsigned THREADS,
+          unsigned FRAME_SIZE, bool USE_DCOE, unsigned MICS_IN>
+void mic_array::prefab::ScalableMicArray<MIC_COUNT, RATE, THREADS, FRAME_SIZE,
+                                         USE_DCOE, MICS_IN>
+    ::SetPort(port_t p_pdm_mics)
+{
+  this->PdmRx.Init(p_pdm_mics);
+}
+
+
+template <unsigned MIC_COUNT, unsigned RATE, unsigned THREADS,
+          unsigned FRAME_SIZE, bool USE_DCOE, unsigned MICS_IN>
+void mic_array::prefab::ScalableMicArray<MIC_COUNT, RATE, THREADS, FRAME_SIZE,
+                                         USE_DCOE, MICS_IN>
+    ::DecimationThreadEntry()
+{
+  if(Plan::Mode == SCALABLE_SINGLE_THREAD){
+    this->PdmRx.CaptureInDecimatorThread(true);
+  } else {
+    StartWorkers(this->Decimator, 0);
+    this->PdmRx.InstallISR();
+    this->PdmRx.UnmaskISR();
+  }
+  this->ThreadEntry();
+}
+
+
+template <unsigned MIC_COUNT, unsigned RATE, unsigned THREADS,
+          unsigned FRAME_SIZE, bool USE_DCOE, unsigned MICS_IN>
+template <class D>
+auto mic_array::prefab::ScalableMicArray<MIC_COUNT, RATE, THREADS, FRAME_SIZE,
+                                         USE_DCOE, MICS_IN>
+    ::StartWorkers(
+        D& decimator,
+        int) -> decltype(decimator.StartWorkers())
+{
+  return decimator.StartWorkers();
+}
+
+
+template <unsigned MIC_COUNT, unsigned RATE, unsigned THREADS,
+          unsigned FRAME_SIZE, bool USE_DCOE, unsigned MICS_IN>
+template <class D>
+void mic_array::prefab::ScalableMicArray<MIC_COUNT, RATE, THREADS, FRAME_SIZE,
+                                         USE_DCOE, MICS_IN>
+    ::StartWorkers(
+        D& decimator,
+        long)
+{
+}
+
+
+template <unsigned MIC_COUNT, unsigned RATE, unsigned THREADS,
+          unsigned FRAME_SIZE, bool USE_DCOE, unsigned MICS_IN>
+void mic_array::prefab::ScalableMicArray<MIC_COUNT, RATE, THREADS, FRAME_SIZE,
+                                         USE_DCOE, MICS_IN>
+    ::InitDecimator(std::true_type)
+{
+  this->Decimator.Init();
+}
+
+
+template <unsigned MIC_COUNT, unsigned RATE, unsigned THREADS,
+          unsigned FRAME_SIZE, bool USE_DCOE, unsigned MICS_IN>
+void mic_array::prefab::ScalableMicArray<MIC_COUNT, RATE, THREADS, FRAME_SIZE,
+                                         USE_DCOE, MICS_IN>
+    ::InitDecimator(std::false_type)
+{
+#if MIC_ARRAY_CONFIG_MIN_PHASE_FILTERS
+  this->Decimator.Init((uint32_t*) stage1_coef_min_phase, stage2_coef_min_phase, 
+                       stage2_shr_min_phase);
+#else
+  this->Decimator.Init((uint32_t*) stage1_coef, stage2_coef, stage2_shr);
+#endif
+}
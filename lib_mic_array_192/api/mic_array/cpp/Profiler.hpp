@@ -0,0 +1,267 @@
+// Copyright 2022-2024 XMOS LIMITED.
+// This Software is subject to the terms of the XMOS Public Licence: Version 1.
+
+#pragma once
+
+#include <cstdint>
+#include <cassert>
+
+#if defined(__XS3A__)
+# include <xcore/hwtimer.h>
+#else
+# include <chrono>
+#endif
+
+/**
+ * Set to `1` to have @ref mic_array::MicArray::ThreadEntry() time each phase
+ * of the decimation thread's loop into @ref mic_array::MicArray::Profiler.
+ * Defaults to `0`, in which case none of the timing code is compiled in.
+ */
+#ifndef MIC_ARRAY_CONFIG_PROFILE
+# define MIC_ARRAY_CONFIG_PROFILE   (0)
+#endif
+
+/**
+ * Expands to its arguments when @ref MIC_ARRAY_CONFIG_PROFILE is enabled and
+ * to nothing otherwise, for statements which only exist to profile the mic
+ * array.
+ */
+#if MIC_ARRAY_CONFIG_PROFILE
+# define MIC_ARRAY_PROFILE(...)     __VA_ARGS__
+#else
+# define MIC_ARRAY_PROFILE(...)
+#endif
+
+/**
+ * Number of bins in each @ref mic_array::StageCycles histogram.
+ */
+#ifndef MIC_ARRAY_PROFILE_HISTOGRAM_BINS
+# define MIC_ARRAY_PROFILE_HISTOGRAM_BINS   (16)
+#endif
+
+
+namespace  mic_array {
+
+  /**
+   * @brief Phases of the decimation thread timed by @ref StageProfiler.
+   */
+  enum ProfileStage : unsigned {
+    /** `PdmRx.GetPdmBlock()`, including any wait for the block and the
+     *  deinterleaving of it. */
+    PROFILE_PDM_RX = 0,
+    /** `Decimator.ProcessBlock()` as a whole. */
+    PROFILE_DECIMATOR,
+    /** The first stage filter, within `PROFILE_DECIMATOR`. Only recorded by
+     *  decimators which support it (@ref TwoStageDecimator). */
+    PROFILE_STAGE1,
+    /** The second stage filter and any fused sample filter, within
+     *  `PROFILE_DECIMATOR`. Only recorded by decimators which support it. */
+    PROFILE_STAGE2,
+    /** `SampleFilter.Filter()` or `SampleFilter.FilterSamples()`. */
+    PROFILE_SAMPLE_FILTER,
+    /** `OutputHandler.OutputSample()` or `OutputHandler.OutputSamples()`. */
+    PROFILE_OUTPUT,
+    /** Number of profiled phases. */
+    PROFILE_STAGE_COUNT
+  };
+
+  /**
+   * @brief Reference clock ticks spent in one phase of the decimation thread.
+   */
+  struct StageCycles {
+    /**
+     * Number of times the phase was timed.
+     */
+    unsigned count;
+
+    /**
+     * Shortest time recorded, in reference clock ticks. `UINT32_MAX` if
+     * nothing has been recorded.
+     */
+    uint32_t min;
+
+    /**
+     * Longest time recorded, in reference clock ticks.
+     */
+    uint32_t max;
+
+    /**
+     * Sum of all times recorded, in reference clock ticks.
+     */
+    uint64_t total;
+
+    /**
+     * Distribution of the times recorded. `histogram[0]` counts times below 2
+     * ticks, and `histogram[b]` times in `[2^b, 2^(b+1))` ticks, except that
+     * the last bin also counts everything longer.
+     */
+    unsigned histogram[MIC_ARRAY_PROFILE_HISTOGRAM_BINS];
+
+    /**
+     * @brief Mean time recorded, in reference clock ticks.
+     *
+     * `0` if nothing has been recorded.
+     */
+    uint32_t Average() const;
+  };
+
+  /**
+   * @brief Collects @ref StageCycles for each @ref ProfileStage.
+   *
+   * When @ref MIC_ARRAY_CONFIG_PROFILE is enabled, @ref MicArray owns one of
+   * these as @ref MicArray::Profiler, and @ref MicArray::ThreadEntry() calls
+   * @ref Mark() as each phase of its loop completes, so that the time between
+   * consecutive marks is charged to the phase just finished. Decimators which
+   * can split their own time between their stages record it with @ref Add().
+   *
+   * All updates happen on the decimation thread. Another thread on the same
+   * tile may call @ref GetStats(), but the `total` of a @ref StageCycles is
+   * two words, so it may occasionally see an entry mid-update.
+   */
+  class StageProfiler {
+
+    private:
+
+      /**
+       * Statistics of each phase.
+       */
+      StageCycles stages[PROFILE_STAGE_COUNT];
+
+      /**
+       * Reference time of the previous @ref Mark() or @ref Start().
+       */
+      uint32_t last_mark;
+
+    public:
+
+      StageProfiler() { Reset(); }
+
+      /**
+       * @brief Current time in reference clock ticks.
+       *
+       * On xcore this is the 100 MHz reference timer. Elsewhere (e.g. in host
+       * builds) it is a monotonic clock counted in the same 10 ns ticks.
+       */
+      static uint32_t Now();
+
+      /**
+       * @brief Clear the statistics of every phase.
+       */
+      void Reset();
+
+      /**
+       * @brief Start timing the first phase.
+       */
+      void Start();
+
+      /**
+       * @brief Charge the time since the last mark to `stage`.
+       *
+       * @param stage The phase which just completed.
+       */
+      void Mark(
+          const ProfileStage stage);
+
+      /**
+       * @brief Record that `stage` took `ticks` reference clock ticks.
+       *
+       * Does not affect the time charged by the next @ref Mark().
+       *
+       * @param stage The phase which was timed.
+       * @param ticks Duration of the phase.
+       */
+      void Add(
+          const ProfileStage stage,
+          const uint32_t ticks);
+
+      /**
+       * @brief Get the statistics recorded for `stage`.
+       *
+       * @param stage The phase of interest.
+       */
+      StageCycles GetStats(
+          const ProfileStage stage) const;
+  };
+
+}
+
+//////////////////////////////////////////////
+// Template function implementations below. //
+//////////////////////////////////////////////
+
+
+inline
+uint32_t mic_array::StageCycles::Average() const
+{
+  return this->count? uint32_t(this->total / this->count) : 0;
+}
+
+
+inline
+uint32_t mic_array::StageProfiler::Now()
+{
+#if defined(__XS3A__)
+  return get_reference_time();
+#else
+  using namespace std::chrono;
+  return uint32_t(duration_cast<nanoseconds>(
+      steady_clock::now().time_since_epoch()).count() / 10);
+#endif
+}
+
+
+inline
+void mic_array::StageProfiler::Reset()
+{
+  for(unsigned k = 0; k < PROFILE_STAGE_COUNT; k++){
+    this->stages[k] = StageCycles{};
+    this->stages[k].min = UINT32_MAX;
+  }
+  this->last_mark = Now();
+}
+
+
+inline
+void mic_array::StageProfiler::Start()
+{
+  this->last_mark = Now();
+}
+
+
+inline
+void mic_array::StageProfiler::Mark(
+    const ProfileStage stage)
+{
+  const uint32_t now = Now();
+  this->Add(stage, now - this->last_mark);
+  this->last_mark = now;
+}
+
+
+inline
+void mic_array::StageProfiler::Add(
+    const ProfileStage stage,
+    const uint32_t ticks)
+{
+  assert(stage < PROFILE_STAGE_COUNT);
+
+  StageCycles& s = this->stages[stage];
+  s.count++;
+  s.total += ticks;
+  if(ticks < s.min) s.min = ticks;
+  if(ticks > s.max) s.max = ticks;
+
+  unsigned bin = 0;
+  for(uint32_t t = ticks >> 1; t && bin < MIC_ARRAY_PROFILE_HISTOGRAM_BINS - 1; t >>= 1)
+    bin++;
+  s.histogram[bin]++;
+}
+
+
+inline
+mic_array::StageCycles mic_array::StageProfiler::GetStats(
+    const ProfileStage stage) const
+{
+  assert(stage < PROFILE_STAGE_COUNT);
+  return this->stages[stage];
+}
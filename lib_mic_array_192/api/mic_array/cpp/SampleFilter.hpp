@@ -9,12 +9,17 @@
 #include <iostream>
 #include <type_traits>
 #include <functional>
+#include <tuple>
+#include <cstring>
+#include <atomic>
 
-#include <xcore/channel.h>
+#include "mic_array/dc_elimination.h"
+#include "mic_array/etc/calibration_filter_s32.h"
 
 // This has caused problems previously, so just catch the problems here.
-#if defined(MIC_COUNT)
-# error Application must not define the following as precompiler macros: MIC_COUNT.
+#if defined(MIC_COUNT) || defined(POLE_SHR) || defined(MAX_DELAY) \
+    || defined(TAP_COUNT) || defined(WINDOW_SIZE)
+# error Application must not define the following as precompiler macros: MIC_COUNT, POLE_SHR, MAX_DELAY, TAP_COUNT, WINDOW_SIZE.
 #endif
 
 using namespace std;
@@ -36,10 +41,71 @@ namespace  mic_array {
   class NopSampleFilter 
   {
     public:
+      /**
+       * @brief Do nothing.
+       */
+      void Init() {};
+
       /**
        * @brief Do nothing.
        */
       void Filter(int32_t sample[MIC_COUNT]) {};
+
+      /**
+       * @brief Return `sample` unmodified.
+       */
+      int32_t FilterChannel(unsigned channel, int32_t sample) 
+      { 
+        return sample; 
+      };
+
+      /**
+       * @brief Do nothing.
+       */
+      template <unsigned SAMPLES>
+      void FilterSamples(int32_t (&samples)[SAMPLES][MIC_COUNT]) {};
+
+      /**
+       * @brief Do nothing.
+       */
+      template <unsigned SAMPLE_COUNT>
+      void FilterFrame(int32_t (&frame)[MIC_COUNT][SAMPLE_COUNT]) {};
+  };
+
+  /**
+   * @brief DCOE pole shift for a given corner frequency and sample rate.
+   * 
+   * `value` is the pole shift (the `POLE_SHR` template parameter of 
+   * @ref DcoeSampleFilter and @ref VectorDcoeSampleFilter) whose -3 dB corner,
+   * `SAMPLE_RATE_HZ / (2 * pi * 2^POLE_SHR)`, is nearest to `CUTOFF_HZ` (on a
+   * log scale).
+   * 
+   * The default pole shift is the one for a 40 Hz corner at 16 kHz. The same 
+   * shift at a higher output rate moves the corner up with it; at 192 kHz it 
+   * would be near 500 Hz, whereas `DcoePoleShr<40, 192000>::value` is `10`.
+   * 
+   * @tparam CUTOFF_HZ      Desired corner frequency.
+   * @tparam SAMPLE_RATE_HZ Output sample rate of the mic array.
+   */
+  template <unsigned CUTOFF_HZ, unsigned SAMPLE_RATE_HZ>
+  struct DcoePoleShr {
+    static_assert(CUTOFF_HZ > 0 && CUTOFF_HZ < SAMPLE_RATE_HZ,
+                  "CUTOFF_HZ must be between 0 and SAMPLE_RATE_HZ.");
+
+    private:
+      // Halve ratio until it is within a factor sqrt(2) of 1, counting.
+      static constexpr unsigned Shr(double ratio, unsigned shr)
+      {
+        return (ratio <= 1.4142135623730951 || shr == 31)? shr 
+                  : Shr(ratio / 2, shr + 1);
+      }
+
+    public:
+      /**
+       * @brief Pole shift, from `1` to `31`.
+       */
+      static constexpr unsigned value = 
+          Shr(SAMPLE_RATE_HZ / (4 * 3.141592653589793 * CUTOFF_HZ), 1);
   };
 
   /**
@@ -52,15 +118,23 @@ namespace  mic_array {
    * filter equation:
    * 
    * @code
-   * R = 252.0 / 256.0
+   * R = 1 - 2^-POLE_SHR
    * y[t] = R * y[t-1] + x[t] - x[t-1]
    * @endcode
    * 
+   * With the default `POLE_SHR` `R` is `252.0 / 256.0`, for a corner near
+   * 40 Hz at 16 kHz. As the corner scales with the sample rate, use
+   * @ref DcoePoleShr to pick `POLE_SHR` for other output rates.
+   * 
    * @tparam MIC_COUNT  Number of microphone channels.
+   * @tparam POLE_SHR   Pole shift, from `1` to `31`.
    */
-  template<unsigned MIC_COUNT>
+  template<unsigned MIC_COUNT, unsigned POLE_SHR = DCOE_DEFAULT_POLE_SHR>
   class DcoeSampleFilter
   {
+    static_assert(POLE_SHR >= 1 && POLE_SHR <= 31, 
+                  "POLE_SHR must be between 1 and 31.");
+
 
     protected:
       /**
@@ -89,24 +163,1106 @@ namespace  mic_array {
        * @param sample Samples to be filtered. Updated in-place.
        */
       void Filter(int32_t sample[MIC_COUNT]);
+
+      /**
+       * @brief Apply DCOE filter on one channel's sample.
+       * 
+       * Filters `sample` as `Filter()` would filter channel `channel`, and
+       * returns the result. This is the per-channel hook used by decimators 
+       * to apply the filter as each output sample is produced (see
+       * @ref TwoStageDecimator), so the sample is not stored and re-read.
+       * 
+       * @param channel Index of the channel `sample` belongs to.
+       * @param sample  Sample to be filtered.
+       * 
+       * @returns Filtered sample.
+       */
+      int32_t FilterChannel(unsigned channel, int32_t sample);
+
+      /**
+       * @brief Apply DCOE filter on a block of samples.
+       * 
+       * Equivalent to calling `Filter()` on each of `samples[0]` through
+       * `samples[SAMPLES-1]`, in that order.
+       * 
+       * @param samples Samples to be filtered. Updated in-place.
+       */
+      template <unsigned SAMPLES>
+      void FilterSamples(int32_t (&samples)[SAMPLES][MIC_COUNT]);
+
+      /**
+       * @brief Apply DCOE filter on a frame.
+       * 
+       * Equivalent to calling `Filter()` on each sample (column) of `frame`,
+       * in order.
+       * 
+       * @param frame Frame to be filtered, in `[MIC][SAMPLE]` order. Updated 
+       *              in-place.
+       */
+      template <unsigned SAMPLE_COUNT>
+      void FilterFrame(int32_t (&frame)[MIC_COUNT][SAMPLE_COUNT]);
   };
-}
 
-//////////////////////////////////////////////
-// Template function implementations below. //
-//////////////////////////////////////////////
+  /**
+   * @brief Filter which applies DC Offset Elimination (DCOE) to all channels
+   *        at once with the VPU.
+   * 
+   * A drop-in alternative to @ref DcoeSampleFilter, applying the same filter
+   * equation with a 32-bit state per channel (see `dcoe_filter_block()`),
+   * rather than 64-bit. This lets the VPU filter 8 channels per instruction,
+   * and a whole block or frame per call, at the cost of a DC error of at most
+   * `2^POLE_SHR - 1` LSBs on each channel.
+   * 
+   * @tparam MIC_COUNT  Number of microphone channels.
+   * @tparam POLE_SHR   Pole shift, from `1` to `31` (see @ref DcoePoleShr).
+   */
+  template<unsigned MIC_COUNT, unsigned POLE_SHR = DCOE_DEFAULT_POLE_SHR>
+  class VectorDcoeSampleFilter
+  {
+    static_assert(POLE_SHR >= 1 && POLE_SHR <= 31, 
+                  "POLE_SHR must be between 1 and 31.");
 
 
-template <unsigned MIC_COUNT>
-void mic_array::DcoeSampleFilter<MIC_COUNT>::Init()
-{
-  dcoe_state_init(&state[0], MIC_COUNT);
-}
+    protected:
+      /**
+       * @brief State of DCOE filters.
+       */
+      int32_t state[MIC_COUNT];
+    
+    public:
 
+      /**
+       * @brief Initialize the filter states.
+       * 
+       * The filter states must be initialized prior to any filtering.
+       */
+      void Init();
 
-template <unsigned MIC_COUNT>
-void mic_array::DcoeSampleFilter<MIC_COUNT>::Filter(
-    int32_t sample[MIC_COUNT])
-{
-  dcoe_filter(&sample[0], &state[0], &sample[0], MIC_COUNT);
-}
\ No newline at end of file
+      /**
+       * @brief Apply DCOE filter on samples.
+       * 
+       * @param sample Samples to be filtered. Updated in-place.
+       */
+      void Filter(int32_t sample[MIC_COUNT]);
+
+      /**
+       * @brief Apply DCOE filter on a block of samples.
+       * 
+       * Equivalent to calling `Filter()` on each of `samples[0]` through
+       * `samples[SAMPLES-1]`, in that order, but with a single call to 
+       * `dcoe_filter_block()`.
+       * 
+       * @param samples Samples to be filtered. Updated in-place.
+       */
+      template <unsigned SAMPLES>
+      void FilterSamples(int32_t (&samples)[SAMPLES][MIC_COUNT]);
+
+      /**
+       * @brief Apply DCOE filter on a frame.
+       * 
+       * Equivalent to calling `Filter()` on each sample (column) of `frame`,
+       * in order, but with a single call to `dcoe_filter_frame()`.
+       * 
+       * @param frame Frame to be filtered, in `[MIC][SAMPLE]` order. Updated 
+       *              in-place.
+       */
+      template <unsigned SAMPLE_COUNT>
+      void FilterFrame(int32_t (&frame)[MIC_COUNT][SAMPLE_COUNT]);
+  };
+
+  /**
+   * @brief Filter which applies a per-channel gain.
+   * 
+   * Intended for trimming the sensitivity of individual microphones, e.g. as
+   * a stage of a @ref SampleFilterChain. Each sample is multiplied by its 
+   * channel's gain, a Q2.30 value (so `GAIN_UNITY` is `1.0`), rounded, and 
+   * saturated to the `int32_t` range.
+   * 
+   * `Init()` sets every channel's gain to `GAIN_UNITY`.
+   * 
+   * @tparam MIC_COUNT  Number of microphone channels.
+   */
+  template<unsigned MIC_COUNT>
+  class GainSampleFilter
+  {
+    public:
+      /**
+       * @brief Gain of `1.0`, in Q2.30.
+       */
+      static constexpr int32_t GAIN_UNITY = 0x40000000;
+
+    protected:
+      /**
+       * @brief Gain of each channel, in Q2.30.
+       */
+      int32_t gain[MIC_COUNT];
+
+    public:
+
+      /**
+       * @brief Set every channel's gain to `GAIN_UNITY`.
+       */
+      void Init();
+
+      /**
+       * @brief Set a channel's gain.
+       * 
+       * @param channel Channel index.
+       * @param gain    New gain, in Q2.30.
+       */
+      void SetGain(unsigned channel, int32_t gain);
+
+      /**
+       * @brief Apply the gains to a sample.
+       * 
+       * @param sample Samples to be filtered. Updated in-place.
+       */
+      void Filter(int32_t sample[MIC_COUNT]);
+
+      /**
+       * @brief Apply a channel's gain to one sample.
+       * 
+       * @param channel Index of the channel `sample` belongs to.
+       * @param sample  Sample to be filtered.
+       * 
+       * @returns Filtered sample.
+       */
+      int32_t FilterChannel(unsigned channel, int32_t sample);
+  };
+
+  /**
+   * @brief Filter which delays each channel by a whole number of samples.
+   * 
+   * Intended for aligning microphones whose signal paths differ, e.g. as a
+   * stage of a @ref SampleFilterChain. Each channel has its own delay, from
+   * `0` to `MAX_DELAY` samples, and its own history of `MAX_DELAY` samples.
+   * 
+   * `Init()` clears the history and sets every channel's delay to `0`.
+   * 
+   * @tparam MIC_COUNT  Number of microphone channels.
+   * @tparam MAX_DELAY  Longest delay supported, in samples.
+   */
+  template<unsigned MIC_COUNT, unsigned MAX_DELAY>
+  class DelaySampleFilter
+  {
+    static_assert(MAX_DELAY >= 1, "MAX_DELAY must be at least 1.");
+
+    protected:
+      /**
+       * @brief Length of each channel's history buffer.
+       */
+      static constexpr unsigned HISTORY_LEN = MAX_DELAY + 1;
+
+      /**
+       * @brief Recent input samples of each channel.
+       */
+      int32_t history[MIC_COUNT][HISTORY_LEN];
+
+      /**
+       * @brief Index in `history` at which each channel's next sample is 
+       *        stored.
+       */
+      unsigned position[MIC_COUNT];
+
+      /**
+       * @brief Delay of each channel, in samples.
+       */
+      unsigned delay[MIC_COUNT];
+
+    public:
+
+      /**
+       * @brief Clear the history and set every channel's delay to `0`.
+       */
+      void Init();
+
+      /**
+       * @brief Set a channel's delay.
+       * 
+       * The history is not cleared, so the first `delay` samples output
+       * after an increase are older input samples of that channel (or `0`
+       * after `Init()`).
+       * 
+       * @param channel Channel index.
+       * @param delay   New delay, in samples, from `0` to `MAX_DELAY`.
+       */
+      void SetDelay(unsigned channel, unsigned delay);
+
+      /**
+       * @brief Delay a sample.
+       * 
+       * @param sample Samples to be filtered. Updated in-place.
+       */
+      void Filter(int32_t sample[MIC_COUNT]);
+
+      /**
+       * @brief Delay one channel's sample.
+       * 
+       * @param channel Index of the channel `sample` belongs to.
+       * @param sample  Sample to be filtered.
+       * 
+       * @returns The sample of `channel` received `delay` calls earlier.
+       */
+      int32_t FilterChannel(unsigned channel, int32_t sample);
+  };
+
+  /**
+   * @brief Filter which applies a per-channel gain and fractional delay, for
+   *        all channels at once with the VPU.
+   * 
+   * Intended for correcting the sensitivity and PDM path delay mismatch of
+   * individual microphones from factory calibration data. Each channel has
+   * its own `TAP_COUNT`-tap FIR, with Q2.30 taps (`TAP_UNITY` is `1.0`), so
+   * gains of up to `2.0` (`+6 dB`) can be applied. The FIRs of all channels
+   * are evaluated together by `calibration_filter_s32()`, 8 channels per
+   * VPU instruction.
+   * 
+   * `SetCalibration()` designs a channel's FIR from a gain and a delay, as a
+   * Lagrange interpolator (exact for integer delays) scaled by the gain. 
+   * Delays are from `0` to `TAP_COUNT-1` samples; to delay some channels 
+   * relative to others, give every channel a nominal delay near
+   * `(TAP_COUNT-1)/2` plus its own offset. `SetTaps()` sets a channel's FIR
+   * directly.
+   * 
+   * `Init()` clears the history and gives every channel a gain of `1.0` and
+   * a delay of `0`, so the filter initially passes samples unmodified.
+   * 
+   * @tparam MIC_COUNT  Number of microphone channels.
+   * @tparam TAP_COUNT  Number of FIR taps per channel.
+   */
+  template<unsigned MIC_COUNT, unsigned TAP_COUNT = 4>
+  class CalibrationSampleFilter
+  {
+    static_assert(TAP_COUNT >= 1, "TAP_COUNT must be at least 1.");
+
+    public:
+      /**
+       * @brief Tap value of `1.0`, in Q2.30.
+       */
+      static constexpr int32_t TAP_UNITY = 0x40000000;
+
+    protected:
+      /**
+       * @brief FIR taps, in `[TAP][MIC]` order.
+       */
+      int32_t coef[TAP_COUNT][MIC_COUNT];
+
+      /**
+       * @brief History of input samples, in `[SAMPLE][MIC]` order.
+       * 
+       * Each sample is stored twice, `TAP_COUNT` rows apart, so that the 
+       * `TAP_COUNT` most recent samples are always contiguous, newest first,
+       * from row `position`.
+       */
+      int32_t history[2 * TAP_COUNT][MIC_COUNT];
+
+      /**
+       * @brief Row of `history` holding the newest sample.
+       */
+      unsigned position;
+
+    public:
+
+      /**
+       * @brief Clear the history, and set every channel's gain to `1.0` and
+       *        delay to `0`.
+       */
+      void Init();
+
+      /**
+       * @brief Set a channel's FIR taps.
+       * 
+       * @param channel Channel index.
+       * @param taps    `TAP_COUNT` taps, in Q2.30, `taps[0]` applied to the
+       *                newest sample.
+       */
+      void SetTaps(unsigned channel, const int32_t taps[TAP_COUNT]);
+
+      /**
+       * @brief Set a channel's gain and delay.
+       * 
+       * Taps which do not fit in Q2.30 are saturated.
+       * 
+       * @param channel Channel index.
+       * @param gain    Linear gain, e.g. `1.1885` for `+1.5 dB`.
+       * @param delay   Delay in samples, from `0` to `TAP_COUNT-1`.
+       */
+      void SetCalibration(unsigned channel, float gain, float delay);
+
+      /**
+       * @brief Apply the calibration on samples.
+       * 
+       * @param sample Samples to be filtered. Updated in-place.
+       */
+      void Filter(int32_t sample[MIC_COUNT]);
+
+      /**
+       * @brief Apply the calibration on a block of samples.
+       * 
+       * Equivalent to calling `Filter()` on each of `samples[0]` through
+       * `samples[SAMPLES-1]`, in that order.
+       * 
+       * @param samples Samples to be filtered. Updated in-place.
+       */
+      template <unsigned SAMPLES>
+      void FilterSamples(int32_t (&samples)[SAMPLES][MIC_COUNT]);
+
+      /**
+       * @brief Apply the calibration on a frame.
+       * 
+       * Equivalent to calling `Filter()` on each sample (column) of `frame`,
+       * in order.
+       * 
+       * @param frame Frame to be filtered, in `[MIC][SAMPLE]` order. Updated 
+       *              in-place.
+       */
+      template <unsigned SAMPLE_COUNT>
+      void FilterFrame(int32_t (&frame)[MIC_COUNT][SAMPLE_COUNT]);
+  };
+
+  /**
+   * @brief Levels of each channel over a metering window.
+   * 
+   * Published by @ref LevelMeterSampleFilter.
+   * 
+   * @tparam MIC_COUNT  Number of microphone channels.
+   */
+  template <unsigned MIC_COUNT>
+  struct ChannelLevels {
+    /**
+     * Largest magnitude of any sample of the channel.
+     */
+    uint32_t peak[MIC_COUNT];
+
+    /**
+     * Mean of `(sample >> 8)^2` over the channel's samples, i.e. the mean
+     * square in units of `2^16` squared LSBs.
+     */
+    uint64_t mean_square[MIC_COUNT];
+
+    /**
+     * Number of samples of the channel whose magnitude reached the clip
+     * level.
+     */
+    unsigned clips[MIC_COUNT];
+
+    /**
+     * Number of windows completed since `Init()`. `0` means the other fields
+     * are not yet valid.
+     */
+    unsigned windows;
+  };
+
+  /**
+   * @brief Filter which meters the level of each channel, without modifying
+   *        the samples.
+   * 
+   * Intended for AGC and for detecting dead, blocked or overloaded 
+   * microphones, without another pass over the frames on the thread
+   * receiving them, e.g. as a stage of a @ref SampleFilterChain. Over each
+   * window of `WINDOW_SIZE` samples (typically the frame size), the filter
+   * tracks each channel's peak magnitude, mean square and the number of
+   * samples at or above a clip level, and at the end of the window publishes
+   * them as a @ref ChannelLevels.
+   * 
+   * @ref GetLevels() may be called from any thread on the same tile. The
+   * levels are published under a sequence count, so a reader never sees a
+   * torn update. Each channel's levels are published as soon as its window
+   * completes; `ChannelLevels::windows` counts the windows of the last
+   * channel.
+   * 
+   * Each sample costs one 32x32-bit multiply-accumulate into a 64-bit
+   * accumulator, and two compares.
+   * 
+   * @tparam MIC_COUNT    Number of microphone channels.
+   * @tparam WINDOW_SIZE  Number of samples per metering window.
+   */
+  template<unsigned MIC_COUNT, unsigned WINDOW_SIZE>
+  class LevelMeterSampleFilter
+  {
+    static_assert(WINDOW_SIZE >= 1 && WINDOW_SIZE <= (1u << 18), 
+                  "WINDOW_SIZE must be between 1 and 2^18.");
+
+    protected:
+      /**
+       * @brief Magnitude at or above which a sample counts as clipped.
+       */
+      uint32_t clip_level;
+
+      /**
+       * @brief Number of samples of each channel in its current window.
+       */
+      unsigned count[MIC_COUNT];
+
+      /**
+       * @brief Peak magnitude of each channel in its current window.
+       */
+      uint32_t peak[MIC_COUNT];
+
+      /**
+       * @brief Sum of `(sample >> 8)^2` of each channel in its current window.
+       */
+      uint64_t energy[MIC_COUNT];
+
+      /**
+       * @brief Clip count of each channel in its current window.
+       */
+      unsigned clips[MIC_COUNT];
+
+      /**
+       * @brief Sequence count of `levels`; odd while it is being updated.
+       */
+      volatile unsigned seq;
+
+      /**
+       * @brief Levels of the latest completed windows.
+       */
+      ChannelLevels<MIC_COUNT> levels;
+
+    public:
+
+      /**
+       * @brief Clear the levels, and set the clip level to `INT32_MAX`.
+       * 
+       * As the decimators saturate their output to `[-INT32_MAX, INT32_MAX]`,
+       * the default clip level counts the samples which saturated.
+       */
+      void Init();
+
+      /**
+       * @brief Set the magnitude at or above which a sample counts as
+       *        clipped.
+       * 
+       * @param level Clip level.
+       */
+      void SetClipLevel(uint32_t level);
+
+      /**
+       * @brief Get the levels of the latest completed windows.
+       * 
+       * May be called from any thread on the same tile.
+       */
+      ChannelLevels<MIC_COUNT> GetLevels() const;
+
+      /**
+       * @brief Meter a sample.
+       * 
+       * @param sample Samples to be metered. Not modified.
+       */
+      void Filter(int32_t sample[MIC_COUNT]);
+
+      /**
+       * @brief Meter one channel's sample.
+       * 
+       * @param channel Index of the channel `sample` belongs to.
+       * @param sample  Sample to be metered.
+       * 
+       * @returns `sample`.
+       */
+      int32_t FilterChannel(unsigned channel, int32_t sample);
+
+      /**
+       * @brief Meter a block of samples.
+       * 
+       * Equivalent to calling `Filter()` on each of `samples[0]` through
+       * `samples[SAMPLES-1]`, in that order.
+       * 
+       * @param samples Samples to be metered. Not modified.
+       */
+      template <unsigned SAMPLES>
+      void FilterSamples(int32_t (&samples)[SAMPLES][MIC_COUNT]);
+
+      /**
+       * @brief Meter a frame.
+       * 
+       * Equivalent to calling `Filter()` on each sample (column) of `frame`,
+       * in order.
+       * 
+       * @param frame Frame to be metered, in `[MIC][SAMPLE]` order. Not 
+       *              modified.
+       */
+      template <unsigned SAMPLE_COUNT>
+      void FilterFrame(int32_t (&frame)[MIC_COUNT][SAMPLE_COUNT]);
+
+    private:
+      /**
+       * @brief Publish the levels of `channel`'s completed window and start
+       *        its next.
+       */
+      void Publish(unsigned channel);
+  };
+
+  /**
+   * @brief Sample filter composed of several sample filters applied in
+   *        series.
+   * 
+   * `SampleFilterChain<MIC_COUNT, A, B, C>` applies `A`, then `B`, then `C` to
+   * every sample, e.g. DCOE, then a gain trim, then a delay alignment:
+   * 
+   * @code{.cpp}
+   * using TFilter = SampleFilterChain<MIC_COUNT, 
+   *                                   DcoeSampleFilter<MIC_COUNT>,
+   *                                   GainSampleFilter<MIC_COUNT>,
+   *                                   DelaySampleFilter<MIC_COUNT, 4>>;
+   * @endcode
+   * 
+   * Rather than running each stage over all of the channels in turn, the
+   * chain makes a single pass over the samples, passing each one through
+   * every stage's `FilterChannel()` before moving on. Each stage must
+   * therefore implement
+   * 
+   * @code{.cpp}
+   * int32_t FilterChannel(unsigned channel, int32_t sample);
+   * void Init();
+   * @endcode
+   * 
+   * and must keep no state shared between channels. The stages are resolved
+   * at compile time, so their `FilterChannel()` calls are inlined into the 
+   * one loop.
+   * 
+   * The chain itself implements `FilterChannel()`, so it may also be used as
+   * the `TSampleFilter` of @ref TwoStageDecimator or 
+   * @ref OneStageDecimator192.
+   * 
+   * @tparam MIC_COUNT  Number of microphone channels.
+   * @tparam TFilters   Sample filter types, in the order they are applied.
+   */
+  template<unsigned MIC_COUNT, class... TFilters>
+  class SampleFilterChain
+  {
+    public:
+      /**
+       * @brief The stages of the chain.
+       */
+      std::tuple<TFilters...> Stages;
+
+      /**
+       * @brief Get a stage of the chain.
+       * 
+       * @tparam INDEX  Position of the stage in `TFilters`.
+       */
+      template <unsigned INDEX>
+      typename std::tuple_element<INDEX, std::tuple<TFilters...>>::type& 
+          Stage() { return std::get<INDEX>(Stages); }
+
+      /**
+       * @brief Initialize every stage.
+       */
+      void Init();
+
+      /**
+       * @brief Apply every stage on samples.
+       * 
+       * @param sample Samples to be filtered. Updated in-place.
+       */
+      void Filter(int32_t sample[MIC_COUNT]);
+
+      /**
+       * @brief Apply every stage on one channel's sample.
+       * 
+       * @param channel Index of the channel `sample` belongs to.
+       * @param sample  Sample to be filtered.
+       * 
+       * @returns Filtered sample.
+       */
+      int32_t FilterChannel(unsigned channel, int32_t sample);
+
+      /**
+       * @brief Apply every stage on a block of samples.
+       * 
+       * Equivalent to calling `Filter()` on each of `samples[0]` through
+       * `samples[SAMPLES-1]`, in that order.
+       * 
+       * @param samples Samples to be filtered. Updated in-place.
+       */
+      template <unsigned SAMPLES>
+      void FilterSamples(int32_t (&samples)[SAMPLES][MIC_COUNT]);
+
+      /**
+       * @brief Apply every stage on a frame.
+       * 
+       * Equivalent to calling `Filter()` on each sample (column) of `frame`,
+       * in order.
+       * 
+       * @param frame Frame to be filtered, in `[MIC][SAMPLE]` order. Updated 
+       *              in-place.
+       */
+      template <unsigned SAMPLE_COUNT>
+      void FilterFrame(int32_t (&frame)[MIC_COUNT][SAMPLE_COUNT]);
+
+    private:
+      template <unsigned INDEX>
+      void InitStages(std::integral_constant<unsigned, INDEX>);
+
+      void InitStages(std::integral_constant<unsigned, sizeof...(TFilters)>) {}
+
+      template <unsigned INDEX>
+      int32_t Apply(unsigned channel, int32_t sample, 
+                    std::integral_constant<unsigned, INDEX>);
+
+      int32_t Apply(unsigned channel, int32_t sample, 
+                    std::integral_constant<unsigned, sizeof...(TFilters)>)
+      { 
+        return sample; 
+      }
+  };
+}
+
+//////////////////////////////////////////////
+// Template function implementations below. //
+//////////////////////////////////////////////
+
+
+template <unsigned MIC_COUNT, unsigned POLE_SHR>
+void mic_array::DcoeSampleFilter<MIC_COUNT, POLE_SHR>::Init()
+{
+  dcoe_state_init(&state[0], MIC_COUNT);
+}
+
+
+template <unsigned MIC_COUNT, unsigned POLE_SHR>
+void mic_array::DcoeSampleFilter<MIC_COUNT, POLE_SHR>::Filter(
+    int32_t sample[MIC_COUNT])
+{
+  dcoe_filter_shr(&sample[0], &state[0], &sample[0], MIC_COUNT, POLE_SHR);
+}
+
+
+template <unsigned MIC_COUNT, unsigned POLE_SHR>
+int32_t mic_array::DcoeSampleFilter<MIC_COUNT, POLE_SHR>::FilterChannel(
+    unsigned channel,
+    int32_t sample)
+{
+  // Same arithmetic as dcoe_filter_shr(), on a single channel.
+  const int64_t x_new = ((int64_t) sample) << 32;
+  int64_t y = state[channel].prev_y + x_new;
+  const int32_t out = y >> 32;
+  y = y - (y >> POLE_SHR);
+  state[channel].prev_y = y - x_new;
+  return out;
+}
+
+
+template <unsigned MIC_COUNT, unsigned POLE_SHR>
+template <unsigned SAMPLES>
+void mic_array::DcoeSampleFilter<MIC_COUNT, POLE_SHR>::FilterSamples(
+    int32_t (&samples)[SAMPLES][MIC_COUNT])
+{
+  for(unsigned s = 0; s < SAMPLES; s++)
+    dcoe_filter_shr(&samples[s][0], &state[0], &samples[s][0], MIC_COUNT, 
+                    POLE_SHR);
+}
+
+
+template <unsigned MIC_COUNT, unsigned POLE_SHR>
+template <unsigned SAMPLE_COUNT>
+void mic_array::DcoeSampleFilter<MIC_COUNT, POLE_SHR>::FilterFrame(
+    int32_t (&frame)[MIC_COUNT][SAMPLE_COUNT])
+{
+  for(unsigned s = 0; s < SAMPLE_COUNT; s++){
+    int32_t sample[MIC_COUNT];
+    for(unsigned k = 0; k < MIC_COUNT; k++)
+      sample[k] = frame[k][s];
+
+    dcoe_filter_shr(&sample[0], &state[0], &sample[0], MIC_COUNT, POLE_SHR);
+
+    for(unsigned k = 0; k < MIC_COUNT; k++)
+      frame[k][s] = sample[k];
+  }
+}
+
+
+template <unsigned MIC_COUNT, unsigned POLE_SHR>
+void mic_array::VectorDcoeSampleFilter<MIC_COUNT, POLE_SHR>::Init()
+{
+  dcoe_state_init_s32(&state[0], MIC_COUNT);
+}
+
+
+template <unsigned MIC_COUNT, unsigned POLE_SHR>
+void mic_array::VectorDcoeSampleFilter<MIC_COUNT, POLE_SHR>::Filter(
+    int32_t sample[MIC_COUNT])
+{
+  dcoe_filter_block(&sample[0], &state[0], MIC_COUNT, 1, POLE_SHR);
+}
+
+
+template <unsigned MIC_COUNT, unsigned POLE_SHR>
+template <unsigned SAMPLES>
+void mic_array::VectorDcoeSampleFilter<MIC_COUNT, POLE_SHR>::FilterSamples(
+    int32_t (&samples)[SAMPLES][MIC_COUNT])
+{
+  dcoe_filter_block(&samples[0][0], &state[0], MIC_COUNT, SAMPLES, POLE_SHR);
+}
+
+
+template <unsigned MIC_COUNT, unsigned POLE_SHR>
+template <unsigned SAMPLE_COUNT>
+void mic_array::VectorDcoeSampleFilter<MIC_COUNT, POLE_SHR>::FilterFrame(
+    int32_t (&frame)[MIC_COUNT][SAMPLE_COUNT])
+{
+  dcoe_filter_frame(&frame[0][0], &state[0], MIC_COUNT, SAMPLE_COUNT, 
+                    POLE_SHR);
+}
+
+
+template <unsigned MIC_COUNT>
+void mic_array::GainSampleFilter<MIC_COUNT>::Init()
+{
+  for(unsigned k = 0; k < MIC_COUNT; k++)
+    this->gain[k] = GAIN_UNITY;
+}
+
+
+template <unsigned MIC_COUNT>
+void mic_array::GainSampleFilter<MIC_COUNT>::SetGain(
+    unsigned channel,
+    int32_t gain)
+{
+  this->gain[channel] = gain;
+}
+
+
+template <unsigned MIC_COUNT>
+void mic_array::GainSampleFilter<MIC_COUNT>::Filter(
+    int32_t sample[MIC_COUNT])
+{
+  for(unsigned k = 0; k < MIC_COUNT; k++)
+    sample[k] = FilterChannel(k, sample[k]);
+}
+
+
+template <unsigned MIC_COUNT>
+int32_t mic_array::GainSampleFilter<MIC_COUNT>::FilterChannel(
+    unsigned channel,
+    int32_t sample)
+{
+  const int64_t y = (((int64_t) sample) * this->gain[channel] + (1 << 29)) >> 30;
+  return (y > INT32_MAX)? INT32_MAX : (y < INT32_MIN)? INT32_MIN : y;
+}
+
+
+template <unsigned MIC_COUNT, unsigned MAX_DELAY>
+void mic_array::DelaySampleFilter<MIC_COUNT, MAX_DELAY>::Init()
+{
+  memset(this->history, 0, sizeof(this->history));
+  for(unsigned k = 0; k < MIC_COUNT; k++){
+    this->position[k] = 0;
+    this->delay[k] = 0;
+  }
+}
+
+
+template <unsigned MIC_COUNT, unsigned MAX_DELAY>
+void mic_array::DelaySampleFilter<MIC_COUNT, MAX_DELAY>::SetDelay(
+    unsigned channel,
+    unsigned delay)
+{
+  assert(delay <= MAX_DELAY);
+  this->delay[channel] = delay;
+}
+
+
+template <unsigned MIC_COUNT, unsigned MAX_DELAY>
+void mic_array::DelaySampleFilter<MIC_COUNT, MAX_DELAY>::Filter(
+    int32_t sample[MIC_COUNT])
+{
+  for(unsigned k = 0; k < MIC_COUNT; k++)
+    sample[k] = FilterChannel(k, sample[k]);
+}
+
+
+template <unsigned MIC_COUNT, unsigned MAX_DELAY>
+int32_t mic_array::DelaySampleFilter<MIC_COUNT, MAX_DELAY>::FilterChannel(
+    unsigned channel,
+    int32_t sample)
+{
+  int32_t* hist = this->history[channel];
+  const unsigned pos = this->position[channel];
+  const unsigned delay = this->delay[channel];
+
+  hist[pos] = sample;
+  const unsigned out = (pos >= delay)? (pos - delay) 
+                                     : (pos + HISTORY_LEN - delay);
+  this->position[channel] = (pos + 1 == HISTORY_LEN)? 0 : (pos + 1);
+  return hist[out];
+}
+
+
+template <unsigned MIC_COUNT, class... TFilters>
+void mic_array::SampleFilterChain<MIC_COUNT, TFilters...>::Init()
+{
+  InitStages(std::integral_constant<unsigned, 0>());
+}
+
+
+template <unsigned MIC_COUNT, class... TFilters>
+void mic_array::SampleFilterChain<MIC_COUNT, TFilters...>::Filter(
+    int32_t sample[MIC_COUNT])
+{
+  for(unsigned k = 0; k < MIC_COUNT; k++)
+    sample[k] = FilterChannel(k, sample[k]);
+}
+
+
+template <unsigned MIC_COUNT, class... TFilters>
+int32_t mic_array::SampleFilterChain<MIC_COUNT, TFilters...>::FilterChannel(
+    unsigned channel,
+    int32_t sample)
+{
+  return Apply(channel, sample, std::integral_constant<unsigned, 0>());
+}
+
+
+template <unsigned MIC_COUNT, class... TFilters>
+template <unsigned SAMPLES>
+void mic_array::SampleFilterChain<MIC_COUNT, TFilters...>::FilterSamples(
+    int32_t (&samples)[SAMPLES][MIC_COUNT])
+{
+  for(unsigned s = 0; s < SAMPLES; s++)
+    for(unsigned k = 0; k < MIC_COUNT; k++)
+      samples[s][k] = FilterChannel(k, samples[s][k]);
+}
+
+
+template <unsigned MIC_COUNT, class... TFilters>
+template <unsigned SAMPLE_COUNT>
+void mic_array::SampleFilterChain<MIC_COUNT, TFilters...>::FilterFrame(
+    int32_t (&frame)[MIC_COUNT][SAMPLE_COUNT])
+{
+  // Stages keep no state shared between channels, so each channel's samples
+  // can be filtered in one run.
+  for(unsigned k = 0; k < MIC_COUNT; k++)
+    for(unsigned s = 0; s < SAMPLE_COUNT; s++)
+      frame[k][s] = FilterChannel(k, frame[k][s]);
+}
+
+
+template <unsigned MIC_COUNT, class... TFilters>
+template <unsigned INDEX>
+void mic_array::SampleFilterChain<MIC_COUNT, TFilters...>::InitStages(
+    std::integral_constant<unsigned, INDEX>)
+{
+  std::get<INDEX>(Stages).Init();
+  InitStages(std::integral_constant<unsigned, INDEX + 1>());
+}
+
+
+template <unsigned MIC_COUNT, class... TFilters>
+template <unsigned INDEX>
+int32_t mic_array::SampleFilterChain<MIC_COUNT, TFilters...>::Apply(
+    unsigned channel,
+    int32_t sample,
+    std::integral_constant<unsigned, INDEX>)
+{
+  return Apply(channel, std::get<INDEX>(Stages).FilterChannel(channel, sample),
+               std::integral_constant<unsigned, INDEX + 1>());
+}
+
+
+template <unsigned MIC_COUNT, unsigned TAP_COUNT>
+void mic_array::CalibrationSampleFilter<MIC_COUNT, TAP_COUNT>::Init()
+{
+  memset(this->history, 0, sizeof(this->history));
+  this->position = 0;
+
+  memset(this->coef, 0, sizeof(this->coef));
+  for(unsigned k = 0; k < MIC_COUNT; k++)
+    this->coef[0][k] = TAP_UNITY;
+}
+
+
+template <unsigned MIC_COUNT, unsigned TAP_COUNT>
+void mic_array::CalibrationSampleFilter<MIC_COUNT, TAP_COUNT>::SetTaps(
+    unsigned channel,
+    const int32_t taps[TAP_COUNT])
+{
+  for(unsigned t = 0; t < TAP_COUNT; t++)
+    this->coef[t][channel] = taps[t];
+}
+
+
+template <unsigned MIC_COUNT, unsigned TAP_COUNT>
+void mic_array::CalibrationSampleFilter<MIC_COUNT, TAP_COUNT>::SetCalibration(
+    unsigned channel,
+    float gain,
+    float delay)
+{
+  assert(delay >= 0 && delay <= (TAP_COUNT - 1));
+
+  int32_t taps[TAP_COUNT];
+  for(unsigned t = 0; t < TAP_COUNT; t++){
+    // Lagrange interpolator: tap t is 1 at delay t and 0 at the other taps.
+    float h = gain;
+    for(unsigned j = 0; j < TAP_COUNT; j++)
+      if(j != t)
+        h *= (delay - j) / ((float) t - (float) j);
+
+    const float q = h * TAP_UNITY;
+    taps[t] = (q >= 2147483647.0f)? INT32_MAX 
+            : (q <= -2147483648.0f)? INT32_MIN 
+            : (int32_t) ((q >= 0)? (q + 0.5f) : (q - 0.5f));
+  }
+
+  SetTaps(channel, taps);
+}
+
+
+template <unsigned MIC_COUNT, unsigned TAP_COUNT>
+void mic_array::CalibrationSampleFilter<MIC_COUNT, TAP_COUNT>::Filter(
+    int32_t sample[MIC_COUNT])
+{
+  this->position = (this->position == 0)? (TAP_COUNT - 1) 
+                                        : (this->position - 1);
+
+  memcpy(&this->history[this->position][0], &sample[0], 
+         sizeof(int32_t) * MIC_COUNT);
+  memcpy(&this->history[this->position + TAP_COUNT][0], &sample[0], 
+         sizeof(int32_t) * MIC_COUNT);
+
+  calibration_filter_s32(&sample[0], &this->history[this->position][0],
+                         &this->coef[0][0], MIC_COUNT, TAP_COUNT);
+}
+
+
+template <unsigned MIC_COUNT, unsigned TAP_COUNT>
+template <unsigned SAMPLES>
+void mic_array::CalibrationSampleFilter<MIC_COUNT, TAP_COUNT>::FilterSamples(
+    int32_t (&samples)[SAMPLES][MIC_COUNT])
+{
+  for(unsigned s = 0; s < SAMPLES; s++)
+    Filter(samples[s]);
+}
+
+
+template <unsigned MIC_COUNT, unsigned TAP_COUNT>
+template <unsigned SAMPLE_COUNT>
+void mic_array::CalibrationSampleFilter<MIC_COUNT, TAP_COUNT>::FilterFrame(
+    int32_t (&frame)[MIC_COUNT][SAMPLE_COUNT])
+{
+  for(unsigned s = 0; s < SAMPLE_COUNT; s++){
+    int32_t sample[MIC_COUNT];
+    for(unsigned k = 0; k < MIC_COUNT; k++)
+      sample[k] = frame[k][s];
+
+    Filter(sample);
+
+    for(unsigned k = 0; k < MIC_COUNT; k++)
+      frame[k][s] = sample[k];
+  }
+}
+
+
+template <unsigned MIC_COUNT, unsigned WINDOW_SIZE>
+void mic_array::LevelMeterSampleFilter<MIC_COUNT, WINDOW_SIZE>::Init()
+{
+  this->clip_level = INT32_MAX;
+  for(unsigned k = 0; k < MIC_COUNT; k++){
+    this->count[k] = 0;
+    this->peak[k] = 0;
+    this->energy[k] = 0;
+    this->clips[k] = 0;
+  }
+
+  this->seq = 0;
+  memset(&this->levels, 0, sizeof(this->levels));
+}
+
+
+template <unsigned MIC_COUNT, unsigned WINDOW_SIZE>
+void mic_array::LevelMeterSampleFilter<MIC_COUNT, WINDOW_SIZE>::SetClipLevel(
+    uint32_t level)
+{
+  this->clip_level = level;
+}
+
+
+template <unsigned MIC_COUNT, unsigned WINDOW_SIZE>
+mic_array::ChannelLevels<MIC_COUNT> 
+    mic_array::LevelMeterSampleFilter<MIC_COUNT, WINDOW_SIZE>::GetLevels() const
+{
+  ChannelLevels<MIC_COUNT> res;
+  unsigned before;
+
+  do {
+    before = this->seq;
+    std::atomic_signal_fence(std::memory_order_seq_cst);
+    memcpy(&res, &this->levels, sizeof(res));
+    std::atomic_signal_fence(std::memory_order_seq_cst);
+  } while((before & 1) || this->seq != before);
+
+  return res;
+}
+
+
+template <unsigned MIC_COUNT, unsigned WINDOW_SIZE>
+void mic_array::LevelMeterSampleFilter<MIC_COUNT, WINDOW_SIZE>::Filter(
+    int32_t sample[MIC_COUNT])
+{
+  for(unsigned k = 0; k < MIC_COUNT; k++)
+    FilterChannel(k, sample[k]);
+}
+
+
+template <unsigned MIC_COUNT, unsigned WINDOW_SIZE>
+int32_t mic_array::LevelMeterSampleFilter<MIC_COUNT, WINDOW_SIZE>::FilterChannel(
+    unsigned channel,
+    int32_t sample)
+{
+  const uint32_t mag = (sample < 0)? (0u - (uint32_t) sample) 
+                                   : (uint32_t) sample;
+  const int32_t s = sample >> 8;
+
+  if(mag > this->peak[channel]) this->peak[channel] = mag;
+  if(mag >= this->clip_level) this->clips[channel]++;
+  this->energy[channel] += (uint64_t) ((int64_t) s * s);
+
+  if(++this->count[channel] == WINDOW_SIZE)
+    Publish(channel);
+
+  return sample;
+}
+
+
+template <unsigned MIC_COUNT, unsigned WINDOW_SIZE>
+template <unsigned SAMPLES>
+void mic_array::LevelMeterSampleFilter<MIC_COUNT, WINDOW_SIZE>::FilterSamples(
+    int32_t (&samples)[SAMPLES][MIC_COUNT])
+{
+  for(unsigned s = 0; s < SAMPLES; s++)
+    Filter(samples[s]);
+}
+
+
+template <unsigned MIC_COUNT, unsigned WINDOW_SIZE>
+template <unsigned SAMPLE_COUNT>
+void mic_array::LevelMeterSampleFilter<MIC_COUNT, WINDOW_SIZE>::FilterFrame(
+    int32_t (&frame)[MIC_COUNT][SAMPLE_COUNT])
+{
+  // Channels are metered independently, so each channel's samples can be
+  // metered in one run.
+  for(unsigned k = 0; k < MIC_COUNT; k++)
+    for(unsigned s = 0; s < SAMPLE_COUNT; s++)
+      FilterChannel(k, frame[k][s]);
+}
+
+
+template <unsigned MIC_COUNT, unsigned WINDOW_SIZE>
+void mic_array::LevelMeterSampleFilter<MIC_COUNT, WINDOW_SIZE>::Publish(
+    unsigned channel)
+{
+  this->seq = this->seq + 1;
+  std::atomic_signal_fence(std::memory_order_seq_cst);
+  this->levels.peak[channel] = this->peak[channel];
+  this->levels.mean_square[channel] = this->energy[channel] / WINDOW_SIZE;
+  this->levels.clips[channel] = this->clips[channel];
+  if(channel == MIC_COUNT - 1)
+    this->levels.windows++;
+  std::atomic_signal_fence(std::memory_order_seq_cst);
+  this->seq = this->seq + 1;
+
+  this->count[channel] = 0;
+  this->peak[channel] = 0;
+  this->energy[channel] = 0;
+  this->clips[channel] = 0;
+}
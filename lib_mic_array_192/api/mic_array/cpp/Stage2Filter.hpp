@@ -0,0 +1,778 @@
+// Copyright 2022-2024 XMOS LIMITED.
+// This Software is subject to the terms of the XMOS Public Licence: Version 1.
+
+#pragma once
+
+#include <cstdint>
+#include <cassert>
+#include <cstring>
+
+#include "xmath/xmath.h"
+#include "mic_array/etc/fir_s32_multi.h"
+#include "mic_array/etc/fir_s16_multi.h"
+#include "Mips.hpp"
+
+// This has caused problems previously, so just catch the problems here.
+#if defined(CHANNELS) || defined(TAP_COUNT) || defined(DEC_FACTOR)
+# error Application must not define the following as precompiler macros: CHANNELS, TAP_COUNT, DEC_FACTOR.
+#endif
+
+namespace  mic_array {
+
+  /**
+   * @brief Decimating 32-bit FIR filter for several channels.
+   *
+   * This is the second stage filter of @ref TwoStageDecimator. Each input
+   * sample only costs a store into the channel's history; the filter itself
+   * is evaluated only when @ref Filter() is called, which a decimator does
+   * once every `DEC_FACTOR` input samples. All channels are evaluated
+   * together by `fir_s32_multi()`, with the history and coefficient buffers
+   * sized at compile time.
+   *
+   * As with @ref PdmHistory, each channel's history is a buffer in which the
+   * filter's window slides one sample towards the front on each
+   * @ref Advance(), and is only moved back to the end of the buffer once every
+   * `HISTORY_STEPS` samples.
+   *
+   * The arithmetic is that of lib_xcore_math's `filter_fir_s32()`, so the
+   * same coefficients and output shift can be used.
+   *
+   * @tparam CHANNELS   Number of channels filtered.
+   * @tparam TAP_COUNT  Number of filter taps.
+   * @tparam DEC_FACTOR @parblock
+   * Decimation factor. Only used to size the history so that moving the
+   * window back happens once every few outputs.
+   * @endparblock
+   */
+  template <unsigned CHANNELS, unsigned TAP_COUNT, unsigned DEC_FACTOR>
+  class Stage2Filter
+  {
+    static_assert(TAP_COUNT >= 1, "TAP_COUNT must be at least 1.");
+    static_assert(DEC_FACTOR >= 1, "DEC_FACTOR must be at least 1.");
+
+    public:
+
+      /**
+       * Type of the filter coefficients.
+       */
+      using Coef = int32_t;
+
+      /**
+       * Maximum number of 8-tap blocks processed for each output.
+       */
+      static constexpr unsigned TapBlocks = (TAP_COUNT + 7) / 8;
+
+      /**
+       * Number of taps after padding with zero coefficients.
+       */
+      static constexpr unsigned PaddedTaps = 8 * TapBlocks;
+
+    private:
+
+      /**
+       * Input samples the window can slide before it must be moved back.
+       */
+      static constexpr unsigned HISTORY_STEPS = 4 * DEC_FACTOR;
+
+    public:
+
+      /**
+       * Distance, in words, between consecutive channels' windows.
+       */
+      static constexpr unsigned Stride = HISTORY_STEPS + PaddedTaps;
+
+    private:
+
+      /**
+       * Index of the window's first (newest) sample in each channel's buffer.
+       */
+      unsigned pos = HISTORY_STEPS;
+
+      /**
+       * Number of 8-tap blocks of the current coefficients.
+       */
+      unsigned tap_blocks = TapBlocks;
+
+      /**
+       * Output right-shift.
+       */
+      right_shift_t shr = 0;
+
+      /**
+       * Filter coefficients, padded with zeros to `PaddedTaps`.
+       */
+      int32_t WORD_ALIGNED coef[PaddedTaps] = {0};
+
+      /**
+       * History buffers.
+       */
+      int32_t WORD_ALIGNED buff[CHANNELS][Stride] = {{0}};
+
+    public:
+
+      constexpr Stage2Filter() noexcept {}
+
+      /**
+       * @brief Initialize the filter.
+       *
+       * @param coef  Filter coefficients, `TAP_COUNT` words.
+       * @param shr   Non-negative output right-shift.
+       */
+      void Init(
+          const int32_t* coef,
+          const right_shift_t shr);
+
+      /**
+       * @brief Initialize the filter with fewer than `TAP_COUNT` taps.
+       *
+       * Only the first `tap_count` taps are evaluated by @ref Filter(). The
+       * history always covers `TAP_COUNT` samples, so this may also be called
+       * while the filter is running to switch to different coefficients
+       * without losing history; the new coefficients apply from the next call
+       * to @ref Filter().
+       *
+       * @param coef      Filter coefficients, `tap_count` words.
+       * @param tap_count Number of filter taps, at most `TAP_COUNT`.
+       * @param shr       Non-negative output right-shift.
+       */
+      void Init(
+          const int32_t* coef,
+          const unsigned tap_count,
+          const right_shift_t shr);
+
+      /**
+       * @brief Make room for a new sample in each channel's window.
+       *
+       * The window's first sample must then be filled in with @ref Set()
+       * before @ref Filter() is called.
+       */
+      void Advance();
+
+      /**
+       * @brief Set the newest sample in a channel's window.
+       *
+       * @param channel Channel index.
+       * @param sample  New input sample.
+       */
+      void Set(
+          unsigned channel,
+          int32_t sample);
+
+      /**
+       * @brief Compute the filter's output for all channels.
+       *
+       * @param out Output sample vector.
+       */
+      void Filter(
+          int32_t out[CHANNELS]);
+
+      /**
+       * @brief Compute the filter's output for the first few channels.
+       *
+       * As @ref Filter(), but only channels `0` to `channels - 1` are 
+       * evaluated. `out[]` is untouched for the other channels.
+       *
+       * @param out       Output sample vector.
+       * @param channels  Number of channels to evaluate, at most `CHANNELS`.
+       */
+      void Filter(
+          int32_t out[CHANNELS],
+          unsigned channels);
+
+      /**
+       * @brief Compute the filter's output for all channels with other
+       *        coefficients.
+       *
+       * As @ref Filter(), but with `coef` and `shr` in place of those given
+       * to @ref Init(), e.g. for a polyphase filter, which applies a
+       * different phase of its coefficients to each output.
+       *
+       * @param out   Output sample vector.
+       * @param coef  Filter coefficients, `PaddedTaps` words (32-bit aligned).
+       * @param shr   Non-negative output right-shift.
+       */
+      void Filter(
+          int32_t out[CHANNELS],
+          const int32_t coef[PaddedTaps],
+          const right_shift_t shr);
+
+      /**
+       * @brief Copy the current coefficients and output shift out.
+       *
+       * The coefficients are padded with zeros to `PaddedTaps`, so they can
+       * be passed back to the three-argument @ref Filter(), e.g. to keep 
+       * evaluating the old filter for a while after @ref Init() has 
+       * switched to a new one.
+       *
+       * @param coef  Destination, `PaddedTaps` words (32-bit aligned).
+       * @param shr   Destination for the output right-shift.
+       */
+      void SaveCoef(
+          int32_t coef[PaddedTaps],
+          right_shift_t& shr) const;
+
+      /**
+       * @brief Fill a channel's history with a single sample value.
+       *
+       * Every sample of the channel's history is set to `sample`, which is
+       * the filter's steady state for a constant input of `sample`.
+       *
+       * @param channel Channel index.
+       * @param sample  Sample value.
+       */
+      void Fill(
+          unsigned channel,
+          int32_t sample);
+
+      /**
+       * @brief Copy a channel's current window out.
+       *
+       * @param channel Channel index.
+       * @param history Destination, `PaddedTaps` samples, newest first.
+       */
+      void Save(
+          unsigned channel,
+          int32_t history[PaddedTaps]) const;
+
+      /**
+       * @brief Replace a channel's current window.
+       *
+       * The inverse of @ref Save().
+       *
+       * @param channel Channel index.
+       * @param history New window, `PaddedTaps` samples, newest first.
+       */
+      void Load(
+          unsigned channel,
+          const int32_t history[PaddedTaps]);
+  };
+
+  /**
+   * @brief Decimating 16-bit FIR filter for several channels.
+   *
+   * A drop-in alternative to @ref Stage2Filter with 16-bit coefficients and
+   * history, for outputs (e.g. 16 kHz voice) which do not need the SNR of
+   * 32-bit filtering. All channels are evaluated together by
+   * `fir_s16_multi()`, which runs the vector unit in its 16-bit mode, so
+   * each instruction covers 16 taps rather than 8, and the history and
+   * coefficients take half the memory.
+   *
+   * Samples are 32-bit on the way in and out. @ref Set() and @ref Fill()
+   * keep the upper 16 bits of each input sample (rounded), and the filter
+   * keeps the whole 32-bit accumulator, so with coefficients scaled down by
+   * `2^16` the output shift is that of the 32-bit filter minus 2 (see
+   * @ref stage2_coef_s16 and @ref stage2_shr_s16).
+   *
+   * The windows are moved back by whole words, so `DEC_FACTOR` must be
+   * even.
+   *
+   * @tparam CHANNELS   Number of channels filtered.
+   * @tparam TAP_COUNT  Number of filter taps.
+   * @tparam DEC_FACTOR Decimation factor; even.
+   */
+  template <unsigned CHANNELS, unsigned TAP_COUNT, unsigned DEC_FACTOR>
+  class Stage2FilterS16
+  {
+    static_assert(TAP_COUNT >= 1, "TAP_COUNT must be at least 1.");
+    static_assert(DEC_FACTOR >= 2 && (DEC_FACTOR % 2) == 0, 
+                  "DEC_FACTOR must be even.");
+
+    public:
+
+      /**
+       * Type of the filter coefficients.
+       */
+      using Coef = int16_t;
+
+      /**
+       * Maximum number of 16-tap blocks processed for each output.
+       */
+      static constexpr unsigned TapBlocks = (TAP_COUNT + 15) / 16;
+
+      /**
+       * Number of taps after padding with zero coefficients.
+       */
+      static constexpr unsigned PaddedTaps = 16 * TapBlocks;
+
+    private:
+
+      /**
+       * Input samples the window can slide before it must be moved back.
+       */
+      static constexpr unsigned HISTORY_STEPS = 4 * DEC_FACTOR;
+
+    public:
+
+      /**
+       * Distance, in samples, between consecutive channels' windows.
+       */
+      static constexpr unsigned Stride = HISTORY_STEPS + PaddedTaps;
+
+    private:
+
+      /**
+       * Index of the window's first (newest) sample in each channel's buffer.
+       */
+      unsigned pos = HISTORY_STEPS;
+
+      /**
+       * Number of 16-tap blocks of the current coefficients.
+       */
+      unsigned tap_blocks = TapBlocks;
+
+      /**
+       * Output right-shift.
+       */
+      right_shift_t shr = 0;
+
+      /**
+       * Filter coefficients, padded with zeros to `PaddedTaps`.
+       */
+      int16_t WORD_ALIGNED coef[PaddedTaps] = {0};
+
+      /**
+       * History buffers.
+       */
+      int16_t WORD_ALIGNED buff[CHANNELS][Stride] = {{0}};
+
+      /**
+       * Upper 16 bits of a 32-bit sample, rounded and saturated.
+       */
+      static int16_t ToS16(int32_t sample);
+
+    public:
+
+      constexpr Stage2FilterS16() noexcept {}
+
+      /**
+       * @brief Initialize the filter.
+       *
+       * @param coef  Filter coefficients, `TAP_COUNT` elements.
+       * @param shr   Non-negative output right-shift.
+       */
+      void Init(
+          const int16_t* coef,
+          const right_shift_t shr);
+
+      /**
+       * @brief Initialize the filter with fewer than `TAP_COUNT` taps.
+       *
+       * As @ref Stage2Filter::Init(), so it may also be called while the
+       * filter is running.
+       *
+       * @param coef      Filter coefficients, `tap_count` elements.
+       * @param tap_count Number of filter taps, at most `TAP_COUNT`.
+       * @param shr       Non-negative output right-shift.
+       */
+      void Init(
+          const int16_t* coef,
+          const unsigned tap_count,
+          const right_shift_t shr);
+
+      /**
+       * @brief Make room for a new sample in each channel's window.
+       */
+      void Advance();
+
+      /**
+       * @brief Set the newest sample in a channel's window.
+       *
+       * Only the upper 16 bits of `sample` are kept.
+       *
+       * @param channel Channel index.
+       * @param sample  New input sample.
+       */
+      void Set(
+          unsigned channel,
+          int32_t sample);
+
+      /**
+       * @brief Compute the filter's output for all channels.
+       *
+       * @param out Output sample vector.
+       */
+      void Filter(
+          int32_t out[CHANNELS]);
+
+      /**
+       * @brief Compute the filter's output for the first few channels.
+       *
+       * @param out       Output sample vector.
+       * @param channels  Number of channels to evaluate, at most `CHANNELS`.
+       */
+      void Filter(
+          int32_t out[CHANNELS],
+          unsigned channels);
+
+      /**
+       * @brief Compute the filter's output for all channels with other
+       *        coefficients.
+       *
+       * As the three-argument @ref Stage2Filter::Filter().
+       *
+       * @param out   Output sample vector.
+       * @param coef  Filter coefficients, `PaddedTaps` elements (32-bit
+       *              aligned).
+       * @param shr   Non-negative output right-shift.
+       */
+      void Filter(
+          int32_t out[CHANNELS],
+          const int16_t coef[PaddedTaps],
+          const right_shift_t shr);
+
+      /**
+       * @brief Copy the current coefficients and output shift out.
+       *
+       * As @ref Stage2Filter::SaveCoef().
+       *
+       * @param coef  Destination, `PaddedTaps` elements (32-bit aligned).
+       * @param shr   Destination for the output right-shift.
+       */
+      void SaveCoef(
+          int16_t coef[PaddedTaps],
+          right_shift_t& shr) const;
+
+      /**
+       * @brief Fill a channel's history with a single sample value.
+       *
+       * Only the upper 16 bits of `sample` are kept.
+       *
+       * @param channel Channel index.
+       * @param sample  Sample value.
+       */
+      void Fill(
+          unsigned channel,
+          int32_t sample);
+
+      /**
+       * @brief Copy a channel's current window out.
+       *
+       * @param channel Channel index.
+       * @param history Destination, `PaddedTaps` samples, newest first.
+       */
+      void Save(
+          unsigned channel,
+          int16_t history[PaddedTaps]) const;
+
+      /**
+       * @brief Replace a channel's current window.
+       *
+       * @param channel Channel index.
+       * @param history New window, `PaddedTaps` samples, newest first.
+       */
+      void Load(
+          unsigned channel,
+          const int16_t history[PaddedTaps]);
+  };
+
+
+  /**
+   * @brief Stage 2 filter with `COEF_BITS` bit coefficients.
+   *
+   * Used by decimators which take their stage 2 coefficient width as a
+   * template parameter: `Type<CHANNELS,TAP_COUNT,DEC_FACTOR>` is
+   * @ref Stage2Filter for 32 and @ref Stage2FilterS16 for 16.
+   *
+   * @tparam COEF_BITS  Bits per stage 2 coefficient: 32 or 16.
+   */
+  template <unsigned COEF_BITS>
+  struct Stage2FilterOf;
+
+  template <>
+  struct Stage2FilterOf<32> {
+    template <unsigned CHANNELS, unsigned TAP_COUNT, unsigned DEC_FACTOR>
+    using Type = Stage2Filter<CHANNELS, TAP_COUNT, DEC_FACTOR>;
+
+    /** Filter taps per instruction (see @ref KernelCost). */
+    static constexpr unsigned TapsPerInstr = KernelCost::FirS32TapsPerInstr;
+  };
+
+  template <>
+  struct Stage2FilterOf<16> {
+    template <unsigned CHANNELS, unsigned TAP_COUNT, unsigned DEC_FACTOR>
+    using Type = Stage2FilterS16<CHANNELS, TAP_COUNT, DEC_FACTOR>;
+
+    /** Filter taps per instruction (see @ref KernelCost). */
+    static constexpr unsigned TapsPerInstr = KernelCost::FirS16TapsPerInstr;
+  };
+
+}
+
+//////////////////////////////////////////////
+// Template function implementations below. //
+//////////////////////////////////////////////
+
+
+template <unsigned CHANNELS, unsigned TAP_COUNT, unsigned DEC_FACTOR>
+void mic_array::Stage2Filter<CHANNELS,TAP_COUNT,DEC_FACTOR>::Init(
+    const int32_t* coef,
+    const right_shift_t shr)
+{
+  this->Init(coef, TAP_COUNT, shr);
+}
+
+
+template <unsigned CHANNELS, unsigned TAP_COUNT, unsigned DEC_FACTOR>
+void mic_array::Stage2Filter<CHANNELS,TAP_COUNT,DEC_FACTOR>::Init(
+    const int32_t* coef,
+    const unsigned tap_count,
+    const right_shift_t shr)
+{
+  assert(tap_count >= 1 && tap_count <= TAP_COUNT);
+
+  for(unsigned k = 0; k < tap_count; k++)
+    this->coef[k] = coef[k];
+  for(unsigned k = tap_count; k < PaddedTaps; k++)
+    this->coef[k] = 0;
+  this->tap_blocks = (tap_count + 7) / 8;
+  this->shr = shr;
+}
+
+
+template <unsigned CHANNELS, unsigned TAP_COUNT, unsigned DEC_FACTOR>
+void mic_array::Stage2Filter<CHANNELS,TAP_COUNT,DEC_FACTOR>::Advance()
+{
+  if(this->pos == 0){
+    // Copy the window to the end of the buffer, last block first so that
+    // no block is overwritten before it has been read.
+    for(unsigned ch = 0; ch < CHANNELS; ch++){
+      for(int blk = TapBlocks-1; blk >= 0; blk--){
+        int32_t* src = &this->buff[ch][8*blk];
+        int32_t* dst = &this->buff[ch][8*blk + HISTORY_STEPS];
+#if defined(__XS3A__)
+        asm volatile("vldd %0[0]; vstd %1[0];" :: "r"(src), "r"(dst) : "memory" );
+#else
+        std::memmove(dst, src, 8 * sizeof(int32_t));
+#endif
+      }
+    }
+    this->pos = HISTORY_STEPS;
+  }
+  this->pos--;
+}
+
+
+template <unsigned CHANNELS, unsigned TAP_COUNT, unsigned DEC_FACTOR>
+void mic_array::Stage2Filter<CHANNELS,TAP_COUNT,DEC_FACTOR>::Set(
+    unsigned channel,
+    int32_t sample)
+{
+  this->buff[channel][this->pos] = sample;
+}
+
+
+template <unsigned CHANNELS, unsigned TAP_COUNT, unsigned DEC_FACTOR>
+void mic_array::Stage2Filter<CHANNELS,TAP_COUNT,DEC_FACTOR>::Filter(
+    int32_t out[CHANNELS])
+{
+  fir_s32_multi(out, &this->buff[0][this->pos], this->coef,
+                CHANNELS, Stride, this->tap_blocks, this->shr);
+}
+
+
+template <unsigned CHANNELS, unsigned TAP_COUNT, unsigned DEC_FACTOR>
+void mic_array::Stage2Filter<CHANNELS,TAP_COUNT,DEC_FACTOR>::Filter(
+    int32_t out[CHANNELS],
+    unsigned channels)
+{
+  assert(channels <= CHANNELS);
+
+  fir_s32_multi(out, &this->buff[0][this->pos], this->coef,
+                channels, Stride, this->tap_blocks, this->shr);
+}
+
+
+template <unsigned CHANNELS, unsigned TAP_COUNT, unsigned DEC_FACTOR>
+void mic_array::Stage2Filter<CHANNELS,TAP_COUNT,DEC_FACTOR>::Filter(
+    int32_t out[CHANNELS],
+    const int32_t coef[PaddedTaps],
+    const right_shift_t shr)
+{
+  fir_s32_multi(out, &this->buff[0][this->pos], coef,
+                CHANNELS, Stride, TapBlocks, shr);
+}
+
+
+template <unsigned CHANNELS, unsigned TAP_COUNT, unsigned DEC_FACTOR>
+void mic_array::Stage2Filter<CHANNELS,TAP_COUNT,DEC_FACTOR>::SaveCoef(
+    int32_t coef[PaddedTaps],
+    right_shift_t& shr) const
+{
+  std::memcpy(coef, this->coef, sizeof(this->coef));
+  shr = this->shr;
+}
+
+
+template <unsigned CHANNELS, unsigned TAP_COUNT, unsigned DEC_FACTOR>
+void mic_array::Stage2Filter<CHANNELS,TAP_COUNT,DEC_FACTOR>::Fill(
+    unsigned channel,
+    int32_t sample)
+{
+  for(unsigned k = 0; k < Stride; k++)
+    this->buff[channel][k] = sample;
+}
+
+
+template <unsigned CHANNELS, unsigned TAP_COUNT, unsigned DEC_FACTOR>
+void mic_array::Stage2Filter<CHANNELS,TAP_COUNT,DEC_FACTOR>::Save(
+    unsigned channel,
+    int32_t history[PaddedTaps]) const
+{
+  std::memcpy(history, &this->buff[channel][this->pos], 
+              PaddedTaps * sizeof(int32_t));
+}
+
+
+template <unsigned CHANNELS, unsigned TAP_COUNT, unsigned DEC_FACTOR>
+void mic_array::Stage2Filter<CHANNELS,TAP_COUNT,DEC_FACTOR>::Load(
+    unsigned channel,
+    const int32_t history[PaddedTaps])
+{
+  std::memcpy(&this->buff[channel][this->pos], history, 
+              PaddedTaps * sizeof(int32_t));
+}
+
+
+template <unsigned CHANNELS, unsigned TAP_COUNT, unsigned DEC_FACTOR>
+int16_t mic_array::Stage2FilterS16<CHANNELS,TAP_COUNT,DEC_FACTOR>::ToS16(
+    int32_t sample)
+{
+  // round(sample / 2^16) as (s >> 1) + (s & 1), s = sample >> 15
+  const int32_t s = sample >> 15;
+  const int32_t r = (s >> 1) + (s & 1);
+  return (r > INT16_MAX)? INT16_MAX : (int16_t) r;
+}
+
+
+template <unsigned CHANNELS, unsigned TAP_COUNT, unsigned DEC_FACTOR>
+void mic_array::Stage2FilterS16<CHANNELS,TAP_COUNT,DEC_FACTOR>::Init(
+    const int16_t* coef,
+    const right_shift_t shr)
+{
+  this->Init(coef, TAP_COUNT, shr);
+}
+
+
+template <unsigned CHANNELS, unsigned TAP_COUNT, unsigned DEC_FACTOR>
+void mic_array::Stage2FilterS16<CHANNELS,TAP_COUNT,DEC_FACTOR>::Init(
+    const int16_t* coef,
+    const unsigned tap_count,
+    const right_shift_t shr)
+{
+  assert(tap_count >= 1 && tap_count <= TAP_COUNT);
+
+  for(unsigned k = 0; k < tap_count; k++)
+    this->coef[k] = coef[k];
+  for(unsigned k = tap_count; k < PaddedTaps; k++)
+    this->coef[k] = 0;
+  this->tap_blocks = (tap_count + 15) / 16;
+  this->shr = shr;
+}
+
+
+template <unsigned CHANNELS, unsigned TAP_COUNT, unsigned DEC_FACTOR>
+void mic_array::Stage2FilterS16<CHANNELS,TAP_COUNT,DEC_FACTOR>::Advance()
+{
+  if(this->pos == 0){
+    // Copy the window to the end of the buffer, last block first so that
+    // no block is overwritten before it has been read.
+    for(unsigned ch = 0; ch < CHANNELS; ch++){
+      for(int blk = TapBlocks-1; blk >= 0; blk--){
+        int16_t* src = &this->buff[ch][16*blk];
+        int16_t* dst = &this->buff[ch][16*blk + HISTORY_STEPS];
+#if defined(__XS3A__)
+        asm volatile("vldd %0[0]; vstd %1[0];" :: "r"(src), "r"(dst) : "memory" );
+#else
+        std::memmove(dst, src, 16 * sizeof(int16_t));
+#endif
+      }
+    }
+    this->pos = HISTORY_STEPS;
+  }
+  this->pos--;
+}
+
+
+template <unsigned CHANNELS, unsigned TAP_COUNT, unsigned DEC_FACTOR>
+void mic_array::Stage2FilterS16<CHANNELS,TAP_COUNT,DEC_FACTOR>::Set(
+    unsigned channel,
+    int32_t sample)
+{
+  this->buff[channel][this->pos] = ToS16(sample);
+}
+
+
+template <unsigned CHANNELS, unsigned TAP_COUNT, unsigned DEC_FACTOR>
+void mic_array::Stage2FilterS16<CHANNELS,TAP_COUNT,DEC_FACTOR>::Filter(
+    int32_t out[CHANNELS])
+{
+  this->Filter(out, CHANNELS);
+}
+
+
+template <unsigned CHANNELS, unsigned TAP_COUNT, unsigned DEC_FACTOR>
+void mic_array::Stage2FilterS16<CHANNELS,TAP_COUNT,DEC_FACTOR>::Filter(
+    int32_t out[CHANNELS],
+    unsigned channels)
+{
+  assert(channels <= CHANNELS);
+  // The kernel needs word-aligned windows.
+  assert((this->pos % 2) == 0);
+
+  fir_s16_multi(out, &this->buff[0][this->pos], this->coef,
+                channels, Stride, this->tap_blocks, this->shr);
+}
+
+
+template <unsigned CHANNELS, unsigned TAP_COUNT, unsigned DEC_FACTOR>
+void mic_array::Stage2FilterS16<CHANNELS,TAP_COUNT,DEC_FACTOR>::Filter(
+    int32_t out[CHANNELS],
+    const int16_t coef[PaddedTaps],
+    const right_shift_t shr)
+{
+  assert((this->pos % 2) == 0);
+
+  fir_s16_multi(out, &this->buff[0][this->pos], coef,
+                CHANNELS, Stride, TapBlocks, shr);
+}
+
+
+template <unsigned CHANNELS, unsigned TAP_COUNT, unsigned DEC_FACTOR>
+void mic_array::Stage2FilterS16<CHANNELS,TAP_COUNT,DEC_FACTOR>::SaveCoef(
+    int16_t coef[PaddedTaps],
+    right_shift_t& shr) const
+{
+  std::memcpy(coef, this->coef, sizeof(this->coef));
+  shr = this->shr;
+}
+
+
+template <unsigned CHANNELS, unsigned TAP_COUNT, unsigned DEC_FACTOR>
+void mic_array::Stage2FilterS16<CHANNELS,TAP_COUNT,DEC_FACTOR>::Fill(
+    unsigned channel,
+    int32_t sample)
+{
+  const int16_t s = ToS16(sample);
+  for(unsigned k = 0; k < Stride; k++)
+    this->buff[channel][k] = s;
+}
+
+
+template <unsigned CHANNELS, unsigned TAP_COUNT, unsigned DEC_FACTOR>
+void mic_array::Stage2FilterS16<CHANNELS,TAP_COUNT,DEC_FACTOR>::Save(
+    unsigned channel,
+    int16_t history[PaddedTaps]) const
+{
+  std::memcpy(history, &this->buff[channel][this->pos], 
+              PaddedTaps * sizeof(int16_t));
+}
+
+
+template <unsigned CHANNELS, unsigned TAP_COUNT, unsigned DEC_FACTOR>
+void mic_array::Stage2FilterS16<CHANNELS,TAP_COUNT,DEC_FACTOR>::Load(
+    unsigned channel,
+    const int16_t history[PaddedTaps])
+{
+  std::memcpy(&this->buff[channel][this->pos], history, 
+              PaddedTaps * sizeof(int16_t));
+}
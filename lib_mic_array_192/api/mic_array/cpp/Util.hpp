@@ -87,4 +87,215 @@ namespace mic_array {
       unsigned s2_dec_factor);
 
 
-}
\ No newline at end of file
+  /**
+   * @brief Number of channels that must be captured for `MIC_COUNT` mics.
+   * 
+   * PDM data can only be captured (and deinterleaved) for `1`, `2`, `4`, `8`
+   * or `16` channels at once, because those are the port widths (SDR) and
+   * twice the port widths (DDR) available. `value` is the smallest of these
+   * which is at least `MIC_COUNT`, i.e. the number of channels a PDM rx 
+   * service must capture (its `CHANNELS_IN`) for an array of `MIC_COUNT`
+   * microphones, of which only `MIC_COUNT` (its `CHANNELS_OUT`) then need be
+   * handed on and decimated. For example, a 6-mic array is captured as 8
+   * channels and a 12-mic array as 16.
+   * 
+   * @tparam MIC_COUNT  Number of microphones, from `1` to `16`.
+   */
+  template <unsigned MIC_COUNT>
+  struct PdmCaptureChannels {
+    static_assert(MIC_COUNT >= 1 && MIC_COUNT <= 16, 
+                  "MIC_COUNT must be between 1 and 16.");
+
+    /**
+     * @brief Number of channels to capture.
+     */
+    static constexpr unsigned value = (MIC_COUNT <= 1)? 1
+                                    : (MIC_COUNT <= 2)? 2
+                                    : (MIC_COUNT <= 4)? 4
+                                    : (MIC_COUNT <= 8)? 8 : 16;
+  };
+
+
+  /**
+   * @brief Deinterleave a block of PDM data and map its channels into a
+   *        mic-major output block.
+   * 
+   * Equivalent to `deinterleave_pdm_samples<MIC_COUNT>(samples, s2_dec_factor)`
+   * followed by
+   * 
+   * @code{.cpp}
+   *  for(int ch = 0; ch < channels_out; ch++)
+   *    for(int sb = 0; sb < s2_dec_factor; sb++)
+   *      out[ch*s2_dec_factor + sb] = 
+   *          samples[(s2_dec_factor-1-sb)*MIC_COUNT + channel_map[ch]];
+   * @endcode
+   * 
+   * `out` is then in the `[channels_out][s2_dec_factor]` order taken by the
+   * decimators, with the oldest samples of each channel first. For `MIC_COUNT`
+   * of `8` or `16` both steps are done by one call to 
+   * `deinterleave8_then_map()` or `deinterleave16_then_map()`.
+   * 
+   * `samples` is left deinterleaved, as by `deinterleave_pdm_samples()`.
+   * 
+   * @tparam MIC_COUNT    Number of channels represented in PDM data.   
+   *                      One of `{1,2,4,8,16}`
+   * 
+   * @param out           Output block, `channels_out*s2_dec_factor` words.
+   * @param samples       Pointer to block of PDM samples.
+   * @param s2_dec_factor Stage2 decimator decimation factor.
+   * @param channel_map   Input channel index of each output channel.
+   * @param channels_out  Number of output channels, at least 1.
+   */
+  template <unsigned MIC_COUNT>
+  void deinterleave_pdm_samples_mapped(
+      uint32_t* out,
+      uint32_t* samples,
+      unsigned s2_dec_factor,
+      const unsigned* channel_map,
+      unsigned channels_out);
+
+
+  /**
+   * @brief Deinterleave a block of PDM data into a mic-major output block,
+   *        with the direct channel mapping.
+   * 
+   * Same result in `out` as `deinterleave_pdm_samples_mapped<MIC_COUNT>(out,
+   * samples, s2_dec_factor, channel_map, MIC_COUNT)` with `channel_map[k] = 
+   * k`, but without looking up a channel map. For `MIC_COUNT` of `16` (e.g. 
+   * 16 mics in a DDR configuration on an 8-bit port) this uses 
+   * `deinterleave16_ddr()`, which stores each channel straight into `out`.
+   * 
+   * `samples` is clobbered.
+   * 
+   * @tparam MIC_COUNT    Number of channels represented in PDM data.   
+   *                      One of `{1,2,4,8,16}`
+   * 
+   * @param out           Output block, `MIC_COUNT*s2_dec_factor` words.
+   * @param samples       Pointer to block of PDM samples.
+   * @param s2_dec_factor Stage2 decimator decimation factor.
+   */
+  template <unsigned MIC_COUNT>
+  void deinterleave_pdm_samples_direct(
+      uint32_t* out,
+      uint32_t* samples,
+      unsigned s2_dec_factor);
+
+
+  /**
+   * @brief Channel map fixed at compile time.
+   * 
+   * Output channel `k` is input channel `CHANNEL_MAP[k]`. As the map is a
+   * template parameter, every word's source and destination within a block
+   * are constants, so the copies which map a block are unrolled with fixed
+   * offsets instead of looking up a runtime map for every word. See e.g.
+   * @ref StandardPdmRxService.
+   * 
+   * @tparam CHANNEL_MAP  Input channel index of each output channel.
+   */
+  template <unsigned... CHANNEL_MAP>
+  struct StaticChannelMap {
+    
+    /**
+     * @brief Number of output channels.
+     */
+    static constexpr unsigned Count = sizeof...(CHANNEL_MAP);
+
+    /**
+     * @brief Whether every input channel index is less than `MIC_COUNT`.
+     */
+    template <unsigned MIC_COUNT>
+    static constexpr bool Fits();
+
+    /**
+     * @brief Deinterleave a block of PDM data and map its channels into a
+     *        mic-major output block.
+     * 
+     * Same result as `deinterleave_pdm_samples_mapped<MIC_COUNT>(out,
+     * samples, SUBBLOCKS, map, Count)` with `map` holding `CHANNEL_MAP`.
+     * 
+     * @tparam MIC_COUNT  Number of channels represented in PDM data.   
+     *                    One of `{1,2,4,8,16}`
+     * @tparam SUBBLOCKS  Number of 32-sample sub-blocks in the block.
+     * 
+     * @param out     Output block.
+     * @param samples Pointer to block of PDM samples. Left deinterleaved.
+     */
+    template <unsigned MIC_COUNT, unsigned SUBBLOCKS>
+    static void DeinterleaveMapped(
+        uint32_t out[][SUBBLOCKS],
+        uint32_t* samples);
+
+    /**
+     * @brief Map one deinterleaved sub-block into a mic-major output block.
+     * 
+     * Output channel `k` of `row` is copied to `out[k][sb]`.
+     * 
+     * @tparam SUBBLOCKS  Number of 32-sample sub-blocks in `out`.
+     * 
+     * @param out Output block.
+     * @param sb  Sub-block index in `out`.
+     * @param row Deinterleaved sub-block, one word per input channel.
+     */
+    template <unsigned SUBBLOCKS>
+    static void MapSubblock(
+        uint32_t out[][SUBBLOCKS],
+        const unsigned sb,
+        const uint32_t* row);
+  };
+
+}
+
+//////////////////////////////////////////////
+// Template function implementations below. //
+//////////////////////////////////////////////
+
+
+namespace mic_array {
+  namespace detail {
+
+    template <unsigned MIC_COUNT>
+    constexpr bool channels_fit() { return true; }
+
+    template <unsigned MIC_COUNT, unsigned FIRST, unsigned... REST>
+    constexpr bool channels_fit() 
+    { 
+      return (FIRST < MIC_COUNT) && channels_fit<MIC_COUNT, REST...>(); 
+    }
+
+  }
+}
+
+
+template <unsigned... CHANNEL_MAP>
+template <unsigned MIC_COUNT>
+constexpr bool mic_array::StaticChannelMap<CHANNEL_MAP...>::Fits()
+{
+  return detail::channels_fit<MIC_COUNT, CHANNEL_MAP...>();
+}
+
+
+template <unsigned... CHANNEL_MAP>
+template <unsigned MIC_COUNT, unsigned SUBBLOCKS>
+void mic_array::StaticChannelMap<CHANNEL_MAP...>::DeinterleaveMapped(
+    uint32_t out[][SUBBLOCKS],
+    uint32_t* samples)
+{
+  deinterleave_pdm_samples<MIC_COUNT>(samples, SUBBLOCKS);
+
+  // Newest sub-block first, so sub-block sb is row SUBBLOCKS-1-sb.
+  for(unsigned sb = 0; sb < SUBBLOCKS; sb++)
+    MapSubblock<SUBBLOCKS>(out, sb, &samples[(SUBBLOCKS - 1 - sb) * MIC_COUNT]);
+}
+
+
+template <unsigned... CHANNEL_MAP>
+template <unsigned SUBBLOCKS>
+void mic_array::StaticChannelMap<CHANNEL_MAP...>::MapSubblock(
+    uint32_t out[][SUBBLOCKS],
+    const unsigned sb,
+    const uint32_t* row)
+{
+  unsigned ch = 0;
+  const int expand[] = { 0, ((out[ch++][sb] = row[CHANNEL_MAP]), 0)... };
+  (void) expand;
+}
@@ -8,6 +8,15 @@
 
 C_API_START
 
+/**
+ * @brief Pole shift used by `dcoe_filter()`.
+ * 
+ * A DCOE filter with pole shift `shr` has `R = 1 - 2^-shr`, and a -3 dB corner
+ * of approximately `fs / (2 * pi * 2^shr)`. The default of `6` 
+ * (`R = 252.0/256`) puts the corner at about 40 Hz for 16 kHz output.
+ */
+#define DCOE_DEFAULT_POLE_SHR   6
+
 /**
  * @brief DC Offset Elimination (DCOE) State
  * 
@@ -100,6 +109,8 @@ void dcoe_state_init(
  * To filter a sample in-place use the same array for both the `new_input` and
  * `new_output` arguments.
  * 
+ * This is `dcoe_filter_shr()` with a `pole_shr` of `DCOE_DEFAULT_POLE_SHR`.
+ * 
  * @param[out]  new_output  Array into which the output sample will be placed.
  * @param[in]   state       DC offset elimination state vector.
  * @param[in]   new_input   New input sample.
@@ -111,5 +122,96 @@ void dcoe_filter(
     dcoe_chan_state_t state[],
     int32_t new_input[],
     const unsigned chan_count);
+
+
+/**
+ * @brief Apply DCOE filter with a given pole.
+ * 
+ * As `dcoe_filter()`, but with `R` equal to `1 - 2^-pole_shr`. See 
+ * `DCOE_DEFAULT_POLE_SHR` for the resulting corner frequency. The same 
+ * `pole_shr` must be used for every sample of a stream.
+ * 
+ * @param[out]  new_output  Array into which the output sample will be placed.
+ * @param[in]   state       DC offset elimination state vector.
+ * @param[in]   new_input   New input sample.
+ * @param[in]   chan_count  Number of channels to be processed.
+ * @param[in]   pole_shr    Pole shift, from 1 to 31.
+ */
+MA_C_API
+void dcoe_filter_shr(
+    int32_t new_output[],
+    dcoe_chan_state_t state[],
+    int32_t new_input[],
+    const unsigned chan_count,
+    const unsigned pole_shr);
+
+/**
+ * @brief Initialize 32-bit DCOE states.
+ * 
+ * Initializes the state used by `dcoe_filter_block()` and 
+ * `dcoe_filter_frame()`.
+ * 
+ * @param[in] state       Array of states to be initialized.
+ * @param[in] chan_count  Number of elements in `state`.
+ */
+MA_C_API
+void dcoe_state_init_s32(
+    int32_t state[],
+    const unsigned chan_count);
+
+
+/**
+ * @brief Apply a 32-bit DCOE filter to a block of samples.
+ * 
+ * Applies the same filter as `dcoe_filter_shr()`, in place, to `sample_count`
+ * consecutive samples of `chan_count` channels, stored in `[sample][channel]`
+ * order. Each channel's state is a single `int32_t`, which lets the VPU 
+ * filter 8 channels at once, so this is far cheaper than calling 
+ * `dcoe_filter()` per sample.
+ * 
+ * Arithmetic saturates to `[-INT32_MAX, INT32_MAX]`. Because the state is
+ * only 32 bits, the decay of `y[t-1]` is truncated, and a DC error of at most
+ * `2^pole_shr - 1` (out of `INT32_MAX`) may remain on each channel.
+ * 
+ * `samples` and `state` must be word-aligned, and `state` initialized with
+ * `dcoe_state_init_s32()`.
+ * 
+ * @param[inout] samples      Samples to be filtered. Updated in-place.
+ * @param[inout] state        DC offset elimination state vector.
+ * @param[in]    chan_count   Number of channels.
+ * @param[in]    sample_count Number of samples.
+ * @param[in]    pole_shr     Pole shift, from 1 to 31 (see 
+ *                            `DCOE_DEFAULT_POLE_SHR`).
+ */
+MA_C_API
+void dcoe_filter_block(
+    int32_t samples[],
+    int32_t state[],
+    const unsigned chan_count,
+    const unsigned sample_count,
+    const unsigned pole_shr);
+
+
+/**
+ * @brief Apply a 32-bit DCOE filter to a frame.
+ * 
+ * As `dcoe_filter_block()`, with identical results, but for a frame stored
+ * in `[channel][sample]` order. Each channel is filtered in turn, with its 
+ * state held in a register across the whole frame.
+ * 
+ * @param[inout] frame        Frame to be filtered. Updated in-place.
+ * @param[inout] state        DC offset elimination state vector.
+ * @param[in]    chan_count   Number of channels.
+ * @param[in]    sample_count Number of samples.
+ * @param[in]    pole_shr     Pole shift, from 1 to 31 (see 
+ *                            `DCOE_DEFAULT_POLE_SHR`).
+ */
+MA_C_API
+void dcoe_filter_frame(
+    int32_t frame[],
+    int32_t state[],
+    const unsigned chan_count,
+    const unsigned sample_count,
+    const unsigned pole_shr);
   
 C_API_END
\ No newline at end of file
@@ -0,0 +1,46 @@
+// Copyright 2021-2024 XMOS LIMITED.
+// This Software is subject to the terms of the XMOS Public Licence: Version 1.
+
+#pragma once
+
+#include <stdint.h>
+
+#include "mic_array/api.h"
+
+C_API_START
+
+/** Function that computes one output of a short, different 32-bit FIR for
+ * each of several channels.
+ *
+ * The taps and history are stored as `[tap_count][chan_count]`, tap (and
+ * history row) `0` first, so that each row holds one value for every
+ * channel. For each channel `k` the output is
+ *
+ *     out[k] = sat32( sum_{i} round( (coef[i*chan_count + k] * 
+ *                                     window[i*chan_count + k]) >> 30 ) )
+ *
+ * where `i` runs over the `tap_count` taps and the sum is accumulated in 40
+ * bits. Saturation is to `[-INT32_MAX, INT32_MAX]`. With Q2.30 taps, the 
+ * output has the same scale as the history.
+ *
+ * The channels are processed 8 at a time with VLMACC, one multiply-accumulate
+ * per tap for all 8 channels of a batch, and the last batch's store is 
+ * masked so nothing is written past `out[chan_count-1]`.
+ *
+ * @param    out        output, one sample per channel (32-bit aligned)
+ * @param    window     history, `tap_count` rows of `chan_count` words 
+ *                      (32-bit aligned)
+ * @param    coef       taps, `tap_count` rows of `chan_count` words (32-bit
+ *                      aligned)
+ * @param    chan_count number of channels, at least 1
+ * @param    tap_count  number of taps, at least 1
+ */
+MA_C_API
+void calibration_filter_s32(
+    int32_t out[],
+    const int32_t window[],
+    const int32_t coef[],
+    unsigned chan_count,
+    unsigned tap_count);
+
+C_API_END
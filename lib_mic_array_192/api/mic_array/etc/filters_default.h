@@ -8,6 +8,38 @@
 
 #include <stdint.h>
 
+/**
+ * @brief Use the minimum phase default filters.
+ *
+ * Set to `1` to have @ref mic_array::prefab::BasicMicArray,
+ * @ref mic_array::prefab::Basic192MicArray (and so the vanilla API) and the
+ * default argument of @ref mic_array::OneStageDecimator192::Init() use the
+ * minimum phase filters (@ref stage1_coef_min_phase,
+ * @ref stage2_coef_min_phase and `s1_fir_coef_min_phase`) rather than the
+ * linear phase ones. Defaults to `0`.
+ *
+ * The minimum phase filters have the same magnitude responses as the linear
+ * phase ones but much less group delay, at the cost of a group delay which
+ * varies with frequency. See each filter for its group delay.
+ */
+#ifndef MIC_ARRAY_CONFIG_MIN_PHASE_FILTERS
+# define MIC_ARRAY_CONFIG_MIN_PHASE_FILTERS   (0)
+#endif
+
+/**
+ * @brief Attributes of the default filter coefficient tables.
+ *
+ * Placed before the definition of each of the default coefficient tables
+ * (@ref stage1_coef, @ref stage2_coef, `s1_fir_coef` and their minimum phase
+ * versions) in `src/etc/`, e.g. to put them in a particular memory section
+ * with `__attribute__((section(".my_section")))`. The library, not just the
+ * application, must be compiled with the same definition. Defaults to
+ * nothing.
+ */
+#ifndef MIC_ARRAY_CONFIG_COEF_ATTRIBUTES
+# define MIC_ARRAY_CONFIG_COEF_ATTRIBUTES
+#endif
+
 C_API_START
 
 /** 
@@ -55,9 +87,94 @@ C_API_START
  * @brief Stage 1 PDM-to-PCM Decimation Filter Default Coefficients
  * 
  * These are the default coefficients for the first stage filter.
+ * 
+ * The filter is linear phase, with a group delay of 193 PDM samples (about
+ * 6.0 stage 1 output samples).
  */
 extern const uint32_t stage1_coef[STAGE1_WORDS];
 
+/**
+ * @brief Stage 1 PDM-to-PCM Decimation Filter Minimum Phase Coefficients
+ * 
+ * The same filter as @ref stage1_coef, applied to the newest 125 PDM samples
+ * rather than the oldest. The filter's zeros all lie on the unit circle, so
+ * it is at once linear and minimum phase, and its group delay is 62 PDM
+ * samples (about 1.9 stage 1 output samples) at all frequencies. Outputs are
+ * otherwise identical to those of @ref stage1_coef.
+ */
+extern const uint32_t stage1_coef_min_phase[STAGE1_WORDS];
+
+/**
+ * @brief Group delay of @ref stage1_coef, in PDM clock periods.
+ * 
+ * Used by @ref mic_array::TwoStageDecimator::Latency().
+ */
+#define STAGE1_GROUP_DELAY              (193)
+
+/**
+ * @brief Group delay of @ref stage1_coef_min_phase, in PDM clock periods.
+ */
+#define STAGE1_GROUP_DELAY_MIN_PHASE    (62)
+
+
+/**
+ * @brief Tap count of the 192 kHz stage 1 filter.
+ *
+ * The number of taps of `s1_fir_coef` and `s1_fir_coef_min_phase`, including
+ * their 16 zero taps. See @ref mic_array::OneStageDecimator192.
+ */
+#define S1_TAP_COUNT 256
+
+/**
+ * @brief Word count of the 192 kHz stage 1 filter.
+ */
+#define S1_WORDS (S1_TAP_COUNT) / 2
+
+/**
+ * @brief 192 kHz One Stage Decimation Filter Default Coefficients
+ *
+ * The default filter of @ref mic_array::OneStageDecimator192: 240 taps, 
+ * cut-off 80 kHz, Kaiser window (`beta=4.0`), -44 dB stopband, padded with 
+ * 16 zero taps on the newest samples. The same coefficients serve both 
+ * output phases. The filter is linear phase, with a group delay of 135.5 PDM 
+ * samples (8.5 output samples).
+ */
+extern const uint32_t s1_fir_coef[S1_WORDS];
+
+/**
+ * @brief 192 kHz One Stage Decimation Filter Minimum Phase Coefficients
+ *
+ * Minimum phase version of `s1_fir_coef`, with the same magnitude response
+ * and the same 16 zero taps. The group delay depends on frequency: in output
+ * samples it is about 2.5 at 1 kHz, 2.9 at 40 kHz and 3.8 at 60 kHz. 
+ * Selected by @ref MIC_ARRAY_CONFIG_MIN_PHASE_FILTERS.
+ */
+extern const uint32_t s1_fir_coef_min_phase[S1_WORDS];
+
+/**
+ * @brief Group delay of `s1_fir_coef`, in PDM clock periods, rounded.
+ *
+ * Used by @ref mic_array::OneStageDecimator192::Latency().
+ */
+#define S1_GROUP_DELAY            (136)
+
+/**
+ * @brief Group delay of `s1_fir_coef_min_phase` at 1 kHz, in PDM clock
+ *        periods, rounded.
+ */
+#define S1_GROUP_DELAY_MIN_PHASE  (41)
+
+/**
+ * @brief Output of the 192 kHz decimator for a full scale PDM signal.
+ *
+ * The magnitude of the output of @ref mic_array::OneStageDecimator192 for a
+ * PDM signal of all ones or all zeros, with `s1_fir_coef` (or
+ * `s1_fir_coef_min_phase`, to within 0.002%) and the decimator's default
+ * output shift of 3 bits. Used by
+ * @ref mic_array::OneStageDecimator192::FullScale.
+ */
+#define S1_FULL_SCALE             (1270820864)
+
 
 
 
@@ -85,9 +202,43 @@ extern const uint32_t stage1_coef[STAGE1_WORDS];
  * @brief Stage 2 Decimation Filter Default Coefficients
  * 
  * These are the default coefficients for the second stage filter.
+ * 
+ * The filter is linear phase, with a group delay of 31.5 stage 2 input
+ * samples (5.25 output samples).
  */
 extern const int32_t stage2_coef[STAGE2_TAP_COUNT];
 
+/**
+ * @brief Stage 2 Decimation Filter Minimum Phase Coefficients
+ * 
+ * A minimum phase filter with the same magnitude response and DC gain as
+ * @ref stage2_coef, for use with @ref stage2_shr_min_phase.
+ * 
+ * Its group delay depends on frequency. In stage 2 output samples (at
+ * 16 kHz with a 3.072 MHz PDM clock) it is about 1.6 at 1 kHz, 2.0 at 4 kHz
+ * and 3.0 at 6 kHz, against 5.25 for @ref stage2_coef. Together with
+ * @ref stage1_coef_min_phase, the decimator's group delay at 1 kHz falls from
+ * 6.3 to 1.9 output samples.
+ */
+extern const int32_t stage2_coef_min_phase[STAGE2_TAP_COUNT];
+
+/**
+ * @brief Group delay of @ref stage2_coef, in PDM clock periods.
+ * 
+ * 31.5 stage 2 input samples of `STAGE1_DEC_FACTOR` PDM clock periods each.
+ * Used by @ref mic_array::TwoStageDecimator::Latency().
+ */
+#define STAGE2_GROUP_DELAY              (1008)
+
+/**
+ * @brief Group delay of @ref stage2_coef_min_phase at 1 kHz, in PDM clock
+ *        periods.
+ * 
+ * The group delay rises with frequency, to about 570 PDM clock periods at
+ * 6 kHz.
+ */
+#define STAGE2_GROUP_DELAY_MIN_PHASE    (304)
+
 /**
  * @brief Stage 2 Decimation Filter Default Output Shift
  * 
@@ -96,4 +247,156 @@ extern const int32_t stage2_coef[STAGE2_TAP_COUNT];
  */
 extern const right_shift_t stage2_shr;
 
+/**
+ * @brief Stage 2 Decimation Filter Minimum Phase Output Shift
+ * 
+ * The output shift to use with @ref stage2_coef_min_phase.
+ */
+extern const right_shift_t stage2_shr_min_phase;
+
+/**
+ * @brief Output of the two stage decimator for a full scale PDM signal.
+ * 
+ * The magnitude of the output of @ref mic_array::TwoStageDecimator for a PDM
+ * signal of all ones or all zeros, with the default filters (either
+ * @ref stage1_coef and @ref stage2_coef or their minimum phase versions) and
+ * no output shift. The default CIC filters have the same DC gain. Used by
+ * @ref mic_array::TwoStageDecimator::FullScale.
+ */
+#define STAGE2_FULL_SCALE               (857718499)
+
+/**
+ * @brief Stage 2 Decimation Filter 16-bit Coefficients
+ * 
+ * @ref stage2_coef rounded to 16 bits, for a
+ * @ref mic_array::TwoStageDecimator whose `S2_COEF_BITS` is 16, with
+ * @ref stage2_shr_s16. The response is that of @ref stage2_coef, to within
+ * the coefficient rounding.
+ */
+extern const int16_t stage2_coef_s16[STAGE2_TAP_COUNT];
+
+/**
+ * @brief Stage 2 Decimation Filter 16-bit Output Shift
+ * 
+ * The output shift to use with @ref stage2_coef_s16.
+ */
+extern const right_shift_t stage2_shr_s16;
+
+/**
+ * @brief PDM words per stage 1 output of the default CIC filters.
+ *
+ * The CIC stage 1 of @ref mic_array::CicDecimator decimates by
+ * `32 * CIC_STAGE1_DEC_WORDS`, i.e. from 3.072 MHz to 48 kHz.
+ */
+#define CIC_STAGE1_DEC_WORDS    2
+
+/**
+ * @brief Coefficient bits of the default CIC stage 1 filter.
+ */
+#define CIC_STAGE1_COEF_BITS    8
+
+/**
+ * @brief Word count of the default CIC stage 1 filter.
+ */
+#define CIC_STAGE1_WORDS        (8 * CIC_STAGE1_COEF_BITS)
+
+/**
+ * @brief CIC Stage 1 Filter Default Coefficients
+ *
+ * An order 4 CIC (`sinc^4`) decimating by 64, for
+ * @ref mic_array::CicDecimator. Its 253 taps are applied to the newest PDM
+ * samples and scaled to 8-bit coefficients for `fir_1x8_bit()`. Everything
+ * which can alias into 0 to 8 kHz of a 16 kHz output is attenuated by at
+ * least 58 dB, against about 100 dB for @ref stage1_coef. The filter is
+ * linear phase, with a group delay of 126 PDM samples. Its passband droop is
+ * compensated by @ref cic_stage2_coef.
+ */
+extern const uint32_t cic_stage1_coef[CIC_STAGE1_WORDS];
+
+/**
+ * @brief Group delay of @ref cic_stage1_coef, in PDM clock periods.
+ */
+#define CIC_STAGE1_GROUP_DELAY  (126)
+
+/**
+ * @brief Stage 2 decimation factor of the default CIC filters.
+ *
+ * 48 kHz to 16 kHz.
+ */
+#define CIC_STAGE2_DEC_FACTOR   3
+
+/**
+ * @brief Stage 2 tap count of the default CIC filters.
+ */
+#define CIC_STAGE2_TAP_COUNT    64
+
+/**
+ * @brief CIC Stage 2 Filter Default Coefficients
+ *
+ * The compensating stage 2 filter for @ref cic_stage1_coef. Together the two
+ * are flat to within 0.1 dB up to 6 kHz (-4 dB at 7 kHz), and attenuate by
+ * at least 70 dB from 10 kHz. The filter is linear phase, with a group delay
+ * of 31.5 stage 2 input samples (10.5 output samples).
+ */
+extern const int32_t cic_stage2_coef[CIC_STAGE2_TAP_COUNT];
+
+/**
+ * @brief Group delay of @ref cic_stage2_coef, in PDM clock periods.
+ *
+ * 31.5 stage 2 input samples of `32 * CIC_STAGE1_DEC_WORDS` PDM clock
+ * periods each.
+ */
+#define CIC_STAGE2_GROUP_DELAY  (2016)
+
+/**
+ * @brief CIC Stage 2 Filter Default Output Shift
+ *
+ * The output shift to use with @ref cic_stage2_coef. The DC gain of the
+ * default CIC filters is the same as that of @ref stage1_coef and
+ * @ref stage2_coef.
+ */
+extern const right_shift_t cic_stage2_shr;
+
+/**
+ * @brief Interpolation factor of the default 147/160 resampling filter.
+ * 
+ * 48 kHz times 147/160 is 44.1 kHz. See @ref resample_147_160_coef.
+ */
+#define RESAMPLE_147_160_UP           147
+
+/**
+ * @brief Decimation factor of the default 147/160 resampling filter.
+ */
+#define RESAMPLE_147_160_DOWN         160
+
+/**
+ * @brief Number of taps in each phase of the default 147/160 resampling
+ *        filter.
+ */
+#define RESAMPLE_147_160_PHASE_TAPS   32
+
+/**
+ * @brief Default 147/160 Resampling Filter Coefficients
+ * 
+ * The polyphase coefficients of a 4704-tap linear phase low-pass filter, for
+ * use with @ref mic_array::ResamplingOutputHandler and
+ * @ref resample_147_160_shr to resample 48 kHz to 44.1 kHz. Row `p` is phase
+ * `p`, with a DC gain of `1.0`.
+ * 
+ * At a 48 kHz input rate, the response is flat to within 0.05 dB up to
+ * 17 kHz and -0.3 dB at 18 kHz, and attenuates by at least 73 dB from
+ * 24 kHz. Only 20.1 kHz to 22.05 kHz of the 44.1 kHz output can therefore
+ * hold aliases, and then only of content above the passband. The group
+ * delay is 16 input samples (333 us).
+ */
+extern const int32_t resample_147_160_coef[RESAMPLE_147_160_UP]
+                                          [RESAMPLE_147_160_PHASE_TAPS];
+
+/**
+ * @brief Default 147/160 Resampling Filter Output Shift
+ * 
+ * The output shift to use with @ref resample_147_160_coef.
+ */
+extern const right_shift_t resample_147_160_shr;
+
 C_API_END
@@ -7,6 +7,25 @@
 
 #include "mic_array/api.h"
 
+/**
+ * Maximum number of channels fir_1x16_bit_multi() can process in one call.
+ */
+#define FIR_1X16_BIT_MULTI_MAX_CHANNELS   16
+
+/**
+ * Minimum number of channels for which the decimators use
+ * fir_1x16_bit_multi() rather than one fir_1x16_bit() call per channel.
+ */
+#ifndef FIR_1X16_BIT_MULTI_MIN_CHANNELS
+# define FIR_1X16_BIT_MULTI_MIN_CHANNELS  4
+#endif
+
+/**
+ * Number of words in a fir_1x16_bit_lut() table: 256 entries for each of the
+ * 32 bytes of a 256-sample signal (32 KB).
+ */
+#define FIR_1X16_BIT_LUT_WORDS            (32 * 256)
+
 C_API_START
 
 /** Function that computes an FIR over a 1-bit signal with 16-bit coefficients.
@@ -48,4 +67,198 @@ C_API_START
 MA_C_API
 int fir_1x16_bit(uint32_t signal[], const uint32_t coeff_1[]);
 
+/** Function that computes the same FIR over two different 1-bit signals.
+ *
+ * The result is identical to
+ *
+ *     out[0] = fir_1x16_bit(signal_a, coeff_1);
+ *     out[1] = fir_1x16_bit(signal_b, coeff_1);
+ *
+ * but both inner products share a single final reduction, saving the second
+ * call's setup and return overhead. This is intended for polyphase filters
+ * where the phases differ only in their offset into the signal history, such
+ * as the 192 kHz stage 1 filter.
+ *
+ * The coefficients are a single 256-tap slice in the format described for
+ * fir_1x16_bit().
+ *
+ * @param    out        output, the two inner products (32-bit aligned)
+ * @param    signal_a   the 1-bit signal for out[0] (32-bit aligned)
+ * @param    signal_b   the 1-bit signal for out[1] (32-bit aligned)
+ * @param    coeff_1    16-bit coefficients split as above (32-bit aligned)
+ */
+MA_C_API
+void fir_1x16_bit_dual_signal(
+    int32_t out[2],
+    uint32_t signal_a[], 
+    uint32_t signal_b[], 
+    const uint32_t coeff_1[]);
+
+/** Function that computes the same FIR over the 1-bit signals of several
+ * channels.
+ *
+ * The result is identical to
+ *
+ *     for(int k = 0; k < count; k++)
+ *       out[k] = fir_1x16_bit(&signal[k * stride], coeff_1);
+ *
+ * but the vector unit is only configured once, and the partial sums of all
+ * channels share a single final reduction. This removes the per-call
+ * overhead of fir_1x16_bit(), which is significant for arrays with many
+ * microphones.
+ *
+ * `stride` allows the channels' signals to be read in place from history
+ * buffers longer than 8 words. For signals stored as `uint32_t [count][8]`,
+ * `stride` is 8.
+ *
+ * The coefficients are a single 256-tap slice in the format described for
+ * fir_1x16_bit().
+ *
+ * @param    signal     the first channel's 1-bit signal (32-bit aligned)
+ * @param    coeff_1    16-bit coefficients split as above (32-bit aligned)
+ * @param    out        output, one inner product per channel (32-bit aligned)
+ * @param    count      number of channels, between 1 and
+ *                      FIR_1X16_BIT_MULTI_MAX_CHANNELS inclusive
+ * @param    stride     distance in words between consecutive channels' signals
+ */
+MA_C_API
+void fir_1x16_bit_multi(
+    const uint32_t signal[], 
+    const uint32_t coeff_1[],
+    int32_t out[],
+    unsigned count,
+    unsigned stride);
+
+/** Functions that compute an FIR over a 1-bit signal with 12-bit or 8-bit
+ * coefficients.
+ *
+ * These are fir_1x16_bit() with only 12 or 8 bit-planes of coefficients, so
+ * they issue 12 or 8 `VLMACCR1` instructions per 256 taps rather than 16,
+ * saving a quarter or half of the filter's inner loop. In exchange, the
+ * coefficients are coarser, which raises the filter's stopband floor.
+ *
+ * The coefficients are a single 256-tap slice in the format described for
+ * fir_1x16_bit(), but with only 12 or 8 bit-planes (96 or 64 words), whose
+ * magnitudes are 1, 2, .., 1024, 2047 or 1, 2, .., 64, 127 respectively. The
+ * coefficients are in the range [-2047 .. 2047] or [-127 .. 127].
+ *
+ * The result is scaled to match fir_1x16_bit() with each coefficient
+ * multiplied by 16 or 256, so that the decimators need no other changes to
+ * use them. `python/stage1.py` and `python/stage1_192.py` generate tables in
+ * these formats with their `--coef-bits` option.
+ *
+ * @param    signal     the 1-bit signal (32-bit aligned)
+ * @param    coeff_1    coefficients split as above (32-bit aligned)
+ *
+ * @returns  The inner product
+ */
+MA_C_API
+int fir_1x12_bit(uint32_t signal[], const uint32_t coeff_1[]);
+
+/** @copydoc fir_1x12_bit */
+MA_C_API
+int fir_1x8_bit(uint32_t signal[], const uint32_t coeff_1[]);
+
+/** Functions that compute the same FIR, with 12-bit or 8-bit coefficients,
+ * over the 1-bit signals of several channels.
+ *
+ * These are to fir_1x12_bit() and fir_1x8_bit() what fir_1x16_bit_multi() is
+ * to fir_1x16_bit(), and take the same parameters.
+ *
+ * @param    signal     the first channel's 1-bit signal (32-bit aligned)
+ * @param    coeff_1    coefficients as for fir_1x12_bit() (32-bit aligned)
+ * @param    out        output, one inner product per channel (32-bit aligned)
+ * @param    count      number of channels, between 1 and
+ *                      FIR_1X16_BIT_MULTI_MAX_CHANNELS inclusive
+ * @param    stride     distance in words between consecutive channels' signals
+ */
+MA_C_API
+void fir_1x12_bit_multi(
+    const uint32_t signal[], 
+    const uint32_t coeff_1[],
+    int32_t out[],
+    unsigned count,
+    unsigned stride);
+
+/** @copydoc fir_1x12_bit_multi */
+MA_C_API
+void fir_1x8_bit_multi(
+    const uint32_t signal[], 
+    const uint32_t coeff_1[],
+    int32_t out[],
+    unsigned count,
+    unsigned stride);
+
+/** Function that builds the table used by fir_1x16_bit_lut() from a block of
+ * 1-bit FIR coefficients.
+ *
+ * Entry `table[256 * p + v]` is the contribution to the filter output of
+ * byte `p` of the signal (bits `8p` to `8p + 7`, i.e. byte `p % 4` of word
+ * `p / 4`) having the value `v`, already scaled as the kernels in this file
+ * scale their results. The entries are two's complement values.
+ *
+ * `coeff_1` is a single 256-tap slice in the format of fir_1x16_bit(), or of
+ * fir_1x12_bit() or fir_1x8_bit() if `coef_bits` is 12 or 8. The table only
+ * depends on the coefficients, so one table serves any number of channels.
+ * `python/stage1_lut.py` generates the same table as a C array.
+ *
+ * @param    table      output, `FIR_1X16_BIT_LUT_WORDS` words
+ * @param    coeff_1    coefficients split as for fir_1x16_bit()
+ * @param    coef_bits  bits per coefficient: 16, 12 or 8
+ */
+MA_C_API
+void fir_1x16_bit_lut_init(
+    uint32_t table[FIR_1X16_BIT_LUT_WORDS],
+    const uint32_t coeff_1[],
+    const unsigned coef_bits);
+
+/** Function that computes an FIR over a 1-bit signal by table look-up.
+ *
+ * The result is identical to that of the kernel the table was built for by
+ * fir_1x16_bit_lut_init(), e.g.
+ *
+ *     fir_1x16_bit_lut_init(table, coeff_1, 16);
+ *     assert(fir_1x16_bit_lut(signal, table) == fir_1x16_bit(signal, coeff_1));
+ *
+ * but rather than one pass over the signal per coefficient bit, each of the
+ * 32 bytes of the signal indexes its own 256-entry table of partial sums,
+ * and the 32 entries are added. The cost is independent of the coefficient
+ * precision.
+ *
+ * This is a scalar kernel. On xcore.ai, where fir_1x16_bit() needs only 16
+ * `VLMACCR1` per output, it is slower than the vector kernels; it is intended
+ * for targets without the vector unit, where it replaces 16 (or 12 or 8)
+ * bit-plane population counts with 32 loads.
+ *
+ * @param    signal     the 1-bit signal (32-bit aligned)
+ * @param    table      table built by fir_1x16_bit_lut_init() (32-bit aligned)
+ *
+ * @returns  The inner product
+ */
+MA_C_API
+int fir_1x16_bit_lut(
+    const uint32_t signal[], 
+    const uint32_t table[]);
+
+/** Function that computes the same FIR, by table look-up, over the 1-bit
+ * signals of several channels.
+ *
+ * This is to fir_1x16_bit_lut() what fir_1x16_bit_multi() is to
+ * fir_1x16_bit(), and takes the same parameters, except that `count` is not
+ * limited.
+ *
+ * @param    signal     the first channel's 1-bit signal (32-bit aligned)
+ * @param    table      table built by fir_1x16_bit_lut_init() (32-bit aligned)
+ * @param    out        output, one inner product per channel (32-bit aligned)
+ * @param    count      number of channels
+ * @param    stride     distance in words between consecutive channels' signals
+ */
+MA_C_API
+void fir_1x16_bit_lut_multi(
+    const uint32_t signal[], 
+    const uint32_t table[],
+    int32_t out[],
+    unsigned count,
+    unsigned stride);
+
 C_API_END
\ No newline at end of file
@@ -0,0 +1,64 @@
+// Copyright 2021-2024 XMOS LIMITED.
+// This Software is subject to the terms of the XMOS Public Licence: Version 1.
+
+#pragma once
+
+#include <stdint.h>
+
+#include "mic_array/api.h"
+#include "xmath/xmath.h"
+
+C_API_START
+
+/** Function that computes one output of the same 16-bit FIR for several
+ * channels.
+ *
+ * For each channel `k` the output is
+ *
+ *     out[k] = round( sat32( acc[0] + acc[1] + ... ) >> shr )
+ *
+ * where each phase accumulator `acc[p]` sums, one block of 16 taps at a
+ * time, the exact products `coef[i] * signal[k*stride + i]` of blocks `p`,
+ * `p + P`, `p + 2P`, ..., saturating to +/-`INT32_MAX` after each block
+ * (as does `sat32()` on their sum).
+ * This is the arithmetic of the vector unit's 16-bit mode, in which each
+ * `VLMACCR` multiplies and sums 16 pairs of 16-bit elements, twice as many
+ * as the 32-bit `fir_s32_multi()`, with `coef[0]` applied to the first
+ * element of each channel's history. Unlike the 16-bit outputs of
+ * lib_xcore_math's `filter_fir_s16()`, the whole 32-bit accumulator is kept.
+ * Unless an accumulator saturates, the output is just the rounded, shifted
+ * dot product.
+ *
+ * The channels are processed 16 at a time, one per vector lane. A batch of
+ * `n < 16` channels (the last, or only, batch) is spread over the lanes `P`
+ * times, with `P` the largest power of two such that `n * P <= 16`, each
+ * copy working through its own subset of the blocks, so e.g. 2 channels
+ * take an eighth of the `VLMACCR`s that 16 channels would, rather than the
+ * same. Filters whose tap count is not a multiple of 16 must have their
+ * coefficients padded with zeros. Nothing is written past `out[count-1]`.
+ *
+ * `stride` allows the channels' histories to be read in place from buffers
+ * longer than the filter. Each channel's history must be 32-bit aligned, so
+ * `stride` must be even.
+ *
+ * @param    out        output, one sample per channel (32-bit aligned)
+ * @param    signal     the first channel's history (32-bit aligned)
+ * @param    coef       coefficients, `16 * tap_blocks` elements (32-bit
+ *                      aligned)
+ * @param    count      number of channels, at least 1
+ * @param    stride     distance in elements between consecutive channels'
+ *                      histories; even
+ * @param    tap_blocks number of 16-tap blocks in the filter, at least 1
+ * @param    shr        non-negative right-shift applied to the accumulators
+ */
+MA_C_API
+void fir_s16_multi(
+    int32_t out[],
+    const int16_t signal[],
+    const int16_t coef[],
+    unsigned count,
+    unsigned stride,
+    unsigned tap_blocks,
+    right_shift_t shr);
+
+C_API_END
@@ -0,0 +1,53 @@
+// Copyright 2021-2024 XMOS LIMITED.
+// This Software is subject to the terms of the XMOS Public Licence: Version 1.
+
+#pragma once
+
+#include <stdint.h>
+
+#include "mic_array/api.h"
+#include "xmath/xmath.h"
+
+C_API_START
+
+/** Function that computes one output of the same 32-bit FIR for several
+ * channels.
+ *
+ * For each channel `k` the output is
+ *
+ *     out[k] = sat32( round( ( sum_{i} round( (coef[i] * signal[k*stride + i]) >> 30 ) ) >> shr ) )
+ *
+ * where `i` runs over the `8 * tap_blocks` coefficients and the sum is
+ * accumulated in 40 bits. This is the same fixed-point arithmetic used by
+ * lib_xcore_math's `filter_fir_s32()`, with `coef[0]` applied to the first
+ * word of each channel's history.
+ *
+ * The channels are processed 8 at a time, with each block of coefficients
+ * loaded into the vector unit once per batch and one VLMACCR per channel
+ * and block. Filters whose tap count is not a multiple of 8 must have their
+ * coefficients padded with zeros. Nothing is written past `out[count-1]`.
+ *
+ * `stride` allows the channels' histories to be read in place from buffers
+ * longer than the filter. For histories stored as
+ * `int32_t [count][8 * tap_blocks]`, `stride` is `8 * tap_blocks`.
+ *
+ * @param    out        output, one sample per channel (32-bit aligned)
+ * @param    signal     the first channel's history (32-bit aligned)
+ * @param    coef       coefficients, `8 * tap_blocks` words (32-bit aligned)
+ * @param    count      number of channels, at least 1
+ * @param    stride     distance in words between consecutive channels'
+ *                      histories
+ * @param    tap_blocks number of 8-tap blocks in the filter, at least 1
+ * @param    shr        non-negative right-shift applied to the accumulators
+ */
+MA_C_API
+void fir_s32_multi(
+    int32_t out[],
+    const int32_t signal[],
+    const int32_t coef[],
+    unsigned count,
+    unsigned stride,
+    unsigned tap_blocks,
+    right_shift_t shr);
+
+C_API_END
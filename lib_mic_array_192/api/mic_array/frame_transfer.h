@@ -98,6 +98,11 @@ void ma_frame_rx(
  * transmitter frame has shape `(CHANNEL, SAMPLE)`, the caller's frame array 
  * will have shape `(SAMPLE, CHANNEL)`.
  * 
+ * The transpose makes this slower than `ma_frame_rx()`. If the transmitter is 
+ * a `FrameOutputHandler` whose `SAMPLE_MAJOR` parameter is `true`, the frame 
+ * is already sent in `(SAMPLE, CHANNEL)` order and `ma_frame_rx()` should be 
+ * used instead.
+ * 
  * This is a blocking call which does not return until the frame has been fully
  * received.
  * 
@@ -127,4 +132,379 @@ void ma_frame_rx_transpose(
     const unsigned sample_count);
 
 
+/**
+ * @brief Header sent ahead of a frame by `ma_frame_tx_stamped()`.
+ * 
+ * Locates the frame in time, so that a receiver can detect frames that were
+ * lost or dropped and line the audio up with other streams clocked from the
+ * reference timer, e.g. I2S playback.
+ */
+typedef struct {
+  /**
+   * Index of the first sample of the frame in the mic array's output stream,
+   * counting samples which were never output because PDM blocks were
+   * dropped. Consecutive frames normally differ by the frame's sample count;
+   * a larger difference means samples were lost. Wraps modulo 2^32.
+   */
+  uint32_t sample_index;
+
+  /**
+   * Reference time at which the first word of the PDM block from which the
+   * frame's first sample was decimated was read from the port. The sample
+   * itself lags this by the decimator's group delay (see 
+   * `MicArray::Latency()`).
+   */
+  uint32_t timestamp;
+} ma_frame_header_t;
+
+
+/**
+ * @brief Transmit a 32-bit PCM frame and its header over a channel.
+ * 
+ * Like `ma_frame_tx()`, but the two words of `header` are sent ahead of the
+ * frame, within the same channel transaction. The frame should be received
+ * with `ma_frame_rx_stamped()`.
+ * 
+ * @param c_frame_out   Channel over which to send frame.
+ * @param header        Header to be transmitted with the frame.
+ * @param frame         Frame to be transmitted.
+ * @param channel_count Number of channels represented in the frame.
+ * @param sample_count  Number of samples represented in the frame.
+ */
+MA_C_API
+void ma_frame_tx_stamped(
+    const chanend_t c_frame_out,
+    const ma_frame_header_t* header,
+    const int32_t frame[],
+    const unsigned channel_count,
+    const unsigned sample_count);
+
+
+/**
+ * @brief Receive a 32-bit PCM frame and its header over a channel.
+ * 
+ * Receives a frame sent with `ma_frame_tx_stamped()`. Like `ma_frame_rx()`,
+ * but the frame's header is stored in `header`.
+ * 
+ * @param header        Buffer to store received header.
+ * @param frame         Buffer to store received frame.
+ * @param c_frame_in    Channel from which to receive frame.
+ * @param channel_count Number of channels represented in the frame.
+ * @param sample_count  Number of samples represented in the frame.
+ */
+MA_C_API
+void ma_frame_rx_stamped(
+    ma_frame_header_t* header,
+    int32_t frame[],
+    const chanend_t c_frame_in,
+    const unsigned channel_count,
+    const unsigned sample_count);
+
+
+/**
+ * @brief Receive a 32-bit PCM frame by pointer.
+ * 
+ * This function waits for the next frame sent over `c_frame_in` by a
+ * `SharedMemoryFrameTransmitter` or `FanOutFrameTransmitter` and returns a
+ * pointer to it, without copying the frame. The frame has the transmitter's
+ * `(CHANNEL, SAMPLE)` shape.
+ * 
+ * The frame belongs to the mic array until `ma_frame_release()` is called,
+ * which must happen before the mic array completes its next frame (or, for a
+ * `FanOutFrameTransmitter`, its next `DEPTH` frames), or the mic array thread
+ * will be held up. The frame must not be accessed after it has been released.
+ * 
+ * The sender must be on the same tile as the receiver.
+ * 
+ * @param c_frame_in    Streaming chanend from which to receive frame.
+ * 
+ * @returns Pointer to the received frame.
+ */
+MA_C_API
+int32_t* ma_frame_rx_ptr(
+    const chanend_t c_frame_in);
+
+
+/**
+ * @brief Release a frame received with `ma_frame_rx_ptr()`.
+ * 
+ * Hands the most recent frame received with `ma_frame_rx_ptr()` back to the
+ * mic array.
+ * 
+ * @param c_frame_in    Streaming chanend the frame was received from.
+ */
+MA_C_API
+void ma_frame_release(
+    const chanend_t c_frame_in);
+
+/**
+ * @brief Convert 32-bit PCM samples to 16 bits.
+ * 
+ * Each element of `src[]` is shifted right 16 bits, rounding to nearest and
+ * saturating, and stored in `dst[]`. When both `dst` and `src` are 
+ * word-aligned the conversion is done on the VPU (see 
+ * `vect_s32_to_vect_s16()`).
+ * 
+ * @param dst   Output samples.
+ * @param src   Input samples.
+ * @param count Number of samples to convert.
+ */
+MA_C_API
+void ma_s32_to_s16(
+    int16_t dst[],
+    const int32_t src[],
+    const unsigned count);
+
+
+/**
+ * @brief Convert 32-bit PCM samples to packed 24 bits.
+ * 
+ * Each element of `src[]` is shifted right 8 bits, rounding to nearest and
+ * saturating, and stored in 3 bytes of `dst[]`, least significant byte first.
+ * `dst[]` must have room for `3 * count` bytes.
+ * 
+ * @param dst   Output samples.
+ * @param src   Input samples.
+ * @param count Number of samples to convert.
+ */
+MA_C_API
+void ma_s32_to_s24(
+    uint8_t dst[],
+    const int32_t src[],
+    const unsigned count);
+
+
+/**
+ * @brief Convert 32-bit PCM samples to `float`.
+ * 
+ * Each element of `src[]` is converted to `float` and multiplied by `scale`,
+ * and stored in `dst[]`. With `scale` the reciprocal of a decimator's output
+ * for a full scale PDM signal (see `mic_array::DecimatorFullScale`), a full
+ * scale signal is converted to `+/-1.0`.
+ * 
+ * @param dst   Output samples.
+ * @param src   Input samples.
+ * @param count Number of samples to convert.
+ * @param scale Factor applied to each converted sample.
+ */
+MA_C_API
+void ma_s32_to_f32(
+    float dst[],
+    const int32_t src[],
+    const unsigned count,
+    const float scale);
+
+
+/**
+ * @brief Transmit 16-bit PCM frame over a channel.
+ * 
+ * Like `ma_frame_tx()`, but for a frame of `int16_t` samples, which takes 
+ * half as long to transmit. The frame should be received with 
+ * `ma_frame_rx_s16()`.
+ * 
+ * `frame` must be word-aligned.
+ * 
+ * @param c_frame_out   Channel over which to send frame.
+ * @param frame         Frame to be transmitted.
+ * @param channel_count Number of channels represented in the frame.
+ * @param sample_count  Number of samples represented in the frame.
+ */
+MA_C_API
+void ma_frame_tx_s16(
+    const chanend_t c_frame_out,
+    const int16_t frame[],
+    const unsigned channel_count,
+    const unsigned sample_count);
+
+
+/**
+ * @brief Receive 16-bit PCM frame over a channel.
+ * 
+ * Receives a frame sent with `ma_frame_tx_s16()`. Like `ma_frame_rx()`, but 
+ * for a frame of `int16_t` samples.
+ * 
+ * `frame` must be word-aligned.
+ * 
+ * @param frame         Buffer to store received frame.
+ * @param c_frame_in    Channel from which to receive frame.
+ * @param channel_count Number of channels represented in the frame.
+ * @param sample_count  Number of samples represented in the frame.
+ */
+MA_C_API
+void ma_frame_rx_s16(
+    int16_t frame[],
+    const chanend_t c_frame_in,
+    const unsigned channel_count,
+    const unsigned sample_count);
+
+
+/**
+ * @brief Transmit packed 24-bit PCM frame over a channel.
+ * 
+ * Like `ma_frame_tx()`, but for a frame of packed 24-bit samples (3 bytes 
+ * each, see `ma_s32_to_s24()`), which takes three quarters as long to 
+ * transmit. The frame should be received with `ma_frame_rx_s24()`.
+ * 
+ * `frame` must be word-aligned.
+ * 
+ * @param c_frame_out   Channel over which to send frame.
+ * @param frame         Frame to be transmitted.
+ * @param channel_count Number of channels represented in the frame.
+ * @param sample_count  Number of samples represented in the frame.
+ */
+MA_C_API
+void ma_frame_tx_s24(
+    const chanend_t c_frame_out,
+    const uint8_t frame[],
+    const unsigned channel_count,
+    const unsigned sample_count);
+
+
+/**
+ * @brief Receive packed 24-bit PCM frame over a channel.
+ * 
+ * Receives a frame sent with `ma_frame_tx_s24()`. `frame[]` must have room 
+ * for `3 * channel_count * sample_count` bytes.
+ * 
+ * `frame` must be word-aligned.
+ * 
+ * @param frame         Buffer to store received frame.
+ * @param c_frame_in    Channel from which to receive frame.
+ * @param channel_count Number of channels represented in the frame.
+ * @param sample_count  Number of samples represented in the frame.
+ */
+MA_C_API
+void ma_frame_rx_s24(
+    uint8_t frame[],
+    const chanend_t c_frame_in,
+    const unsigned channel_count,
+    const unsigned sample_count);
+
+
+/**
+ * @brief Transmit `float` PCM frame over a channel.
+ * 
+ * Like `ma_frame_tx()`, but for a frame of `float` samples (see 
+ * `ma_s32_to_f32()`). The frame should be received with `ma_frame_rx_f32()`.
+ * 
+ * @param c_frame_out   Channel over which to send frame.
+ * @param frame         Frame to be transmitted.
+ * @param channel_count Number of channels represented in the frame.
+ * @param sample_count  Number of samples represented in the frame.
+ */
+MA_C_API
+void ma_frame_tx_f32(
+    const chanend_t c_frame_out,
+    const float frame[],
+    const unsigned channel_count,
+    const unsigned sample_count);
+
+
+/**
+ * @brief Receive `float` PCM frame over a channel.
+ * 
+ * Receives a frame sent with `ma_frame_tx_f32()`. Like `ma_frame_rx()`, but 
+ * for a frame of `float` samples.
+ * 
+ * @param frame         Buffer to store received frame.
+ * @param c_frame_in    Channel from which to receive frame.
+ * @param channel_count Number of channels represented in the frame.
+ * @param sample_count  Number of samples represented in the frame.
+ */
+MA_C_API
+void ma_frame_rx_f32(
+    float frame[],
+    const chanend_t c_frame_in,
+    const unsigned channel_count,
+    const unsigned sample_count);
+
+/**
+ * @brief Largest credit count usable with `ma_frame_stream_rx_init()`.
+ * 
+ * Credits are returned as single bytes, and must all fit in the channel's
+ * buffering so that returning one never blocks the receiver.
+ */
+#define MA_FRAME_STREAM_MAX_CREDITS   4
+
+
+/**
+ * @brief Start receiving frames streamed with `ma_frame_stream_tx()`.
+ * 
+ * `c_frame_in` is one end of a streaming channel, which, unlike the channel 
+ * transactions used by `ma_frame_tx()`, keeps its route open between frames.
+ * Each frame is therefore sent as a single uninterrupted burst of words, 
+ * without the handshake needed to open and close a route, which is 
+ * significant when crossing tiles with small frames.
+ * 
+ * Flow control uses credits: the transmitter uses up one credit for each frame
+ * it sends, and waits if it has none, and the receiver returns one after each
+ * frame it receives. This call grants the transmitter its initial `credits`, 
+ * so at most `credits` frames are ever in flight. It must be called once, 
+ * before the first `ma_frame_stream_rx()`.
+ * 
+ * The sender is not required to be on the same tile as the receiver.
+ * 
+ * @param c_frame_in    Streaming chanend from which frames will be received.
+ * @param credits       Number of credits, 1 to `MA_FRAME_STREAM_MAX_CREDITS`.
+ */
+MA_C_API
+void ma_frame_stream_rx_init(
+    const chanend_t c_frame_in,
+    const unsigned credits);
+
+
+/**
+ * @brief Stream a 32-bit PCM frame over a streaming channel.
+ * 
+ * Uses up one credit, waiting for one to be returned by the receiver if none
+ * are left, then sends `frame[]` in memory order. See 
+ * `ma_frame_stream_rx_init()`.
+ * 
+ * @param c_frame_out   Streaming chanend over which to send frame.
+ * @param frame         Frame to be transmitted.
+ * @param channel_count Number of channels represented in the frame.
+ * @param sample_count  Number of samples represented in the frame.
+ */
+MA_C_API
+void ma_frame_stream_tx(
+    const chanend_t c_frame_out,
+    const int32_t frame[],
+    const unsigned channel_count,
+    const unsigned sample_count);
+
+
+/**
+ * @brief Receive a 32-bit PCM frame streamed with `ma_frame_stream_tx()`.
+ * 
+ * Blocks until the whole frame has been received, then returns a credit to
+ * the transmitter.
+ * 
+ * @param frame         Buffer to store received frame.
+ * @param c_frame_in    Streaming chanend from which to receive frame.
+ * @param channel_count Number of channels represented in the frame.
+ * @param sample_count  Number of samples represented in the frame.
+ */
+MA_C_API
+void ma_frame_stream_rx(
+    int32_t frame[],
+    const chanend_t c_frame_in,
+    const unsigned channel_count,
+    const unsigned sample_count);
+
+
+/**
+ * @brief Stop streaming frames.
+ * 
+ * Called by the transmitter. Waits until the receiver has taken every frame 
+ * sent, by collecting all `credits` granted in `ma_frame_stream_rx_init()`,
+ * after which the channel holds no data and may be freed.
+ * 
+ * @param c_frame_out   Streaming chanend frames were sent over.
+ * @param credits       Number of credits granted by the receiver.
+ */
+MA_C_API
+void ma_frame_stream_tx_end(
+    const chanend_t c_frame_out,
+    const unsigned credits);
+
 C_API_END
\ No newline at end of file
@@ -0,0 +1,126 @@
+// Copyright 2022-2024 XMOS LIMITED.
+// This Software is subject to the terms of the XMOS Public Licence: Version 1.
+#pragma once
+
+#include "api.h"
+#include "pdm_resources.h"
+#include "etc/xcore_compat.h"
+
+C_API_START
+
+/**
+ * @brief Handle to a mic array instance.
+ *
+ * A C-callable handle to a mic array object, for applications which run
+ * more than one mic array, each with its own configuration and hardware
+ * resources, or which cannot use the C++ API directly.
+ *
+ * The type is opaque to C. Each instance is defined, from one of the prefab
+ * (or any other) mic array classes, with `MA_INSTANCE_DEFINE()` in a C++
+ * file, and declared with `MA_INSTANCE_DECLARE()` wherever it is used:
+ *
+ * @code{.cpp}
+ *  // instances.cpp
+ *  #include "mic_array.h"
+ *  MA_INSTANCE_DEFINE(array_a, mic_array::prefab::BasicMicArray<8, 16, true>);
+ *  MA_INSTANCE_DEFINE(array_b, mic_array::prefab::Basic192MicArray<8, 32, false>);
+ * @endcode
+ *
+ * @code{.c}
+ *  // app.c
+ *  MA_INSTANCE_DECLARE(array_a);
+ *  ...
+ *  ma_init(&array_a, &cfg_a);
+ * @endcode
+ */
+typedef struct ma_instance ma_instance_t;
+
+/**
+ * @brief Run-time configuration of a mic array instance.
+ *
+ * Passed to `ma_init()`.
+ */
+MA_C_API
+typedef struct {
+  /**
+   * @brief Hardware resources used by the instance.
+   *
+   * No two instances may share a port or clock block. Must remain valid for
+   * as long as the instance is used.
+   */
+  pdm_rx_resources_t* pdm_res;
+
+  /**
+   * @brief Ratio of the master audio clock to the PDM clock.
+   *
+   * See `mic_array_resources_configure()`.
+   */
+  unsigned mclk_divider;
+
+  /**
+   * @brief Whether the PDM rx service runs on its own thread.
+   *
+   * If `0`, `ma_task()` installs the PDM rx ISR on the decimation thread.
+   * The PDM rx ISR has a single, global context, so no more than one
+   * instance may do this. If non-zero, `ma_pdm_rx_task()` must be run on
+   * another thread of the same tile, and it also deinterleaves the PDM data
+   * (see @ref mic_array::StandardPdmRxService::DeinterleaveInThread()).
+   */
+  unsigned use_pdm_thread;
+} ma_config_t;
+
+/**
+ * @brief Declare a mic array instance defined with `MA_INSTANCE_DEFINE()`.
+ *
+ * @param NAME  Name of the instance.
+ */
+#define MA_INSTANCE_DECLARE(NAME)     extern ma_instance_t NAME
+
+/**
+ * @brief Initialize a mic array instance.
+ *
+ * Initializes the instance's decimator, configures its ports and clocks for
+ * PDM reception, and starts the PDM clock, as `ma_vanilla_init()` does for
+ * the vanilla API.
+ *
+ * @param handle  The instance.
+ * @param cfg     Its configuration. Need not remain valid after this returns.
+ */
+MA_C_API
+void ma_init(
+    ma_instance_t* handle,
+    const ma_config_t* cfg);
+
+/**
+ * @brief Entry point for the decimation thread of a mic array instance.
+ *
+ * Installs and unmasks the PDM rx ISR (unless `ma_config_t::use_pdm_thread`
+ * was set), and then runs the decimator, sending frames over
+ * `c_frames_out`. Receive them with `ma_frame_rx()` or
+ * `ma_frame_rx_transpose()`.
+ *
+ * @note This call does not return.
+ *
+ * @param handle        The instance, initialized with `ma_init()`.
+ * @param c_frames_out  (Non-streaming) Channel over which to send frames.
+ */
+MA_C_API
+void ma_task(
+    ma_instance_t* handle,
+    chanend_t c_frames_out);
+
+/**
+ * @brief Entry point for the PDM rx thread of a mic array instance.
+ *
+ * Only for instances with `ma_config_t::use_pdm_thread` set. Must be run on
+ * the same tile as `ma_task()`.
+ *
+ * @note This call does not return.
+ *
+ * @param handle  The instance, initialized with `ma_init()`.
+ */
+MA_C_API
+void ma_pdm_rx_task(
+    ma_instance_t* handle);
+
+C_API_END
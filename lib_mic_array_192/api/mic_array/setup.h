@@ -4,6 +4,24 @@
 
 #include "mic_array.h"
 
+/**
+ * Length of the PDM clock warm-up performed by `mic_array_pdm_clock_start()`,
+ * in microseconds. Many microphones need some time with the PDM clock running
+ * before they produce valid data; check the data sheet of the part used. May
+ * be `0` for parts which need no warm-up.
+ */
+#ifndef MIC_ARRAY_CONFIG_PDM_WARMUP_US
+# define MIC_ARRAY_CONFIG_PDM_WARMUP_US       (50000)
+#endif
+
+/**
+ * Factor by which `mic_array_pdm_clock_start()` slows the PDM clock during
+ * its warm-up. `1` runs the warm-up at the full PDM clock rate.
+ */
+#ifndef MIC_ARRAY_CONFIG_PDM_WARMUP_SLOWDOWN
+# define MIC_ARRAY_CONFIG_PDM_WARMUP_SLOWDOWN (2)
+#endif
+
 C_API_START
 
 /**
@@ -68,6 +86,50 @@ void mic_array_resources_configure(
     pdm_rx_resources_t* pdm_res,
     int divide);
 
+/**
+ * @brief Configure an additional port to capture PDM data.
+ * 
+ * For microphones spread over more than one port (see 
+ * @ref mic_array::MultiPortPdmRxService), `pdm_res->p_pdm_mics` is the first
+ * port, and this function configures each of the others, `p_pdm_mics`, as
+ * `mic_array_resources_configure()` does the first: it is reset, and enabled
+ * as a 32-bit buffered input clocked by the same capture clock (Clock A in an
+ * SDR configuration, Clock B in a DDR configuration).
+ * 
+ * Call this after `mic_array_resources_configure()` and before the clock(s)
+ * are started.
+ * 
+ * @param pdm_res     The hardware resources used by the mic array.
+ * @param p_pdm_mics  The additional port on which PDM data is received.
+ */
+MA_C_API
+void mic_array_resources_configure_port(
+    const pdm_rx_resources_t* pdm_res,
+    port_t p_pdm_mics);
+
+/**
+ * @brief Forward PDM data from a port to another tile.
+ * 
+ * Entry point for a thread on the tile which owns the PDM port, where the
+ * mic array's decimation runs on another tile (see 
+ * @ref mic_array::ChannelPdmRxService). It reads each word of PDM data from
+ * `p_pdm_mics` and sends it, as it is read, over the streaming chanend
+ * `c_pdm_words`. This is the only mic array thread needed on this tile.
+ * 
+ * `p_pdm_mics` must already be configured, with
+ * `mic_array_resources_configure()`, and the PDM clock started.
+ * 
+ * @note This call does not return.
+ * 
+ * @param p_pdm_mics   The port on which PDM data is received.
+ * @param c_pdm_words  Streaming chanend connected to the chanend passed to
+ *                     `mic_array::ChannelPdmRxService::Init()`.
+ */
+MA_C_API
+void mic_array_pdm_forward(
+    port_t p_pdm_mics,
+    chanend_t c_pdm_words);
+
 /**
  * @brief Start the PDM and capture clock(s).
  * 
@@ -84,6 +146,14 @@ void mic_array_resources_configure(
  * clock is also started, causing `pdm_res->p_pdm_mics` to begin storing PDM 
  * samples received on each period of the capture clock.
  * 
+ * Before starting the clocks at full rate, the PDM clock is run for
+ * @ref MIC_ARRAY_CONFIG_PDM_WARMUP_US microseconds, slowed down by a factor of
+ * @ref MIC_ARRAY_CONFIG_PDM_WARMUP_SLOWDOWN, and this function does not return
+ * until that warm-up is over. To avoid this wait, or to choose the warm-up of 
+ * a particular microphone at run time, use `mic_array_pdm_clock_start_async()`
+ * and `mic_array_pdm_clock_ramp()` instead; this function is equivalent to
+ * calling both in turn.
+ * 
  * In DDR configuration, this function starts Clock B, waits for a rising edge, 
  * and then starts Clock A, ensuring that the rising edges of the two clocks are 
  * not in phase.
@@ -104,6 +174,162 @@ void mic_array_pdm_clock_start(
     pdm_rx_resources_t* pdm_res,
     int divide);
 
+/**
+ * @brief Start the PDM and capture clock(s) on a signal shared between boards.
+ * 
+ * As `mic_array_pdm_clock_start()`, except that once the warm-up is over the
+ * clocks are not started at full rate until a sync signal arrives. Where 
+ * several boards, each with its own mic array, share an audio master clock,
+ * this starts all their PDM clocks together, so that a sample index counted
+ * from the start on one board counts the same instant on every board. In
+ * particular, the sample index in each frame header (see
+ * @ref mic_array::FrameOutputHandler::SetBlockStamp()) is then a global
+ * index, and frames from different boards with the same index can be
+ * combined without realigning them. The timestamps in the headers remain
+ * local to each board's reference timer.
+ * 
+ * The sync signal is given by `p_sync`, `c_sync`, or both:
+ * 
+ * If `p_sync` is non-zero, it is a 1-bit port wired to a sync line common to
+ * all boards, which one of them (or an external device) drives high to start
+ * the clocks. This function enables the port, waits for the line to be low and
+ * then high again, and disables the port. The clocks are started within a few
+ * instructions of the rising edge, so this aligns the boards to within a PDM
+ * clock period.
+ * 
+ * If `c_sync` is non-zero, a word (of any value) is received from it, e.g.
+ * sent with `chanend_out_word()` by a thread on the board which coordinates
+ * the start. The clocks are started as soon as the word arrives. Because the
+ * word takes longer to reach boards more links away, this alone only aligns
+ * the boards coarsely, but it needs no extra wiring. If both are given, the
+ * word is received first, so that the board can tell the coordinator it is
+ * ready before waiting on the sync line.
+ * 
+ * As with `mic_array_pdm_clock_start()`, this must be called prior to 
+ * launching the decimator or PDM rx threads, and those should be launched
+ * as soon as it returns.
+ * 
+ * @param pdm_res   The hardware resources used by the mic array.
+ * @param divide    The divider to generate the PDM clock from the master clock.
+ * @param p_sync    1-bit port on which to wait for a rising edge, or `0`.
+ * @param c_sync    Chanend from which to receive a word, or `0`.
+ * 
+ * @returns Reference time at which the sync signal arrived and the clocks
+ *          were started.
+ */
+MA_C_API
+uint32_t mic_array_pdm_clock_start_sync(
+    pdm_rx_resources_t* pdm_res,
+    int divide,
+    port_t p_sync,
+    chanend_t c_sync);
+
+/**
+ * @brief Start the PDM clock warm-up without waiting for it to finish.
+ * 
+ * Starts Clock A, the PDM clock, slowed down by a factor of `warmup_slowdown`,
+ * and returns at once with the reference time at which the warm-up is over.
+ * `mic_array_pdm_clock_ramp()` must then be called, with that time, to switch
+ * to the full PDM clock rate and start the capture clock. Typically the
+ * application does the rest of its initialization in the meantime and waits 
+ * for a timer event at the returned time (e.g. with a `hwtimer_t` whose 
+ * trigger time is set to it) before calling `mic_array_pdm_clock_ramp()`, 
+ * which then returns without waiting.
+ * 
+ * If `warmup_us` is `0`, no clock is started and the current time is
+ * returned, so that `mic_array_pdm_clock_ramp()` starts the clocks at full
+ * rate straight away.
+ * 
+ * `mic_array_resources_configure()` must have been called already to configure
+ * the resources indicated in `pdm_res`.
+ * 
+ * @param pdm_res         The hardware resources used by the mic array.
+ * @param divide          The divider to generate the PDM clock from the master
+ *                        clock.
+ * @param warmup_us       Length of the warm-up, in microseconds.
+ * @param warmup_slowdown Factor by which the PDM clock is slowed during the
+ *                        warm-up.
+ * 
+ * @returns Reference time at which the warm-up is over.
+ */
+MA_C_API
+uint32_t mic_array_pdm_clock_start_async(
+    pdm_rx_resources_t* pdm_res,
+    int divide,
+    unsigned warmup_us,
+    unsigned warmup_slowdown);
+
+/**
+ * @brief Finish the PDM clock warm-up and start the clocks at full rate.
+ * 
+ * Completes a warm-up started with `mic_array_pdm_clock_start_async()`,
+ * whose return value must be passed as `due`. If `due` has not yet been 
+ * reached, this waits until it has. Clock A is then set to the full PDM clock
+ * rate and, as by `mic_array_pdm_clock_start()`, the PDM and capture clocks
+ * are started.
+ * 
+ * In an SDR configuration, the mic array may already be running. The 
+ * samples it decimates from PDM data captured during the warm-up are not 
+ * meaningful, and are best dropped with @ref mic_array::MicArray::SettlingSamples.
+ * In a DDR configuration this function reads `pdm_res->p_pdm_mics` itself, so 
+ * it must be called before the PDM rx ISR (or thread) is started.
+ * 
+ * @param pdm_res   The hardware resources used by the mic array.
+ * @param divide    The divider to generate the PDM clock from the master clock.
+ * @param due       Time returned by `mic_array_pdm_clock_start_async()`.
+ */
+MA_C_API
+void mic_array_pdm_clock_ramp(
+    pdm_rx_resources_t* pdm_res,
+    int divide,
+    uint32_t due);
+
+/**
+ * @brief Change the PDM clock rate while the mic array is running.
+ * 
+ * Stops the PDM and capture clock(s), sets them for a PDM clock of the master
+ * clock divided by `divide`, and starts them again as 
+ * `mic_array_pdm_clock_ramp()` does, without a warm-up. This is used to move
+ * between a reduced PDM clock for low-power listening and the full PDM clock;
+ * see \verbatim embed:rst :ref:`power_modes` \endverbatim.
+ * 
+ * In an SDR configuration this may be called at any time after the clocks 
+ * have been started, from any thread, while the PDM rx service and decimator
+ * keep running. The PDM block being captured at the time of the change 
+ * spans both rates, so the few output samples which depend on it should be 
+ * ignored.
+ * 
+ * In a DDR configuration the clocks are restarted by reading 
+ * `pdm_res->p_pdm_mics`, as in `mic_array_pdm_clock_ramp()`, so the PDM rx
+ * ISR (or thread) must not be reading the port at the time.
+ * 
+ * @param pdm_res   The hardware resources used by the mic array.
+ * @param divide    The new divider to generate the PDM clock from the master 
+ *                  clock.
+ */
+MA_C_API
+void mic_array_pdm_clock_set_divide(
+    pdm_rx_resources_t* pdm_res,
+    int divide);
+
+/**
+ * @brief Set the clock divider of the calling thread's tile.
+ * 
+ * The tile's core clock becomes the PLL clock divided by `divide`, which 
+ * reduces both the tile's instruction rate and power in proportion. The
+ * reference clock, and so all timers and timestamps, and the port clocks 
+ * derived from the master clock, are unaffected. 
+ * 
+ * This is intended to be driven by a @ref mic_array::ClockGovernor, which
+ * chooses the divider from the decimation thread's measured slack. Every
+ * thread on the tile is slowed down, not just the mic array's.
+ * 
+ * @param divide  Tile clock divider, from `1` (undivided) to `256`.
+ */
+MA_C_API
+void mic_array_tile_clock_divide(
+    unsigned divide);
+
 /**
  * @brief Compute clock divider for PDM clock.
  * 
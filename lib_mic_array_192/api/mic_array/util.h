@@ -57,4 +57,107 @@ void deinterleave8(uint32_t*);
 MA_C_API 
 void deinterleave16(uint32_t*);
 
+
+/**
+ * @brief Perform deinterleaving for consecutive 8-microphone subblocks.
+ * 
+ * Assembly function. 
+ * 
+ * Equivalent to calling `deinterleave8()` on each of the `subblocks` 8 word
+ * subblocks starting at `samples`, but without the per-call overhead.
+ */
+MA_C_API 
+void deinterleave8_block(
+    uint32_t* samples,
+    unsigned subblocks);
+
+
+/**
+ * @brief Perform deinterleaving for consecutive 16-microphone subblocks.
+ * 
+ * Assembly function. 
+ * 
+ * Equivalent to calling `deinterleave16()` on each of the `subblocks` 16 word
+ * subblocks starting at `samples`, but without the per-call overhead.
+ * 
+ * @ingroup util_h_
+ */
+MA_C_API 
+void deinterleave16_block(
+    uint32_t* samples,
+    unsigned subblocks);
+
+
+/**
+ * @brief Deinterleave the subblocks of 8 microphones, then copy the channels
+ *        through a channel map into a mic-major output block.
+ * 
+ * Assembly function. 
+ * 
+ * `src` points to `subblocks` consecutive 8 word subblocks, in the format of
+ * the argument to `deinterleave8()`, with the oldest subblock last. Each is
+ * deinterleaved in place by `deinterleave8()`, and then output channel `k` of
+ * it is copied from word `channel_map[k]` of the subblock into
+ * `dst[k*subblocks + sb]`, where subblock `sb = 0` is the oldest.
+ * 
+ * This is `deinterleave8_block()` followed by the channel map copy done on each
+ * block of PDM data by the PDM rx service, in one call. Each word is still
+ * stored back into `src` and loaded again to be copied through the map; only
+ * the per-call and loop overhead of doing the two separately is saved.
+ * 
+ * `channels_out` must be at least 1.
+ */
+MA_C_API 
+void deinterleave8_then_map(
+    uint32_t* dst,
+    uint32_t* src,
+    unsigned subblocks,
+    const unsigned* channel_map,
+    unsigned channels_out);
+
+
+/**
+ * @brief Deinterleave the subblocks of 16 microphones, then copy the channels
+ *        through a channel map into a mic-major output block.
+ * 
+ * Assembly function. 
+ * 
+ * As `deinterleave8_then_map()`, with subblocks of 16 words, in the format of the
+ * argument to `deinterleave16()`.
+ * 
+ * @ingroup util_h_
+ */
+MA_C_API 
+void deinterleave16_then_map(
+    uint32_t* dst,
+    uint32_t* src,
+    unsigned subblocks,
+    const unsigned* channel_map,
+    unsigned channels_out);
+
+
+/**
+ * @brief Deinterleave the subblocks of 16 microphones straight into a
+ *        mic-major output block.
+ * 
+ * Assembly function. 
+ * 
+ * As `deinterleave16_then_map()` with `channel_map[k] = k` and `channels_out = 16`,
+ * but the last pass of the deinterleave stores each channel directly into
+ * `dst[k*subblocks + sb]`, with no channel map to look up and without first
+ * storing it back into `src`. `src` is left partly deinterleaved.
+ * 
+ * In a DDR configuration on an 8-bit port, each 32-bit port read holds 2 PDM
+ * clocks of the 8 pins sampled on each edge, so that channels `0` to `7` and
+ * `8` to `15` are the pins' mics captured on opposite edges. This is the
+ * 16 mic DDR configuration's deinterleave.
+ * 
+ * @ingroup util_h_
+ */
+MA_C_API 
+void deinterleave16_ddr(
+    uint32_t* dst,
+    uint32_t* src,
+    unsigned subblocks);
+
 C_API_END
\ No newline at end of file
@@ -4,8 +4,6 @@
 #include "mic_array/cpp/Util.hpp"
 #include "mic_array/util.h"
 
-#include "mic_array.h"
-
 
 
 template <>
@@ -49,23 +47,155 @@ void mic_array::deinterleave_pdm_samples<8>(
     uint32_t* samples,
     unsigned s2_dec_factor)
 {
-  constexpr unsigned MICS = 8;
+  deinterleave8_block(samples, s2_dec_factor);
+}
 
-  for(int k = 0; k < s2_dec_factor; k++) {
-    uint32_t* sb = &samples[k*MICS];
-    deinterleave8(sb);
+template <>
+void mic_array::deinterleave_pdm_samples<16>(
+    uint32_t* samples,
+    unsigned s2_dec_factor)
+{
+  deinterleave16_block(samples, s2_dec_factor);
+}
+
+
+
+// Shared by the channel counts without a kernel of their own.
+template <unsigned MIC_COUNT>
+static void deinterleave_then_map(
+    uint32_t* out,
+    uint32_t* samples,
+    unsigned s2_dec_factor,
+    const unsigned* channel_map,
+    unsigned channels_out)
+{
+  mic_array::deinterleave_pdm_samples<MIC_COUNT>(samples, s2_dec_factor);
+
+  for(int ch = 0; ch < channels_out; ch++){
+    const uint32_t* src = &samples[(s2_dec_factor-1)*MIC_COUNT + channel_map[ch]];
+    for(int sb = 0; sb < s2_dec_factor; sb++){
+      out[ch*s2_dec_factor + sb] = src[0];
+      src -= MIC_COUNT;
+    }
   }
 }
 
 template <>
-void mic_array::deinterleave_pdm_samples<16>(
+void mic_array::deinterleave_pdm_samples_mapped<1>(
+    uint32_t* out,
+    uint32_t* samples,
+    unsigned s2_dec_factor,
+    const unsigned* channel_map,
+    unsigned channels_out)
+{
+  deinterleave_then_map<1>(out, samples, s2_dec_factor, channel_map, channels_out);
+}
+
+template <>
+void mic_array::deinterleave_pdm_samples_mapped<2>(
+    uint32_t* out,
+    uint32_t* samples,
+    unsigned s2_dec_factor,
+    const unsigned* channel_map,
+    unsigned channels_out)
+{
+  deinterleave_then_map<2>(out, samples, s2_dec_factor, channel_map, channels_out);
+}
+
+template <>
+void mic_array::deinterleave_pdm_samples_mapped<4>(
+    uint32_t* out,
+    uint32_t* samples,
+    unsigned s2_dec_factor,
+    const unsigned* channel_map,
+    unsigned channels_out)
+{
+  deinterleave_then_map<4>(out, samples, s2_dec_factor, channel_map, channels_out);
+}
+
+template <>
+void mic_array::deinterleave_pdm_samples_mapped<8>(
+    uint32_t* out,
+    uint32_t* samples,
+    unsigned s2_dec_factor,
+    const unsigned* channel_map,
+    unsigned channels_out)
+{
+  deinterleave8_then_map(out, samples, s2_dec_factor, channel_map, channels_out);
+}
+
+template <>
+void mic_array::deinterleave_pdm_samples_mapped<16>(
+    uint32_t* out,
+    uint32_t* samples,
+    unsigned s2_dec_factor,
+    const unsigned* channel_map,
+    unsigned channels_out)
+{
+  deinterleave16_then_map(out, samples, s2_dec_factor, channel_map, channels_out);
+}
+
+
+
+// Shared by the channel counts without a direct kernel.
+template <unsigned MIC_COUNT>
+static void deinterleave_then_copy(
+    uint32_t* out,
     uint32_t* samples,
     unsigned s2_dec_factor)
 {
-  constexpr unsigned MICS = 16;
+  mic_array::deinterleave_pdm_samples<MIC_COUNT>(samples, s2_dec_factor);
 
-  for(int k = 0; k < s2_dec_factor; k++) {
-    uint32_t* sb = &samples[k*MICS];
-    deinterleave16(sb);
+  for(int ch = 0; ch < MIC_COUNT; ch++){
+    const uint32_t* src = &samples[(s2_dec_factor-1)*MIC_COUNT + ch];
+    for(int sb = 0; sb < s2_dec_factor; sb++){
+      out[ch*s2_dec_factor + sb] = src[0];
+      src -= MIC_COUNT;
+    }
   }
+}
+
+template <>
+void mic_array::deinterleave_pdm_samples_direct<1>(
+    uint32_t* out,
+    uint32_t* samples,
+    unsigned s2_dec_factor)
+{
+  deinterleave_then_copy<1>(out, samples, s2_dec_factor);
+}
+
+template <>
+void mic_array::deinterleave_pdm_samples_direct<2>(
+    uint32_t* out,
+    uint32_t* samples,
+    unsigned s2_dec_factor)
+{
+  deinterleave_then_copy<2>(out, samples, s2_dec_factor);
+}
+
+template <>
+void mic_array::deinterleave_pdm_samples_direct<4>(
+    uint32_t* out,
+    uint32_t* samples,
+    unsigned s2_dec_factor)
+{
+  deinterleave_then_copy<4>(out, samples, s2_dec_factor);
+}
+
+template <>
+void mic_array::deinterleave_pdm_samples_direct<8>(
+    uint32_t* out,
+    uint32_t* samples,
+    unsigned s2_dec_factor)
+{
+  deinterleave_then_copy<8>(out, samples, s2_dec_factor);
+}
+
+template <>
+void mic_array::deinterleave_pdm_samples_direct<16>(
+    uint32_t* out,
+    uint32_t* samples,
+    unsigned s2_dec_factor)
+{
+  deinterleave16_ddr(out, samples, s2_dec_factor);
 }
\ No newline at end of file
@@ -17,9 +17,19 @@ void dcoe_filter(
     dcoe_chan_state_t state[],
     int32_t new_input[],
     const unsigned chan_count)
+{
+  dcoe_filter_shr(new_output, state, new_input, chan_count, 
+                  DCOE_DEFAULT_POLE_SHR);
+}
+
+void dcoe_filter_shr(
+    int32_t new_output[],
+    dcoe_chan_state_t state[],
+    int32_t new_input[],
+    const unsigned chan_count,
+    const unsigned pole_shr)
 {
   #define N   32
-  #define Q   6
 
   for(int k = 0; k < chan_count; k++){
     const int64_t x_new = ((int64_t)new_input[k]) << N;
@@ -27,11 +37,47 @@ void dcoe_filter(
     new_output[k] = state[k].prev_y >> N;
     // Doing these next two steps here avoids the need to store the 
     // inputs between samples
-    state[k].prev_y = state[k].prev_y - (state[k].prev_y >> Q);
+    state[k].prev_y = state[k].prev_y - (state[k].prev_y >> pole_shr);
     state[k].prev_y = state[k].prev_y - x_new; 
 
   }
 
   #undef N
-  #undef Q
+}
+
+
+void dcoe_state_init_s32(
+    int32_t state[],
+    const unsigned chan_count)
+{
+  memset(state, 0, sizeof(int32_t) * chan_count);
+}
+
+
+// Saturate to the VPU's 32-bit range, so this matches dcoe_filter_block().
+static inline int32_t sat32(const int64_t a)
+{
+  return (a > INT32_MAX)? INT32_MAX : (a < -INT32_MAX)? -INT32_MAX : a;
+}
+
+
+void dcoe_filter_frame(
+    int32_t frame[],
+    int32_t state[],
+    const unsigned chan_count,
+    const unsigned sample_count,
+    const unsigned pole_shr)
+{
+  for(int k = 0; k < chan_count; k++){
+    int32_t* x = &frame[k * sample_count];
+    int32_t w = state[k];
+
+    for(int t = 0; t < sample_count; t++){
+      const int32_t y = sat32((int64_t) x[t] + w);
+      w = sat32((int64_t) (y - (y >> pole_shr)) - x[t]);
+      x[t] = y;
+    }
+
+    state[k] = w;
+  }
 }
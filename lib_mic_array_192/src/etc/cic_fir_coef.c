@@ -0,0 +1,28 @@
+// Copyright 2022-2024 XMOS LIMITED.
+// This Software is subject to the terms of the XMOS Public Licence: Version 1.
+
+#include "mic_array/etc/filters_default.h"
+
+// Order 4 CIC decimating by 64, 253 taps applied to the newest PDM
+// samples, scaled to 8-bit coefficients. Generated by python/stage1_cic.py.
+MIC_ARRAY_CONFIG_COEF_ATTRIBUTES
+const uint32_t cic_stage1_coef[CIC_STAGE1_WORDS] = {
+  0xFFFE03C7, 0x336955A6, 0x707FFFF8, 0x1CC95260, 0x325499C0, 0xFFFFF073, 0x2D54B667, 0x1E03FFFF,
+  0xFFFFFC07, 0xC38E66CB, 0x5AAAAAAD, 0x56926380, 0x0E324B55, 0xAAAAAAD6, 0x9B338E1F, 0x01FFFFFF,
+  0xFFFFFFF8, 0x03F078F3, 0x9CCCCCCE, 0x671C7C00, 0x01F1C733, 0x999999CE, 0x78F07E00, 0xFFFFFFFF,
+  0xFFFFFFFF, 0xFC007F03, 0xE0F0F0F0, 0x781F8000, 0x000FC0F0, 0x7878783E, 0x07F001FF, 0xFFFFFFFF,
+  0xFFFFFFFF, 0xFFFF8003, 0xFF00FF00, 0x7FE00000, 0x00003FF0, 0x07F807FE, 0x000FFFFF, 0xFFFFFFFF,
+  0xFFFFFFFF, 0xFFFFFFFC, 0x0000FFFF, 0x80000000, 0x0000000F, 0xFFF80001, 0xFFFFFFFF, 0xFFFFFFFF,
+  0xFFFFFFFF, 0xFFFFFFFF, 0xFFFF0000, 0x00000000, 0x00000000, 0x0007FFFF, 0xFFFFFFFF, 0xFFFFFFFF,
+  0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000,
+};
+
+// Kaiser windowed (beta 5.65) low-pass, cut off at 7200 Hz, whose
+// passband inverts the droop of cic_stage1_coef.
+MIC_ARRAY_CONFIG_COEF_ATTRIBUTES
+const int32_t cic_stage2_coef[CIC_STAGE2_TAP_COUNT] = 
+{
+    -0x10a89d, -0xc9abb, 0x11fa40, 0x3839e0, 0x375e14, -0xec395, -0x74990a, -0x959384, -0x235048, 0xb28239, 0x134ab07, 0xafe782, -0xc5adbd, -0x20e32bf, -0x1c5fcd9, 0x65ca9c, 0x2fb951b, 0x38d5954, 0xd2c87f, -0x3ab4141, -0x6218896, -0x374394a, 0x38deadf, 0x9a218ce, 0x888526e, -0x181f3a6, -0xe8af1dd, -0x134ea40a, -0x68bf604, 0x178040c4, 0x3b2f500d, 0x5349f351, 0x5349f351, 0x3b2f500d, 0x178040c4, -0x68bf604, -0x134ea40a, -0xe8af1dd, -0x181f3a6, 0x888526e, 0x9a218ce, 0x38deadf, -0x374394a, -0x6218896, -0x3ab4141, 0xd2c87f, 0x38d5954, 0x2fb951b, 0x65ca9c, -0x1c5fcd9, -0x20e32bf, -0xc5adbd, 0xafe782, 0x134ab07, 0xb28239, -0x235048, -0x959384, -0x74990a, -0xec395, 0x375e14, 0x3839e0, 0x11fa40, -0xc9abb, -0x10a89d
+};
+
+const right_shift_t cic_stage2_shr = 2;
@@ -0,0 +1,161 @@
+// Copyright 2022-2024 XMOS LIMITED.
+// This Software is subject to the terms of the XMOS Public Licence: Version 1.
+
+#include "mic_array/etc/filters_default.h"
+
+// Polyphase decomposition of a 4704-tap Kaiser windowed sinc low-pass filter
+// (cutoff 20.3 kHz at 48 kHz input, beta 7.86), scaled so that each phase has
+// a DC gain of 1.0 in Q2.30. Row p holds taps p, p+147, p+2*147, ...
+MIC_ARRAY_CONFIG_COEF_ATTRIBUTES
+const int32_t resample_147_160_coef[RESAMPLE_147_160_UP][RESAMPLE_147_160_PHASE_TAPS] = 
+{
+    { -0xde0a, 0x31199, -0x49d2f, 0x720c, 0x10d826, -0x34ee2d, 0x68ebe5, -0x9a8f73, 0xa5d9a2, -0x5afeb0, -0x729499, 0x1d81810, -0x3c22a5c, 0x5ef70c1, -0x7fd2abe, 0x98b3c2e, 0x3621f13e, 0x9283e2e, -0x7dc43c2, 0x5e7dbde, -0x3c6710e, 0x1e0c781, -0x7b402c, -0x5487e4, 0xa22051, -0x9918ba, 0x68d7d4, -0x356c95, 0x116233, 0x14c9, -0x4700e, 0x30252 },
+    { -0xe169, 0x320ca, -0x4ca63, 0xd022, 0x104b80, -0x346a3d, 0x68f6f6, -0x9bfaf6, 0xa989ba, -0x6175e9, -0x69d49b, 0x1cf35c3, -0x3bd8c48, 0x5f68f97, -0x81da40c, 0x9eed02d, 0x36206a22, 0x8c5da26, -0x7baf289, 0x5dfd23c, -0x3ca6073, 0x1e94397, -0x83d6b0, -0x4e1213, 0x9e5e23, -0x9796fa, 0x68bad2, -0x35e573, 0x11e99e, -0x479e, -0x44305, 0x2f2f7 },
+    { -0xe4be, 0x32fe2, -0x4f7a6, 0x12f05, 0xfbc48, -0x33e0c7, 0x68f8f8, -0x9d5b11, 0xad3039, -0x67ed02, -0x6100d9, 0x1c6211d, -0x3b896c7, 0x5fd371c, -0x83dac3f, 0xa52f624, 0x361d5bfd, 0x8641406, -0x7993a81, 0x5d7552e, -0x3cdf8a6, 0x1f18bda, -0x8c5785, -0x479dc8, 0x9a9379, -0x960a66, 0x6894f2, -0x3658c6, 0x126e63, -0xa325, -0x41619, 0x2e38a },
+    { -0xe805, 0x33ee1, -0x524f4, 0x18eae, 0xf2a87, -0x3351cd, 0x68f1dd, -0x9eaf97, 0xb0ccc2, -0x6e636b, -0x5819fd, 0x1bcdaa8, -0x3b349d4, 0x6036613, -0x85d3fec, 0xab7aa03, 0x3618c6f9, 0x802efae, -0x7771f1f, 0x5ce6610, -0x3d139c8, 0x1f99fd5, -0x94c209, -0x412b90, 0x96c0b0, -0x94732e, 0x686643, -0x36c68f, 0x12f079, -0xfdc4, -0x3e94c, 0x2d40d },
+    { -0xeb40, 0x34dc3, -0x55249, 0x1ef16, 0xe9643, -0x32bd52, 0x68e195, -0x9ff857, 0xb45ef7, -0x74d896, -0x4f20b2, 0x1b362ef, -0x3ada570, 0x6091b45, -0x87c5bab, 0xb1ce7ab, 0x3612ab51, 0x7a270f5, -0x754a3d3, 0x5c50645, -0x3d42403, 0x2017f17, -0x9d15a2, -0x3abbf5, 0x92e629, -0x92d187, 0x682ed9, -0x372ecc, 0x136fdb, -0x15775, -0x3bca2, 0x2c481 },
+    { -0xee6e, 0x35c87, -0x57fa1, 0x25036, 0xdff86, -0x32235a, 0x68c815, -0xa13526, 0xb7e67c, -0x7b4bf3, -0x4615a5, 0x1a9ba85, -0x3a7a9a4, 0x60e5587, -0x89afc14, 0xb82aaf5, 0x360b0957, 0x7429ba2, -0x731cc13, 0x5bb3738, -0x3d6b787, 0x2092937, -0xa551b6, -0x344f80, 0x8f0441, -0x9125a3, 0x67eec6, -0x379180, 0x13ec82, -0x1b031, -0x39021, 0x2b4e9 },
+    { -0xf18d, 0x36b2b, -0x5acf6, 0x2b206, 0xd6658, -0x3183e9, 0x68a550, -0xa265d5, 0xbb62f3, -0x81bcf1, -0x3cf988, 0x19fe200, -0x3a15682, 0x61313b4, -0x8b91dc4, 0xbe8efac, 0x3601e170, 0x6e37373, -0x70e9b53, 0x5b0fa59, -0x3d8f48a, 0x2109dcf, -0xad75ad, -0x2de6bb, 0x8b1b5a, -0x8f6fb6, 0x67a61d, -0x37eeaa, 0x146669, -0x207f4, -0x363cc, 0x2a546 },
+    { -0xf49d, 0x379ad, -0x5da45, 0x3147f, 0xccac3, -0x30df03, 0x687939, -0xa38a39, 0xbed402, -0x882aff, -0x33cd0d, 0x195d9fd, -0x39aac21, 0x61754ae, -0x8d6bd5a, 0xc4fb195, 0x35f73413, 0x684fc15, -0x6eb1509, 0x5a65120, -0x3dadb4b, 0x217dc7e, -0xb580f4, -0x27822e, 0x872bd2, -0x8daff4, 0x6754f2, -0x38464c, 0x14dd8a, -0x25eb7, -0x337a6, 0x2959a },
+    { -0xf79c, 0x3880b, -0x60789, 0x37799, 0xc2ccf, -0x3034ad, 0x6843c7, -0xa4a226, 0xc2394b, -0x8e958d, -0x2a90e9, 0x18ba31b, -0x393aaa1, 0x61b1762, -0x8f3d77a, 0xcb6ec65, 0x35eb01cf, 0x627392b, -0x6c73ca8, 0x59b3d0b, -0x3dc6c0f, 0x21ee4e8, -0xbd72f9, -0x212260, 0x833609, -0x8be694, 0x66fb5a, -0x389869, 0x1551e0, -0x2b475, -0x30bb3, 0x285e7 },
+    { -0xfa8b, 0x39642, -0x634bd, 0x3db4d, 0xb8c86, -0x2f84ed, 0x6804ef, -0xa5ad72, 0xc59276, -0x94fc09, -0x2145d4, 0x1813dff, -0x38c5228, 0x61e5ac5, -0x91068c8, 0xd1e9bc9, 0x35dd4b44, 0x5ca2e49, -0x6a315a6, 0x58fbfa0, -0x3dda720, 0x225b6b7, -0xc54b2e, -0x1ac7d5, 0x7f3a5f, -0x8a13ca, 0x66996a, -0x38e502, 0x15c366, -0x30927, -0x2dff8, 0x27630 },
+    { -0xfd69, 0x3a451, -0x661de, 0x43f92, 0xae9f2, -0x2ecfca, 0x67bca7, -0xa6abf4, 0xc8df26, -0x9b5de0, -0x17ec85, 0x176ab53, -0x384a2e5, 0x6211dd4, -0x92c6df0, 0xd86bb66, 0x35ce1127, 0x56ddef5, -0x67ea378, 0x583da69, -0x3de8cd2, 0x22c519a, -0xcd0907, -0x147314, 0x7b3934, -0x8837cc, 0x662f39, -0x392c1c, 0x163218, -0x35cc9, -0x2b477, 0x26675 },
+    { -0x10034, 0x3b235, -0x68ee5, 0x4a460, 0xa451d, -0x2e1548, 0x676ae8, -0xa79d83, 0xcc1f02, -0xa1ba80, -0xe85b9, 0x16bebc7, -0x37c9d0e, 0x6235f96, -0x947e39e, 0xdef46d4, 0x35bd5442, 0x5124ea9, -0x659e993, 0x5778ef9, -0x3df1d7e, 0x232b543, -0xd4abfb, -0xe249e, 0x7732e7, -0x8652d1, 0x65bcdb, -0x396db8, 0x169df1, -0x3af55, -0x28935, 0x256b8 },
+    { -0x102ed, 0x3bfed, -0x6bbcf, 0x509b0, 0x99e12, -0x2d5571, 0x670fa9, -0xa881f6, 0xcf51b1, -0xa81156, -0x5122d, 0x161000b, -0x37440e0, 0x6251f19, -0x962c686, 0xe5839a4, 0x35ab1571, 0x4b780ce, -0x634eb68, 0x56adee7, -0x3df5984, 0x238e16b, -0xdc3385, -0x7dcf8, 0x7327d8, -0x846511, 0x65426a, -0x39a9dc, 0x1706ee, -0x400c6, -0x25e34, 0x246fc },
+    { -0x10591, 0x3cd76, -0x6e897, 0x56f79, 0x8f4db, -0x2c904b, 0x66aae4, -0xa95928, 0xd276db, -0xae61d0, 0x46d60, 0x155e8da, -0x36b8ea0, 0x6265b77, -0x97d135d, 0xec18f5a, 0x359755a5, 0x45d78c2, -0x60fac6b, 0x55dcbd1, -0x3df4148, 0x23ed5d0, -0xe39f21, -0x19ca1, 0x6f1867, -0x826ec3, 0x64bffb, -0x39e08c, 0x176d0a, -0x45118, -0x23379, 0x23741 },
+    { -0x10821, 0x3dace, -0x71538, 0x5d5b2, 0x84984, -0x2bc5de, 0x663c92, -0xaa22f2, 0xd58e28, -0xb4ab5b, 0xdf82b, 0x14aa6ed, -0x362869a, 0x62713d1, -0x996c6de, 0xf2b4376, 0x358215e3, 0x40439d4, -0x5ea300d, 0x550575a, -0x3ded53a, 0x2449234, -0xeaee50, 0x49be6, 0x6b04f3, -0x80701f, 0x6435a8, -0x3a11cc, 0x17d042, -0x4a044, -0x20906, 0x2278a },
+    { -0x10a9b, 0x3e7f4, -0x741ad, 0x63c54, 0x79c17, -0x2af634, 0x65c4ad, -0xaadf30, 0xd89740, -0xbaed63, 0x178d73, 0x13f3b07, -0x3592921, 0x6274753, -0x9afddcb, 0xf95516a, 0x356b5743, 0x3abc744, -0x5c479bd, 0x542832a, -0x3de15cb, 0x24a165f, -0xf22095, 0xacc1f, 0x66eddb, -0x7e695d, 0x63a388, -0x3a3da2, 0x183094, -0x4ee47, -0x1dee0, 0x217d9 },
+    { -0x10cff, 0x3f4e4, -0x76df2, 0x6a355, 0x6eca0, -0x2a2156, 0x654332, -0xab8dbd, 0xdb91ce, -0xc12755, 0x212c72, 0x133a5ec, -0x34f7692, 0x626f530, -0x9c854e8, 0xfffb4a4, 0x35531af2, 0x3542442, -0x59e8ce9, 0x53450f1, -0x3dd0376, 0x24f621d, -0xf93577, 0x10f38c, 0x62d37f, -0x7c5ab6, 0x6309b6, -0x3a6414, 0x188dfc, -0x53b1d, -0x1b509, 0x2082e },
+    { -0x10f4c, 0x4019e, -0x79a02, 0x70aad, 0x63b2b, -0x29474d, 0x64b81d, -0xac2e77, 0xde7d7d, -0xc7589d, 0x2ad462, 0x127e865, -0x3456f4f, 0x6261ca8, -0x9e02900, 0x106a6886, 0x3539622e, 0x2fd53f3, -0x5786cfd, 0x525c261, -0x3db9ebb, 0x254753f, -0x1002c7f, 0x1711b2, 0x5eb63d, -0x7a4464, 0x62684b, -0x3a8528, 0x18e877, -0x586c0, -0x18b84, 0x1f88c },
+    { -0x11182, 0x40e1d, -0x7c5d8, 0x77253, 0x587c5, -0x286824, 0x64236a, -0xacc13c, 0xe159f7, -0xcd80a9, 0x348479, 0x11c0342, -0x33b13c2, 0x624bd02, -0x9f756e4, 0x10d5686c, 0x351e2e4b, 0x2a75969, -0x5521d62, 0x516d933, -0x3d9e81f, 0x2594f9d, -0x1070538, 0x1d2617, 0x5a9675, -0x7826a0, 0x61bf62, -0x3aa0e4, 0x194005, -0x5d12d, -0x16255, 0x1e8f4 },
+    { -0x1139f, 0x41a62, -0x7f16e, 0x7da3e, 0x4d278, -0x2783e6, 0x638518, -0xad45eb, 0xe426ea, -0xd39ee6, 0x3e3bee, 0x10ff754, -0x330645d, 0x622d590, -0xa0ddb6a, 0x1140afaa, 0x350180b0, 0x25237aa, -0x52ba181, 0x5079725, -0x3d7e02f, 0x25df111, -0x10dbf34, 0x233041, 0x567484, -0x7601a3, 0x610f15, -0x3ab74f, 0x1994a1, -0x61a5f, -0x1397f, 0x1d968 },
+    { -0x115a2, 0x42669, -0x81cc1, 0x84265, 0x41b54, -0x269a9f, 0x62dd25, -0xadbc64, 0xe6e402, -0xd9b2c0, 0x47f9f5, 0x103c571, -0x325619b, 0x62065ad, -0xa23b36e, 0x11ac398b, 0x34e35ad7, 0x1fdf1ab, -0x504fcbe, 0x4f7fdf9, -0x3d5877e, 0x262597d, -0x1145a03, 0x292fb9, 0x5250c8, -0x73d5a9, 0x60577f, -0x3ac872, 0x19e64c, -0x66253, -0x11105, 0x1c9e9 },
+    { -0x1178c, 0x43230, -0x847ca, 0x8aac0, 0x36263, -0x25ac59, 0x622b91, -0xae2488, 0xe990ed, -0xdfbba5, 0x51bdc0, 0xf76e75, -0x31a0bfc, 0x61d6cc1, -0xa38dbd4, 0x12180155, 0x34c3be4c, 0x1aa8a52, -0x4de327a, 0x4e80f76, -0x3d2dea4, 0x26688c6, -0x11ad53e, 0x2f2408, 0x4e2ba0, -0x71a2ec, 0x5f98bc, -0x3ad454, 0x1a3504, -0x6a905, -0xe8e9, 0x1ba79 },
+    { -0x1195a, 0x43db6, -0x87286, 0x91343, 0x2a7b3, -0x24b922, 0x61705d, -0xae7e3a, 0xec2d5c, -0xe5b901, 0x5b8682, 0xeaf33e, -0x30e6408, 0x619ea39, -0xa4d5185, 0x12840245, 0x34a2acb0, 0x1580477, -0x4b74615, 0x4d7cd67, -0x3cfe63f, 0x26a7ed6, -0x121307c, 0x350cbb, 0x4a0569, -0x6f69a5, 0x5ed2e9, -0x3adafd, 0x1a80c7, -0x6ee72, -0xc12f, 0x1ab19 },
+    { -0x11b0d, 0x448f8, -0x89cef, 0x97be7, 0x1eb52, -0x23c106, 0x60ab89, -0xaec95e, 0xeeb8fe, -0xebaa44, 0x65536a, 0xde54b0, -0x3026a51, 0x615dd91, -0xa611170, 0x12f03793, 0x348027b7, 0x10662e1, -0x4903aea, 0x4c7399c, -0x3cc9ef4, 0x26e3b9d, -0x1276b5a, 0x3ae95f, 0x45de7f, -0x6d2a11, 0x5e0622, -0x3adc77, 0x1ac994, -0x73295, -0x99da, 0x19bcb },
+    { -0x11ca4, 0x453f3, -0x8c700, 0x9e4a3, 0x12d4e, -0x22c414, 0x5fdd18, -0xaf05d7, 0xf13384, -0xf18ed9, 0x6f23a7, 0xd193b1, -0x2f61f6d, 0x611464c, -0xa74188f, 0x135c9c6e, 0x345c3126, 0xb5a847, -0x4691452, 0x4b655ea, -0x3c9096d, 0x271bf0f, -0x12d8577, 0x40b981, 0x41b740, -0x6ae46a, 0x5d3284, -0x3ad8ca, 0x1b0f6c, -0x7756c, -0x72eb, 0x18c91 },
+    { -0x11e1d, 0x45ea7, -0x8f0b4, 0xa4d6b, 0x6db3, -0x21c259, 0x5f050e, -0xaf338c, 0xf39ca1, -0xf76631, 0x78f665, 0xc4b12d, -0x2e983fc, 0x60c23fb, -0xa8663df, 0x13c92c01, 0x3436cad8, 0x65d752, -0x441d5a1, 0x4a52427, -0x3c52659, 0x2750925, -0x1337e77, 0x467cb3, 0x3d9007, -0x6898ec, 0x5c582d, -0x3acfff, 0x1b524d, -0x7b6f3, -0x4c67, 0x17d6b },
+    { -0x11f78, 0x46910, -0x91a07, 0xab637, -0x536e, -0x20bbe3, 0x5e236e, -0xaf5263, 0xf5f408, -0xfd2fba, 0x82cad1, 0xb7ae14, -0x2dc98a4, 0x6067635, -0xa97f067, 0x1435e170, 0x340ff6b7, 0x16f298, -0x41a8227, 0x493a62f, -0x3c0f66e, 0x27819dd, -0x1395600, 0x4c3287, 0x396931, -0x6647d3, 0x5b773b, -0x3ac222, 0x1b9239, -0x7f728, -0x264f, 0x16e5b },
+    { -0x120b5, 0x4732d, -0x942f2, 0xb1efe, -0x11609, -0x1fb0c3, 0x5d383c, -0xaf6246, 0xf8396f, -0x102eae3, 0x8ca017, 0xaa8b57, -0x2cf5e14, 0x6003c9f, -0xaa8bb34, 0x14a2b7db, 0x33e7b6c4, -0x37035e, -0x3f31d30, 0x481dde1, -0x3bc7a68, 0x27af13a, -0x13f0bba, 0x51da90, 0x354317, -0x63f159, 0x5a8fcc, -0x3aaf3c, 0x1bcf2e, -0x83607, -0xa5, 0x15f62 },
+    { -0x121d2, 0x47cfb, -0x96b72, 0xb87b5, -0x1da0e, -0x1ea107, 0x5c437f, -0xaf631b, 0xfa6c8a, -0x108971b, 0x96755f, 0x9d49ee, -0x2c1d502, 0x5f976e8, -0xab8c15d, 0x150faa5a, 0x33be0d0d, -0x840818, -0x3cbaa06, 0x46fcd20, -0x3b7b305, 0x27d8f45, -0x1449f53, 0x577464, 0x311e15, -0x6195bc, 0x59a1ff, -0x3a9758, 0x1c092f, -0x8738f, 0x2493, 0x15082 },
+    { -0x122cf, 0x48679, -0x99380, 0xbf052, -0x29f6e, -0x1d8cbf, 0x5b453d, -0xaf54cf, 0xfc8d12, -0x10e33d4, 0xa049d3, 0x8fead3, -0x2b3fe2a, 0x5f224c9, -0xac80000, 0x157cb401, 0x3392fbb8, -0xd0192f, -0x3a42beb, 0x45d75d2, -0x3b2a10c, 0x27ff409, -0x14a107a, 0x5cff99, 0x2cfa85, -0x5f3537, 0x58adf3, -0x3a7a81, 0x1c403a, -0x8afbc, 0x4957, 0x141bc },
+    { -0x123ab, 0x48fa4, -0x9bb18, 0xc58cc, -0x3661a, -0x1c73fd, 0x5a3d7e, -0xaf374d, 0xfe9abd, -0x113c07f, 0xaa1c9a, 0x826f05, -0x2a5da51, 0x5ea4605, -0xad67444, 0x15e9cfe0, 0x336684fa, -0x11b344c, -0x37ca61e, 0x44ad9df, -0x3ad4548, 0x2821f98, -0x14f5ee3, 0x627bca, 0x28d8c1, -0x5cd005, 0x57b3c8, -0x3a58c3, 0x1c7453, -0x8ea8c, 0x6da5, 0x13312 },
+    { -0x12465, 0x4987b, -0x9e235, 0xcc118, -0x42e04, -0x1b56d2, 0x592c49, -0xaf0a82, 0x1009546, -0x1193c8d, 0xb3ecdc, 0x74d785, -0x2976a43, 0x5e1da6d, -0xae41b59, 0x1656f901, 0x3338ab1a, -0x1655729, -0x3551bda, 0x437fb34, -0x3a7a089, 0x2841209, -0x1548a45, 0x67e890, 0x24b920, -0x5a6664, 0x56b39c, -0x3a3229, 0x1ca579, -0x923fd, 0x917b, 0x12484 },
+    { -0x124fc, 0x4a0fb, -0xa08d2, 0xd292d, -0x4f71a, -0x1a354e, 0x5811a9, -0xaece5b, 0x1027c68, -0x11ea770, 0xbdb9bf, 0x67255a, -0x288aed3, 0x5d8e1db, -0xaf0f275, 0x16c42a6c, 0x33097072, -0x1ae7f8f, -0x32d9052, 0x424dbbf, -0x3a1b3a4, 0x285cb75, -0x159925a, 0x6d4588, 0x209bfb, -0x57f88f, 0x55ad92, -0x3a06c0, 0x1cd3af, -0x95c0d, 0xb4d7, 0x11614 },
+    { -0x12571, 0x4a921, -0xa2ee9, 0xd9101, -0x5c14e, -0x190f86, 0x56eda7, -0xae82c9, 0x1044fdf, -0x124009c, 0xc78268, 0x59598c, -0x279a8dc, 0x5cf5c33, -0xafcf6dc, 0x17315f22, 0x32d8d76d, -0x1f6ab58, -0x30606b6, 0x4117d72, -0x39b7f74, 0x2874bfe, -0x15e76de, 0x729250, 0x1c81aa, -0x5586c2, 0x54a1c8, -0x39d694, 0x1cfef6, -0x992ba, 0xd7b6, 0x107c3 },
+    { -0x125c1, 0x4b0ed, -0xa5476, 0xdf888, -0x68c8f, -0x17e58a, 0x55c04f, -0xae27bb, 0x1060f68, -0x1294786, 0xd145fc, 0x4b7528, -0x26a5940, 0x5c54965, -0xb0825d8, 0x179e9223, 0x32a6e289, -0x23dd870, -0x2de8231, 0x3fde240, -0x39504d6, 0x28893c6, -0x1633793, 0x77ce8a, 0x186a83, -0x53113a, 0x53905f, -0x39a1b2, 0x1d2751, -0x9c802, 0xfa16, 0xf991 },
+    { -0x125ed, 0x4b85c, -0xa7973, 0xe5fba, -0x758cc, -0x16b76e, 0x5489ab, -0xadbd24, 0x107bac2, -0x12e7ba1, 0xdb03a0, 0x3d793c, -0x25ac0e7, 0x5baa96e, -0xb127cbc, 0x180bbe69, 0x32739454, -0x28404d4, -0x2b705e6, 0x3ea0c1f, -0x38e44b0, 0x289a2f7, -0x167d43c, 0x7cf9d7, 0x1456dd, -0x509833, 0x52797a, -0x396828, 0x1d4cc2, -0x9fbe4, 0x11bf6, 0xeb82 },
+    { -0x125f3, 0x4bf6c, -0xa9ddc, 0xec68b, -0x825f7, -0x158547, 0x5349ca, -0xad42f6, 0x10951ad, -0x1339c65, 0xe4ba77, 0x2f66de, -0x24ae0c3, 0x5af7c54, -0xb1bf8e8, 0x1878deee, 0x323eef6e, -0x2c92e8f, -0x28f94f4, 0x3d5fd08, -0x3873fea, 0x28a79bf, -0x16c4ca1, 0x8213db, 0x10470c, -0x4e1be9, 0x515d39, -0x392a02, 0x1d6f4b, -0xa2e5d, 0x13d54, 0xdd94 },
+    { -0x125d4, 0x4c61b, -0xac1ab, 0xf2cf2, -0x8f3fd, -0x144f27, 0x5200b8, -0xacb927, 0x10ad3ed, -0x138a948, 0xee69a4, 0x213f21, -0x23ab9ca, 0x5a3c229, -0xb2497c3, 0x18e5eea8, 0x3208f689, -0x30d53bf, -0x2683272, 0x3c1b6f5, -0x37ff771, 0x28b184f, -0x170a08e, 0x871c3c, 0xc3b65, -0x4b9c97, 0x503bbd, -0x38e74f, 0x1d8ef0, -0xa5f6e, 0x15e2d, 0xcfca },
+    { -0x1258d, 0x4cc67, -0xae4db, 0xf92e3, -0x9c2cd, -0x131525, 0x50ae85, -0xac1fac, 0x10c4142, -0x13da1c2, 0xf8104b, 0x130321, -0x22a4cfc, 0x5977b0b, -0xb2c56c0, 0x1952e888, 0x31d1ac66, -0x3507294, -0x240e173, 0x3ad3be0, -0x3786c37, 0x28b7ede, -0x174cfcf, 0x8c12a3, 0x8343c, -0x491a7b, 0x4f1529, -0x38a01d, 0x1dabb3, -0xa8f14, 0x17e81, 0xc224 },
+    { -0x12520, 0x4d24e, -0xb0767, 0xff855, -0xa9258, -0x11d755, 0x4f533f, -0xab767c, 0x10d9974, -0x142854c, 0x101ad8d, 0x4b3fa, -0x2199b5e, 0x58aa722, -0xb33335b, 0x19bfc77f, 0x319913d8, -0x392894c, -0x219a502, 0x3988dc9, -0x3709f31, 0x28bada6, -0x178da37, 0x90f6b9, 0x431e3, -0x4695d0, 0x4de99f, -0x38547b, 0x1dc598, -0xabd4f, 0x19e4d, 0xb4a4 },
+    { -0x1248a, 0x4d7ce, -0xb294b, 0x105d3d, -0xb628a, -0x1095cc, 0x4deef8, -0xaabd8f, 0x10edc47, -0x1475360, 0x10b408d, -0x9ad36, -0x208a5fd, 0x57d46a3, -0xb392b1c, 0x1a2c867e, 0x315f2fc2, -0x3d3963a, -0x1f28024, 0x383aead, -0x368915b, 0x28ba4e9, -0x17cbf9a, 0x95c82a, 0x34ad, -0x440ed2, 0x4cb941, -0x380477, 0x1ddca3, -0xaea1d, 0x1bd90, 0xa74a },
+    { -0x123cb, 0x4dce6, -0xb4a80, 0x10c190, -0xc3354, -0xf50a2, 0x4c81c0, -0xa9f4e0, 0x1100984, -0x14c0b7b, 0x114c86d, -0x181f4c, -0x1f76ded, 0x56f59cd, -0xb3e3b95, 0x1a992070, 0x3124031a, -0x41397be, -0x1cb75d6, 0x36ea08e, -0x36043b3, 0x28b64e9, -0x1807fd0, 0x9a86a5, -0x3c316, -0x4185bc, 0x4b8432, -0x37b020, 0x1df0d7, -0xb157f, 0x1dc48, 0x9a17 },
+    { -0x122e3, 0x4e193, -0xb6b03, 0x112544, -0xd04a2, -0xe07ec, 0x4b0baa, -0xa91c69, 0x11120f4, -0x150ad18, 0x11e444f, -0x26a122, -0x1e5f449, 0x560e0ed, -0xb426264, 0x1b059043, 0x30e790e3, -0x4528c4c, -0x1a48910, 0x359656b, -0x357b73b, 0x28aedee, -0x1841ab7, 0x9f31da, -0x7b514, -0x3efaca, 0x4a4a94, -0x375786, 0x1e0238, -0xb3f72, 0x1fa74, 0x8d0c },
+    { -0x121d1, 0x4e5d3, -0xb8ace, 0x11884e, -0xdd664, -0xcbbc1, 0x498cc9, -0xa83426, 0x1122263, -0x15537b6, 0x127b356, -0x353191, -0x1d43a31, 0x551dc58, -0xb459d30, 0x1b71d0e0, 0x30a9dc32, -0x4907268, -0x17dbcc2, 0x343ff48, -0x34eecfa, 0x28a4046, -0x187902b, 0xa3c97a, -0xba100, -0x3c6e38, 0x490c8a, -0x36fab8, 0x1e10cb, -0xb67f8, 0x21813, 0x802b },
+    { -0x12095, 0x4e9a5, -0xba9db, 0x11eaa4, -0xea887, -0xb6c3a, 0x480531, -0xa73c17, 0x1130d9d, -0x159aad4, 0x13114a3, -0x43cf6f, -0x1c240cf, 0x5424c72, -0xb47e9ad, 0x1bdddd32, 0x306ae82c, -0x4cd48a7, -0x15713d3, 0x32e7027, -0x345e5fc, 0x2895c41, -0x18ae010, 0xa84d3a, -0xf868a, -0x39e03f, 0x47ca38, -0x3699c6, 0x1e1c94, -0xb8f0f, 0x23522, 0x7374 },
+    { -0x11f2d, 0x4ed06, -0xbc827, 0x124c3a, -0xf7af9, -0xa196e, 0x4674f6, -0xa63439, 0x113e270, -0x15e05f3, 0x13a6758, -0x52798e, -0x1b00952, 0x53231a9, -0xb49459c, 0x1c49b022, 0x302ab803, -0x5090db2, -0x1309124, 0x318ba0c, -0x33ca34e, 0x2884234, -0x18e0a4b, 0xacbcd0, -0x136566, -0x37511c, 0x4683c1, -0x3634c1, 0x1e2598, -0xbb4b8, 0x251a2, 0x66e7 },
+    { -0x11d99, 0x4eff6, -0xbe5ad, 0x12ad07, -0x104da8, -0x8c376, 0x44dc2f, -0xa51c8e, 0x114a0ad, -0x1624895, 0x143aa98, -0x612ebe, -0x19d94ef, 0x5218c77, -0xb49aec7, 0x1cb5449b, 0x2fe94efd, -0x543c03f, -0x10a378f, 0x302defa, -0x3332602, 0x286f279, -0x1910ec6, 0xb117f5, -0x173d46, -0x34c109, 0x453947, -0x35cbb9, 0x1e2bdc, -0xbd8f2, 0x26d91, 0x5a86 },
+    { -0x11bd9, 0x4f272, -0xc0266, 0x130d00, -0x112080, -0x76a6a, 0x433af2, -0xa3f517, 0x1154825, -0x166723e, 0x14cdd86, -0x6fedcf, -0x18ae4e3, 0x5105d61, -0xb492306, 0x1d209585, 0x2fa6b06c, -0x57d5f19, -0xe409e6, 0x2ece0f8, -0x3296f2e, 0x2856d6d, -0x193ed6d, 0xb55e64, -0x1b0de0, -0x323041, 0x43eaf0, -0x355ebe, 0x1e2f65, -0xbfbbe, 0x288ee, 0x4e51 },
+    { -0x119ec, 0x4f478, -0xc1e50, 0x136c19, -0x11f371, -0x60e63, 0x419157, -0xa2bdd7, 0x115d8ad, -0x16a8273, 0x155ff44, -0x7eb58c, -0x177fa71, 0x4fea4fa, -0xb47a03c, 0x1d8b9dcb, 0x2f62dfb2, -0x5b5e91a, -0xbe0af1, 0x2d6c208, -0x31f7feb, 0x283b371, -0x196a62f, 0xb98fd8, -0x1ed6e9, -0x2f9efd, 0x4298dd, -0x34ede1, 0x1e3038, -0xc1d1b, 0x2a3b7, 0x4249 },
+    { -0x117d1, 0x4f606, -0xc3963, 0x13ca49, -0x12c665, -0x4af7d, 0x3fdf75, -0xa176d4, 0x1165219, -0x16e78bb, 0x15f0ef6, -0x8d84be, -0x164d6e3, 0x4ec63de, -0xb45245a, 0x1df65858, 0x2f1de040, -0x5ed5d2e, -0x983d71, 0x2c0842f, -0x3155956, 0x281c4eb, -0x1993900, 0xbdac11, -0x229818, -0x2d0d77, 0x414334, -0x347934, 0x1e2e5b, -0xc3d0b, 0x2bdec, 0x366f },
+    { -0x11588, 0x4f71c, -0xc539d, 0x142784, -0x13994c, -0x34dd0, 0x3e2567, -0xa02014, 0x116b440, -0x172549f, 0x1680bc0, -0x9c5a2e, -0x1517b87, 0x4d99ab7, -0xb41ad5c, 0x1e60c018, 0x2ed7b595, -0x623ba54, -0x72a420, 0x2aa2971, -0x30afc8f, 0x27fa244, -0x19ba5d5, 0xc1b2cf, -0x265125, -0x2a7be9, 0x3fea18, -0x3400c8, 0x1e29d4, -0xc5b8d, 0x2d78c, 0x2ac4 },
+    { -0x11311, 0x4f7b7, -0xc6cf8, 0x1483bf, -0x146c11, -0x1e978, 0x3c6347, -0x9eb99f, 0x116fefc, -0x17615a8, 0x170f4c6, -0xab349f, -0x13de9b6, 0x4c64a39, -0xb3d394b, 0x1ecacff9, 0x2e906341, -0x658ff9a, -0x4d41af, 0x293b3d3, -0x3006ab8, 0x27d4bea, -0x19deca9, 0xc5a3d7, -0x2a01c8, -0x27ea8d, 0x3e8dad, -0x3384af, 0x1e22a9, -0xc78a2, 0x2f096, 0x1f47 },
+    { -0x1106a, 0x4f7d5, -0xc856f, 0x14def1, -0x153ea1, -0x8290, 0x3a992f, -0x9d437c, 0x1173227, -0x179bb64, 0x179c92f, -0xba12d7, -0x12a22cb, 0x4b27326, -0xb37c63e, 0x1f3482e8, 0x2e47ece0, -0x68d2c20, -0x2818c4, 0x27d2557, -0x2f5a4f7, 0x27ac24e, -0x1a00d79, 0xc97eec, -0x2da9bc, -0x25599a, 0x3d2e16, -0x3304fa, 0x1e18e0, -0xc944c, 0x3090a, 0x13fa },
+    { -0x10d94, 0x4f776, -0xc9cfe, 0x15390e, -0x1610e9, 0xe6ce, 0x38c73c, -0x9bbdb7, 0x1174d9d, -0x17d455f, 0x182881e, -0xc8f397, -0x1162828, 0x49e1649, -0xb315258, 0x1f9dd3d8, 0x2dfe561c, -0x6c03f18, -0x32bfe, 0x2668000, -0x2eaac76, 0x27805e5, -0x1a20844, 0xcd43d7, -0x3148bb, -0x22c94a, 0x3bcb79, -0x3281bb, 0x1e0c7f, -0xcae8a, 0x320e6, 0x8de },
+    { -0x10a8e, 0x4f697, -0xcb3a0, 0x15920b, -0x16e2d5, 0x25285, 0x36ed8a, -0x9a285c, 0x117513f, -0x180b329, 0x18b30bd, -0xd7d59f, -0x101fb38, 0x489347a, -0xb29dbca, 0x2006bdba, 0x2db3a2ad, -0x6f237c6, 0x21820b, 0x24fc5d0, -0x2df825f, 0x2751728, -0x1a3dd0e, 0xd0f261, -0x34de83, -0x2039d5, 0x3a65f9, -0x31fb05, 0x1dfd8d, -0xcc75f, 0x3382a, -0x20f },
+    { -0x10757, 0x4f537, -0xcc951, 0x15e9df, -0x17b452, 0x3c078, 0x350c36, -0x988377, 0x1173ceb, -0x1840454, 0x193c231, -0xe6b7ae, -0xed9d67, 0x473ce9f, -0xb2160d2, 0x206f3b86, 0x2d67d659, -0x723157d, 0x45eecb, 0x238f8c8, -0x2d427e2, 0x271f694, -0x1a58bdf, 0xd48a56, -0x386acf, -0x1dab72, 0x38fdba, -0x3170e9, 0x1dec11, -0xcdecb, 0x34ed6, -0xcc9 },
+    { -0x103ef, 0x4f354, -0xcde0b, 0x16407d, -0x18854c, 0x5308c, 0x332361, -0x96cf18, 0x1171084, -0x1873873, 0x19c3ba3, -0xf59880, -0xd9102c, 0x45de5a8, -0xb17dfbb, 0x20d74834, 0x2d1af4f4, -0x752d7a4, 0x6a17be, 0x2221ae7, -0x2c89e2f, 0x26ea4a9, -0x1a714be, 0xd80b84, -0x3bed60, -0x1b1e58, 0x3792e0, -0x30e37b, 0x1dd811, -0xcf4cf, 0x364e9, -0x1752 },
+    { -0x10056, 0x4f0ed, -0xcf1cb, 0x1695dd, -0x1955b0, 0x6a2a4, 0x313327, -0x950b4f, 0x116cbee, -0x18a4f1b, 0x1a49c3e, -0x10476d0, -0xc45501, 0x4477a8f, -0xb0d56e0, 0x213edec0, 0x2ccd025e, -0x7817db2, 0x8dfa68, 0x20b2e2c, -0x2bce67b, 0x26b21ea, -0x1a877bb, 0xdb75bc, -0x3f65f5, -0x1892bf, 0x362590, -0x3052cd, 0x1dc195, -0xd096d, 0x37a63, -0x21a9 },
+    { -0xfc8a, 0x4ee01, -0xd048c, 0x16e9f2, -0x1a2569, 0x816a1, 0x2f3bab, -0x93382d, 0x1166f11, -0x18d47e5, 0x1ace32b, -0x1135159, -0xaf6d65, 0x4308e5c, -0xb01c4a8, 0x21a5fa28, 0x2c7e0284, -0x7af072f, 0xb1945a, 0x1f43493, -0x2b101f9, 0x2676ede, -0x1a9b4e4, 0xdec8d0, -0x42d44f, -0x1608de, 0x34b5ed, -0x2fbef2, 0x1da8a3, -0xd1ca6, 0x38f43, -0x2bce },
+    { -0xf88d, 0x4ea8e, -0xd164a, 0x173cb3, -0x1af464, 0x98c66, 0x2d3d0d, -0x9155c6, 0x115f9d3, -0x1902269, 0x1b50f97, -0x12226d4, -0x9a5ae0, 0x4192224, -0xaf52788, 0x220c9571, 0x2c2df960, -0x7db73b4, 0xd4e32b, 0x1dd3019, -0x2a4f1e4, 0x2638c12, -0x1aacc4e, 0xe20495, -0x46382f, -0x1380e9, 0x33441d, -0x2f27fd, 0x1d8d45, -0xd2e7c, 0x3a38a, -0x35bf },
+    { -0xf45d, 0x4e692, -0xd2700, 0x178e14, -0x1bc28c, 0xb03d5, 0x2b376e, -0x8f642d, 0x1156c1f, -0x192de43, 0x1bd20af, -0x130f5f8, -0x851efc, 0x4013705, -0xae77e05, 0x2272aba0, 0x2bdceaf8, -0x806c2ec, 0xf7e47d, 0x1c622b5, -0x298b775, 0x25f7a12, -0x1abbe0f, 0xe528e1, -0x49915a, -0x10fb16, 0x31d042, -0x2e8e02, 0x1d6f80, -0xd3ef1, 0x3b736, -0x3f7d },
+    { -0xeffa, 0x4e20d, -0xd36aa, 0x17de0d, -0x1c8fcd, 0xc7cd0, 0x292af2, -0x8d637a, 0x114c5e2, -0x1957b11, 0x1c515a2, -0x13fbd7d, -0x6fbb4a, 0x3e8ce2a, -0xad8c6b1, 0x22d837c2, 0x2b8adb5f, -0x830f494, 0x11a95fd, 0x1af0e61, -0x28c53e8, 0x25b3970, -0x1ac8a40, 0xe8358f, -0x4cdf95, -0xe779b, 0x305a81, -0x2df112, 0x1d4f5d, -0xd4e07, 0x3ca48, -0x4907 },
+    { -0xeb64, 0x4dcfe, -0xd4543, 0x182c91, -0x1d5c14, 0xdf738, 0x2717bb, -0x8b53c2, 0x1140709, -0x197f873, 0x1cced9f, -0x14e7c17, -0x5a3160, 0x3cfe8ca, -0xac9002c, 0x233d34e6, 0x2b37ceb4, -0x85a0879, 0x13cf55e, 0x197f511, -0x27fc87c, 0x256cac1, -0x1ad30ff, 0xeb2a78, -0x5022a4, -0xbf6ac, 0x2ee2fe, -0x2d5143, 0x1d2ce4, -0xd5bbf, 0x3dcc0, -0x525d },
+    { -0xe69a, 0x4d762, -0xd52c9, 0x187996, -0x1e274b, 0xf72ed, 0x24fdef, -0x89351f, 0x1132f85, -0x19a560b, 0x1d4a7d7, -0x15d307c, -0x4482db, 0x3b68828, -0xab82927, 0x23a19e23, 0x2ae3c91f, -0x881fe78, 0x15f0062, 0x180d8b9, -0x2731670, 0x2522e9d, -0x1adb26b, 0xee077c, -0x535a51, -0x9787d, 0x2d69dd, -0x2caea7, 0x1d081d, -0xd681c, 0x3ee9e, -0x5b80 },
+    { -0xe19d, 0x4d139, -0xd5f36, 0x18c513, -0x1ef160, 0x10efd1, 0x22ddb2, -0x8707ac, 0x1123f48, -0x19c937e, 0x1dc437e, -0x16bd960, -0x2eb15b, 0x39cad90, -0xaa6405f, 0x24056e91, 0x2a8eced7, -0x8a8d682, 0x180b4d2, 0x169bb4a, -0x2663f07, 0x24d659f, -0x1ae0ea7, 0xf0cc7a, -0x568662, -0x6fd41, 0x2bef41, -0x2c0952, 0x1ce10f, -0xd7320, 0x3ffe1, -0x646d },
+    { -0xdc6b, 0x4ca82, -0xd6a86, 0x190efc, -0x1fba3c, 0x126dc3, 0x20b729, -0x84cb83, 0x1113648, -0x19eb072, 0x1e3bfc9, -0x17a7577, -0x18be85, 0x3825a5e, -0xa9344a3, 0x2468a152, 0x2a38e41c, -0x8ce9095, 0x1a21083, 0x1529eb2, -0x2594385, 0x2487065, -0x1ae45da, 0xf37954, -0x59a6a2, -0x4852b, 0x2a734f, -0x2b6159, 0x1cb7c4, -0xd7cce, 0x4108a, -0x6d26 },
+    { -0xd705, 0x4c33b, -0xd74b6, 0x195749, -0x2081cc, 0x13eca4, 0x1e8a7d, -0x8280c2, 0x1101479, -0x1a0ac91, 0x1eb1bed, -0x1890374, -0x2ac05, 0x3678ff6, -0xa7f34cf, 0x24cb318a, 0x29e20d39, -0x8f32cc4, 0x1c31152, 0x13b84dd, -0x24c252c, 0x2434f91, -0x1ae582b, 0xf60dee, -0x5cbadd, -0x2106d, 0x28f62a, -0x2ab6ce, 0x1c8c44, -0xd8527, 0x4209a, -0x75aa },
+    { -0xd16b, 0x4bb64, -0xd7dc2, 0x199dee, -0x2147fc, 0x156c53, 0x1c57d3, -0x802788, 0x10ed9d5, -0x1a28786, 0x1f25723, -0x1978209, 0x138477, 0x34c4fca, -0xa6a0fcf, 0x252d1a65, 0x298a4e85, -0x916ab31, 0x1e3b528, 0x1246fb5, -0x23ee545, 0x23e03c7, -0x1ae45c7, 0xf88a2f, -0x5fc2de, 0x60c6, 0x2777f5, -0x2a09c6, 0x1c5e98, -0xd8c2e, 0x4300f, -0x7df9 },
+    { -0xcb9b, 0x4b2fb, -0xd85a6, 0x19e2e1, -0x220cb7, 0x16ecaf, 0x1a1f55, -0x7dbff5, 0x10d8657, -0x1a440ff, 0x1f970a5, -0x1a5efe9, 0x29d13a, 0x3309b55, -0xa53d49e, 0x258e5717, 0x2931ac5f, -0x9390c0d, 0x203f9fa, 0x10d611f, -0x2318517, 0x2388dad, -0x1ae0edd, 0xfaee00, -0x62be74, 0x2ce3f, 0x25f8d3, -0x295a54, 0x1c2ec8, -0xd91e6, 0x43eeb, -0x8613 },
+    { -0xc597, 0x4aa00, -0xd8c5e, 0x1a2618, -0x22cfe8, 0x186d98, 0x17e12a, -0x7b4a2a, 0x10c19fb, -0x1a5d8ad, 0x20067af, -0x1b44bc6, 0x40388c, 0x3147421, -0xa3c8247, 0x25eee2d7, 0x28d82b33, -0x95a4f9d, 0x223ddc4, 0xf65afe, -0x22405e9, 0x232eded, -0x1adb39e, 0xfd394c, -0x65ad6d, 0x537cb, 0x2478e9, -0x28a88e, 0x1bfcdd, -0xd9652, 0x44d2f, -0x8df7 },
+    { -0xbf5e, 0x4a072, -0xd91e7, 0x1a678a, -0x23917c, 0x19eeed, 0x159d7e, -0x78c649, 0x10a94c1, -0x1a74e42, 0x2073b7e, -0x1c29453, 0x56b8af, 0x2f7dbbf, -0xa2417e4, 0x264eb8e6, 0x287dcf73, -0x97a7635, 0x2435e90, 0xdf5f32, -0x2166906, 0x22d2535, -0x1ad343f, 0xff6c00, -0x688f9b, 0x79d3d, 0x22f859, -0x27f487, 0x1bc8e1, -0xd9975, 0x45ad9, -0x95a6 },
+    { -0xb8ef, 0x4964f, -0xd963c, 0x1aa72d, -0x24515d, 0x1b708b, 0x13547a, -0x763477, 0x108f6aa, -0x1a8a176, 0x20deb54, -0x1d0c840, 0x6d4fe2, 0x2dad3cf, -0xa0a94a0, 0x26add48b, 0x28229d9f, -0x9998039, 0x2627a71, 0xc86f98, -0x208afb8, 0x2273433, -0x1ac90f7, 0x101860c, -0x6b64d0, 0x9fe63, 0x217745, -0x273e53, 0x1b92dc, -0xd9b50, 0x467ec, -0x9d20 },
+    { -0xb24c, 0x48b97, -0xd995b, 0x1ae4f7, -0x250f78, 0x1cf252, 0x110649, -0x7394db, 0x1073fb8, -0x1a9d1ff, 0x2147671, -0x1dee642, 0x83fc5e, 0x2bd5dfb, -0x9eff7b5, 0x270c3116, 0x27c69a3c, -0x9b76e1f, 0x2812f86, 0xb18e09, -0x1fadb4a, 0x2211b99, -0x1abca01, 0x1038761, -0x6e2cde, 0xc5b11, 0x1ff5d1, -0x268607, 0x1b5ad7, -0xd9be9, 0x47466, -0xa464 },
+    { -0xab72, 0x4804a, -0xd9b41, 0x1b20dd, -0x25cbb7, 0x1e741f, 0xeb317, -0x70e79a, 0x1056ff3, -0x1aadf99, 0x21adc1b, -0x1eced0a, 0x9abc5b, 0x29f7bf7, -0x9d4406b, 0x2769c9db, 0x2769c9db, -0x9d4406b, 0x29f7bf7, 0x9abc5b, -0x1eced0a, 0x21adc1b, -0x1aadf99, 0x1056ff3, -0x70e79a, 0xeb317, 0x1e741f, -0x25cbb7, 0x1b20dd, -0xd9b41, 0x4804a, -0xab72 },
+    { -0xa464, 0x47466, -0xd9be9, 0x1b5ad7, -0x268607, 0x1ff5d1, 0xc5b11, -0x6e2cde, 0x1038761, -0x1abca01, 0x2211b99, -0x1fadb4a, 0xb18e09, 0x2812f86, -0x9b76e1f, 0x27c69a3c, 0x270c3116, -0x9eff7b5, 0x2bd5dfb, 0x83fc5e, -0x1dee642, 0x2147671, -0x1a9d1ff, 0x1073fb8, -0x7394db, 0x110649, 0x1cf252, -0x250f78, 0x1ae4f7, -0xd995b, 0x48b97, -0xb24c },
+    { -0x9d20, 0x467ec, -0xd9b50, 0x1b92dc, -0x273e53, 0x217745, 0x9fe63, -0x6b64d0, 0x101860c, -0x1ac90f7, 0x2273433, -0x208afb8, 0xc86f98, 0x2627a71, -0x9998039, 0x28229d9f, 0x26add48b, -0xa0a94a0, 0x2dad3cf, 0x6d4fe2, -0x1d0c840, 0x20deb54, -0x1a8a176, 0x108f6aa, -0x763477, 0x13547a, 0x1b708b, -0x24515d, 0x1aa72d, -0xd963c, 0x4964f, -0xb8ef },
+    { -0x95a6, 0x45ad9, -0xd9975, 0x1bc8e1, -0x27f487, 0x22f859, 0x79d3d, -0x688f9b, 0xff6c00, -0x1ad343f, 0x22d2535, -0x2166906, 0xdf5f32, 0x2435e90, -0x97a7635, 0x287dcf73, 0x264eb8e6, -0xa2417e4, 0x2f7dbbf, 0x56b8af, -0x1c29453, 0x2073b7e, -0x1a74e42, 0x10a94c1, -0x78c649, 0x159d7e, 0x19eeed, -0x23917c, 0x1a678a, -0xd91e7, 0x4a072, -0xbf5e },
+    { -0x8df7, 0x44d2f, -0xd9652, 0x1bfcdd, -0x28a88e, 0x2478e9, 0x537cb, -0x65ad6d, 0xfd394c, -0x1adb39e, 0x232eded, -0x22405e9, 0xf65afe, 0x223ddc4, -0x95a4f9d, 0x28d82b33, 0x25eee2d7, -0xa3c8247, 0x3147421, 0x40388c, -0x1b44bc6, 0x20067af, -0x1a5d8ad, 0x10c19fb, -0x7b4a2a, 0x17e12a, 0x186d98, -0x22cfe8, 0x1a2618, -0xd8c5e, 0x4aa00, -0xc597 },
+    { -0x8613, 0x43eeb, -0xd91e6, 0x1c2ec8, -0x295a54, 0x25f8d3, 0x2ce3f, -0x62be74, 0xfaee00, -0x1ae0edd, 0x2388dad, -0x2318517, 0x10d611f, 0x203f9fa, -0x9390c0d, 0x2931ac5f, 0x258e5717, -0xa53d49e, 0x3309b55, 0x29d13a, -0x1a5efe9, 0x1f970a5, -0x1a440ff, 0x10d8657, -0x7dbff5, 0x1a1f55, 0x16ecaf, -0x220cb7, 0x19e2e1, -0xd85a6, 0x4b2fb, -0xcb9b },
+    { -0x7df9, 0x4300f, -0xd8c2e, 0x1c5e98, -0x2a09c6, 0x2777f5, 0x60c6, -0x5fc2de, 0xf88a2f, -0x1ae45c7, 0x23e03c7, -0x23ee545, 0x1246fb5, 0x1e3b528, -0x916ab31, 0x298a4e85, 0x252d1a65, -0xa6a0fcf, 0x34c4fca, 0x138477, -0x1978209, 0x1f25723, -0x1a28786, 0x10ed9d5, -0x802788, 0x1c57d3, 0x156c53, -0x2147fc, 0x199dee, -0xd7dc2, 0x4bb64, -0xd16b },
+    { -0x75aa, 0x4209a, -0xd8527, 0x1c8c44, -0x2ab6ce, 0x28f62a, -0x2106d, -0x5cbadd, 0xf60dee, -0x1ae582b, 0x2434f91, -0x24c252c, 0x13b84dd, 0x1c31152, -0x8f32cc4, 0x29e20d39, 0x24cb318a, -0xa7f34cf, 0x3678ff6, -0x2ac05, -0x1890374, 0x1eb1bed, -0x1a0ac91, 0x1101479, -0x8280c2, 0x1e8a7d, 0x13eca4, -0x2081cc, 0x195749, -0xd74b6, 0x4c33b, -0xd705 },
+    { -0x6d26, 0x4108a, -0xd7cce, 0x1cb7c4, -0x2b6159, 0x2a734f, -0x4852b, -0x59a6a2, 0xf37954, -0x1ae45da, 0x2487065, -0x2594385, 0x1529eb2, 0x1a21083, -0x8ce9095, 0x2a38e41c, 0x2468a152, -0xa9344a3, 0x3825a5e, -0x18be85, -0x17a7577, 0x1e3bfc9, -0x19eb072, 0x1113648, -0x84cb83, 0x20b729, 0x126dc3, -0x1fba3c, 0x190efc, -0xd6a86, 0x4ca82, -0xdc6b },
+    { -0x646d, 0x3ffe1, -0xd7320, 0x1ce10f, -0x2c0952, 0x2bef41, -0x6fd41, -0x568662, 0xf0cc7a, -0x1ae0ea7, 0x24d659f, -0x2663f07, 0x169bb4a, 0x180b4d2, -0x8a8d682, 0x2a8eced7, 0x24056e91, -0xaa6405f, 0x39cad90, -0x2eb15b, -0x16bd960, 0x1dc437e, -0x19c937e, 0x1123f48, -0x8707ac, 0x22ddb2, 0x10efd1, -0x1ef160, 0x18c513, -0xd5f36, 0x4d139, -0xe19d },
+    { -0x5b80, 0x3ee9e, -0xd681c, 0x1d081d, -0x2caea7, 0x2d69dd, -0x9787d, -0x535a51, 0xee077c, -0x1adb26b, 0x2522e9d, -0x2731670, 0x180d8b9, 0x15f0062, -0x881fe78, 0x2ae3c91f, 0x23a19e23, -0xab82927, 0x3b68828, -0x4482db, -0x15d307c, 0x1d4a7d7, -0x19a560b, 0x1132f85, -0x89351f, 0x24fdef, 0xf72ed, -0x1e274b, 0x187996, -0xd52c9, 0x4d762, -0xe69a },
+    { -0x525d, 0x3dcc0, -0xd5bbf, 0x1d2ce4, -0x2d5143, 0x2ee2fe, -0xbf6ac, -0x5022a4, 0xeb2a78, -0x1ad30ff, 0x256cac1, -0x27fc87c, 0x197f511, 0x13cf55e, -0x85a0879, 0x2b37ceb4, 0x233d34e6, -0xac9002c, 0x3cfe8ca, -0x5a3160, -0x14e7c17, 0x1cced9f, -0x197f873, 0x1140709, -0x8b53c2, 0x2717bb, 0xdf738, -0x1d5c14, 0x182c91, -0xd4543, 0x4dcfe, -0xeb64 },
+    { -0x4907, 0x3ca48, -0xd4e07, 0x1d4f5d, -0x2df112, 0x305a81, -0xe779b, -0x4cdf95, 0xe8358f, -0x1ac8a40, 0x25b3970, -0x28c53e8, 0x1af0e61, 0x11a95fd, -0x830f494, 0x2b8adb5f, 0x22d837c2, -0xad8c6b1, 0x3e8ce2a, -0x6fbb4a, -0x13fbd7d, 0x1c515a2, -0x1957b11, 0x114c5e2, -0x8d637a, 0x292af2, 0xc7cd0, -0x1c8fcd, 0x17de0d, -0xd36aa, 0x4e20d, -0xeffa },
+    { -0x3f7d, 0x3b736, -0xd3ef1, 0x1d6f80, -0x2e8e02, 0x31d042, -0x10fb16, -0x49915a, 0xe528e1, -0x1abbe0f, 0x25f7a12, -0x298b775, 0x1c622b5, 0xf7e47d, -0x806c2ec, 0x2bdceaf8, 0x2272aba0, -0xae77e05, 0x4013705, -0x851efc, -0x130f5f8, 0x1bd20af, -0x192de43, 0x1156c1f, -0x8f642d, 0x2b376e, 0xb03d5, -0x1bc28c, 0x178e14, -0xd2700, 0x4e692, -0xf45d },
+    { -0x35bf, 0x3a38a, -0xd2e7c, 0x1d8d45, -0x2f27fd, 0x33441d, -0x1380e9, -0x46382f, 0xe20495, -0x1aacc4e, 0x2638c12, -0x2a4f1e4, 0x1dd3019, 0xd4e32b, -0x7db73b4, 0x2c2df960, 0x220c9571, -0xaf52788, 0x4192224, -0x9a5ae0, -0x12226d4, 0x1b50f97, -0x1902269, 0x115f9d3, -0x9155c6, 0x2d3d0d, 0x98c66, -0x1af464, 0x173cb3, -0xd164a, 0x4ea8e, -0xf88d },
+    { -0x2bce, 0x38f43, -0xd1ca6, 0x1da8a3, -0x2fbef2, 0x34b5ed, -0x1608de, -0x42d44f, 0xdec8d0, -0x1a9b4e4, 0x2676ede, -0x2b101f9, 0x1f43493, 0xb1945a, -0x7af072f, 0x2c7e0284, 0x21a5fa28, -0xb01c4a8, 0x4308e5c, -0xaf6d65, -0x1135159, 0x1ace32b, -0x18d47e5, 0x1166f11, -0x93382d, 0x2f3bab, 0x816a1, -0x1a2569, 0x16e9f2, -0xd048c, 0x4ee01, -0xfc8a },
+    { -0x21a9, 0x37a63, -0xd096d, 0x1dc195, -0x3052cd, 0x362590, -0x1892bf, -0x3f65f5, 0xdb75bc, -0x1a877bb, 0x26b21ea, -0x2bce67b, 0x20b2e2c, 0x8dfa68, -0x7817db2, 0x2ccd025e, 0x213edec0, -0xb0d56e0, 0x4477a8f, -0xc45501, -0x10476d0, 0x1a49c3e, -0x18a4f1b, 0x116cbee, -0x950b4f, 0x313327, 0x6a2a4, -0x1955b0, 0x1695dd, -0xcf1cb, 0x4f0ed, -0x10056 },
+    { -0x1752, 0x364e9, -0xcf4cf, 0x1dd811, -0x30e37b, 0x3792e0, -0x1b1e58, -0x3bed60, 0xd80b84, -0x1a714be, 0x26ea4a9, -0x2c89e2f, 0x2221ae7, 0x6a17be, -0x752d7a4, 0x2d1af4f4, 0x20d74834, -0xb17dfbb, 0x45de5a8, -0xd9102c, -0xf59880, 0x19c3ba3, -0x1873873, 0x1171084, -0x96cf18, 0x332361, 0x5308c, -0x18854c, 0x16407d, -0xcde0b, 0x4f354, -0x103ef },
+    { -0xcc9, 0x34ed6, -0xcdecb, 0x1dec11, -0x3170e9, 0x38fdba, -0x1dab72, -0x386acf, 0xd48a56, -0x1a58bdf, 0x271f694, -0x2d427e2, 0x238f8c8, 0x45eecb, -0x723157d, 0x2d67d659, 0x206f3b86, -0xb2160d2, 0x473ce9f, -0xed9d67, -0xe6b7ae, 0x193c231, -0x1840454, 0x1173ceb, -0x988377, 0x350c36, 0x3c078, -0x17b452, 0x15e9df, -0xcc951, 0x4f537, -0x10757 },
+    { -0x20f, 0x3382a, -0xcc75f, 0x1dfd8d, -0x31fb05, 0x3a65f9, -0x2039d5, -0x34de83, 0xd0f261, -0x1a3dd0e, 0x2751728, -0x2df825f, 0x24fc5d0, 0x21820b, -0x6f237c6, 0x2db3a2ad, 0x2006bdba, -0xb29dbca, 0x489347a, -0x101fb38, -0xd7d59f, 0x18b30bd, -0x180b329, 0x117513f, -0x9a285c, 0x36ed8a, 0x25285, -0x16e2d5, 0x15920b, -0xcb3a0, 0x4f697, -0x10a8e },
+    { 0x8de, 0x320e6, -0xcae8a, 0x1e0c7f, -0x3281bb, 0x3bcb79, -0x22c94a, -0x3148bb, 0xcd43d7, -0x1a20844, 0x27805e5, -0x2eaac76, 0x2668000, -0x32bfe, -0x6c03f18, 0x2dfe561c, 0x1f9dd3d8, -0xb315258, 0x49e1649, -0x1162828, -0xc8f397, 0x182881e, -0x17d455f, 0x1174d9d, -0x9bbdb7, 0x38c73c, 0xe6ce, -0x1610e9, 0x15390e, -0xc9cfe, 0x4f776, -0x10d94 },
+    { 0x13fa, 0x3090a, -0xc944c, 0x1e18e0, -0x3304fa, 0x3d2e16, -0x25599a, -0x2da9bc, 0xc97eec, -0x1a00d79, 0x27ac24e, -0x2f5a4f7, 0x27d2557, -0x2818c4, -0x68d2c20, 0x2e47ece0, 0x1f3482e8, -0xb37c63e, 0x4b27326, -0x12a22cb, -0xba12d7, 0x179c92f, -0x179bb64, 0x1173227, -0x9d437c, 0x3a992f, -0x8290, -0x153ea1, 0x14def1, -0xc856f, 0x4f7d5, -0x1106a },
+    { 0x1f47, 0x2f096, -0xc78a2, 0x1e22a9, -0x3384af, 0x3e8dad, -0x27ea8d, -0x2a01c8, 0xc5a3d7, -0x19deca9, 0x27d4bea, -0x3006ab8, 0x293b3d3, -0x4d41af, -0x658ff9a, 0x2e906341, 0x1ecacff9, -0xb3d394b, 0x4c64a39, -0x13de9b6, -0xab349f, 0x170f4c6, -0x17615a8, 0x116fefc, -0x9eb99f, 0x3c6347, -0x1e978, -0x146c11, 0x1483bf, -0xc6cf8, 0x4f7b7, -0x11311 },
+    { 0x2ac4, 0x2d78c, -0xc5b8d, 0x1e29d4, -0x3400c8, 0x3fea18, -0x2a7be9, -0x265125, 0xc1b2cf, -0x19ba5d5, 0x27fa244, -0x30afc8f, 0x2aa2971, -0x72a420, -0x623ba54, 0x2ed7b595, 0x1e60c018, -0xb41ad5c, 0x4d99ab7, -0x1517b87, -0x9c5a2e, 0x1680bc0, -0x172549f, 0x116b440, -0xa02014, 0x3e2567, -0x34dd0, -0x13994c, 0x142784, -0xc539d, 0x4f71c, -0x11588 },
+    { 0x366f, 0x2bdec, -0xc3d0b, 0x1e2e5b, -0x347934, 0x414334, -0x2d0d77, -0x229818, 0xbdac11, -0x1993900, 0x281c4eb, -0x3155956, 0x2c0842f, -0x983d71, -0x5ed5d2e, 0x2f1de040, 0x1df65858, -0xb45245a, 0x4ec63de, -0x164d6e3, -0x8d84be, 0x15f0ef6, -0x16e78bb, 0x1165219, -0xa176d4, 0x3fdf75, -0x4af7d, -0x12c665, 0x13ca49, -0xc3963, 0x4f606, -0x117d1 },
+    { 0x4249, 0x2a3b7, -0xc1d1b, 0x1e3038, -0x34ede1, 0x4298dd, -0x2f9efd, -0x1ed6e9, 0xb98fd8, -0x196a62f, 0x283b371, -0x31f7feb, 0x2d6c208, -0xbe0af1, -0x5b5e91a, 0x2f62dfb2, 0x1d8b9dcb, -0xb47a03c, 0x4fea4fa, -0x177fa71, -0x7eb58c, 0x155ff44, -0x16a8273, 0x115d8ad, -0xa2bdd7, 0x419157, -0x60e63, -0x11f371, 0x136c19, -0xc1e50, 0x4f478, -0x119ec },
+    { 0x4e51, 0x288ee, -0xbfbbe, 0x1e2f65, -0x355ebe, 0x43eaf0, -0x323041, -0x1b0de0, 0xb55e64, -0x193ed6d, 0x2856d6d, -0x3296f2e, 0x2ece0f8, -0xe409e6, -0x57d5f19, 0x2fa6b06c, 0x1d209585, -0xb492306, 0x5105d61, -0x18ae4e3, -0x6fedcf, 0x14cdd86, -0x166723e, 0x1154825, -0xa3f517, 0x433af2, -0x76a6a, -0x112080, 0x130d00, -0xc0266, 0x4f272, -0x11bd9 },
+    { 0x5a86, 0x26d91, -0xbd8f2, 0x1e2bdc, -0x35cbb9, 0x453947, -0x34c109, -0x173d46, 0xb117f5, -0x1910ec6, 0x286f279, -0x3332602, 0x302defa, -0x10a378f, -0x543c03f, 0x2fe94efd, 0x1cb5449b, -0xb49aec7, 0x5218c77, -0x19d94ef, -0x612ebe, 0x143aa98, -0x1624895, 0x114a0ad, -0xa51c8e, 0x44dc2f, -0x8c376, -0x104da8, 0x12ad07, -0xbe5ad, 0x4eff6, -0x11d99 },
+    { 0x66e7, 0x251a2, -0xbb4b8, 0x1e2598, -0x3634c1, 0x4683c1, -0x37511c, -0x136566, 0xacbcd0, -0x18e0a4b, 0x2884234, -0x33ca34e, 0x318ba0c, -0x1309124, -0x5090db2, 0x302ab803, 0x1c49b022, -0xb49459c, 0x53231a9, -0x1b00952, -0x52798e, 0x13a6758, -0x15e05f3, 0x113e270, -0xa63439, 0x4674f6, -0xa196e, -0xf7af9, 0x124c3a, -0xbc827, 0x4ed06, -0x11f2d },
+    { 0x7374, 0x23522, -0xb8f0f, 0x1e1c94, -0x3699c6, 0x47ca38, -0x39e03f, -0xf868a, 0xa84d3a, -0x18ae010, 0x2895c41, -0x345e5fc, 0x32e7027, -0x15713d3, -0x4cd48a7, 0x306ae82c, 0x1bdddd32, -0xb47e9ad, 0x5424c72, -0x1c240cf, -0x43cf6f, 0x13114a3, -0x159aad4, 0x1130d9d, -0xa73c17, 0x480531, -0xb6c3a, -0xea887, 0x11eaa4, -0xba9db, 0x4e9a5, -0x12095 },
+    { 0x802b, 0x21813, -0xb67f8, 0x1e10cb, -0x36fab8, 0x490c8a, -0x3c6e38, -0xba100, 0xa3c97a, -0x187902b, 0x28a4046, -0x34eecfa, 0x343ff48, -0x17dbcc2, -0x4907268, 0x30a9dc32, 0x1b71d0e0, -0xb459d30, 0x551dc58, -0x1d43a31, -0x353191, 0x127b356, -0x15537b6, 0x1122263, -0xa83426, 0x498cc9, -0xcbbc1, -0xdd664, 0x11884e, -0xb8ace, 0x4e5d3, -0x121d1 },
+    { 0x8d0c, 0x1fa74, -0xb3f72, 0x1e0238, -0x375786, 0x4a4a94, -0x3efaca, -0x7b514, 0x9f31da, -0x1841ab7, 0x28aedee, -0x357b73b, 0x359656b, -0x1a48910, -0x4528c4c, 0x30e790e3, 0x1b059043, -0xb426264, 0x560e0ed, -0x1e5f449, -0x26a122, 0x11e444f, -0x150ad18, 0x11120f4, -0xa91c69, 0x4b0baa, -0xe07ec, -0xd04a2, 0x112544, -0xb6b03, 0x4e193, -0x122e3 },
+    { 0x9a17, 0x1dc48, -0xb157f, 0x1df0d7, -0x37b020, 0x4b8432, -0x4185bc, -0x3c316, 0x9a86a5, -0x1807fd0, 0x28b64e9, -0x36043b3, 0x36ea08e, -0x1cb75d6, -0x41397be, 0x3124031a, 0x1a992070, -0xb3e3b95, 0x56f59cd, -0x1f76ded, -0x181f4c, 0x114c86d, -0x14c0b7b, 0x1100984, -0xa9f4e0, 0x4c81c0, -0xf50a2, -0xc3354, 0x10c190, -0xb4a80, 0x4dce6, -0x123cb },
+    { 0xa74a, 0x1bd90, -0xaea1d, 0x1ddca3, -0x380477, 0x4cb941, -0x440ed2, 0x34ad, 0x95c82a, -0x17cbf9a, 0x28ba4e9, -0x368915b, 0x383aead, -0x1f28024, -0x3d3963a, 0x315f2fc2, 0x1a2c867e, -0xb392b1c, 0x57d46a3, -0x208a5fd, -0x9ad36, 0x10b408d, -0x1475360, 0x10edc47, -0xaabd8f, 0x4deef8, -0x1095cc, -0xb628a, 0x105d3d, -0xb294b, 0x4d7ce, -0x1248a },
+    { 0xb4a4, 0x19e4d, -0xabd4f, 0x1dc598, -0x38547b, 0x4de99f, -0x4695d0, 0x431e3, 0x90f6b9, -0x178da37, 0x28bada6, -0x3709f31, 0x3988dc9, -0x219a502, -0x392894c, 0x319913d8, 0x19bfc77f, -0xb33335b, 0x58aa722, -0x2199b5e, 0x4b3fa, 0x101ad8d, -0x142854c, 0x10d9974, -0xab767c, 0x4f533f, -0x11d755, -0xa9258, 0xff855, -0xb0767, 0x4d24e, -0x12520 },
+    { 0xc224, 0x17e81, -0xa8f14, 0x1dabb3, -0x38a01d, 0x4f1529, -0x491a7b, 0x8343c, 0x8c12a3, -0x174cfcf, 0x28b7ede, -0x3786c37, 0x3ad3be0, -0x240e173, -0x3507294, 0x31d1ac66, 0x1952e888, -0xb2c56c0, 0x5977b0b, -0x22a4cfc, 0x130321, 0xf8104b, -0x13da1c2, 0x10c4142, -0xac1fac, 0x50ae85, -0x131525, -0x9c2cd, 0xf92e3, -0xae4db, 0x4cc67, -0x1258d },
+    { 0xcfca, 0x15e2d, -0xa5f6e, 0x1d8ef0, -0x38e74f, 0x503bbd, -0x4b9c97, 0xc3b65, 0x871c3c, -0x170a08e, 0x28b184f, -0x37ff771, 0x3c1b6f5, -0x2683272, -0x30d53bf, 0x3208f689, 0x18e5eea8, -0xb2497c3, 0x5a3c229, -0x23ab9ca, 0x213f21, 0xee69a4, -0x138a948, 0x10ad3ed, -0xacb927, 0x5200b8, -0x144f27, -0x8f3fd, 0xf2cf2, -0xac1ab, 0x4c61b, -0x125d4 },
+    { 0xdd94, 0x13d54, -0xa2e5d, 0x1d6f4b, -0x392a02, 0x515d39, -0x4e1be9, 0x10470c, 0x8213db, -0x16c4ca1, 0x28a79bf, -0x3873fea, 0x3d5fd08, -0x28f94f4, -0x2c92e8f, 0x323eef6e, 0x1878deee, -0xb1bf8e8, 0x5af7c54, -0x24ae0c3, 0x2f66de, 0xe4ba77, -0x1339c65, 0x10951ad, -0xad42f6, 0x5349ca, -0x158547, -0x825f7, 0xec68b, -0xa9ddc, 0x4bf6c, -0x125f3 },
+    { 0xeb82, 0x11bf6, -0x9fbe4, 0x1d4cc2, -0x396828, 0x52797a, -0x509833, 0x1456dd, 0x7cf9d7, -0x167d43c, 0x289a2f7, -0x38e44b0, 0x3ea0c1f, -0x2b705e6, -0x28404d4, 0x32739454, 0x180bbe69, -0xb127cbc, 0x5baa96e, -0x25ac0e7, 0x3d793c, 0xdb03a0, -0x12e7ba1, 0x107bac2, -0xadbd24, 0x5489ab, -0x16b76e, -0x758cc, 0xe5fba, -0xa7973, 0x4b85c, -0x125ed },
+    { 0xf991, 0xfa16, -0x9c802, 0x1d2751, -0x39a1b2, 0x53905f, -0x53113a, 0x186a83, 0x77ce8a, -0x1633793, 0x28893c6, -0x39504d6, 0x3fde240, -0x2de8231, -0x23dd870, 0x32a6e289, 0x179e9223, -0xb0825d8, 0x5c54965, -0x26a5940, 0x4b7528, 0xd145fc, -0x1294786, 0x1060f68, -0xae27bb, 0x55c04f, -0x17e58a, -0x68c8f, 0xdf888, -0xa5476, 0x4b0ed, -0x125c1 },
+    { 0x107c3, 0xd7b6, -0x992ba, 0x1cfef6, -0x39d694, 0x54a1c8, -0x5586c2, 0x1c81aa, 0x729250, -0x15e76de, 0x2874bfe, -0x39b7f74, 0x4117d72, -0x30606b6, -0x1f6ab58, 0x32d8d76d, 0x17315f22, -0xafcf6dc, 0x5cf5c33, -0x279a8dc, 0x59598c, 0xc78268, -0x124009c, 0x1044fdf, -0xae82c9, 0x56eda7, -0x190f86, -0x5c14e, 0xd9101, -0xa2ee9, 0x4a921, -0x12571 },
+    { 0x11614, 0xb4d7, -0x95c0d, 0x1cd3af, -0x3a06c0, 0x55ad92, -0x57f88f, 0x209bfb, 0x6d4588, -0x159925a, 0x285cb75, -0x3a1b3a4, 0x424dbbf, -0x32d9052, -0x1ae7f8f, 0x33097072, 0x16c42a6c, -0xaf0f275, 0x5d8e1db, -0x288aed3, 0x67255a, 0xbdb9bf, -0x11ea770, 0x1027c68, -0xaece5b, 0x5811a9, -0x1a354e, -0x4f71a, 0xd292d, -0xa08d2, 0x4a0fb, -0x124fc },
+    { 0x12484, 0x917b, -0x923fd, 0x1ca579, -0x3a3229, 0x56b39c, -0x5a6664, 0x24b920, 0x67e890, -0x1548a45, 0x2841209, -0x3a7a089, 0x437fb34, -0x3551bda, -0x1655729, 0x3338ab1a, 0x1656f901, -0xae41b59, 0x5e1da6d, -0x2976a43, 0x74d785, 0xb3ecdc, -0x1193c8d, 0x1009546, -0xaf0a82, 0x592c49, -0x1b56d2, -0x42e04, 0xcc118, -0x9e235, 0x4987b, -0x12465 },
+    { 0x13312, 0x6da5, -0x8ea8c, 0x1c7453, -0x3a58c3, 0x57b3c8, -0x5cd005, 0x28d8c1, 0x627bca, -0x14f5ee3, 0x2821f98, -0x3ad4548, 0x44ad9df, -0x37ca61e, -0x11b344c, 0x336684fa, 0x15e9cfe0, -0xad67444, 0x5ea4605, -0x2a5da51, 0x826f05, 0xaa1c9a, -0x113c07f, 0xfe9abd, -0xaf374d, 0x5a3d7e, -0x1c73fd, -0x3661a, 0xc58cc, -0x9bb18, 0x48fa4, -0x123ab },
+    { 0x141bc, 0x4957, -0x8afbc, 0x1c403a, -0x3a7a81, 0x58adf3, -0x5f3537, 0x2cfa85, 0x5cff99, -0x14a107a, 0x27ff409, -0x3b2a10c, 0x45d75d2, -0x3a42beb, -0xd0192f, 0x3392fbb8, 0x157cb401, -0xac80000, 0x5f224c9, -0x2b3fe2a, 0x8fead3, 0xa049d3, -0x10e33d4, 0xfc8d12, -0xaf54cf, 0x5b453d, -0x1d8cbf, -0x29f6e, 0xbf052, -0x99380, 0x48679, -0x122cf },
+    { 0x15082, 0x2493, -0x8738f, 0x1c092f, -0x3a9758, 0x59a1ff, -0x6195bc, 0x311e15, 0x577464, -0x1449f53, 0x27d8f45, -0x3b7b305, 0x46fcd20, -0x3cbaa06, -0x840818, 0x33be0d0d, 0x150faa5a, -0xab8c15d, 0x5f976e8, -0x2c1d502, 0x9d49ee, 0x96755f, -0x108971b, 0xfa6c8a, -0xaf631b, 0x5c437f, -0x1ea107, -0x1da0e, 0xb87b5, -0x96b72, 0x47cfb, -0x121d2 },
+    { 0x15f62, -0xa5, -0x83607, 0x1bcf2e, -0x3aaf3c, 0x5a8fcc, -0x63f159, 0x354317, 0x51da90, -0x13f0bba, 0x27af13a, -0x3bc7a68, 0x481dde1, -0x3f31d30, -0x37035e, 0x33e7b6c4, 0x14a2b7db, -0xaa8bb34, 0x6003c9f, -0x2cf5e14, 0xaa8b57, 0x8ca017, -0x102eae3, 0xf8396f, -0xaf6246, 0x5d383c, -0x1fb0c3, -0x11609, 0xb1efe, -0x942f2, 0x4732d, -0x120b5 },
+    { 0x16e5b, -0x264f, -0x7f728, 0x1b9239, -0x3ac222, 0x5b773b, -0x6647d3, 0x396931, 0x4c3287, -0x1395600, 0x27819dd, -0x3c0f66e, 0x493a62f, -0x41a8227, 0x16f298, 0x340ff6b7, 0x1435e170, -0xa97f067, 0x6067635, -0x2dc98a4, 0xb7ae14, 0x82cad1, -0xfd2fba, 0xf5f408, -0xaf5263, 0x5e236e, -0x20bbe3, -0x536e, 0xab637, -0x91a07, 0x46910, -0x11f78 },
+    { 0x17d6b, -0x4c67, -0x7b6f3, 0x1b524d, -0x3acfff, 0x5c582d, -0x6898ec, 0x3d9007, 0x467cb3, -0x1337e77, 0x2750925, -0x3c52659, 0x4a52427, -0x441d5a1, 0x65d752, 0x3436cad8, 0x13c92c01, -0xa8663df, 0x60c23fb, -0x2e983fc, 0xc4b12d, 0x78f665, -0xf76631, 0xf39ca1, -0xaf338c, 0x5f050e, -0x21c259, 0x6db3, 0xa4d6b, -0x8f0b4, 0x45ea7, -0x11e1d },
+    { 0x18c91, -0x72eb, -0x7756c, 0x1b0f6c, -0x3ad8ca, 0x5d3284, -0x6ae46a, 0x41b740, 0x40b981, -0x12d8577, 0x271bf0f, -0x3c9096d, 0x4b655ea, -0x4691452, 0xb5a847, 0x345c3126, 0x135c9c6e, -0xa74188f, 0x611464c, -0x2f61f6d, 0xd193b1, 0x6f23a7, -0xf18ed9, 0xf13384, -0xaf05d7, 0x5fdd18, -0x22c414, 0x12d4e, 0x9e4a3, -0x8c700, 0x453f3, -0x11ca4 },
+    { 0x19bcb, -0x99da, -0x73295, 0x1ac994, -0x3adc77, 0x5e0622, -0x6d2a11, 0x45de7f, 0x3ae95f, -0x1276b5a, 0x26e3b9d, -0x3cc9ef4, 0x4c7399c, -0x4903aea, 0x10662e1, 0x348027b7, 0x12f03793, -0xa611170, 0x615dd91, -0x3026a51, 0xde54b0, 0x65536a, -0xebaa44, 0xeeb8fe, -0xaec95e, 0x60ab89, -0x23c106, 0x1eb52, 0x97be7, -0x89cef, 0x448f8, -0x11b0d },
+    { 0x1ab19, -0xc12f, -0x6ee72, 0x1a80c7, -0x3adafd, 0x5ed2e9, -0x6f69a5, 0x4a0569, 0x350cbb, -0x121307c, 0x26a7ed6, -0x3cfe63f, 0x4d7cd67, -0x4b74615, 0x1580477, 0x34a2acb0, 0x12840245, -0xa4d5185, 0x619ea39, -0x30e6408, 0xeaf33e, 0x5b8682, -0xe5b901, 0xec2d5c, -0xae7e3a, 0x61705d, -0x24b922, 0x2a7b3, 0x91343, -0x87286, 0x43db6, -0x1195a },
+    { 0x1ba79, -0xe8e9, -0x6a905, 0x1a3504, -0x3ad454, 0x5f98bc, -0x71a2ec, 0x4e2ba0, 0x2f2408, -0x11ad53e, 0x26688c6, -0x3d2dea4, 0x4e80f76, -0x4de327a, 0x1aa8a52, 0x34c3be4c, 0x12180155, -0xa38dbd4, 0x61d6cc1, -0x31a0bfc, 0xf76e75, 0x51bdc0, -0xdfbba5, 0xe990ed, -0xae2488, 0x622b91, -0x25ac59, 0x36263, 0x8aac0, -0x847ca, 0x43230, -0x1178c },
+    { 0x1c9e9, -0x11105, -0x66253, 0x19e64c, -0x3ac872, 0x60577f, -0x73d5a9, 0x5250c8, 0x292fb9, -0x1145a03, 0x262597d, -0x3d5877e, 0x4f7fdf9, -0x504fcbe, 0x1fdf1ab, 0x34e35ad7, 0x11ac398b, -0xa23b36e, 0x62065ad, -0x325619b, 0x103c571, 0x47f9f5, -0xd9b2c0, 0xe6e402, -0xadbc64, 0x62dd25, -0x269a9f, 0x41b54, 0x84265, -0x81cc1, 0x42669, -0x115a2 },
+    { 0x1d968, -0x1397f, -0x61a5f, 0x1994a1, -0x3ab74f, 0x610f15, -0x7601a3, 0x567484, 0x233041, -0x10dbf34, 0x25df111, -0x3d7e02f, 0x5079725, -0x52ba181, 0x25237aa, 0x350180b0, 0x1140afaa, -0xa0ddb6a, 0x622d590, -0x330645d, 0x10ff754, 0x3e3bee, -0xd39ee6, 0xe426ea, -0xad45eb, 0x638518, -0x2783e6, 0x4d278, 0x7da3e, -0x7f16e, 0x41a62, -0x1139f },
+    { 0x1e8f4, -0x16255, -0x5d12d, 0x194005, -0x3aa0e4, 0x61bf62, -0x7826a0, 0x5a9675, 0x1d2617, -0x1070538, 0x2594f9d, -0x3d9e81f, 0x516d933, -0x5521d62, 0x2a75969, 0x351e2e4b, 0x10d5686c, -0x9f756e4, 0x624bd02, -0x33b13c2, 0x11c0342, 0x348479, -0xcd80a9, 0xe159f7, -0xacc13c, 0x64236a, -0x286824, 0x587c5, 0x77253, -0x7c5d8, 0x40e1d, -0x11182 },
+    { 0x1f88c, -0x18b84, -0x586c0, 0x18e877, -0x3a8528, 0x62684b, -0x7a4464, 0x5eb63d, 0x1711b2, -0x1002c7f, 0x254753f, -0x3db9ebb, 0x525c261, -0x5786cfd, 0x2fd53f3, 0x3539622e, 0x106a6886, -0x9e02900, 0x6261ca8, -0x3456f4f, 0x127e865, 0x2ad462, -0xc7589d, 0xde7d7d, -0xac2e77, 0x64b81d, -0x29474d, 0x63b2b, 0x70aad, -0x79a02, 0x4019e, -0x10f4c },
+    { 0x2082e, -0x1b509, -0x53b1d, 0x188dfc, -0x3a6414, 0x6309b6, -0x7c5ab6, 0x62d37f, 0x10f38c, -0xf93577, 0x24f621d, -0x3dd0376, 0x53450f1, -0x59e8ce9, 0x3542442, 0x35531af2, 0xfffb4a4, -0x9c854e8, 0x626f530, -0x34f7692, 0x133a5ec, 0x212c72, -0xc12755, 0xdb91ce, -0xab8dbd, 0x654332, -0x2a2156, 0x6eca0, 0x6a355, -0x76df2, 0x3f4e4, -0x10cff },
+    { 0x217d9, -0x1dee0, -0x4ee47, 0x183094, -0x3a3da2, 0x63a388, -0x7e695d, 0x66eddb, 0xacc1f, -0xf22095, 0x24a165f, -0x3de15cb, 0x542832a, -0x5c479bd, 0x3abc744, 0x356b5743, 0xf95516a, -0x9afddcb, 0x6274753, -0x3592921, 0x13f3b07, 0x178d73, -0xbaed63, 0xd89740, -0xaadf30, 0x65c4ad, -0x2af634, 0x79c17, 0x63c54, -0x741ad, 0x3e7f4, -0x10a9b },
+    { 0x2278a, -0x20906, -0x4a044, 0x17d042, -0x3a11cc, 0x6435a8, -0x80701f, 0x6b04f3, 0x49be6, -0xeaee50, 0x2449234, -0x3ded53a, 0x550575a, -0x5ea300d, 0x40439d4, 0x358215e3, 0xf2b4376, -0x996c6de, 0x62713d1, -0x362869a, 0x14aa6ed, 0xdf82b, -0xb4ab5b, 0xd58e28, -0xaa22f2, 0x663c92, -0x2bc5de, 0x84984, 0x5d5b2, -0x71538, 0x3dace, -0x10821 },
+    { 0x23741, -0x23379, -0x45118, 0x176d0a, -0x39e08c, 0x64bffb, -0x826ec3, 0x6f1867, -0x19ca1, -0xe39f21, 0x23ed5d0, -0x3df4148, 0x55dcbd1, -0x60fac6b, 0x45d78c2, 0x359755a5, 0xec18f5a, -0x97d135d, 0x6265b77, -0x36b8ea0, 0x155e8da, 0x46d60, -0xae61d0, 0xd276db, -0xa95928, 0x66aae4, -0x2c904b, 0x8f4db, 0x56f79, -0x6e897, 0x3cd76, -0x10591 },
+    { 0x246fc, -0x25e34, -0x400c6, 0x1706ee, -0x39a9dc, 0x65426a, -0x846511, 0x7327d8, -0x7dcf8, -0xdc3385, 0x238e16b, -0x3df5984, 0x56adee7, -0x634eb68, 0x4b780ce, 0x35ab1571, 0xe5839a4, -0x962c686, 0x6251f19, -0x37440e0, 0x161000b, -0x5122d, -0xa81156, 0xcf51b1, -0xa881f6, 0x670fa9, -0x2d5571, 0x99e12, 0x509b0, -0x6bbcf, 0x3bfed, -0x102ed },
+    { 0x256b8, -0x28935, -0x3af55, 0x169df1, -0x396db8, 0x65bcdb, -0x8652d1, 0x7732e7, -0xe249e, -0xd4abfb, 0x232b543, -0x3df1d7e, 0x5778ef9, -0x659e993, 0x5124ea9, 0x35bd5442, 0xdef46d4, -0x947e39e, 0x6235f96, -0x37c9d0e, 0x16bebc7, -0xe85b9, -0xa1ba80, 0xcc1f02, -0xa79d83, 0x676ae8, -0x2e1548, 0xa451d, 0x4a460, -0x68ee5, 0x3b235, -0x10034 },
+    { 0x26675, -0x2b477, -0x35cc9, 0x163218, -0x392c1c, 0x662f39, -0x8837cc, 0x7b3934, -0x147314, -0xcd0907, 0x22c519a, -0x3de8cd2, 0x583da69, -0x67ea378, 0x56ddef5, 0x35ce1127, 0xd86bb66, -0x92c6df0, 0x6211dd4, -0x384a2e5, 0x176ab53, -0x17ec85, -0x9b5de0, 0xc8df26, -0xa6abf4, 0x67bca7, -0x2ecfca, 0xae9f2, 0x43f92, -0x661de, 0x3a451, -0xfd69 },
+    { 0x27630, -0x2dff8, -0x30927, 0x15c366, -0x38e502, 0x66996a, -0x8a13ca, 0x7f3a5f, -0x1ac7d5, -0xc54b2e, 0x225b6b7, -0x3dda720, 0x58fbfa0, -0x6a315a6, 0x5ca2e49, 0x35dd4b44, 0xd1e9bc9, -0x91068c8, 0x61e5ac5, -0x38c5228, 0x1813dff, -0x2145d4, -0x94fc09, 0xc59276, -0xa5ad72, 0x6804ef, -0x2f84ed, 0xb8c86, 0x3db4d, -0x634bd, 0x39642, -0xfa8b },
+    { 0x285e7, -0x30bb3, -0x2b475, 0x1551e0, -0x389869, 0x66fb5a, -0x8be694, 0x833609, -0x212260, -0xbd72f9, 0x21ee4e8, -0x3dc6c0f, 0x59b3d0b, -0x6c73ca8, 0x627392b, 0x35eb01cf, 0xcb6ec65, -0x8f3d77a, 0x61b1762, -0x393aaa1, 0x18ba31b, -0x2a90e9, -0x8e958d, 0xc2394b, -0xa4a226, 0x6843c7, -0x3034ad, 0xc2ccf, 0x37799, -0x60789, 0x3880b, -0xf79c },
+    { 0x2959a, -0x337a6, -0x25eb7, 0x14dd8a, -0x38464c, 0x6754f2, -0x8daff4, 0x872bd2, -0x27822e, -0xb580f4, 0x217dc7e, -0x3dadb4b, 0x5a65120, -0x6eb1509, 0x684fc15, 0x35f73413, 0xc4fb195, -0x8d6bd5a, 0x61754ae, -0x39aac21, 0x195d9fd, -0x33cd0d, -0x882aff, 0xbed402, -0xa38a39, 0x687939, -0x30df03, 0xccac3, 0x3147f, -0x5da45, 0x379ad, -0xf49d },
+    { 0x2a546, -0x363cc, -0x207f4, 0x146669, -0x37eeaa, 0x67a61d, -0x8f6fb6, 0x8b1b5a, -0x2de6bb, -0xad75ad, 0x2109dcf, -0x3d8f48a, 0x5b0fa59, -0x70e9b53, 0x6e37373, 0x3601e170, 0xbe8efac, -0x8b91dc4, 0x61313b4, -0x3a15682, 0x19fe200, -0x3cf988, -0x81bcf1, 0xbb62f3, -0xa265d5, 0x68a550, -0x3183e9, 0xd6658, 0x2b206, -0x5acf6, 0x36b2b, -0xf18d },
+    { 0x2b4e9, -0x39021, -0x1b031, 0x13ec82, -0x379180, 0x67eec6, -0x9125a3, 0x8f0441, -0x344f80, -0xa551b6, 0x2092937, -0x3d6b787, 0x5bb3738, -0x731cc13, 0x7429ba2, 0x360b0957, 0xb82aaf5, -0x89afc14, 0x60e5587, -0x3a7a9a4, 0x1a9ba85, -0x4615a5, -0x7b4bf3, 0xb7e67c, -0xa13526, 0x68c815, -0x32235a, 0xdff86, 0x25036, -0x57fa1, 0x35c87, -0xee6e },
+    { 0x2c481, -0x3bca2, -0x15775, 0x136fdb, -0x372ecc, 0x682ed9, -0x92d187, 0x92e629, -0x3abbf5, -0x9d15a2, 0x2017f17, -0x3d42403, 0x5c50645, -0x754a3d3, 0x7a270f5, 0x3612ab51, 0xb1ce7ab, -0x87c5bab, 0x6091b45, -0x3ada570, 0x1b362ef, -0x4f20b2, -0x74d896, 0xb45ef7, -0x9ff857, 0x68e195, -0x32bd52, 0xe9643, 0x1ef16, -0x55249, 0x34dc3, -0xeb40 },
+    { 0x2d40d, -0x3e94c, -0xfdc4, 0x12f079, -0x36c68f, 0x686643, -0x94732e, 0x96c0b0, -0x412b90, -0x94c209, 0x1f99fd5, -0x3d139c8, 0x5ce6610, -0x7771f1f, 0x802efae, 0x3618c6f9, 0xab7aa03, -0x85d3fec, 0x6036613, -0x3b349d4, 0x1bcdaa8, -0x5819fd, -0x6e636b, 0xb0ccc2, -0x9eaf97, 0x68f1dd, -0x3351cd, 0xf2a87, 0x18eae, -0x524f4, 0x33ee1, -0xe805 },
+    { 0x2e38a, -0x41619, -0xa325, 0x126e63, -0x3658c6, 0x6894f2, -0x960a66, 0x9a9379, -0x479dc8, -0x8c5785, 0x1f18bda, -0x3cdf8a6, 0x5d7552e, -0x7993a81, 0x8641406, 0x361d5bfd, 0xa52f624, -0x83dac3f, 0x5fd371c, -0x3b896c7, 0x1c6211d, -0x6100d9, -0x67ed02, 0xad3039, -0x9d5b11, 0x68f8f8, -0x33e0c7, 0xfbc48, 0x12f05, -0x4f7a6, 0x32fe2, -0xe4be },
+    { 0x2f2f7, -0x44305, -0x479e, 0x11e99e, -0x35e573, 0x68bad2, -0x9796fa, 0x9e5e23, -0x4e1213, -0x83d6b0, 0x1e94397, -0x3ca6073, 0x5dfd23c, -0x7baf289, 0x8c5da26, 0x36206a22, 0x9eed02d, -0x81da40c, 0x5f68f97, -0x3bd8c48, 0x1cf35c3, -0x69d49b, -0x6175e9, 0xa989ba, -0x9bfaf6, 0x68f6f6, -0x346a3d, 0x104b80, 0xd022, -0x4ca63, 0x320ca, -0xe169 },
+    { 0x30252, -0x4700e, 0x14c9, 0x116233, -0x356c95, 0x68d7d4, -0x9918ba, 0xa22051, -0x5487e4, -0x7b402c, 0x1e0c781, -0x3c6710e, 0x5e7dbde, -0x7dc43c2, 0x9283e2e, 0x3621f13e, 0x98b3c2e, -0x7fd2abe, 0x5ef70c1, -0x3c22a5c, 0x1d81810, -0x729499, -0x5afeb0, 0xa5d9a2, -0x9a8f73, 0x68ebe5, -0x34ee2d, 0x10d826, 0x720c, -0x49d2f, 0x31199, -0xde0a }
+};
+
+const right_shift_t resample_147_160_shr = 0;
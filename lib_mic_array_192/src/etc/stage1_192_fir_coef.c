@@ -0,0 +1,57 @@
+// Copyright 2022-2024 XMOS LIMITED.
+// This Software is subject to the terms of the XMOS Public Licence: Version 1.
+
+#include <stdint.h>
+
+#include "mic_array/etc/filters_default.h"
+
+
+// taps=240, fc=80kHz, window=("kaiser", 4.0), a_stop=-44dB, 16 samples padding
+// at the end. python/stage1_192.py generates tables in this format from design
+// parameters.
+// clang-format off
+MIC_ARRAY_CONFIG_COEF_ATTRIBUTES
+const uint32_t s1_fir_coef[S1_WORDS] = {
+  0xFFFFDA39, 0xBFF03D14, 0x538A5CDE, 0xCE092678, 0xAA551E64, 0x90737B3A, 0x51CA28BC, 0x0FFD9C5B, 
+  0xFFFF0B0A, 0x66F123BA, 0x52CDEEBC, 0x9ABFF4AE, 0xF66F752F, 0xFD593D77, 0xB34A5DC4, 0x8F6650D0, 
+  0xFFFFE5F6, 0x6942B926, 0xA4759759, 0x7664D0A0, 0xA815050B, 0x266E9AE9, 0xAE25649D, 0x42966FA7, 
+  0xFFFF9207, 0xCF40DCF9, 0x3DBEE8B1, 0xBF02757E, 0xF00F7EAE, 0x40FD8D17, 0x7DBC9F3B, 0x02F3E049, 
+  0xFFFFA150, 0xE96BC170, 0x45B01821, 0x3D7A8121, 0xEE778481, 0x5EBC8418, 0x0DA20E83, 0xD6970A85, 
+  0xFFFF959A, 0x0626D835, 0x1E635D0D, 0x75D96DDB, 0xF24FDBB6, 0x9BAEB0BA, 0xC678AC1B, 0x646059A9, 
+  0xFFFF8CB6, 0x0AE19A19, 0xBB279875, 0xCD6B6F6F, 0x8001F6F6, 0xD6B3AE19, 0xE4DD9859, 0x87506D31, 
+  0xFFFF7C71, 0xF34AE6A1, 0xD79AB09E, 0x821667F1, 0xD42B8FE6, 0x6841790D, 0x59EB8567, 0x52CF8E3E, 
+  0xFFFFFC0F, 0xFC730194, 0xB0298AF7, 0xAAEDFBAA, 0x7E7E55DF, 0xB755EF51, 0x940D2980, 0xCE3FF03F, 
+  0xFFFFFC00, 0x007C0073, 0x8FCD2CF2, 0xCCA10833, 0xDC3BCC10, 0x85334F34, 0xB3F1CE00, 0x3E00003F, 
+  0xFFFFFC00, 0x007FFFF0, 0x7FF1CF0E, 0x5A61A7C3, 0xC813C3E5, 0x865A70F3, 0x8FFE0FFF, 0xFE00003F, 
+  0xFFFFFC00, 0x007FFFF0, 0x0001F001, 0xC61E3556, 0x90096AAC, 0x7863800F, 0x80000FFF, 0xFE00003F, 
+  0xFFFFFC00, 0x007FFFF0, 0x0001FFFF, 0xC1FFC664, 0xE0072663, 0xFF83FFFF, 0x80000FFF, 0xFE00003F, 
+  0xFFFFFC00, 0x007FFFF0, 0x0001FFFF, 0xC0000787, 0x0000E1E0, 0x0003FFFF, 0x80000FFF, 0xFE00003F, 
+  0xFFFFFC00, 0x007FFFF0, 0x0001FFFF, 0xC00007F8, 0x00001FE0, 0x0003FFFF, 0x80000FFF, 0xFE00003F, 
+  0x000003FF, 0xFF80000F, 0xFFFE0000, 0x3FFFF800, 0x0000001F, 0xFFFC0000, 0x7FFFF000, 0x01FFFFC0,
+};
+// clang-format on
+
+
+// Homomorphic design from s1_fir_coef's magnitude response, with the same 16
+// zero taps on the newest samples.
+// clang-format off
+MIC_ARRAY_CONFIG_COEF_ATTRIBUTES
+const uint32_t s1_fir_coef_min_phase[S1_WORDS] = {
+  0xFFFFD989, 0xA14CFCCF, 0x711D7820, 0x81AFED71, 0x6CE60EB7, 0x9B6DC7DC, 0xA2B8780B, 0xD7A07D84,
+  0xFFFF400E, 0xD5D4C52A, 0x635BDBB0, 0x018DDFA2, 0x3CDD2F06, 0x6F3842D5, 0xA8087EA6, 0xB342427D,
+  0xFFFF2232, 0x28F3D7A8, 0x7ACB0636, 0xEE10BC5F, 0x65FEE599, 0xB6C24F30, 0xB41A0A99, 0x06FA338C,
+  0xFFFFE7D4, 0x4050FA22, 0x35C8EBE4, 0xDDE7CFBE, 0x37DCABA7, 0x58512924, 0xE9F5B5D6, 0xC0AD616B,
+  0xFFFFCC19, 0xF1D2BAEA, 0xB50BF3D7, 0x04D5B5F6, 0x36A09996, 0xD4CA558A, 0xA95DB7B0, 0xBA6595AA,
+  0xFFFF8B2C, 0x3CCF80B3, 0x74E2ED02, 0xB7C72CDE, 0xCEBE8A73, 0xA7A0A377, 0xB99CCD25, 0x8349F36F,
+  0xFFFF3E12, 0x7DCD8299, 0xFBF2BFA2, 0xB33F6384, 0xCFA62597, 0x784440FA, 0x4CB6FC93, 0x838E0F12,
+  0xFFFF7738, 0xFCF47C4D, 0x35575F0C, 0x56042C92, 0x797CCBCA, 0xFFD7D556, 0x0ED8FC70, 0x7C0FFF03,
+  0xFFFFAF82, 0x038A66D1, 0x800240B9, 0x2C06C19B, 0x7A170D43, 0x5567CCCE, 0x0F1F03F0, 0x000FFF03,
+  0xFFFFCA83, 0x55043CCB, 0x7BB9953A, 0x17F8A136, 0xD3F2A4C3, 0x9987C3C1, 0xF01FFFF0, 0x000FFF03,
+  0xFFFFF329, 0x3357E8C7, 0x0282B36C, 0x0D559E24, 0x9C0E63C3, 0xE1F83FC0, 0x001FFFF0, 0x000FFF03,
+  0xFFFFFC32, 0x5A67E595, 0xA98325B0, 0x03338038, 0xE001E03C, 0x01FFFFC0, 0x001FFFF0, 0x000FFF03,
+  0xFFFFFFC3, 0x9C781C4C, 0x987C39C0, 0x00F07FC0, 0xFFFFE000, 0x01FFFFC0, 0x001FFFF0, 0x000FFF03,
+  0xFFFFFFFC, 0x1F8003C3, 0x87FFC1FF, 0xFFF00000, 0xFFFFE000, 0x01FFFFC0, 0x001FFFF0, 0x000FFF03,
+  0xFFFFFFFF, 0xE000003F, 0x800001FF, 0xFFF00000, 0xFFFFE000, 0x01FFFFC0, 0x001FFFF0, 0x000FFF03,
+  0x00000000, 0x00000000, 0x7FFFFE00, 0x000FFFFF, 0x00001FFF, 0xFE00003F, 0xFFE0000F, 0xFFF000FC,
+};
+// clang-format on
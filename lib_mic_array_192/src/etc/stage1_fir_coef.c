@@ -8,6 +8,7 @@
 
 // Each coefficient is 16 bits and the number of coefficients must be a multiple of 256.
 // int32_t type so that it's word-aligned. So this is 512 16-bit coefficients.
+MIC_ARRAY_CONFIG_COEF_ATTRIBUTES
 const uint32_t stage1_coef[STAGE1_WORDS] = {
 
   0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF, 0xEEEEEEEE, 0xEEEEEEEE, 0xEEEEEEEE, 0xEEEEEEEE,
@@ -27,4 +28,31 @@ const uint32_t stage1_coef[STAGE1_WORDS] = {
   0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFE000, 0x0000FFFF, 0xFFFFFFFF,
   0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000,
 
-};
\ No newline at end of file
+};
+
+
+// The same taps as stage1_coef, moved from the oldest 125 of the 256 samples
+// to the newest. The moving average filter's zeros all lie on the unit circle,
+// so it is already minimum phase; only the 131 samples of padding in front of
+// it were adding delay.
+MIC_ARRAY_CONFIG_COEF_ATTRIBUTES
+const uint32_t stage1_coef_min_phase[STAGE1_WORDS] = {
+
+  0x77777777, 0x77777777, 0x77777777, 0x77777777, 0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF,
+  0xD7D7D7D7, 0xD7D7D7D7, 0x5F5F5F5F, 0x5F5F5F5F, 0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF,
+  0xAD07AD07, 0x258F258F, 0x8D278D27, 0x05AF05AF, 0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF,
+  0xDA8D7027, 0x7AA5D00F, 0x805D2AF7, 0x20758ADF, 0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF,
+  0xE89A9DED, 0x98C04D9F, 0xCD9018CD, 0xBDCAC8BF, 0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF,
+  0xF268907A, 0xC2575A95, 0x4AD7521A, 0xF048B27F, 0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF,
+  0xFCA73108, 0xBC98E400, 0x0138C9E8, 0x846729FF, 0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF,
+  0xFF3571A7, 0x2A4A82F7, 0x7A0A92A7, 0x2C7567FF, 0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF,
+  0xFFC65B60, 0x336CFE58, 0xD3F9B660, 0x36D31FFF, 0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF,
+  0xFFF8624A, 0x96DA549F, 0xC952DB4A, 0x9230FFFF, 0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF,
+  0xFFFF838C, 0xDB6C98E0, 0x38C9B6D9, 0x8E0FFFFF, 0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF,
+  0xFFFFFC0F, 0x1C70E0FF, 0xF83871C7, 0x81FFFFFF, 0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF,
+  0xFFFFFFF0, 0x1F80FF00, 0x07F80FC0, 0x7FFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF,
+  0xFFFFFFFF, 0xE000FFFF, 0xFFF8003F, 0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF,
+  0xFFFFFFFF, 0xFFFF0000, 0x0007FFFF, 0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF,
+  0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000,
+
+};
@@ -3,9 +3,30 @@
 
 #include "mic_array/etc/filters_default.h"
 
+MIC_ARRAY_CONFIG_COEF_ATTRIBUTES
 const int32_t stage2_coef[STAGE2_TAP_COUNT] = 
 {
     0xf0ae7, 0x3ff64e, 0x7fd7c6, 0xb78b45, 0xc5d06b, 0x896e74, -0x103d43, -0xfcadb6, -0x20b8a31, -0x2e9693b, -0x330ef35, -0x288bfcd, -0xc797a3, 0x1ec3ba6, 0x50e383b, 0x7c7a6bd, 0x919cb7e, 0x8210df5, 0x462d605, -0x1ee86db, -0x9cfbe97, -0x11796175, -0x16a39a95, -0x16f8b8ea, -0x10a057d0, -0x2c351b0, 0x1219788d, 0x2bfeaf1d, 0x47bcf46a, 0x6171a4f6, 0x753c91cd, 0x7fffffff, 0x7fffffff, 0x753c91cd, 0x6171a4f6, 0x47bcf46a, 0x2bfeaf1d, 0x1219788d, -0x2c351b0, -0x10a057d0, -0x16f8b8ea, -0x16a39a95, -0x11796175, -0x9cfbe97, -0x1ee86db, 0x462d605, 0x8210df5, 0x919cb7e, 0x7c7a6bd, 0x50e383b, 0x1ec3ba6, -0xc797a3, -0x288bfcd, -0x330ef35, -0x2e9693b, -0x20b8a31, -0xfcadb6, -0x103d43, 0x896e74, 0xc5d06b, 0xb78b45, 0x7fd7c6, 0x3ff64e, 0xf0ae7
 };
 
 const right_shift_t stage2_shr = 2;
+
+// stage2_coef scaled down to 16 bits, for Stage2FilterS16
+// (python/stage2.py --coef-bits 16).
+MIC_ARRAY_CONFIG_COEF_ATTRIBUTES
+const int16_t stage2_coef_s16[STAGE2_TAP_COUNT] = 
+{
+    0xf, 0x40, 0x80, 0xb8, 0xc6, 0x89, -0x10, -0xfd, -0x20c, -0x2e9, -0x331, -0x289, -0xc8, 0x1ec, 0x50e, 0x7c8, 0x91a, 0x821, 0x463, -0x1ef, -0x9d0, -0x1179, -0x16a4, -0x16f9, -0x10a0, -0x2c3, 0x1219, 0x2bff, 0x47bd, 0x6172, 0x753d, 0x7fff, 0x7fff, 0x753d, 0x6172, 0x47bd, 0x2bff, 0x1219, -0x2c3, -0x10a0, -0x16f9, -0x16a4, -0x1179, -0x9d0, -0x1ef, 0x463, 0x821, 0x91a, 0x7c8, 0x50e, 0x1ec, -0xc8, -0x289, -0x331, -0x2e9, -0x20c, -0xfd, -0x10, 0x89, 0xc6, 0xb8, 0x80, 0x40, 0xf
+};
+
+const right_shift_t stage2_shr_s16 = 0;
+
+// Minimum phase version of stage2_coef, with the same magnitude response and
+// DC gain (homomorphic design from stage2_coef's magnitude response).
+MIC_ARRAY_CONFIG_COEF_ATTRIBUTES
+const int32_t stage2_coef_min_phase[STAGE2_TAP_COUNT] = 
+{
+    0x3d208a, 0x12577e3, 0x352f133, 0x7860374, 0xe7fe676, 0x18ce01a8, 0x268d8f2c, 0x37365667, 0x497dc428, 0x5b613507, 0x6a5ef5f3, 0x73da74d1, 0x759be044, 0x6e516f6c, 0x5df3cc50, 0x45f1f8d7, 0x29138008, 0xb0fd6bc, -0x1014281b, -0x24c25e62, -0x3080b5ee, -0x32689231, -0x2b4c8914, -0x1d8302c5, -0xc619eca, 0x4781770, 0x11dd1e6f, 0x19ac5b20, 0x1b2631bc, 0x16ef0250, 0xec3d5e7, 0x4f8a201, -0x41d1bca, -0xaaab56f, -0xdb641a6, -0xd371e84, -0x9f2888f, -0x52c8c8c, -0x469c30, 0x39990b7, 0x5c5ddd9, 0x61bd29f, 0x4f214cf, 0x2ea9841, 0xba3301, -0x109a86f, -0x20ad48b, -0x23ae210, -0x1c6564a, -0xfa8d57, -0x286b00, 0x734913, 0xbc1527, 0xb5d19a, 0x7ac521, 0x2dfef9, -0x128539, -0x34fd7c, -0x380e09, -0x23bed6, -0x99f3f, 0xc810c, 0xdb567, 0x3b3bd
+};
+
+const right_shift_t stage2_shr_min_phase = 2;
@@ -0,0 +1,68 @@
+// Copyright 2022-2024 XMOS LIMITED.
+// This Software is subject to the terms of the XMOS Public Licence: Version 1.
+
+#include "mic_array/etc/fir_1x16_bit.h"
+
+
+void fir_1x16_bit_lut_init(
+    uint32_t table[FIR_1X16_BIT_LUT_WORDS],
+    const uint32_t coeff_1[],
+    const unsigned coef_bits)
+{
+  // Tap i applies to signal bit i % 32 of word i / 32. Each of its bit-planes
+  // adds +/- half of the plane's weight (1, 2, .., 2^(planes-2), and
+  // 2^(planes-1) - 1 for the last), which sums to a whole number.
+  int32_t taps[256];
+
+  for(unsigned i = 0; i < 256; i++){
+    int32_t tap = 0;
+    for(unsigned bit = 0; bit < coef_bits; bit++){
+      const int32_t weight = (bit == coef_bits - 1)? ((1 << bit) - 1)
+                                                   : (1 << bit);
+      const unsigned c = (coeff_1[8 * bit + i / 32] >> (i % 32)) & 1;
+      tap += c? -weight : weight;
+    }
+    taps[i] = tap / 2;
+  }
+
+  // A signal bit of 0 is +1 and of 1 is -1.
+  for(unsigned p = 0; p < 32; p++){
+    for(unsigned v = 0; v < 256; v++){
+      int32_t acc = 0;
+      for(unsigned k = 0; k < 8; k++)
+        acc += ((v >> k) & 1)? -taps[8 * p + k] : taps[8 * p + k];
+      table[256 * p + v] = ((uint32_t) acc) << (24 - coef_bits);
+    }
+  }
+}
+
+
+int fir_1x16_bit_lut(
+    const uint32_t signal[],
+    const uint32_t table[])
+{
+  uint32_t acc = 0;
+
+  for(unsigned k = 0; k < 8; k++){
+    const uint32_t word = signal[k];
+    const uint32_t* t = &table[4 * 256 * k];
+    acc += t[0 * 256 + ((word >>  0) & 0xFF)];
+    acc += t[1 * 256 + ((word >>  8) & 0xFF)];
+    acc += t[2 * 256 + ((word >> 16) & 0xFF)];
+    acc += t[3 * 256 + ((word >> 24) & 0xFF)];
+  }
+
+  return (int32_t) acc;
+}
+
+
+void fir_1x16_bit_lut_multi(
+    const uint32_t signal[],
+    const uint32_t table[],
+    int32_t out[],
+    unsigned count,
+    unsigned stride)
+{
+  for(unsigned k = 0; k < count; k++)
+    out[k] = fir_1x16_bit_lut(&signal[k * stride], table);
+}
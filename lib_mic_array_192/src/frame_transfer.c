@@ -3,11 +3,36 @@
 
 #include <xcore/channel.h>
 #include <xcore/channel_transaction.h>
+#include <xcore/channel_streaming.h>
 #include <stdio.h>
 
+#include "xmath/xmath.h"
+
 #include "mic_array/frame_transfer.h"
 
 
+static void t_chan_out_buf_packed(
+    transacting_chanend_t* ct,
+    const void* buff,
+    const unsigned bytes)
+{
+  t_chan_out_buf_word(ct, (uint32_t*) buff, bytes / 4);
+  if(bytes % 4)
+    t_chan_out_buf_byte(ct, &((uint8_t*) buff)[bytes & ~3], bytes % 4);
+}
+
+
+static void t_chan_in_buf_packed(
+    transacting_chanend_t* ct,
+    void* buff,
+    const unsigned bytes)
+{
+  t_chan_in_buf_word(ct, (uint32_t*) buff, bytes / 4);
+  if(bytes % 4)
+    t_chan_in_buf_byte(ct, &((uint8_t*) buff)[bytes & ~3], bytes % 4);
+}
+
+
 void ma_frame_tx(
     const chanend_t c_frame_out,
     const int32_t frame[],
@@ -52,3 +77,211 @@ void ma_frame_rx_transpose(
   }
   chan_complete_transaction(ct_frame);
 }
+
+
+void ma_frame_tx_stamped(
+    const chanend_t c_frame_out,
+    const ma_frame_header_t* header,
+    const int32_t frame[],
+    const unsigned channel_count,
+    const unsigned sample_count)
+{
+  transacting_chanend_t ct_frame = chan_init_transaction_master(c_frame_out);
+  t_chan_out_word(&ct_frame, header->sample_index);
+  t_chan_out_word(&ct_frame, header->timestamp);
+  t_chan_out_buf_word(&ct_frame, 
+                      (uint32_t*) frame, 
+                      channel_count * sample_count);
+  chan_complete_transaction(ct_frame);
+}
+
+
+void ma_frame_rx_stamped(
+    ma_frame_header_t* header,
+    int32_t frame[],
+    const chanend_t c_frame_in,
+    const unsigned channel_count,
+    const unsigned sample_count)
+{
+  transacting_chanend_t ct_frame = chan_init_transaction_slave(c_frame_in);
+  header->sample_index = t_chan_in_word(&ct_frame);
+  header->timestamp = t_chan_in_word(&ct_frame);
+  t_chan_in_buf_word(&ct_frame, 
+                     (uint32_t*) frame, 
+                     channel_count * sample_count);
+  chan_complete_transaction(ct_frame);
+}
+
+
+int32_t* ma_frame_rx_ptr(
+    const chanend_t c_frame_in)
+{
+  return (int32_t*) s_chan_in_word(c_frame_in);
+}
+
+
+void ma_frame_release(
+    const chanend_t c_frame_in)
+{
+  s_chan_out_word(c_frame_in, 0);
+}
+
+
+void ma_s32_to_s16(
+    int16_t dst[],
+    const int32_t src[],
+    const unsigned count)
+{
+  if(!((((uintptr_t) dst) | ((uintptr_t) src)) & 3)){
+    vect_s32_to_vect_s16(dst, src, count, 16);
+    return;
+  }
+
+  for(int k = 0; k < count; k++){
+    const int32_t v = src[k];
+    dst[k] = (v >= 0x7FFF8000)? 0x7FFF : ((v + 0x8000) >> 16);
+  }
+}
+
+
+void ma_s32_to_s24(
+    uint8_t dst[],
+    const int32_t src[],
+    const unsigned count)
+{
+  for(int k = 0; k < count; k++){
+    const int32_t v = (src[k] >= 0x7FFFFF80)? 0x7FFFFF : ((src[k] + 0x80) >> 8);
+    dst[3*k + 0] = (uint8_t) v;
+    dst[3*k + 1] = (uint8_t) (v >> 8);
+    dst[3*k + 2] = (uint8_t) (v >> 16);
+  }
+}
+
+
+void ma_s32_to_f32(
+    float dst[],
+    const int32_t src[],
+    const unsigned count,
+    const float scale)
+{
+  for(int k = 0; k < count; k++)
+    dst[k] = ((float) src[k]) * scale;
+}
+
+
+void ma_frame_tx_s16(
+    const chanend_t c_frame_out,
+    const int16_t frame[],
+    const unsigned channel_count,
+    const unsigned sample_count)
+{
+  transacting_chanend_t ct_frame = chan_init_transaction_master(c_frame_out);
+  t_chan_out_buf_packed(&ct_frame, frame, 2 * channel_count * sample_count);
+  chan_complete_transaction(ct_frame);
+}
+
+
+void ma_frame_rx_s16(
+    int16_t frame[],
+    const chanend_t c_frame_in,
+    const unsigned channel_count,
+    const unsigned sample_count)
+{
+  transacting_chanend_t ct_frame = chan_init_transaction_slave(c_frame_in);
+  t_chan_in_buf_packed(&ct_frame, frame, 2 * channel_count * sample_count);
+  chan_complete_transaction(ct_frame);
+}
+
+
+void ma_frame_tx_s24(
+    const chanend_t c_frame_out,
+    const uint8_t frame[],
+    const unsigned channel_count,
+    const unsigned sample_count)
+{
+  transacting_chanend_t ct_frame = chan_init_transaction_master(c_frame_out);
+  t_chan_out_buf_packed(&ct_frame, frame, 3 * channel_count * sample_count);
+  chan_complete_transaction(ct_frame);
+}
+
+
+void ma_frame_rx_s24(
+    uint8_t frame[],
+    const chanend_t c_frame_in,
+    const unsigned channel_count,
+    const unsigned sample_count)
+{
+  transacting_chanend_t ct_frame = chan_init_transaction_slave(c_frame_in);
+  t_chan_in_buf_packed(&ct_frame, frame, 3 * channel_count * sample_count);
+  chan_complete_transaction(ct_frame);
+}
+
+
+void ma_frame_tx_f32(
+    const chanend_t c_frame_out,
+    const float frame[],
+    const unsigned channel_count,
+    const unsigned sample_count)
+{
+  transacting_chanend_t ct_frame = chan_init_transaction_master(c_frame_out);
+  t_chan_out_buf_word(&ct_frame, (uint32_t*) frame, 
+                      channel_count * sample_count);
+  chan_complete_transaction(ct_frame);
+}
+
+
+void ma_frame_rx_f32(
+    float frame[],
+    const chanend_t c_frame_in,
+    const unsigned channel_count,
+    const unsigned sample_count)
+{
+  transacting_chanend_t ct_frame = chan_init_transaction_slave(c_frame_in);
+  t_chan_in_buf_word(&ct_frame, (uint32_t*) frame, 
+                     channel_count * sample_count);
+  chan_complete_transaction(ct_frame);
+}
+
+
+void ma_frame_stream_rx_init(
+    const chanend_t c_frame_in,
+    const unsigned credits)
+{
+  for(int k = 0; k < credits; k++)
+    s_chan_out_byte(c_frame_in, 0);
+}
+
+
+void ma_frame_stream_tx(
+    const chanend_t c_frame_out,
+    const int32_t frame[],
+    const unsigned channel_count,
+    const unsigned sample_count)
+{
+  (void) s_chan_in_byte(c_frame_out);
+  s_chan_out_buf_word(c_frame_out, 
+                      (uint32_t*) frame, 
+                      channel_count * sample_count);
+}
+
+
+void ma_frame_stream_rx(
+    int32_t frame[],
+    const chanend_t c_frame_in,
+    const unsigned channel_count,
+    const unsigned sample_count)
+{
+  s_chan_in_buf_word(c_frame_in, 
+                     (uint32_t*) frame, 
+                     channel_count * sample_count);
+  s_chan_out_byte(c_frame_in, 0);
+}
+
+
+void ma_frame_stream_tx_end(
+    const chanend_t c_frame_out,
+    const unsigned credits)
+{
+  for(int k = 0; k < credits; k++)
+    (void) s_chan_in_byte(c_frame_out);
+}
@@ -0,0 +1,42 @@
+// Copyright 2022-2024 XMOS LIMITED.
+// This Software is subject to the terms of the XMOS Public Licence: Version 1.
+
+#include <cassert>
+
+#include "mic_array.h"
+#include "mic_array/cpp/Instance.hpp"
+
+
+// The PDM rx ISR has a single, global context (pdm_rx_isr_context), so only
+// one instance may use it.
+static ma_instance_t* isr_instance = nullptr;
+
+
+void ma_init(
+    ma_instance_t* handle,
+    const ma_config_t* cfg)
+{
+  handle->use_pdm_thread = cfg->use_pdm_thread;
+  handle->init(handle->mics, cfg);
+}
+
+
+void ma_task(
+    ma_instance_t* handle,
+    chanend_t c_frames_out)
+{
+  if(!handle->use_pdm_thread){
+    assert(isr_instance == nullptr || isr_instance == handle);
+    isr_instance = handle;
+  }
+
+  handle->task(handle->mics, c_frames_out, handle->use_pdm_thread);
+}
+
+
+void ma_pdm_rx_task(
+    ma_instance_t* handle)
+{
+  assert(handle->use_pdm_thread);
+  handle->pdm_rx_task(handle->mics);
+}
@@ -8,6 +8,10 @@
 #include <xccompat.h>
 #include <xclib.h>
 #include <xscope.h>
+#include <xcore/hwtimer.h>
+#include <xcore/chanend.h>
+#include <xcore/channel_streaming.h>
+#include <xcore/port.h>
 
 #include <stdio.h>
 #include <stdint.h>
@@ -46,16 +50,122 @@ void mic_array_resources_configure(
 }
 
 
+
+void mic_array_resources_configure_port(
+    const pdm_rx_resources_t* pdm_res,
+    port_t p_pdm_mics)
+{
+  const unsigned is_ddr = pdm_res->clock_b != 0;
+
+  port_reset(p_pdm_mics);
+  port_start_buffered(p_pdm_mics, 32);
+  port_set_clock(p_pdm_mics, is_ddr? pdm_res->clock_b
+                                   : pdm_res->clock_a);
+  port_clear_buffer(p_pdm_mics);
+}
+
+
+
+void mic_array_pdm_forward(
+    port_t p_pdm_mics,
+    chanend_t c_pdm_words)
+{
+  while(1){
+    s_chan_out_word(c_pdm_words, port_in(p_pdm_mics));
+  }
+}
+
+
 void mic_array_pdm_clock_start(
     pdm_rx_resources_t* pdm_res,
     int divide)
 {
-  // Start the clock with half the speed
-  clock_set_divide(pdm_res->clock_a, divide);
+  const uint32_t due = mic_array_pdm_clock_start_async(pdm_res, divide, 
+                                    MIC_ARRAY_CONFIG_PDM_WARMUP_US,
+                                    MIC_ARRAY_CONFIG_PDM_WARMUP_SLOWDOWN);
+  mic_array_pdm_clock_ramp(pdm_res, divide, due);
+}
+
+
+uint32_t mic_array_pdm_clock_start_sync(
+    pdm_rx_resources_t* pdm_res,
+    int divide,
+    port_t p_sync,
+    chanend_t c_sync)
+{
+  const uint32_t due = mic_array_pdm_clock_start_async(pdm_res, divide, 
+                                    MIC_ARRAY_CONFIG_PDM_WARMUP_US,
+                                    MIC_ARRAY_CONFIG_PDM_WARMUP_SLOWDOWN);
+
+  // Wait out the warm-up first, so nothing delays the start after the signal
+  const int32_t remaining = (int32_t) (due - get_reference_time());
+  if(remaining > 0)
+    delay_ticks(remaining);
+
+  if(c_sync)
+    (void) chanend_in_word(c_sync);
+
+  if(p_sync){
+    port_enable(p_sync);
+    (void) port_in_when_pinseq(p_sync, PORT_UNBUFFERED, 0);
+    (void) port_in_when_pinseq(p_sync, PORT_UNBUFFERED, 1);
+  }
+
+  const uint32_t start = get_reference_time();
+  mic_array_pdm_clock_ramp(pdm_res, divide, start);
+
+  if(p_sync)
+    port_disable(p_sync);
+
+  return start;
+}
+
+
+uint32_t mic_array_pdm_clock_start_async(
+    pdm_rx_resources_t* pdm_res,
+    int divide,
+    unsigned warmup_us,
+    unsigned warmup_slowdown)
+{
+  const uint32_t now = get_reference_time();
+
+  if(!warmup_us)
+    return now;
+
+  // Start the clock at the reduced speed
+  clock_set_divide(pdm_res->clock_a, warmup_slowdown * divide / 2);
   clock_start(pdm_res->clock_a);
 
+  return now + warmup_us * XS1_TIMER_MHZ;
+}
+
+
+void mic_array_pdm_clock_set_divide(
+    pdm_rx_resources_t* pdm_res,
+    int divide)
+{
+  clock_stop(pdm_res->clock_a);
+
+  if( pdm_res->clock_b != 0 ) {
+    clock_stop(pdm_res->clock_b);
+    clock_set_divide(pdm_res->clock_b, divide/4);
+  }
+
+  mic_array_pdm_clock_ramp(pdm_res, divide, get_reference_time());
+}
+
+
+void mic_array_pdm_clock_ramp(
+    pdm_rx_resources_t* pdm_res,
+    int divide,
+    uint32_t due)
+{
+  // Wait out whatever is left of the warm-up
+  const int32_t remaining = (int32_t) (due - get_reference_time());
+  if(remaining > 0)
+    delay_ticks(remaining);
+
   // Stop and set to the normal speed
-  delay_milliseconds(50);
   clock_stop(pdm_res->clock_a);
   clock_set_divide(pdm_res->clock_a, divide/2);
 
@@ -83,3 +193,11 @@ void mic_array_pdm_clock_start(
     clock_start(pdm_res->clock_a);
   }
 }
+
+
+void mic_array_tile_clock_divide(
+    unsigned divide)
+{
+  write_pswitch_reg(get_local_tile_id(), XS1_PSWITCH_PLL_CLK_DIVIDER_NUM, 
+                    divide - 1);
+}
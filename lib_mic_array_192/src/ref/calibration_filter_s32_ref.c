@@ -0,0 +1,46 @@
+// Copyright 2022-2024 XMOS LIMITED.
+// This Software is subject to the terms of the XMOS Public Licence: Version 1.
+
+#if !defined(__XS3A__)
+
+/*
+  Portable C implementation of calibration_filter_s32(), used when the library
+  is not built for xcore.ai. Results are bit-exact with the VPU version.
+*/
+
+#include "mic_array/etc/calibration_filter_s32.h"
+
+
+static inline int64_t sat40(const int64_t a)
+{
+  const int64_t max = (((int64_t) 1) << 39) - 1;
+  return (a > max)? max : (a < -max)? -max : a;
+}
+
+static inline int32_t sat32(const int64_t a)
+{
+  return (a > INT32_MAX)? INT32_MAX : (a < -INT32_MAX)? -INT32_MAX : a;
+}
+
+
+void calibration_filter_s32(
+    int32_t out[],
+    const int32_t window[],
+    const int32_t coef[],
+    unsigned chan_count,
+    unsigned tap_count)
+{
+  for(unsigned k = 0; k < chan_count; k++){
+    int64_t acc = 0;
+
+    for(unsigned i = 0; i < tap_count; i++){
+      const int64_t p = ((int64_t) coef[i * chan_count + k]) 
+                      * window[i * chan_count + k];
+      acc = sat40(acc + ((p + (1 << 29)) >> 30));
+    }
+
+    out[k] = sat32(acc);
+  }
+}
+
+#endif // !defined(__XS3A__)
@@ -0,0 +1,27 @@
+// Copyright 2022-2024 XMOS LIMITED.
+// This Software is subject to the terms of the XMOS Public Licence: Version 1.
+
+#if !defined(__XS3A__)
+
+/*
+  Portable C implementation of dcoe_filter_block(), used when the library is
+  not built for xcore.ai.
+*/
+
+#include "mic_array/dc_elimination.h"
+
+
+void dcoe_filter_block(
+    int32_t samples[],
+    int32_t state[],
+    const unsigned chan_count,
+    const unsigned sample_count,
+    const unsigned pole_shr)
+{
+  // A single sample in [sample][channel] order is also a frame of one sample
+  // in [channel][sample] order.
+  for(unsigned t = 0; t < sample_count; t++)
+    dcoe_filter_frame(&samples[t * chan_count], state, chan_count, 1, pole_shr);
+}
+
+#endif // !defined(__XS3A__)
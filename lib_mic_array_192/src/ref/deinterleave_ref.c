@@ -0,0 +1,107 @@
+// Copyright 2022-2024 XMOS LIMITED.
+// This Software is subject to the terms of the XMOS Public Licence: Version 1.
+
+#if !defined(__XS3A__)
+
+/*
+  Portable C implementations of the deinterleaving functions declared in
+  util.h, used when the library is not built for xcore.ai.
+*/
+
+#include "mic_array/util.h"
+
+#include <string.h>
+
+
+// Bit g of the interleaved subblock (counting from bit 0 of its last word)
+// is bit g / chans of channel g % chans.
+static void deinterleave_n(
+    uint32_t* words,
+    const unsigned chans)
+{
+  uint32_t out[16] = {0};
+
+  for(unsigned g = 0; g < 32 * chans; g++){
+    const uint32_t bit = (words[chans - 1 - g / 32] >> (g % 32)) & 1;
+    out[g % chans] |= bit << (g / chans);
+  }
+
+  memcpy(words, out, sizeof(uint32_t) * chans);
+}
+
+
+static void deinterleave_n_map(
+    uint32_t* dst,
+    uint32_t* src,
+    const unsigned chans,
+    const unsigned subblocks,
+    const unsigned* channel_map,
+    const unsigned channels_out)
+{
+  for(unsigned sb = 0; sb < subblocks; sb++)
+    deinterleave_n(&src[sb * chans], chans);
+
+  // The oldest subblock is last in src, and first in each channel of dst.
+  for(unsigned k = 0; k < channels_out; k++)
+    for(unsigned sb = 0; sb < subblocks; sb++)
+      dst[k * subblocks + sb] = src[(subblocks - 1 - sb) * chans + channel_map[k]];
+}
+
+
+void deinterleave2(uint32_t* samples)  { deinterleave_n(samples, 2);  }
+void deinterleave4(uint32_t* samples)  { deinterleave_n(samples, 4);  }
+void deinterleave8(uint32_t* samples)  { deinterleave_n(samples, 8);  }
+void deinterleave16(uint32_t* samples) { deinterleave_n(samples, 16); }
+
+
+void deinterleave8_block(
+    uint32_t* samples,
+    unsigned subblocks)
+{
+  for(unsigned sb = 0; sb < subblocks; sb++)
+    deinterleave_n(&samples[8 * sb], 8);
+}
+
+
+void deinterleave16_block(
+    uint32_t* samples,
+    unsigned subblocks)
+{
+  for(unsigned sb = 0; sb < subblocks; sb++)
+    deinterleave_n(&samples[16 * sb], 16);
+}
+
+
+void deinterleave8_then_map(
+    uint32_t* dst,
+    uint32_t* src,
+    unsigned subblocks,
+    const unsigned* channel_map,
+    unsigned channels_out)
+{
+  deinterleave_n_map(dst, src, 8, subblocks, channel_map, channels_out);
+}
+
+
+void deinterleave16_then_map(
+    uint32_t* dst,
+    uint32_t* src,
+    unsigned subblocks,
+    const unsigned* channel_map,
+    unsigned channels_out)
+{
+  deinterleave_n_map(dst, src, 16, subblocks, channel_map, channels_out);
+}
+
+
+void deinterleave16_ddr(
+    uint32_t* dst,
+    uint32_t* src,
+    unsigned subblocks)
+{
+  static const unsigned direct_map[16] = 
+      {0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15};
+  deinterleave_n_map(dst, src, 16, subblocks, direct_map, 16);
+}
+
+#endif // !defined(__XS3A__)
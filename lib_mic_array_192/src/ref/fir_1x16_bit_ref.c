@@ -0,0 +1,117 @@
+// Copyright 2022-2024 XMOS LIMITED.
+// This Software is subject to the terms of the XMOS Public Licence: Version 1.
+
+#if !defined(__XS3A__)
+
+/*
+  Portable C implementations of the 1-bit FIR kernels declared in
+  fir_1x16_bit.h, used when the library is not built for xcore.ai (e.g. the
+  host benchmark in tests/host_benchmark). Results are bit-exact with the VPU
+  versions.
+*/
+
+#include "mic_array/etc/fir_1x16_bit.h"
+
+
+static inline unsigned popcount32(uint32_t x)
+{
+  x = x - ((x >> 1) & 0x55555555);
+  x = (x & 0x33333333) + ((x >> 2) & 0x33333333);
+  x = (x + (x >> 4)) & 0x0F0F0F0F;
+  return (x * 0x01010101) >> 24;
+}
+
+
+// One 256-tap slice. Each group of 8 coefficient words is a bit plane, and
+// VLMACCR1 adds 128 minus the number of bits in which the plane and the
+// signal differ. The planes are then weighted 1, 2, 4 .. 2^(planes-2), and
+// 2^(planes-1) - 1 for the last, and the result is scaled to match 16 planes.
+static int32_t fir_1x16_bit_slice(
+    const uint32_t signal[],
+    const uint32_t coeff_1[],
+    const unsigned planes)
+{
+  int32_t acc = 0;
+
+  for(unsigned bit = 0; bit < planes; bit++){
+    int32_t plane = 128;
+    for(unsigned k = 0; k < 8; k++)
+      plane -= popcount32(signal[k] ^ coeff_1[8 * bit + k]);
+    acc += plane * ((bit == planes - 1)? ((1 << bit) - 1) : (1 << bit));
+  }
+
+  return (int32_t) (((uint32_t) acc) << (24 - planes));
+}
+
+
+int fir_1x16_bit(
+    uint32_t signal[], 
+    const uint32_t coeff_1[])
+{
+  return fir_1x16_bit_slice(signal, coeff_1, 16);
+}
+
+
+void fir_1x16_bit_dual_signal(
+    int32_t out[2],
+    uint32_t signal_a[], 
+    uint32_t signal_b[], 
+    const uint32_t coeff_1[])
+{
+  out[0] = fir_1x16_bit_slice(signal_a, coeff_1, 16);
+  out[1] = fir_1x16_bit_slice(signal_b, coeff_1, 16);
+}
+
+
+void fir_1x16_bit_multi(
+    const uint32_t signal[], 
+    const uint32_t coeff_1[],
+    int32_t out[],
+    unsigned count,
+    unsigned stride)
+{
+  for(unsigned k = 0; k < count; k++)
+    out[k] = fir_1x16_bit_slice(&signal[k * stride], coeff_1, 16);
+}
+
+
+int fir_1x12_bit(
+    uint32_t signal[], 
+    const uint32_t coeff_1[])
+{
+  return fir_1x16_bit_slice(signal, coeff_1, 12);
+}
+
+
+int fir_1x8_bit(
+    uint32_t signal[], 
+    const uint32_t coeff_1[])
+{
+  return fir_1x16_bit_slice(signal, coeff_1, 8);
+}
+
+
+void fir_1x12_bit_multi(
+    const uint32_t signal[], 
+    const uint32_t coeff_1[],
+    int32_t out[],
+    unsigned count,
+    unsigned stride)
+{
+  for(unsigned k = 0; k < count; k++)
+    out[k] = fir_1x16_bit_slice(&signal[k * stride], coeff_1, 12);
+}
+
+
+void fir_1x8_bit_multi(
+    const uint32_t signal[], 
+    const uint32_t coeff_1[],
+    int32_t out[],
+    unsigned count,
+    unsigned stride)
+{
+  for(unsigned k = 0; k < count; k++)
+    out[k] = fir_1x16_bit_slice(&signal[k * stride], coeff_1, 8);
+}
+
+#endif // !defined(__XS3A__)
@@ -0,0 +1,62 @@
+// Copyright 2022-2024 XMOS LIMITED.
+// This Software is subject to the terms of the XMOS Public Licence: Version 1.
+
+#if !defined(__XS3A__)
+
+/*
+  Portable C implementation of fir_s16_multi(), used when the library is not
+  built for xcore.ai. Results are bit-exact with the VPU version.
+*/
+
+#include "mic_array/etc/fir_s16_multi.h"
+
+
+// The VPU's 32-bit accumulators (in 16-bit mode) saturate.
+static inline int64_t sat32(const int64_t a)
+{
+  return (a > INT32_MAX)? INT32_MAX : (a < -INT32_MAX)? -INT32_MAX : a;
+}
+
+
+void fir_s16_multi(
+    int32_t out[],
+    const int16_t signal[],
+    const int16_t coef[],
+    unsigned count,
+    unsigned stride,
+    unsigned tap_blocks,
+    right_shift_t shr)
+{
+  for(unsigned c0 = 0; c0 < count; c0 += 16){
+    // Lanes per phase for this batch, as chosen by the VPU version.
+    unsigned width = 16;
+    while(width > 1 && (width / 2) >= (count - c0))
+      width /= 2;
+    const unsigned phases = 16 / width;
+
+    for(unsigned k = c0; k < count && k < c0 + width; k++){
+      const int16_t* x = &signal[k * stride];
+      int64_t total = 0;
+
+      for(unsigned p = 0; p < phases; p++){
+        int64_t acc = 0;
+        for(unsigned blk = p; blk < tap_blocks; blk += phases){
+          int64_t dot = 0;
+          for(unsigned i = 16 * blk; i < 16 * (blk + 1); i++)
+            dot += ((int32_t) coef[i]) * x[i];
+          acc = sat32(acc + dot);
+        }
+        total += acc;
+      }
+
+      total = sat32(total);
+
+      if(shr > 0)
+        total = (total + (((int64_t) 1) << (shr - 1))) >> shr;
+
+      out[k] = (int32_t) total;
+    }
+  }
+}
+
+#endif // !defined(__XS3A__)
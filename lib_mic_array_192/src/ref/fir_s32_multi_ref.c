@@ -0,0 +1,52 @@
+// Copyright 2022-2024 XMOS LIMITED.
+// This Software is subject to the terms of the XMOS Public Licence: Version 1.
+
+#if !defined(__XS3A__)
+
+/*
+  Portable C implementation of fir_s32_multi(), used when the library is not
+  built for xcore.ai. Results are bit-exact with the VPU version.
+*/
+
+#include "mic_array/etc/fir_s32_multi.h"
+
+
+// The VPU's 40-bit accumulators saturate.
+static inline int64_t sat40(const int64_t a)
+{
+  const int64_t max = (((int64_t) 1) << 39) - 1;
+  return (a > max)? max : (a < -max)? -max : a;
+}
+
+static inline int32_t sat32(const int64_t a)
+{
+  return (a > INT32_MAX)? INT32_MAX : (a < -INT32_MAX)? -INT32_MAX : a;
+}
+
+
+void fir_s32_multi(
+    int32_t out[],
+    const int32_t signal[],
+    const int32_t coef[],
+    unsigned count,
+    unsigned stride,
+    unsigned tap_blocks,
+    right_shift_t shr)
+{
+  for(unsigned k = 0; k < count; k++){
+    const int32_t* x = &signal[k * stride];
+    int64_t acc = 0;
+
+    for(unsigned i = 0; i < 8 * tap_blocks; i++){
+      const int64_t p = ((int64_t) coef[i]) * x[i];
+      acc = sat40(acc + ((p + (1 << 29)) >> 30));
+    }
+
+    if(shr > 0)
+      acc = (acc + (((int64_t) 1) << (shr - 1))) >> shr;
+
+    out[k] = sat32(acc);
+  }
+}
+
+#endif // !defined(__XS3A__)
@@ -185,6 +185,47 @@ def design_3_stage(fs_0, decimations, ma_stages, stage_2: stage_params, stage_3:
     return coeffs
 
 
+def design_1_stage_192(fs_0, stage_1: stage_params, int_coeffs=False, zero_taps=16):
+    """
+    Design the single stage filter of the 192 kHz (16x) decimator.
+
+    OneStageDecimator192 filters each 32-sample PDM word twice with the same
+    256-tap table, the second time against a copy of the history delayed by
+    half a word. That only works if the taps on the newest 16 samples are
+    zero, so the designed filter (at most 256 - zero_taps taps) is padded with
+    zeros at the end, in the order expected by Stage1Filter.
+
+    Parameters
+    ----------
+    fs_0 : int
+        input sample frequency
+    stage_1 : stage_params
+        A stage_params class, specifying the design parameters. Only cutoff,
+        taps and fir_window are used.
+    int_coeffs : bool
+        Whether to return int16 filter coeffcients. If false, return floats
+    zero_taps : int
+        Number of zero taps required at the end of the 256.
+
+    Returns
+    -------
+    coeffs : list
+        The filter coefficients in a packed format [stage][coefficients, decimation_ratio]
+
+    """
+    assert stage_1.taps <= 256 - zero_taps, \
+        f"192 kHz filter can have at most {256 - zero_taps} taps"
+
+    coeff_1 = spsig.firwin(stage_1.taps, stage_1.cutoff, window=stage_1.fir_window, fs=fs_0)
+
+    if int_coeffs:
+        coeff_1 = ft.float_coeffs_to_int16(coeff_1)
+
+    coeff_1 = np.concatenate((coeff_1, np.zeros(256 - stage_1.taps, dtype=coeff_1.dtype)))
+
+    return [[coeff_1, 16]]
+
+
 def small_2_stage_filter(int_coeffs: bool):
     """
     Design a 2 stage decimation filter for 3.072 Mhz to 16 kHz with a small number of taps
@@ -358,6 +399,30 @@ def small_48k_filter(int_coeffs: bool):
     return coeffs
 
 
+def good_192k_filter(int_coeffs: bool):
+    """
+    Design the single stage decimation filter for 3.072 MHz to 192 kHz
+
+    These are the design parameters of the filter supplied in
+    src/etc/stage1_192_fir_coef.c. The passband extends to around 80 kHz.
+
+    If int_coeffs is True, int16 filter coefficients are returned.
+    Otherwise, float coefficients are returned
+    """
+
+    fs_0 = 3072000
+
+    cutoff = 80000
+    transition_bandwidth = 0
+    taps_1 = 240
+    fir_window = ("kaiser", 4.0)
+    stage_1 = stage_params(cutoff, transition_bandwidth, taps_1, fir_window)
+
+    coeffs = design_1_stage_192(fs_0, stage_1, int_coeffs=int_coeffs)
+
+    return coeffs
+
+
 def main():
     coeffs = small_2_stage_filter(int_coeffs=True)
     out_path = "small_2_stage_filter_int.pkl"
@@ -386,5 +451,9 @@ def main():
     out_path = "small_48k_filter_int.pkl"
     ft.save_packed_filter(out_path, coeffs)
 
+    coeffs = good_192k_filter(int_coeffs=True)
+    out_path = "good_192k_filter_int.pkl"
+    ft.save_packed_filter(out_path, coeffs)
+
 if __name__ == "__main__":
     main()
@@ -164,6 +164,14 @@ def float_coeffs_to_int32(b):
     return b
 
 
+def float_coeffs_to_int16(b):
+    """convert floating point coefficients to int16, scaled so that the
+    largest is 32767 (the largest value a fir_1x16_bit() coefficient can take)
+    """
+    b = np.round(b/np.max(np.abs(b)) * 32767)
+    return b.astype(np.int16)
+
+
 def combined_filter(coeff_1, coeff_2, decimation_1):
     """Upsample the 2nd stage coefficients by the 1st stage filter
 
@@ -24,20 +24,26 @@ class Stage1Filter(object):
   INT16_MAX_COEFFICIENT = 32766
   BLOCK_SIZE = 256
 
-  def __init__(self, coefs: np.ndarray, decimation_factor: int = 32):
+  def __init__(self, coefs: np.ndarray, decimation_factor: int = 32, coef_bits: int = 16):
 
     assert (coefs.ndim == 1), "Stage1Filter coefs must be a single dimensional ndarray"
     assert (len(coefs) % Stage1Filter.BLOCK_SIZE == 0), f"Stage1Filter must have a multiple of 256 coefficients ({len(coefs)})"
     assert (coefs.dtype == np.int16), "Stage1Filter coefs must have dtype np.int16"
+    assert coef_bits in (16, 12, 8), "Stage1Filter coef_bits must be 16, 12 or 8"
+    assert np.max(np.abs(coefs.astype(np.int32))) < 2**(coef_bits-1), \
+      f"Stage1Filter coefs must fit in {coef_bits} bits"
 
     # The decimation factor
     self.dec_factor = decimation_factor
 
+    # The number of coefficient bit-planes, and so of VLMACCR1s per 256 taps
+    self.coef_bits = coef_bits
+
     # The coefficients themselves
     self.coefs = coefs
 
     # The bipolar {-1,1} filter coefficient representation
-    self.coefs_bipolar = util.int16_vect_to_bipolar_matrix(self.coefs, util.int16_dual)
+    self.coefs_bipolar = util.int16_vect_to_bipolar_matrix(self.coefs, util.coef_dual(coef_bits))
 
     # The binary {1,0} filter coefficient representation
     #  (note that the binary matrix is from the bipolar transposed)
@@ -50,6 +56,10 @@ class Stage1Filter(object):
   @property
   def TapCount(self):
     return len(self.coefs)
+
+  @property
+  def CoefBits(self):
+    return self.coef_bits
   
   @property
   def BlockCount(self):
@@ -215,7 +225,257 @@ class TwoStageFilter(object):
     s1_output = self.s1.FilterInt16(pdm_signal)
     return self.s2.FilterInt32(s1_output)
 
-    
+
+# Stage 1 coefficients of OneStageDecimator192, as stored on the device
+# (s1_fir_coef in src/etc/stage1_192_fir_coef.c).
+S1_FIR_COEF_192 = np.array([
+  0xFFFFDA39, 0xBFF03D14, 0x538A5CDE, 0xCE092678, 0xAA551E64, 0x90737B3A, 0x51CA28BC, 0x0FFD9C5B,
+  0xFFFF0B0A, 0x66F123BA, 0x52CDEEBC, 0x9ABFF4AE, 0xF66F752F, 0xFD593D77, 0xB34A5DC4, 0x8F6650D0,
+  0xFFFFE5F6, 0x6942B926, 0xA4759759, 0x7664D0A0, 0xA815050B, 0x266E9AE9, 0xAE25649D, 0x42966FA7,
+  0xFFFF9207, 0xCF40DCF9, 0x3DBEE8B1, 0xBF02757E, 0xF00F7EAE, 0x40FD8D17, 0x7DBC9F3B, 0x02F3E049,
+  0xFFFFA150, 0xE96BC170, 0x45B01821, 0x3D7A8121, 0xEE778481, 0x5EBC8418, 0x0DA20E83, 0xD6970A85,
+  0xFFFF959A, 0x0626D835, 0x1E635D0D, 0x75D96DDB, 0xF24FDBB6, 0x9BAEB0BA, 0xC678AC1B, 0x646059A9,
+  0xFFFF8CB6, 0x0AE19A19, 0xBB279875, 0xCD6B6F6F, 0x8001F6F6, 0xD6B3AE19, 0xE4DD9859, 0x87506D31,
+  0xFFFF7C71, 0xF34AE6A1, 0xD79AB09E, 0x821667F1, 0xD42B8FE6, 0x6841790D, 0x59EB8567, 0x52CF8E3E,
+  0xFFFFFC0F, 0xFC730194, 0xB0298AF7, 0xAAEDFBAA, 0x7E7E55DF, 0xB755EF51, 0x940D2980, 0xCE3FF03F,
+  0xFFFFFC00, 0x007C0073, 0x8FCD2CF2, 0xCCA10833, 0xDC3BCC10, 0x85334F34, 0xB3F1CE00, 0x3E00003F,
+  0xFFFFFC00, 0x007FFFF0, 0x7FF1CF0E, 0x5A61A7C3, 0xC813C3E5, 0x865A70F3, 0x8FFE0FFF, 0xFE00003F,
+  0xFFFFFC00, 0x007FFFF0, 0x0001F001, 0xC61E3556, 0x90096AAC, 0x7863800F, 0x80000FFF, 0xFE00003F,
+  0xFFFFFC00, 0x007FFFF0, 0x0001FFFF, 0xC1FFC664, 0xE0072663, 0xFF83FFFF, 0x80000FFF, 0xFE00003F,
+  0xFFFFFC00, 0x007FFFF0, 0x0001FFFF, 0xC0000787, 0x0000E1E0, 0x0003FFFF, 0x80000FFF, 0xFE00003F,
+  0xFFFFFC00, 0x007FFFF0, 0x0001FFFF, 0xC00007F8, 0x00001FE0, 0x0003FFFF, 0x80000FFF, 0xFE00003F,
+  0x000003FF, 0xFF80000F, 0xFFFE0000, 0x3FFFF800, 0x0000001F, 0xFFFC0000, 0x7FFFF000, 0x01FFFFC0,
+], dtype=np.uint32)
+
+
+def requantize_coefs(coefs: np.ndarray, coef_bits: int) -> np.ndarray:
+  """
+  Scale int16 stage 1 coefficients (at most 32767) down to coef_bits bits,
+  for use with fir_1x12_bit() or fir_1x8_bit().
+  """
+  scale = (2**(coef_bits-1) - 1) / 32767
+  return np.round(coefs.astype(np.float64) * scale).astype(np.int16)
+
+
+def stage2_coefs_s16(coefs: np.ndarray, shr: int):
+  """
+  Scale int32 stage 2 coefficients, with their output shift, down to int16
+  for Stage2FilterS16 (the S2_COEF_BITS = 16 TwoStageDecimator).
+
+  Both the coefficients and the stage 2 history lose their lower 16 bits,
+  while fir_s16_multi() lacks the 30-bit shift of 32-bit VPU products, so the
+  same output needs a shift 2 bits smaller. If shr is less than 2, the
+  coefficients are scaled down further instead. Returns (coefs, shr).
+  """
+  extra = max(0, 2 - shr)
+  scaled = np.round(coefs.astype(np.float64) / 2**(16 + extra))
+  return np.clip(scaled, -0x7FFF, 0x7FFF).astype(np.int16), shr - 2 + extra
+
+
+def fir_1x16_bit_taps(coef_words: np.ndarray, coef_bits: int = 16) -> np.ndarray:
+  """
+  Effective tap of each of the 256 signal bits of a fir_1x16_bit() call (or
+  fir_1x12_bit() or fir_1x8_bit(), for coef_bits of 12 or 8).
+
+  Each group of 8 coefficient words is a bit plane (weighted 1, 2, .. 16384,
+  32767), and VLMACCR1 adds 128 minus the number of bits in which a plane and
+  the signal differ. That is the same as the inner product of the bipolar
+  signal with these taps. Bit k of signal word j is tap 32*j+k.
+  """
+  coef_words = np.asarray(coef_words, dtype=np.uint32)
+  assert coef_words.shape == (8*coef_bits,), f"fir_1x{coef_bits}_bit() takes {8*coef_bits} coefficient words"
+  bits = util.bits_array(coef_words.astype('<u4')).reshape((coef_bits, 256))
+  planes = np.matmul(util.coef_dual(coef_bits).astype(np.int64), 1 - 2*bits.astype(np.int64))
+  # Both the 0x7FFF and 0x0001 weights are odd, so each sum is even.
+  return planes // 2
+
+
+class Fir1x16Bit(object):
+  """
+  Vectorised, bit-exact model of fir_1x16_bit() (or, with coef_bits of 12 or
+  8, of fir_1x12_bit() or fir_1x8_bit()).
+
+  Rather than emulating VLMACCR1 bit plane by bit plane, the 256 taps are
+  folded into a table of the contribution of each value of each of the 32
+  signal bytes, so that each output costs 32 lookups.
+  """
+
+  def __init__(self, coef_words: np.ndarray, coef_bits: int = 16):
+    self.taps = fir_1x16_bit_taps(coef_words, coef_bits)
+    # The kernels scale their results to match 16 bit-planes
+    self.shift = 24 - coef_bits
+    byte_bits = (np.arange(256)[:,np.newaxis] >> np.arange(8)) & 1
+    # table[p, v] is the contribution of signal byte p having value v
+    self.table = np.matmul(1 - 2*byte_bits, self.taps.reshape((32, 8)).T).T
+
+  def Accumulate(self, signal: np.ndarray) -> np.ndarray:
+    """
+    Inner products of (..., 8) word signals with the taps, before the final
+    shift applied by fir_1x16_bit(). Returns int64.
+    """
+    b = np.ascontiguousarray(signal, dtype='<u4').view(np.uint8)
+    return self.table[np.arange(32), b].sum(axis=-1)
+
+  def Filter(self, signal: np.ndarray) -> np.ndarray:
+    """
+    fir_1x16_bit() of each (..., 8) word signal. Returns int32.
+    """
+    return (self.Accumulate(signal) << self.shift).astype(np.int32)
+
+
+class OneStage192Filter(object):
+  """
+  Bit-exact model of OneStageDecimator192 (with NopSampleFilter).
+
+  Each PDM word gives two outputs: fir_1x16_bit() of the mic's 8-word PDM
+  history, and of its half-word delayed copy, whose newest word holds only
+  the upper half of the newest PDM word. Both are shifted left by 3 for
+  output. The history starts out filled with 0x55555555.
+
+  Windows are built for a whole chunk of blocks at once, so signals of
+  several minutes are practical.
+  """
+
+  DECIMATION_FACTOR = 16
+  HISTORY_WORDS = 8
+  HISTORY_FILL = 0x55555555
+
+  def __init__(self, coef_words: np.ndarray = S1_FIR_COEF_192, coef_bits: int = 16):
+    self.fir = Fir1x16Bit(coef_words, coef_bits)
+
+  @property
+  def DecimationFactor(self):
+    return OneStage192Filter.DECIMATION_FACTOR
+
+  def FilterWords(self, words: np.ndarray, chunk_blocks: int = 1 << 16,
+                  history: np.ndarray = None) -> np.ndarray:
+    """
+    Decimate PDM words, as delivered to the decimator (bit k of word j is
+    sample 32*j+k, and a set bit is -1).
+
+    words has shape (CHANS, BLOCKS) (or (BLOCKS,) for one channel). Returns
+    int32 of shape (CHANS, 2*BLOCKS), with the two outputs of each block in
+    the order ProcessBlock() writes them.
+
+    history, of shape (CHANS, HISTORY_WORDS-1), holds the PDM words which
+    preceded words, oldest first, and defaults to the initial fill. Passing
+    the last HISTORY_WORDS-1 words of one call to the next splits a signal
+    into chunks with no change to the output.
+    """
+    words = np.asarray(words, dtype=np.uint32)
+    if words.ndim == 1:
+      words = words[np.newaxis,:]
+    CHANS, BLOCKS = words.shape
+    H = OneStage192Filter.HISTORY_WORDS
+
+    if history is None:
+      history = np.full((CHANS, H-1), OneStage192Filter.HISTORY_FILL, dtype=np.uint32)
+    history = np.asarray(history, dtype=np.uint32).reshape((CHANS, H-1))
+    W = np.concatenate((history, words), axis=1)
+
+    # D[k] = (W[k] >> 16) | (W[k+1] << 16) is the delayed copy's word once the
+    # next PDM word has completed it. The last is never completed.
+    D = W >> 16
+    D[:,:-1] |= W[:,1:] << 16
+
+    hist = np.lib.stride_tricks.sliding_window_view(W, H, axis=1)[:,:,::-1]
+    delayed = np.lib.stride_tricks.sliding_window_view(D[:,:-1], H-1, axis=1)[:,:,::-1]
+
+    res = np.empty((CHANS, BLOCKS, 2), dtype=np.int32)
+    for start in range(0, BLOCKS, chunk_blocks):
+      end = min(start + chunk_blocks, BLOCKS)
+      win = np.empty((CHANS, end-start, 2, H), dtype=np.uint32)
+      win[:,:,0,:] = hist[:,start:end,:]
+      win[:,:,1,0] = W[:,H-1+start:H-1+end] >> 16
+      win[:,:,1,1:] = delayed[:,start:end,:]
+      # fir_1x16_bit() shifts left by 8, and the decimator by 3 more.
+      res[:,start:end,:] = (self.fir.Accumulate(win) << (self.fir.shift + 3)).astype(np.int32)
+
+    return res.reshape((CHANS, 2*BLOCKS))
+
+  def Filter(self, pdm_signal: np.ndarray, chunk_blocks: int = 1 << 16) -> np.ndarray:
+    """
+    Decimate a bipolar {-1,+1} PDM signal of shape (CHANS, SAMPS), SAMPS a
+    multiple of 32. Returns int32 of shape (CHANS, SAMPS // 16).
+    """
+    if pdm_signal.ndim == 1:
+      pdm_signal = pdm_signal[np.newaxis,:]
+    CHANS, SAMPS = pdm_signal.shape
+    assert SAMPS % 32 == 0, "OneStage192Filter takes whole PDM words"
+    binary = ((1 - pdm_signal) // 2).astype(np.uint8)
+    words = np.packbits(binary, axis=1, bitorder='little').view('<u4')
+    return self.FilterWords(words, chunk_blocks)
+
+
+
+class TwoStageDecimatorModel(object):
+  """
+  Bit-exact, streaming model of TwoStageDecimator (with NopSampleFilter).
+
+  Unlike TwoStageFilter, which computes the filters in floating point, this
+  follows the device's integer arithmetic: fir_1x16_bit() (or fir_1x12_bit()
+  or fir_1x8_bit()) of each mic's 8-word PDM history for stage 1, and for
+  stage 2 the Q30 products of fir_s32_multi(), each rounded, summed, then
+  shifted right by Shr with rounding and saturated to +/-INT32_MAX.
+
+  The PDM history starts out filled with 0x55555555 and the stage 2 history
+  with zeros, as after TwoStageDecimator::Init(). Both are kept between
+  calls to FilterWords(), so a signal of any length can be decimated one
+  chunk at a time.
+  """
+
+  HISTORY_WORDS = 8
+  HISTORY_FILL = 0x55555555
+
+  def __init__(self, chans: int, s1_coef_words: np.ndarray, s2_coef: np.ndarray,
+               s2_shr: int, s2_dec_factor: int, s1_coef_bits: int = 16):
+    self.fir = Fir1x16Bit(s1_coef_words, s1_coef_bits)
+    self.s2_coef = np.asarray(s2_coef, dtype=np.int64)
+    # Below 128 taps the VPU's 40-bit accumulator cannot saturate.
+    assert len(self.s2_coef) < 128, "Stage 2 filters are limited to 127 taps"
+    self.s2_shr = int(s2_shr)
+    self.s2_dec_factor = int(s2_dec_factor)
+    self.chans = chans
+    self.pdm_history = np.full((chans, self.HISTORY_WORDS - 1),
+                               self.HISTORY_FILL, dtype=np.uint32)
+    self.s1_history = np.zeros((chans, len(self.s2_coef) - 1), dtype=np.int64)
+
+  @property
+  def DecimationFactor(self):
+    return 32 * self.s2_dec_factor
+
+  def FilterWords(self, words: np.ndarray) -> np.ndarray:
+    """
+    Decimate the next PDM words (bit k of word j is sample 32*j+k, and a set
+    bit is -1) of shape (CHANS, WORDS), WORDS a multiple of the stage 2
+    decimation factor. Returns int32 of shape (CHANS, WORDS // s2_dec_factor).
+    """
+    words = np.asarray(words, dtype=np.uint32)
+    if words.ndim == 1:
+      words = words[np.newaxis,:]
+    CHANS, WORDS = words.shape
+    assert CHANS == self.chans
+    assert WORDS % self.s2_dec_factor == 0, "TwoStageDecimatorModel takes whole blocks"
+    H = self.HISTORY_WORDS
+    T = len(self.s2_coef)
+
+    # Stage 1: one output per PDM word, newest word first in each window
+    W = np.concatenate((self.pdm_history, words), axis=1)
+    win = np.lib.stride_tricks.sliding_window_view(W, H, axis=1)[:,:,::-1]
+    s1 = self.fir.Filter(win).astype(np.int64)
+    self.pdm_history = W[:,WORDS:]
+
+    # Stage 2: one output per block, at the block's last stage 1 sample
+    X = np.concatenate((self.s1_history, s1), axis=1)
+    ends = np.arange(self.s2_dec_factor - 1, WORDS, self.s2_dec_factor) + (T - 1)
+    acc = np.zeros((CHANS, len(ends)), dtype=np.int64)
+    for t in range(T):
+      acc += (self.s2_coef[t] * X[:,ends-t] + (1 << 29)) >> 30
+    if self.s2_shr > 0:
+      acc = (acc + (1 << (self.s2_shr - 1))) >> self.s2_shr
+    self.s1_history = X[:,X.shape[1]-(T-1):]
+
+    return np.clip(acc, -0x7FFFFFFF, 0x7FFFFFFF).astype(np.int32)
 
 
 def load(coef_file: str):
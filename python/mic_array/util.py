@@ -15,16 +15,24 @@ int16_dual = np.array([0x0001, 0x0002, 0x0004, 0x0008,
                        0x0100, 0x0200, 0x0400, 0x0800, 
                        0x1000, 0x2000, 0x4000, 0x7FFF], dtype=np.int32)
 
+# The dual vector of coefficients with only `bits` bit-planes, as used by
+# fir_1x12_bit() and fir_1x8_bit(). coef_dual(16) is int16_dual.
+def coef_dual(bits):
+  dual = (2**np.arange(bits)).astype(np.int32)
+  dual[-1] -= 1
+  return dual
+
 # Find the bipolar matrix representation B[,] of an int16 vector x[] which satisfies
 #   (np.matmul(B[:,:], dual_vector[:]) / 2) == x[:]
-# If len(x) == N, then the returned matrix B[,] will have shape (N, 16).
+# If len(x) == N, then the returned matrix B[,] will have shape (N, len(dual_vector)).
 # The first column, B[k,0], must correspond to the LEAST significant bit of the 
 # transformed coefficient x[k]
 def int16_vect_to_bipolar_matrix(x, dual_vector):
   x = x.astype(np.int64)
   y = 2*x[:,0] if (len(x.shape)==2) else 2*x
-  res = np.zeros((len(y), 16), dtype=np.int32)
-  for k in range(15,-1,-1):
+  bits = len(dual_vector)
+  res = np.zeros((len(y), bits), dtype=np.int32)
+  for k in range(bits-1,-1,-1):
     p = (y >= 0) * 2 - 1
     res[:,k] = p
     y = y - p * dual_vector[k] 
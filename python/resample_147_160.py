@@ -0,0 +1,73 @@
+# Copyright 2022-2024 XMOS LIMITED.
+# This Software is subject to the terms of the XMOS Public Licence: Version 1.
+
+# Generates lib_mic_array_192/src/etc/resample_147_160_coef.c, the default
+# polyphase coefficients of mic_array::ResamplingOutputHandler for resampling
+# 48 kHz to 44.1 kHz: a Kaiser windowed sinc low-pass filter, cut off at
+# 20.3 kHz, designed at the 147 * 48 kHz interpolated rate.
+
+import math
+import argparse
+
+UP = 147
+PHASE_TAPS = 32
+INPUT_RATE = 48000.0
+CUTOFF = 20300.0
+ATTENUATION_DB = 80.0
+
+
+def bessel_i0(x):
+  total, term, k = 1.0, 1.0, 1
+  while term > 1e-12 * total:
+    term *= (x / (2 * k)) ** 2
+    total += term
+    k += 1
+  return total
+
+
+def design():
+  n_taps = UP * PHASE_TAPS
+  rate = INPUT_RATE * UP
+  beta = 0.1102 * (ATTENUATION_DB - 8.7)
+  centre = (n_taps - 1) / 2.0
+
+  h = []
+  for n in range(n_taps):
+    x = n - centre
+    if x == 0:
+      s = 2 * CUTOFF / rate
+    else:
+      s = math.sin(2 * math.pi * CUTOFF / rate * x) / (math.pi * x)
+    w = bessel_i0(beta * math.sqrt(1 - (2 * x / (n_taps - 1)) ** 2)) / bessel_i0(beta)
+    # Gain of UP, so that each phase has a DC gain of 1.0.
+    h.append(UP * s * w)
+  return h
+
+
+def main(args):
+  h = design()
+  rows = []
+  for p in range(UP):
+    q = [max(-2**31, min(2**31 - 1, int(round(h[p + k * UP] * 2**30))))
+         for k in range(PHASE_TAPS)]
+    rows.append("    { " + ", ".join(hex(x) for x in q) + " }")
+
+  with open(args.out_file, "w") as f:
+    f.write("// Copyright 2022-2024 XMOS LIMITED.\n")
+    f.write("// This Software is subject to the terms of the XMOS Public Licence: Version 1.\n\n")
+    f.write('#include "mic_array/etc/filters_default.h"\n\n')
+    f.write("// Polyphase decomposition of a 4704-tap Kaiser windowed sinc low-pass filter\n")
+    f.write("// (cutoff 20.3 kHz at 48 kHz input, beta 7.86), scaled so that each phase has\n")
+    f.write("// a DC gain of 1.0 in Q2.30. Row p holds taps p, p+147, p+2*147, ...\n")
+    f.write("MIC_ARRAY_CONFIG_COEF_ATTRIBUTES\n")
+    f.write("const int32_t resample_147_160_coef[RESAMPLE_147_160_UP][RESAMPLE_147_160_PHASE_TAPS] = \n{\n")
+    f.write(",\n".join(rows))
+    f.write("\n};\n\nconst right_shift_t resample_147_160_shr = 0;\n")
+
+
+if __name__ == "__main__":
+  parser = argparse.ArgumentParser()
+  parser.add_argument("out_file", type=str, help='Path of the C file to write.')
+
+  args = parser.parse_args()
+  main(args)
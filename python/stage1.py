@@ -12,12 +12,17 @@ def main(args):
 
   stage1, _ = filters.load(args.coef_pkl_file)
 
+  if args.coef_bits != 16:
+    coefs = filters.requantize_coefs(stage1.Coef, args.coef_bits)
+    stage1 = filters.Stage1Filter(coefs, stage1.DecimationFactor, args.coef_bits)
+    print(f"Coefficient bits: {args.coef_bits}\n")
+
   # get the byte array representing the binary matrix
   s1_coef_words = stage1.ToXCoreCoefArray()
 
   print(f"Filter word count: {len(s1_coef_words)}\n")
 
-  words = np.array(["0x%08X" % x for x in s1_coef_words], dtype=str).reshape((16,8))
+  words = np.array(["0x%08X" % x for x in s1_coef_words], dtype=str).reshape((-1,8))
 
   print("{")
 
@@ -31,6 +36,8 @@ def main(args):
 if __name__ == "__main__":
   parser = argparse.ArgumentParser()
   parser.add_argument("coef_pkl_file", type=str, help='Path to pkl file containing first and second stage coefficients.')
+  parser.add_argument("--coef-bits", type=int, default=16, choices=[16, 12, 8],
+                      help='Coefficient precision, for the S1_COEF_BITS template parameter of TwoStageDecimator.')
 
   args = parser.parse_args()
   main(args)
\ No newline at end of file
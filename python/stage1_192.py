@@ -0,0 +1,116 @@
+# Copyright 2022-2024 XMOS LIMITED.
+# This Software is subject to the terms of the XMOS Public Licence: Version 1.
+
+import numpy as np
+import pickle as pkl
+import argparse
+import scipy.signal as spsig
+
+import mic_array.filters as filters
+
+import filter_design.design_filter as df
+import filter_design.filter_tools as ft
+
+FS_PDM = 3072000
+FS_OUT = FS_PDM // 16
+
+
+def load_coefs(args):
+
+  if args.coef_pkl_file is not None:
+    with open(args.coef_pkl_file, "rb") as pkl_file:
+      stage1, = pkl.load(pkl_file)
+    coefs, dec_factor = stage1
+    assert dec_factor == 16, f"192 kHz filter must have a decimation factor of 16 ({dec_factor})"
+    desc = f"from {args.coef_pkl_file}"
+  else:
+    window = ("kaiser", args.beta) if args.window == "kaiser" else args.window
+    params = df.stage_params(args.cutoff, 0, args.taps, window)
+    [[coefs, _]] = df.design_1_stage_192(FS_PDM, params, int_coeffs=True)
+    desc = f"taps={args.taps}, cutoff={args.cutoff} Hz, window={window}"
+
+  if len(coefs) < 256:
+    coefs = np.pad(coefs, (0, 256 - len(coefs)))
+
+  assert len(coefs) == 256, f"192 kHz filter must have at most 256 taps ({len(coefs)})"
+  assert coefs.dtype == np.int16, "192 kHz filter coefs must have dtype np.int16"
+  assert not np.any(coefs[240:]), "The last 16 taps of the 192 kHz filter must be zero"
+
+  if args.coef_bits != 16:
+    coefs = filters.requantize_coefs(coefs, args.coef_bits)
+    desc += f", {args.coef_bits}-bit coefficients"
+
+  return coefs, desc
+
+
+def report(coefs, words, coef_bits):
+
+  # fir_1x16_bit_taps() works in lag order, Stage1Filter in oldest-first order
+  taps = filters.fir_1x16_bit_taps(words, coef_bits)
+  assert np.array_equal(taps.reshape(8,32)[::-1].reshape(256), coefs), \
+    f"Coefficients are not exactly representable by fir_1x{coef_bits}_bit()"
+
+  w, h = spsig.freqz(coefs.astype(np.float64), worN=8192, fs=FS_PDM)
+  h_db = 20 * np.log10(np.maximum(np.abs(h) / np.abs(h[0]), 1e-12))
+
+  print(f"Tap count: {np.count_nonzero(coefs)}")
+  print(f"Gain at 20 kHz: {np.interp(20000, w, h_db):.2f} dB")
+  print(f"Gain at 80 kHz: {np.interp(80000, w, h_db):.2f} dB")
+  print(f"Worst gain above {FS_OUT // 2} Hz: {np.max(h_db[w >= FS_OUT // 2]):.2f} dB")
+  print("")
+
+
+def format_words(words):
+  words = np.array(["0x%08X" % x for x in words], dtype=str).reshape((-1,8))
+  return "\n".join(["  " + ", ".join(words[r,:]) + "," for r in range(words.shape[0])])
+
+
+def main(args):
+
+  coefs, desc = load_coefs(args)
+
+  s1_coef_words = filters.Stage1Filter(coefs, 16, args.coef_bits).ToXCoreCoefArray()
+
+  report(coefs, s1_coef_words, args.coef_bits)
+
+  body = format_words(s1_coef_words)
+
+  if args.out is None:
+    print(f"Filter word count: {len(s1_coef_words)}\n")
+    print("{")
+    print(body)
+    print("}")
+    return
+
+  with open(args.out, "w") as f:
+    f.write("// Generated by python/stage1_192.py. Do not edit.\n")
+    f.write(f"// Design: {desc}\n")
+    f.write(f"// Use with mic_array::OneStageDecimator192<..., {args.coef_bits}>::Init({args.name}).\n")
+    f.write("#pragma once\n\n")
+    f.write("#include <stdint.h>\n\n")
+    f.write("#include \"xmath/xmath.h\"\n\n")
+    f.write(f"static const uint32_t WORD_ALIGNED {args.name}[{len(s1_coef_words)}] = {{\n")
+    f.write(body + "\n")
+    f.write("};\n")
+
+  print(f"Wrote {args.out}")
+
+
+
+if __name__ == "__main__":
+  parser = argparse.ArgumentParser(
+      description="Generate the filter table of the 192 kHz (16x) decimator, "
+                  "either from a .pkl file or from design parameters.")
+  parser.add_argument("coef_pkl_file", type=str, nargs="?", default=None,
+                      help='Path to pkl file containing the single stage coefficients.')
+  parser.add_argument("--taps", type=int, default=240, help='Number of taps to design (at most 240).')
+  parser.add_argument("--cutoff", type=float, default=80000, help='Cutoff frequency, in Hz.')
+  parser.add_argument("--window", type=str, default="kaiser", help='Window passed to scipy.signal.firwin().')
+  parser.add_argument("--beta", type=float, default=4.0, help='Kaiser window beta.')
+  parser.add_argument("--coef-bits", type=int, default=16, choices=[16, 12, 8],
+                      help='Coefficient precision, for the S1_COEF_BITS template parameter of OneStageDecimator192.')
+  parser.add_argument("--out", type=str, default=None, help='Write a C header to this path instead of printing.')
+  parser.add_argument("--name", type=str, default="s1_fir_coef_custom", help='Name of the array in the header.')
+
+  args = parser.parse_args()
+  main(args)
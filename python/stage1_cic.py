@@ -0,0 +1,199 @@
+# Copyright 2022-2024 XMOS LIMITED.
+# This Software is subject to the terms of the XMOS Public Licence: Version 1.
+
+# Generates lib_mic_array_192/src/etc/cic_fir_coef.c, the default filters of
+# mic_array::CicDecimator: a CIC (sinc^N) stage 1 decimating 3.072 MHz PDM by
+# 64, in the bit-plane format of fir_1x8_bit(), and a stage 2 FIR decimating
+# its 48 kHz output by 3 which also compensates the CIC's passband droop.
+
+import math
+import argparse
+
+FS_PDM = 3072000
+S1_WORDS = 2
+S1_DEC_FACTOR = 32 * S1_WORDS
+S2_DEC_FACTOR = 3
+FS_S1 = FS_PDM / S1_DEC_FACTOR
+FS_OUT = FS_S1 / S2_DEC_FACTOR
+
+# DC gain of the whole decimator for a full scale PDM signal, the same as
+# that of the default TwoStageDecimator filters.
+TARGET_GAIN = 857718499
+
+
+def bessel_i0(x):
+  total, term, k = 1.0, 1.0, 1
+  while term > 1e-12 * total:
+    term *= (x / (2 * k)) ** 2
+    total += term
+    k += 1
+  return total
+
+
+def cic_taps(order, coef_bits):
+  """Impulse response of an order `order` CIC, scaled to `coef_bits` bits."""
+  h = [1]
+  for _ in range(order):
+    out = [0] * (len(h) + S1_DEC_FACTOR - 1)
+    for i, a in enumerate(h):
+      for j in range(S1_DEC_FACTOR):
+        out[i + j] += a
+    h = out
+  assert len(h) <= 256, f"An order {order} CIC has more than 256 taps"
+  scale = (2 ** (coef_bits - 1) - 1) / max(h)
+  return [int(round(c * scale)) for c in h]
+
+
+def response(taps, f, fs):
+  w = 2 * math.pi * f / fs
+  re = sum(c * math.cos(w * n) for n, c in enumerate(taps))
+  im = sum(c * math.sin(w * n) for n, c in enumerate(taps))
+  return math.hypot(re, im)
+
+
+def to_words(taps, coef_bits):
+  """
+  Bit-plane words of a 256-tap fir_1x16_bit() style table (as
+  mic_array.filters.Stage1Filter.ToXCoreCoefArray()). `taps` are applied to
+  the newest PDM samples, `taps[0]` to the newest.
+  """
+  dual = [2 ** p for p in range(coef_bits)]
+  dual[-1] -= 1
+  # Oldest first, zero padded at the old end.
+  coefs = [0] * (256 - len(taps)) + list(reversed(taps))
+  planes = [[0] * 256 for _ in range(coef_bits)]
+  for i, c in enumerate(coefs):
+    y = 2 * c
+    for p in range(coef_bits - 1, -1, -1):
+      s = 1 if y >= 0 else -1
+      planes[p][i] = (1 - s) // 2
+      y -= s * dual[p]
+    assert y == 0, f"Tap {c} is not representable with {coef_bits} bits"
+  # Word j (0 newest) of a plane holds oldest first taps 32*(7-j) .. +31,
+  # the oldest in the LSb.
+  words = []
+  for p in range(coef_bits):
+    for j in range(8):
+      base = 32 * (7 - j)
+      words.append(sum(planes[p][base + k] << k for k in range(32)))
+  return words
+
+
+def s1_output_gain(taps, coef_bits):
+  # fir_1x8_bit() and fir_1x12_bit() scale their results to 16 bit-planes,
+  # and all kernels shift left by a further 8 bits.
+  return sum(taps) << (24 - coef_bits)
+
+
+def design_stage2(s1_taps, tap_count, cutoff, beta):
+  """Kaiser windowed FIR low-pass whose passband inverts the CIC's droop."""
+  centre = (tap_count - 1) / 2.0
+  s1_dc = sum(s1_taps)
+  droop = lambda f: response(s1_taps, f, FS_PDM) / s1_dc
+
+  # Frequency sampling of the ideal response up to the cutoff, integrated
+  # with the trapezium rule.
+  points = 400
+  df = cutoff / points
+  grid = [k * df for k in range(points + 1)]
+  gain = [1.0 / droop(f) for f in grid]
+
+  h = []
+  for n in range(tap_count):
+    x = n - centre
+    acc = 0.0
+    for k, f in enumerate(grid):
+      wgt = 0.5 if k in (0, points) else 1.0
+      acc += wgt * gain[k] * math.cos(2 * math.pi * f * x / FS_S1)
+    s = 2 * acc * df / FS_S1
+    w = bessel_i0(beta * math.sqrt(1 - (2 * x / (tap_count - 1)) ** 2)) / bessel_i0(beta)
+    h.append(s * w)
+  return h
+
+
+def quantize_stage2(h, s1_gain):
+  # out = (s1_gain * sum(coef) / 2^30) >> shr must be TARGET_GAIN.
+  total = sum(h)
+  for shr in range(0, 16):
+    scale = TARGET_GAIN * (2 ** 30) * (2 ** shr) / (s1_gain * total)
+    q = [int(round(c * scale)) for c in h]
+    if max(abs(c) for c in q) <= 0x7FFFFFFF:
+      best = (q, shr)
+    else:
+      break
+  return best
+
+
+def report(s1_taps, s2_coef, s2_shr, s1_gain):
+  s1_dc = sum(s1_taps)
+  s2_dc = sum(s2_coef)
+
+  def total(f):
+    s2 = math.hypot(sum(c * math.cos(2 * math.pi * f * n / FS_S1) for n, c in enumerate(s2_coef)),
+                    sum(c * math.sin(2 * math.pi * f * n / FS_S1) for n, c in enumerate(s2_coef)))
+    return response(s1_taps, f, FS_PDM) / s1_dc * s2 / s2_dc
+
+  db = lambda x: 20 * math.log10(max(x, 1e-12))
+
+  print(f"Stage 1 taps: {len(s1_taps)}")
+  print(f"DC gain: {s1_gain * s2_dc / 2**30 / 2**s2_shr:.0f}")
+  for f in (1000, 4000, 6000, 7000):
+    print(f"Gain at {f} Hz: {db(total(f)):.2f} dB")
+
+  # Stage 1 aliases into the output band from around each multiple of FS_S1.
+  alias = max(response(s1_taps, m * FS_S1 + d, FS_PDM) / s1_dc
+              for m in range(1, S1_DEC_FACTOR // 2 + 1)
+              for d in range(-int(FS_OUT // 2), int(FS_OUT // 2) + 1, 250)
+              if 0 < m * FS_S1 + d <= FS_PDM / 2)
+  print(f"Worst stage 1 alias into 0 - {FS_OUT / 2:.0f} Hz: {db(alias):.1f} dB")
+
+  # Stage 2 aliases into 0 - 6 kHz from FS_OUT - 6 kHz up.
+  stop = max(total(f) for f in range(int(FS_OUT) - 6000, int(FS_S1 / 2) + 1, 100))
+  print(f"Worst gain from {FS_OUT - 6000:.0f} Hz: {db(stop):.1f} dB")
+  print("")
+
+
+def main(args):
+  s1_taps = cic_taps(args.order, 8)
+  s1_words = to_words(s1_taps, 8)
+  s1_gain = s1_output_gain(s1_taps, 8)
+
+  h = design_stage2(s1_taps, args.s2_taps, args.cutoff, args.beta)
+  s2_coef, s2_shr = quantize_stage2(h, s1_gain)
+
+  report(s1_taps, s2_coef, s2_shr, s1_gain)
+
+  s1_rows = [", ".join("0x%08X" % w for w in s1_words[r:r+8])
+             for r in range(0, len(s1_words), 8)]
+
+  with open(args.out_file, "w") as f:
+    f.write("// Copyright 2022-2024 XMOS LIMITED.\n")
+    f.write("// This Software is subject to the terms of the XMOS Public Licence: Version 1.\n\n")
+    f.write('#include "mic_array/etc/filters_default.h"\n\n')
+    f.write(f"// Order {args.order} CIC decimating by {S1_DEC_FACTOR}, {len(s1_taps)} taps applied to the newest PDM\n")
+    f.write("// samples, scaled to 8-bit coefficients. Generated by python/stage1_cic.py.\n")
+    f.write("MIC_ARRAY_CONFIG_COEF_ATTRIBUTES\n")
+    f.write("const uint32_t cic_stage1_coef[CIC_STAGE1_WORDS] = {\n")
+    f.write("\n".join("  " + r + "," for r in s1_rows))
+    f.write("\n};\n\n")
+    f.write(f"// Kaiser windowed (beta {args.beta}) low-pass, cut off at {args.cutoff:.0f} Hz, whose\n")
+    f.write("// passband inverts the droop of cic_stage1_coef.\n")
+    f.write("MIC_ARRAY_CONFIG_COEF_ATTRIBUTES\n")
+    f.write("const int32_t cic_stage2_coef[CIC_STAGE2_TAP_COUNT] = \n{\n")
+    f.write("    " + ", ".join(hex(c) for c in s2_coef))
+    f.write("\n};\n\n")
+    f.write(f"const right_shift_t cic_stage2_shr = {s2_shr};\n")
+
+
+if __name__ == "__main__":
+  parser = argparse.ArgumentParser(
+      description="Generate the CIC stage 1 and compensating stage 2 filters "
+                  "of mic_array::CicDecimator.")
+  parser.add_argument("out_file", type=str, help='Path of the C file to write.')
+  parser.add_argument("--order", type=int, default=4, help='CIC order (at most 4).')
+  parser.add_argument("--s2-taps", type=int, default=64, help='Stage 2 tap count.')
+  parser.add_argument("--cutoff", type=float, default=7200, help='Stage 2 cutoff frequency, in Hz.')
+  parser.add_argument("--beta", type=float, default=5.65, help='Stage 2 Kaiser window beta.')
+
+  args = parser.parse_args()
+  main(args)
@@ -0,0 +1,82 @@
+# Copyright 2022-2024 XMOS LIMITED.
+# This Software is subject to the terms of the XMOS Public Licence: Version 1.
+
+# Generates the look-up table used by fir_1x16_bit_lut() (and so by a
+# mic_array::TwoStageDecimator whose S1_COEF_BITS is mic_array::STAGE1_LUT)
+# from a block of stage 1 coefficient words, as a C array. This is the table
+# which fir_1x16_bit_lut_init() builds at run time, for applications which
+# would rather keep it with their constant data.
+#
+# The coefficient words are read from the initializer of a C array, e.g.
+# stage1_coef in lib_mic_array_192/src/etc/stage1_fir_coef.c.
+
+import re
+import argparse
+
+
+def read_words(c_file, array_name):
+  """The integer literals in the initializer of `array_name` in `c_file`."""
+  with open(c_file) as f:
+    src = f.read()
+  src = re.sub(r"//[^\n]*|/\*.*?\*/", "", src, flags=re.S)
+  m = re.search(r"\b" + re.escape(array_name) + r"\s*\[[^\]]*\]\s*=\s*\{(.*?)\}", src, re.S)
+  assert m, f"No initializer for {array_name} in {c_file}"
+  return [int(w, 0) & 0xFFFFFFFF for w in re.findall(r"0[xX][0-9a-fA-F]+|\d+", m.group(1))]
+
+
+def taps(words, coef_bits):
+  """
+  Taps of a 256-tap slice, tap i applying to bit i % 32 of signal word
+  i // 32 (as mic_array.filters.fir_1x16_bit_taps()).
+  """
+  assert len(words) >= 8 * coef_bits, f"{8 * coef_bits} coefficient words are needed"
+  dual = [2 ** p for p in range(coef_bits)]
+  dual[-1] -= 1
+  out = []
+  for i in range(256):
+    t = sum(-d if (words[8 * p + i // 32] >> (i % 32)) & 1 else d
+            for p, d in enumerate(dual))
+    out.append(t // 2)
+  return out
+
+
+def lut(words, coef_bits):
+  """table[256 * p + v]: contribution of signal byte p having the value v."""
+  t = taps(words, coef_bits)
+  table = []
+  for p in range(32):
+    for v in range(256):
+      acc = sum(-t[8 * p + k] if (v >> k) & 1 else t[8 * p + k] for k in range(8))
+      table.append((acc << (24 - coef_bits)) & 0xFFFFFFFF)
+  return table
+
+
+def main(args):
+  words = read_words(args.coef_file, args.array)
+  table = lut(words, args.coef_bits)
+
+  rows = [", ".join("0x%08X" % w for w in table[r:r+8]) for r in range(0, len(table), 8)]
+
+  with open(args.out_file, "w") as f:
+    f.write("// Copyright 2022-2024 XMOS LIMITED.\n")
+    f.write("// This Software is subject to the terms of the XMOS Public Licence: Version 1.\n\n")
+    f.write('#include "mic_array/etc/fir_1x16_bit.h"\n\n')
+    f.write(f"// fir_1x16_bit_lut() table of {args.array} ({args.coef_bits}-bit coefficients).\n")
+    f.write("// Generated by python/stage1_lut.py.\n")
+    f.write(f"const uint32_t {args.name}[FIR_1X16_BIT_LUT_WORDS] = {{\n")
+    f.write("\n".join("  " + r + "," for r in rows))
+    f.write("\n};\n")
+
+
+if __name__ == "__main__":
+  parser = argparse.ArgumentParser(
+      description="Generate the fir_1x16_bit_lut() table of a block of stage 1 "
+                  "coefficients.")
+  parser.add_argument("coef_file", type=str, help='C file defining the coefficient words.')
+  parser.add_argument("out_file", type=str, help='Path of the C file to write.')
+  parser.add_argument("--array", type=str, default="stage1_coef", help='Name of the coefficient array.')
+  parser.add_argument("--coef-bits", type=int, default=16, choices=[16, 12, 8], help='Bits per coefficient.')
+  parser.add_argument("--name", type=str, default="stage1_lut", help='Name of the table to define.')
+
+  args = parser.parse_args()
+  main(args)
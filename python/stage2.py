@@ -16,18 +16,26 @@ def main(args):
 
   # print(f"Scale: {stage2.ScaleInt32}")
 
-  print(f"Right-shift: {stage2.Shr}")
+  coefs, shr = stage2.Coef, stage2.Shr
+
+  if args.coef_bits == 16:
+    coefs, shr = filters.stage2_coefs_s16(coefs, shr)
+    print(f"Coefficient bits: {args.coef_bits}\n")
+
+  print(f"Right-shift: {shr}")
 
 
   print("\n")
   print("{")
-  print(", ".join( [hex(x) for x in stage2.Coef] ))
+  print(", ".join( [hex(x) for x in coefs] ))
   print("}")
 
 
 if __name__ == "__main__":
   parser = argparse.ArgumentParser()
   parser.add_argument("coef_pkl_file", type=str, help='Path to pkl file containing first and second stage coefficients.')
+  parser.add_argument("--coef-bits", type=int, default=32, choices=[32, 16],
+                      help='Coefficient precision, for the S2_COEF_BITS template parameter of TwoStageDecimator.')
 
   args = parser.parse_args()
   main(args)
\ No newline at end of file
@@ -0,0 +1,12 @@
+# Copyright 2024 XMOS LIMITED.
+# This Software is subject to the terms of the XMOS Public Licence: Version 1.
+
+def pytest_addoption(parser):
+    parser.addoption("--tolerance", type=float, default=0.02,
+                     help="Allowed fractional increase over the baseline")
+    parser.addoption("--estimate-tolerance", type=float, default=0.25,
+                     help="Allowed fractional increase over an estimated baseline")
+    parser.addoption("--update-baseline", action="store_true",
+                     help="Write the measured results to baseline.json")
+    parser.addoption("--xsim-args", action="store", default="")
+    parser.addoption("--print-output", action="store_true")
@@ -0,0 +1,189 @@
+// Copyright 2024 XMOS LIMITED.
+// This Software is subject to the terms of the XMOS Public Licence: Version 1.
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstdint>
+#include <type_traits>
+
+#include <xcore/channel.h>
+#include <xcore/channel_streaming.h>
+#include <xcore/hwtimer.h>
+
+#include "mic_array.h"
+
+#include "app.h"
+
+#ifndef CHAN_COUNT
+# error CHAN_COUNT must be defined.
+#endif
+#ifndef OUTPUT_RATE
+# error OUTPUT_RATE must be defined.
+#endif
+#ifndef SAMPLES_PER_FRAME
+# error SAMPLES_PER_FRAME must be defined.
+#endif
+#ifndef USE_ISR
+# error USE_ISR must be defined.
+#endif
+
+// PDM clock the source thread emulates.
+#define PDM_FREQ          (3072000)
+
+// Reference clock frequency.
+#define REF_CLOCK_FREQ    (100000000)
+
+// The PDM source runs this many times slower than real time, so that even
+// configurations which can't keep up in real time are measured rather than
+// dropping blocks. The block period (and so the idle time) scales with it,
+// but the busy time per block does not.
+#ifndef BENCH_SLOWDOWN
+# define BENCH_SLOWDOWN   (4)
+#endif
+
+// Output samples to let through before measuring, so that the decimator's
+// history is full and the frame transfer has settled.
+#ifndef BENCH_WARMUP_SAMPLES
+# define BENCH_WARMUP_SAMPLES   (64)
+#endif
+
+// Output samples over which the decimation thread's load is measured.
+#ifndef BENCH_SAMPLES
+# define BENCH_SAMPLES          (512)
+#endif
+
+
+/*
+  Same arrangement as the BasicMicArray signal test: a streaming chanend
+  stands in for the PDM port, fed by a thread which sends PDM words at the
+  (slowed) PDM rate. GetSlack() of the PDM rx service gives the time the
+  decimation thread spent waiting for each block, so the difference between
+  the block period and the least idle time is the worst-case time the thread
+  needed per block, including the PDM rx ISR in ISR mode.
+*/
+
+static constexpr bool USE_192K = (OUTPUT_RATE == 192000);
+
+// Second stage decimation factor, or 1 for the one-stage 192 kHz decimator,
+// whose blocks are a single word per mic. The 32 and 48 kHz configurations
+// use the default 65-tap second stage filter with a decimation factor of 3 or
+// 2. The coefficients aren't designed for those rates, but the cost doesn't
+// depend on them.
+static constexpr unsigned S2_DEC_FACTOR = USE_192K? 1 
+                                        : PDM_FREQ / (32 * OUTPUT_RATE);
+
+static_assert(USE_192K || (S2_DEC_FACTOR * 32 * OUTPUT_RATE == PDM_FREQ),
+              "OUTPUT_RATE must be 192000 or a divisor of 96000.");
+
+using TDecimator = typename std::conditional<USE_192K,
+                      mic_array::OneStageDecimator192<CHAN_COUNT>,
+                      mic_array::TwoStageDecimator<CHAN_COUNT, S2_DEC_FACTOR, 
+                                                   STAGE2_TAP_COUNT>>::type;
+
+using TMicArray = mic_array::MicArray<CHAN_COUNT,
+                      TDecimator,
+                      mic_array::StandardPdmRxService<CHAN_COUNT, CHAN_COUNT, 
+                                                      S2_DEC_FACTOR>,
+                      mic_array::NopSampleFilter<CHAN_COUNT>,
+                      mic_array::FrameOutputHandler<CHAN_COUNT, 
+                          SAMPLES_PER_FRAME, 
+                          mic_array::ChannelFrameTransmitter>>;
+
+static constexpr unsigned BLOCK_WORDS = CHAN_COUNT * S2_DEC_FACTOR;
+static constexpr unsigned SAMPLES_PER_BLOCK = 
+    mic_array::DecimatorSamplesPerBlock<TDecimator>::value;
+static constexpr unsigned BLOCK_PERIOD = uint64_t(BENCH_SLOWDOWN) 
+    * REF_CLOCK_FREQ * 32 * S2_DEC_FACTOR / PDM_FREQ;
+
+TMicArray mics;
+
+
+static void init_decimator(
+    mic_array::OneStageDecimator192<CHAN_COUNT>& decimator)
+{
+  decimator.Init();
+}
+
+template <class T>
+static void init_decimator(
+    T& decimator)
+{
+  decimator.Init((uint32_t*) stage1_coef, stage2_coef, stage2_shr);
+}
+
+
+void app_init(
+    chanend_t c_pdm)
+{
+  init_decimator(mics.Decimator);
+  mics.PdmRx.Init((port_t) c_pdm);
+}
+
+
+void app_pdm_source_task(
+    chanend_t c_pdm)
+{
+  hwtimer_t tmr = hwtimer_alloc();
+
+  // The cost doesn't depend on the signal, but keep it from being constant.
+  uint32_t lfsr = 0xACE1ACE1;
+  uint32_t next_time = hwtimer_get_time(tmr);
+
+  while(1){
+    for(unsigned k = 0; k < BLOCK_WORDS; k++){
+      lfsr = (lfsr >> 1) ^ ((-(lfsr & 1)) & 0xD0000001);
+      s_chan_out_word(c_pdm, lfsr);
+    }
+    next_time += BLOCK_PERIOD;
+    hwtimer_wait_until(tmr, next_time);
+  }
+}
+
+
+void app_pdm_task()
+{
+  mics.PdmRx.ThreadEntry();
+}
+
+
+void app_dec_task(
+    chanend_t c_frames_out)
+{
+  mics.OutputHandler.FrameTx.SetChannel(c_frames_out);
+#if (USE_ISR)
+  mics.PdmRx.InstallISR();
+  mics.PdmRx.UnmaskISR();
+#endif
+  mics.ThreadEntry();
+}
+
+
+void app_output_task(
+    chanend_t c_frames_in)
+{
+  constexpr unsigned WARMUP_FRAMES = 
+      (BENCH_WARMUP_SAMPLES + SAMPLES_PER_FRAME - 1) / SAMPLES_PER_FRAME;
+  constexpr unsigned FRAMES = 
+      (BENCH_SAMPLES + SAMPLES_PER_FRAME - 1) / SAMPLES_PER_FRAME;
+
+  int32_t frame[CHAN_COUNT][SAMPLES_PER_FRAME];
+
+  for(unsigned k = 0; k < WARMUP_FRAMES; k++)
+    ma_frame_rx(&frame[0][0], c_frames_in, CHAN_COUNT, SAMPLES_PER_FRAME);
+
+  mics.PdmRx.ResetStats();
+
+  for(unsigned k = 0; k < FRAMES; k++)
+    ma_frame_rx(&frame[0][0], c_frames_in, CHAN_COUNT, SAMPLES_PER_FRAME);
+
+  const mic_array::PdmRxSlack slack = mics.PdmRx.GetSlack();
+
+  // Parsed by test_benchmark.py
+  printf("BENCH mics=%u rate=%u frame=%u isr=%u block_period=%u "
+         "min_idle=%u samples_per_block=%u\n",
+         CHAN_COUNT, OUTPUT_RATE, SAMPLES_PER_FRAME, USE_ISR,
+         (unsigned) slack.block_period, (unsigned) slack.min_idle, 
+         SAMPLES_PER_BLOCK);
+
+  exit(0);
+}
@@ -0,0 +1,32 @@
+// Copyright 2024 XMOS LIMITED.
+// This Software is subject to the terms of the XMOS Public Licence: Version 1.
+
+#pragma once
+
+#include "mic_array.h"
+
+C_API_START
+
+// Initialize the mic array, with the streaming chanend standing in for the
+// PDM port
+MA_C_API
+void app_init(chanend_t c_pdm);
+
+// Thread that plays the part of the PDM port, sending PDM words in real time
+MA_C_API
+void app_pdm_source_task(chanend_t c_pdm);
+
+// Thread that receives PDM data (thread mode only)
+MA_C_API
+void app_pdm_task();
+
+// Thread that runs the decimator (and in ISR mode, the PDM rx ISR)
+MA_C_API
+void app_dec_task(chanend_t c_frames_out);
+
+// Thread that receives frames, and reports the decimation thread's load once
+// enough have been received
+MA_C_API
+void app_output_task(chanend_t c_frames_in);
+
+C_API_END
@@ -0,0 +1,118 @@
+# Copyright 2024 XMOS LIMITED.
+# This Software is subject to the terms of the XMOS Public Licence: Version 1.
+
+######
+# Test: Decimation thread benchmark
+#
+# Runs each configuration of the benchmark app under xsim and checks the
+# worst-case time the decimation thread needs per output sample against
+# baseline.json, so that changes to the decimators, the PDM rx service or
+# the VPU kernels which slow the library down are caught.
+#
+# The app feeds the mic array from a thread which pretends to be the PDM
+# port, and reports the PDM rx block period and the least time the
+# decimation thread spent waiting for a block (see PdmRxSlack). Their
+# difference is the most time any block took to process, in 100 MHz
+# reference clock ticks. xsim is cycle accurate, so the figure is repeatable.
+#
+# Notes:
+#  - This test assumes that the CMake targets for this app are all already
+#    built.
+#  - xsim must be on your path.
+#  - To run it, navigate to the root of your CMake build directory, and run:
+#       > pytest path/to/this/dir/test_benchmark.py
+#  - To record new baseline figures (e.g. after a deliberate change in cost),
+#    add --update-baseline, and commit the updated baseline.json.
+#  - A configuration without a baseline entry fails, so a new configuration
+#    needs an --update-baseline run before it can pass.
+#  - Entries with "measured": false are estimates from the mic array's
+#    RequiredMips() (see README.rst), and are checked against the looser
+#    --estimate-tolerance until an xsim run replaces them.
+######
+
+import json
+import re
+import subprocess
+from pathlib import Path
+
+import pytest
+
+with open(Path(__file__).parent / "test_params.json") as f:
+    params = json.load(f)
+
+BASELINE_FILE = Path(__file__).parent / "baseline.json"
+
+RESULT_RE = re.compile(r"^BENCH .*block_period=(\d+) min_idle=(\d+) "
+                       r"samples_per_block=(\d+)", re.MULTILINE)
+
+
+def load_baseline():
+    if not BASELINE_FILE.exists():
+        return {}
+    with open(BASELINE_FILE) as f:
+        return json.load(f)
+
+
+def save_baseline_entry(cfg, ticks_per_sample):
+    baseline = load_baseline()
+    baseline[cfg] = {"ticks_per_sample": ticks_per_sample, "measured": True}
+    with open(BASELINE_FILE, "w") as f:
+        json.dump(dict(sorted(baseline.items())), f, indent=4)
+        f.write("\n")
+
+
+def run_benchmark(xe_path, xsim_args, print_output):
+    cmd = ["xsim"] + xsim_args.split() + [xe_path]
+    res = subprocess.run(cmd, capture_output=True, text=True, timeout=1800)
+    if print_output: print(res.stdout)
+    assert res.returncode == 0, f"xsim failed:\n{res.stdout}{res.stderr}"
+
+    m = RESULT_RE.search(res.stdout)
+    assert m is not None, f"No result in output:\n{res.stdout}"
+    return [int(x) for x in m.groups()]
+
+
+@pytest.mark.parametrize("chans", params["N_MICS"], ids=[f"{nm}n_mics" for nm in params["N_MICS"]])
+@pytest.mark.parametrize("rate", params["OUTPUT_RATE"], ids=[f"{r}hz" for r in params["OUTPUT_RATE"]])
+@pytest.mark.parametrize("frame_size", params["FRAME_SIZE"], ids=[f"{fs}frame" for fs in params["FRAME_SIZE"]])
+@pytest.mark.parametrize("use_isr", params["USE_ISR"], ids=[f"{ui}_isr" for ui in params["USE_ISR"]])
+def test_benchmark(request, chans, rate, frame_size, use_isr):
+
+    cwd = Path(request.fspath).parent
+    cfg = f"{chans}ch_{rate}hz_{frame_size}smp_{use_isr}isr"
+    xe_path = f'{cwd}/bin/{cfg}/tests-benchmark_{cfg}.xe'
+    assert Path(xe_path).exists(), f"Cannot find {xe_path}"
+
+    block_period, min_idle, samples_per_block = run_benchmark(
+        xe_path, request.config.getoption("xsim_args"),
+        request.config.getoption("print_output"))
+
+    # No idle time at all means the decimation thread fell behind the
+    # (slowed) PDM source, and its actual cost can't be seen.
+    assert 0 < min_idle < block_period, \
+        f"{cfg}: decimator did not keep up (block_period={block_period}, min_idle={min_idle})"
+
+    ticks_per_sample = round((block_period - min_idle) / samples_per_block, 1)
+    print(f"{cfg}: {ticks_per_sample} ticks per output sample")
+
+    if request.config.getoption("update_baseline"):
+        save_baseline_entry(cfg, ticks_per_sample)
+        return
+
+    baseline = load_baseline()
+    assert cfg in baseline, \
+        f"{cfg}: no baseline (run with --update-baseline to record one)"
+
+    entry = baseline[cfg]
+    expected = entry["ticks_per_sample"]
+    if entry["measured"]:
+        tolerance = request.config.getoption("tolerance")
+    else:
+        tolerance = request.config.getoption("estimate_tolerance")
+        print(f"{cfg}: baseline is an estimate; run --update-baseline to measure it")
+
+    assert ticks_per_sample <= expected * (1 + tolerance), \
+        f"{cfg}: {ticks_per_sample} ticks per sample, baseline is {expected}"
+
+    if ticks_per_sample < expected * (1 - tolerance):
+        print(f"{cfg}: faster than baseline ({expected}); consider --update-baseline")
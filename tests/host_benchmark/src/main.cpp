@@ -0,0 +1,282 @@
+// Copyright 2022-2024 XMOS LIMITED.
+// This Software is subject to the terms of the XMOS Public Licence: Version 1.
+
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <chrono>
+
+#include "mic_array/cpp/Decimator.hpp"
+#include "mic_array/cpp/Decimator192.hpp"
+#include "mic_array/cpp/DecimatorCic.hpp"
+#include "mic_array/cpp/Util.hpp"
+#include "mic_array/etc/filters_default.h"
+#include "mic_array/util.h"
+
+/*
+  Host benchmark of the decimators, built from the library's portable C
+  kernels (src/ref/). Each configuration decimates random PDM data for a fixed
+  number of blocks, and the throughput is reported in output samples (per
+  channel) per second, and as a multiple of the rate needed at the standard
+  3.072 MHz PDM clock.
+
+  Before anything is timed, the reference kernels are checked against
+  straightforward definitions, so that throughput isn't measured on a broken
+  build.
+*/
+
+#define PDM_FREQ    (3072000)
+
+using bench_clock = std::chrono::steady_clock;
+
+static unsigned failures = 0;
+
+static uint32_t rand_word()
+{
+  return (((uint32_t) rand()) << 16) ^ ((uint32_t) rand());
+}
+
+static void check(bool ok, const char* what)
+{
+  if(!ok){
+    printf("FAILED: %s\n", what);
+    failures++;
+  }
+}
+
+
+// fir_1x16_bit() against the inner product of the +/-1 signal with the
+// coefficients decoded from their bit planes.
+static void check_fir_1x16_bit()
+{
+  srand(0x1F1);
+
+  for(int rep = 0; rep < 100; rep++){
+    uint32_t signal[8];
+    uint32_t coef[128];
+    for(int k = 0; k < 8; k++)   signal[k] = rand_word();
+    for(int k = 0; k < 128; k++) coef[k] = rand_word();
+
+    int64_t expected = 0;
+    for(int i = 0; i < 256; i++){
+      const int s = ((signal[i / 32] >> (i % 32)) & 1)? -1 : 1;
+      int32_t c2 = 0; // twice the coefficient
+      for(int bit = 0; bit < 16; bit++){
+        const int32_t w = (bit == 15)? 0x7FFF : (1 << bit);
+        c2 += ((coef[8 * bit + i / 32] >> (i % 32)) & 1)? -w : w;
+      }
+      expected += s * c2;
+    }
+    expected = (expected / 2) * 256;
+
+    check(fir_1x16_bit(signal, coef) == expected, "fir_1x16_bit()");
+  }
+}
+
+
+// Interleave, as the PDM port does, as in the deinterleave unit tests.
+template <unsigned MICS>
+static void interleave(uint32_t res[MICS], const uint32_t orig[MICS])
+{
+  uint32_t mic[MICS];
+  memcpy(mic, orig, sizeof(mic));
+  memset(res, 0, sizeof(uint32_t) * MICS);
+  for(unsigned n = 0; n < MICS; n++){
+    const unsigned p = MICS - 1 - n;
+    for(unsigned k = 0; k < 32; k++){
+      const unsigned mc = k % MICS;
+      const uint32_t a = mic[mc] & 1;
+      mic[mc] >>= 1;
+      res[p] = (res[p] >> 1) | (a << 31);
+    }
+  }
+}
+
+template <unsigned MICS>
+static void check_deinterleave()
+{
+  constexpr unsigned SUBBLOCKS = 6;
+
+  srand(0xD1 + MICS);
+
+  uint32_t expected[SUBBLOCKS][MICS];
+  uint32_t block[SUBBLOCKS][MICS];
+  for(unsigned sb = 0; sb < SUBBLOCKS; sb++){
+    for(unsigned k = 0; k < MICS; k++)
+      expected[sb][k] = rand_word();
+    interleave<MICS>(block[sb], expected[sb]);
+  }
+
+  mic_array::deinterleave_pdm_samples<MICS>(&block[0][0], SUBBLOCKS);
+
+  check(memcmp(expected, block, sizeof(block)) == 0, 
+        "deinterleave_pdm_samples()");
+}
+
+
+// Time `blocks` calls to `process(pdm_block)`, cycling through a set of
+// random PDM blocks of `block_words` words.
+template <class TProcess>
+static double time_blocks(
+    TProcess process,
+    unsigned block_words,
+    unsigned blocks)
+{
+  static uint32_t pdm[16][16 * STAGE2_DEC_FACTOR];
+  for(unsigned b = 0; b < 16; b++)
+    for(unsigned k = 0; k < block_words; k++)
+      pdm[b][k] = rand_word();
+
+  const auto start = bench_clock::now();
+  for(unsigned b = 0; b < blocks; b++)
+    process(pdm[b % 16]);
+  const auto end = bench_clock::now();
+
+  return std::chrono::duration<double>(end - start).count();
+}
+
+static void report(
+    const char* name,
+    unsigned mics,
+    unsigned samples,
+    double seconds,
+    double output_rate)
+{
+  const double rate = samples / seconds;
+  printf("%-24s %5u %14.0f %10.1f\n", name, mics, rate, rate / output_rate);
+}
+
+
+// Results are summed into here so that the work can't be optimised away.
+static volatile int32_t sink;
+
+template <unsigned MICS>
+static void bench_two_stage(unsigned blocks)
+{
+  using TDecimator = mic_array::TwoStageDecimator<MICS, STAGE2_DEC_FACTOR, 
+                                                  STAGE2_TAP_COUNT>;
+  static TDecimator dec;
+  dec.Init(stage1_coef, stage2_coef, stage2_shr);
+
+  const double seconds = time_blocks([](uint32_t* pdm){
+    int32_t out[MICS];
+    dec.ProcessBlock(out, pdm);
+    sink += out[0];
+  }, TDecimator::BLOCK_SIZE, blocks);
+
+  report("TwoStageDecimator", MICS, blocks, seconds, 
+         PDM_FREQ / (32.0 * STAGE2_DEC_FACTOR));
+}
+
+template <unsigned MICS>
+static void bench_two_stage_lut(unsigned blocks)
+{
+  using TDecimator = mic_array::TwoStageDecimator<MICS, STAGE2_DEC_FACTOR, 
+                                  STAGE2_TAP_COUNT, 
+                                  mic_array::NopSampleFilter<MICS>,
+                                  mic_array::STAGE1_LUT>;
+  static uint32_t stage1_lut[FIR_1X16_BIT_LUT_WORDS];
+  static TDecimator dec;
+  fir_1x16_bit_lut_init(stage1_lut, stage1_coef, 16);
+  dec.Init(stage1_lut, stage2_coef, stage2_shr);
+
+  const double seconds = time_blocks([](uint32_t* pdm){
+    int32_t out[MICS];
+    dec.ProcessBlock(out, pdm);
+    sink += out[0];
+  }, TDecimator::BLOCK_SIZE, blocks);
+
+  report("TwoStageDecimator (LUT)", MICS, blocks, seconds, 
+         PDM_FREQ / (32.0 * STAGE2_DEC_FACTOR));
+}
+
+template <unsigned MICS>
+static void bench_cic(unsigned blocks)
+{
+  using TDecimator = mic_array::CicDecimator<MICS>;
+  static TDecimator dec;
+  dec.Init();
+
+  const double seconds = time_blocks([](uint32_t* pdm){
+    int32_t out[MICS];
+    dec.ProcessBlock(out, pdm);
+    sink += out[0];
+  }, TDecimator::BLOCK_SIZE, blocks);
+
+  report("CicDecimator", MICS, blocks, seconds, 
+         PDM_FREQ / (double) TDecimator::SamplePeriod);
+}
+
+template <unsigned MICS>
+static void bench_one_stage_192(unsigned blocks)
+{
+  using TDecimator = mic_array::OneStageDecimator192<MICS>;
+  static TDecimator dec;
+  dec.Init();
+
+  const double seconds = time_blocks([](uint32_t* pdm){
+    int32_t out[TDecimator::SamplesPerBlock][MICS];
+    dec.ProcessBlock(out, pdm);
+    sink += out[0][0];
+  }, TDecimator::BLOCK_SIZE, blocks);
+
+  report("OneStageDecimator192", MICS, blocks * TDecimator::SamplesPerBlock, 
+         seconds, PDM_FREQ / 16.0);
+}
+
+template <unsigned MICS>
+static void bench_deinterleave(unsigned blocks)
+{
+  const double seconds = time_blocks([](uint32_t* pdm){
+    mic_array::deinterleave_pdm_samples<MICS>(pdm, STAGE2_DEC_FACTOR);
+  }, MICS * STAGE2_DEC_FACTOR, blocks);
+
+  report("deinterleave_pdm_samples", MICS, blocks, seconds,
+         PDM_FREQ / (32.0 * STAGE2_DEC_FACTOR));
+}
+
+
+int main(int argc, char** argv)
+{
+  const unsigned blocks = (argc > 1)? strtoul(argv[1], nullptr, 0) : 20000;
+
+  check_fir_1x16_bit();
+  check_deinterleave<2>();
+  check_deinterleave<4>();
+  check_deinterleave<8>();
+  check_deinterleave<16>();
+
+  if(failures){
+    printf("%u reference kernel check(s) failed.\n", failures);
+    return 1;
+  }
+
+  printf("%-24s %5s %14s %10s\n", "Configuration", "Mics", "Samples/s", "x Realtime");
+
+  bench_two_stage<1>(blocks);
+  bench_two_stage<2>(blocks);
+  bench_two_stage<4>(blocks);
+  bench_two_stage<8>(blocks);
+  bench_two_stage<16>(blocks);
+
+  bench_two_stage_lut<1>(blocks);
+  bench_two_stage_lut<4>(blocks);
+  bench_two_stage_lut<16>(blocks);
+
+  bench_cic<1>(blocks);
+  bench_cic<4>(blocks);
+  bench_cic<16>(blocks);
+
+  bench_one_stage_192<1>(blocks);
+  bench_one_stage_192<2>(blocks);
+  bench_one_stage_192<4>(blocks);
+  bench_one_stage_192<8>(blocks);
+
+  bench_deinterleave<2>(blocks);
+  bench_deinterleave<4>(blocks);
+  bench_deinterleave<8>(blocks);
+  bench_deinterleave<16>(blocks);
+
+  return 0;
+}
@@ -0,0 +1,57 @@
+# Copyright 2024 XMOS LIMITED.
+# This Software is subject to the terms of the XMOS Public Licence: Version 1.
+
+import numpy as np
+from mic_array.device_context import DeviceContext
+
+
+class BulkDecimatorDevice(DeviceContext):
+  """
+  Streams PDM words to the BulkDecimator app in chunks of many blocks,
+  without waiting for the output of each block, and collects the output of a
+  chunk once it has all been sent.
+  """
+
+  def __init__(self, xe_path, /, extra_xrun_args="", **kwargs):
+    super().__init__(xe_path, probes=["meta_out", "data_out"], extra_xrun_args=extra_xrun_args, **kwargs)
+
+    self.channels = None # unknown initially
+
+  def next_data(self, count=1):
+    return self.probe_next("data_out", count=count)
+
+  def next_meta(self, count=1):
+    return self.probe_next("meta_out", count=count)
+
+  def _on_connect(self):
+    self.param = {
+      "channels": self.next_meta(),
+      "decimator_192": self.next_meta(),
+      "block_words": self.next_meta(),
+      "samples_per_block": self.next_meta(),
+    }
+    self.channels = self.param["channels"]
+    self.block_words = self.param["block_words"]
+    self.samples_per_block = self.param["samples_per_block"]
+
+  def start(self, blocks: int):
+    """Tell the device how many blocks will be sent in all."""
+    self.send_word(blocks)
+
+  def process_chunk(self, words: np.ndarray) -> np.ndarray:
+    """
+    Decimate the next PDM words, of shape (WORDS, CHANS), WORDS a multiple of
+    the block length. Returns int32 of shape (CHANS, SAMPLES).
+    """
+    WORDS, CHANS = words.shape
+    assert CHANS == self.channels
+    blocks = WORDS // self.block_words
+    assert blocks * self.block_words == WORDS
+
+    # The device takes each block as [CHANS][block_words]
+    blk = np.asarray(words, dtype='<u4').reshape((blocks, self.block_words, CHANS))
+    self.send_bytes(np.ascontiguousarray(blk.transpose((0, 2, 1))).tobytes())
+
+    count = blocks * self.samples_per_block * CHANS
+    out = np.array(self.next_data(count=count), dtype=np.int32)
+    return out.reshape((blocks * self.samples_per_block, CHANS)).T
@@ -0,0 +1,17 @@
+# Copyright 2024 XMOS LIMITED.
+# This Software is subject to the terms of the XMOS Public Licence: Version 1.
+
+import sys, os, pytest
+sys.path.append(os.path.join(os.path.dirname(__file__), '..', '..','..',"python"))
+
+def pytest_addoption(parser):
+    parser.addoption("--build-dir", action="store", default='.')
+    parser.addoption("--seconds", type=float, default=10.0,
+                     help="Length of the signal in seconds of audio.")
+    parser.addoption("--chunk-blocks", type=int, default=4096,
+                     help="Blocks sent and checked per chunk.")
+    parser.addoption("--pdm-file", action="store", default=None,
+                     help="Raw PDM input: little-endian uint32 words, as [word][channel].")
+    parser.addoption("--signal", action="store", default="loud",
+                     choices=["loud", "random"],
+                     help="Signal to generate when no --pdm-file is given.")
@@ -0,0 +1,80 @@
+// Copyright 2024 XMOS LIMITED.
+// This Software is subject to the terms of the XMOS Public Licence: Version 1.
+
+#include <cstdio>
+#include <cstdint>
+
+#include <xcore/channel.h>
+#include <xcore/channel_streaming.h>
+
+extern "C" {
+#include "xscope.h"
+}
+
+#include "mic_array.h"
+
+#ifndef CHAN_COUNT
+# error CHAN_COUNT must be defined.
+#endif
+#ifndef DECIMATOR_192
+# error DECIMATOR_192 must be defined.
+#endif
+
+// Both decimators use the library's default filters, so that what is tested
+// is exactly what an application gets. The host models them bit for bit.
+#if DECIMATOR_192
+using TDecimator = mic_array::OneStageDecimator192<CHAN_COUNT>;
+#else
+using TDecimator = mic_array::TwoStageDecimator<CHAN_COUNT,
+                                                STAGE2_DEC_FACTOR,
+                                                STAGE2_TAP_COUNT>;
+#endif
+
+static constexpr unsigned SAMPLES_PER_BLOCK =
+    mic_array::DecimatorSamplesPerBlock<TDecimator>::value;
+
+static TDecimator decimator;
+
+
+void process_signal(chanend_t c_from_host)
+{
+#if DECIMATOR_192
+  decimator.Init(s1_fir_coef);
+#else
+  decimator.Init(stage1_coef, stage2_coef, stage2_shr);
+#endif
+
+  // Host will tell us how many blocks it intends to send. It streams them
+  // without waiting for the output of each, so the blocks are consumed as
+  // fast as xscope delivers them.
+  unsigned block_count = s_chan_in_word(c_from_host);
+
+  uint32_t buffer[TDecimator::BLOCK_SIZE];
+  int32_t sample_out[SAMPLES_PER_BLOCK][CHAN_COUNT];
+
+  printf("Processing %u blocks of PDM samples..\n", block_count);
+  for(unsigned k = 0; k < block_count; k++){
+    s_chan_in_buf_word(c_from_host, &buffer[0], TDecimator::BLOCK_SIZE);
+#if DECIMATOR_192
+    decimator.ProcessBlock(sample_out, buffer);
+#else
+    decimator.ProcessBlock(sample_out[0], buffer);
+#endif
+    for(int s = 0; s < SAMPLES_PER_BLOCK; s++)
+      for(int c = 0; c < CHAN_COUNT; c++)
+        xscope_int(DATA_OUT, sample_out[s][c]);
+  }
+  printf("Finished processing PDM signal.\n");
+}
+
+extern "C"
+void run(chanend_t c_from_host)
+{
+  // Tell the host script what is being tested
+  xscope_int(META_OUT, CHAN_COUNT);
+  xscope_int(META_OUT, DECIMATOR_192);
+  xscope_int(META_OUT, TDecimator::BLOCK_SIZE / CHAN_COUNT); // words per mic
+  xscope_int(META_OUT, SAMPLES_PER_BLOCK);
+
+  process_signal(c_from_host);
+}
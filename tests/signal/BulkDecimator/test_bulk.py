@@ -0,0 +1,168 @@
+# Copyright 2024 XMOS LIMITED.
+# This Software is subject to the terms of the XMOS Public Licence: Version 1.
+
+######
+# Test: Bulk bit-exact decimator regression
+#
+# Streams long PDM signals (minutes of audio, if asked for) through the
+# library's default decimators on the device, and checks every output sample
+# against the bit-exact models in mic_array.filters: TwoStageDecimatorModel
+# for TwoStageDecimator, and OneStage192Filter for OneStageDecimator192.
+#
+# The signal is read from a file of raw PDM words, so that a failing signal
+# can be kept and replayed. If no file is given one is generated: a loud,
+# density-modulated sine with full-scale steps, to drive the filters into
+# saturation (--signal loud), or uniformly random bits (--signal random).
+# It is sent and checked one chunk of blocks at a time, so the length of the
+# signal is limited only by the time taken.
+#
+# Notes:
+#  - This test assumes that the CMake targets for this app are all already
+#    built.
+#  - This test directly launches xgdb, and so the XTC tools must be on your
+#    path.
+#  - An appropriate xCore device must be connected to the host using xTag
+#  - This test should be executed with pytest. To run it, navigate to the root
+#    of your CMake build directory, and run:
+#       > pytest path/to/this/dir/test_bulk.py --seconds 300
+######
+
+import re
+import numpy as np
+from mic_array import filters
+from bulk_device import BulkDecimatorDevice
+import pytest
+from pathlib import Path
+import json
+
+with open(Path(__file__).parent / "test_params.json") as f:
+    params = json.load(f)
+
+LIB_DIR = Path(__file__).parents[3] / "lib_mic_array_192"
+
+PDM_FREQ = 3072000
+HISTORY_WORDS = 8
+
+
+def c_source(rel_path):
+  return re.sub(r"//[^\n]*|/\*.*?\*/", "", (LIB_DIR / rel_path).read_text(), flags=re.S)
+
+def c_define(name):
+  m = re.search(r"#define\s+" + name + r"\s+(\d+)", c_source("api/mic_array/etc/filters_default.h"))
+  return int(m.group(1))
+
+def c_array(rel_path, name, length):
+  """The initializer of a C array, zero padded to its declared length."""
+  m = re.search(r"\b" + name + r"\s*\[[^\]]*\]\s*=\s*\{(.*?)\}", c_source(rel_path), re.S)
+  vals = [int(v, 0) for v in re.findall(r"-?0[xX][0-9a-fA-F]+|-?\d+", m.group(1))]
+  assert len(vals) <= length
+  return vals + [0] * (length - len(vals))
+
+def c_scalar(rel_path, name):
+  m = re.search(r"\b" + name + r"\s*=\s*(-?\d+)\s*;", c_source(rel_path))
+  return int(m.group(1))
+
+
+def two_stage_model(chans):
+  # Defaults passed to TwoStageDecimator::Init() by the device app
+  taps = c_define("STAGE2_TAP_COUNT")
+  s1_coef = np.array(c_array("src/etc/stage1_fir_coef.c", "stage1_coef", 128), dtype=np.uint32)
+  s2_coef = np.array(c_array("src/etc/stage2_fir_coef.c", "stage2_coef", taps), dtype=np.int64)
+  s2_shr = c_scalar("src/etc/stage2_fir_coef.c", "stage2_shr")
+  return filters.TwoStageDecimatorModel(chans, s1_coef, s2_coef, s2_shr,
+                                        c_define("STAGE2_DEC_FACTOR"))
+
+
+class OneStage192Model(object):
+  """OneStage192Filter, with the PDM history carried from chunk to chunk."""
+
+  def __init__(self, chans):
+    self.filter = filters.OneStage192Filter()
+    self.history = np.full((chans, HISTORY_WORDS-1), filters.OneStage192Filter.HISTORY_FILL,
+                           dtype=np.uint32)
+
+  def FilterWords(self, words):
+    out = self.filter.FilterWords(words, history=self.history)
+    self.history = np.concatenate((self.history, words), axis=1)[:,-(HISTORY_WORDS-1):]
+    return out
+
+
+def generate_signal(path, kind, chans, words, seed=1):
+  """
+  Write `words` PDM words per channel to `path`, as little-endian uint32 in
+  [word][channel] order, a piece at a time.
+  """
+  rng = np.random.default_rng(seed)
+  PIECE = 4096
+  # Each channel gets its own tone, between 100 Hz and ~7 kHz
+  freq = 100.0 + 6900.0 * np.arange(chans) / max(chans, 1)
+  with open(path, "wb") as f:
+    for start in range(0, words, PIECE):
+      n = min(PIECE, words - start)
+      if kind == "random":
+        w = rng.integers(0, 2**32, size=(n, chans), dtype=np.uint32)
+      else:
+        t = (32 * start + np.arange(32 * n)) / PDM_FREQ
+        level = 0.95 * np.sin(2 * np.pi * freq[:,np.newaxis] * t)
+        # 50 ms at positive then negative full scale every second: the step
+        # gives the largest stage 2 overshoot, and so saturation.
+        phase = t % 1.0
+        level[:,(phase >= 0.50) & (phase < 0.55)] = 1.0
+        level[:,(phase >= 0.55) & (phase < 0.60)] = -1.0
+        # A set bit is -1
+        bits = (rng.random(level.shape) < (1 - level) / 2).astype(np.uint8)
+        w = np.packbits(bits, axis=1, bitorder='little').view('<u4').T
+      np.ascontiguousarray(w, dtype='<u4').tofile(f)
+
+
+@pytest.mark.parametrize("config", params["CONFIG"], ids=[f"{c['DECIMATOR']}_{c['N_MICS']}ch" for c in params["CONFIG"]])
+def test_bulk(request, tmp_path, config):
+  chans = config["N_MICS"]
+  cfg = f"{config['DECIMATOR']}_{chans}ch"
+  is_192 = config["DECIMATOR"] == "OneStage192"
+
+  cwd = Path(request.fspath).parent
+  xe_path = f'{cwd}/bin/{cfg}/tests-signal-bulk-decimator_{cfg}.xe'
+  assert Path(xe_path).exists(), f"Cannot find {xe_path}"
+
+  chunk_blocks = request.config.getoption("chunk_blocks")
+  pdm_file = request.config.getoption("pdm_file")
+
+  block_words = 1 if is_192 else c_define("STAGE2_DEC_FACTOR")
+  if pdm_file is None:
+    seconds = request.config.getoption("seconds")
+    words = int(seconds * PDM_FREQ / 32) // block_words * block_words
+    pdm_file = tmp_path / "pdm_in.bin"
+    generate_signal(pdm_file, request.config.getoption("signal"), chans, words)
+
+  signal = np.memmap(pdm_file, dtype='<u4', mode='r').reshape((-1, chans))
+  blocks = signal.shape[0] // block_words
+  print(f"\n{cfg}: {blocks} blocks ({blocks * block_words * 32 / PDM_FREQ:.1f} s) from {pdm_file}")
+
+  model = OneStage192Model(chans) if is_192 else two_stage_model(chans)
+
+  with BulkDecimatorDevice(xe_path, extra_xrun_args="--id 0") as dev:
+
+    assert dev.param["channels"] == chans
+    assert dev.param["decimator_192"] == int(is_192)
+    assert dev.param["block_words"] == block_words
+
+    dev.start(blocks)
+
+    out_index = 0
+    for start in range(0, blocks, chunk_blocks):
+      end = min(start + chunk_blocks, blocks)
+      words = np.array(signal[start * block_words:end * block_words,:])
+
+      device_output = dev.process_chunk(words)
+      expected = model.FilterWords(words.T)
+
+      if not np.array_equal(expected, device_output):
+        ch, k = np.argwhere(expected != device_output)[0]
+        k_abs = out_index + k
+        seconds = k_abs * block_words * 32 / (PDM_FREQ * dev.samples_per_block)
+        pytest.fail(f"Channel {ch}, sample {k_abs} ({seconds:.4f} s): expected "
+                    f"{expected[ch,k]}, device gave {device_output[ch,k]}. "
+                    f"Signal: {pdm_file}")
+
+      out_index += device_output.shape[1]
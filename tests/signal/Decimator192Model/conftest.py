@@ -0,0 +1,5 @@
+# Copyright 2024 XMOS LIMITED.
+# This Software is subject to the terms of the XMOS Public Licence: Version 1.
+
+import sys, os
+sys.path.append(os.path.join(os.path.dirname(__file__), '..', '..','..',"python"))
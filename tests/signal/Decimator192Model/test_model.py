@@ -0,0 +1,118 @@
+# Copyright 2024 XMOS LIMITED.
+# This Software is subject to the terms of the XMOS Public Licence: Version 1.
+
+######
+# Test: OneStage192Filter model
+#
+# Checks the vectorised model of OneStageDecimator192 in mic_array.filters
+# against a direct emulation of the device: a PDM history updated as
+# ProcessBlock() does, and fir_1x16_bit() computed bit plane by bit plane as
+# VLMACCR1 does. Runs on the host only; no device is needed.
+#
+#   > pytest path/to/this/dir/test_model.py
+######
+
+import re
+from pathlib import Path
+
+import numpy as np
+import pytest
+from mic_array import filters
+
+COEF_SOURCE = Path(__file__).parents[3] / "lib_mic_array_192" / "src" / "etc" / "stage1_192_fir_coef.c"
+
+
+def popcount32(x: int) -> int:
+  return bin(x & 0xFFFFFFFF).count("1")
+
+
+def fir_1x16_bit_direct(signal, coef, coef_bits=16):
+  acc = 0
+  for bit in range(coef_bits):
+    plane = 128 - sum(popcount32(signal[k] ^ int(coef[8*bit+k])) for k in range(8))
+    acc += plane * ((1 << bit) - 1 if bit == coef_bits - 1 else (1 << bit))
+  return acc << (24 - coef_bits)
+
+
+def to_int32(x: int) -> int:
+  x &= 0xFFFFFFFF
+  return x - (1 << 32) if x & 0x80000000 else x
+
+
+def decimate_direct(words, coef):
+  # words[chan][block]; mirrors OneStageDecimator192::ProcessBlock()
+  chans, blocks = words.shape
+  out = np.zeros((chans, 2*blocks), dtype=np.int32)
+  for ch in range(chans):
+    hist = [0x55555555] * 8
+    delayed = [0x55555555] * 8
+    for n in range(blocks):
+      w = int(words[ch, n])
+      delayed[0] = (delayed[0] & 0xFFFF) | ((w << 16) & 0xFFFFFFFF)
+      hist = [w] + hist[:-1]
+      delayed = [w >> 16] + delayed[:-1]
+      out[ch, 2*n]   = to_int32(fir_1x16_bit_direct(hist, coef) << 3)
+      out[ch, 2*n+1] = to_int32(fir_1x16_bit_direct(delayed, coef) << 3)
+  return out
+
+
+def test_coef_matches_device():
+  text = COEF_SOURCE.read_text()
+  table = text[text.index("s1_fir_coef[S1_WORDS]"):]
+  table = table[:table.index("};")]
+  words = [int(x, 16) for x in re.findall(r"0x[0-9A-Fa-f]{8}", table)]
+  assert np.array_equal(np.array(words, dtype=np.uint32), filters.S1_FIR_COEF_192)
+
+
+@pytest.mark.parametrize("coef_bits", [16, 12, 8])
+@pytest.mark.parametrize("seed", range(4))
+def test_fir_1x16_bit(seed, coef_bits):
+  rng = np.random.default_rng(seed)
+  coef = rng.integers(0, 2**32, size=8*coef_bits, dtype=np.uint32)
+  signal = rng.integers(0, 2**32, size=(50, 8), dtype=np.uint32)
+
+  fir = filters.Fir1x16Bit(coef, coef_bits)
+  got = fir.Filter(signal)
+  expected = [to_int32(fir_1x16_bit_direct([int(x) for x in s], coef, coef_bits)) for s in signal]
+
+  assert np.array_equal(got, np.array(expected, dtype=np.int32))
+
+
+@pytest.mark.parametrize("coef_bits", [12, 8])
+def test_requantized_coef(coef_bits):
+  # The shipped table, reduced to coef_bits, must survive Stage1Filter's
+  # encoding exactly, with its zero taps still zero.
+  taps = filters.fir_1x16_bit_taps(filters.S1_FIR_COEF_192)
+  coefs = taps.reshape(8,32)[::-1].reshape(256).astype(np.int16)
+  small = filters.requantize_coefs(coefs, coef_bits)
+  words = filters.Stage1Filter(small, 16, coef_bits).ToXCoreCoefArray()
+
+  assert len(words) == 8*coef_bits
+  got = filters.fir_1x16_bit_taps(words, coef_bits).reshape(8,32)[::-1].reshape(256)
+  assert np.array_equal(got, small)
+  assert not np.any(got[240:])
+
+
+@pytest.mark.parametrize("chans", [1, 2, 4])
+def test_one_stage_192(chans):
+  rng = np.random.default_rng(chans)
+  words = rng.integers(0, 2**32, size=(chans, 40), dtype=np.uint32)
+
+  model = filters.OneStage192Filter()
+  expected = decimate_direct(words, filters.S1_FIR_COEF_192)
+
+  assert np.array_equal(model.FilterWords(words), expected)
+  # Chunking must not change anything
+  assert np.array_equal(model.FilterWords(words, chunk_blocks=7), expected)
+
+
+def test_one_stage_192_bipolar():
+  rng = np.random.default_rng(1234)
+  words = rng.integers(0, 2**32, size=(2, 16), dtype=np.uint32)
+
+  # bit k of word j is sample 32*j+k, and a set bit is -1
+  bits = (words[:,:,np.newaxis] >> np.arange(32, dtype=np.uint32)) & 1
+  signal = (1 - 2*bits.astype(np.int32)).reshape((2, 16*32))
+
+  model = filters.OneStage192Filter()
+  assert np.array_equal(model.Filter(signal), model.FilterWords(words))
@@ -18,18 +18,67 @@ int main(int argc, const char* argv[])
   RUN_TEST_GROUP(dcoe_state_init);
   RUN_TEST_GROUP(dcoe_filter);
   RUN_TEST_GROUP(DcoeSampleFilter);
+  RUN_TEST_GROUP(VectorDcoeSampleFilter);
+  RUN_TEST_GROUP(SampleFilterChain);
+  RUN_TEST_GROUP(CalibrationSampleFilter);
+  RUN_TEST_GROUP(LevelMeterSampleFilter);
+  RUN_TEST_GROUP(OutputScaler);
+  RUN_TEST_GROUP(StageProfiler);
+  RUN_TEST_GROUP(ClockGovernor);
   
   RUN_TEST_GROUP(ma_frame_tx_rx);
   RUN_TEST_GROUP(ma_frame_tx_rx_transpose);
+  RUN_TEST_GROUP(ma_frame_tx_rx_packed);
   RUN_TEST_GROUP(ChannelFrameTransmitter);
+  RUN_TEST_GROUP(ChannelSampleOutputHandler);
+  RUN_TEST_GROUP(TdmOutputHandler);
+  RUN_TEST_GROUP(SharedMemoryFrameTransmitter);
+  RUN_TEST_GROUP(FanOutFrameTransmitter);
+  RUN_TEST_GROUP(StreamingFrameTransmitter);
+  RUN_TEST_GROUP(QueuedFrameTransmitter);
+  RUN_TEST_GROUP(RingBufferFrameTransmitter);
+  RUN_TEST_GROUP(GatedFrameTransmitter);
   RUN_TEST_GROUP(FrameOutputHandler);
+  RUN_TEST_GROUP(OverlapFrameOutputHandler);
+  RUN_TEST_GROUP(FftOutputHandler);
+  RUN_TEST_GROUP(DualRateOutputHandler);
+  RUN_TEST_GROUP(ResamplingOutputHandler);
+  RUN_TEST_GROUP(BeamformOutputHandler);
   
   RUN_TEST_GROUP(deinterleave2);
   RUN_TEST_GROUP(deinterleave4);
   RUN_TEST_GROUP(deinterleave8);
   RUN_TEST_GROUP(deinterleave16);
 
+  RUN_TEST_GROUP(ChannelPdmRxService);
   RUN_TEST_GROUP(deinterleave_pdm_samples);
+  RUN_TEST_GROUP(MultiPortPdmRxService);
+  RUN_TEST_GROUP(SharedMemPdmRxService);
+  RUN_TEST_GROUP(StandardPdmRxService);
+  RUN_TEST_GROUP(pdm_rx_isr_dual);
+  RUN_TEST_GROUP(PdmTap);
+  RUN_TEST_GROUP(PdmHealthMonitor);
+
+  RUN_TEST_GROUP(fir_1x16_bit_dual_signal);
+  RUN_TEST_GROUP(fir_1x16_bit_multi);
+  RUN_TEST_GROUP(fir_1xN_bit);
+  RUN_TEST_GROUP(fir_1x16_bit_lut);
+  RUN_TEST_GROUP(fir_s32_multi);
+  RUN_TEST_GROUP(fir_s16_multi);
+  RUN_TEST_GROUP(PdmHistory);
+  RUN_TEST_GROUP(Stage2Filter);
+  RUN_TEST_GROUP(Stage2FilterS16);
+  RUN_TEST_GROUP(OneStageDecimator192);
+  RUN_TEST_GROUP(TwoStageDecimator);
+  RUN_TEST_GROUP(CicDecimator);
+  RUN_TEST_GROUP(MultiRateDecimator);
+  RUN_TEST_GROUP(ParallelDecimator);
+  RUN_TEST_GROUP(PipelinedTwoStageDecimator);
+  RUN_TEST_GROUP(PdmPassthroughDecimator);
+  RUN_TEST_GROUP(ScalableMicArray);
+  RUN_TEST_GROUP(MicArray);
+
+  RUN_TEST_GROUP(kernel_timing);
   
   return UNITY_END();
 }
@@ -0,0 +1,226 @@
+// Copyright 2020-2024 XMOS LIMITED.
+// This Software is subject to the terms of the XMOS Public Licence: Version 1.
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <assert.h>
+#include <stdarg.h>
+
+#include "unity_fixture.h"
+
+#include "mic_array/cpp/OutputHandler.hpp"
+
+extern "C" {
+
+TEST_GROUP_RUNNER(BeamformOutputHandler) {
+  RUN_TEST_CASE(BeamformOutputHandler, broadside_mics4_beams1);
+  RUN_TEST_CASE(BeamformOutputHandler, broadside_mics8_beams2);
+  RUN_TEST_CASE(BeamformOutputHandler, integer_mics4_beams2);
+  RUN_TEST_CASE(BeamformOutputHandler, integer_mics7_beams3);
+  RUN_TEST_CASE(BeamformOutputHandler, fractional_mics4_beams2);
+  RUN_TEST_CASE(BeamformOutputHandler, fractional_mics2_taps3);
+  RUN_TEST_CASE(BeamformOutputHandler, block_mics8_beams4);
+}
+
+TEST_GROUP(BeamformOutputHandler);
+TEST_SETUP(BeamformOutputHandler) {}
+TEST_TEAR_DOWN(BeamformOutputHandler) {}
+
+}
+
+
+#define MAX_FRAMES  20
+
+template <unsigned MIC_COUNT, unsigned SAMPLE_COUNT>
+class MockBeamTransmitter
+{
+  public:
+
+    unsigned count = 0;
+    int32_t frames[MAX_FRAMES][MIC_COUNT][SAMPLE_COUNT];
+
+    void OutputFrame(int32_t frame[MIC_COUNT][SAMPLE_COUNT])
+    {
+      assert(count < MAX_FRAMES);
+      memcpy(&frames[count][0][0], &frame[0][0], sizeof(frames[0]));
+      count++;
+    }
+};
+
+
+static int32_t rand_sample()
+{
+  // Leaves enough headroom that no beam sum saturates.
+  return ((int32_t) ((((uint32_t) rand()) << 16) ^ ((uint32_t) rand()))) >> 4;
+}
+
+// The kernel rounds each product to the input's scale before summing.
+static int32_t scale(int32_t x, int32_t tap)
+{
+  return (int32_t) ((((int64_t) x) * tap + (1 << 29)) >> 30);
+}
+
+
+// Each beam must be the sum over mics of the mic's input `delay[b][k]`
+// samples earlier, times weight[b][k].
+template <unsigned MICS, unsigned BEAMS, unsigned FRAME, unsigned TAPS>
+static
+void test_integer(bool broadside, bool blocks)
+{
+  using THandler = mic_array::BeamformOutputHandler<MICS, BEAMS, FRAME,
+                                                    MockBeamTransmitter, TAPS>;
+
+  srand(35521 * MICS + 7 * BEAMS + TAPS);
+
+  constexpr unsigned FRAMES = 6;
+  constexpr unsigned SAMPLE_COUNT = FRAMES * FRAME;
+  static_assert(FRAMES <= MAX_FRAMES, "");
+
+  THandler* handler = new THandler();
+  handler->Init();
+
+  int32_t weight[BEAMS][MICS];
+  unsigned delay[BEAMS][MICS];
+  for(int b = 0; b < BEAMS; b++){
+    for(int k = 0; k < MICS; k++){
+      if(broadside){
+        weight[b][k] = (THandler::TAP_UNITY + MICS / 2) / MICS;
+        delay[b][k] = 0;
+      } else {
+        // Weights which are exact in Q2.30.
+        weight[b][k] = THandler::TAP_UNITY >> (2 + (rand() % 3));
+        delay[b][k] = rand() % TAPS;
+        handler->SetSteering(b, k, weight[b][k] / (float) THandler::TAP_UNITY,
+                             delay[b][k]);
+      }
+    }
+  }
+
+  int32_t input[SAMPLE_COUNT][MICS];
+  for(int s = 0; s < SAMPLE_COUNT; s++)
+    for(int k = 0; k < MICS; k++)
+      input[s][k] = rand_sample();
+
+  if(blocks){
+    for(int f = 0; f < FRAMES; f++)
+      handler->OutputSamples(
+          *reinterpret_cast<int32_t (*)[FRAME][MICS]>(&input[f * FRAME][0]));
+  } else {
+    for(int s = 0; s < SAMPLE_COUNT; s++)
+      handler->OutputSample(input[s]);
+  }
+
+  TEST_ASSERT_EQUAL_UINT(FRAMES, handler->FrameTx.count);
+
+  for(int s = 0; s < SAMPLE_COUNT; s++){
+    for(int b = 0; b < BEAMS; b++){
+      int32_t expected = 0;
+      for(int k = 0; k < MICS; k++)
+        if(s >= (int) delay[b][k])
+          expected += scale(input[s - delay[b][k]][k], weight[b][k]);
+
+      TEST_ASSERT_EQUAL_INT32(expected,
+          handler->FrameTx.frames[s / FRAME][b][s % FRAME]);
+    }
+  }
+
+  delete handler;
+}
+
+
+// In steady state, a linear ramp on every mic must come out of each beam as
+// the sum of the weighted ramps, each shifted by its fractional delay.
+template <unsigned MICS, unsigned BEAMS, unsigned TAPS>
+static
+void test_fractional()
+{
+  constexpr unsigned FRAME = 4;
+  using THandler = mic_array::BeamformOutputHandler<MICS, BEAMS, FRAME,
+                                                    MockBeamTransmitter, TAPS>;
+
+  srand(88123 * MICS + BEAMS + TAPS);
+
+  constexpr unsigned FRAMES = 10;
+  constexpr unsigned SAMPLE_COUNT = FRAMES * FRAME;
+
+  THandler* handler = new THandler();
+  handler->Init();
+
+  float weight[BEAMS][MICS];
+  float delay[BEAMS][MICS];
+  for(int b = 0; b < BEAMS; b++){
+    for(int k = 0; k < MICS; k++){
+      weight[b][k] = 1.0f / MICS;
+      delay[b][k] = (rand() % (1000 * (TAPS - 1) + 1)) / 1000.0f;
+      handler->SetSteering(b, k, weight[b][k], delay[b][k]);
+    }
+  }
+
+  int32_t slope[MICS];
+  for(int k = 0; k < MICS; k++)
+    slope[k] = (rand() % 20001) - 10000;
+
+  for(int s = 0; s < SAMPLE_COUNT; s++){
+    int32_t sample[MICS];
+    for(int k = 0; k < MICS; k++)
+      sample[k] = slope[k] * (s + 1);
+    handler->OutputSample(sample);
+  }
+
+  TEST_ASSERT_EQUAL_UINT(FRAMES, handler->FrameTx.count);
+
+  for(int s = TAPS; s < SAMPLE_COUNT; s++){
+    for(int b = 0; b < BEAMS; b++){
+      double expected = 0;
+      for(int k = 0; k < MICS; k++)
+        expected += weight[b][k] * slope[k] * (s + 1 - delay[b][k]);
+
+      TEST_ASSERT_INT32_WITHIN(8 * MICS, (int32_t) expected,
+          handler->FrameTx.frames[s / FRAME][b][s % FRAME]);
+    }
+  }
+
+  delete handler;
+}
+
+
+extern "C" {
+
+TEST(BeamformOutputHandler, broadside_mics4_beams1)
+{
+  test_integer<4,1,16,8>(true, false);
+}
+
+TEST(BeamformOutputHandler, broadside_mics8_beams2)
+{
+  test_integer<8,2,5,3>(true, false);
+}
+
+TEST(BeamformOutputHandler, integer_mics4_beams2)
+{
+  test_integer<4,2,16,8>(false, false);
+}
+
+TEST(BeamformOutputHandler, integer_mics7_beams3)
+{
+  test_integer<7,3,3,5>(false, false);
+}
+
+TEST(BeamformOutputHandler, fractional_mics4_beams2)
+{
+  test_fractional<4,2,8>();
+}
+
+TEST(BeamformOutputHandler, fractional_mics2_taps3)
+{
+  test_fractional<2,1,3>();
+}
+
+TEST(BeamformOutputHandler, block_mics8_beams4)
+{
+  test_integer<8,4,16,6>(false, true);
+}
+
+}
@@ -0,0 +1,232 @@
+// Copyright 2020-2024 XMOS LIMITED.
+// This Software is subject to the terms of the XMOS Public Licence: Version 1.
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <assert.h>
+#include <stdarg.h>
+#include <math.h>
+
+#include "unity_fixture.h"
+
+#include "mic_array/cpp/SampleFilter.hpp"
+
+extern "C" {
+
+TEST_GROUP_RUNNER(CalibrationSampleFilter) {
+  RUN_TEST_CASE(CalibrationSampleFilter, passthrough);
+  RUN_TEST_CASE(CalibrationSampleFilter, integer_delay);
+  RUN_TEST_CASE(CalibrationSampleFilter, gain);
+  RUN_TEST_CASE(CalibrationSampleFilter, fractional_delay);
+  RUN_TEST_CASE(CalibrationSampleFilter, taps5);
+  RUN_TEST_CASE(CalibrationSampleFilter, taps13);
+  RUN_TEST_CASE(CalibrationSampleFilter, block);
+  RUN_TEST_CASE(CalibrationSampleFilter, frame);
+}
+
+TEST_GROUP(CalibrationSampleFilter);
+TEST_SETUP(CalibrationSampleFilter) {}
+TEST_TEAR_DOWN(CalibrationSampleFilter) {}
+
+}
+
+static int32_t rand_sample()
+{
+  return (int32_t) ((uint32_t(rand()) << 17) ^ rand()) | 1;
+}
+
+static int32_t ref_sat(int64_t a)
+{
+  return (a > INT32_MAX)? INT32_MAX : (a < -INT32_MAX)? -INT32_MAX : a;
+}
+
+
+extern "C" {
+
+TEST(CalibrationSampleFilter, passthrough)
+{
+  constexpr unsigned MICS = 11;
+
+  srand(9981);
+
+  mic_array::CalibrationSampleFilter<MICS> filter;
+  filter.Init();
+
+  for(int r = 0; r < 100; r++){
+    int32_t expected[MICS];
+    int32_t sample[MICS];
+    for(int k = 0; k < MICS; k++)
+      expected[k] = sample[k] = rand_sample();
+
+    filter.Filter(sample);
+
+    TEST_ASSERT_EQUAL_INT32_ARRAY(expected, sample, MICS);
+  }
+}
+
+TEST(CalibrationSampleFilter, integer_delay)
+{
+  constexpr unsigned MICS = 4;
+  constexpr unsigned TAPS = 4;
+  constexpr unsigned SAMPLES = 20;
+
+  srand(5512);
+
+  mic_array::CalibrationSampleFilter<MICS, TAPS> filter;
+  filter.Init();
+  for(int k = 0; k < MICS; k++)
+    filter.SetCalibration(k, 1.0f, (float) k);
+
+  int32_t input[SAMPLES][MICS];
+  for(int s = 0; s < SAMPLES; s++){
+    int32_t sample[MICS];
+    for(int k = 0; k < MICS; k++)
+      sample[k] = input[s][k] = rand_sample();
+
+    filter.Filter(sample);
+
+    for(int k = 0; k < MICS; k++)
+      TEST_ASSERT_EQUAL_INT32((s >= k)? input[s-k][k] : 0, sample[k]);
+  }
+}
+
+TEST(CalibrationSampleFilter, gain)
+{
+  constexpr unsigned MICS = 3;
+
+  mic_array::CalibrationSampleFilter<MICS> filter;
+  filter.Init();
+  filter.SetCalibration(0, 0.5f, 0.0f);
+  filter.SetCalibration(1, 1.5f, 0.0f);
+  filter.SetCalibration(2, 1.9f, 0.0f);
+
+  int32_t sample[MICS] = { 1001, -1000, 0x60000000 };
+  filter.Filter(sample);
+
+  TEST_ASSERT_EQUAL_INT32(501, sample[0]);
+  TEST_ASSERT_EQUAL_INT32(-1500, sample[1]);
+  TEST_ASSERT_EQUAL_INT32(INT32_MAX, sample[2]);
+}
+
+// A delay of 1.5 samples on a low frequency tone must land (nearly) on the
+// tone 1.5 samples earlier.
+TEST(CalibrationSampleFilter, fractional_delay)
+{
+  constexpr unsigned MICS = 2;
+  const double w = 2 * M_PI / 64;
+
+  mic_array::CalibrationSampleFilter<MICS> filter;
+  filter.Init();
+  filter.SetCalibration(0, 1.0f, 1.5f);
+  filter.SetCalibration(1, 0.5f, 2.25f);
+
+  for(int t = 0; t < 200; t++){
+    int32_t sample[MICS];
+    sample[0] = sample[1] = (int32_t) (0x40000000 * sin(w * t));
+
+    filter.Filter(sample);
+
+    if(t >= 4){
+      TEST_ASSERT_INT32_WITHIN(0x40000000 / 1000, 
+          (int32_t) (0x40000000 * sin(w * (t - 1.5))), sample[0]);
+      TEST_ASSERT_INT32_WITHIN(0x40000000 / 1000, 
+          (int32_t) (0x20000000 * sin(w * (t - 2.25))), sample[1]);
+    }
+  }
+}
+
+}
+
+
+// With arbitrary taps the output must match a scalar FIR, and nothing may
+// be written past the last channel.
+template <unsigned MICS, unsigned TAPS>
+static
+void test_CalibrationSampleFilter_taps()
+{
+  srand(7781 + MICS);
+
+  mic_array::CalibrationSampleFilter<MICS, TAPS> filter;
+  filter.Init();
+
+  int32_t taps[MICS][TAPS];
+  for(int k = 0; k < MICS; k++){
+    for(int t = 0; t < TAPS; t++)
+      taps[k][t] = rand_sample() >> (1 + (rand() % 4));
+    filter.SetTaps(k, taps[k]);
+  }
+
+  int32_t input[TAPS][MICS];
+  memset(input, 0, sizeof(input));
+
+  for(int r = 0; r < 200; r++){
+    int32_t buff[MICS + 8];
+    int32_t expected[MICS + 8];
+    for(int k = 0; k < MICS + 8; k++)
+      expected[k] = buff[k] = rand_sample();
+
+    memmove(&input[1][0], &input[0][0], sizeof(int32_t) * MICS * (TAPS - 1));
+    memcpy(&input[0][0], buff, sizeof(int32_t) * MICS);
+
+    for(int k = 0; k < MICS; k++){
+      int64_t acc = 0;
+      for(int t = 0; t < TAPS; t++)
+        acc += (((int64_t) taps[k][t]) * input[t][k] + (1 << 29)) >> 30;
+      expected[k] = ref_sat(acc);
+    }
+
+    filter.Filter(buff);
+
+    TEST_ASSERT_EQUAL_INT32_ARRAY(expected, buff, MICS + 8);
+  }
+}
+
+// FilterSamples() and FilterFrame() must give the same result as Filter() on
+// each sample.
+template <unsigned MICS, unsigned SAMPLES, bool FRAME>
+static
+void test_CalibrationSampleFilter_batch()
+{
+  srand(3312 + MICS + SAMPLES);
+
+  mic_array::CalibrationSampleFilter<MICS> exp_filter;
+  mic_array::CalibrationSampleFilter<MICS> filter;
+  exp_filter.Init();
+  filter.Init();
+  for(int k = 0; k < MICS; k++){
+    exp_filter.SetCalibration(k, 0.7f + 0.1f * k, 0.3f * k);
+    filter.SetCalibration(k, 0.7f + 0.1f * k, 0.3f * k);
+  }
+
+  for(int r = 0; r < 20; r++){
+    int32_t samples[SAMPLES][MICS];
+    int32_t frame[MICS][SAMPLES];
+    int32_t expected[SAMPLES][MICS];
+
+    for(int s = 0; s < SAMPLES; s++){
+      for(int k = 0; k < MICS; k++)
+        expected[s][k] = samples[s][k] = frame[k][s] = rand_sample();
+      exp_filter.Filter(expected[s]);
+    }
+
+    if(FRAME){
+      filter.FilterFrame(frame);
+      for(int s = 0; s < SAMPLES; s++)
+        for(int k = 0; k < MICS; k++)
+          samples[s][k] = frame[k][s];
+    } else {
+      filter.FilterSamples(samples);
+    }
+
+    TEST_ASSERT_EQUAL_INT32_ARRAY(&expected[0][0], &samples[0][0], MICS*SAMPLES);
+  }
+}
+
+extern "C" {
+TEST(CalibrationSampleFilter, taps5)  { test_CalibrationSampleFilter_taps<5,3>();  }
+TEST(CalibrationSampleFilter, taps13) { test_CalibrationSampleFilter_taps<13,6>(); }
+TEST(CalibrationSampleFilter, block)  { test_CalibrationSampleFilter_batch<4,2,false>(); }
+TEST(CalibrationSampleFilter, frame)  { test_CalibrationSampleFilter_batch<10,16,true>(); }
+}
@@ -0,0 +1,146 @@
+// Copyright 2020-2024 XMOS LIMITED.
+// This Software is subject to the terms of the XMOS Public Licence: Version 1.
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <assert.h>
+#include <stdarg.h>
+
+#include <xcore/channel_streaming.h>
+
+#include "unity_fixture.h"
+
+#include "mic_array.h"
+
+extern "C" {
+
+TEST_GROUP_RUNNER(ChannelPdmRxService) {
+  RUN_TEST_CASE(ChannelPdmRxService, words_4_to_3);
+  RUN_TEST_CASE(ChannelPdmRxService, words_8_to_8);
+  RUN_TEST_CASE(ChannelPdmRxService, words_16_to_16);
+  RUN_TEST_CASE(ChannelPdmRxService, block_stamp);
+}
+
+TEST_GROUP(ChannelPdmRxService);
+
+static streaming_channel_t c_pdm_words;
+
+TEST_SETUP(ChannelPdmRxService) {
+  c_pdm_words = s_chan_alloc();
+}
+
+TEST_TEAR_DOWN(ChannelPdmRxService) {
+  s_chan_free(c_pdm_words);
+}
+
+}
+
+
+// Words received over the channel, one at a time as from
+// mic_array_pdm_forward(), must give the same blocks as a
+// StandardPdmRxService given the same words from its port.
+template <unsigned CH_IN, unsigned CH_OUT, unsigned SUBBLOCKS>
+static
+void test_words(
+    unsigned seed)
+{
+  using TRef = mic_array::StandardPdmRxService<CH_IN, CH_OUT, SUBBLOCKS>;
+  using TDut = mic_array::ChannelPdmRxService<CH_IN, CH_OUT, SUBBLOCKS>;
+  constexpr unsigned BLOCK_WORDS = CH_IN * SUBBLOCKS;
+  constexpr unsigned BLOCK_COUNT = 4;
+
+  static TRef ref_rx;
+  static TDut dut_rx;
+
+  ref_rx.Init(0);
+  dut_rx.Init(c_pdm_words.end_b);
+
+  srand(seed);
+
+  // Reverse the default mapping, so channel_map is actually exercised.
+  unsigned map[CH_OUT];
+  for(int ch = 0; ch < CH_OUT; ch++)
+    map[ch] = CH_IN - 1 - ch;
+  ref_rx.MapChannels(map);
+  dut_rx.MapChannels(map);
+
+  for(int blk = 0; blk < BLOCK_COUNT; blk++){
+    // In order of arrival.
+    uint32_t words[BLOCK_WORDS];
+    for(int k = 0; k < BLOCK_WORDS; k++)
+      words[k] = (((uint32_t) rand()) << 16) ^ ((uint32_t) rand());
+
+    // Stored in reverse order of arrival, as by ProcessNext().
+    uint32_t raw[BLOCK_WORDS];
+    for(int k = 0; k < BLOCK_WORDS; k++)
+      raw[BLOCK_WORDS-1-k] = words[k];
+
+    ref_rx.SendBlock(raw);
+    uint32_t expected[CH_OUT * SUBBLOCKS];
+    memcpy(expected, ref_rx.GetPdmBlock(), sizeof(expected));
+
+    for(int k = 0; k < BLOCK_WORDS; k++){
+      s_chan_out_word(c_pdm_words.end_a, words[k]);
+      dut_rx.ProcessNext();
+    }
+
+    uint32_t* out = dut_rx.GetPdmBlock();
+
+    TEST_ASSERT_EQUAL_UINT32_ARRAY(expected, out, CH_OUT * SUBBLOCKS);
+  }
+
+  TEST_ASSERT_EQUAL_UINT32(BLOCK_COUNT, dut_rx.GetStats().blocks);
+}
+
+extern "C" {
+
+TEST(ChannelPdmRxService, words_4_to_3)
+{
+  test_words<4, 3, 6>(0x44A1);
+}
+
+TEST(ChannelPdmRxService, words_8_to_8)
+{
+  test_words<8, 8, 3>(0x19E7);
+}
+
+TEST(ChannelPdmRxService, words_16_to_16)
+{
+  test_words<16, 16, 1>(0x7D35);
+}
+
+
+// Each block's stamp must count the blocks received, and give the time its
+// first word arrived.
+TEST(ChannelPdmRxService, block_stamp)
+{
+  constexpr unsigned CH_IN = 4;
+  constexpr unsigned SUBBLOCKS = 2;
+  constexpr unsigned BLOCK_COUNT = 5;
+
+  static mic_array::ChannelPdmRxService<CH_IN, CH_IN, SUBBLOCKS> pdm_rx;
+  pdm_rx.Init(c_pdm_words.end_b);
+
+  for(int blk = 0; blk < BLOCK_COUNT; blk++){
+    s_chan_out_word(c_pdm_words.end_a, 0x12345678);
+    const uint32_t before = get_reference_time();
+    pdm_rx.ProcessNext();
+    const uint32_t after = get_reference_time();
+    delay_ticks(1000);
+
+    for(int k = 1; k < CH_IN * SUBBLOCKS; k++){
+      s_chan_out_word(c_pdm_words.end_a, 0x12345678);
+      pdm_rx.ProcessNext();
+    }
+
+    pdm_rx.GetPdmBlock();
+
+    const mic_array::PdmBlockStamp stamp = pdm_rx.GetBlockStamp();
+    TEST_ASSERT_EQUAL_UINT32(blk, stamp.block_index);
+    TEST_ASSERT(stamp.timestamp - before <= after - before);
+  }
+}
+
+}
@@ -0,0 +1,178 @@
+// Copyright 2020-2024 XMOS LIMITED.
+// This Software is subject to the terms of the XMOS Public Licence: Version 1.
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <assert.h>
+#include <stdarg.h>
+
+#include <xcore/thread.h>
+#include <xcore/channel.h>
+#include <xcore/channel_transaction.h>
+
+#include "unity_fixture.h"
+
+#include "mic_array/cpp/OutputHandler.hpp"
+
+extern "C" {
+
+  channel_t c_sample_frames;
+
+  TEST_GROUP_RUNNER(ChannelSampleOutputHandler) {
+    RUN_TEST_CASE(ChannelSampleOutputHandler, NoArgConstructor);
+    RUN_TEST_CASE(ChannelSampleOutputHandler, SetChannel);
+
+    RUN_TEST_CASE(ChannelSampleOutputHandler, OutputSample_1x1  );
+    RUN_TEST_CASE(ChannelSampleOutputHandler, OutputSample_1x16 );
+    RUN_TEST_CASE(ChannelSampleOutputHandler, OutputSample_2x16 );
+    RUN_TEST_CASE(ChannelSampleOutputHandler, OutputSample_4x256);
+
+    RUN_TEST_CASE(ChannelSampleOutputHandler, OutputFrame_1x16 );
+    RUN_TEST_CASE(ChannelSampleOutputHandler, OutputFrame_4x256);
+  }
+
+  TEST_GROUP(ChannelSampleOutputHandler);
+
+  TEST_SETUP(ChannelSampleOutputHandler) {
+    c_sample_frames = chan_alloc();
+  }
+
+  TEST_TEAR_DOWN(ChannelSampleOutputHandler) {
+    chan_free(c_sample_frames);
+  }
+
+
+  static unsigned stack[8000];
+  static void* stack_start = stack_base(stack, 8000);
+
+}
+
+static constexpr unsigned FRAME_LOOPS = 3;
+
+// Sends FRAME_LOOPS frames one sample at a time.
+template <unsigned CHANS, unsigned SAMPLE_COUNT>
+static void send_samples(void* vframes)
+{
+  auto frames = reinterpret_cast<int32_t (*)[SAMPLE_COUNT][CHANS]>(vframes);
+
+  mic_array::ChannelSampleOutputHandler<CHANS,SAMPLE_COUNT> handler(
+      c_sample_frames.end_a);
+
+  for(int f = 0; f < FRAME_LOOPS; f++)
+    for(int s = 0; s < SAMPLE_COUNT; s++)
+      handler.OutputSample(frames[f][s]);
+}
+
+// Sends FRAME_LOOPS whole (mic-major) frames.
+template <unsigned CHANS, unsigned SAMPLE_COUNT>
+static void send_frames(void* vframes)
+{
+  auto frames = reinterpret_cast<int32_t (*)[CHANS][SAMPLE_COUNT]>(vframes);
+
+  mic_array::ChannelSampleOutputHandler<CHANS,SAMPLE_COUNT> handler(
+      c_sample_frames.end_a);
+
+  for(int f = 0; f < FRAME_LOOPS; f++)
+    handler.OutputFrame(frames[f]);
+}
+
+template <unsigned CHANS, unsigned SAMPLE_COUNT>
+static
+void test_OutputSample()
+{
+  srand(5463341*CHANS + SAMPLE_COUNT);
+
+  constexpr unsigned LOOP_COUNT=100;
+
+  for(int r = 0; r < LOOP_COUNT; r++){
+    int32_t exp_frames[FRAME_LOOPS][SAMPLE_COUNT][CHANS];
+
+    for(int f = 0; f < FRAME_LOOPS; f++)
+      for(int s = 0; s < SAMPLE_COUNT; s++)
+        for(int c = 0; c < CHANS; c++)
+          exp_frames[f][s][c] = rand();
+
+    run_async( send_samples<CHANS,SAMPLE_COUNT>, &exp_frames[0][0][0],
+               stack_start);
+
+    // Each frame arrives as one transaction, in sample-major order.
+    for(int f = 0; f < FRAME_LOOPS; f++){
+      int32_t received[SAMPLE_COUNT][CHANS];
+
+      ma_frame_rx(&received[0][0], c_sample_frames.end_b, CHANS, SAMPLE_COUNT);
+
+      TEST_ASSERT_EQUAL_INT32_ARRAY(&exp_frames[f][0][0], &received[0][0],
+                                    CHANS * SAMPLE_COUNT);
+    }
+  }
+}
+
+template <unsigned CHANS, unsigned SAMPLE_COUNT>
+static
+void test_OutputFrame()
+{
+  srand(8876123*CHANS + SAMPLE_COUNT);
+
+  constexpr unsigned LOOP_COUNT=100;
+
+  for(int r = 0; r < LOOP_COUNT; r++){
+    int32_t frames[FRAME_LOOPS][CHANS][SAMPLE_COUNT];
+
+    for(int f = 0; f < FRAME_LOOPS; f++)
+      for(int c = 0; c < CHANS; c++)
+        for(int s = 0; s < SAMPLE_COUNT; s++)
+          frames[f][c][s] = rand();
+
+    run_async( send_frames<CHANS,SAMPLE_COUNT>, &frames[0][0][0],
+               stack_start);
+
+    for(int f = 0; f < FRAME_LOOPS; f++){
+      int32_t received[SAMPLE_COUNT][CHANS];
+
+      ma_frame_rx(&received[0][0], c_sample_frames.end_b, CHANS, SAMPLE_COUNT);
+
+      for(int c = 0; c < CHANS; c++)
+        for(int s = 0; s < SAMPLE_COUNT; s++)
+          TEST_ASSERT_EQUAL_INT32(frames[f][c][s], received[s][c]);
+    }
+  }
+}
+
+extern "C" {
+
+  TEST(ChannelSampleOutputHandler, NoArgConstructor) {
+    if(1){
+      auto handler = mic_array::ChannelSampleOutputHandler<1,1>();
+      TEST_ASSERT_EQUAL_UINT32(0, handler.GetChannel());
+    }
+    if(1){
+      auto handler = mic_array::ChannelSampleOutputHandler<4,256>();
+      TEST_ASSERT_EQUAL_UINT32(0, handler.GetChannel());
+    }
+  }
+
+  TEST(ChannelSampleOutputHandler, SetChannel) {
+
+    srand(12355321);
+
+    auto handler = mic_array::ChannelSampleOutputHandler<4,8>();
+    TEST_ASSERT_EQUAL_UINT32(0, handler.GetChannel());
+
+    for(int k = 0; k < 400; k++){
+      uint32_t c = rand();
+      handler.SetChannel(c);
+      TEST_ASSERT_EQUAL_UINT32(c, handler.GetChannel());
+    }
+  }
+
+  TEST(ChannelSampleOutputHandler, OutputSample_1x1)   { test_OutputSample<1,1>();   }
+  TEST(ChannelSampleOutputHandler, OutputSample_1x16)  { test_OutputSample<1,16>();  }
+  TEST(ChannelSampleOutputHandler, OutputSample_2x16)  { test_OutputSample<2,16>();  }
+  TEST(ChannelSampleOutputHandler, OutputSample_4x256) { test_OutputSample<4,256>(); }
+
+  TEST(ChannelSampleOutputHandler, OutputFrame_1x16)   { test_OutputFrame<1,16>();   }
+  TEST(ChannelSampleOutputHandler, OutputFrame_4x256)  { test_OutputFrame<4,256>();  }
+
+}
@@ -0,0 +1,190 @@
+// Copyright 2020-2024 XMOS LIMITED.
+// This Software is subject to the terms of the XMOS Public Licence: Version 1.
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <assert.h>
+#include <stdarg.h>
+
+#include "unity_fixture.h"
+
+#include "mic_array/cpp/Decimator.hpp"
+#include "mic_array/cpp/DecimatorCic.hpp"
+#include "mic_array/etc/filters_default.h"
+
+extern "C" {
+
+TEST_GROUP_RUNNER(CicDecimator) {
+  RUN_TEST_CASE(CicDecimator, model_mics1);
+  RUN_TEST_CASE(CicDecimator, model_mics5);
+  RUN_TEST_CASE(CicDecimator, model_mics16);
+  RUN_TEST_CASE(CicDecimator, dc_gain);
+  RUN_TEST_CASE(CicDecimator, latency);
+}
+
+TEST_GROUP(CicDecimator);
+TEST_SETUP(CicDecimator) {}
+TEST_TEAR_DOWN(CicDecimator) {}
+
+}
+
+
+// The decimator must give the same output as stage 1 applied to a plain
+// 8-word PDM history once every CIC_STAGE1_DEC_WORDS words, followed by the
+// stage 2 FIR computed with the arithmetic of fir_s32_multi().
+template <unsigned MICS>
+static
+void test_CicDecimator_model()
+{
+  using TDecimator = mic_array::CicDecimator<MICS>;
+
+  constexpr unsigned BLOCK_WORDS = CIC_STAGE1_DEC_WORDS * CIC_STAGE2_DEC_FACTOR;
+  constexpr unsigned BLOCKS = 40;
+  constexpr unsigned S1_SAMPLES = BLOCKS * CIC_STAGE2_DEC_FACTOR;
+
+  srand(4481 * MICS);
+
+  TDecimator* dec = new TDecimator();
+  dec->Init();
+
+  static uint32_t history[MICS][8];
+  static int32_t s1_out[MICS][S1_SAMPLES];
+  for(int mic = 0; mic < MICS; mic++)
+    for(int k = 0; k < 8; k++)
+      history[mic][k] = 0x55555555;
+
+  unsigned s1_count = 0;
+
+  for(int b = 0; b < BLOCKS; b++){
+    uint32_t pdm_block[MICS][BLOCK_WORDS];
+    for(int mic = 0; mic < MICS; mic++)
+      for(int k = 0; k < BLOCK_WORDS; k++)
+        pdm_block[mic][k] = (((uint32_t) rand()) << 16) ^ ((uint32_t) rand());
+
+    for(int k = 0; k < BLOCK_WORDS; k++){
+      for(int mic = 0; mic < MICS; mic++){
+        memmove(&history[mic][1], &history[mic][0], 7 * sizeof(uint32_t));
+        history[mic][0] = pdm_block[mic][k];
+        if((k % CIC_STAGE1_DEC_WORDS) == (CIC_STAGE1_DEC_WORDS - 1))
+          s1_out[mic][s1_count] = fir_1x8_bit(history[mic], cic_stage1_coef);
+      }
+      if((k % CIC_STAGE1_DEC_WORDS) == (CIC_STAGE1_DEC_WORDS - 1))
+        s1_count++;
+    }
+
+    int32_t sample[MICS];
+    dec->ProcessBlock(sample, &pdm_block[0][0]);
+
+    for(int mic = 0; mic < MICS; mic++){
+      int64_t acc = 0;
+      for(int t = 0; t < CIC_STAGE2_TAP_COUNT && t < s1_count; t++){
+        const int64_t p = ((int64_t) cic_stage2_coef[t])
+                        * s1_out[mic][s1_count - 1 - t];
+        acc += (p + (1 << 29)) >> 30;
+      }
+      acc = (acc + (1 << (cic_stage2_shr - 1))) >> cic_stage2_shr;
+      const int32_t expected = (acc > INT32_MAX)? INT32_MAX
+                             : (acc < -INT32_MAX)? -INT32_MAX : acc;
+
+      TEST_ASSERT_EQUAL_INT32(expected, sample[mic]);
+    }
+  }
+
+  delete dec;
+}
+
+extern "C" {
+
+TEST(CicDecimator, model_mics1)  { test_CicDecimator_model<1>(); }
+TEST(CicDecimator, model_mics5)  { test_CicDecimator_model<5>(); }
+TEST(CicDecimator, model_mics16) { test_CicDecimator_model<16>(); }
+
+}
+
+
+// With the default filters, a constant PDM signal must settle to the same
+// output as the default TwoStageDecimator's.
+extern "C" {
+
+TEST(CicDecimator, dc_gain)
+{
+  using TCic = mic_array::CicDecimator<1>;
+  using TTwoStage = mic_array::TwoStageDecimator<1, STAGE2_DEC_FACTOR,
+                                                 STAGE2_TAP_COUNT>;
+
+  static_assert(TCic::SamplePeriod == TTwoStage::SamplePeriod, "");
+
+  // 3 of every 4 PDM samples are +1, for a level of 0.5.
+  const uint32_t word = 0x88888888;
+  uint32_t pdm_block[TCic::BLOCK_SIZE];
+  for(int k = 0; k < TCic::BLOCK_SIZE; k++)
+    pdm_block[k] = word;
+
+  TCic dec_cic;
+  TTwoStage dec_two_stage;
+  dec_cic.Init();
+  dec_two_stage.Init(stage1_coef, stage2_coef, stage2_shr);
+
+  int32_t cic, two_stage;
+  for(int b = 0; b < 40; b++){
+    dec_cic.ProcessBlock(&cic, pdm_block);
+    dec_two_stage.ProcessBlock(&two_stage, pdm_block);
+  }
+
+  TEST_ASSERT_INT32_WITHIN(two_stage / 1000, two_stage, cic);
+}
+
+}
+
+
+// An impulse Latency() PDM clock periods before the end of a block must give
+// the largest response in that block's output sample.
+extern "C" {
+
+TEST(CicDecimator, latency)
+{
+  using TDecimator = mic_array::CicDecimator<1>;
+
+  constexpr unsigned BLOCK_WORDS = TDecimator::BLOCK_SIZE;
+  constexpr unsigned BLOCKS = 24;
+  constexpr unsigned PEAK_BLOCK = 16;
+  constexpr unsigned LATENCY = TDecimator::Latency();
+  // Index of the impulse's PDM sample, counting from the first block
+  constexpr unsigned IMPULSE = (PEAK_BLOCK + 1) * TDecimator::SamplePeriod
+                                - 1 - LATENCY;
+
+  TDecimator dec_ref;
+  TDecimator dec_imp;
+
+  dec_ref.Init();
+  dec_imp.Init();
+
+  unsigned peak = 0;
+  int64_t peak_mag = 0;
+
+  for(int b = 0; b < BLOCKS; b++){
+    uint32_t pdm_ref[BLOCK_WORDS];
+    uint32_t pdm_imp[BLOCK_WORDS];
+    for(int k = 0; k < BLOCK_WORDS; k++){
+      pdm_ref[k] = pdm_imp[k] = 0x55555555;
+      if(b * BLOCK_WORDS + k == IMPULSE / 32)
+        pdm_imp[k] ^= 1u << (IMPULSE % 32);
+    }
+
+    int32_t ref, imp;
+    dec_ref.ProcessBlock(&ref, pdm_ref);
+    dec_imp.ProcessBlock(&imp, pdm_imp);
+
+    const int64_t mag = llabs(((int64_t) imp) - ref);
+    if(mag > peak_mag){
+      peak = b;
+      peak_mag = mag;
+    }
+  }
+
+  TEST_ASSERT_EQUAL_UINT(PEAK_BLOCK, peak);
+}
+
+}
@@ -0,0 +1,126 @@
+// Copyright 2022-2024 XMOS LIMITED.
+// This Software is subject to the terms of the XMOS Public Licence: Version 1.
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <assert.h>
+#include <stdarg.h>
+
+#include "unity_fixture.h"
+
+#include "mic_array.h"
+
+using namespace mic_array;
+
+extern "C" {
+
+TEST_GROUP_RUNNER(ClockGovernor) {
+  RUN_TEST_CASE(ClockGovernor, no_window);
+  RUN_TEST_CASE(ClockGovernor, step_up);
+  RUN_TEST_CASE(ClockGovernor, back_off);
+  RUN_TEST_CASE(ClockGovernor, hold_off);
+}
+
+TEST_GROUP(ClockGovernor);
+TEST_SETUP(ClockGovernor) {}
+TEST_TEAR_DOWN(ClockGovernor) {}
+
+}
+
+
+static constexpr uint32_t PERIOD = 10000;
+static constexpr unsigned WINDOW = MIC_ARRAY_SLACK_WINDOW_BLOCKS;
+
+// Slack of a decimation thread busy for `busy` ticks of each block.
+static PdmRxSlack slack_of(uint32_t busy)
+{
+  PdmRxSlack slack;
+  slack.block_period = PERIOD;
+  slack.last_idle = PERIOD - busy;
+  slack.recent_min_idle = PERIOD - busy;
+  slack.min_idle = PERIOD - busy;
+  return slack;
+}
+
+extern "C" {
+
+// Nothing may change until a slack window has completed.
+TEST(ClockGovernor, no_window)
+{
+  ClockGovernor governor;
+
+  PdmRxSlack slack = slack_of(100);
+  slack.recent_min_idle = UINT32_MAX;
+
+  TEST_ASSERT(!governor.Update(slack, 10 * WINDOW));
+  TEST_ASSERT_EQUAL_UINT(1, governor.Divide());
+}
+
+
+// A lightly loaded thread must have the divider raised one step per update,
+// up to MaxDivide.
+TEST(ClockGovernor, step_up)
+{
+  ClockGovernor governor;
+  governor.MaxDivide = 3;
+
+  unsigned blocks = 0;
+  for(unsigned expected = 2; expected <= 3; expected++){
+    blocks += 2 * WINDOW;
+    // 10% load at the undivided clock.
+    TEST_ASSERT(governor.Update(slack_of(1000 * governor.Divide()), blocks));
+    TEST_ASSERT_EQUAL_UINT(expected, governor.Divide());
+  }
+
+  blocks += 2 * WINDOW;
+  TEST_ASSERT(!governor.Update(slack_of(3000), blocks));
+  TEST_ASSERT_EQUAL_UINT(3, governor.Divide());
+}
+
+
+// Once the load rises, the divider must drop straight to the largest one 
+// which keeps within TargetLoad.
+TEST(ClockGovernor, back_off)
+{
+  ClockGovernor governor;
+  governor.MaxDivide = 4;
+  governor.TargetLoad = 75;
+
+  unsigned blocks = 0;
+  while(governor.Divide() < 4){
+    blocks += 2 * WINDOW;
+    governor.Update(slack_of(100 * governor.Divide()), blocks);
+  }
+
+  // 3500 ticks at the undivided clock; 2 * 3500 fits in 7500, 3 * 3500 not.
+  blocks += 2 * WINDOW;
+  TEST_ASSERT(governor.Update(slack_of(PERIOD), blocks));
+  TEST_ASSERT_EQUAL_UINT(1, governor.Divide());
+  blocks += 2 * WINDOW;
+  TEST_ASSERT(governor.Update(slack_of(3500), blocks));
+  TEST_ASSERT_EQUAL_UINT(2, governor.Divide());
+  blocks += 2 * WINDOW;
+  TEST_ASSERT(!governor.Update(slack_of(7000), blocks));
+  TEST_ASSERT_EQUAL_UINT(2, governor.Divide());
+}
+
+
+// After a change, the governor must wait for two windows at the new rate.
+TEST(ClockGovernor, hold_off)
+{
+  ClockGovernor governor;
+
+  unsigned blocks = 2 * WINDOW;
+  TEST_ASSERT(governor.Update(slack_of(100), blocks));
+  TEST_ASSERT_EQUAL_UINT(2, governor.Divide());
+
+  TEST_ASSERT(!governor.Update(slack_of(200), blocks + 2 * WINDOW - 1));
+  TEST_ASSERT_EQUAL_UINT(2, governor.Divide());
+
+  TEST_ASSERT(governor.Update(slack_of(200), blocks + 2 * WINDOW));
+  TEST_ASSERT_EQUAL_UINT(3, governor.Divide());
+}
+
+}
@@ -7,6 +7,7 @@
 #include <string.h>
 #include <assert.h>
 #include <stdarg.h>
+#include <math.h>
 
 #include "unity_fixture.h"
 
@@ -20,6 +21,13 @@ TEST_GROUP_RUNNER(DcoeSampleFilter) {
   RUN_TEST_CASE(DcoeSampleFilter, states4);
   RUN_TEST_CASE(DcoeSampleFilter, states8);
   RUN_TEST_CASE(DcoeSampleFilter, states32);
+  RUN_TEST_CASE(DcoeSampleFilter, block4x2);
+  RUN_TEST_CASE(DcoeSampleFilter, block8x3);
+  RUN_TEST_CASE(DcoeSampleFilter, frame4x16);
+  RUN_TEST_CASE(DcoeSampleFilter, states8_shr10);
+  RUN_TEST_CASE(DcoeSampleFilter, time_constant);
+  RUN_TEST_CASE(DcoeSampleFilter, pole_shr_for_rate);
+  RUN_TEST_CASE(DcoeSampleFilter, filter_channel);
 }
 
 TEST_GROUP(DcoeSampleFilter);
@@ -29,24 +37,25 @@ TEST_TEAR_DOWN(DcoeSampleFilter) {}
 }
 
 // This extension is just a way to make the state accessible
-template<unsigned CHANS>
-class TestDcoeSampleFilter : public mic_array::DcoeSampleFilter<CHANS>
+template<unsigned CHANS, unsigned POLE_SHR = DCOE_DEFAULT_POLE_SHR>
+class TestDcoeSampleFilter : public mic_array::DcoeSampleFilter<CHANS,POLE_SHR>
 {
   public:
-    TestDcoeSampleFilter() : mic_array::DcoeSampleFilter<CHANS>() {}
+    TestDcoeSampleFilter() : mic_array::DcoeSampleFilter<CHANS,POLE_SHR>() {}
     dcoe_chan_state_t GetState(unsigned channel) {
       return this->state[channel];
     }
 };
 
-template <unsigned CHANS, unsigned ITER_COUNT>
+template <unsigned CHANS, unsigned ITER_COUNT, 
+          unsigned POLE_SHR = DCOE_DEFAULT_POLE_SHR>
 static
 void test_DcoeSampleFilter()
 {
 
   srand(7685664);
 
-  TestDcoeSampleFilter<CHANS> filter;
+  TestDcoeSampleFilter<CHANS,POLE_SHR> filter;
   int32_t input[CHANS];
   
   double f_states[CHANS];
@@ -89,4 +98,156 @@ TEST(DcoeSampleFilter, states4)  { test_DcoeSampleFilter<4,1000>(); }
 TEST(DcoeSampleFilter, states8)  { test_DcoeSampleFilter<8,1000>(); }
 TEST(DcoeSampleFilter, states32) { test_DcoeSampleFilter<32,1000>(); }
 
-}
\ No newline at end of file
+}
+
+
+// FilterSamples() must give the same result as Filter() on each sample.
+template <unsigned CHANS, unsigned SAMPLES, unsigned ITER_COUNT>
+static
+void test_DcoeSampleFilter_block()
+{
+  srand(8872341);
+
+  mic_array::DcoeSampleFilter<CHANS> exp_filter;
+  mic_array::DcoeSampleFilter<CHANS> filter;
+
+  exp_filter.Init();
+  filter.Init();
+
+  for(int r = 0; r < ITER_COUNT; r++){
+
+    int32_t samples[SAMPLES][CHANS];
+    int32_t expected[SAMPLES][CHANS];
+
+    for(int s = 0; s < SAMPLES; s++){
+      for(int k = 0; k < CHANS; k++)
+        expected[s][k] = samples[s][k] = rand();
+      exp_filter.Filter(expected[s]);
+    }
+
+    filter.FilterSamples(samples);
+
+    TEST_ASSERT_EQUAL_INT32_ARRAY(&expected[0][0], &samples[0][0], CHANS*SAMPLES);
+  }
+}
+
+extern "C" {
+
+TEST(DcoeSampleFilter, block4x2) { test_DcoeSampleFilter_block<4,2,500>(); }
+TEST(DcoeSampleFilter, block8x3) { test_DcoeSampleFilter_block<8,3,500>(); }
+
+}
+
+
+// FilterFrame() must give the same result as Filter() on each column.
+extern "C" {
+
+TEST(DcoeSampleFilter, frame4x16)
+{
+  constexpr unsigned CHANS = 4;
+  constexpr unsigned SAMPLES = 16;
+
+  srand(5561239);
+
+  mic_array::DcoeSampleFilter<CHANS> exp_filter;
+  mic_array::DcoeSampleFilter<CHANS> filter;
+  exp_filter.Init();
+  filter.Init();
+
+  for(int r = 0; r < 100; r++){
+    int32_t frame[CHANS][SAMPLES];
+    int32_t expected[SAMPLES][CHANS];
+
+    for(int s = 0; s < SAMPLES; s++){
+      for(int k = 0; k < CHANS; k++)
+        expected[s][k] = frame[k][s] = rand();
+      exp_filter.Filter(expected[s]);
+    }
+
+    filter.FilterFrame(frame);
+
+    for(int s = 0; s < SAMPLES; s++)
+      for(int k = 0; k < CHANS; k++)
+        TEST_ASSERT_EQUAL_INT32(expected[s][k], frame[k][s]);
+  }
+}
+
+}
+
+
+// A DC step on the input must decay by a factor e every 2^POLE_SHR samples.
+template <unsigned POLE_SHR>
+static
+void test_DcoeSampleFilter_time_constant()
+{
+  constexpr int32_t STEP = 0x40000000;
+
+  mic_array::DcoeSampleFilter<1,POLE_SHR> filter;
+  filter.Init();
+
+  int32_t sample[1];
+  for(int t = 0; t < (1 << POLE_SHR); t++){
+    sample[0] = STEP;
+    filter.Filter(sample);
+  }
+
+  // (1 - 2^-POLE_SHR)^(2^POLE_SHR - 1), within 1%
+  const double expected = STEP * pow(1.0 - ldexp(1.0, -POLE_SHR), 
+                                     (1 << POLE_SHR) - 1);
+  TEST_ASSERT_INT32_WITHIN(STEP / 100, (int32_t) expected, sample[0]);
+}
+
+extern "C" {
+
+TEST(DcoeSampleFilter, states8_shr10) { test_DcoeSampleFilter<8,1000,10>(); }
+
+TEST(DcoeSampleFilter, time_constant)
+{
+  test_DcoeSampleFilter_time_constant<DCOE_DEFAULT_POLE_SHR>();
+  test_DcoeSampleFilter_time_constant<3>();
+  test_DcoeSampleFilter_time_constant<10>();
+}
+
+TEST(DcoeSampleFilter, pole_shr_for_rate)
+{
+  TEST_ASSERT_EQUAL_UINT(DCOE_DEFAULT_POLE_SHR, 
+                         (mic_array::DcoePoleShr<40, 16000>::value));
+  TEST_ASSERT_EQUAL_UINT(7,  (mic_array::DcoePoleShr<40, 32000>::value));
+  TEST_ASSERT_EQUAL_UINT(8,  (mic_array::DcoePoleShr<40, 48000>::value));
+  TEST_ASSERT_EQUAL_UINT(10, (mic_array::DcoePoleShr<40, 192000>::value));
+  TEST_ASSERT_EQUAL_UINT(1,  (mic_array::DcoePoleShr<4000, 16000>::value));
+}
+
+}
+
+
+extern "C" {
+
+// FilterChannel() on each channel in turn must match Filter().
+TEST(DcoeSampleFilter, filter_channel)
+{
+  constexpr unsigned CHANS = 5;
+
+  srand(99812);
+
+  mic_array::DcoeSampleFilter<CHANS,10> exp_filter;
+  mic_array::DcoeSampleFilter<CHANS,10> filter;
+  exp_filter.Init();
+  filter.Init();
+
+  for(int r = 0; r < 1000; r++){
+    int32_t expected[CHANS];
+    int32_t result[CHANS];
+
+    for(int k = 0; k < CHANS; k++)
+      expected[k] = result[k] = (int32_t) ((uint32_t(rand()) << 17) ^ rand());
+
+    exp_filter.Filter(expected);
+    for(int k = 0; k < CHANS; k++)
+      result[k] = filter.FilterChannel(k, result[k]);
+
+    TEST_ASSERT_EQUAL_INT32_ARRAY(expected, result, CHANS);
+  }
+}
+
+}
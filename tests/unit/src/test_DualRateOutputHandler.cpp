@@ -0,0 +1,117 @@
+// Copyright 2020-2024 XMOS LIMITED.
+// This Software is subject to the terms of the XMOS Public Licence: Version 1.
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <assert.h>
+#include <stdarg.h>
+
+#include "unity_fixture.h"
+
+#include "mic_array/cpp/OutputHandler.hpp"
+
+extern "C" {
+
+TEST_GROUP_RUNNER(DualRateOutputHandler) {
+  RUN_TEST_CASE(DualRateOutputHandler, mics1_dec12);
+  RUN_TEST_CASE(DualRateOutputHandler, mics2_dec4);
+  RUN_TEST_CASE(DualRateOutputHandler, mics4_dec12);
+}
+
+TEST_GROUP(DualRateOutputHandler);
+TEST_SETUP(DualRateOutputHandler) {}
+TEST_TEAR_DOWN(DualRateOutputHandler) {}
+
+}
+
+
+#define MAX_RECORDED  400
+
+template <unsigned MIC_COUNT>
+class MockOutputHandler
+{
+  public:
+
+    unsigned count = 0;
+    int32_t samples[MAX_RECORDED][MIC_COUNT];
+
+    void OutputSample(int32_t sample[MIC_COUNT])
+    {
+      assert(count < MAX_RECORDED);
+      for(int k = 0; k < MIC_COUNT; k++)
+        samples[count][k] = sample[k];
+      count++;
+    }
+};
+
+
+// FullRate must see every sample unchanged, LowRate must see the output of a
+// filter_fir_s32_t (per mic) fed every sample, on every S2_DEC_FACTOR-th
+// sample.
+template <unsigned MICS, unsigned DEC, unsigned TAPS>
+static
+void test_DualRateOutputHandler()
+{
+  using THandler = mic_array::DualRateOutputHandler<MICS, DEC, TAPS,
+                                                    MockOutputHandler<MICS>,
+                                                    MockOutputHandler<MICS>>;
+
+  srand(66653 * MICS + DEC);
+
+  constexpr unsigned SAMPLE_COUNT = 30 * DEC;
+  static_assert(SAMPLE_COUNT <= MAX_RECORDED, "");
+
+  int32_t coef[TAPS];
+  for(int k = 0; k < TAPS; k++)
+    coef[k] = ((int32_t) ((((uint32_t) rand()) << 16) ^ ((uint32_t) rand()))) >> 1;
+  const right_shift_t shr = 5;
+
+  THandler* handler = new THandler();
+  handler->Init(coef, shr);
+
+  filter_fir_s32_t filters[MICS];
+  int32_t filter_state[MICS][TAPS] = {{0}};
+  for(int mic = 0; mic < MICS; mic++)
+    filter_fir_s32_init(&filters[mic], &filter_state[mic][0], TAPS, coef, shr);
+
+  int32_t full_expected[SAMPLE_COUNT][MICS];
+  int32_t low_expected[SAMPLE_COUNT / DEC][MICS];
+
+  for(int s = 0; s < SAMPLE_COUNT; s++){
+    int32_t sample[MICS];
+
+    for(int mic = 0; mic < MICS; mic++){
+      sample[mic] = ((int32_t) ((((uint32_t) rand()) << 16) ^ ((uint32_t) rand()))) >> 1;
+      full_expected[s][mic] = sample[mic];
+
+      if(((s + 1) % DEC) == 0)
+        low_expected[s / DEC][mic] = filter_fir_s32(&filters[mic], sample[mic]);
+      else
+        filter_fir_s32_add_sample(&filters[mic], sample[mic]);
+    }
+
+    handler->OutputSample(sample);
+  }
+
+  TEST_ASSERT_EQUAL_UINT(SAMPLE_COUNT, handler->FullRate.count);
+  TEST_ASSERT_EQUAL_UINT(SAMPLE_COUNT / DEC, handler->LowRate.count);
+
+  TEST_ASSERT_EQUAL_INT32_ARRAY(&full_expected[0][0], 
+                                &handler->FullRate.samples[0][0],
+                                SAMPLE_COUNT * MICS);
+  TEST_ASSERT_EQUAL_INT32_ARRAY(&low_expected[0][0], 
+                                &handler->LowRate.samples[0][0],
+                                (SAMPLE_COUNT / DEC) * MICS);
+
+  delete handler;
+}
+
+extern "C" {
+
+TEST(DualRateOutputHandler, mics1_dec12) { test_DualRateOutputHandler<1,12,96>(); }
+TEST(DualRateOutputHandler, mics2_dec4)  { test_DualRateOutputHandler<2,4,33>(); }
+TEST(DualRateOutputHandler, mics4_dec12) { test_DualRateOutputHandler<4,12,96>(); }
+
+}
@@ -0,0 +1,172 @@
+// Copyright 2020-2024 XMOS LIMITED.
+// This Software is subject to the terms of the XMOS Public Licence: Version 1.
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <assert.h>
+#include <stdarg.h>
+
+#include <xcore/channel_streaming.h>
+
+#include "unity_fixture.h"
+
+#include "mic_array/cpp/OutputHandler.hpp"
+
+static constexpr unsigned MAX_CONSUMERS = 3;
+
+extern "C" {
+
+  streaming_channel_t c_fanout_frames[MAX_CONSUMERS];
+
+  TEST_GROUP_RUNNER(FanOutFrameTransmitter) {
+    RUN_TEST_CASE(FanOutFrameTransmitter, consumers_3x2x16);
+    RUN_TEST_CASE(FanOutFrameTransmitter, consumers_2x4x8_held);
+    RUN_TEST_CASE(FanOutFrameTransmitter, add_consumer);
+    RUN_TEST_CASE(FanOutFrameTransmitter, no_consumers);
+  }
+
+  TEST_GROUP(FanOutFrameTransmitter);
+
+  TEST_SETUP(FanOutFrameTransmitter) {
+    for(int k = 0; k < MAX_CONSUMERS; k++)
+      c_fanout_frames[k] = s_chan_alloc();
+  }
+
+  TEST_TEAR_DOWN(FanOutFrameTransmitter) {
+    for(int k = 0; k < MAX_CONSUMERS; k++)
+      s_chan_free(c_fanout_frames[k]);
+  }
+
+}
+
+static constexpr unsigned FRAMES = 7;
+
+// Sample k of channel c of frame f.
+static int32_t sample_value(unsigned f, unsigned c, unsigned k)
+{
+  return (int32_t) ((f << 24) ^ (c << 16) ^ (k * 0x9E37));
+}
+
+template <class TOutput, unsigned CHANS, unsigned SAMPLE_COUNT>
+static void output_frame(TOutput& output, unsigned f)
+{
+  for(int k = 0; k < SAMPLE_COUNT; k++){
+    int32_t sample[CHANS];
+    for(int c = 0; c < CHANS; c++)
+      sample[c] = sample_value(f, c, k);
+    output.OutputSample(sample);
+  }
+}
+
+template <unsigned CHANS, unsigned SAMPLE_COUNT>
+static void check_frame(const int32_t* frame, unsigned f)
+{
+  TEST_ASSERT_NOT_NULL(frame);
+  for(int c = 0; c < CHANS; c++)
+    for(int k = 0; k < SAMPLE_COUNT; k++)
+      TEST_ASSERT_EQUAL_INT32(sample_value(f, c, k), 
+                              frame[c * SAMPLE_COUNT + k]);
+}
+
+// Every consumer must be handed the same frame buffer, complete and in
+// place, and each consumer's release must be waited for before the buffer is
+// reused. The consumers take turns with the producer on this thread; their
+// release tokens wait in the streaming channels until the producer takes
+// them.
+template <unsigned CONSUMERS, unsigned CHANS, unsigned SAMPLE_COUNT, 
+          unsigned DEPTH>
+static
+void test_FanOutFrameTransmitter()
+{
+  static mic_array::FrameOutputHandler<CHANS, SAMPLE_COUNT, 
+      mic_array::FanOutFrameTransmitterOf<MAX_CONSUMERS, DEPTH>::template Type,
+      DEPTH + 1> output;
+
+  for(int n = 0; n < CONSUMERS; n++)
+    TEST_ASSERT_TRUE(output.FrameTx.AddConsumer(c_fanout_frames[n].end_a));
+  TEST_ASSERT_EQUAL_UINT(CONSUMERS, output.FrameTx.Consumers());
+
+  // Frames each consumer holds, oldest first.
+  int32_t* held[CONSUMERS][DEPTH];
+  unsigned held_count = 0;
+
+  for(int f = 0; f < FRAMES; f++){
+    // Consumers hold up to DEPTH frames, and must release the oldest before
+    // the next frame is sent. It must not have been overwritten by the 
+    // frames completed while it was held.
+    if(held_count == DEPTH){
+      for(int n = 0; n < CONSUMERS; n++){
+        check_frame<CHANS, SAMPLE_COUNT>(held[n][0], f - DEPTH);
+        ma_frame_release(c_fanout_frames[n].end_b);
+        for(int d = 1; d < DEPTH; d++)
+          held[n][d-1] = held[n][d];
+      }
+      held_count--;
+    }
+
+    output_frame<decltype(output), CHANS, SAMPLE_COUNT>(output, f);
+
+    for(int n = 0; n < CONSUMERS; n++){
+      int32_t* frame = ma_frame_rx_ptr(c_fanout_frames[n].end_b);
+      check_frame<CHANS, SAMPLE_COUNT>(frame, f);
+      if(n > 0)
+        TEST_ASSERT_TRUE(frame == held[0][held_count]);
+      held[n][held_count] = frame;
+    }
+    held_count++;
+  }
+
+  while(held_count){
+    for(int n = 0; n < CONSUMERS; n++){
+      check_frame<CHANS, SAMPLE_COUNT>(held[n][0], FRAMES - held_count);
+      ma_frame_release(c_fanout_frames[n].end_b);
+      for(int d = 1; d < DEPTH; d++)
+        held[n][d-1] = held[n][d];
+    }
+    held_count--;
+  }
+
+  output.FrameTx.Drain();
+}
+
+extern "C" {
+
+TEST(FanOutFrameTransmitter, consumers_3x2x16)
+{
+  test_FanOutFrameTransmitter<3, 2, 16, 1>();
+}
+
+TEST(FanOutFrameTransmitter, consumers_2x4x8_held)
+{
+  test_FanOutFrameTransmitter<2, 4, 8, 3>();
+}
+
+// No more than CONSUMERS consumers may be registered.
+TEST(FanOutFrameTransmitter, add_consumer)
+{
+  mic_array::FanOutFrameTransmitter<1, 1, 2> tx;
+
+  TEST_ASSERT_EQUAL_UINT(0, tx.Consumers());
+  TEST_ASSERT_TRUE(tx.AddConsumer(c_fanout_frames[0].end_a));
+  TEST_ASSERT_TRUE(tx.AddConsumer(c_fanout_frames[1].end_a));
+  TEST_ASSERT_FALSE(tx.AddConsumer(c_fanout_frames[2].end_a));
+  TEST_ASSERT_EQUAL_UINT(2, tx.Consumers());
+  TEST_ASSERT_EQUAL_UINT32(c_fanout_frames[1].end_a, tx.GetChannel(1));
+}
+
+// Without consumers, frames must be discarded rather than block.
+TEST(FanOutFrameTransmitter, no_consumers)
+{
+  static mic_array::FrameOutputHandler<2, 4, 
+      mic_array::FanOutFrameTransmitterOf<MAX_CONSUMERS>::Type, 2> output;
+
+  for(int f = 0; f < FRAMES; f++)
+    output_frame<decltype(output), 2, 4>(output, f);
+
+  output.FrameTx.Drain();
+  TEST_ASSERT_EQUAL_UINT(0, output.FrameTx.Consumers());
+}
+
+}
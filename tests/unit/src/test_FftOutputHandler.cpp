@@ -0,0 +1,121 @@
+// Copyright 2020-2024 XMOS LIMITED.
+// This Software is subject to the terms of the XMOS Public Licence: Version 1.
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <assert.h>
+#include <stdarg.h>
+#include <math.h>
+
+#include "unity_fixture.h"
+
+#include "mic_array/cpp/OutputHandler.hpp"
+
+extern "C" {
+
+TEST_GROUP_RUNNER(FftOutputHandler) {
+  RUN_TEST_CASE(FftOutputHandler, spectra_3x64);
+  RUN_TEST_CASE(FftOutputHandler, bin_range_2x32);
+}
+
+TEST_GROUP(FftOutputHandler);
+TEST_SETUP(FftOutputHandler) {}
+TEST_TEAR_DOWN(FftOutputHandler) {}
+
+}
+
+// Allowed error of each bin, from the FFT's rounding.
+#define BIN_TOLERANCE   (1 << 10)
+
+template <unsigned MIC_COUNT, unsigned SAMPLE_COUNT>
+class MockFrameTransmitter
+{
+  public:
+
+    unsigned OutputFrame_called = 0;
+
+    int32_t last_frame[MIC_COUNT][SAMPLE_COUNT];
+    int32_t* last_frame_ptr = nullptr;
+    int32_t* prev_frame_ptr = nullptr;
+
+    void OutputFrame(int32_t frame[MIC_COUNT][SAMPLE_COUNT])
+    {
+      OutputFrame_called++;
+      memcpy(&last_frame[0][0], &frame[0][0], sizeof(last_frame));
+      prev_frame_ptr = last_frame_ptr;
+      last_frame_ptr = &frame[0][0];
+    }
+};
+
+extern "C" {
+
+TEST(FftOutputHandler, spectra_3x64)
+{
+  static constexpr unsigned N = 64;
+  static mic_array::FftOutputHandler<3, N, MockFrameTransmitter> output;
+
+  TEST_ASSERT_EQUAL_UINT(64, output.FrameSize);
+
+  // Channel 0: DC and Nyquist; channel 1: cosine at bin 4; 
+  // channel 2: sine at bin 9
+  for(int frame = 0; frame < 2; frame++){
+    for(int n = 0; n < N; n++){
+      int32_t sample[3];
+      sample[0] = 0x30000000 + ((n & 1)? -0x10000000 : 0x10000000);
+      sample[1] = (int32_t) round(0x40000000 * cos(2 * M_PI * 4 * n / N));
+      sample[2] = (int32_t) round(0x40000000 * sin(2 * M_PI * 9 * n / N));
+      output.OutputSample(sample);
+    }
+    TEST_ASSERT_EQUAL_UINT(frame + 1, output.FrameTx.OutputFrame_called);
+  }
+
+  // Frames alternate between two buffers.
+  TEST_ASSERT_NOT_NULL(output.FrameTx.prev_frame_ptr);
+  TEST_ASSERT(output.FrameTx.prev_frame_ptr != output.FrameTx.last_frame_ptr);
+
+  for(int ch = 0; ch < 3; ch++){
+    for(int k = 0; k < N / 2; k++){
+      int32_t re = 0, im = 0;
+      if(ch == 0 && k == 0){ re = 0x30000000; im = 0x10000000; }
+      if(ch == 1 && k == 4){ re = 0x20000000; }
+      if(ch == 2 && k == 9){ im = -0x20000000; }
+      TEST_ASSERT_INT32_WITHIN(BIN_TOLERANCE, re, 
+                               output.FrameTx.last_frame[ch][2 * k]);
+      TEST_ASSERT_INT32_WITHIN(BIN_TOLERANCE, im, 
+                               output.FrameTx.last_frame[ch][2 * k + 1]);
+    }
+  }
+}
+
+TEST(FftOutputHandler, bin_range_2x32)
+{
+  static constexpr unsigned N = 32;
+  static constexpr unsigned FIRST = 3;
+  static constexpr unsigned BINS = 5;
+  static mic_array::FftOutputHandler<2, N, MockFrameTransmitter, 
+                                     FIRST, BINS> output;
+
+  // Channel c is a cosine at bin 3 + 2c, with amplitude 2^(29 - c)
+  int32_t samples[N][2];
+  for(int n = 0; n < N; n++)
+    for(int c = 0; c < 2; c++)
+      samples[n][c] = (int32_t) round(ldexp(1, 29 - c) 
+                                    * cos(2 * M_PI * (3 + 2 * c) * n / N));
+
+  output.OutputSamples(samples);
+  TEST_ASSERT_EQUAL_UINT(1, output.FrameTx.OutputFrame_called);
+
+  for(int c = 0; c < 2; c++){
+    for(int b = 0; b < BINS; b++){
+      const int32_t re = (FIRST + b == 3 + 2 * c)? (1 << (28 - c)) : 0;
+      TEST_ASSERT_INT32_WITHIN(BIN_TOLERANCE, re, 
+                               output.FrameTx.last_frame[c][2 * b]);
+      TEST_ASSERT_INT32_WITHIN(BIN_TOLERANCE, 0, 
+                               output.FrameTx.last_frame[c][2 * b + 1]);
+    }
+  }
+}
+
+}
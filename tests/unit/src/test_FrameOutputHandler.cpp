@@ -32,6 +32,29 @@ extern "C" {
     RUN_TEST_CASE(FrameOutputHandler, case_4x1024);
     
     RUN_TEST_CASE(FrameOutputHandler, multibuffer);
+
+    RUN_TEST_CASE(FrameOutputHandler, block_1x16x2);
+    RUN_TEST_CASE(FrameOutputHandler, block_2x15x2);
+    RUN_TEST_CASE(FrameOutputHandler, block_4x1x2);
+    RUN_TEST_CASE(FrameOutputHandler, block_4x16x3);
+
+    RUN_TEST_CASE(FrameOutputHandler, sample_major_1x16);
+    RUN_TEST_CASE(FrameOutputHandler, sample_major_4x16);
+    RUN_TEST_CASE(FrameOutputHandler, sample_major_3x5);
+    RUN_TEST_CASE(FrameOutputHandler, sample_major_block_4x16x3);
+    RUN_TEST_CASE(FrameOutputHandler, sample_major_frame_4x16);
+
+    RUN_TEST_CASE(FrameOutputHandler, s16_3x5);
+    RUN_TEST_CASE(FrameOutputHandler, s16_4x16_sample_major);
+    RUN_TEST_CASE(FrameOutputHandler, s24_3x5);
+    RUN_TEST_CASE(FrameOutputHandler, s24_4x16_sample_major);
+    RUN_TEST_CASE(FrameOutputHandler, s16_frame_4x16);
+    RUN_TEST_CASE(FrameOutputHandler, s24_frame_3x5_sample_major);
+    RUN_TEST_CASE(FrameOutputHandler, f32_3x5);
+    RUN_TEST_CASE(FrameOutputHandler, f32_4x16_sample_major);
+    RUN_TEST_CASE(FrameOutputHandler, f32_frame_4x16);
+
+    RUN_TEST_CASE(FrameOutputHandler, stamped_2x5);
   }
 
   TEST_GROUP(FrameOutputHandler);
@@ -61,6 +84,42 @@ class MockFrameTransmitter
 };
 
 
+template <unsigned MIC_COUNT, unsigned SAMPLE_COUNT>
+class MockPackedFrameTransmitter
+{
+  public:
+
+    unsigned OutputFrame_called = 0;
+
+    // Big enough for float frames
+    uint8_t last_frame[4 * MIC_COUNT * SAMPLE_COUNT];
+    const void* last_frame_ptr;
+
+    MockPackedFrameTransmitter() {}
+
+    void OutputFrame(const int16_t frame[])
+    {
+      OutputFrame_called++;
+      memcpy(last_frame, frame, 2 * MIC_COUNT * SAMPLE_COUNT);
+      last_frame_ptr = frame;
+    }
+
+    void OutputFrame(const uint8_t frame[])
+    {
+      OutputFrame_called++;
+      memcpy(last_frame, frame, 3 * MIC_COUNT * SAMPLE_COUNT);
+      last_frame_ptr = frame;
+    }
+
+    void OutputFrame(const float frame[])
+    {
+      OutputFrame_called++;
+      memcpy(last_frame, frame, 4 * MIC_COUNT * SAMPLE_COUNT);
+      last_frame_ptr = frame;
+    }
+};
+
+
 template <unsigned CHANS, unsigned SAMPLE_COUNT>
 static
 void test_FrameOutputHandler()
@@ -177,4 +236,358 @@ extern "C" {
 
   }
 
-}
\ No newline at end of file
+}
+
+
+// OutputSamples() must be indistinguishable from calling OutputSample() on
+// each sample in the block, including when frames are completed mid-block.
+template <unsigned CHANS, unsigned SAMPLE_COUNT, unsigned SAMPLES>
+static
+void test_FrameOutputHandler_block()
+{
+  srand(3421*CHANS + 17*SAMPLE_COUNT + SAMPLES);
+  
+  constexpr unsigned LOOP_COUNT=100;
+
+  using TFrameOutputHandler = mic_array::FrameOutputHandler<CHANS,SAMPLE_COUNT,MockFrameTransmitter>;
+
+  TFrameOutputHandler exp_handler;
+  TFrameOutputHandler handler;
+  
+  for(int r = 0; r < LOOP_COUNT; r++){
+
+    int32_t samples[SAMPLES][CHANS];
+
+    for(int s = 0; s < SAMPLES; s++){
+      for(int c = 0; c < CHANS; c++)
+        samples[s][c] = rand();
+      exp_handler.OutputSample(samples[s]);
+    }
+
+    handler.OutputSamples(samples);
+
+    TEST_ASSERT_EQUAL(exp_handler.FrameTx.OutputFrame_called, 
+                      handler.FrameTx.OutputFrame_called);
+
+    if(handler.FrameTx.OutputFrame_called){
+      TEST_ASSERT_EQUAL_INT32_ARRAY(&exp_handler.FrameTx.last_frame[0][0], 
+                                    &handler.FrameTx.last_frame[0][0], 
+                                    CHANS * SAMPLE_COUNT);
+    }
+  }
+}
+
+extern "C" {
+  
+  TEST(FrameOutputHandler, block_1x16x2) { test_FrameOutputHandler_block<1,16,2>(); }
+  TEST(FrameOutputHandler, block_2x15x2) { test_FrameOutputHandler_block<2,15,2>(); }
+  TEST(FrameOutputHandler, block_4x1x2)  { test_FrameOutputHandler_block<4,1,2>();  }
+  TEST(FrameOutputHandler, block_4x16x3) { test_FrameOutputHandler_block<4,16,3>(); }
+
+}
+
+
+// With SAMPLE_MAJOR, each transmitted frame's memory must hold the samples in
+// [SAMPLE][MIC] order, whether they arrived through OutputSample(),
+// OutputSamples() or (already in [MIC][SAMPLE] order) OutputFrame().
+template <unsigned CHANS, unsigned SAMPLE_COUNT, unsigned SAMPLES>
+static
+void test_FrameOutputHandler_sample_major()
+{
+  srand(8761*CHANS + 23*SAMPLE_COUNT + SAMPLES);
+  
+  constexpr unsigned LOOP_COUNT=100;
+
+  using TFrameOutputHandler = mic_array::FrameOutputHandler<CHANS,SAMPLE_COUNT,
+                                            MockFrameTransmitter,1,true>;
+
+  TFrameOutputHandler handler;
+
+  int32_t next_frame[SAMPLE_COUNT][CHANS];
+  int32_t exp_frame[SAMPLE_COUNT][CHANS];
+  unsigned exp_frames = 0;
+  unsigned cur_sample = 0;
+  
+  for(int r = 0; r < LOOP_COUNT; r++){
+
+    int32_t samples[SAMPLES][CHANS];
+
+    for(int s = 0; s < SAMPLES; s++){
+      for(int c = 0; c < CHANS; c++){
+        samples[s][c] = rand();
+        next_frame[cur_sample][c] = samples[s][c];
+      }
+      if(++cur_sample == SAMPLE_COUNT){
+        cur_sample = 0;
+        exp_frames++;
+        memcpy(exp_frame, next_frame, sizeof(exp_frame));
+      }
+    }
+
+    if(SAMPLES == 1) handler.OutputSample(samples[0]);
+    else             handler.OutputSamples(samples);
+
+    TEST_ASSERT_EQUAL(exp_frames, handler.FrameTx.OutputFrame_called);
+    if(exp_frames)
+      TEST_ASSERT_EQUAL_INT32_ARRAY(&exp_frame[0][0], 
+                                    &handler.FrameTx.last_frame[0][0], 
+                                    CHANS * SAMPLE_COUNT);
+  }
+}
+
+extern "C" {
+  
+  TEST(FrameOutputHandler, sample_major_1x16) { test_FrameOutputHandler_sample_major<1,16,1>(); }
+  TEST(FrameOutputHandler, sample_major_4x16) { test_FrameOutputHandler_sample_major<4,16,1>(); }
+  TEST(FrameOutputHandler, sample_major_3x5)  { test_FrameOutputHandler_sample_major<3,5,1>();  }
+  TEST(FrameOutputHandler, sample_major_block_4x16x3) { test_FrameOutputHandler_sample_major<4,16,3>(); }
+
+  TEST(FrameOutputHandler, sample_major_frame_4x16)
+  {
+    constexpr unsigned CHANS = 4;
+    constexpr unsigned SAMPLE_COUNT = 16;
+
+    srand(7895);
+
+    using TFrameOutputHandler = mic_array::FrameOutputHandler<CHANS,SAMPLE_COUNT,
+                                              MockFrameTransmitter,2,true>;
+
+    TFrameOutputHandler handler;
+
+    for(int r = 0; r < 10; r++){
+      int32_t frame[CHANS][SAMPLE_COUNT];
+      int32_t exp_frame[SAMPLE_COUNT][CHANS];
+
+      for(int c = 0; c < CHANS; c++){
+        for(int s = 0; s < SAMPLE_COUNT; s++){
+          frame[c][s] = rand();
+          exp_frame[s][c] = frame[c][s];
+        }
+      }
+
+      handler.OutputFrame(frame);
+
+      TEST_ASSERT_EQUAL(r+1, handler.FrameTx.OutputFrame_called);
+      TEST_ASSERT_EQUAL_INT32_ARRAY(&exp_frame[0][0], 
+                                    &handler.FrameTx.last_frame[0][0], 
+                                    CHANS * SAMPLE_COUNT);
+      // The transposed frame lives in the handler's own buffers.
+      TEST_ASSERT(handler.FrameTx.last_frame_ptr != &frame[0][0]);
+    }
+  }
+
+}
+
+
+// Expected packed value of a sample, given the frame format.
+static void pack_expected(int16_t frame[], unsigned index, int32_t value)
+{
+  int16_t v;
+  ma_s32_to_s16(&v, &value, 1);
+  frame[index] = v;
+}
+
+static void pack_expected(uint8_t frame[], unsigned index, int32_t value)
+{
+  ma_s32_to_s24(&frame[3*index], &value, 1);
+}
+
+// Full scale of the float frame format under test.
+#define F32_FULL_SCALE    (857718499)
+
+static void pack_expected(float frame[], unsigned index, int32_t value)
+{
+  frame[index] = ((float) value) * (1.0f / F32_FULL_SCALE);
+}
+
+
+// Frames in a packed FRAME_FORMAT must hold each sample converted as 
+// ma_s32_to_s16() / ma_s32_to_s24() / ma_s32_to_f32() would, in the 
+// selected layout, and be handed to the transmitter word-aligned.
+template <class FORMAT, bool SAMPLE_MAJOR, unsigned CHANS, unsigned SAMPLE_COUNT>
+static
+void test_FrameOutputHandler_format()
+{
+  srand(9871*CHANS + 31*SAMPLE_COUNT + FORMAT::BYTES_PER_SAMPLE);
+
+  constexpr unsigned LOOP_COUNT = 50;
+  constexpr unsigned FRAME_BYTES = FORMAT::BYTES_PER_SAMPLE * CHANS * SAMPLE_COUNT;
+
+  using TFrameOutputHandler = mic_array::FrameOutputHandler<CHANS,SAMPLE_COUNT,
+                                MockPackedFrameTransmitter,2,SAMPLE_MAJOR,FORMAT>;
+
+  TFrameOutputHandler handler;
+
+  for(int r = 0; r < LOOP_COUNT; r++){
+    typename FORMAT::sample_t exp_frame[FRAME_BYTES / sizeof(typename FORMAT::sample_t)];
+
+    for(int s = 0; s < SAMPLE_COUNT; s++){
+      int32_t sample[CHANS];
+      for(int c = 0; c < CHANS; c++){
+        // Full scale, so that saturation gets exercised
+        sample[c] = (rand() << 17) ^ rand();
+        if(!(rand() & 7)) sample[c] = INT32_MAX - (rand() & 0xFF);
+        pack_expected(exp_frame, SAMPLE_MAJOR? (s*CHANS + c) : (c*SAMPLE_COUNT + s), 
+                      sample[c]);
+      }
+      handler.OutputSample(sample);
+    }
+
+    TEST_ASSERT_EQUAL(r+1, handler.FrameTx.OutputFrame_called);
+    TEST_ASSERT_EQUAL(0, ((uintptr_t) handler.FrameTx.last_frame_ptr) & 3);
+    TEST_ASSERT_EQUAL_UINT8_ARRAY((uint8_t*) exp_frame, 
+                                  handler.FrameTx.last_frame, FRAME_BYTES);
+  }
+}
+
+
+// OutputFrame() must convert (and if SAMPLE_MAJOR transpose) the frame it is
+// given into the handler's own buffer.
+template <class FORMAT, bool SAMPLE_MAJOR, unsigned CHANS, unsigned SAMPLE_COUNT>
+static
+void test_FrameOutputHandler_format_frame()
+{
+  srand(2281*CHANS + 13*SAMPLE_COUNT + FORMAT::BYTES_PER_SAMPLE);
+
+  constexpr unsigned FRAME_BYTES = FORMAT::BYTES_PER_SAMPLE * CHANS * SAMPLE_COUNT;
+
+  using TFrameOutputHandler = mic_array::FrameOutputHandler<CHANS,SAMPLE_COUNT,
+                                MockPackedFrameTransmitter,1,SAMPLE_MAJOR,FORMAT>;
+
+  TFrameOutputHandler handler;
+
+  for(int r = 0; r < 10; r++){
+    int32_t frame[CHANS][SAMPLE_COUNT];
+    typename FORMAT::sample_t exp_frame[FRAME_BYTES / sizeof(typename FORMAT::sample_t)];
+
+    for(int c = 0; c < CHANS; c++){
+      for(int s = 0; s < SAMPLE_COUNT; s++){
+        frame[c][s] = (rand() << 17) ^ rand();
+        pack_expected(exp_frame, SAMPLE_MAJOR? (s*CHANS + c) : (c*SAMPLE_COUNT + s), 
+                      frame[c][s]);
+      }
+    }
+
+    handler.OutputFrame(frame);
+
+    TEST_ASSERT_EQUAL(r+1, handler.FrameTx.OutputFrame_called);
+    TEST_ASSERT_EQUAL_UINT8_ARRAY((uint8_t*) exp_frame, 
+                                  handler.FrameTx.last_frame, FRAME_BYTES);
+  }
+}
+
+extern "C" {
+
+  using mic_array::FrameFormatS16;
+  using mic_array::FrameFormatS24;
+
+  TEST(FrameOutputHandler, s16_3x5)               { test_FrameOutputHandler_format<FrameFormatS16,false,3,5>();  }
+  TEST(FrameOutputHandler, s16_4x16_sample_major) { test_FrameOutputHandler_format<FrameFormatS16,true,4,16>();  }
+  TEST(FrameOutputHandler, s24_3x5)               { test_FrameOutputHandler_format<FrameFormatS24,false,3,5>();  }
+  TEST(FrameOutputHandler, s24_4x16_sample_major) { test_FrameOutputHandler_format<FrameFormatS24,true,4,16>();  }
+
+  TEST(FrameOutputHandler, s16_frame_4x16)             { test_FrameOutputHandler_format_frame<FrameFormatS16,false,4,16>(); }
+  TEST(FrameOutputHandler, s24_frame_3x5_sample_major) { test_FrameOutputHandler_format_frame<FrameFormatS24,true,3,5>();   }
+
+  using FrameFormatF32 = mic_array::FrameFormatF32<F32_FULL_SCALE>;
+
+  TEST(FrameOutputHandler, f32_3x5)               { test_FrameOutputHandler_format<FrameFormatF32,false,3,5>();  }
+  TEST(FrameOutputHandler, f32_4x16_sample_major) { test_FrameOutputHandler_format<FrameFormatF32,true,4,16>();  }
+  TEST(FrameOutputHandler, f32_frame_4x16)        { test_FrameOutputHandler_format_frame<FrameFormatF32,false,4,16>(); }
+
+}
+
+
+template <unsigned MIC_COUNT, unsigned SAMPLE_COUNT>
+class MockStampedFrameTransmitter
+{
+  public:
+
+    unsigned OutputFrame_called = 0;
+
+    ma_frame_header_t last_header;
+    int32_t last_frame[MIC_COUNT][SAMPLE_COUNT];
+
+    MockStampedFrameTransmitter() {}
+
+    void OutputFrame(const ma_frame_header_t& header,
+                     int32_t frame[MIC_COUNT][SAMPLE_COUNT])
+    {
+      OutputFrame_called++;
+      last_header = header;
+      memcpy(&last_frame[0][0], &frame[0][0], sizeof(last_frame));
+    }
+};
+
+
+extern "C" {
+
+  // Each frame's header must carry the index and block timestamp of its
+  // first sample, with a dropped block showing up as a jump in the index.
+  TEST(FrameOutputHandler, stamped_2x5)
+  {
+    constexpr unsigned CHANS = 2;
+    constexpr unsigned SAMPLE_COUNT = 5;
+    constexpr unsigned SAMPLES_PER_BLOCK = 2;
+    constexpr unsigned BLOCK_COUNT = 11;
+    constexpr unsigned DROPPED_BLOCK = 6;
+
+    using TFrameOutputHandler = mic_array::FrameOutputHandler<CHANS,SAMPLE_COUNT,
+                                              MockStampedFrameTransmitter>;
+
+    TFrameOutputHandler handler;
+
+    // Index and timestamp of each sample output.
+    uint32_t index[BLOCK_COUNT * SAMPLES_PER_BLOCK];
+    uint32_t stamp[BLOCK_COUNT * SAMPLES_PER_BLOCK];
+    unsigned count = 0;
+
+    for(int blk = 0; blk < BLOCK_COUNT; blk++){
+      const uint32_t timestamp = 1000 + 37 * blk;
+
+      if(blk == DROPPED_BLOCK)
+        continue;
+
+      handler.SetBlockStamp(blk * SAMPLES_PER_BLOCK, timestamp);
+
+      int32_t samples[SAMPLES_PER_BLOCK][CHANS] = {{0}};
+      for(int s = 0; s < SAMPLES_PER_BLOCK; s++){
+        index[count] = blk * SAMPLES_PER_BLOCK + s;
+        stamp[count] = timestamp;
+        samples[s][0] = count++;
+      }
+
+      const unsigned frames = handler.FrameTx.OutputFrame_called;
+      handler.OutputSamples(samples);
+
+      // A block completes at most one frame, whose first sample is then
+      // sample (count / SAMPLE_COUNT - 1) * SAMPLE_COUNT.
+      if(handler.FrameTx.OutputFrame_called != frames){
+        const unsigned first = (count / SAMPLE_COUNT - 1) * SAMPLE_COUNT;
+        TEST_ASSERT_EQUAL(first, handler.FrameTx.last_frame[0][0]);
+        TEST_ASSERT_EQUAL_UINT32(index[first],
+                                 handler.FrameTx.last_header.sample_index);
+        TEST_ASSERT_EQUAL_UINT32(stamp[first],
+                                 handler.FrameTx.last_header.timestamp);
+      }
+    }
+
+    TEST_ASSERT_EQUAL(count / SAMPLE_COUNT, handler.FrameTx.OutputFrame_called);
+    TEST_ASSERT_EQUAL(0, count % SAMPLE_COUNT);
+
+    // Whole frames are stamped the same way, and count towards the index.
+    int32_t frame[CHANS][SAMPLE_COUNT] = {{0}};
+    handler.SetBlockStamp(100, 5);
+    handler.OutputFrame(frame);
+    TEST_ASSERT_EQUAL_UINT32(100, handler.FrameTx.last_header.sample_index);
+    TEST_ASSERT_EQUAL_UINT32(5, handler.FrameTx.last_header.timestamp);
+
+    int32_t sample[CHANS] = {0};
+    for(int s = 0; s < SAMPLE_COUNT; s++)
+      handler.OutputSample(sample);
+    TEST_ASSERT_EQUAL_UINT32(100 + SAMPLE_COUNT, 
+                             handler.FrameTx.last_header.sample_index);
+    TEST_ASSERT_EQUAL_UINT32(5, handler.FrameTx.last_header.timestamp);
+  }
+
+}
@@ -0,0 +1,187 @@
+// Copyright 2020-2024 XMOS LIMITED.
+// This Software is subject to the terms of the XMOS Public Licence: Version 1.
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <assert.h>
+#include <stdarg.h>
+
+#include "unity_fixture.h"
+
+#include "mic_array/cpp/OutputHandler.hpp"
+
+extern "C" {
+
+TEST_GROUP_RUNNER(GatedFrameTransmitter) {
+  RUN_TEST_CASE(GatedFrameTransmitter, default_passes_all);
+  RUN_TEST_CASE(GatedFrameTransmitter, preroll_and_hangover);
+  RUN_TEST_CASE(GatedFrameTransmitter, no_preroll);
+  RUN_TEST_CASE(GatedFrameTransmitter, frame_contents);
+  RUN_TEST_CASE(GatedFrameTransmitter, frame_output_handler);
+}
+
+TEST_GROUP(GatedFrameTransmitter);
+TEST_SETUP(GatedFrameTransmitter) {}
+TEST_TEAR_DOWN(GatedFrameTransmitter) {}
+
+}
+
+
+#define MAX_RECORDED  40
+
+template <unsigned MIC_COUNT, unsigned SAMPLE_COUNT>
+class MockGateTransmitter
+{
+  public:
+
+    unsigned count = 0;
+    int32_t frames[MAX_RECORDED][MIC_COUNT][SAMPLE_COUNT];
+
+    void OutputFrame(int32_t frame[MIC_COUNT][SAMPLE_COUNT])
+    {
+      assert(count < MAX_RECORDED);
+      memcpy(&frames[count][0][0], &frame[0][0], sizeof(frames[0]));
+      count++;
+    }
+};
+
+
+template <unsigned PREROLL>
+using TGate = mic_array::GatedFrameTransmitter<2, 8, MockGateTransmitter, PREROLL>;
+
+// Frame `id` has the energy `amp^2`, and its id in the bottom 8 bits of every
+// sample.
+template <unsigned PREROLL>
+static void send_frames(TGate<PREROLL>& gate, const int32_t* amps, unsigned n)
+{
+  for(unsigned id = 0; id < n; id++){
+    int32_t frame[2][8];
+    for(int k = 0; k < 2; k++)
+      for(int s = 0; s < 8; s++)
+        frame[k][s] = (amps[id] << 8) | id;
+    gate.OutputFrame(frame);
+  }
+}
+
+template <unsigned PREROLL>
+static void check_sent(TGate<PREROLL>& gate, const unsigned* ids, unsigned n)
+{
+  TEST_ASSERT_EQUAL_UINT(n, gate.Inner.count);
+  for(unsigned f = 0; f < n; f++)
+    TEST_ASSERT_EQUAL_UINT(ids[f], gate.Inner.frames[f][0][0] & 0xFF);
+}
+
+
+extern "C" {
+
+TEST(GatedFrameTransmitter, default_passes_all)
+{
+  auto* gate = new TGate<2>();
+
+  const int32_t amps[] = {0, 0, 1000, 0, 5};
+  send_frames(*gate, amps, 5);
+
+  const unsigned expected[] = {0, 1, 2, 3, 4};
+  check_sent(*gate, expected, 5);
+  TEST_ASSERT_EQUAL_UINT(0, gate->Suppressed());
+  TEST_ASSERT(gate->IsOpen());
+
+  delete gate;
+}
+
+TEST(GatedFrameTransmitter, preroll_and_hangover)
+{
+  auto* gate = new TGate<2>();
+  gate->SetLevels(100 * 100, 50 * 50, 1);
+
+  const int32_t amps[] = {
+    0, 0, 0, 10, 0,   // held; 0-2 pushed out of the pre-roll
+    200,              // onset: 3 and 4 passed on ahead of it
+    60,               // above the close level
+    10,               // first quiet frame, within the hangover
+    10,               // second quiet frame, closes the gate
+    70,               // below the open level
+    100,              // onset: 8 and 9 passed on ahead of it
+  };
+  send_frames(*gate, amps, 11);
+
+  const unsigned expected[] = {3, 4, 5, 6, 7, 8, 9, 10};
+  check_sent(*gate, expected, 8);
+  TEST_ASSERT_EQUAL_UINT(3, gate->Suppressed());
+  TEST_ASSERT(gate->IsOpen());
+  TEST_ASSERT_EQUAL_UINT64(100 * 100, gate->Energy());
+
+  delete gate;
+}
+
+TEST(GatedFrameTransmitter, no_preroll)
+{
+  auto* gate = new TGate<0>();
+  gate->SetLevels(100 * 100, 50 * 50);
+
+  const int32_t amps[] = {0, 200, 10, 60, 200};
+  send_frames(*gate, amps, 5);
+
+  const unsigned expected[] = {1, 4};
+  check_sent(*gate, expected, 2);
+  TEST_ASSERT_EQUAL_UINT(3, gate->Suppressed());
+
+  delete gate;
+}
+
+// Frames from the pre-roll must be passed on unmodified.
+TEST(GatedFrameTransmitter, frame_contents)
+{
+  srand(3321);
+
+  auto* gate = new TGate<3>();
+  gate->SetLevels(1000 * 1000, 1000 * 1000);
+
+  int32_t frames[4][2][8];
+  for(int f = 0; f < 4; f++)
+    for(int k = 0; k < 2; k++)
+      for(int s = 0; s < 8; s++)
+        frames[f][k][s] = (rand() % 2001) - 1000;
+  frames[3][1][5] = INT32_MAX;
+
+  for(int f = 0; f < 4; f++){
+    int32_t frame[2][8];
+    memcpy(frame, frames[f], sizeof(frame));
+    gate->OutputFrame(frame);
+  }
+
+  TEST_ASSERT_EQUAL_UINT(4, gate->Inner.count);
+  TEST_ASSERT_EQUAL_INT32_ARRAY(&frames[0][0][0], &gate->Inner.frames[0][0][0],
+                                4 * 2 * 8);
+
+  delete gate;
+}
+
+// The gate must work as the FrameTx of a FrameOutputHandler.
+TEST(GatedFrameTransmitter, frame_output_handler)
+{
+  using THandler = mic_array::FrameOutputHandler<2, 4,
+      mic_array::GatedFrameTransmitterOf<MockGateTransmitter, 1>::Type>;
+
+  auto* handler = new THandler();
+  handler->FrameTx.SetLevels(1 << 20, 1 << 20);
+
+  for(int f = 0; f < 6; f++){
+    for(int s = 0; s < 4; s++){
+      int32_t sample[2] = { (f == 4)? 0x10000000 : f, f };
+      handler->OutputSample(sample);
+    }
+  }
+
+  // Frame 3 as pre-roll, frame 4 as the onset; frame 5 is held.
+  TEST_ASSERT_EQUAL_UINT(2, handler->FrameTx.Inner.count);
+  TEST_ASSERT_EQUAL_INT32(3, handler->FrameTx.Inner.frames[0][1][0]);
+  TEST_ASSERT_EQUAL_INT32(4, handler->FrameTx.Inner.frames[1][1][0]);
+  TEST_ASSERT_EQUAL_UINT(3, handler->FrameTx.Suppressed());
+
+  delete handler;
+}
+
+}
@@ -0,0 +1,197 @@
+// Copyright 2020-2024 XMOS LIMITED.
+// This Software is subject to the terms of the XMOS Public Licence: Version 1.
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <assert.h>
+#include <stdarg.h>
+
+#include "unity_fixture.h"
+
+#include "mic_array/cpp/SampleFilter.hpp"
+
+extern "C" {
+
+TEST_GROUP_RUNNER(LevelMeterSampleFilter) {
+  RUN_TEST_CASE(LevelMeterSampleFilter, initial);
+  RUN_TEST_CASE(LevelMeterSampleFilter, mics1_window16);
+  RUN_TEST_CASE(LevelMeterSampleFilter, mics4_window32);
+  RUN_TEST_CASE(LevelMeterSampleFilter, mics8_window5);
+  RUN_TEST_CASE(LevelMeterSampleFilter, clip_level);
+  RUN_TEST_CASE(LevelMeterSampleFilter, passes_samples);
+  RUN_TEST_CASE(LevelMeterSampleFilter, frames);
+}
+
+TEST_GROUP(LevelMeterSampleFilter);
+TEST_SETUP(LevelMeterSampleFilter) {}
+TEST_TEAR_DOWN(LevelMeterSampleFilter) {}
+
+}
+
+
+static int32_t rand_sample()
+{
+  return (int32_t) ((((uint32_t) rand()) << 16) ^ ((uint32_t) rand()));
+}
+
+static uint32_t magnitude(int32_t x)
+{
+  return (x < 0)? (0u - (uint32_t) x) : (uint32_t) x;
+}
+
+// Checks levels against those computed directly from the window's samples.
+template <unsigned MICS, unsigned WINDOW>
+static
+void check_levels(
+    const mic_array::ChannelLevels<MICS>& levels,
+    int32_t window[WINDOW][MICS],
+    uint32_t clip_level,
+    unsigned windows)
+{
+  TEST_ASSERT_EQUAL_UINT(windows, levels.windows);
+
+  for(int k = 0; k < MICS; k++){
+    uint32_t peak = 0;
+    uint64_t energy = 0;
+    unsigned clips = 0;
+
+    for(int s = 0; s < WINDOW; s++){
+      const uint32_t mag = magnitude(window[s][k]);
+      if(mag > peak) peak = mag;
+      if(mag >= clip_level) clips++;
+      const int64_t v = window[s][k] >> 8;
+      energy += v * v;
+    }
+
+    TEST_ASSERT_EQUAL_UINT32(peak, levels.peak[k]);
+    TEST_ASSERT_EQUAL_UINT64(energy / WINDOW, levels.mean_square[k]);
+    TEST_ASSERT_EQUAL_UINT(clips, levels.clips[k]);
+  }
+}
+
+template <unsigned MICS, unsigned WINDOW>
+static
+void test_LevelMeterSampleFilter(uint32_t clip_level)
+{
+  srand(123411 * MICS + WINDOW);
+
+  constexpr unsigned WINDOWS = 5;
+
+  mic_array::LevelMeterSampleFilter<MICS, WINDOW> filter;
+  filter.Init();
+  if(clip_level != INT32_MAX)
+    filter.SetClipLevel(clip_level);
+
+  for(int w = 0; w < WINDOWS; w++){
+    int32_t window[WINDOW][MICS];
+
+    for(int s = 0; s < WINDOW; s++){
+      for(int k = 0; k < MICS; k++){
+        // Saturated samples now and then.
+        const int r = rand() % 16;
+        window[s][k] = (r == 0)? INT32_MAX : (r == 1)? -INT32_MAX
+                     : (r == 2)? INT32_MIN : rand_sample();
+      }
+
+      int32_t sample[MICS];
+      memcpy(sample, window[s], sizeof(sample));
+      filter.Filter(sample);
+
+      // Nothing is published part way through a window.
+      if(s != WINDOW - 1)
+        TEST_ASSERT_EQUAL_UINT(w, filter.GetLevels().windows);
+    }
+
+    check_levels<MICS, WINDOW>(filter.GetLevels(), window, clip_level, w + 1);
+  }
+}
+
+extern "C" {
+
+TEST(LevelMeterSampleFilter, initial)
+{
+  mic_array::LevelMeterSampleFilter<4, 16> filter;
+  filter.Init();
+
+  auto levels = filter.GetLevels();
+  TEST_ASSERT_EQUAL_UINT(0, levels.windows);
+  for(int k = 0; k < 4; k++){
+    TEST_ASSERT_EQUAL_UINT32(0, levels.peak[k]);
+    TEST_ASSERT_EQUAL_UINT64(0, levels.mean_square[k]);
+    TEST_ASSERT_EQUAL_UINT(0, levels.clips[k]);
+  }
+}
+
+TEST(LevelMeterSampleFilter, mics1_window16)
+{
+  test_LevelMeterSampleFilter<1, 16>(INT32_MAX);
+}
+
+TEST(LevelMeterSampleFilter, mics4_window32)
+{
+  test_LevelMeterSampleFilter<4, 32>(INT32_MAX);
+}
+
+TEST(LevelMeterSampleFilter, mics8_window5)
+{
+  test_LevelMeterSampleFilter<8, 5>(INT32_MAX);
+}
+
+TEST(LevelMeterSampleFilter, clip_level)
+{
+  test_LevelMeterSampleFilter<4, 16>(0x40000000);
+}
+
+TEST(LevelMeterSampleFilter, passes_samples)
+{
+  srand(774312);
+
+  mic_array::LevelMeterSampleFilter<3, 4> filter;
+  filter.Init();
+
+  for(int r = 0; r < 20; r++){
+    int32_t sample[3];
+    int32_t expected[3];
+    for(int k = 0; k < 3; k++)
+      sample[k] = expected[k] = rand_sample();
+
+    filter.Filter(sample);
+    TEST_ASSERT_EQUAL_INT32_ARRAY(expected, sample, 3);
+
+    for(int k = 0; k < 3; k++)
+      TEST_ASSERT_EQUAL_INT32(expected[k], filter.FilterChannel(k, expected[k]));
+  }
+}
+
+// FilterFrame() and FilterSamples() must meter as Filter() does.
+TEST(LevelMeterSampleFilter, frames)
+{
+  constexpr unsigned MICS = 4;
+  constexpr unsigned WINDOW = 8;
+
+  srand(5512);
+
+  mic_array::LevelMeterSampleFilter<MICS, WINDOW> by_frame;
+  mic_array::LevelMeterSampleFilter<MICS, WINDOW> by_block;
+  by_frame.Init();
+  by_block.Init();
+
+  for(int w = 0; w < 3; w++){
+    int32_t window[WINDOW][MICS];
+    int32_t frame[MICS][WINDOW];
+
+    for(int s = 0; s < WINDOW; s++)
+      for(int k = 0; k < MICS; k++)
+        frame[k][s] = window[s][k] = rand_sample();
+
+    by_frame.FilterFrame(frame);
+    by_block.FilterSamples(window);
+
+    check_levels<MICS, WINDOW>(by_frame.GetLevels(), window, INT32_MAX, w + 1);
+    check_levels<MICS, WINDOW>(by_block.GetLevels(), window, INT32_MAX, w + 1);
+  }
+}
+
+}
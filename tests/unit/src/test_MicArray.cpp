@@ -0,0 +1,239 @@
+// Copyright 2020-2024 XMOS LIMITED.
+// This Software is subject to the terms of the XMOS Public Licence: Version 1.
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <assert.h>
+#include <stdarg.h>
+#include <setjmp.h>
+
+#include "unity_fixture.h"
+
+#include "mic_array.h"
+#include "mic_array/cpp/DecimatorMultiRate.hpp"
+#include "mic_array/etc/filters_default.h"
+
+extern "C" {
+
+TEST_GROUP_RUNNER(MicArray) {
+  RUN_TEST_CASE(MicArray, multi_rate_block_words1_mics1);
+  RUN_TEST_CASE(MicArray, multi_rate_block_words1_mics3);
+  RUN_TEST_CASE(MicArray, frame_mode_mics1_frame4);
+  RUN_TEST_CASE(MicArray, frame_mode_mics3_frame16);
+}
+
+TEST_GROUP(MicArray);
+TEST_SETUP(MicArray) {}
+TEST_TEAR_DOWN(MicArray) {}
+
+}
+
+
+/*
+  MicArray::ThreadEntry() never returns, so these tests run it on the test
+  thread with a PDM rx service which jumps back to the test once it has
+  handed out all of its blocks. None of ThreadEntry()'s locals need
+  destroying.
+*/
+static jmp_buf pdm_rx_done;
+
+template <unsigned BLOCK_SIZE, unsigned BLOCK_COUNT>
+class TestPdmRx
+{
+  public:
+    uint32_t blocks[BLOCK_COUNT][BLOCK_SIZE];
+    unsigned next = 0;
+
+    uint32_t* GetPdmBlock()
+    {
+      if(next == BLOCK_COUNT)
+        longjmp(pdm_rx_done, 1);
+      // Decimators may modify their PDM block.
+      memcpy(block, blocks[next++], sizeof(block));
+      return block;
+    }
+
+  private:
+    uint32_t block[BLOCK_SIZE];
+};
+
+// Delivers mic-major blocks of SUBBLOCKS words per mic, which MicArray reads
+// through PdmRxSubBlocks.
+template <unsigned MIC_COUNT, unsigned SUBBLOCKS, unsigned BLOCK_COUNT>
+class TestFramePdmRx : public TestPdmRx<MIC_COUNT * SUBBLOCKS, BLOCK_COUNT>
+{
+  public:
+    static constexpr unsigned SubBlocks = SUBBLOCKS;
+};
+
+template <unsigned MIC_COUNT, unsigned MAX_SAMPLES>
+class TestOutputHandler
+{
+  public:
+    int32_t samples[MAX_SAMPLES][MIC_COUNT];
+    unsigned count = 0;
+
+    void OutputSample(int32_t sample[MIC_COUNT])
+    {
+      TEST_ASSERT_LESS_THAN_UINT32(MAX_SAMPLES, count);
+      memcpy(samples[count++], sample, sizeof(samples[0]));
+    }
+};
+
+// Takes only whole frames, so MicArray must run in frame mode to use it.
+template <unsigned MIC_COUNT, unsigned FRAME_SIZE, unsigned MAX_FRAMES>
+class TestFrameOutputHandler
+{
+  public:
+    static constexpr unsigned FrameSize = FRAME_SIZE;
+
+    int32_t frames[MAX_FRAMES][MIC_COUNT][FRAME_SIZE];
+    unsigned count = 0;
+
+    void OutputFrame(int32_t frame[MIC_COUNT][FRAME_SIZE])
+    {
+      TEST_ASSERT_LESS_THAN_UINT32(MAX_FRAMES, count);
+      memcpy(frames[count++], frame, sizeof(frames[0]));
+    }
+};
+
+
+// A MultiRateDecimator taking one PDM word per mic per block produces a
+// sample only every `dec_factor` blocks. Through MicArray it must give the
+// samples of a MultiRateDecimator taking `dec_factor` words per block.
+template <unsigned MICS>
+static
+void test_MicArray_multi_rate_block_words1()
+{
+  constexpr unsigned DEC = STAGE2_DEC_FACTOR;
+  constexpr unsigned SAMPLE_COUNT = 12;
+  constexpr unsigned BLOCK_COUNT = SAMPLE_COUNT * DEC;
+
+  using TDecimator = mic_array::MultiRateDecimator<MICS, 1, STAGE2_TAP_COUNT>;
+  using TRef = mic_array::MultiRateDecimator<MICS, DEC, STAGE2_TAP_COUNT>;
+  using TMicArray = mic_array::MicArray<MICS, TDecimator,
+                                        TestPdmRx<MICS, BLOCK_COUNT>,
+                                        mic_array::NopSampleFilter<MICS>,
+                                        TestOutputHandler<MICS, SAMPLE_COUNT>>;
+
+  static_assert(mic_array::DecimatorSamplesPerBlock<TDecimator>::value == 1,
+                "Expected one sample per block at most.");
+
+  static const typename TDecimator::Stage2Config config =
+      { stage2_coef, STAGE2_TAP_COUNT, DEC, stage2_shr, 0 };
+  static const typename TRef::Stage2Config ref_config =
+      { stage2_coef, STAGE2_TAP_COUNT, DEC, stage2_shr, 0 };
+
+  static TMicArray mics;
+  static TRef ref;
+
+  mics.SettlingSamples = 0;
+  mics.PrimeDecimator = false;
+  mics.Decimator.Init(stage1_coef, &config);
+  ref.Init(stage1_coef, &ref_config);
+
+  srand(7331 * MICS);
+
+  for(int b = 0; b < BLOCK_COUNT; b++)
+    for(int mic = 0; mic < MICS; mic++)
+      mics.PdmRx.blocks[b][mic] = (((uint32_t) rand()) << 16) ^ ((uint32_t) rand());
+
+  if(!setjmp(pdm_rx_done))
+    mics.ThreadEntry();
+
+  TEST_ASSERT_EQUAL_UINT(BLOCK_COUNT, mics.PdmRx.next);
+  TEST_ASSERT_EQUAL_UINT(SAMPLE_COUNT, mics.OutputHandler.count);
+
+  for(int s = 0; s < SAMPLE_COUNT; s++){
+    uint32_t ref_block[MICS][DEC];
+    for(int mic = 0; mic < MICS; mic++)
+      for(int k = 0; k < DEC; k++)
+        ref_block[mic][k] = mics.PdmRx.blocks[s * DEC + k][mic];
+
+    int32_t expected[DEC][MICS];
+    TEST_ASSERT_EQUAL_UINT(1, ref.ProcessBlock(expected, &ref_block[0][0]));
+    TEST_ASSERT_EQUAL_INT32_ARRAY(expected[0], mics.OutputHandler.samples[s],
+                                  MICS);
+  }
+}
+
+
+// With PDM blocks holding a whole frame, MicArray decimates each into a
+// frame with ProcessFrame(). The first frame is dropped to settle, and the
+// decimator is primed from the second. The frames must be those of a 
+// TwoStageDecimator fed one block at a time.
+template <unsigned MICS, unsigned FRAME_SIZE>
+static
+void test_MicArray_frame_mode()
+{
+  constexpr unsigned DEC = STAGE2_DEC_FACTOR;
+  constexpr unsigned FRAME_COUNT = 4;
+
+  using TDecimator = mic_array::TwoStageDecimator<MICS, DEC, STAGE2_TAP_COUNT>;
+  using TMicArray = mic_array::MicArray<MICS, TDecimator,
+                        TestFramePdmRx<MICS, FRAME_SIZE * DEC, FRAME_COUNT>,
+                        mic_array::NopSampleFilter<MICS>,
+                        TestFrameOutputHandler<MICS, FRAME_SIZE, FRAME_COUNT>>;
+
+  static_assert(TMicArray::FrameMode, "Expected frame mode.");
+  static_assert(!mic_array::MicArray<MICS, TDecimator, TestPdmRx<MICS * DEC, 1>,
+                    mic_array::NopSampleFilter<MICS>,
+                    TestOutputHandler<MICS, 1>>::FrameMode,
+                "Expected no frame mode with one sample per block.");
+
+  static TMicArray mics;
+  static TDecimator ref;
+
+  mics.SettlingSamples = FRAME_SIZE;
+  mics.PrimeDecimator = true;
+  mics.Decimator.Init(stage1_coef, stage2_coef, stage2_shr);
+  ref.Init(stage1_coef, stage2_coef, stage2_shr);
+
+  srand(4417 * MICS + FRAME_SIZE);
+
+  for(int f = 0; f < FRAME_COUNT; f++)
+    for(int k = 0; k < MICS * FRAME_SIZE * DEC; k++)
+      mics.PdmRx.blocks[f][k] = (((uint32_t) rand()) << 16) ^ ((uint32_t) rand());
+
+  if(!setjmp(pdm_rx_done))
+    mics.ThreadEntry();
+
+  TEST_ASSERT_EQUAL_UINT(FRAME_COUNT, mics.PdmRx.next);
+  TEST_ASSERT_EQUAL_UINT(FRAME_COUNT - 1, mics.OutputHandler.count);
+
+  for(int f = 0; f < FRAME_COUNT; f++){
+    auto pdm_frame = (uint32_t (*)[FRAME_SIZE * DEC]) mics.PdmRx.blocks[f];
+
+    for(int s = 0; s < FRAME_SIZE; s++){
+      uint32_t pdm_block[MICS][DEC];
+      for(int mic = 0; mic < MICS; mic++)
+        for(int k = 0; k < DEC; k++)
+          pdm_block[mic][k] = pdm_frame[mic][s * DEC + k];
+
+      if(f == 1 && s == 0)
+        ref.Prime(&pdm_block[0][0]);
+
+      int32_t expected[MICS];
+      ref.ProcessBlock(expected, &pdm_block[0][0]);
+
+      if(f == 0)
+        continue;
+
+      for(int mic = 0; mic < MICS; mic++)
+        TEST_ASSERT_EQUAL_INT32(expected[mic], 
+                                mics.OutputHandler.frames[f - 1][mic][s]);
+    }
+  }
+}
+
+
+extern "C" {
+
+TEST(MicArray, multi_rate_block_words1_mics1) { test_MicArray_multi_rate_block_words1<1>(); }
+TEST(MicArray, multi_rate_block_words1_mics3) { test_MicArray_multi_rate_block_words1<3>(); }
+TEST(MicArray, frame_mode_mics1_frame4)       { test_MicArray_frame_mode<1, 4>(); }
+TEST(MicArray, frame_mode_mics3_frame16)      { test_MicArray_frame_mode<3, 16>(); }
+
+}
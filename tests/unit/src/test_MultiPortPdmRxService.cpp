@@ -0,0 +1,143 @@
+// Copyright 2020-2024 XMOS LIMITED.
+// This Software is subject to the terms of the XMOS Public Licence: Version 1.
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <assert.h>
+#include <stdarg.h>
+
+#include "unity_fixture.h"
+
+#include "mic_array.h"
+
+extern "C" {
+
+TEST_GROUP_RUNNER(MultiPortPdmRxService) {
+  RUN_TEST_CASE(MultiPortPdmRxService, two_8bit_ports_16_mics);
+  RUN_TEST_CASE(MultiPortPdmRxService, two_4bit_ports_reversed);
+  RUN_TEST_CASE(MultiPortPdmRxService, three_8bit_ports_to_20);
+  RUN_TEST_CASE(MultiPortPdmRxService, block_stamp);
+}
+
+TEST_GROUP(MultiPortPdmRxService);
+TEST_SETUP(MultiPortPdmRxService) {}
+TEST_TEAR_DOWN(MultiPortPdmRxService) {}
+
+}
+
+
+// Words of each port fed into one MultiPortPdmRxService must give the same
+// channels as feeding them into a StandardPdmRxService per port.
+template <unsigned PORT_CH, unsigned PORTS, unsigned CH_OUT, unsigned SUBBLOCKS>
+static
+void test_ports(
+    unsigned seed,
+    bool reverse_map)
+{
+  using TRef = mic_array::StandardPdmRxService<PORT_CH, PORT_CH, SUBBLOCKS>;
+  using TDut = mic_array::MultiPortPdmRxService<PORT_CH, PORTS, CH_OUT, SUBBLOCKS>;
+  constexpr unsigned CH_IN = PORT_CH * PORTS;
+  constexpr unsigned BLOCK_WORDS = PORT_CH * SUBBLOCKS;
+  constexpr unsigned BLOCK_COUNT = 4;
+
+  static TRef ref_rx[PORTS];
+  static TDut dut_rx;
+
+  port_t ports[PORTS] = {0};
+  dut_rx.Init(ports);
+
+  for(int p = 0; p < PORTS; p++){
+    ref_rx[p].Init(0);
+    ref_rx[p].DeinterleaveInThread(true);
+  }
+
+  unsigned map[CH_OUT];
+  for(int ch = 0; ch < CH_OUT; ch++)
+    map[ch] = reverse_map? CH_IN - 1 - ch : ch;
+  if(reverse_map)
+    dut_rx.MapChannels(map);
+
+  srand(seed);
+
+  for(int blk = 0; blk < BLOCK_COUNT; blk++){
+    // In order of arrival.
+    uint32_t words[BLOCK_WORDS][PORTS];
+    for(int k = 0; k < BLOCK_WORDS; k++)
+      for(int p = 0; p < PORTS; p++)
+        words[k][p] = (((uint32_t) rand()) << 16) ^ ((uint32_t) rand());
+
+    // Input channel p*PORT_CH + c is channel c of port p.
+    uint32_t expected_in[CH_IN][SUBBLOCKS];
+    for(int p = 0; p < PORTS; p++){
+      for(int k = 0; k < BLOCK_WORDS; k++)
+        ref_rx[p].ProcessWord(words[k][p]);
+      memcpy(&expected_in[p * PORT_CH][0], ref_rx[p].GetPdmBlock(),
+             PORT_CH * SUBBLOCKS * sizeof(uint32_t));
+    }
+
+    for(int k = 0; k < BLOCK_WORDS; k++)
+      dut_rx.ProcessWords(words[k]);
+
+    uint32_t (*out)[SUBBLOCKS] = 
+        reinterpret_cast<uint32_t (*)[SUBBLOCKS]>(dut_rx.GetPdmBlock());
+
+    for(int ch = 0; ch < CH_OUT; ch++)
+      TEST_ASSERT_EQUAL_UINT32_ARRAY(expected_in[map[ch]], out[ch], SUBBLOCKS);
+  }
+
+  TEST_ASSERT_EQUAL_UINT32(BLOCK_COUNT, dut_rx.GetStats().blocks);
+  TEST_ASSERT_EQUAL_UINT32(0, dut_rx.GetStats().dropped_blocks);
+}
+
+extern "C" {
+
+TEST(MultiPortPdmRxService, two_8bit_ports_16_mics)
+{
+  test_ports<8, 2, 16, 2>(0x61D3, false);
+}
+
+TEST(MultiPortPdmRxService, two_4bit_ports_reversed)
+{
+  test_ports<4, 2, 6, 6>(0x1E88, true);
+}
+
+TEST(MultiPortPdmRxService, three_8bit_ports_to_20)
+{
+  test_ports<8, 3, 20, 3>(0x3F40, true);
+}
+
+// Each block's stamp must count the blocks captured, and give the time its
+// first words were read.
+TEST(MultiPortPdmRxService, block_stamp)
+{
+  constexpr unsigned PORT_CH = 8;
+  constexpr unsigned SUBBLOCKS = 2;
+  constexpr unsigned BLOCK_COUNT = 5;
+
+  static mic_array::MultiPortPdmRxService<PORT_CH, 2, 16, SUBBLOCKS> pdm_rx;
+
+  port_t ports[2] = {0, 0};
+  pdm_rx.Init(ports);
+
+  const uint32_t words[2] = {0x12345678, 0x9ABCDEF0};
+
+  for(int blk = 0; blk < BLOCK_COUNT; blk++){
+    const uint32_t before = get_reference_time();
+    pdm_rx.ProcessWords(words);
+    const uint32_t after = get_reference_time();
+    delay_ticks(1000);
+
+    for(int k = 1; k < PORT_CH * SUBBLOCKS; k++)
+      pdm_rx.ProcessWords(words);
+
+    pdm_rx.GetPdmBlock();
+
+    const mic_array::PdmBlockStamp stamp = pdm_rx.GetBlockStamp();
+    TEST_ASSERT_EQUAL_UINT32(blk, stamp.block_index);
+    TEST_ASSERT(stamp.timestamp - before <= after - before);
+  }
+}
+
+}
@@ -0,0 +1,212 @@
+// Copyright 2020-2024 XMOS LIMITED.
+// This Software is subject to the terms of the XMOS Public Licence: Version 1.
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <assert.h>
+#include <stdarg.h>
+
+#include "unity_fixture.h"
+
+#include "mic_array/cpp/DecimatorMultiRate.hpp"
+#include "mic_array/etc/filters_default.h"
+#include "mic_array/etc/fir_1x16_bit.h"
+
+extern "C" {
+
+TEST_GROUP_RUNNER(MultiRateDecimator) {
+  RUN_TEST_CASE(MultiRateDecimator, mics1);
+  RUN_TEST_CASE(MultiRateDecimator, mics2);
+  RUN_TEST_CASE(MultiRateDecimator, mics5);
+  RUN_TEST_CASE(MultiRateDecimator, mic_count_mics2);
+  RUN_TEST_CASE(MultiRateDecimator, mic_count_mics5);
+}
+
+TEST_GROUP(MultiRateDecimator);
+TEST_SETUP(MultiRateDecimator) {}
+TEST_TEAR_DOWN(MultiRateDecimator) {}
+
+}
+
+
+#define CONFIG_COUNT  3
+#define MAX_TAPS      STAGE2_TAP_COUNT
+
+// The decimator is switched between configurations every few blocks. Its
+// output must match a reference which feeds every stage 1 sample to one
+// filter_fir_s32_t per configuration and mic, and reads the output of the
+// active configuration's filter every `dec_factor` samples, counting from the
+// switch.
+template <unsigned MICS>
+static
+void test_MultiRateDecimator()
+{
+  using TDecimator = mic_array::MultiRateDecimator<MICS, STAGE2_DEC_FACTOR, 
+                                                   MAX_TAPS>;
+  using TConfig = typename TDecimator::Stage2Config;
+
+  srand(45127 * MICS);
+
+  constexpr unsigned BLOCK_COUNT = 40;
+
+  // 16 kHz with the default filter, then decimating by 4 (not a divisor of
+  // the block size) and by 1 with shorter filters.
+  const TConfig configs[CONFIG_COUNT] = {
+    { stage2_coef,      STAGE2_TAP_COUNT, STAGE2_DEC_FACTOR, stage2_shr },
+    { &stage2_coef[16], 33,               4,                 stage2_shr },
+    { &stage2_coef[28], 9,                1,                 stage2_shr },
+  };
+
+  TDecimator dec;
+  dec.Init(stage1_coef, &configs[0]);
+
+  filter_fir_s32_t filters[CONFIG_COUNT][MICS];
+  int32_t filter_state[CONFIG_COUNT][MICS][MAX_TAPS] = {{{0}}};
+  for(int c = 0; c < CONFIG_COUNT; c++)
+    for(int mic = 0; mic < MICS; mic++)
+      filter_fir_s32_init(&filters[c][mic], &filter_state[c][mic][0],
+                          configs[c].tap_count, configs[c].coef, 
+                          configs[c].shr);
+
+  uint32_t pdm_history[MICS][8];
+  for(int mic = 0; mic < MICS; mic++)
+    for(int k = 0; k < 8; k++)
+      pdm_history[mic][k] = 0x55555555;
+
+  unsigned active = 0;
+  unsigned phase = 0;
+
+  for(int b = 0; b < BLOCK_COUNT; b++){
+
+    if(b > 0 && (b % 7) == 0){
+      active = (active + 1) % CONFIG_COUNT;
+      phase = 0;
+      dec.SetStage2(&configs[active]);
+    }
+
+    uint32_t pdm_block[MICS][STAGE2_DEC_FACTOR];
+    for(int mic = 0; mic < MICS; mic++)
+      for(int k = 0; k < STAGE2_DEC_FACTOR; k++)
+        pdm_block[mic][k] = (((uint32_t) rand()) << 16) ^ ((uint32_t) rand());
+
+    int32_t expected[STAGE2_DEC_FACTOR][MICS];
+    unsigned expected_count = 0;
+
+    for(int k = 0; k < STAGE2_DEC_FACTOR; k++){
+      bool output = (++phase == configs[active].dec_factor);
+      if(output) phase = 0;
+
+      for(int mic = 0; mic < MICS; mic++){
+        for(int j = 7; j > 0; j--)
+          pdm_history[mic][j] = pdm_history[mic][j-1];
+        pdm_history[mic][0] = pdm_block[mic][k];
+
+        int32_t s1 = fir_1x16_bit(pdm_history[mic], stage1_coef);
+
+        for(int c = 0; c < CONFIG_COUNT; c++){
+          if(output && c == active)
+            expected[expected_count][mic] = filter_fir_s32(&filters[c][mic], s1);
+          else
+            filter_fir_s32_add_sample(&filters[c][mic], s1);
+        }
+      }
+
+      if(output) expected_count++;
+    }
+
+    int32_t result[STAGE2_DEC_FACTOR][MICS];
+    unsigned count = dec.ProcessBlock(result, &pdm_block[0][0]);
+
+    TEST_ASSERT_EQUAL_UINT(expected_count, count);
+    TEST_ASSERT_EQUAL_PTR(&configs[active], dec.GetStage2());
+    if(count)
+      TEST_ASSERT_EQUAL_INT32_ARRAY(&expected[0][0], &result[0][0], 
+                                    count * MICS);
+  }
+}
+
+extern "C" {
+
+TEST(MultiRateDecimator, mics1) { test_MultiRateDecimator<1>(); }
+TEST(MultiRateDecimator, mics2) { test_MultiRateDecimator<2>(); }
+TEST(MultiRateDecimator, mics5) { test_MultiRateDecimator<5>(); }
+
+}
+
+
+// The decimator is switched between decimating only the first microphone and
+// all of them every few blocks. The first microphone's output must be 
+// unaffected, the others' must be zero while switched off, and once switched
+// back on they must match a decimator started from scratch at the switch.
+template <unsigned MICS>
+static
+void test_MultiRateDecimator_mic_count()
+{
+  using TDecimator = mic_array::MultiRateDecimator<MICS, STAGE2_DEC_FACTOR, 
+                                                   MAX_TAPS>;
+  using TConfig = typename TDecimator::Stage2Config;
+
+  srand(7741 * MICS);
+
+  constexpr unsigned BLOCK_COUNT = 40;
+
+  const TConfig full = 
+      { stage2_coef, STAGE2_TAP_COUNT, STAGE2_DEC_FACTOR, stage2_shr };
+  const TConfig low_power = 
+      { stage2_coef, STAGE2_TAP_COUNT, STAGE2_DEC_FACTOR, stage2_shr, 1 };
+
+  TDecimator dec;
+  TDecimator dec_ref;
+  TDecimator dec_fresh;
+
+  dec.Init(stage1_coef, &full);
+  dec_ref.Init(stage1_coef, &full);
+
+  bool lp = false;
+
+  for(int b = 0; b < BLOCK_COUNT; b++){
+
+    if(b > 0 && (b % 7) == 0){
+      lp = !lp;
+      dec.SetStage2(lp? &low_power : &full);
+      if(!lp){
+        dec_fresh = TDecimator();
+        dec_fresh.Init(stage1_coef, &full);
+      }
+    }
+
+    uint32_t pdm_block[MICS][STAGE2_DEC_FACTOR];
+    for(int mic = 0; mic < MICS; mic++)
+      for(int k = 0; k < STAGE2_DEC_FACTOR; k++)
+        pdm_block[mic][k] = (((uint32_t) rand()) << 16) ^ ((uint32_t) rand());
+
+    int32_t expected[1][MICS];
+    TEST_ASSERT_EQUAL_UINT(1, dec_ref.ProcessBlock(expected, &pdm_block[0][0]));
+
+    int32_t result[STAGE2_DEC_FACTOR][MICS];
+    TEST_ASSERT_EQUAL_UINT(1, dec.ProcessBlock(result, &pdm_block[0][0]));
+
+    TEST_ASSERT_EQUAL_INT32(expected[0][0], result[0][0]);
+
+    if(lp){
+      for(int mic = 1; mic < MICS; mic++)
+        TEST_ASSERT_EQUAL_INT32(0, result[0][mic]);
+    } else if(b >= 7) {
+      int32_t fresh[1][MICS];
+      dec_fresh.ProcessBlock(fresh, &pdm_block[0][0]);
+      for(int mic = 1; mic < MICS; mic++)
+        TEST_ASSERT_EQUAL_INT32(fresh[0][mic], result[0][mic]);
+    } else {
+      TEST_ASSERT_EQUAL_INT32_ARRAY(&expected[0][0], &result[0][0], MICS);
+    }
+  }
+}
+
+extern "C" {
+
+TEST(MultiRateDecimator, mic_count_mics2) { test_MultiRateDecimator_mic_count<2>(); }
+TEST(MultiRateDecimator, mic_count_mics5) { test_MultiRateDecimator_mic_count<5>(); }
+
+}
@@ -0,0 +1,369 @@
+// Copyright 2020-2024 XMOS LIMITED.
+// This Software is subject to the terms of the XMOS Public Licence: Version 1.
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <assert.h>
+#include <stdarg.h>
+
+#include "unity_fixture.h"
+
+#include "mic_array/cpp/Decimator192.hpp"
+#include "mic_array/cpp/SampleFilter.hpp"
+#include "mic_array/etc/fir_1x16_bit.h"
+
+extern "C" {
+
+TEST_GROUP_RUNNER(OneStageDecimator192) {
+  RUN_TEST_CASE(OneStageDecimator192, mics1);
+  RUN_TEST_CASE(OneStageDecimator192, mics2);
+  RUN_TEST_CASE(OneStageDecimator192, mics4);
+  RUN_TEST_CASE(OneStageDecimator192, mics8);
+  RUN_TEST_CASE(OneStageDecimator192, min_phase_mics1);
+  RUN_TEST_CASE(OneStageDecimator192, min_phase_mics4);
+  RUN_TEST_CASE(OneStageDecimator192, fused_dcoe_mics1);
+  RUN_TEST_CASE(OneStageDecimator192, fused_dcoe_mics4);
+  RUN_TEST_CASE(OneStageDecimator192, latency);
+  RUN_TEST_CASE(OneStageDecimator192, full_scale);
+  RUN_TEST_CASE(OneStageDecimator192, subblocks_mics1_6);
+  RUN_TEST_CASE(OneStageDecimator192, subblocks_mics4_8);
+  RUN_TEST_CASE(OneStageDecimator192, subblocks_latency);
+  RUN_TEST_CASE(OneStageDecimator192, swap_mics2);
+  RUN_TEST_CASE(OneStageDecimator192, swap_fade_mics3_4);
+}
+
+TEST_GROUP(OneStageDecimator192);
+TEST_SETUP(OneStageDecimator192) {}
+TEST_TEAR_DOWN(OneStageDecimator192) {}
+
+}
+
+
+// Second phase coefficients as they were stored before both phases shared
+// one table: the live taps moved 16 positions forward, padded with zero taps
+// (all bits set except in the most significant coefficient bit-plane).
+static
+void make_zero_before(uint32_t out[S1_WORDS], const uint32_t coef[S1_WORDS])
+{
+  for(int p = 0; p < 16; p++){
+    const uint32_t* src = &coef[8*p];
+    uint32_t* dst = &out[8*p];
+    for(int k = 0; k < 7; k++)
+      dst[k] = (src[k] << 16) | (src[k+1] >> 16);
+    dst[7] = (src[7] << 16) | ((p == 15)? 0x0000 : 0xFFFF);
+  }
+}
+
+
+template <unsigned MICS>
+static
+void test_OneStageDecimator192(
+    const uint32_t* coef)
+{
+  srand(6457 * MICS);
+
+  constexpr unsigned BLOCKS = 100;
+
+  static uint32_t WORD_ALIGNED coef_b[S1_WORDS];
+  make_zero_before(coef_b, coef);
+
+  mic_array::OneStageDecimator192<MICS> dec;
+  dec.Init(coef);
+
+  uint32_t WORD_ALIGNED hist[MICS][8];
+  for(int m = 0; m < MICS; m++)
+    for(int k = 0; k < 8; k++)
+      hist[m][k] = 0x55555555;
+
+  for(int r = 0; r < BLOCKS; r++){
+
+    uint32_t pdm_block[MICS];
+    int32_t expected[2][MICS];
+    int32_t result[2][MICS];
+
+    for(int m = 0; m < MICS; m++){
+      pdm_block[m] = (((uint32_t) rand()) << 16) ^ ((uint32_t) rand());
+
+      for(int k = 7; k > 0; k--)
+        hist[m][k] = hist[m][k-1];
+      hist[m][0] = pdm_block[m];
+
+      expected[0][m] = fir_1x16_bit(hist[m], coef) << 3;
+      expected[1][m] = fir_1x16_bit(hist[m], coef_b) << 3;
+    }
+
+    dec.ProcessBlock(result, pdm_block);
+
+    TEST_ASSERT_EQUAL_INT32_ARRAY(&expected[0][0], &result[0][0], 2*MICS);
+  }
+}
+
+extern "C" {
+
+TEST(OneStageDecimator192, mics1) { test_OneStageDecimator192<1>(s1_fir_coef); }
+TEST(OneStageDecimator192, mics2) { test_OneStageDecimator192<2>(s1_fir_coef); }
+TEST(OneStageDecimator192, mics4) { test_OneStageDecimator192<4>(s1_fir_coef); }
+TEST(OneStageDecimator192, mics8) { test_OneStageDecimator192<8>(s1_fir_coef); }
+
+// The minimum phase table must keep the 16 zero taps the second phase needs.
+TEST(OneStageDecimator192, min_phase_mics1) 
+  { test_OneStageDecimator192<1>(s1_fir_coef_min_phase); }
+TEST(OneStageDecimator192, min_phase_mics4) 
+  { test_OneStageDecimator192<4>(s1_fir_coef_min_phase); }
+
+}
+
+
+// A decimator with a DcoeSampleFilter inside must give the same output as a
+// plain decimator followed by the same DcoeSampleFilter.
+template <unsigned MICS>
+static
+void test_OneStageDecimator192_fused_dcoe()
+{
+  using TFilter = mic_array::DcoeSampleFilter<MICS, 10>;
+
+  srand(4421 * MICS);
+
+  constexpr unsigned BLOCKS = 100;
+
+  mic_array::OneStageDecimator192<MICS> dec_plain;
+  mic_array::OneStageDecimator192<MICS, TFilter> dec_fused;
+  TFilter filter;
+
+  dec_plain.Init();
+  dec_fused.Init();
+  filter.Init();
+
+  for(int r = 0; r < BLOCKS; r++){
+
+    uint32_t pdm_block[MICS];
+    int32_t expected[2][MICS];
+    int32_t result[2][MICS];
+
+    for(int m = 0; m < MICS; m++)
+      pdm_block[m] = (((uint32_t) rand()) << 16) ^ ((uint32_t) rand());
+
+    dec_plain.ProcessBlock(expected, pdm_block);
+    filter.FilterSamples(expected);
+
+    dec_fused.ProcessBlock(result, pdm_block);
+
+    TEST_ASSERT_EQUAL_INT32_ARRAY(&expected[0][0], &result[0][0], 2*MICS);
+  }
+}
+
+extern "C" {
+
+TEST(OneStageDecimator192, fused_dcoe_mics1) { test_OneStageDecimator192_fused_dcoe<1>(); }
+TEST(OneStageDecimator192, fused_dcoe_mics4) { test_OneStageDecimator192_fused_dcoe<4>(); }
+
+}
+
+
+// An impulse Latency() PDM clock periods before the end of a block must give
+// the largest response in that block's older output sample.
+extern "C" {
+
+TEST(OneStageDecimator192, latency)
+{
+  using TDecimator = mic_array::OneStageDecimator192<1>;
+
+  constexpr unsigned BLOCKS = 24;
+  constexpr unsigned PEAK_BLOCK = 16;
+  constexpr unsigned LATENCY = TDecimator::Latency(S1_GROUP_DELAY);
+  // Index of the impulse's PDM sample, counting from the first block
+  constexpr unsigned IMPULSE = (PEAK_BLOCK + 1) * 32 - 1 - LATENCY;
+
+  TDecimator dec_ref;
+  TDecimator dec_imp;
+
+  dec_ref.Init(s1_fir_coef);
+  dec_imp.Init(s1_fir_coef);
+
+  unsigned peak = 0;
+  int64_t peak_mag = 0;
+
+  for(int b = 0; b < BLOCKS; b++){
+    // Alternating PDM samples filter to (almost) nothing.
+    uint32_t pdm_ref = 0x55555555;
+    uint32_t pdm_imp = (b == IMPULSE / 32)? (pdm_ref ^ (1u << (IMPULSE % 32)))
+                                          : pdm_ref;
+
+    int32_t ref[2][1], imp[2][1];
+    dec_ref.ProcessBlock(ref, &pdm_ref);
+    dec_imp.ProcessBlock(imp, &pdm_imp);
+
+    for(int s = 0; s < 2; s++){
+      const int64_t mag = llabs(((int64_t) imp[s][0]) - ref[s][0]);
+      if(mag > peak_mag){
+        peak = 2 * b + s;
+        peak_mag = mag;
+      }
+    }
+  }
+
+  TEST_ASSERT_EQUAL_UINT(2 * PEAK_BLOCK, peak);
+}
+
+
+// A full scale PDM signal must settle at +/-FullScale.
+TEST(OneStageDecimator192, full_scale)
+{
+  using TDecimator = mic_array::OneStageDecimator192<1>;
+
+  static TDecimator dec;
+  dec.Init(s1_fir_coef);
+
+  for(int v = 0; v < 2; v++){
+    uint32_t pdm = v? 0xFFFFFFFF : 0;
+
+    int32_t out[2][1];
+    for(int b = 0; b < 16; b++)
+      dec.ProcessBlock(out, &pdm);
+
+    const int32_t expected = v? -TDecimator::FullScale : TDecimator::FullScale;
+    TEST_ASSERT_INT32_WITHIN(16, expected, out[0][0]);
+    TEST_ASSERT_INT32_WITHIN(16, expected, out[1][0]);
+  }
+}
+
+}
+
+
+// A decimator taking SUBBLOCKS words per mic per block must give the same
+// output, oldest sample first, as one taking a word at a time.
+template <unsigned MICS, unsigned SUBBLOCKS>
+static
+void test_OneStageDecimator192_subblocks()
+{
+  srand(3319 * MICS + SUBBLOCKS);
+
+  constexpr unsigned BLOCKS = 40;
+
+  mic_array::OneStageDecimator192<MICS> dec_ref;
+  mic_array::OneStageDecimator192<MICS, mic_array::NopSampleFilter<MICS>, 
+                                  16, SUBBLOCKS> dec;
+
+  dec_ref.Init();
+  dec.Init();
+
+  TEST_ASSERT_EQUAL_UINT(2 * SUBBLOCKS, decltype(dec)::SamplesPerBlock);
+
+  for(int r = 0; r < BLOCKS; r++){
+
+    uint32_t pdm_block[MICS][SUBBLOCKS];
+    int32_t expected[2 * SUBBLOCKS][MICS];
+    int32_t result[2 * SUBBLOCKS][MICS];
+
+    for(int m = 0; m < MICS; m++)
+      for(int k = 0; k < SUBBLOCKS; k++)
+        pdm_block[m][k] = (((uint32_t) rand()) << 16) ^ ((uint32_t) rand());
+
+    for(int k = 0; k < SUBBLOCKS; k++){
+      uint32_t word[MICS];
+      for(int m = 0; m < MICS; m++)
+        word[m] = pdm_block[m][k];
+      dec_ref.ProcessBlock(&expected[2*k], word);
+    }
+
+    dec.ProcessBlock(result, &pdm_block[0][0]);
+
+    TEST_ASSERT_EQUAL_INT32_ARRAY(&expected[0][0], &result[0][0], 
+                                  2 * SUBBLOCKS * MICS);
+  }
+}
+
+extern "C" {
+
+TEST(OneStageDecimator192, subblocks_mics1_6) 
+  { test_OneStageDecimator192_subblocks<1, 6>(); }
+TEST(OneStageDecimator192, subblocks_mics4_8) 
+  { test_OneStageDecimator192_subblocks<4, 8>(); }
+
+TEST(OneStageDecimator192, subblocks_latency)
+{
+  using TDecimator = mic_array::OneStageDecimator192<1, 
+                          mic_array::NopSampleFilter<1>, 16, 6>;
+
+  TEST_ASSERT_EQUAL_UINT(S1_GROUP_DELAY + 5 * 32, 
+                         TDecimator::Latency(S1_GROUP_DELAY));
+}
+
+}
+
+
+// SwapCoefficients() must switch coefficients at the next block, crossfading
+// the outputs of the old and new coefficients over FADE samples.
+template <unsigned MICS, unsigned SUBBLOCKS, unsigned FADE>
+static
+void test_OneStageDecimator192_swap()
+{
+  using TDecimator = mic_array::OneStageDecimator192<MICS, 
+                          mic_array::NopSampleFilter<MICS>, 16, SUBBLOCKS>;
+
+  srand(2293 * MICS + FADE);
+
+  constexpr unsigned BLOCKS = 30;
+  constexpr unsigned SWAP_BLOCK = 9;
+  constexpr unsigned SAMPLES = TDecimator::SamplesPerBlock;
+
+  TDecimator dec_old;
+  TDecimator dec_new;
+  TDecimator dec_swap;
+
+  dec_old.Init(s1_fir_coef);
+  dec_new.Init(s1_fir_coef);
+  dec_swap.Init(s1_fir_coef);
+
+  // Mix unscaled outputs.
+  dec_old.Scaler.SetShift(0);
+  dec_new.Scaler.SetShift(0);
+  dec_swap.Scaler.SetShift(0);
+
+  for(int b = 0; b < BLOCKS; b++){
+    uint32_t pdm_block[MICS * SUBBLOCKS];
+    for(int k = 0; k < MICS * SUBBLOCKS; k++)
+      pdm_block[k] = (((uint32_t) rand()) << 16) ^ ((uint32_t) rand());
+
+    if(b == SWAP_BLOCK){
+      TEST_ASSERT_TRUE(dec_swap.SwapCoefficients(s1_fir_coef_min_phase, FADE));
+      TEST_ASSERT_TRUE(dec_swap.SwapPending());
+      TEST_ASSERT_FALSE(dec_swap.SwapCoefficients(s1_fir_coef));
+      dec_new.Init(s1_fir_coef_min_phase);
+    }
+
+    int32_t old_out[SAMPLES][MICS];
+    int32_t new_out[SAMPLES][MICS];
+    int32_t result[SAMPLES][MICS];
+    dec_old.ProcessBlock(old_out, pdm_block);
+    dec_new.ProcessBlock(new_out, pdm_block);
+    dec_swap.ProcessBlock(result, pdm_block);
+
+    TEST_ASSERT_FALSE(dec_swap.SwapPending());
+
+    for(int s = 0; s < SAMPLES; s++){
+      const int step = (b - (int) SWAP_BLOCK) * SAMPLES + s + 1;
+      for(int mic = 0; mic < MICS; mic++){
+        if(step >= 1 && step <= FADE){
+          TEST_ASSERT_EQUAL_INT32(
+              mic_array::crossfade_sample(old_out[s][mic], new_out[s][mic],
+                                          step, FADE),
+              result[s][mic]);
+        } else {
+          TEST_ASSERT_EQUAL_INT32(new_out[s][mic], result[s][mic]);
+        }
+      }
+    }
+  }
+}
+
+extern "C" {
+
+TEST(OneStageDecimator192, swap_mics2) 
+  { test_OneStageDecimator192_swap<2, 1, 0>(); }
+TEST(OneStageDecimator192, swap_fade_mics3_4) 
+  { test_OneStageDecimator192_swap<3, 4, 13>(); }
+
+}
@@ -0,0 +1,191 @@
+// Copyright 2022-2024 XMOS LIMITED.
+// This Software is subject to the terms of the XMOS Public Licence: Version 1.
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <assert.h>
+#include <stdarg.h>
+
+#include "unity_fixture.h"
+
+#include "mic_array.h"
+
+using namespace mic_array;
+
+extern "C" {
+
+TEST_GROUP_RUNNER(OutputScaler) {
+  RUN_TEST_CASE(OutputScaler, saturate);
+  RUN_TEST_CASE(OutputScaler, right_shift);
+  RUN_TEST_CASE(OutputScaler, wrap);
+  RUN_TEST_CASE(OutputScaler, one_stage_192);
+}
+
+TEST_GROUP(OutputScaler);
+TEST_SETUP(OutputScaler) {}
+TEST_TEAR_DOWN(OutputScaler) {}
+
+}
+
+
+static
+void rand_samples(int32_t buff[], unsigned count, unsigned shr)
+{
+  for(int k = 0; k < count; k++)
+    buff[k] = ((int32_t) ((((uint32_t) rand()) << 16) ^ ((uint32_t) rand()))) >> shr;
+}
+
+
+static
+int32_t sat32(int64_t a)
+{
+  return (a > INT32_MAX)? INT32_MAX : (a < -INT32_MAX)? -INT32_MAX : a;
+}
+
+
+extern "C" {
+
+// Samples which do not fit saturate, and are counted.
+TEST(OutputScaler, saturate)
+{
+  srand(0x5CA1E000);
+
+  OutputScaler scaler(3);
+  TEST_ASSERT_EQUAL_INT(3, scaler.Shift());
+  TEST_ASSERT_EQUAL_UINT(0, scaler.ClippedSamples());
+
+  unsigned expected_clips = 0;
+
+  for(int r = 0; r < 100; r++){
+    const unsigned count = 1 + (r % 19);
+    int32_t samples[19];
+    int32_t expected[19];
+
+    // Roughly one sample in three does not fit.
+    rand_samples(samples, count, 1);
+
+    for(int k = 0; k < count; k++){
+      expected[k] = sat32(((int64_t) samples[k]) << 3);
+      expected_clips += (expected[k] == INT32_MAX) || (expected[k] == -INT32_MAX);
+    }
+
+    scaler.Apply(samples, count);
+
+    TEST_ASSERT_EQUAL_INT32_ARRAY(expected, samples, count);
+    TEST_ASSERT_EQUAL_UINT(expected_clips, scaler.ClippedSamples());
+  }
+
+  TEST_ASSERT_GREATER_THAN(0, expected_clips);
+
+  scaler.ResetClippedSamples();
+  TEST_ASSERT_EQUAL_UINT(0, scaler.ClippedSamples());
+
+  // Samples already at the limits are counted even without a shift.
+  scaler.SetShift(0);
+  int32_t samples[4] = { INT32_MAX, 0x12345678, -INT32_MAX, -5 };
+  scaler.Apply(samples, 4);
+  TEST_ASSERT_EQUAL_UINT(2, scaler.ClippedSamples());
+}
+
+
+// A negative shift attenuates, and nothing clips.
+TEST(OutputScaler, right_shift)
+{
+  srand(0x5CA1E001);
+
+  OutputScaler scaler;
+  scaler.SetShift(-4);
+
+  for(int r = 0; r < 50; r++){
+    int32_t samples[16];
+    int32_t expected[16];
+
+    rand_samples(samples, 16, 0);
+    samples[0] = INT32_MAX;
+
+    for(int k = 0; k < 16; k++)
+      expected[k] = samples[k] >> 4;
+
+    scaler.Apply(samples, 16);
+
+    TEST_ASSERT_EQUAL_INT32_ARRAY(expected, samples, 16);
+  }
+
+  TEST_ASSERT_EQUAL_UINT(0, scaler.ClippedSamples());
+}
+
+
+// Without saturation, samples wrap and nothing is counted.
+TEST(OutputScaler, wrap)
+{
+  srand(0x5CA1E002);
+
+  OutputScaler scaler;
+  scaler.SetShift(3, false);
+
+  for(int r = 0; r < 50; r++){
+    int32_t samples[16];
+    int32_t expected[16];
+
+    rand_samples(samples, 16, 1);
+
+    for(int k = 0; k < 16; k++)
+      expected[k] = (int32_t) (((uint32_t) samples[k]) << 3);
+
+    scaler.Apply(samples, 16);
+
+    TEST_ASSERT_EQUAL_INT32_ARRAY(expected, samples, 16);
+  }
+
+  TEST_ASSERT_EQUAL_UINT(0, scaler.ClippedSamples());
+
+  scaler.SetShift(-2, false);
+  int32_t samples[2] = { -7, 100 };
+  scaler.Apply(samples, 2);
+  TEST_ASSERT_EQUAL_INT32(-2, samples[0]);
+  TEST_ASSERT_EQUAL_INT32(25, samples[1]);
+}
+
+
+// OneStageDecimator192 scales by its Scaler, before its sample filter.
+TEST(OutputScaler, one_stage_192)
+{
+  constexpr unsigned MICS = 3;
+
+  // A full scale square wave, alternating runs of ones and zeros.
+  uint32_t pdm[MICS];
+
+  OneStageDecimator192<MICS> dec_ref;
+  OneStageDecimator192<MICS> dec_hot;
+  dec_ref.Init();
+  dec_hot.Init();
+
+  TEST_ASSERT_EQUAL_INT(3, dec_ref.Scaler.Shift());
+  dec_ref.Scaler.SetShift(0);
+  dec_hot.Scaler.SetShift(10);
+
+  for(int r = 0; r < 200; r++){
+    for(int k = 0; k < MICS; k++)
+      pdm[k] = ((r / 8) & 1)? 0xFFFFFFFF : 0x00000000;
+
+    int32_t ref[2][MICS];
+    int32_t hot[2][MICS];
+    uint32_t block[MICS];
+
+    memcpy(block, pdm, sizeof(block));
+    dec_ref.ProcessBlock(ref, block);
+    memcpy(block, pdm, sizeof(block));
+    dec_hot.ProcessBlock(hot, block);
+
+    for(int s = 0; s < 2; s++)
+      for(int k = 0; k < MICS; k++)
+        TEST_ASSERT_EQUAL_INT32(sat32(((int64_t) ref[s][k]) << 10), hot[s][k]);
+  }
+
+  TEST_ASSERT_EQUAL_UINT(0, dec_ref.Scaler.ClippedSamples());
+  TEST_ASSERT_GREATER_THAN(0, dec_hot.Scaler.ClippedSamples());
+}
+
+}
@@ -0,0 +1,144 @@
+// Copyright 2020-2024 XMOS LIMITED.
+// This Software is subject to the terms of the XMOS Public Licence: Version 1.
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <assert.h>
+#include <stdarg.h>
+#include <math.h>
+
+#include "unity_fixture.h"
+
+#include "mic_array/cpp/OutputHandler.hpp"
+
+extern "C" {
+
+TEST_GROUP_RUNNER(OverlapFrameOutputHandler) {
+  RUN_TEST_CASE(OverlapFrameOutputHandler, overlap_2x8x4);
+  RUN_TEST_CASE(OverlapFrameOutputHandler, overlap_3x8x2);
+  RUN_TEST_CASE(OverlapFrameOutputHandler, no_overlap_2x5x5);
+  RUN_TEST_CASE(OverlapFrameOutputHandler, window);
+}
+
+TEST_GROUP(OverlapFrameOutputHandler);
+TEST_SETUP(OverlapFrameOutputHandler) {}
+TEST_TEAR_DOWN(OverlapFrameOutputHandler) {}
+
+}
+
+// Records each frame, and checks the frame passed before it was left alone
+// while the consumer could still be reading it.
+template <unsigned MIC_COUNT, unsigned SAMPLE_COUNT>
+class MockFrameTransmitter
+{
+  public:
+
+    unsigned OutputFrame_called = 0;
+
+    int32_t last_frame[MIC_COUNT][SAMPLE_COUNT];
+    int32_t* last_frame_ptr = nullptr;
+
+    void OutputFrame(int32_t frame[MIC_COUNT][SAMPLE_COUNT])
+    {
+      if(last_frame_ptr != nullptr)
+        TEST_ASSERT_EQUAL_INT32_ARRAY(&last_frame[0][0], last_frame_ptr, 
+                                      MIC_COUNT * SAMPLE_COUNT);
+      OutputFrame_called++;
+      memcpy(&last_frame[0][0], &frame[0][0], sizeof(last_frame));
+      last_frame_ptr = &frame[0][0];
+    }
+};
+
+// Channel c of sample n, or 0 before the first sample.
+static int32_t sample_value(int n, unsigned c)
+{
+  return (n < 0)? 0 : (int32_t) ((n << 8) | (c + 1));
+}
+
+template <unsigned MIC_COUNT, unsigned WINDOW, unsigned HOP>
+static void check_overlap(unsigned sample_count)
+{
+  static mic_array::OverlapFrameOutputHandler<MIC_COUNT, WINDOW, HOP,
+                                              MockFrameTransmitter> output;
+  int32_t* ptrs[WINDOW / HOP + 1];
+
+  for(int n = 0; n < sample_count; n++){
+    int32_t sample[MIC_COUNT];
+    for(int c = 0; c < MIC_COUNT; c++)
+      sample[c] = sample_value(n, c);
+    output.OutputSample(sample);
+
+    TEST_ASSERT_EQUAL_UINT((n + 1) / HOP, output.FrameTx.OutputFrame_called);
+
+    if((n + 1) % HOP)
+      continue;
+
+    // The frame holds the last WINDOW samples.
+    for(int c = 0; c < MIC_COUNT; c++)
+      for(int k = 0; k < WINDOW; k++)
+        TEST_ASSERT_EQUAL_INT32(sample_value(n + 1 - WINDOW + k, c),
+                                output.FrameTx.last_frame[c][k]);
+
+    // And is passed on in place, from a ring of WINDOW / HOP + 1 frames.
+    const unsigned f = (n + 1) / HOP - 1;
+    if(f < WINDOW / HOP + 1)
+      ptrs[f] = output.FrameTx.last_frame_ptr;
+    else
+      TEST_ASSERT_EQUAL_PTR(ptrs[f % (WINDOW / HOP + 1)], 
+                            output.FrameTx.last_frame_ptr);
+  }
+}
+
+extern "C" {
+
+TEST(OverlapFrameOutputHandler, overlap_2x8x4)
+{
+  check_overlap<2, 8, 4>(40);
+}
+
+TEST(OverlapFrameOutputHandler, overlap_3x8x2)
+{
+  check_overlap<3, 8, 2>(41);
+}
+
+TEST(OverlapFrameOutputHandler, no_overlap_2x5x5)
+{
+  check_overlap<2, 5, 5>(30);
+}
+
+TEST(OverlapFrameOutputHandler, window)
+{
+  static constexpr unsigned WINDOW = 16;
+  static mic_array::OverlapFrameOutputHandler<2, WINDOW, WINDOW / 2,
+                                              MockFrameTransmitter> output;
+  static int32_t window[WINDOW];
+
+  // Hann window in Q1.31
+  for(int k = 0; k < WINDOW; k++)
+    window[k] = (int32_t) round(0x7FFFFFFF * 0.5 
+                                  * (1 - cos(2 * M_PI * k / WINDOW)));
+  output.SetWindow(window);
+
+  int32_t x[3 * WINDOW][2];
+  for(int n = 0; n < 3 * WINDOW; n++){
+    x[n][0] = (int32_t) (0x40000000 * sin(0.3 * n));
+    x[n][1] = -(n << 20);
+  }
+
+  output.OutputSamples(x);
+  TEST_ASSERT_EQUAL_UINT(6, output.FrameTx.OutputFrame_called);
+
+  // The last frame is of the last WINDOW samples.
+  for(int c = 0; c < 2; c++){
+    for(int k = 0; k < WINDOW; k++){
+      const double expected = (double) x[2 * WINDOW + k][c] * window[k] 
+                                / 2147483648.0;
+      TEST_ASSERT_INT32_WITHIN(2, (int32_t) round(expected), 
+                               output.FrameTx.last_frame[c][k]);
+    }
+  }
+}
+
+}
@@ -0,0 +1,174 @@
+// Copyright 2020-2024 XMOS LIMITED.
+// This Software is subject to the terms of the XMOS Public Licence: Version 1.
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <assert.h>
+#include <stdarg.h>
+
+#include <type_traits>
+
+#include "unity_fixture.h"
+
+#include "mic_array/cpp/DecimatorParallel.hpp"
+#include "mic_array/etc/filters_default.h"
+
+extern "C" {
+
+TEST_GROUP_RUNNER(ParallelDecimator) {
+  RUN_TEST_CASE(ParallelDecimator, two_stage_mics1_workers1);
+  RUN_TEST_CASE(ParallelDecimator, two_stage_mics4_workers2);
+  RUN_TEST_CASE(ParallelDecimator, two_stage_mics8_workers3);
+  RUN_TEST_CASE(ParallelDecimator, two_stage_mics16_workers4);
+  RUN_TEST_CASE(ParallelDecimator, two_stage_restart_workers);
+  RUN_TEST_CASE(ParallelDecimator, one_stage192_mics2_workers2);
+  RUN_TEST_CASE(ParallelDecimator, one_stage192_mics8_workers3);
+  RUN_TEST_CASE(ParallelDecimator, one_stage192_mics16_workers4);
+  RUN_TEST_CASE(ParallelDecimator, one_stage192_mics16_workers3_lead2);
+}
+
+TEST_GROUP(ParallelDecimator);
+TEST_SETUP(ParallelDecimator) {}
+TEST_TEAR_DOWN(ParallelDecimator) {}
+
+}
+
+
+// Decimators producing one sample per block take a sample vector, others an
+// array of sample vectors.
+template <class TDecimator, unsigned SAMPLES, unsigned MICS>
+static
+void process_block(
+    TDecimator& dec,
+    int32_t sample_out[SAMPLES][MICS],
+    uint32_t* pdm_block,
+    std::true_type)
+{
+  dec.ProcessBlock(&sample_out[0][0], pdm_block);
+}
+
+template <class TDecimator, unsigned SAMPLES, unsigned MICS>
+static
+void process_block(
+    TDecimator& dec,
+    int32_t sample_out[SAMPLES][MICS],
+    uint32_t* pdm_block,
+    std::false_type)
+{
+  dec.ProcessBlock(sample_out, pdm_block);
+}
+
+
+// A parallel decimator must give the same output as the decimator it splits
+// between its workers, run on all of the mics.
+template <class TParallel, class TSerial>
+static
+void test_ParallelDecimator(
+    TParallel& dec_par,
+    TSerial& dec_ser,
+    unsigned seed)
+{
+  constexpr unsigned MICS = TSerial::MicCount;
+  constexpr unsigned BLOCK_SIZE = TSerial::BLOCK_SIZE;
+  constexpr unsigned SAMPLES = mic_array::DecimatorSamplesPerBlock<TSerial>::value;
+
+  static_assert(TParallel::BLOCK_SIZE == BLOCK_SIZE, "BLOCK_SIZE mismatch");
+  static_assert(TParallel::SamplesPerBlock == SAMPLES, "SamplesPerBlock mismatch");
+
+  srand(seed);
+
+  constexpr unsigned BLOCK_COUNT = 20;
+
+  for(int b = 0; b < BLOCK_COUNT; b++){
+
+    uint32_t pdm_block[BLOCK_SIZE];
+    for(int k = 0; k < BLOCK_SIZE; k++)
+      pdm_block[k] = (((uint32_t) rand()) << 16) ^ ((uint32_t) rand());
+
+    // Decimators may modify their PDM block, so each gets its own copy.
+    uint32_t pdm_copy[BLOCK_SIZE];
+    memcpy(pdm_copy, pdm_block, sizeof(pdm_block));
+
+    int32_t expected[SAMPLES][MICS];
+    int32_t actual[SAMPLES][MICS];
+
+    process_block<TSerial, SAMPLES, MICS>(dec_ser, expected, pdm_block,
+        std::integral_constant<bool, SAMPLES == 1>());
+    process_block<TParallel, SAMPLES, MICS>(dec_par, actual, pdm_copy,
+        std::integral_constant<bool, SAMPLES == 1>());
+
+    TEST_ASSERT_EQUAL_INT32_ARRAY(&expected[0][0], &actual[0][0],
+                                  SAMPLES * MICS);
+  }
+
+  // Release the worker threads for the following tests.
+  dec_par.StopWorkers();
+}
+
+template <unsigned MICS, unsigned WORKERS>
+static
+void test_ParallelTwoStageDecimator()
+{
+  static mic_array::TwoStageDecimator<MICS, STAGE2_DEC_FACTOR,
+                                      STAGE2_TAP_COUNT> dec_ser;
+  static mic_array::ParallelTwoStageDecimator<MICS, STAGE2_DEC_FACTOR,
+                                              STAGE2_TAP_COUNT, WORKERS> dec_par;
+
+  dec_ser.Init(stage1_coef, stage2_coef, stage2_shr);
+  dec_par.Init(stage1_coef, stage2_coef, stage2_shr);
+
+  test_ParallelDecimator(dec_par, dec_ser, 3457 * MICS + WORKERS);
+}
+
+// Stopping the workers must not lose any decimator state; the next block
+// restarts them.
+static
+void test_ParallelTwoStageDecimator_restart()
+{
+  constexpr unsigned MICS = 6;
+  constexpr unsigned WORKERS = 4;
+
+  static mic_array::TwoStageDecimator<MICS, STAGE2_DEC_FACTOR,
+                                      STAGE2_TAP_COUNT> dec_ser;
+  static mic_array::ParallelTwoStageDecimator<MICS, STAGE2_DEC_FACTOR,
+                                              STAGE2_TAP_COUNT, WORKERS> dec_par;
+
+  dec_ser.Init(stage1_coef, stage2_coef, stage2_shr);
+  dec_par.Init(stage1_coef, stage2_coef, stage2_shr);
+  dec_par.StartWorkers();
+
+  for(int k = 0; k < 3; k++)
+    test_ParallelDecimator(dec_par, dec_ser, 6121 + k);
+}
+
+template <unsigned MICS, unsigned WORKERS,
+          unsigned LEAD_MICS = MICS / WORKERS>
+static
+void test_ParallelOneStageDecimator192()
+{
+  static mic_array::OneStageDecimator192<MICS> dec_ser;
+  static mic_array::ParallelDecimator<MICS, WORKERS,
+      mic_array::OneStageDecimator192Of::Type,
+      MIC_ARRAY_PARALLEL_WORKER_STACK_WORDS, LEAD_MICS> dec_par;
+
+  dec_ser.Init();
+  dec_par.Init();
+
+  test_ParallelDecimator(dec_par, dec_ser, 8821 * MICS + WORKERS);
+}
+
+extern "C" {
+
+TEST(ParallelDecimator, two_stage_mics1_workers1)     { test_ParallelTwoStageDecimator<1,1>(); }
+TEST(ParallelDecimator, two_stage_mics4_workers2)     { test_ParallelTwoStageDecimator<4,2>(); }
+TEST(ParallelDecimator, two_stage_mics8_workers3)     { test_ParallelTwoStageDecimator<8,3>(); }
+TEST(ParallelDecimator, two_stage_mics16_workers4)    { test_ParallelTwoStageDecimator<16,4>(); }
+TEST(ParallelDecimator, two_stage_restart_workers)    { test_ParallelTwoStageDecimator_restart(); }
+TEST(ParallelDecimator, one_stage192_mics2_workers2)  { test_ParallelOneStageDecimator192<2,2>(); }
+TEST(ParallelDecimator, one_stage192_mics8_workers3)  { test_ParallelOneStageDecimator192<8,3>(); }
+TEST(ParallelDecimator, one_stage192_mics16_workers4) { test_ParallelOneStageDecimator192<16,4>(); }
+TEST(ParallelDecimator, one_stage192_mics16_workers3_lead2) { test_ParallelOneStageDecimator192<16,3,2>(); }
+
+}
@@ -0,0 +1,188 @@
+// Copyright 2020-2024 XMOS LIMITED.
+// This Software is subject to the terms of the XMOS Public Licence: Version 1.
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <assert.h>
+#include <stdarg.h>
+
+#include "unity_fixture.h"
+
+#include "mic_array.h"
+
+extern "C" {
+
+TEST_GROUP_RUNNER(PdmHealthMonitor) {
+  RUN_TEST_CASE(PdmHealthMonitor, faults_4x8);
+  RUN_TEST_CASE(PdmHealthMonitor, recovery_3x2);
+  RUN_TEST_CASE(PdmHealthMonitor, partial_window);
+  RUN_TEST_CASE(PdmHealthMonitor, reset);
+}
+
+TEST_GROUP(PdmHealthMonitor);
+TEST_SETUP(PdmHealthMonitor) {}
+TEST_TEAR_DOWN(PdmHealthMonitor) {}
+
+}
+
+
+static uint32_t rand_word()
+{
+  return (((uint32_t) rand()) << 16) ^ ((uint32_t) rand());
+}
+
+// Each channel is given a fixed pattern, or random data if its pattern is 
+// zero and `live` is set.
+template <unsigned CHANNELS, unsigned SUBBLOCKS>
+static void fill_block(
+    uint32_t block[CHANNELS * SUBBLOCKS],
+    const uint32_t pattern[CHANNELS],
+    const bool live[CHANNELS])
+{
+  for(int ch = 0; ch < CHANNELS; ch++)
+    for(int sb = 0; sb < SUBBLOCKS; sb++)
+      block[ch * SUBBLOCKS + sb] = live[ch]? rand_word() : pattern[ch];
+}
+
+
+extern "C" {
+
+// Channels stuck low, stuck high, toggling and live must each be judged as
+// such once every channel has been examined for a whole window.
+TEST(PdmHealthMonitor, faults_4x8)
+{
+  constexpr unsigned CHANNELS = 4;
+  constexpr unsigned SUBBLOCKS = 8;
+  constexpr unsigned BLOCKS = 
+      CHANNELS * MIC_ARRAY_HEALTH_WINDOW_WORDS / SUBBLOCKS;
+
+  static mic_array::PdmHealthMonitor<CHANNELS, SUBBLOCKS> monitor;
+
+  srand(0x4EA1);
+
+  const uint32_t pattern[CHANNELS] = { 0x00000000, 0xFFFFFFFF, 
+                                       0xAAAAAAAA, 0 };
+  const bool live[CHANNELS] = { false, false, false, true };
+
+  uint32_t block[CHANNELS * SUBBLOCKS];
+
+  for(int blk = 0; blk < BLOCKS; blk++){
+    fill_block<CHANNELS, SUBBLOCKS>(block, pattern, live);
+    monitor.Update(block);
+  }
+
+  mic_array::PdmHealth health = monitor.Get();
+  TEST_ASSERT_EQUAL_UINT(CHANNELS, health.windows);
+  TEST_ASSERT_EQUAL_HEX32(0x1, health.stuck_low);
+  TEST_ASSERT_EQUAL_HEX32(0x2, health.stuck_high);
+  TEST_ASSERT_EQUAL_HEX32(0x4, health.toggling);
+}
+
+// A channel's flag must clear once a window of live data follows its fault,
+// and be raised again by a later fault.
+TEST(PdmHealthMonitor, recovery_3x2)
+{
+  constexpr unsigned CHANNELS = 3;
+  constexpr unsigned SUBBLOCKS = 2;
+  constexpr unsigned BLOCKS = 
+      CHANNELS * MIC_ARRAY_HEALTH_WINDOW_WORDS / SUBBLOCKS;
+
+  static mic_array::PdmHealthMonitor<CHANNELS, SUBBLOCKS> monitor;
+
+  srand(0x3C07);
+
+  const uint32_t pattern[CHANNELS] = { 0, 0x55555555, 0 };
+  bool live[CHANNELS] = { true, false, true };
+
+  uint32_t block[CHANNELS * SUBBLOCKS];
+
+  for(int blk = 0; blk < BLOCKS; blk++){
+    fill_block<CHANNELS, SUBBLOCKS>(block, pattern, live);
+    monitor.Update(block);
+  }
+
+  TEST_ASSERT_EQUAL_HEX32(0x2, monitor.Get().toggling);
+  TEST_ASSERT_EQUAL_HEX32(0x0, monitor.Get().stuck_low);
+
+  live[1] = true;
+  live[2] = false;
+
+  for(int blk = 0; blk < BLOCKS; blk++){
+    fill_block<CHANNELS, SUBBLOCKS>(block, pattern, live);
+    monitor.Update(block);
+  }
+
+  mic_array::PdmHealth health = monitor.Get();
+  TEST_ASSERT_EQUAL_UINT(2 * CHANNELS, health.windows);
+  TEST_ASSERT_EQUAL_HEX32(0x0, health.toggling);
+  TEST_ASSERT_EQUAL_HEX32(0x4, health.stuck_low);
+  TEST_ASSERT_EQUAL_HEX32(0x0, health.stuck_high);
+}
+
+// No channel may be judged before its window is complete.
+TEST(PdmHealthMonitor, partial_window)
+{
+  constexpr unsigned CHANNELS = 2;
+  constexpr unsigned SUBBLOCKS = 4;
+  constexpr unsigned BLOCKS = 
+      CHANNELS * MIC_ARRAY_HEALTH_WINDOW_WORDS / SUBBLOCKS;
+
+  static mic_array::PdmHealthMonitor<CHANNELS, SUBBLOCKS> monitor;
+
+  uint32_t block[CHANNELS * SUBBLOCKS] = {0};
+
+  for(int blk = 0; blk < BLOCKS - CHANNELS; blk++)
+    monitor.Update(block);
+
+  TEST_ASSERT_EQUAL_UINT(0, monitor.Get().windows);
+  TEST_ASSERT_EQUAL_HEX32(0x0, monitor.Get().stuck_low);
+
+  monitor.Update(block);
+
+  TEST_ASSERT_EQUAL_UINT(1, monitor.Get().windows);
+  TEST_ASSERT_EQUAL_HEX32(0x1, monitor.Get().stuck_low);
+
+  monitor.Update(block);
+
+  TEST_ASSERT_EQUAL_UINT(2, monitor.Get().windows);
+  TEST_ASSERT_EQUAL_HEX32(0x3, monitor.Get().stuck_low);
+}
+
+// Reset() must clear the flags and discard the windows in progress.
+TEST(PdmHealthMonitor, reset)
+{
+  constexpr unsigned CHANNELS = 1;
+  constexpr unsigned SUBBLOCKS = 16;
+  constexpr unsigned BLOCKS = MIC_ARRAY_HEALTH_WINDOW_WORDS / SUBBLOCKS;
+
+  static mic_array::PdmHealthMonitor<CHANNELS, SUBBLOCKS> monitor;
+
+  uint32_t block[CHANNELS * SUBBLOCKS];
+  memset(block, 0xFF, sizeof(block));
+
+  for(int blk = 0; blk < BLOCKS + BLOCKS / 2; blk++)
+    monitor.Update(block);
+
+  TEST_ASSERT_EQUAL_UINT(1, monitor.Get().windows);
+  TEST_ASSERT_EQUAL_HEX32(0x1, monitor.Get().stuck_high);
+
+  monitor.Reset();
+
+  TEST_ASSERT_EQUAL_UINT(0, monitor.Get().windows);
+  TEST_ASSERT_EQUAL_HEX32(0x0, monitor.Get().stuck_high);
+
+  // Half a window before the reset must not count towards the next.
+  for(int blk = 0; blk < BLOCKS - 1; blk++)
+    monitor.Update(block);
+
+  TEST_ASSERT_EQUAL_UINT(0, monitor.Get().windows);
+
+  monitor.Update(block);
+
+  TEST_ASSERT_EQUAL_UINT(1, monitor.Get().windows);
+  TEST_ASSERT_EQUAL_HEX32(0x1, monitor.Get().stuck_high);
+}
+
+}
@@ -0,0 +1,79 @@
+// Copyright 2020-2024 XMOS LIMITED.
+// This Software is subject to the terms of the XMOS Public Licence: Version 1.
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <assert.h>
+#include <stdarg.h>
+
+#include "unity_fixture.h"
+
+#include "mic_array/cpp/PdmHistory.hpp"
+
+extern "C" {
+
+TEST_GROUP_RUNNER(PdmHistory) {
+  RUN_TEST_CASE(PdmHistory, chans1_steps1);
+  RUN_TEST_CASE(PdmHistory, chans3_steps4);
+  RUN_TEST_CASE(PdmHistory, chans4_steps6);
+  RUN_TEST_CASE(PdmHistory, chans2_steps9);
+}
+
+TEST_GROUP(PdmHistory);
+TEST_SETUP(PdmHistory) {}
+TEST_TEAR_DOWN(PdmHistory) {}
+
+}
+
+
+// Each window must always match an 8-word buffer maintained the old way,
+// with hist[0] = word followed by a shift.
+template <unsigned CHANS, unsigned STEPS>
+static
+void test_PdmHistory()
+{
+  srand(23411 * CHANS + STEPS);
+
+  constexpr unsigned LOOP_COUNT = 100;
+
+  mic_array::PdmHistory<CHANS,STEPS> history;
+
+  uint32_t expected[CHANS][8];
+  for(int c = 0; c < CHANS; c++)
+    for(int k = 0; k < 8; k++)
+      expected[c][k] = 0x55555555;
+
+  for(int r = 0; r < LOOP_COUNT; r++){
+
+    history.Advance();
+
+    for(int c = 0; c < CHANS; c++){
+      uint32_t word = (((uint32_t) rand()) << 16) ^ ((uint32_t) rand());
+
+      for(int k = 7; k > 0; k--)
+        expected[c][k] = expected[c][k-1];
+      expected[c][0] = word;
+
+      history.Set(c, word);
+    }
+
+    for(int c = 0; c < CHANS; c++){
+      TEST_ASSERT_EQUAL_UINT32_ARRAY(expected[c], history.Window(c), 8);
+
+      if(c > 0)
+        TEST_ASSERT_EQUAL_PTR(&history.Window(c-1)[history.Stride], 
+                              history.Window(c));
+    }
+  }
+}
+
+extern "C" {
+
+TEST(PdmHistory, chans1_steps1) { test_PdmHistory<1,1>(); }
+TEST(PdmHistory, chans3_steps4) { test_PdmHistory<3,4>(); }
+TEST(PdmHistory, chans4_steps6) { test_PdmHistory<4,6>(); }
+TEST(PdmHistory, chans2_steps9) { test_PdmHistory<2,9>(); }
+
+}
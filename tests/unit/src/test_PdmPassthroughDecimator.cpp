@@ -0,0 +1,114 @@
+// Copyright 2020-2024 XMOS LIMITED.
+// This Software is subject to the terms of the XMOS Public Licence: Version 1.
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <assert.h>
+#include <stdarg.h>
+
+#include "unity_fixture.h"
+
+#include "mic_array/cpp/DecimatorPassthrough.hpp"
+
+extern "C" {
+
+TEST_GROUP_RUNNER(PdmPassthroughDecimator) {
+  RUN_TEST_CASE(PdmPassthroughDecimator, mics1_subblocks1);
+  RUN_TEST_CASE(PdmPassthroughDecimator, mics5_subblocks1);
+  RUN_TEST_CASE(PdmPassthroughDecimator, mics3_subblocks4);
+  RUN_TEST_CASE(PdmPassthroughDecimator, mics16_subblocks6);
+  RUN_TEST_CASE(PdmPassthroughDecimator, latency);
+}
+
+TEST_GROUP(PdmPassthroughDecimator);
+TEST_SETUP(PdmPassthroughDecimator) {}
+TEST_TEAR_DOWN(PdmPassthroughDecimator) {}
+
+}
+
+
+// Each output sample must be the PDM word of the same mic and position in
+// the block, unchanged.
+template <unsigned MICS, unsigned SUBBLOCKS>
+static
+void test_passthrough()
+{
+  using TDecimator = mic_array::PdmPassthroughDecimator<MICS, SUBBLOCKS>;
+
+  static_assert(TDecimator::BLOCK_SIZE == MICS * SUBBLOCKS, "");
+  static_assert(TDecimator::SamplesPerBlock == SUBBLOCKS, "");
+
+  srand(0x9A55 + 17 * MICS + SUBBLOCKS);
+
+  TDecimator dec;
+  dec.Init();
+
+  for(int b = 0; b < 10; b++){
+    uint32_t pdm_block[MICS][SUBBLOCKS];
+    for(int mic = 0; mic < MICS; mic++)
+      for(int s = 0; s < SUBBLOCKS; s++)
+        pdm_block[mic][s] = (((uint32_t) rand()) << 16) ^ ((uint32_t) rand());
+
+    int32_t sample_out[SUBBLOCKS][MICS];
+    dec.ProcessBlock(sample_out, &pdm_block[0][0]);
+
+    for(int mic = 0; mic < MICS; mic++)
+      for(int s = 0; s < SUBBLOCKS; s++)
+        TEST_ASSERT_EQUAL_UINT32(pdm_block[mic][s], (uint32_t) sample_out[s][mic]);
+  }
+}
+
+
+// The single sample form, which MicArray uses when SUBBLOCKS is 1.
+template <unsigned MICS>
+static
+void test_passthrough_single()
+{
+  using TDecimator = mic_array::PdmPassthroughDecimator<MICS>;
+
+  srand(0x9A56 + 17 * MICS);
+
+  TDecimator dec;
+  dec.Init();
+
+  for(int b = 0; b < 10; b++){
+    uint32_t pdm_block[MICS];
+    for(int mic = 0; mic < MICS; mic++)
+      pdm_block[mic] = (((uint32_t) rand()) << 16) ^ ((uint32_t) rand());
+
+    int32_t sample[MICS];
+    dec.ProcessBlock(sample, pdm_block);
+
+    for(int mic = 0; mic < MICS; mic++)
+      TEST_ASSERT_EQUAL_UINT32(pdm_block[mic], (uint32_t) sample[mic]);
+  }
+}
+
+extern "C" {
+
+TEST(PdmPassthroughDecimator, mics1_subblocks1)
+{
+  test_passthrough<1, 1>();
+  test_passthrough_single<1>();
+}
+
+TEST(PdmPassthroughDecimator, mics5_subblocks1)
+{
+  test_passthrough<5, 1>();
+  test_passthrough_single<5>();
+}
+
+TEST(PdmPassthroughDecimator, mics3_subblocks4)  { test_passthrough<3, 4>();  }
+TEST(PdmPassthroughDecimator, mics16_subblocks6) { test_passthrough<16, 6>(); }
+
+
+TEST(PdmPassthroughDecimator, latency)
+{
+  TEST_ASSERT_EQUAL_UINT(0,   (mic_array::PdmPassthroughDecimator<4, 1>::Latency()));
+  TEST_ASSERT_EQUAL_UINT(32,  (mic_array::PdmPassthroughDecimator<4, 2>::Latency()));
+  TEST_ASSERT_EQUAL_UINT(160, (mic_array::PdmPassthroughDecimator<4, 6>::Latency()));
+}
+
+}
@@ -0,0 +1,138 @@
+// Copyright 2020-2024 XMOS LIMITED.
+// This Software is subject to the terms of the XMOS Public Licence: Version 1.
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <assert.h>
+#include <stdarg.h>
+
+#include <xcore/channel_streaming.h>
+
+#include "unity_fixture.h"
+
+#include "mic_array.h"
+
+extern "C" {
+
+TEST_GROUP_RUNNER(PdmTap) {
+  RUN_TEST_CASE(PdmTap, tap_4_to_3);
+  RUN_TEST_CASE(PdmTap, tap_8_to_8);
+  RUN_TEST_CASE(PdmTap, tap_16_to_5);
+  RUN_TEST_CASE(PdmTap, no_channel);
+}
+
+TEST_GROUP(PdmTap);
+
+static streaming_channel_t c_tap;
+
+TEST_SETUP(PdmTap) {
+  c_tap = s_chan_alloc();
+}
+
+TEST_TEAR_DOWN(PdmTap) {
+  s_chan_free(c_tap);
+}
+
+}
+
+
+// The block returned by a PdmTap must be the one its StandardPdmRxService
+// would return, and each tap must point at the words of its mic within it.
+template <unsigned CH_IN, unsigned CH_OUT, unsigned SUBBLOCKS, unsigned TAPS>
+static
+void test_tap(
+    unsigned seed)
+{
+  using TRef = mic_array::StandardPdmRxService<CH_IN, CH_OUT, SUBBLOCKS>;
+  using TDut = mic_array::PdmTap<TRef, CH_OUT, SUBBLOCKS, TAPS>;
+  constexpr unsigned BLOCK_WORDS = CH_IN * SUBBLOCKS;
+  constexpr unsigned BLOCK_COUNT = 4;
+
+  static TRef ref_rx;
+  static TDut dut_rx;
+
+  ref_rx.Init(0);
+  dut_rx.Init(0);
+  dut_rx.SetTapChannel(c_tap.end_a);
+
+  srand(seed);
+
+  // Tap the last mics first, so the map is actually exercised.
+  unsigned map[TAPS];
+  for(int k = 0; k < TAPS; k++)
+    map[k] = CH_OUT - 1 - k;
+  dut_rx.MapTap(map);
+
+  for(int blk = 0; blk < BLOCK_COUNT; blk++){
+    // Each service deinterleaves its raw block in place.
+    uint32_t ref_raw[BLOCK_WORDS];
+    uint32_t dut_raw[BLOCK_WORDS];
+    for(int k = 0; k < BLOCK_WORDS; k++)
+      ref_raw[k] = dut_raw[k] = (((uint32_t) rand()) << 16) ^ ((uint32_t) rand());
+
+    ref_rx.SendBlock(ref_raw);
+    uint32_t expected[CH_OUT * SUBBLOCKS];
+    memcpy(expected, ref_rx.GetPdmBlock(), sizeof(expected));
+
+    dut_rx.SendBlock(dut_raw);
+    uint32_t* out = dut_rx.GetPdmBlock();
+
+    TEST_ASSERT_EQUAL_UINT32_ARRAY(expected, out, CH_OUT * SUBBLOCKS);
+
+    const uint32_t* const* rows = TDut::ReceiveTap(c_tap.end_b);
+
+    for(int k = 0; k < TAPS; k++){
+      // Not a copy
+      TEST_ASSERT_EQUAL_PTR(&out[map[k] * SUBBLOCKS], rows[k]);
+      TEST_ASSERT_EQUAL_UINT32_ARRAY(&expected[map[k] * SUBBLOCKS], rows[k],
+                                     SUBBLOCKS);
+    }
+  }
+}
+
+extern "C" {
+
+TEST(PdmTap, tap_4_to_3)
+{
+  test_tap<4, 3, 6, 2>(0x6A02);
+}
+
+TEST(PdmTap, tap_8_to_8)
+{
+  test_tap<8, 8, 3, 8>(0x3E51);
+}
+
+TEST(PdmTap, tap_16_to_5)
+{
+  test_tap<16, 5, 2, 1>(0x1D9C);
+}
+
+
+// With no tap channel set, nothing is sent.
+TEST(PdmTap, no_channel)
+{
+  constexpr unsigned CH = 4;
+  constexpr unsigned SUBBLOCKS = 2;
+  using TDut = mic_array::PdmTap<
+      mic_array::StandardPdmRxService<CH, CH, SUBBLOCKS>, CH, SUBBLOCKS>;
+
+  static TDut dut_rx;
+  dut_rx.Init(0);
+
+  uint32_t raw[CH * SUBBLOCKS];
+  for(int k = 0; k < CH * SUBBLOCKS; k++)
+    raw[k] = 0x01010101 * k;
+
+  for(int blk = 0; blk < 4; blk++){
+    dut_rx.SendBlock(raw);
+    dut_rx.GetPdmBlock();
+  }
+
+  // A word sent now must be the first thing on the channel.
+  s_chan_out_word(c_tap.end_a, 0x600DF00D);
+  TEST_ASSERT_EQUAL_UINT32(0x600DF00D, s_chan_in_word(c_tap.end_b));
+}
+
+}
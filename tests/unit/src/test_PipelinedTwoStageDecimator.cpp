@@ -0,0 +1,91 @@
+// Copyright 2020-2024 XMOS LIMITED.
+// This Software is subject to the terms of the XMOS Public Licence: Version 1.
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <assert.h>
+#include <stdarg.h>
+
+#include "unity_fixture.h"
+
+#include "mic_array/cpp/DecimatorPipelined.hpp"
+#include "mic_array/etc/filters_default.h"
+
+extern "C" {
+
+TEST_GROUP_RUNNER(PipelinedTwoStageDecimator) {
+  RUN_TEST_CASE(PipelinedTwoStageDecimator, mics1);
+  RUN_TEST_CASE(PipelinedTwoStageDecimator, mics3);
+  RUN_TEST_CASE(PipelinedTwoStageDecimator, mics8);
+  RUN_TEST_CASE(PipelinedTwoStageDecimator, mics16);
+}
+
+TEST_GROUP(PipelinedTwoStageDecimator);
+TEST_SETUP(PipelinedTwoStageDecimator) {}
+TEST_TEAR_DOWN(PipelinedTwoStageDecimator) {}
+
+}
+
+
+// The pipelined decimator's output for each block must be the
+// TwoStageDecimator's output for the previous block (and zero for the first
+// block). Stopping and restarting the worker must not lose any state.
+template <unsigned MICS>
+static
+void test_PipelinedTwoStageDecimator()
+{
+  using TSerial = mic_array::TwoStageDecimator<MICS, STAGE2_DEC_FACTOR,
+                                               STAGE2_TAP_COUNT>;
+  using TPipelined = mic_array::PipelinedTwoStageDecimator<MICS,
+                                STAGE2_DEC_FACTOR, STAGE2_TAP_COUNT>;
+
+  static TSerial dec_ser;
+  static TPipelined dec_pipe;
+
+  constexpr unsigned BLOCK_SIZE = TSerial::BLOCK_SIZE;
+  constexpr unsigned BLOCK_COUNT = 30;
+
+  srand(5791 * MICS);
+
+  dec_ser.Init(stage1_coef, stage2_coef, stage2_shr);
+  dec_pipe.Init(stage1_coef, stage2_coef, stage2_shr);
+
+  int32_t expected[MICS] = {0};
+
+  for(int b = 0; b < BLOCK_COUNT; b++){
+
+    uint32_t pdm_block[BLOCK_SIZE];
+    for(int k = 0; k < BLOCK_SIZE; k++)
+      pdm_block[k] = (((uint32_t) rand()) << 16) ^ ((uint32_t) rand());
+
+    uint32_t pdm_copy[BLOCK_SIZE];
+    memcpy(pdm_copy, pdm_block, sizeof(pdm_block));
+
+    int32_t actual[MICS];
+    dec_pipe.ProcessBlock(actual, pdm_copy);
+
+    // The block is copied, so the caller may reuse it straight away.
+    memset(pdm_copy, 0, sizeof(pdm_copy));
+
+    TEST_ASSERT_EQUAL_INT32_ARRAY(expected, actual, MICS);
+
+    dec_ser.ProcessBlock(expected, pdm_block);
+
+    if(b == BLOCK_COUNT / 2)
+      dec_pipe.StopWorker();
+  }
+
+  // Release the worker thread for the following tests.
+  dec_pipe.StopWorker();
+}
+
+extern "C" {
+
+TEST(PipelinedTwoStageDecimator, mics1)   { test_PipelinedTwoStageDecimator<1>(); }
+TEST(PipelinedTwoStageDecimator, mics3)   { test_PipelinedTwoStageDecimator<3>(); }
+TEST(PipelinedTwoStageDecimator, mics8)   { test_PipelinedTwoStageDecimator<8>(); }
+TEST(PipelinedTwoStageDecimator, mics16)  { test_PipelinedTwoStageDecimator<16>(); }
+
+}
@@ -0,0 +1,158 @@
+// Copyright 2020-2024 XMOS LIMITED.
+// This Software is subject to the terms of the XMOS Public Licence: Version 1.
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <assert.h>
+#include <stdarg.h>
+
+#include "unity_fixture.h"
+
+#include "mic_array/cpp/OutputHandler.hpp"
+
+extern "C" {
+
+TEST_GROUP_RUNNER(QueuedFrameTransmitter) {
+  RUN_TEST_CASE(QueuedFrameTransmitter, in_order);
+  RUN_TEST_CASE(QueuedFrameTransmitter, skip_newest);
+  RUN_TEST_CASE(QueuedFrameTransmitter, overwrite_oldest);
+  RUN_TEST_CASE(QueuedFrameTransmitter, overwrite_many_laps);
+  RUN_TEST_CASE(QueuedFrameTransmitter, FrameOutputHandler);
+}
+
+TEST_GROUP(QueuedFrameTransmitter);
+TEST_SETUP(QueuedFrameTransmitter) {}
+TEST_TEAR_DOWN(QueuedFrameTransmitter) {}
+
+}
+
+static constexpr unsigned CHANS = 3;
+static constexpr unsigned SAMPS = 5;
+
+// Frame number n is filled with values derived from n.
+static void make_frame(int32_t frame[CHANS][SAMPS], unsigned n)
+{
+  for(int c = 0; c < CHANS; c++)
+    for(int s = 0; s < SAMPS; s++)
+      frame[c][s] = (int32_t) ((n << 16) | (c << 8) | s);
+}
+
+template <class TTx>
+static void push_frames(TTx& tx, unsigned first, unsigned count)
+{
+  for(unsigned n = first; n < first + count; n++){
+    int32_t frame[CHANS][SAMPS];
+    make_frame(frame, n);
+    tx.OutputFrame(frame);
+  }
+}
+
+template <class TTx>
+static void expect_frame(TTx& tx, unsigned n)
+{
+  int32_t expected[CHANS][SAMPS];
+  int32_t frame[CHANS][SAMPS];
+  make_frame(expected, n);
+  TEST_ASSERT_TRUE(tx.TryReceive(frame));
+  TEST_ASSERT_EQUAL_INT32_ARRAY(&expected[0][0], &frame[0][0], CHANS * SAMPS);
+}
+
+extern "C" {
+
+TEST(QueuedFrameTransmitter, in_order)
+{
+  static mic_array::QueuedFrameTransmitter<CHANS, SAMPS, 4> tx;
+  int32_t frame[CHANS][SAMPS];
+
+  TEST_ASSERT_FALSE(tx.TryReceive(frame));
+
+  for(int round = 0; round < 5; round++){
+    push_frames(tx, 3*round, 3);
+    TEST_ASSERT_EQUAL_UINT(3, tx.Pending());
+    for(int k = 0; k < 3; k++)
+      expect_frame(tx, 3*round + k);
+    TEST_ASSERT_FALSE(tx.TryReceive(frame));
+  }
+
+  TEST_ASSERT_EQUAL_UINT(0, tx.Overruns());
+}
+
+TEST(QueuedFrameTransmitter, skip_newest)
+{
+  static mic_array::QueuedFrameTransmitter<CHANS, SAMPS, 3, false> tx;
+  int32_t frame[CHANS][SAMPS];
+
+  push_frames(tx, 0, 5);
+  TEST_ASSERT_EQUAL_UINT(2, tx.Overruns());
+  TEST_ASSERT_EQUAL_UINT(3, tx.Pending());
+
+  expect_frame(tx, 0);
+  expect_frame(tx, 1);
+
+  // There's room again for two frames.
+  push_frames(tx, 5, 3);
+  TEST_ASSERT_EQUAL_UINT(3, tx.Overruns());
+
+  expect_frame(tx, 2);
+  expect_frame(tx, 5);
+  expect_frame(tx, 6);
+  TEST_ASSERT_FALSE(tx.TryReceive(frame));
+}
+
+TEST(QueuedFrameTransmitter, overwrite_oldest)
+{
+  static mic_array::QueuedFrameTransmitter<CHANS, SAMPS, 3, true> tx;
+  int32_t frame[CHANS][SAMPS];
+
+  push_frames(tx, 0, 5);
+  TEST_ASSERT_EQUAL_UINT(2, tx.Overruns());
+  TEST_ASSERT_EQUAL_UINT(3, tx.Pending());
+
+  expect_frame(tx, 2);
+  expect_frame(tx, 3);
+
+  push_frames(tx, 5, 2);
+  TEST_ASSERT_EQUAL_UINT(2, tx.Overruns());
+
+  expect_frame(tx, 4);
+  expect_frame(tx, 5);
+  expect_frame(tx, 6);
+  TEST_ASSERT_FALSE(tx.TryReceive(frame));
+}
+
+TEST(QueuedFrameTransmitter, overwrite_many_laps)
+{
+  static mic_array::QueuedFrameTransmitter<CHANS, SAMPS, 2, true> tx;
+  int32_t frame[CHANS][SAMPS];
+
+  push_frames(tx, 0, 11);
+  TEST_ASSERT_EQUAL_UINT(9, tx.Overruns());
+
+  expect_frame(tx, 9);
+  expect_frame(tx, 10);
+  TEST_ASSERT_FALSE(tx.TryReceive(frame));
+}
+
+TEST(QueuedFrameTransmitter, FrameOutputHandler)
+{
+  static mic_array::FrameOutputHandler<CHANS, SAMPS, 
+      mic_array::QueuedFrameTransmitterOf<2>::Type> output;
+
+  for(unsigned n = 0; n < 2; n++){
+    int32_t frame[CHANS][SAMPS];
+    make_frame(frame, n);
+    for(int s = 0; s < SAMPS; s++){
+      int32_t sample[CHANS];
+      for(int c = 0; c < CHANS; c++)
+        sample[c] = frame[c][s];
+      output.OutputSample(sample);
+    }
+  }
+
+  expect_frame(output.FrameTx, 0);
+  expect_frame(output.FrameTx, 1);
+}
+
+}
@@ -0,0 +1,162 @@
+// Copyright 2020-2024 XMOS LIMITED.
+// This Software is subject to the terms of the XMOS Public Licence: Version 1.
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <assert.h>
+#include <stdarg.h>
+#include <math.h>
+
+#include "unity_fixture.h"
+
+#include "mic_array/cpp/OutputHandler.hpp"
+#include "mic_array/etc/filters_default.h"
+
+extern "C" {
+
+TEST_GROUP_RUNNER(ResamplingOutputHandler) {
+  RUN_TEST_CASE(ResamplingOutputHandler, mics1_up2_down3);
+  RUN_TEST_CASE(ResamplingOutputHandler, mics4_up3_down2);
+  RUN_TEST_CASE(ResamplingOutputHandler, mics3_up7_down5_taps16);
+  RUN_TEST_CASE(ResamplingOutputHandler, mics2_up1_down1);
+  RUN_TEST_CASE(ResamplingOutputHandler, default_147_160_sine);
+}
+
+TEST_GROUP(ResamplingOutputHandler);
+TEST_SETUP(ResamplingOutputHandler) {}
+TEST_TEAR_DOWN(ResamplingOutputHandler) {}
+
+}
+
+
+#define MAX_RECORDED  5000
+
+template <unsigned MIC_COUNT>
+class MockOutputHandler
+{
+  public:
+
+    unsigned count = 0;
+    int32_t samples[MAX_RECORDED][MIC_COUNT];
+
+    void OutputSample(int32_t sample[MIC_COUNT])
+    {
+      assert(count < MAX_RECORDED);
+      for(int k = 0; k < MIC_COUNT; k++)
+        samples[count][k] = sample[k];
+      count++;
+    }
+};
+
+
+// Output n must be phase (n * DOWN) % UP of the filter applied to the input
+// up to sample (n * DOWN) / UP, with the arithmetic of fir_s32_multi().
+template <unsigned MICS, unsigned UP, unsigned DOWN, unsigned TAPS>
+static
+void test_ResamplingOutputHandler()
+{
+  using THandler = mic_array::ResamplingOutputHandler<MICS, UP, DOWN, TAPS,
+                                                      MockOutputHandler<MICS>>;
+
+  srand(88331 * MICS + 31 * UP + DOWN);
+
+  constexpr unsigned INPUTS = 300;
+  constexpr unsigned OUTPUTS = (INPUTS * UP + DOWN - 1) / DOWN;
+  static_assert(OUTPUTS <= MAX_RECORDED, "");
+
+  static int32_t coef[UP][TAPS];
+  for(int p = 0; p < UP; p++)
+    for(int t = 0; t < TAPS; t++)
+      coef[p][t] = ((int32_t) ((((uint32_t) rand()) << 16) ^ ((uint32_t) rand()))) >> 3;
+  const right_shift_t shr = 2;
+
+  THandler* handler = new THandler();
+  handler->Init(&coef[0][0], shr);
+
+  static int32_t input[INPUTS][MICS];
+  for(int s = 0; s < INPUTS; s++){
+    for(int k = 0; k < MICS; k++)
+      input[s][k] = ((int32_t) ((((uint32_t) rand()) << 16) ^ ((uint32_t) rand()))) >> 1;
+    handler->OutputSample(input[s]);
+  }
+
+  TEST_ASSERT_EQUAL_UINT(OUTPUTS, handler->Output.count);
+
+  for(int n = 0; n < OUTPUTS; n++){
+    const unsigned newest = (n * DOWN) / UP;
+    const unsigned phase = (n * DOWN) % UP;
+
+    for(int k = 0; k < MICS; k++){
+      int64_t acc = 0;
+      for(int t = 0; t < TAPS && t <= newest; t++){
+        const int64_t p = ((int64_t) coef[phase][t]) * input[newest - t][k];
+        acc += (p + (1 << 29)) >> 30;
+      }
+      acc = (acc + (1 << (shr - 1))) >> shr;
+      const int32_t expected = (acc > INT32_MAX)? INT32_MAX
+                             : (acc < -INT32_MAX)? -INT32_MAX : acc;
+
+      TEST_ASSERT_EQUAL_INT32(expected, handler->Output.samples[n][k]);
+    }
+  }
+
+  delete handler;
+}
+
+extern "C" {
+
+TEST(ResamplingOutputHandler, mics1_up2_down3)
+{
+  test_ResamplingOutputHandler<1, 2, 3, 8>();
+}
+
+TEST(ResamplingOutputHandler, mics4_up3_down2)
+{
+  test_ResamplingOutputHandler<4, 3, 2, 8>();
+}
+
+TEST(ResamplingOutputHandler, mics3_up7_down5_taps16)
+{
+  test_ResamplingOutputHandler<3, 7, 5, 16>();
+}
+
+TEST(ResamplingOutputHandler, mics2_up1_down1)
+{
+  test_ResamplingOutputHandler<2, 1, 1, 24>();
+}
+
+// A 1 kHz tone at 48 kHz must come out as the same tone at 44.1 kHz, delayed
+// by the filter's 16 sample group delay.
+TEST(ResamplingOutputHandler, default_147_160_sine)
+{
+  using THandler = mic_array::ResamplingOutputHandler<1,
+      RESAMPLE_147_160_UP, RESAMPLE_147_160_DOWN, RESAMPLE_147_160_PHASE_TAPS,
+      MockOutputHandler<1>>;
+
+  constexpr unsigned INPUTS = 4800;
+  constexpr double AMPLITUDE = 0x40000000;
+  constexpr double FREQ = 1000.0;
+
+  THandler* handler = new THandler();
+  handler->Init(&resample_147_160_coef[0][0], resample_147_160_shr);
+
+  for(int s = 0; s < INPUTS; s++){
+    int32_t sample[1] = { (int32_t) (AMPLITUDE * sin(2 * M_PI * FREQ * s / 48000.0)) };
+    handler->OutputSample(sample);
+  }
+
+  TEST_ASSERT_EQUAL_UINT(4410, handler->Output.count);
+
+  for(int n = 100; n < 4410; n++){
+    const double t = n / 44100.0 - 16 / 48000.0;
+    const int32_t expected = (int32_t) (AMPLITUDE * sin(2 * M_PI * FREQ * t));
+    TEST_ASSERT_INT32_WITHIN(0x40000000 / 2000, expected,
+                             handler->Output.samples[n][0]);
+  }
+
+  delete handler;
+}
+
+}
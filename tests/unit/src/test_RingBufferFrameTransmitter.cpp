@@ -0,0 +1,170 @@
+// Copyright 2020-2024 XMOS LIMITED.
+// This Software is subject to the terms of the XMOS Public Licence: Version 1.
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <assert.h>
+#include <stdarg.h>
+
+#include "unity_fixture.h"
+
+#include "mic_array/cpp/OutputHandler.hpp"
+
+extern "C" {
+
+TEST_GROUP_RUNNER(RingBufferFrameTransmitter) {
+  RUN_TEST_CASE(RingBufferFrameTransmitter, in_order);
+  RUN_TEST_CASE(RingBufferFrameTransmitter, overrun_underrun);
+  RUN_TEST_CASE(RingBufferFrameTransmitter, wraps_index);
+  RUN_TEST_CASE(RingBufferFrameTransmitter, sample_major);
+  RUN_TEST_CASE(RingBufferFrameTransmitter, FrameOutputHandler);
+}
+
+TEST_GROUP(RingBufferFrameTransmitter);
+TEST_SETUP(RingBufferFrameTransmitter) {}
+TEST_TEAR_DOWN(RingBufferFrameTransmitter) {}
+
+}
+
+static constexpr unsigned CHANS = 3;
+static constexpr unsigned SAMPS = 5;
+
+// Sample s of channel c of frame n.
+static int32_t sample_value(unsigned n, unsigned c, unsigned s)
+{
+  return (int32_t) ((n << 16) | (c << 8) | s);
+}
+
+static void make_frame(int32_t frame[CHANS][SAMPS], unsigned n)
+{
+  for(int c = 0; c < CHANS; c++)
+    for(int s = 0; s < SAMPS; s++)
+      frame[c][s] = sample_value(n, c, s);
+}
+
+template <class TTx>
+static void push_frames(TTx& tx, unsigned first, unsigned count)
+{
+  for(unsigned n = first; n < first + count; n++){
+    int32_t frame[CHANS][SAMPS];
+    make_frame(frame, n);
+    tx.OutputFrame(frame);
+  }
+}
+
+template <class TTx>
+static void expect_frame(TTx& tx, unsigned n)
+{
+  for(int s = 0; s < SAMPS; s++){
+    int32_t sample[CHANS];
+    TEST_ASSERT_TRUE(tx.PopSample(sample));
+    for(int c = 0; c < CHANS; c++)
+      TEST_ASSERT_EQUAL_INT32(sample_value(n, c, s), sample[c]);
+  }
+}
+
+extern "C" {
+
+TEST(RingBufferFrameTransmitter, in_order)
+{
+  static mic_array::RingBufferFrameTransmitter<CHANS, SAMPS, 16> tx;
+
+  for(int round = 0; round < 5; round++){
+    push_frames(tx, 3*round, 3);
+    TEST_ASSERT_EQUAL_UINT(3 * SAMPS, tx.Available());
+    for(int k = 0; k < 3; k++)
+      expect_frame(tx, 3*round + k);
+    TEST_ASSERT_EQUAL_UINT(0, tx.Available());
+  }
+
+  TEST_ASSERT_EQUAL_UINT(0, tx.Overruns());
+  TEST_ASSERT_EQUAL_UINT(0, tx.Underruns());
+}
+
+TEST(RingBufferFrameTransmitter, overrun_underrun)
+{
+  static mic_array::RingBufferFrameTransmitter<CHANS, SAMPS, 16> tx;
+  int32_t sample[CHANS];
+
+  TEST_ASSERT_FALSE(tx.PopSample(sample));
+  TEST_ASSERT_EQUAL_UINT(1, tx.Underruns());
+
+  // Only 3 whole frames fit in 16 samples.
+  push_frames(tx, 0, 5);
+  TEST_ASSERT_EQUAL_UINT(2, tx.Overruns());
+  TEST_ASSERT_EQUAL_UINT(15, tx.Available());
+
+  // Taking one sample is not room enough for another frame...
+  TEST_ASSERT_TRUE(tx.PopSample(sample));
+  push_frames(tx, 5, 1);
+  TEST_ASSERT_EQUAL_UINT(3, tx.Overruns());
+
+  // ...but taking the rest of a frame is.
+  for(int s = 1; s < SAMPS; s++)
+    TEST_ASSERT_TRUE(tx.PopSample(sample));
+  push_frames(tx, 6, 1);
+  TEST_ASSERT_EQUAL_UINT(3, tx.Overruns());
+
+  expect_frame(tx, 1);
+  expect_frame(tx, 2);
+  expect_frame(tx, 6);
+  TEST_ASSERT_FALSE(tx.PopSample(sample));
+  TEST_ASSERT_EQUAL_UINT(2, tx.Underruns());
+}
+
+TEST(RingBufferFrameTransmitter, wraps_index)
+{
+  static mic_array::RingBufferFrameTransmitter<CHANS, SAMPS, 8> tx;
+
+  // Frames straddle the end of the ring on most rounds.
+  for(unsigned n = 0; n < 20; n++){
+    push_frames(tx, n, 1);
+    expect_frame(tx, n);
+  }
+
+  TEST_ASSERT_EQUAL_UINT(0, tx.Overruns());
+  TEST_ASSERT_EQUAL_UINT(0, tx.Underruns());
+}
+
+TEST(RingBufferFrameTransmitter, sample_major)
+{
+  static mic_array::RingBufferFrameTransmitter<CHANS, SAMPS, 8, true> tx;
+
+  int32_t frame[SAMPS][CHANS];
+  for(int s = 0; s < SAMPS; s++)
+    for(int c = 0; c < CHANS; c++)
+      frame[s][c] = sample_value(7, c, s);
+
+  tx.OutputFrame(reinterpret_cast<int32_t (*)[SAMPS]>(&frame[0][0]));
+  expect_frame(tx, 7);
+}
+
+TEST(RingBufferFrameTransmitter, FrameOutputHandler)
+{
+  static mic_array::FrameOutputHandler<CHANS, SAMPS, 
+      mic_array::RingBufferFrameTransmitterOf<16>::Type> output;
+  static mic_array::FrameOutputHandler<CHANS, SAMPS, 
+      mic_array::RingBufferFrameTransmitterOf<16, true>::Type, 
+      1, true> output_sm;
+
+  for(unsigned n = 0; n < 2; n++){
+    int32_t frame[CHANS][SAMPS];
+    make_frame(frame, n);
+    for(int s = 0; s < SAMPS; s++){
+      int32_t sample[CHANS];
+      for(int c = 0; c < CHANS; c++)
+        sample[c] = frame[c][s];
+      output.OutputSample(sample);
+      output_sm.OutputSample(sample);
+    }
+  }
+
+  expect_frame(output.FrameTx, 0);
+  expect_frame(output.FrameTx, 1);
+  expect_frame(output_sm.FrameTx, 0);
+  expect_frame(output_sm.FrameTx, 1);
+}
+
+}
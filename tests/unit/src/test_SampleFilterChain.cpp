@@ -0,0 +1,242 @@
+// Copyright 2020-2024 XMOS LIMITED.
+// This Software is subject to the terms of the XMOS Public Licence: Version 1.
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <assert.h>
+#include <stdarg.h>
+
+#include "unity_fixture.h"
+
+#include "mic_array/dc_elimination.h"
+#include "mic_array/cpp/SampleFilter.hpp"
+
+extern "C" {
+
+TEST_GROUP_RUNNER(SampleFilterChain) {
+  RUN_TEST_CASE(SampleFilterChain, gain);
+  RUN_TEST_CASE(SampleFilterChain, gain_saturates);
+  RUN_TEST_CASE(SampleFilterChain, delay);
+  RUN_TEST_CASE(SampleFilterChain, empty);
+  RUN_TEST_CASE(SampleFilterChain, dcoe_gain_delay);
+  RUN_TEST_CASE(SampleFilterChain, block);
+  RUN_TEST_CASE(SampleFilterChain, frame);
+}
+
+TEST_GROUP(SampleFilterChain);
+TEST_SETUP(SampleFilterChain) {}
+TEST_TEAR_DOWN(SampleFilterChain) {}
+
+}
+
+static int32_t rand_sample()
+{
+  return (int32_t) ((uint32_t(rand()) << 17) ^ rand());
+}
+
+template <unsigned MICS>
+using TestChain = mic_array::SampleFilterChain<MICS,
+                                               mic_array::DcoeSampleFilter<MICS>,
+                                               mic_array::GainSampleFilter<MICS>,
+                                               mic_array::DelaySampleFilter<MICS, 3>>;
+
+// Set up a chain's trim and alignment stages (the same way each time).
+template <unsigned MICS>
+static void configure(mic_array::GainSampleFilter<MICS>& gain,
+                      mic_array::DelaySampleFilter<MICS, 3>& delay)
+{
+  for(int k = 0; k < MICS; k++){
+    gain.SetGain(k, 0x30000000 + 0x01000000 * k);
+    delay.SetDelay(k, k % 4);
+  }
+}
+
+
+extern "C" {
+
+TEST(SampleFilterChain, gain)
+{
+  mic_array::GainSampleFilter<3> filter;
+  filter.Init();
+
+  int32_t sample[3] = { 1000, -1000, 0x12345678 };
+  filter.Filter(sample);
+  TEST_ASSERT_EQUAL_INT32(1000, sample[0]);
+  TEST_ASSERT_EQUAL_INT32(-1000, sample[1]);
+  TEST_ASSERT_EQUAL_INT32(0x12345678, sample[2]);
+
+  filter.SetGain(0, 0x20000000);  // 0.5
+  filter.SetGain(1, 0x60000000);  // 1.5
+  filter.SetGain(2, -0x40000000); // -1.0
+  filter.Filter(sample);
+  TEST_ASSERT_EQUAL_INT32(500, sample[0]);
+  TEST_ASSERT_EQUAL_INT32(-1500, sample[1]);
+  TEST_ASSERT_EQUAL_INT32(-0x12345678, sample[2]);
+
+  // Rounds to nearest
+  TEST_ASSERT_EQUAL_INT32(2, filter.FilterChannel(0, 3));
+  TEST_ASSERT_EQUAL_INT32(-1, filter.FilterChannel(0, -3));
+}
+
+TEST(SampleFilterChain, gain_saturates)
+{
+  mic_array::GainSampleFilter<2> filter;
+  filter.Init();
+  filter.SetGain(0, 0x7FFFFFFF);
+  filter.SetGain(1, -0x80000000);
+
+  int32_t sample[2] = { 0x40000000, 0x7FFFFFFF };
+  filter.Filter(sample);
+  TEST_ASSERT_EQUAL_INT32(INT32_MAX, sample[0]);
+  TEST_ASSERT_EQUAL_INT32(INT32_MIN, sample[1]);
+}
+
+TEST(SampleFilterChain, delay)
+{
+  constexpr unsigned MICS = 4;
+  constexpr unsigned MAX_DELAY = 5;
+  constexpr unsigned SAMPLES = 40;
+  const unsigned delays[MICS] = { 0, 1, 3, 5 };
+
+  mic_array::DelaySampleFilter<MICS, MAX_DELAY> filter;
+  filter.Init();
+  for(int k = 0; k < MICS; k++)
+    filter.SetDelay(k, delays[k]);
+
+  int32_t input[SAMPLES][MICS];
+  for(int s = 0; s < SAMPLES; s++){
+    for(int k = 0; k < MICS; k++)
+      input[s][k] = rand_sample();
+
+    int32_t sample[MICS];
+    memcpy(sample, input[s], sizeof(sample));
+    filter.Filter(sample);
+
+    for(int k = 0; k < MICS; k++){
+      const int32_t expected = (s >= delays[k])? input[s - delays[k]][k] : 0;
+      TEST_ASSERT_EQUAL_INT32(expected, sample[k]);
+    }
+  }
+}
+
+TEST(SampleFilterChain, empty)
+{
+  mic_array::SampleFilterChain<4> chain;
+  chain.Init();
+
+  int32_t sample[4] = { 1, -2, 3, INT32_MIN };
+  chain.Filter(sample);
+  TEST_ASSERT_EQUAL_INT32(1, sample[0]);
+  TEST_ASSERT_EQUAL_INT32(-2, sample[1]);
+  TEST_ASSERT_EQUAL_INT32(3, sample[2]);
+  TEST_ASSERT_EQUAL_INT32(INT32_MIN, sample[3]);
+}
+
+// The chain must match its stages applied one after another.
+TEST(SampleFilterChain, dcoe_gain_delay)
+{
+  constexpr unsigned MICS = 7;
+
+  srand(12399);
+
+  TestChain<MICS> chain;
+  mic_array::DcoeSampleFilter<MICS> dcoe;
+  mic_array::GainSampleFilter<MICS> gain;
+  mic_array::DelaySampleFilter<MICS, 3> delay;
+
+  chain.Init();
+  dcoe.Init();
+  gain.Init();
+  delay.Init();
+
+  configure<MICS>(chain.Stage<1>(), chain.Stage<2>());
+  configure<MICS>(gain, delay);
+
+  for(int r = 0; r < 500; r++){
+    int32_t expected[MICS];
+    int32_t result[MICS];
+
+    for(int k = 0; k < MICS; k++)
+      expected[k] = result[k] = rand_sample();
+
+    dcoe.Filter(expected);
+    gain.Filter(expected);
+    delay.Filter(expected);
+
+    chain.Filter(result);
+
+    TEST_ASSERT_EQUAL_INT32_ARRAY(expected, result, MICS);
+  }
+}
+
+}
+
+
+// FilterSamples() and FilterFrame() must give the same result as Filter() on
+// each sample.
+template <unsigned MICS, unsigned SAMPLES>
+static
+void test_SampleFilterChain_block()
+{
+  srand(4431 + MICS);
+
+  TestChain<MICS> exp_chain;
+  TestChain<MICS> chain;
+  exp_chain.Init();
+  chain.Init();
+  configure<MICS>(exp_chain.template Stage<1>(), exp_chain.template Stage<2>());
+  configure<MICS>(chain.template Stage<1>(), chain.template Stage<2>());
+
+  for(int r = 0; r < 50; r++){
+    int32_t samples[SAMPLES][MICS];
+    int32_t expected[SAMPLES][MICS];
+
+    for(int s = 0; s < SAMPLES; s++){
+      for(int k = 0; k < MICS; k++)
+        expected[s][k] = samples[s][k] = rand_sample();
+      exp_chain.Filter(expected[s]);
+    }
+
+    chain.FilterSamples(samples);
+
+    TEST_ASSERT_EQUAL_INT32_ARRAY(&expected[0][0], &samples[0][0], MICS*SAMPLES);
+  }
+}
+
+template <unsigned MICS, unsigned SAMPLES>
+static
+void test_SampleFilterChain_frame()
+{
+  srand(8812 + MICS);
+
+  TestChain<MICS> exp_chain;
+  TestChain<MICS> chain;
+  exp_chain.Init();
+  chain.Init();
+  configure<MICS>(exp_chain.template Stage<1>(), exp_chain.template Stage<2>());
+  configure<MICS>(chain.template Stage<1>(), chain.template Stage<2>());
+
+  for(int r = 0; r < 50; r++){
+    int32_t frame[MICS][SAMPLES];
+    int32_t expected[SAMPLES][MICS];
+
+    for(int s = 0; s < SAMPLES; s++){
+      for(int k = 0; k < MICS; k++)
+        expected[s][k] = frame[k][s] = rand_sample();
+      exp_chain.Filter(expected[s]);
+    }
+
+    chain.FilterFrame(frame);
+
+    for(int s = 0; s < SAMPLES; s++)
+      for(int k = 0; k < MICS; k++)
+        TEST_ASSERT_EQUAL_INT32(expected[s][k], frame[k][s]);
+  }
+}
+
+extern "C" {
+TEST(SampleFilterChain, block) { test_SampleFilterChain_block<4,2>(); }
+TEST(SampleFilterChain, frame) { test_SampleFilterChain_frame<5,16>(); }
+}
@@ -0,0 +1,141 @@
+// Copyright 2022-2024 XMOS LIMITED.
+// This Software is subject to the terms of the XMOS Public Licence: Version 1.
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <assert.h>
+#include <stdarg.h>
+
+#include <type_traits>
+
+#include "unity_fixture.h"
+
+#include "mic_array.h"
+#include "mic_array/cpp/Prefab.hpp"
+
+using namespace mic_array;
+using namespace mic_array::prefab;
+
+extern "C" {
+
+TEST_GROUP_RUNNER(ScalableMicArray) {
+  RUN_TEST_CASE(ScalableMicArray, plan_16k);
+  RUN_TEST_CASE(ScalableMicArray, plan_192k);
+  RUN_TEST_CASE(ScalableMicArray, components);
+  RUN_TEST_CASE(ScalableMicArray, required_mips);
+}
+
+TEST_GROUP(ScalableMicArray);
+TEST_SETUP(ScalableMicArray) {}
+TEST_TEAR_DOWN(ScalableMicArray) {}
+
+}
+
+
+template <unsigned MIC_COUNT, unsigned RATE, unsigned THREADS>
+static void check_plan(
+    ScalableMode mode,
+    unsigned workers,
+    unsigned lead_mics = MIC_COUNT)
+{
+  using Plan = ScalableMicArrayPlan<MIC_COUNT, RATE, THREADS>;
+
+  TEST_ASSERT_EQUAL_UINT(mode, Plan::Mode);
+  TEST_ASSERT_EQUAL_UINT(workers, Plan::Workers);
+  TEST_ASSERT_EQUAL_UINT(lead_mics, Plan::LeadMics);
+
+  if(mode != SCALABLE_NONE){
+    TEST_ASSERT_LESS_OR_EQUAL_UINT32(MIC_ARRAY_CONFIG_THREAD_MIPS, 
+                                     Plan::RequiredMips);
+  }
+}
+
+
+extern "C" {
+
+// The estimates are close to the measured figures in resource_usage.rst.
+TEST(ScalableMicArray, plan_16k)
+{
+  TEST_ASSERT_EQUAL_UINT(10, (ScalableMicArrayPlan<1,16000,1>::RequiredMips));
+  TEST_ASSERT_EQUAL_UINT(44, (ScalableMicArrayPlan<4,16000,1>::RequiredMips));
+
+  check_plan<1, 16000, 1>(SCALABLE_SINGLE_THREAD, 1);
+  check_plan<2, 16000, 1>(SCALABLE_ISR_THREAD, 1);
+  check_plan<4, 16000, 4>(SCALABLE_ISR_THREAD, 1);
+  check_plan<8, 16000, 1>(SCALABLE_NONE, 1);
+  check_plan<8, 16000, 4>(SCALABLE_PARALLEL, 2, 4);
+  check_plan<16, 16000, 2>(SCALABLE_NONE, 1);
+  check_plan<16, 16000, 8>(SCALABLE_PARALLEL, 3, 4);
+}
+
+
+TEST(ScalableMicArray, plan_192k)
+{
+  check_plan<1, 192000, 1>(SCALABLE_ISR_THREAD, 1);
+  check_plan<4, 192000, 1>(SCALABLE_ISR_THREAD, 1);
+  check_plan<8, 192000, 4>(SCALABLE_PARALLEL, 2, 4);
+  // The decimation thread takes a lighter share of the mics, leaving it time
+  // for the PDM rx and output.
+  check_plan<16, 192000, 3>(SCALABLE_PARALLEL, 3, 2);
+  check_plan<16, 192000, 4>(SCALABLE_PARALLEL, 3, 2);
+  // More threads are allowed but not used.
+  check_plan<16, 192000, 8>(SCALABLE_PARALLEL, 3, 2);
+}
+
+
+// The components are those of BasicMicArray and Basic192MicArray, split
+// between workers as planned.
+TEST(ScalableMicArray, components)
+{
+  using Single = ScalableMicArray<1, 16000, 1>;
+  using Isr192 = ScalableMicArray<4, 192000, 1>;
+  using Par192 = ScalableMicArray<16, 192000, 4>;
+
+  TEST_ASSERT_TRUE((std::is_same<decltype(Single::Decimator),
+      TwoStageDecimator<1, STAGE2_DEC_FACTOR, STAGE2_TAP_COUNT>>::value));
+  TEST_ASSERT_TRUE((std::is_same<decltype(Single::PdmRx),
+      StandardPdmRxService<1, 1, STAGE2_DEC_FACTOR>>::value));
+  TEST_ASSERT_TRUE((std::is_same<decltype(Single::SampleFilter),
+      DcoeSampleFilter<1>>::value));
+
+  TEST_ASSERT_TRUE((std::is_same<decltype(Isr192::Decimator),
+      OneStageDecimator192<4, DcoeSampleFilter<4, DcoePoleShr<40, 192000>::value>,
+                           16, 8>>::value));
+  TEST_ASSERT_TRUE((std::is_same<decltype(Isr192::SampleFilter),
+      NopSampleFilter<4>>::value));
+
+  TEST_ASSERT_TRUE((std::is_same<decltype(Par192::Decimator),
+      ParallelDecimator<16, 3, ScalableDecimatorOf<192000, true, 8>::Type,
+                        MIC_ARRAY_PARALLEL_WORKER_STACK_WORDS, 2>>::value));
+  TEST_ASSERT_TRUE((std::is_same<decltype(Par192::PdmRx),
+      StandardPdmRxService<16, 16, 8>>::value));
+  TEST_ASSERT_EQUAL_UINT(192, OutputHandlerFrameSize<
+      decltype(Par192::OutputHandler)>::value);
+}
+
+
+// Within 5% of the measured figures in resource_usage.rst (3.072 MHz, ISR).
+TEST(ScalableMicArray, required_mips)
+{
+  TEST_ASSERT_FLOAT_WITHIN(0.05f * 10.65f, 10.65f, 
+                           (BasicMicArray<1, 16, true>::RequiredMips()));
+  TEST_ASSERT_FLOAT_WITHIN(0.05f * 22.00f, 22.00f, 
+                           (BasicMicArray<2, 16, true>::RequiredMips()));
+  TEST_ASSERT_FLOAT_WITHIN(0.05f * 43.70f, 43.70f, 
+                           (BasicMicArray<4, 16, true>::RequiredMips()));
+  TEST_ASSERT_FLOAT_WITHIN(0.05f * 75.90f, 75.90f, 
+                           (BasicMicArray<8, 16, true>::RequiredMips(3072000, 
+                                                                    false)));
+
+  static_assert(FitsThreadMips(BasicMicArray<4, 16, true>::RequiredMips()),
+                "4 mics fit one thread.");
+  static_assert(!FitsThreadMips(BasicMicArray<8, 16, true>::RequiredMips()),
+                "8 mics do not fit one thread with the ISR.");
+
+  TEST_ASSERT_EQUAL_FLOAT((ScalableMicArrayPlan<4,16000,1>::ThreadMips),
+                          (BasicMicArray<4, 16, true>::RequiredMips()));
+}
+
+}
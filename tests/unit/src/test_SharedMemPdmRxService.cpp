@@ -0,0 +1,150 @@
+// Copyright 2020-2024 XMOS LIMITED.
+// This Software is subject to the terms of the XMOS Public Licence: Version 1.
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <assert.h>
+#include <stdarg.h>
+
+#include "unity_fixture.h"
+
+#include "mic_array.h"
+
+extern "C" {
+
+TEST_GROUP_RUNNER(SharedMemPdmRxService) {
+  RUN_TEST_CASE(SharedMemPdmRxService, blocks_in_order_depth2);
+  RUN_TEST_CASE(SharedMemPdmRxService, blocks_in_order_depth4);
+  RUN_TEST_CASE(SharedMemPdmRxService, drops_when_full_depth2);
+  RUN_TEST_CASE(SharedMemPdmRxService, drops_when_full_depth5);
+}
+
+TEST_GROUP(SharedMemPdmRxService);
+TEST_SETUP(SharedMemPdmRxService) {}
+TEST_TEAR_DOWN(SharedMemPdmRxService) {}
+
+}
+
+static constexpr unsigned SUBBLOCKS = 4;
+
+template <unsigned DEPTH>
+using TPdmRx = mic_array::SharedMemPdmRxService<1, 1, SUBBLOCKS, DEPTH>;
+
+
+// With one channel there is nothing to deinterleave, and the words are just
+// put back in chronological order.
+static
+void check_block(
+    uint32_t* out_block,
+    uint32_t block[SUBBLOCKS])
+{
+  for(int sb = 0; sb < SUBBLOCKS; sb++)
+    TEST_ASSERT_EQUAL_UINT32(block[SUBBLOCKS-1-sb], out_block[sb]);
+}
+
+static
+void fill_block(
+    uint32_t block[SUBBLOCKS])
+{
+  for(int k = 0; k < SUBBLOCKS; k++)
+    block[k] = (((uint32_t) rand()) << 16) ^ ((uint32_t) rand());
+}
+
+
+// Up to DEPTH-1 blocks may wait to be taken, and are taken in order.
+template <unsigned DEPTH>
+static
+void test_blocks_in_order()
+{
+  static TPdmRx<DEPTH> pdm_rx;
+  pdm_rx.Init(0);
+  pdm_rx.AssertOnDroppedBlock(false);
+
+  srand(2355 + DEPTH);
+
+  constexpr unsigned BLOCK_COUNT = 20 * (DEPTH - 1);
+
+  uint32_t blocks[BLOCK_COUNT][SUBBLOCKS];
+  uint32_t expected[BLOCK_COUNT][SUBBLOCKS];
+  for(int k = 0; k < BLOCK_COUNT; k++){
+    fill_block(blocks[k]);
+    memcpy(expected[k], blocks[k], sizeof(blocks[0]));
+  }
+
+  for(int k = 0; k < BLOCK_COUNT; k += (DEPTH - 1)){
+    for(int j = 0; j < DEPTH - 1; j++)
+      pdm_rx.SendBlock(blocks[k + j]);
+    for(int j = 0; j < DEPTH - 1; j++)
+      check_block(pdm_rx.GetPdmBlock(), expected[k + j]);
+  }
+
+  TEST_ASSERT_EQUAL_UINT32(BLOCK_COUNT, pdm_rx_shmem_isr_context.published);
+  TEST_ASSERT_EQUAL_UINT32(0, pdm_rx_shmem_isr_context.missed_blocks);
+
+  mic_array::PdmRxStats stats = pdm_rx.GetStats();
+  TEST_ASSERT_EQUAL_UINT32(BLOCK_COUNT, stats.blocks);
+  TEST_ASSERT_EQUAL_UINT32(0, stats.dropped_blocks);
+  TEST_ASSERT_EQUAL_UINT32(DEPTH - 1, stats.max_backlog);
+
+  pdm_rx.ResetStats();
+  stats = pdm_rx.GetStats();
+  TEST_ASSERT_EQUAL_UINT32(0, stats.max_backlog);
+  TEST_ASSERT_EQUAL_UINT32(0, stats.max_latency);
+}
+
+
+// A block which arrives while DEPTH-1 blocks are waiting is dropped.
+template <unsigned DEPTH>
+static
+void test_drops_when_full()
+{
+  static TPdmRx<DEPTH> pdm_rx;
+  pdm_rx.Init(0);
+  pdm_rx.AssertOnDroppedBlock(false);
+
+  srand(9812 + DEPTH);
+
+  uint32_t blocks[DEPTH + 2][SUBBLOCKS];
+  uint32_t expected[DEPTH + 2][SUBBLOCKS];
+  for(int k = 0; k < DEPTH + 2; k++){
+    fill_block(blocks[k]);
+    memcpy(expected[k], blocks[k], sizeof(blocks[0]));
+  }
+
+  for(int k = 0; k < DEPTH - 1; k++)
+    pdm_rx.SendBlock(blocks[k]);
+  TEST_ASSERT_EQUAL_UINT32(0, pdm_rx_shmem_isr_context.missed_blocks);
+
+  pdm_rx.SendBlock(blocks[DEPTH - 1]);
+  TEST_ASSERT_EQUAL_UINT32(1, pdm_rx_shmem_isr_context.missed_blocks);
+
+  // Taking a block makes room for exactly one more.
+  check_block(pdm_rx.GetPdmBlock(), expected[0]);
+
+  pdm_rx.SendBlock(blocks[DEPTH]);
+  TEST_ASSERT_EQUAL_UINT32(1, pdm_rx_shmem_isr_context.missed_blocks);
+
+  pdm_rx.SendBlock(blocks[DEPTH + 1]);
+  TEST_ASSERT_EQUAL_UINT32(2, pdm_rx_shmem_isr_context.missed_blocks);
+
+  for(int k = 1; k < DEPTH - 1; k++)
+    check_block(pdm_rx.GetPdmBlock(), expected[k]);
+  check_block(pdm_rx.GetPdmBlock(), expected[DEPTH]);
+
+  // Drops are counted in the stats whatever AssertOnDroppedBlock() says.
+  mic_array::PdmRxStats stats = pdm_rx.GetStats();
+  TEST_ASSERT_EQUAL_UINT32(DEPTH, stats.blocks);
+  TEST_ASSERT_EQUAL_UINT32(2, stats.dropped_blocks);
+  TEST_ASSERT_EQUAL_UINT32(DEPTH - 1, stats.max_backlog);
+}
+
+extern "C" {
+
+TEST(SharedMemPdmRxService, blocks_in_order_depth2) { test_blocks_in_order<2>(); }
+TEST(SharedMemPdmRxService, blocks_in_order_depth4) { test_blocks_in_order<4>(); }
+TEST(SharedMemPdmRxService, drops_when_full_depth2) { test_drops_when_full<2>(); }
+TEST(SharedMemPdmRxService, drops_when_full_depth5) { test_drops_when_full<5>(); }
+
+}
@@ -0,0 +1,113 @@
+// Copyright 2020-2024 XMOS LIMITED.
+// This Software is subject to the terms of the XMOS Public Licence: Version 1.
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <assert.h>
+#include <stdarg.h>
+
+#include <xcore/thread.h>
+#include <xcore/channel_streaming.h>
+
+#include "unity_fixture.h"
+
+#include "mic_array/cpp/OutputHandler.hpp"
+
+extern "C" {
+
+  streaming_channel_t c_shmem_frames;
+
+  TEST_GROUP_RUNNER(SharedMemoryFrameTransmitter) {
+    RUN_TEST_CASE(SharedMemoryFrameTransmitter, OutputFrame_1x16);
+    RUN_TEST_CASE(SharedMemoryFrameTransmitter, OutputFrame_4x1);
+    RUN_TEST_CASE(SharedMemoryFrameTransmitter, OutputFrame_8x64);
+    RUN_TEST_CASE(SharedMemoryFrameTransmitter, OutputFrame_16x256);
+  }
+
+  TEST_GROUP(SharedMemoryFrameTransmitter);
+
+  TEST_SETUP(SharedMemoryFrameTransmitter) {
+    c_shmem_frames = s_chan_alloc();
+  }
+
+  TEST_TEAR_DOWN(SharedMemoryFrameTransmitter) {
+    s_chan_free(c_shmem_frames);
+  }
+
+  static unsigned shmem_stack[8000];
+  static void* shmem_stack_start = stack_base(shmem_stack, 8000);
+
+}
+
+static constexpr unsigned FRAMES = 6;
+
+// Sample k of channel c of frame f.
+static int32_t sample_value(unsigned f, unsigned c, unsigned k)
+{
+  return (int32_t) ((f << 24) ^ (c << 16) ^ (k * 0x9E37));
+}
+
+template <unsigned CHANS, unsigned SAMPLE_COUNT>
+static void produce_frames(void*)
+{
+  static mic_array::FrameOutputHandler<CHANS, SAMPLE_COUNT, 
+      mic_array::SharedMemoryFrameTransmitter, 2> output;
+
+  output.FrameTx.SetChannel(c_shmem_frames.end_a);
+
+  for(int f = 0; f < FRAMES; f++){
+    for(int k = 0; k < SAMPLE_COUNT; k++){
+      int32_t sample[CHANS];
+      for(int c = 0; c < CHANS; c++)
+        sample[c] = sample_value(f, c, k);
+      output.OutputSample(sample);
+    }
+  }
+
+  output.FrameTx.Drain();
+
+  // Tell the test the last release token has been taken, so the channel can
+  // be freed.
+  s_chan_out_word(c_shmem_frames.end_a, 0);
+}
+
+// Each frame must arrive complete and in place, alternating between the two
+// frame buffers, and the producer must not overwrite a frame before it is
+// released.
+template <unsigned CHANS, unsigned SAMPLE_COUNT>
+static
+void test_SharedMemoryFrameTransmitter()
+{
+  run_async(produce_frames<CHANS,SAMPLE_COUNT>, NULL, shmem_stack_start);
+
+  int32_t* prev = NULL;
+
+  for(int f = 0; f < FRAMES; f++){
+    int32_t* frame = ma_frame_rx_ptr(c_shmem_frames.end_b);
+
+    TEST_ASSERT_NOT_NULL(frame);
+    if(prev != NULL)
+      TEST_ASSERT_FALSE(frame == prev);
+
+    for(int c = 0; c < CHANS; c++)
+      for(int k = 0; k < SAMPLE_COUNT; k++)
+        TEST_ASSERT_EQUAL_INT32(sample_value(f, c, k), 
+                                frame[c * SAMPLE_COUNT + k]);
+
+    prev = frame;
+    ma_frame_release(c_shmem_frames.end_b);
+  }
+
+  (void) s_chan_in_word(c_shmem_frames.end_b);
+}
+
+extern "C" {
+
+  TEST(SharedMemoryFrameTransmitter, OutputFrame_1x16)   { test_SharedMemoryFrameTransmitter<1,16>(); }
+  TEST(SharedMemoryFrameTransmitter, OutputFrame_4x1)    { test_SharedMemoryFrameTransmitter<4,1>(); }
+  TEST(SharedMemoryFrameTransmitter, OutputFrame_8x64)   { test_SharedMemoryFrameTransmitter<8,64>(); }
+  TEST(SharedMemoryFrameTransmitter, OutputFrame_16x256) { test_SharedMemoryFrameTransmitter<16,256>(); }
+
+}
@@ -0,0 +1,87 @@
+// Copyright 2020-2024 XMOS LIMITED.
+// This Software is subject to the terms of the XMOS Public Licence: Version 1.
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <assert.h>
+#include <stdarg.h>
+
+#include "unity_fixture.h"
+
+#include "mic_array/cpp/Stage2Filter.hpp"
+
+extern "C" {
+
+TEST_GROUP_RUNNER(Stage2Filter) {
+  RUN_TEST_CASE(Stage2Filter, chans1_taps8_dec1);
+  RUN_TEST_CASE(Stage2Filter, chans2_taps65_dec6);
+  RUN_TEST_CASE(Stage2Filter, chans4_taps20_dec3);
+  RUN_TEST_CASE(Stage2Filter, chans9_taps65_dec6);
+}
+
+TEST_GROUP(Stage2Filter);
+TEST_SETUP(Stage2Filter) {}
+TEST_TEAR_DOWN(Stage2Filter) {}
+
+}
+
+
+// Stage2Filter, evaluated once every DEC_FACTOR samples, must match one
+// filter_fir_s32_t per channel fed every sample.
+template <unsigned CHANS, unsigned TAPS, unsigned DEC>
+static
+void test_Stage2Filter()
+{
+  srand(97127 * CHANS + 31 * TAPS + DEC);
+
+  constexpr unsigned OUTPUT_COUNT = 60;
+
+  int32_t coef[TAPS];
+  for(int k = 0; k < TAPS; k++)
+    coef[k] = ((int32_t) ((((uint32_t) rand()) << 16) ^ ((uint32_t) rand()))) >> 1;
+  const right_shift_t shr = 5;
+
+  mic_array::Stage2Filter<CHANS,TAPS,DEC> filter;
+  filter.Init(coef, shr);
+
+  filter_fir_s32_t expected_filters[CHANS];
+  int32_t expected_state[CHANS][TAPS] = {{0}};
+  for(int c = 0; c < CHANS; c++)
+    filter_fir_s32_init(&expected_filters[c], &expected_state[c][0], 
+                        TAPS, coef, shr);
+
+  for(int r = 0; r < OUTPUT_COUNT; r++){
+    int32_t expected[CHANS];
+
+    for(int k = 0; k < DEC; k++){
+      filter.Advance();
+
+      for(int c = 0; c < CHANS; c++){
+        int32_t sample = ((int32_t) ((((uint32_t) rand()) << 16) ^ ((uint32_t) rand()))) >> 1;
+
+        filter.Set(c, sample);
+
+        if(k < DEC-1)
+          filter_fir_s32_add_sample(&expected_filters[c], sample);
+        else
+          expected[c] = filter_fir_s32(&expected_filters[c], sample);
+      }
+    }
+
+    int32_t result[CHANS];
+    filter.Filter(result);
+
+    TEST_ASSERT_EQUAL_INT32_ARRAY(expected, result, CHANS);
+  }
+}
+
+extern "C" {
+
+TEST(Stage2Filter, chans1_taps8_dec1)  { test_Stage2Filter<1,8,1>(); }
+TEST(Stage2Filter, chans2_taps65_dec6) { test_Stage2Filter<2,65,6>(); }
+TEST(Stage2Filter, chans4_taps20_dec3) { test_Stage2Filter<4,20,3>(); }
+TEST(Stage2Filter, chans9_taps65_dec6) { test_Stage2Filter<9,65,6>(); }
+
+}
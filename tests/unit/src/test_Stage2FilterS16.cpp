@@ -0,0 +1,123 @@
+// Copyright 2020-2024 XMOS LIMITED.
+// This Software is subject to the terms of the XMOS Public Licence: Version 1.
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <assert.h>
+#include <stdarg.h>
+
+#include "unity_fixture.h"
+
+#include "mic_array/cpp/Stage2Filter.hpp"
+
+extern "C" {
+
+TEST_GROUP_RUNNER(Stage2FilterS16) {
+  RUN_TEST_CASE(Stage2FilterS16, chans1_taps16_dec2);
+  RUN_TEST_CASE(Stage2FilterS16, chans2_taps65_dec6);
+  RUN_TEST_CASE(Stage2FilterS16, chans4_taps20_dec4);
+  RUN_TEST_CASE(Stage2FilterS16, chans18_taps65_dec6);
+  RUN_TEST_CASE(Stage2FilterS16, rounding);
+}
+
+TEST_GROUP(Stage2FilterS16);
+TEST_SETUP(Stage2FilterS16) {}
+TEST_TEAR_DOWN(Stage2FilterS16) {}
+
+}
+
+
+// Upper 16 bits of a sample, rounded.
+static
+int16_t top16(int32_t sample)
+{
+  return (int16_t) ((((int64_t) sample) + 0x8000) >> 16);
+}
+
+
+// Stage2FilterS16, evaluated once every DEC_FACTOR samples, must match a
+// plain FIR over the upper 16 bits of each channel's samples.
+template <unsigned CHANS, unsigned TAPS, unsigned DEC>
+static
+void test_Stage2FilterS16()
+{
+  srand(97127 * CHANS + 31 * TAPS + DEC + 16);
+
+  constexpr unsigned OUTPUT_COUNT = 60;
+
+  int16_t coef[TAPS];
+  for(int k = 0; k < TAPS; k++)
+    coef[k] = ((int16_t) rand()) >> 1;
+  const right_shift_t shr = 3;
+
+  mic_array::Stage2FilterS16<CHANS,TAPS,DEC> filter;
+  filter.Init(coef, shr);
+
+  // Newest sample first
+  int16_t history[CHANS][TAPS] = {{0}};
+
+  for(int r = 0; r < OUTPUT_COUNT; r++){
+    for(int k = 0; k < DEC; k++){
+      filter.Advance();
+
+      for(int c = 0; c < CHANS; c++){
+        // Small enough that the accumulators never saturate
+        int32_t sample = ((int32_t) ((((uint32_t) rand()) << 16) ^ ((uint32_t) rand()))) >> 5;
+
+        filter.Set(c, sample);
+
+        memmove(&history[c][1], &history[c][0], (TAPS-1) * sizeof(int16_t));
+        history[c][0] = top16(sample);
+      }
+    }
+
+    int32_t expected[CHANS];
+    for(int c = 0; c < CHANS; c++){
+      int64_t acc = 0;
+      for(int k = 0; k < TAPS; k++)
+        acc += ((int32_t) coef[k]) * history[c][k];
+      expected[c] = (int32_t) ((acc + (1 << (shr - 1))) >> shr);
+    }
+
+    int32_t result[CHANS];
+    filter.Filter(result);
+
+    TEST_ASSERT_EQUAL_INT32_ARRAY(expected, result, CHANS);
+  }
+}
+
+extern "C" {
+
+TEST(Stage2FilterS16, chans1_taps16_dec2)  { test_Stage2FilterS16<1,16,2>(); }
+TEST(Stage2FilterS16, chans2_taps65_dec6)  { test_Stage2FilterS16<2,65,6>(); }
+TEST(Stage2FilterS16, chans4_taps20_dec4)  { test_Stage2FilterS16<4,20,4>(); }
+TEST(Stage2FilterS16, chans18_taps65_dec6) { test_Stage2FilterS16<18,65,6>(); }
+
+
+// Samples are rounded to their upper 16 bits, saturating at the top.
+TEST(Stage2FilterS16, rounding)
+{
+  const int32_t samples[] = { 0x00007FFF, 0x00008000, -0x00008000,
+                              -0x00008001, 0x12348000, INT32_MAX, INT32_MIN };
+  const int32_t expected[] = { 0, 1, 0, -1, 0x1235, 0x7FFF, -0x8000 };
+
+  int16_t coef[16] = { 1 };
+
+  mic_array::Stage2FilterS16<1,16,2> filter;
+  filter.Init(coef, 0);
+
+  for(int k = 0; k < sizeof(samples) / sizeof(samples[0]); k++){
+    int32_t result;
+    // Filtered once every DEC_FACTOR samples
+    filter.Advance();
+    filter.Set(0, 0);
+    filter.Advance();
+    filter.Set(0, samples[k]);
+    filter.Filter(&result);
+    TEST_ASSERT_EQUAL_INT32(expected[k], result);
+  }
+}
+
+}
@@ -0,0 +1,173 @@
+// Copyright 2022-2024 XMOS LIMITED.
+// This Software is subject to the terms of the XMOS Public Licence: Version 1.
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <assert.h>
+#include <stdarg.h>
+
+#include "unity_fixture.h"
+
+#include "mic_array/cpp/Profiler.hpp"
+
+using namespace mic_array;
+
+extern "C" {
+
+TEST_GROUP_RUNNER(StageProfiler) {
+  RUN_TEST_CASE(StageProfiler, empty);
+  RUN_TEST_CASE(StageProfiler, add);
+  RUN_TEST_CASE(StageProfiler, histogram);
+  RUN_TEST_CASE(StageProfiler, stages_independent);
+  RUN_TEST_CASE(StageProfiler, mark);
+  RUN_TEST_CASE(StageProfiler, reset);
+}
+
+TEST_GROUP(StageProfiler);
+TEST_SETUP(StageProfiler) {}
+TEST_TEAR_DOWN(StageProfiler) {}
+
+TEST(StageProfiler, empty)
+{
+  StageProfiler profiler;
+
+  for(unsigned k = 0; k < PROFILE_STAGE_COUNT; k++){
+    StageCycles s = profiler.GetStats(ProfileStage(k));
+    TEST_ASSERT_EQUAL_UINT(0, s.count);
+    TEST_ASSERT_EQUAL_UINT32(UINT32_MAX, s.min);
+    TEST_ASSERT_EQUAL_UINT32(0, s.max);
+    TEST_ASSERT_EQUAL_UINT32(0, s.Average());
+    for(unsigned b = 0; b < MIC_ARRAY_PROFILE_HISTOGRAM_BINS; b++)
+      TEST_ASSERT_EQUAL_UINT(0, s.histogram[b]);
+  }
+}
+
+TEST(StageProfiler, add)
+{
+  StageProfiler profiler;
+
+  srand(7712);
+
+  uint32_t min = UINT32_MAX, max = 0;
+  uint64_t total = 0;
+
+  for(int r = 0; r < 1000; r++){
+    uint32_t ticks = rand() % 100000;
+    min = (ticks < min)? ticks : min;
+    max = (ticks > max)? ticks : max;
+    total += ticks;
+    profiler.Add(PROFILE_STAGE1, ticks);
+  }
+
+  StageCycles s = profiler.GetStats(PROFILE_STAGE1);
+  TEST_ASSERT_EQUAL_UINT(1000, s.count);
+  TEST_ASSERT_EQUAL_UINT32(min, s.min);
+  TEST_ASSERT_EQUAL_UINT32(max, s.max);
+  TEST_ASSERT_EQUAL_UINT32(total / 1000, s.Average());
+  TEST_ASSERT(s.total == total);
+
+  unsigned binned = 0;
+  for(unsigned b = 0; b < MIC_ARRAY_PROFILE_HISTOGRAM_BINS; b++)
+    binned += s.histogram[b];
+  TEST_ASSERT_EQUAL_UINT(1000, binned);
+}
+
+TEST(StageProfiler, histogram)
+{
+  StageProfiler profiler;
+
+  const unsigned top = MIC_ARRAY_PROFILE_HISTOGRAM_BINS - 1;
+
+  profiler.Add(PROFILE_OUTPUT, 0);
+  profiler.Add(PROFILE_OUTPUT, 1);
+  profiler.Add(PROFILE_OUTPUT, 2);
+  profiler.Add(PROFILE_OUTPUT, 3);
+  profiler.Add(PROFILE_OUTPUT, 1000);  // [512, 1024)
+  profiler.Add(PROFILE_OUTPUT, 1024);  // [1024, 2048)
+  profiler.Add(PROFILE_OUTPUT, (1u << top) - 1);
+  profiler.Add(PROFILE_OUTPUT, 1u << top);
+  profiler.Add(PROFILE_OUTPUT, UINT32_MAX);
+
+  StageCycles s = profiler.GetStats(PROFILE_OUTPUT);
+
+  unsigned expected[MIC_ARRAY_PROFILE_HISTOGRAM_BINS] = {0};
+  expected[0] = 2;
+  expected[1] = 2;
+  expected[9] = 1;
+  expected[10] = 1;
+  expected[top - 1] = 1;
+  expected[top] = 2;
+
+  TEST_ASSERT_EQUAL_UINT_ARRAY(expected, s.histogram, 
+                               MIC_ARRAY_PROFILE_HISTOGRAM_BINS);
+  TEST_ASSERT_EQUAL_UINT32(0, s.min);
+  TEST_ASSERT_EQUAL_UINT32(UINT32_MAX, s.max);
+}
+
+TEST(StageProfiler, stages_independent)
+{
+  StageProfiler profiler;
+
+  profiler.Add(PROFILE_PDM_RX, 100);
+  profiler.Add(PROFILE_SAMPLE_FILTER, 30);
+  profiler.Add(PROFILE_SAMPLE_FILTER, 50);
+
+  for(unsigned k = 0; k < PROFILE_STAGE_COUNT; k++){
+    StageCycles s = profiler.GetStats(ProfileStage(k));
+    switch(k){
+      case PROFILE_PDM_RX:
+        TEST_ASSERT_EQUAL_UINT(1, s.count);
+        TEST_ASSERT_EQUAL_UINT32(100, s.Average());
+        break;
+      case PROFILE_SAMPLE_FILTER:
+        TEST_ASSERT_EQUAL_UINT(2, s.count);
+        TEST_ASSERT_EQUAL_UINT32(30, s.min);
+        TEST_ASSERT_EQUAL_UINT32(50, s.max);
+        TEST_ASSERT_EQUAL_UINT32(40, s.Average());
+        break;
+      default:
+        TEST_ASSERT_EQUAL_UINT(0, s.count);
+        break;
+    }
+  }
+}
+
+TEST(StageProfiler, mark)
+{
+  StageProfiler profiler;
+
+  profiler.Start();
+  for(int r = 0; r < 10; r++){
+    profiler.Mark(PROFILE_PDM_RX);
+    profiler.Mark(PROFILE_DECIMATOR);
+  }
+  profiler.Mark(PROFILE_PDM_RX);
+
+  StageCycles rx = profiler.GetStats(PROFILE_PDM_RX);
+  StageCycles dec = profiler.GetStats(PROFILE_DECIMATOR);
+
+  TEST_ASSERT_EQUAL_UINT(11, rx.count);
+  TEST_ASSERT_EQUAL_UINT(10, dec.count);
+  TEST_ASSERT(rx.min <= rx.max);
+  TEST_ASSERT(dec.min <= dec.max);
+  TEST_ASSERT_EQUAL_UINT(0, profiler.GetStats(PROFILE_OUTPUT).count);
+}
+
+TEST(StageProfiler, reset)
+{
+  StageProfiler profiler;
+
+  profiler.Add(PROFILE_STAGE2, 12345);
+  profiler.Reset();
+
+  StageCycles s = profiler.GetStats(PROFILE_STAGE2);
+  TEST_ASSERT_EQUAL_UINT(0, s.count);
+  TEST_ASSERT_EQUAL_UINT32(UINT32_MAX, s.min);
+  TEST_ASSERT_EQUAL_UINT32(0, s.max);
+  TEST_ASSERT(s.total == 0);
+  TEST_ASSERT_EQUAL_UINT(0, s.histogram[MIC_ARRAY_PROFILE_HISTOGRAM_BINS-1]);
+}
+
+}
@@ -0,0 +1,580 @@
+// Copyright 2020-2024 XMOS LIMITED.
+// This Software is subject to the terms of the XMOS Public Licence: Version 1.
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <assert.h>
+#include <stdarg.h>
+
+#include "unity_fixture.h"
+
+#include "mic_array.h"
+
+extern "C" {
+
+TEST_GROUP_RUNNER(StandardPdmRxService) {
+  RUN_TEST_CASE(StandardPdmRxService, thread_deinterleave_4_to_3);
+  RUN_TEST_CASE(StandardPdmRxService, thread_deinterleave_8_to_8);
+  RUN_TEST_CASE(StandardPdmRxService, thread_deinterleave_16_to_5);
+  RUN_TEST_CASE(StandardPdmRxService, capture_channels);
+  RUN_TEST_CASE(StandardPdmRxService, six_of_eight);
+  RUN_TEST_CASE(StandardPdmRxService, slack);
+  RUN_TEST_CASE(StandardPdmRxService, block_stamp);
+  RUN_TEST_CASE(StandardPdmRxService, health);
+  RUN_TEST_CASE(StandardPdmRxService, static_map_1);
+  RUN_TEST_CASE(StandardPdmRxService, static_map_2);
+  RUN_TEST_CASE(StandardPdmRxService, static_map_4);
+  RUN_TEST_CASE(StandardPdmRxService, static_map_8);
+  RUN_TEST_CASE(StandardPdmRxService, static_map_16);
+  RUN_TEST_CASE(StandardPdmRxService, direct_map_16);
+  RUN_TEST_CASE(StandardPdmRxService, active_channels);
+  RUN_TEST_CASE(StandardPdmRxService, reenable_channels);
+  RUN_TEST_CASE(StandardPdmRxService, reenable_channels_thread);
+}
+
+TEST_GROUP(StandardPdmRxService);
+TEST_SETUP(StandardPdmRxService) {}
+TEST_TEAR_DOWN(StandardPdmRxService) {}
+
+}
+
+
+// Words fed into ProcessWord() one at a time, with DeinterleaveInThread()
+// enabled, must give the same blocks as sending the raw block and letting
+// GetPdmBlock() deinterleave it.
+template <unsigned CH_IN, unsigned CH_OUT, unsigned SUBBLOCKS>
+static
+void test_thread_deinterleave(
+    unsigned seed)
+{
+  using TPdmRx = mic_array::StandardPdmRxService<CH_IN, CH_OUT, SUBBLOCKS>;
+  constexpr unsigned BLOCK_WORDS = CH_IN * SUBBLOCKS;
+  constexpr unsigned BLOCK_COUNT = 4;
+
+  static TPdmRx ref_rx;
+  static TPdmRx dut_rx;
+
+  ref_rx.Init(0);
+  dut_rx.Init(0);
+  dut_rx.DeinterleaveInThread(true);
+
+  srand(seed);
+
+  // Reverse the default mapping, so channel_map is actually exercised.
+  unsigned map[CH_OUT];
+  for(int ch = 0; ch < CH_OUT; ch++)
+    map[ch] = CH_IN - 1 - ch;
+  ref_rx.MapChannels(map);
+  dut_rx.MapChannels(map);
+
+  for(int blk = 0; blk < BLOCK_COUNT; blk++){
+    // In order of arrival.
+    uint32_t words[BLOCK_WORDS];
+    for(int k = 0; k < BLOCK_WORDS; k++)
+      words[k] = (((uint32_t) rand()) << 16) ^ ((uint32_t) rand());
+
+    // Stored in reverse order of arrival, as by ProcessNext().
+    uint32_t raw[BLOCK_WORDS];
+    for(int k = 0; k < BLOCK_WORDS; k++)
+      raw[BLOCK_WORDS-1-k] = words[k];
+
+    ref_rx.SendBlock(raw);
+    uint32_t expected[CH_OUT * SUBBLOCKS];
+    memcpy(expected, ref_rx.GetPdmBlock(), sizeof(expected));
+
+    for(int k = 0; k < BLOCK_WORDS; k++)
+      dut_rx.ProcessWord(words[k]);
+
+    uint32_t* out = dut_rx.GetPdmBlock();
+
+    TEST_ASSERT_EQUAL_UINT32_ARRAY(expected, out, CH_OUT * SUBBLOCKS);
+  }
+
+  TEST_ASSERT_EQUAL_UINT32(BLOCK_COUNT, dut_rx.GetStats().blocks);
+}
+
+extern "C" {
+
+TEST(StandardPdmRxService, thread_deinterleave_4_to_3)
+{
+  test_thread_deinterleave<4, 3, 6>(0x2A71);
+}
+
+TEST(StandardPdmRxService, thread_deinterleave_8_to_8)
+{
+  test_thread_deinterleave<8, 8, 3>(0x7C19);
+}
+
+TEST(StandardPdmRxService, thread_deinterleave_16_to_5)
+{
+  test_thread_deinterleave<16, 5, 2>(0x5B02);
+}
+
+TEST(StandardPdmRxService, capture_channels)
+{
+  TEST_ASSERT_EQUAL_UINT(1,  mic_array::PdmCaptureChannels<1>::value);
+  TEST_ASSERT_EQUAL_UINT(2,  mic_array::PdmCaptureChannels<2>::value);
+  TEST_ASSERT_EQUAL_UINT(4,  mic_array::PdmCaptureChannels<3>::value);
+  TEST_ASSERT_EQUAL_UINT(4,  mic_array::PdmCaptureChannels<4>::value);
+  TEST_ASSERT_EQUAL_UINT(8,  mic_array::PdmCaptureChannels<5>::value);
+  TEST_ASSERT_EQUAL_UINT(8,  mic_array::PdmCaptureChannels<6>::value);
+  TEST_ASSERT_EQUAL_UINT(8,  mic_array::PdmCaptureChannels<8>::value);
+  TEST_ASSERT_EQUAL_UINT(16, mic_array::PdmCaptureChannels<12>::value);
+  TEST_ASSERT_EQUAL_UINT(16, mic_array::PdmCaptureChannels<16>::value);
+}
+
+// A 6-mic array on the first 6 pins of an 8-bit port, with the default
+// channel map: each output channel is the deinterleaved input channel.
+TEST(StandardPdmRxService, six_of_eight)
+{
+  constexpr unsigned MICS = 6;
+  constexpr unsigned CH_IN = mic_array::PdmCaptureChannels<MICS>::value;
+  constexpr unsigned SUBBLOCKS = 3;
+
+  static mic_array::StandardPdmRxService<CH_IN, MICS, SUBBLOCKS> pdm_rx;
+  pdm_rx.Init(0);
+
+  srand(0x6E8);
+
+  alignas(8) uint32_t raw[SUBBLOCKS * CH_IN];
+  uint32_t copy[SUBBLOCKS * CH_IN];
+  for(int k = 0; k < SUBBLOCKS * CH_IN; k++)
+    copy[k] = raw[k] = (((uint32_t) rand()) << 16) ^ ((uint32_t) rand());
+
+  mic_array::deinterleave_pdm_samples<CH_IN>(copy, SUBBLOCKS);
+
+  pdm_rx.SendBlock(raw);
+  uint32_t* out = pdm_rx.GetPdmBlock();
+
+  for(int ch = 0; ch < MICS; ch++)
+    for(int sb = 0; sb < SUBBLOCKS; sb++)
+      TEST_ASSERT_EQUAL_UINT32(copy[(SUBBLOCKS-1-sb)*CH_IN + ch], 
+                               out[ch * SUBBLOCKS + sb]);
+}
+
+
+// Blocks which are already waiting when GetPdmBlock() is called must show
+// (almost) no idle time, and a block period of at least the time between
+// the blocks being sent.
+TEST(StandardPdmRxService, slack)
+{
+  constexpr unsigned CH_IN = 2;
+  constexpr unsigned SUBBLOCKS = 2;
+  constexpr uint32_t GAP = 5000;
+
+  static mic_array::StandardPdmRxService<CH_IN, CH_IN, SUBBLOCKS> pdm_rx;
+  pdm_rx.Init(0);
+
+  mic_array::PdmRxSlack slack = pdm_rx.GetSlack();
+  TEST_ASSERT_EQUAL_UINT32(0, slack.block_period);
+  TEST_ASSERT_EQUAL_UINT32(UINT32_MAX, slack.recent_min_idle);
+  TEST_ASSERT_EQUAL_UINT32(UINT32_MAX, slack.min_idle);
+
+  alignas(8) uint32_t raw[SUBBLOCKS * CH_IN] = {0};
+
+  for(int blk = 0; blk < MIC_ARRAY_SLACK_WINDOW_BLOCKS; blk++){
+    pdm_rx.SendBlock(raw);
+    delay_ticks(GAP);
+    pdm_rx.GetPdmBlock();
+
+    slack = pdm_rx.GetSlack();
+    TEST_ASSERT_LESS_THAN_UINT32(GAP / 10, slack.last_idle);
+    TEST_ASSERT(slack.min_idle <= slack.last_idle);
+    if(blk)
+      TEST_ASSERT_GREATER_OR_EQUAL_UINT32(GAP, slack.block_period);
+    if(blk < MIC_ARRAY_SLACK_WINDOW_BLOCKS - 1)
+      TEST_ASSERT_EQUAL_UINT32(UINT32_MAX, slack.recent_min_idle);
+  }
+
+  slack = pdm_rx.GetSlack();
+  TEST_ASSERT_EQUAL_UINT32(slack.min_idle, slack.recent_min_idle);
+
+  pdm_rx.ResetStats();
+  TEST_ASSERT_EQUAL_UINT32(UINT32_MAX, pdm_rx.GetSlack().min_idle);
+}
+
+
+// The blocks returned by GetPdmBlock() must only be checked once
+// MonitorHealth() is enabled. On a 2-bit port, a port word of alternating
+// bits is one channel stuck high and the other stuck low.
+TEST(StandardPdmRxService, health)
+{
+  constexpr unsigned CH_IN = 2;
+  constexpr unsigned SUBBLOCKS = 4;
+  constexpr unsigned BLOCKS = CH_IN * MIC_ARRAY_HEALTH_WINDOW_WORDS / SUBBLOCKS;
+
+  static mic_array::StandardPdmRxService<CH_IN, CH_IN, SUBBLOCKS> pdm_rx;
+  pdm_rx.Init(0);
+
+  alignas(8) uint32_t raw[SUBBLOCKS * CH_IN];
+
+  for(int blk = 0; blk < BLOCKS; blk++){
+    for(int k = 0; k < SUBBLOCKS * CH_IN; k++)
+      raw[k] = 0x55555555;
+    pdm_rx.SendBlock(raw);
+    pdm_rx.GetPdmBlock();
+  }
+
+  TEST_ASSERT_EQUAL_UINT(0, pdm_rx.GetHealth().windows);
+
+  pdm_rx.MonitorHealth(true);
+
+  for(int blk = 0; blk < BLOCKS; blk++){
+    for(int k = 0; k < SUBBLOCKS * CH_IN; k++)
+      raw[k] = 0x55555555;
+    pdm_rx.SendBlock(raw);
+    pdm_rx.GetPdmBlock();
+  }
+
+  mic_array::PdmHealth health = pdm_rx.GetHealth();
+  TEST_ASSERT_EQUAL_UINT(CH_IN, health.windows);
+  TEST_ASSERT_EQUAL_HEX32(0x3, health.stuck_low ^ health.stuck_high);
+  TEST_ASSERT_EQUAL_HEX32(0x0, health.stuck_low & health.stuck_high);
+  TEST_ASSERT_EQUAL_HEX32(0x0, health.toggling);
+}
+
+
+// Each block's stamp must count the blocks captured, and give the time its
+// first word was read.
+TEST(StandardPdmRxService, block_stamp)
+{
+  constexpr unsigned CH_IN = 4;
+  constexpr unsigned SUBBLOCKS = 2;
+  constexpr unsigned BLOCK_COUNT = 5;
+
+  static mic_array::StandardPdmRxService<CH_IN, CH_IN, SUBBLOCKS> pdm_rx;
+  pdm_rx.Init(0);
+  pdm_rx.DeinterleaveInThread(true);
+
+  for(int blk = 0; blk < BLOCK_COUNT; blk++){
+    const uint32_t before = get_reference_time();
+    pdm_rx.ProcessWord(0x12345678);
+    const uint32_t after = get_reference_time();
+    delay_ticks(1000);
+
+    for(int k = 1; k < CH_IN * SUBBLOCKS; k++)
+      pdm_rx.ProcessWord(0x12345678);
+
+    pdm_rx.GetPdmBlock();
+
+    const mic_array::PdmBlockStamp stamp = pdm_rx.GetBlockStamp();
+    TEST_ASSERT_EQUAL_UINT32(blk, stamp.block_index);
+    TEST_ASSERT(stamp.timestamp - before <= after - before);
+  }
+}
+
+}
+
+
+// A compile-time CHANNEL_MAP must give the same blocks as the same map
+// given to MapChannels(), both when GetPdmBlock() deinterleaves and when
+// ProcessWord() does.
+template <unsigned CH_IN, unsigned SUBBLOCKS, unsigned... CHANNEL_MAP>
+static
+void test_static_map(
+    unsigned seed)
+{
+  constexpr unsigned CH_OUT = sizeof...(CHANNEL_MAP);
+  using TRefRx = mic_array::StandardPdmRxService<CH_IN, CH_OUT, SUBBLOCKS>;
+  using TDutRx = mic_array::StandardPdmRxService<CH_IN, CH_OUT, SUBBLOCKS, 
+                                                 CHANNEL_MAP...>;
+  constexpr unsigned BLOCK_WORDS = CH_IN * SUBBLOCKS;
+  constexpr unsigned BLOCK_COUNT = 4;
+
+  static TRefRx ref_rx;
+  static TDutRx dut_rx;
+  static TDutRx dut_thread_rx;
+
+  ref_rx.Init(0);
+  dut_rx.Init(0);
+  dut_thread_rx.Init(0);
+  dut_thread_rx.DeinterleaveInThread(true);
+
+  unsigned map[CH_OUT] = { CHANNEL_MAP... };
+  ref_rx.MapChannels(map);
+
+  srand(seed);
+
+  for(int blk = 0; blk < BLOCK_COUNT; blk++){
+    uint32_t words[BLOCK_WORDS];
+    for(int k = 0; k < BLOCK_WORDS; k++)
+      words[k] = (((uint32_t) rand()) << 16) ^ ((uint32_t) rand());
+
+    alignas(8) uint32_t raw[BLOCK_WORDS];
+    for(int k = 0; k < BLOCK_WORDS; k++)
+      raw[BLOCK_WORDS-1-k] = words[k];
+
+    uint32_t expected[CH_OUT * SUBBLOCKS];
+    ref_rx.SendBlock(raw);
+    memcpy(expected, ref_rx.GetPdmBlock(), sizeof(expected));
+
+    for(int k = 0; k < BLOCK_WORDS; k++)
+      raw[BLOCK_WORDS-1-k] = words[k];
+    dut_rx.SendBlock(raw);
+    uint32_t* out = dut_rx.GetPdmBlock();
+    TEST_ASSERT_EQUAL_UINT32_ARRAY(expected, out, CH_OUT * SUBBLOCKS);
+
+    for(int k = 0; k < BLOCK_WORDS; k++)
+      dut_thread_rx.ProcessWord(words[k]);
+    out = dut_thread_rx.GetPdmBlock();
+    TEST_ASSERT_EQUAL_UINT32_ARRAY(expected, out, CH_OUT * SUBBLOCKS);
+  }
+}
+
+extern "C" {
+
+TEST(StandardPdmRxService, static_map_1)
+{
+  test_static_map<1, 4, 0>(0x51A1);
+}
+
+TEST(StandardPdmRxService, static_map_2)
+{
+  test_static_map<2, 3, 1, 0>(0x51A2);
+}
+
+TEST(StandardPdmRxService, static_map_4)
+{
+  test_static_map<4, 2, 3, 0, 2>(0x51A4);
+}
+
+TEST(StandardPdmRxService, static_map_8)
+{
+  test_static_map<8, 3, 1, 2, 3, 4, 5, 6>(0x51A8);
+}
+
+TEST(StandardPdmRxService, static_map_16)
+{
+  test_static_map<16, 2, 15, 0, 7, 8, 3, 12, 5, 10, 1>(0x51B0);
+}
+
+
+// 16 mics (e.g. DDR on an 8-bit port) with the direct channel map are
+// deinterleaved straight into the output block, and a map set later (or
+// set back to direct) is still followed.
+TEST(StandardPdmRxService, direct_map_16)
+{
+  constexpr unsigned MICS = 16;
+  constexpr unsigned SUBBLOCKS = 3;
+
+  static mic_array::StandardPdmRxService<MICS, MICS, SUBBLOCKS> pdm_rx;
+  pdm_rx.Init(0);
+
+  srand(0xD16);
+
+  const unsigned maps[3][2] = { {0, 0}, {0, 5}, {0, 0} };
+
+  for(int r = 0; r < 3; r++){
+    pdm_rx.MapChannel(maps[r][0], maps[r][1]);
+
+    alignas(8) uint32_t raw[SUBBLOCKS * MICS];
+    uint32_t copy[SUBBLOCKS * MICS];
+    for(int k = 0; k < SUBBLOCKS * MICS; k++)
+      copy[k] = raw[k] = (((uint32_t) rand()) << 16) ^ ((uint32_t) rand());
+
+    mic_array::deinterleave_pdm_samples<MICS>(copy, SUBBLOCKS);
+
+    pdm_rx.SendBlock(raw);
+    uint32_t* out = pdm_rx.GetPdmBlock();
+
+    for(int ch = 0; ch < MICS; ch++){
+      const unsigned in_ch = (ch == maps[r][0])? maps[r][1] : ch;
+      for(int sb = 0; sb < SUBBLOCKS; sb++)
+        TEST_ASSERT_EQUAL_UINT32(copy[(SUBBLOCKS-1-sb)*MICS + in_ch], 
+                                 out[ch * SUBBLOCKS + sb]);
+    }
+  }
+}
+
+}
+
+
+// With some channels inactive, the active channels' words must be as with
+// all channels active, both when GetPdmBlock() deinterleaves and when
+// ProcessWord() does.
+extern "C" {
+
+TEST(StandardPdmRxService, active_channels)
+{
+  constexpr unsigned CH_IN = 8;
+  constexpr unsigned CH_OUT = 6;
+  constexpr unsigned SUBBLOCKS = 3;
+  constexpr unsigned BLOCK_WORDS = CH_IN * SUBBLOCKS;
+  constexpr unsigned BLOCK_COUNT = 4;
+  const uint32_t mask = 0x25;
+
+  using TPdmRx = mic_array::StandardPdmRxService<CH_IN, CH_OUT, SUBBLOCKS>;
+
+  static TPdmRx ref_rx;
+  static TPdmRx dut_rx;
+  static TPdmRx dut_thread_rx;
+
+  ref_rx.Init(0);
+  dut_rx.Init(0);
+  dut_thread_rx.Init(0);
+  dut_thread_rx.DeinterleaveInThread(true);
+
+  unsigned map[CH_OUT] = { 7, 2, 5, 0, 3, 6 };
+  ref_rx.MapChannels(map);
+  dut_rx.MapChannels(map);
+  dut_thread_rx.MapChannels(map);
+
+  dut_rx.SetActiveChannels(mask);
+  dut_thread_rx.SetActiveChannels(mask);
+
+  srand(0xAC7);
+
+  for(int blk = 0; blk < BLOCK_COUNT; blk++){
+    uint32_t words[BLOCK_WORDS];
+    for(int k = 0; k < BLOCK_WORDS; k++)
+      words[k] = (((uint32_t) rand()) << 16) ^ ((uint32_t) rand());
+
+    alignas(8) uint32_t raw[BLOCK_WORDS];
+    for(int k = 0; k < BLOCK_WORDS; k++)
+      raw[BLOCK_WORDS-1-k] = words[k];
+
+    uint32_t expected[CH_OUT][SUBBLOCKS];
+    ref_rx.SendBlock(raw);
+    memcpy(expected, ref_rx.GetPdmBlock(), sizeof(expected));
+
+    for(int k = 0; k < BLOCK_WORDS; k++)
+      raw[BLOCK_WORDS-1-k] = words[k];
+    dut_rx.SendBlock(raw);
+    uint32_t (*out)[SUBBLOCKS] = (uint32_t (*)[SUBBLOCKS]) dut_rx.GetPdmBlock();
+
+    for(int k = 0; k < BLOCK_WORDS; k++)
+      dut_thread_rx.ProcessWord(words[k]);
+    uint32_t (*thread_out)[SUBBLOCKS] = 
+        (uint32_t (*)[SUBBLOCKS]) dut_thread_rx.GetPdmBlock();
+
+    for(int ch = 0; ch < CH_OUT; ch++){
+      if(!((mask >> ch) & 1))
+        continue;
+      TEST_ASSERT_EQUAL_UINT32_ARRAY(expected[ch], out[ch], SUBBLOCKS);
+      TEST_ASSERT_EQUAL_UINT32_ARRAY(expected[ch], thread_out[ch], SUBBLOCKS);
+    }
+  }
+}
+
+}
+
+
+// Switching mics off and back on, in the order MicArray::ThreadEntry() does
+// it, must never leave the decimator reading words which PdmRx has not
+// copied: each mic must match a decimator fed from a PdmRx which copies
+// every channel and given the same masks. With DeinterleaveInThread(), the
+// PDM rx thread is half way through the next block when the mask changes.
+template <bool THREAD>
+static
+void test_reenable_channels(
+    unsigned seed)
+{
+  constexpr unsigned CH_IN = 8;
+  constexpr unsigned MICS = 6;
+  constexpr unsigned SUBBLOCKS = STAGE2_DEC_FACTOR;
+  constexpr unsigned BLOCK_WORDS = CH_IN * SUBBLOCKS;
+  constexpr unsigned BLOCK_COUNT = 16;
+  constexpr unsigned ALL = (1 << MICS) - 1;
+
+  using TPdmRx = mic_array::StandardPdmRxService<CH_IN, MICS, SUBBLOCKS>;
+  using TDecimator = mic_array::TwoStageDecimator<MICS, STAGE2_DEC_FACTOR, 
+                                                  STAGE2_TAP_COUNT>;
+
+  static TPdmRx ref_rx;
+  static TPdmRx dut_rx;
+  static TDecimator ref_dec;
+  static TDecimator dut_dec;
+
+  ref_rx.Init(0);
+  dut_rx.Init(0);
+  dut_rx.DeinterleaveInThread(THREAD);
+  ref_dec.Init(stage1_coef, stage2_coef, stage2_shr);
+  dut_dec.Init(stage1_coef, stage2_coef, stage2_shr);
+
+  unsigned map[MICS] = { 7, 2, 5, 0, 3, 6 };
+  ref_rx.MapChannels(map);
+  dut_rx.MapChannels(map);
+
+  // Mask requested before each block is decimated.
+  const uint32_t requested[BLOCK_COUNT] = { 
+      ALL, ALL, 0x25, 0x25, 0x25, 0x25, 0x2F, 0x2F, 
+      0x2F, 0x01, 0x01, 0x01, ALL,  ALL,  ALL,  ALL };
+
+  srand(seed);
+
+  static uint32_t words[BLOCK_COUNT + 1][BLOCK_WORDS];
+  for(int blk = 0; blk <= BLOCK_COUNT; blk++)
+    for(int k = 0; k < BLOCK_WORDS; k++)
+      words[blk][k] = (((uint32_t) rand()) << 16) ^ ((uint32_t) rand());
+
+  if(THREAD){
+    for(int k = 0; k < BLOCK_WORDS / 2; k++)
+      dut_rx.ProcessWord(words[0][k]);
+  }
+
+  uint32_t decimated = ALL;
+
+  for(int blk = 0; blk < BLOCK_COUNT; blk++){
+    alignas(8) static uint32_t raw[BLOCK_WORDS];
+    for(int k = 0; k < BLOCK_WORDS; k++)
+      raw[BLOCK_WORDS-1-k] = words[blk][k];
+    ref_rx.SendBlock(raw);
+    uint32_t* ref_pdm = ref_rx.GetPdmBlock();
+
+    if(THREAD){
+      // Finish this block, and get half way through the next.
+      for(int k = BLOCK_WORDS / 2; k < BLOCK_WORDS; k++)
+        dut_rx.ProcessWord(words[blk][k]);
+      for(int k = 0; k < BLOCK_WORDS / 2; k++)
+        dut_rx.ProcessWord(words[blk+1][k]);
+    } else {
+      alignas(8) static uint32_t dut_raw[BLOCK_WORDS];
+      for(int k = 0; k < BLOCK_WORDS; k++)
+        dut_raw[BLOCK_WORDS-1-k] = words[blk][k];
+      dut_rx.SendBlock(dut_raw);
+    }
+    uint32_t* dut_pdm = dut_rx.GetPdmBlock();
+
+    if(requested[blk] != decimated){
+      decimated = requested[blk] & dut_rx.CopiedChannels();
+      dut_dec.SetActiveChannels(decimated);
+      ref_dec.SetActiveChannels(decimated);
+      dut_rx.SetActiveChannels(requested[blk]);
+    }
+
+    // Mics 1 and 3 are switched back on at block 6. The block GetPdmBlock()
+    // has just returned was copied without them, and in the thread so is
+    // half of the next.
+    if(blk == 6)
+      TEST_ASSERT_EQUAL_UINT32(0x25, decimated);
+    if(blk == 7)
+      TEST_ASSERT_EQUAL_UINT32(THREAD? 0x25 : 0x2F, decimated);
+    if(blk == 8)
+      TEST_ASSERT_EQUAL_UINT32(0x2F, decimated);
+
+    int32_t expected[MICS];
+    int32_t sample[MICS];
+    ref_dec.ProcessBlock(expected, ref_pdm);
+    dut_dec.ProcessBlock(sample, dut_pdm);
+
+    TEST_ASSERT_EQUAL_INT32_ARRAY(expected, sample, MICS);
+  }
+
+  TEST_ASSERT_EQUAL_UINT32(ALL, decimated);
+}
+
+extern "C" {
+
+TEST(StandardPdmRxService, reenable_channels)
+{
+  test_reenable_channels<false>(0x3E1);
+}
+
+TEST(StandardPdmRxService, reenable_channels_thread)
+{
+  test_reenable_channels<true>(0x3E2);
+}
+
+}
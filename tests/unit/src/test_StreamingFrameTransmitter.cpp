@@ -0,0 +1,106 @@
+// Copyright 2020-2024 XMOS LIMITED.
+// This Software is subject to the terms of the XMOS Public Licence: Version 1.
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <assert.h>
+#include <stdarg.h>
+
+#include <xcore/thread.h>
+#include <xcore/channel_streaming.h>
+
+#include "unity_fixture.h"
+
+#include "mic_array/cpp/OutputHandler.hpp"
+
+extern "C" {
+
+  streaming_channel_t c_stream_frames;
+
+  TEST_GROUP_RUNNER(StreamingFrameTransmitter) {
+    RUN_TEST_CASE(StreamingFrameTransmitter, OutputFrame_1x1_1credit);
+    RUN_TEST_CASE(StreamingFrameTransmitter, OutputFrame_1x16_2credits);
+    RUN_TEST_CASE(StreamingFrameTransmitter, OutputFrame_4x1_4credits);
+    RUN_TEST_CASE(StreamingFrameTransmitter, OutputFrame_8x64_2credits);
+    RUN_TEST_CASE(StreamingFrameTransmitter, OutputFrame_16x16_1credit);
+  }
+
+  TEST_GROUP(StreamingFrameTransmitter);
+
+  TEST_SETUP(StreamingFrameTransmitter) {
+    c_stream_frames = s_chan_alloc();
+  }
+
+  TEST_TEAR_DOWN(StreamingFrameTransmitter) {
+    s_chan_free(c_stream_frames);
+  }
+
+  static unsigned stream_stack[8000];
+  static void* stream_stack_start = stack_base(stream_stack, 8000);
+
+}
+
+static constexpr unsigned FRAMES = 10;
+
+// Sample k of channel c of frame f.
+static int32_t stream_sample_value(unsigned f, unsigned c, unsigned k)
+{
+  return (int32_t) ((f << 24) ^ (c << 16) ^ (k * 0x7F4A));
+}
+
+template <unsigned CHANS, unsigned SAMPLE_COUNT, unsigned CREDITS>
+static void stream_frames(void*)
+{
+  static mic_array::FrameOutputHandler<CHANS, SAMPLE_COUNT, 
+      mic_array::StreamingFrameTransmitter> output;
+
+  output.FrameTx.SetChannel(c_stream_frames.end_a);
+
+  for(int f = 0; f < FRAMES; f++){
+    for(int k = 0; k < SAMPLE_COUNT; k++){
+      int32_t sample[CHANS];
+      for(int c = 0; c < CHANS; c++)
+        sample[c] = stream_sample_value(f, c, k);
+      output.OutputSample(sample);
+    }
+  }
+
+  output.FrameTx.Drain(CREDITS);
+
+  // Tell the test the credits have all been collected, so the channel can be
+  // freed.
+  s_chan_out_word(c_stream_frames.end_a, 0);
+}
+
+// Every frame must arrive complete and in order, however many credits are
+// granted, and once drained the channel must hold nothing but the final word.
+template <unsigned CHANS, unsigned SAMPLE_COUNT, unsigned CREDITS>
+static
+void test_StreamingFrameTransmitter()
+{
+  ma_frame_stream_rx_init(c_stream_frames.end_b, CREDITS);
+
+  run_async(stream_frames<CHANS,SAMPLE_COUNT,CREDITS>, NULL, stream_stack_start);
+
+  for(int f = 0; f < FRAMES; f++){
+    int32_t frame[CHANS][SAMPLE_COUNT];
+
+    ma_frame_stream_rx(&frame[0][0], c_stream_frames.end_b, CHANS, SAMPLE_COUNT);
+
+    for(int c = 0; c < CHANS; c++)
+      for(int k = 0; k < SAMPLE_COUNT; k++)
+        TEST_ASSERT_EQUAL_INT32(stream_sample_value(f, c, k), frame[c][k]);
+  }
+
+  TEST_ASSERT_EQUAL_UINT32(0, s_chan_in_word(c_stream_frames.end_b));
+}
+
+extern "C" {
+  TEST(StreamingFrameTransmitter, OutputFrame_1x1_1credit)    { test_StreamingFrameTransmitter<1,1,1>();   }
+  TEST(StreamingFrameTransmitter, OutputFrame_1x16_2credits)  { test_StreamingFrameTransmitter<1,16,2>();  }
+  TEST(StreamingFrameTransmitter, OutputFrame_4x1_4credits)   { test_StreamingFrameTransmitter<4,1,4>();   }
+  TEST(StreamingFrameTransmitter, OutputFrame_8x64_2credits)  { test_StreamingFrameTransmitter<8,64,2>();  }
+  TEST(StreamingFrameTransmitter, OutputFrame_16x16_1credit)  { test_StreamingFrameTransmitter<16,16,1>(); }
+}
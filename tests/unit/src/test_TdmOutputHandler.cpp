@@ -0,0 +1,160 @@
+// Copyright 2020-2024 XMOS LIMITED.
+// This Software is subject to the terms of the XMOS Public Licence: Version 1.
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <assert.h>
+#include <stdarg.h>
+
+#include "unity_fixture.h"
+
+#include "mic_array/cpp/OutputHandler.hpp"
+
+extern "C" {
+
+TEST_GROUP_RUNNER(TdmOutputHandler) {
+  RUN_TEST_CASE(TdmOutputHandler, slot_layout);
+  RUN_TEST_CASE(TdmOutputHandler, follows_isr);
+  RUN_TEST_CASE(TdmOutputHandler, slips);
+  RUN_TEST_CASE(TdmOutputHandler, frame_sync);
+}
+
+TEST_GROUP(TdmOutputHandler);
+TEST_SETUP(TdmOutputHandler) {}
+TEST_TEAR_DOWN(TdmOutputHandler) {}
+
+}
+
+static constexpr unsigned CHANS = 3;
+static constexpr unsigned SLOTS = 4;
+static constexpr unsigned FRAMES = 4;
+
+using TOutput = mic_array::TdmOutputHandler<CHANS, SLOTS, FRAMES>;
+
+static uint32_t bit_reverse(uint32_t x)
+{
+  uint32_t y = 0;
+  for(int b = 0; b < 32; b++, x >>= 1)
+    y = (y << 1) | (x & 1);
+  return y;
+}
+
+// Channel c of sample n.
+static int32_t sample_value(unsigned n, unsigned c)
+{
+  return (int32_t) (0x80000000 | (n << 8) | c);
+}
+
+static void output_sample(TOutput& output, unsigned n)
+{
+  int32_t sample[CHANS];
+  for(int c = 0; c < CHANS; c++)
+    sample[c] = sample_value(n, c);
+  output.OutputSample(sample);
+}
+
+// Does what the ISR does for one TDM frame, checking the slot words.
+static void isr_frame(const int n)
+{
+  for(int s = 0; s < SLOTS; s++){
+    const uint32_t word = tdm_tx_isr_context.buffer[tdm_tx_isr_context.index];
+    const uint32_t expected = (n < 0 || s >= CHANS)? 0 
+                                : bit_reverse(sample_value(n, s));
+    TEST_ASSERT_EQUAL_HEX32(expected, word);
+    tdm_tx_isr_context.index = (tdm_tx_isr_context.index + 1) 
+                                  % tdm_tx_isr_context.words;
+  }
+}
+
+extern "C" {
+
+TEST(TdmOutputHandler, slot_layout)
+{
+  static TOutput output;
+  output.AttachISR();
+
+  TEST_ASSERT_EQUAL_UINT(2 * FRAMES * SLOTS, tdm_tx_isr_context.words);
+  TEST_ASSERT_EQUAL_UINT(SLOTS, tdm_tx_isr_context.slots);
+
+  for(unsigned n = 0; n < 3; n++)
+    output_sample(output, n);
+
+  // The first sample goes FRAMES frames ahead of the ISR, MSB first.
+  for(unsigned n = 0; n < 3; n++){
+    for(unsigned s = 0; s < SLOTS; s++){
+      const uint32_t expected = (s < CHANS)? bit_reverse(sample_value(n, s)) 
+                                           : 0;
+      TEST_ASSERT_EQUAL_HEX32(expected, 
+          tdm_tx_isr_context.buffer[(FRAMES + n) * SLOTS + s]);
+    }
+  }
+
+  TEST_ASSERT_EQUAL_UINT(0, output.Slips());
+}
+
+TEST(TdmOutputHandler, follows_isr)
+{
+  static TOutput output;
+  output.AttachISR();
+
+  // Samples come out FRAMES frames after they go in, across many laps.
+  for(int n = 0; n < 50; n++){
+    output_sample(output, n);
+    isr_frame(n - (int) FRAMES);
+  }
+
+  // Bursts within FRAMES / 2 of the ISR are fine too.
+  for(int n = 50; n < 100; n += 2){
+    output_sample(output, n);
+    output_sample(output, n + 1);
+    isr_frame(n - (int) FRAMES);
+    isr_frame(n + 1 - (int) FRAMES);
+  }
+
+  TEST_ASSERT_EQUAL_UINT(0, output.Slips());
+}
+
+TEST(TdmOutputHandler, slips)
+{
+  static TOutput output;
+  output.AttachISR();
+
+  // The ISR runs at twice the rate of the samples.
+  for(int n = 0; n < 8; n++){
+    output_sample(output, n);
+    for(int k = 0; k < 2*SLOTS; k++)
+      tdm_tx_isr_context.index = (tdm_tx_isr_context.index + 1) 
+                                    % tdm_tx_isr_context.words;
+  }
+
+  TEST_ASSERT_EQUAL_UINT(2, output.Slips());
+
+  // The last slip, on sample 6, put it FRAMES frames ahead of the ISR (which
+  // was outputting frame 4) again.
+  TEST_ASSERT_EQUAL_HEX32(bit_reverse(sample_value(6, 0)),
+                          tdm_tx_isr_context.buffer[0]);
+  TEST_ASSERT_EQUAL_HEX32(bit_reverse(sample_value(7, 0)),
+                          tdm_tx_isr_context.buffer[SLOTS]);
+}
+
+TEST(TdmOutputHandler, frame_sync)
+{
+  static TOutput output;
+
+  output.SetPorts(5, 7);
+  output.AttachISR();
+  TEST_ASSERT_EQUAL(5, tdm_tx_isr_context.p_tdm_out);
+  TEST_ASSERT_EQUAL(7, tdm_tx_isr_context.p_fsync);
+  TEST_ASSERT_EQUAL_HEX32(1, tdm_tx_isr_context.fsync[0]);
+  for(int s = 1; s < SLOTS; s++)
+    TEST_ASSERT_EQUAL_HEX32(0, tdm_tx_isr_context.fsync[s]);
+
+  const uint32_t pattern[SLOTS] = {0, 0, 0xFFFFFFFF, 0xFFFFFFFF};
+  output.SetFrameSync(pattern);
+  output.AttachISR();
+  TEST_ASSERT_EQUAL_HEX32_ARRAY(pattern, tdm_tx_isr_context.fsync, SLOTS);
+}
+
+}
@@ -0,0 +1,837 @@
+// Copyright 2020-2024 XMOS LIMITED.
+// This Software is subject to the terms of the XMOS Public Licence: Version 1.
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <assert.h>
+#include <stdarg.h>
+
+#include "unity_fixture.h"
+
+#include "mic_array/cpp/Decimator.hpp"
+#include "mic_array/cpp/SampleFilter.hpp"
+#include "mic_array/etc/filters_default.h"
+
+extern "C" {
+
+TEST_GROUP_RUNNER(TwoStageDecimator) {
+  RUN_TEST_CASE(TwoStageDecimator, frame_mics1_samples1);
+  RUN_TEST_CASE(TwoStageDecimator, frame_mics2_samples16);
+  RUN_TEST_CASE(TwoStageDecimator, frame_mics4_samples3);
+  RUN_TEST_CASE(TwoStageDecimator, frame_mics8_samples8);
+  RUN_TEST_CASE(TwoStageDecimator, fused_dcoe_mics1);
+  RUN_TEST_CASE(TwoStageDecimator, fused_dcoe_mics8);
+  RUN_TEST_CASE(TwoStageDecimator, latency);
+  RUN_TEST_CASE(TwoStageDecimator, full_scale);
+  RUN_TEST_CASE(TwoStageDecimator, prime_mics1);
+  RUN_TEST_CASE(TwoStageDecimator, prime_mics8);
+  RUN_TEST_CASE(TwoStageDecimator, state_mics2);
+  RUN_TEST_CASE(TwoStageDecimator, state_mics8);
+  RUN_TEST_CASE(TwoStageDecimator, stage1_lut_mics1);
+  RUN_TEST_CASE(TwoStageDecimator, stage1_lut_mics16);
+  RUN_TEST_CASE(TwoStageDecimator, s2_coef16_mics2);
+  RUN_TEST_CASE(TwoStageDecimator, s2_coef16_mics8);
+  RUN_TEST_CASE(TwoStageDecimator, stage1_output_mics1);
+  RUN_TEST_CASE(TwoStageDecimator, stage1_output_mics5);
+  RUN_TEST_CASE(TwoStageDecimator, swap_mics2);
+  RUN_TEST_CASE(TwoStageDecimator, swap_fade_s2_mics3);
+  RUN_TEST_CASE(TwoStageDecimator, swap_fade_s1_mics4);
+  RUN_TEST_CASE(TwoStageDecimator, active_subset_mics8);
+  RUN_TEST_CASE(TwoStageDecimator, active_change_mics8);
+}
+
+TEST_GROUP(TwoStageDecimator);
+TEST_SETUP(TwoStageDecimator) {}
+TEST_TEAR_DOWN(TwoStageDecimator) {}
+
+}
+
+
+// ProcessFrame() must give the same output as SAMPLE_COUNT calls to
+// ProcessBlock(), transposed into [MIC][SAMPLE] order.
+template <unsigned MICS, unsigned SAMPLE_COUNT>
+static
+void test_TwoStageDecimator_frame()
+{
+  using TDecimator = mic_array::TwoStageDecimator<MICS, STAGE2_DEC_FACTOR, 
+                                                  STAGE2_TAP_COUNT>;
+
+  srand(76823 * MICS + SAMPLE_COUNT);
+
+  constexpr unsigned FRAME_COUNT = 5;
+  constexpr unsigned FRAME_WORDS = SAMPLE_COUNT * STAGE2_DEC_FACTOR;
+
+  TDecimator dec_frame;
+  TDecimator dec_block;
+
+  dec_frame.Init(stage1_coef, stage2_coef, stage2_shr);
+  dec_block.Init(stage1_coef, stage2_coef, stage2_shr);
+
+  for(int f = 0; f < FRAME_COUNT; f++){
+
+    uint32_t pdm_frame[MICS][FRAME_WORDS];
+    for(int mic = 0; mic < MICS; mic++)
+      for(int k = 0; k < FRAME_WORDS; k++)
+        pdm_frame[mic][k] = (((uint32_t) rand()) << 16) ^ ((uint32_t) rand());
+
+    int32_t expected[MICS][SAMPLE_COUNT];
+    for(int s = 0; s < SAMPLE_COUNT; s++){
+      uint32_t pdm_block[MICS][STAGE2_DEC_FACTOR];
+      for(int mic = 0; mic < MICS; mic++)
+        for(int k = 0; k < STAGE2_DEC_FACTOR; k++)
+          pdm_block[mic][k] = pdm_frame[mic][s * STAGE2_DEC_FACTOR + k];
+
+      int32_t sample[MICS];
+      dec_block.ProcessBlock(sample, &pdm_block[0][0]);
+
+      for(int mic = 0; mic < MICS; mic++)
+        expected[mic][s] = sample[mic];
+    }
+
+    int32_t frame_out[MICS][SAMPLE_COUNT];
+    dec_frame.template ProcessFrame<SAMPLE_COUNT>(frame_out, &pdm_frame[0][0]);
+
+    TEST_ASSERT_EQUAL_INT32_ARRAY(&expected[0][0], &frame_out[0][0], 
+                                  MICS * SAMPLE_COUNT);
+  }
+}
+
+extern "C" {
+
+TEST(TwoStageDecimator, frame_mics1_samples1)  { test_TwoStageDecimator_frame<1,1>(); }
+TEST(TwoStageDecimator, frame_mics2_samples16) { test_TwoStageDecimator_frame<2,16>(); }
+TEST(TwoStageDecimator, frame_mics4_samples3)  { test_TwoStageDecimator_frame<4,3>(); }
+TEST(TwoStageDecimator, frame_mics8_samples8)  { test_TwoStageDecimator_frame<8,8>(); }
+
+}
+
+
+// A decimator with a DcoeSampleFilter inside must give the same output as a
+// plain decimator followed by the same DcoeSampleFilter, both from 
+// ProcessBlock() and from ProcessFrame().
+template <unsigned MICS>
+static
+void test_TwoStageDecimator_fused_dcoe()
+{
+  using TFilter = mic_array::DcoeSampleFilter<MICS>;
+  using TPlain = mic_array::TwoStageDecimator<MICS, STAGE2_DEC_FACTOR, 
+                                              STAGE2_TAP_COUNT>;
+  using TFused = mic_array::TwoStageDecimator<MICS, STAGE2_DEC_FACTOR, 
+                                              STAGE2_TAP_COUNT, TFilter>;
+
+  srand(1287 * MICS);
+
+  constexpr unsigned SAMPLE_COUNT = 4;
+  constexpr unsigned FRAME_COUNT = 5;
+
+  TPlain dec_plain;
+  TFilter filter;
+  TFused dec_block;
+  TFused dec_frame;
+
+  dec_plain.Init(stage1_coef, stage2_coef, stage2_shr);
+  filter.Init();
+  dec_block.Init(stage1_coef, stage2_coef, stage2_shr);
+  dec_frame.Init(stage1_coef, stage2_coef, stage2_shr);
+
+  for(int f = 0; f < FRAME_COUNT; f++){
+
+    uint32_t pdm_frame[MICS][SAMPLE_COUNT * STAGE2_DEC_FACTOR];
+    for(int mic = 0; mic < MICS; mic++)
+      for(int k = 0; k < SAMPLE_COUNT * STAGE2_DEC_FACTOR; k++)
+        pdm_frame[mic][k] = (((uint32_t) rand()) << 16) ^ ((uint32_t) rand());
+
+    int32_t expected[MICS][SAMPLE_COUNT];
+    for(int s = 0; s < SAMPLE_COUNT; s++){
+      uint32_t pdm_block[MICS][STAGE2_DEC_FACTOR];
+      for(int mic = 0; mic < MICS; mic++)
+        for(int k = 0; k < STAGE2_DEC_FACTOR; k++)
+          pdm_block[mic][k] = pdm_frame[mic][s * STAGE2_DEC_FACTOR + k];
+
+      int32_t sample[MICS];
+      dec_plain.ProcessBlock(sample, &pdm_block[0][0]);
+      filter.Filter(sample);
+
+      int32_t fused[MICS];
+      dec_block.ProcessBlock(fused, &pdm_block[0][0]);
+      TEST_ASSERT_EQUAL_INT32_ARRAY(sample, fused, MICS);
+
+      for(int mic = 0; mic < MICS; mic++)
+        expected[mic][s] = sample[mic];
+    }
+
+    int32_t frame_out[MICS][SAMPLE_COUNT];
+    dec_frame.template ProcessFrame<SAMPLE_COUNT>(frame_out, &pdm_frame[0][0]);
+
+    TEST_ASSERT_EQUAL_INT32_ARRAY(&expected[0][0], &frame_out[0][0], 
+                                  MICS * SAMPLE_COUNT);
+  }
+}
+
+extern "C" {
+
+TEST(TwoStageDecimator, fused_dcoe_mics1) { test_TwoStageDecimator_fused_dcoe<1>(); }
+TEST(TwoStageDecimator, fused_dcoe_mics8) { test_TwoStageDecimator_fused_dcoe<8>(); }
+
+}
+
+
+// An impulse Latency() PDM clock periods before the end of a block must give
+// the largest response in that block's output sample.
+extern "C" {
+
+TEST(TwoStageDecimator, latency)
+{
+  using TDecimator = mic_array::TwoStageDecimator<1, STAGE2_DEC_FACTOR, 
+                                                  STAGE2_TAP_COUNT>;
+
+  constexpr unsigned BLOCKS = 24;
+  constexpr unsigned PEAK_BLOCK = 16;
+  constexpr unsigned LATENCY = TDecimator::Latency(STAGE1_GROUP_DELAY, 
+                                                   STAGE2_GROUP_DELAY);
+  // Index of the impulse's PDM sample, counting from the first block
+  constexpr unsigned IMPULSE = (PEAK_BLOCK + 1) * TDecimator::SamplePeriod 
+                                - 1 - LATENCY;
+
+  TDecimator dec_ref;
+  TDecimator dec_imp;
+
+  dec_ref.Init(stage1_coef, stage2_coef, stage2_shr);
+  dec_imp.Init(stage1_coef, stage2_coef, stage2_shr);
+
+  unsigned peak = 0;
+  int64_t peak_mag = 0;
+
+  for(int b = 0; b < BLOCKS; b++){
+    // Alternating PDM samples filter to (almost) nothing.
+    uint32_t pdm_ref[STAGE2_DEC_FACTOR];
+    uint32_t pdm_imp[STAGE2_DEC_FACTOR];
+    for(int k = 0; k < STAGE2_DEC_FACTOR; k++){
+      pdm_ref[k] = pdm_imp[k] = 0x55555555;
+      if(b * STAGE2_DEC_FACTOR + k == IMPULSE / 32)
+        pdm_imp[k] ^= 1u << (IMPULSE % 32);
+    }
+
+    int32_t ref, imp;
+    dec_ref.ProcessBlock(&ref, pdm_ref);
+    dec_imp.ProcessBlock(&imp, pdm_imp);
+
+    const int64_t mag = llabs(((int64_t) imp) - ref);
+    if(mag > peak_mag){
+      peak = b;
+      peak_mag = mag;
+    }
+  }
+
+  TEST_ASSERT_EQUAL_UINT(PEAK_BLOCK, peak);
+}
+
+
+// A full scale PDM signal must settle at +/-FullScale, with the linear and
+// minimum phase filters alike.
+TEST(TwoStageDecimator, full_scale)
+{
+  using TDecimator = mic_array::TwoStageDecimator<1, STAGE2_DEC_FACTOR, 
+                                                  STAGE2_TAP_COUNT>;
+
+  static TDecimator dec_lin, dec_min;
+  dec_lin.Init(stage1_coef, stage2_coef, stage2_shr);
+  dec_min.Init(stage1_coef_min_phase, stage2_coef_min_phase, 
+               stage2_shr_min_phase);
+
+  for(int v = 0; v < 2; v++){
+    uint32_t pdm[STAGE2_DEC_FACTOR];
+    for(int k = 0; k < STAGE2_DEC_FACTOR; k++)
+      pdm[k] = v? 0xFFFFFFFF : 0;
+
+    int32_t lin, min;
+    for(int b = 0; b < 64; b++){
+      dec_lin.ProcessBlock(&lin, pdm);
+      dec_min.ProcessBlock(&min, pdm);
+    }
+
+    const int32_t expected = v? -TDecimator::FullScale : TDecimator::FullScale;
+    TEST_ASSERT_INT32_WITHIN(16, expected, lin);
+    TEST_ASSERT_INT32_WITHIN(16, expected, min);
+  }
+}
+
+}
+
+
+// Priming from a block must put the decimator straight into the steady state
+// it would reach if the block's oldest word were repeated indefinitely.
+template <unsigned MICS>
+static
+void test_TwoStageDecimator_prime()
+{
+  using TDecimator = mic_array::TwoStageDecimator<MICS, STAGE2_DEC_FACTOR, 
+                                                  STAGE2_TAP_COUNT>;
+
+  srand(3461 * MICS);
+
+  // Enough blocks to flush both stages' histories.
+  constexpr unsigned SETTLE_BLOCKS = STAGE2_TAP_COUNT / STAGE2_DEC_FACTOR + 4;
+
+  uint32_t word[MICS];
+  for(int mic = 0; mic < MICS; mic++)
+    word[mic] = (((uint32_t) rand()) << 16) ^ ((uint32_t) rand());
+
+  uint32_t pdm_block[MICS][STAGE2_DEC_FACTOR];
+  for(int mic = 0; mic < MICS; mic++)
+    for(int k = 0; k < STAGE2_DEC_FACTOR; k++)
+      pdm_block[mic][k] = word[mic];
+
+  TDecimator dec_settled;
+  TDecimator dec_primed;
+
+  dec_settled.Init(stage1_coef, stage2_coef, stage2_shr);
+  dec_primed.Init(stage1_coef, stage2_coef, stage2_shr);
+
+  int32_t expected[MICS];
+  for(int b = 0; b < SETTLE_BLOCKS; b++)
+    dec_settled.ProcessBlock(expected, &pdm_block[0][0]);
+
+  dec_primed.Prime(&pdm_block[0][0]);
+
+  // Priming must not modify the block
+  for(int mic = 0; mic < MICS; mic++)
+    for(int k = 0; k < STAGE2_DEC_FACTOR; k++)
+      TEST_ASSERT_EQUAL_UINT32(word[mic], pdm_block[mic][k]);
+
+  int32_t sample[MICS];
+  dec_primed.ProcessBlock(sample, &pdm_block[0][0]);
+
+  TEST_ASSERT_EQUAL_INT32_ARRAY(expected, sample, MICS);
+}
+
+extern "C" {
+
+TEST(TwoStageDecimator, prime_mics1) { test_TwoStageDecimator_prime<1>(); }
+TEST(TwoStageDecimator, prime_mics8) { test_TwoStageDecimator_prime<8>(); }
+
+}
+
+
+// A decimator which has loaded another's saved state must give the same
+// output as the other from then on.
+template <unsigned MICS>
+static
+void test_TwoStageDecimator_state()
+{
+  using TDecimator = mic_array::TwoStageDecimator<MICS, STAGE2_DEC_FACTOR, 
+                                                  STAGE2_TAP_COUNT>;
+
+  srand(9127 * MICS);
+
+  constexpr unsigned BLOCKS = 30;
+  constexpr unsigned SAVE_BLOCK = 17;
+
+  TDecimator dec_ref;
+  TDecimator dec_loaded;
+  typename TDecimator::State state;
+
+  dec_ref.Init(stage1_coef, stage2_coef, stage2_shr);
+  dec_loaded.Init(stage1_coef, stage2_coef, stage2_shr);
+
+  for(int b = 0; b < BLOCKS; b++){
+    uint32_t pdm_block[MICS][STAGE2_DEC_FACTOR];
+    for(int mic = 0; mic < MICS; mic++)
+      for(int k = 0; k < STAGE2_DEC_FACTOR; k++)
+        pdm_block[mic][k] = (((uint32_t) rand()) << 16) ^ ((uint32_t) rand());
+
+    int32_t expected[MICS];
+    dec_ref.ProcessBlock(expected, &pdm_block[0][0]);
+
+    if(b == SAVE_BLOCK){
+      dec_ref.SaveState(state);
+      dec_loaded.LoadState(state);
+    } else if(b > SAVE_BLOCK) {
+      int32_t sample[MICS];
+      dec_loaded.ProcessBlock(sample, &pdm_block[0][0]);
+      TEST_ASSERT_EQUAL_INT32_ARRAY(expected, sample, MICS);
+    }
+  }
+}
+
+extern "C" {
+
+TEST(TwoStageDecimator, state_mics2) { test_TwoStageDecimator_state<2>(); }
+TEST(TwoStageDecimator, state_mics8) { test_TwoStageDecimator_state<8>(); }
+
+}
+
+
+// With S1_COEF_BITS of STAGE1_LUT and a table built from stage1_coef, the
+// output must be identical to that of the default decimator.
+template <unsigned MICS>
+static
+void test_TwoStageDecimator_stage1_lut()
+{
+  using TDecimator = mic_array::TwoStageDecimator<MICS, STAGE2_DEC_FACTOR, 
+                                                  STAGE2_TAP_COUNT>;
+  using TLutDecimator = mic_array::TwoStageDecimator<MICS, STAGE2_DEC_FACTOR,
+                                  STAGE2_TAP_COUNT, 
+                                  mic_array::NopSampleFilter<MICS>,
+                                  mic_array::STAGE1_LUT>;
+
+  static_assert(TLutDecimator::Stage1CoefWords == FIR_1X16_BIT_LUT_WORDS, "");
+
+  srand(58813 * MICS);
+
+  static uint32_t stage1_lut[FIR_1X16_BIT_LUT_WORDS];
+  fir_1x16_bit_lut_init(stage1_lut, stage1_coef, 16);
+
+  TDecimator* dec = new TDecimator();
+  TLutDecimator* dec_lut = new TLutDecimator();
+
+  dec->Init(stage1_coef, stage2_coef, stage2_shr);
+  dec_lut->Init(stage1_lut, stage2_coef, stage2_shr);
+
+  for(int b = 0; b < 100; b++){
+    uint32_t pdm_block[MICS * STAGE2_DEC_FACTOR];
+    for(int k = 0; k < MICS * STAGE2_DEC_FACTOR; k++)
+      pdm_block[k] = (((uint32_t) rand()) << 16) ^ ((uint32_t) rand());
+
+    int32_t expected[MICS];
+    int32_t result[MICS];
+    dec->ProcessBlock(expected, pdm_block);
+    dec_lut->ProcessBlock(result, pdm_block);
+
+    TEST_ASSERT_EQUAL_INT32_ARRAY(expected, result, MICS);
+  }
+
+  delete dec;
+  delete dec_lut;
+}
+
+extern "C" {
+
+TEST(TwoStageDecimator, stage1_lut_mics1)  { test_TwoStageDecimator_stage1_lut<1>(); }
+TEST(TwoStageDecimator, stage1_lut_mics16) { test_TwoStageDecimator_stage1_lut<16>(); }
+
+}
+
+
+
+// With S2_COEF_BITS of 16 and stage2_coef_s16, the output must stay close to
+// that of the default decimator, the difference being the rounding of the
+// coefficients and of the stage 2 history to 16 bits.
+template <unsigned MICS>
+static
+void test_TwoStageDecimator_s2_coef16()
+{
+  using TDecimator = mic_array::TwoStageDecimator<MICS, STAGE2_DEC_FACTOR, 
+                                                  STAGE2_TAP_COUNT>;
+  using TDecimator16 = mic_array::TwoStageDecimator<MICS, STAGE2_DEC_FACTOR,
+                                  STAGE2_TAP_COUNT, 
+                                  mic_array::NopSampleFilter<MICS>, 16,
+                                  mic_array::NopOutputHandler<MICS>, 16>;
+
+  static_assert(std::is_same<typename TDecimator16::Stage2Coef, 
+                             int16_t>::value, "");
+  static_assert(sizeof(typename TDecimator16::State) 
+                  < sizeof(typename TDecimator::State), "");
+
+  srand(60317 * MICS);
+
+  TDecimator* dec = new TDecimator();
+  TDecimator16* dec16 = new TDecimator16();
+
+  dec->Init(stage1_coef, stage2_coef, stage2_shr);
+  dec16->Init(stage1_coef, stage2_coef_s16, stage2_shr_s16);
+
+  for(int b = 0; b < 100; b++){
+    uint32_t pdm_block[MICS * STAGE2_DEC_FACTOR];
+    for(int k = 0; k < MICS * STAGE2_DEC_FACTOR; k++)
+      pdm_block[k] = (((uint32_t) rand()) << 16) ^ ((uint32_t) rand());
+
+    int32_t expected[MICS];
+    int32_t result[MICS];
+    dec->ProcessBlock(expected, pdm_block);
+    dec16->ProcessBlock(result, pdm_block);
+
+    for(int mic = 0; mic < MICS; mic++)
+      TEST_ASSERT_INT32_WITHIN(1 << 18, expected[mic], result[mic]);
+  }
+
+  delete dec;
+  delete dec16;
+}
+
+extern "C" {
+
+TEST(TwoStageDecimator, s2_coef16_mics2) { test_TwoStageDecimator_s2_coef16<2>(); }
+TEST(TwoStageDecimator, s2_coef16_mics8) { test_TwoStageDecimator_s2_coef16<8>(); }
+
+}
+
+
+// Records the samples given to a TwoStageDecimator's Stage1Output.
+template <unsigned MICS, unsigned CAPACITY>
+struct Stage1Recorder {
+  int32_t samples[CAPACITY][MICS];
+  unsigned count = 0;
+
+  void OutputSample(int32_t sample[MICS])
+  {
+    assert(count < CAPACITY);
+    memcpy(samples[count++], sample, sizeof(samples[0]));
+  }
+};
+
+// Stage1Output must receive each stage 1 sample, i.e. fir_1x16_bit() of each
+// mic's 8 newest PDM words, once per word, and the decimator's own output
+// must be unchanged.
+template <unsigned MICS>
+static
+void test_TwoStageDecimator_stage1_output()
+{
+  constexpr unsigned BLOCKS = 30;
+
+  using TRecorder = Stage1Recorder<MICS, BLOCKS * STAGE2_DEC_FACTOR>;
+  using TDecimator = mic_array::TwoStageDecimator<MICS, STAGE2_DEC_FACTOR, 
+                                                  STAGE2_TAP_COUNT>;
+  using TTapDecimator = mic_array::TwoStageDecimator<MICS, STAGE2_DEC_FACTOR,
+                                  STAGE2_TAP_COUNT, 
+                                  mic_array::NopSampleFilter<MICS>, 16,
+                                  TRecorder>;
+
+  srand(59021 * MICS);
+
+  TDecimator* dec = new TDecimator();
+  TTapDecimator* dec_tap = new TTapDecimator();
+
+  dec->Init(stage1_coef, stage2_coef, stage2_shr);
+  dec_tap->Init(stage1_coef, stage2_coef, stage2_shr);
+
+  uint32_t history[MICS][8];
+  for(int mic = 0; mic < MICS; mic++)
+    for(int k = 0; k < 8; k++)
+      history[mic][k] = 0x55555555;
+
+  for(int b = 0; b < BLOCKS; b++){
+    uint32_t pdm_block[MICS][STAGE2_DEC_FACTOR];
+    for(int mic = 0; mic < MICS; mic++)
+      for(int k = 0; k < STAGE2_DEC_FACTOR; k++)
+        pdm_block[mic][k] = (((uint32_t) rand()) << 16) ^ ((uint32_t) rand());
+
+    int32_t expected[MICS];
+    int32_t result[MICS];
+    dec->ProcessBlock(expected, &pdm_block[0][0]);
+    dec_tap->ProcessBlock(result, &pdm_block[0][0]);
+
+    TEST_ASSERT_EQUAL_INT32_ARRAY(expected, result, MICS);
+    TEST_ASSERT_EQUAL_UINT((b + 1) * STAGE2_DEC_FACTOR, 
+                           dec_tap->Stage1Output.count);
+
+    for(int k = 0; k < STAGE2_DEC_FACTOR; k++){
+      for(int mic = 0; mic < MICS; mic++){
+        memmove(&history[mic][1], &history[mic][0], 7 * sizeof(uint32_t));
+        history[mic][0] = pdm_block[mic][k];
+        TEST_ASSERT_EQUAL_INT32(fir_1x16_bit(history[mic], stage1_coef),
+            dec_tap->Stage1Output.samples[b * STAGE2_DEC_FACTOR + k][mic]);
+      }
+    }
+  }
+
+  delete dec;
+  delete dec_tap;
+}
+
+extern "C" {
+
+TEST(TwoStageDecimator, stage1_output_mics1) { test_TwoStageDecimator_stage1_output<1>(); }
+TEST(TwoStageDecimator, stage1_output_mics5) { test_TwoStageDecimator_stage1_output<5>(); }
+
+}
+
+
+// SwapCoefficients() must switch coefficients at the next block, keeping the
+// filters' state, as Init() does between blocks.
+template <unsigned MICS>
+static
+void test_TwoStageDecimator_swap()
+{
+  using TDecimator = mic_array::TwoStageDecimator<MICS, STAGE2_DEC_FACTOR, 
+                                                  STAGE2_TAP_COUNT>;
+
+  srand(5531 * MICS);
+
+  constexpr unsigned BLOCKS = 40;
+  constexpr unsigned SWAP_BLOCK = 13;
+
+  TDecimator dec_ref;
+  TDecimator dec_swap;
+
+  dec_ref.Init(stage1_coef, stage2_coef, stage2_shr);
+  dec_swap.Init(stage1_coef, stage2_coef, stage2_shr);
+
+  for(int b = 0; b < BLOCKS; b++){
+    uint32_t pdm_block[MICS][STAGE2_DEC_FACTOR];
+    for(int mic = 0; mic < MICS; mic++)
+      for(int k = 0; k < STAGE2_DEC_FACTOR; k++)
+        pdm_block[mic][k] = (((uint32_t) rand()) << 16) ^ ((uint32_t) rand());
+
+    if(b == SWAP_BLOCK){
+      TEST_ASSERT_TRUE(dec_swap.SwapCoefficients(stage1_coef_min_phase,
+                                                 stage2_coef_min_phase,
+                                                 stage2_shr_min_phase));
+      TEST_ASSERT_TRUE(dec_swap.SwapPending());
+      // Only one swap may be outstanding.
+      TEST_ASSERT_FALSE(dec_swap.SwapCoefficients(stage1_coef, stage2_coef,
+                                                  stage2_shr));
+      dec_ref.Init(stage1_coef_min_phase, stage2_coef_min_phase, 
+                   stage2_shr_min_phase);
+    }
+
+    int32_t expected[MICS];
+    int32_t sample[MICS];
+    dec_ref.ProcessBlock(expected, &pdm_block[0][0]);
+    dec_swap.ProcessBlock(sample, &pdm_block[0][0]);
+
+    TEST_ASSERT_FALSE(dec_swap.SwapPending());
+    TEST_ASSERT_EQUAL_INT32_ARRAY(expected, sample, MICS);
+  }
+}
+
+
+// With a crossfade of the stage 2 coefficients only, each output during the
+// crossfade must be the mix of the outputs of the old and new filters.
+template <unsigned MICS>
+static
+void test_TwoStageDecimator_swap_fade_s2()
+{
+  using TDecimator = mic_array::TwoStageDecimator<MICS, STAGE2_DEC_FACTOR, 
+                                                  STAGE2_TAP_COUNT>;
+
+  srand(3301 * MICS);
+
+  constexpr unsigned BLOCKS = 40;
+  constexpr unsigned SWAP_BLOCK = 11;
+  constexpr unsigned FADE = 7;
+
+  TDecimator dec_old;
+  TDecimator dec_new;
+  TDecimator dec_fade;
+
+  dec_old.Init(stage1_coef, stage2_coef, stage2_shr);
+  dec_new.Init(stage1_coef, stage2_coef, stage2_shr);
+  dec_fade.Init(stage1_coef, stage2_coef, stage2_shr);
+
+  for(int b = 0; b < BLOCKS; b++){
+    uint32_t pdm_block[MICS][STAGE2_DEC_FACTOR];
+    for(int mic = 0; mic < MICS; mic++)
+      for(int k = 0; k < STAGE2_DEC_FACTOR; k++)
+        pdm_block[mic][k] = (((uint32_t) rand()) << 16) ^ ((uint32_t) rand());
+
+    if(b == SWAP_BLOCK){
+      TEST_ASSERT_TRUE(dec_fade.SwapCoefficients(nullptr, 
+                                                 stage2_coef_min_phase,
+                                                 stage2_shr_min_phase, FADE));
+      dec_new.Init(stage1_coef, stage2_coef_min_phase, stage2_shr_min_phase);
+    }
+
+    int32_t old_sample[MICS];
+    int32_t new_sample[MICS];
+    int32_t sample[MICS];
+    dec_old.ProcessBlock(old_sample, &pdm_block[0][0]);
+    dec_new.ProcessBlock(new_sample, &pdm_block[0][0]);
+    dec_fade.ProcessBlock(sample, &pdm_block[0][0]);
+
+    const unsigned step = b - SWAP_BLOCK + 1;
+    for(int mic = 0; mic < MICS; mic++){
+      if(b >= SWAP_BLOCK && step <= FADE){
+        TEST_ASSERT_EQUAL_INT32(
+            mic_array::crossfade_sample(old_sample[mic], new_sample[mic], 
+                                        step, FADE),
+            sample[mic]);
+      } else {
+        TEST_ASSERT_EQUAL_INT32(new_sample[mic], sample[mic]);
+      }
+    }
+  }
+}
+
+
+// After a crossfade of the stage 1 coefficients, once the stage 2 history
+// holds only outputs of the new stage 1 filter, the output must be that of
+// the new coefficients.
+template <unsigned MICS>
+static
+void test_TwoStageDecimator_swap_fade_s1()
+{
+  using TDecimator = mic_array::TwoStageDecimator<MICS, STAGE2_DEC_FACTOR, 
+                                                  STAGE2_TAP_COUNT>;
+
+  srand(7717 * MICS);
+
+  constexpr unsigned SWAP_BLOCK = 5;
+  constexpr unsigned FADE = 10;
+  constexpr unsigned SETTLED = SWAP_BLOCK + FADE 
+                      + (STAGE2_TAP_COUNT + STAGE2_DEC_FACTOR - 1) 
+                          / STAGE2_DEC_FACTOR;
+  constexpr unsigned BLOCKS = SETTLED + 10;
+
+  TDecimator dec_new;
+  TDecimator dec_fade;
+
+  dec_new.Init(stage1_coef, stage2_coef, stage2_shr);
+  dec_fade.Init(stage1_coef, stage2_coef, stage2_shr);
+
+  for(int b = 0; b < BLOCKS; b++){
+    uint32_t pdm_block[MICS][STAGE2_DEC_FACTOR];
+    for(int mic = 0; mic < MICS; mic++)
+      for(int k = 0; k < STAGE2_DEC_FACTOR; k++)
+        pdm_block[mic][k] = (((uint32_t) rand()) << 16) ^ ((uint32_t) rand());
+
+    if(b == SWAP_BLOCK){
+      TEST_ASSERT_TRUE(dec_fade.SwapCoefficients(stage1_coef_min_phase, 
+                                                 nullptr, 0, FADE));
+      dec_new.Init(stage1_coef_min_phase, stage2_coef, stage2_shr);
+    }
+
+    int32_t expected[MICS];
+    int32_t sample[MICS];
+    dec_new.ProcessBlock(expected, &pdm_block[0][0]);
+    dec_fade.ProcessBlock(sample, &pdm_block[0][0]);
+
+    if(b < SWAP_BLOCK || b >= SETTLED)
+      TEST_ASSERT_EQUAL_INT32_ARRAY(expected, sample, MICS);
+  }
+}
+
+extern "C" {
+
+TEST(TwoStageDecimator, swap_mics2) { test_TwoStageDecimator_swap<2>(); }
+TEST(TwoStageDecimator, swap_fade_s2_mics3) { test_TwoStageDecimator_swap_fade_s2<3>(); }
+TEST(TwoStageDecimator, swap_fade_s1_mics4) { test_TwoStageDecimator_swap_fade_s1<4>(); }
+
+}
+
+
+// With only some microphones active, those must give the same output as with
+// all of them active, and the others zeros.
+template <unsigned MICS>
+static
+void test_TwoStageDecimator_active_subset(const uint32_t mask)
+{
+  using TDecimator = mic_array::TwoStageDecimator<MICS, STAGE2_DEC_FACTOR, 
+                                                  STAGE2_TAP_COUNT>;
+
+  srand(5923 * MICS + mask);
+
+  constexpr unsigned BLOCKS = 30;
+
+  TDecimator dec_all;
+  TDecimator dec_subset;
+
+  dec_all.Init(stage1_coef, stage2_coef, stage2_shr);
+  dec_subset.Init(stage1_coef, stage2_coef, stage2_shr);
+
+  TEST_ASSERT_EQUAL_UINT32(TDecimator::AllChannels, dec_subset.ActiveChannels());
+
+  // Bits past the last microphone are ignored.
+  dec_subset.SetActiveChannels(mask | ~TDecimator::AllChannels);
+  TEST_ASSERT_EQUAL_UINT32(mask, dec_subset.ActiveChannels());
+
+  for(int b = 0; b < BLOCKS; b++){
+    uint32_t pdm_block[MICS][STAGE2_DEC_FACTOR];
+    for(int mic = 0; mic < MICS; mic++)
+      for(int k = 0; k < STAGE2_DEC_FACTOR; k++)
+        pdm_block[mic][k] = (((uint32_t) rand()) << 16) ^ ((uint32_t) rand());
+
+    int32_t expected[MICS];
+    dec_all.ProcessBlock(expected, &pdm_block[0][0]);
+
+    for(int mic = 0; mic < MICS; mic++)
+      if(!((mask >> mic) & 1))
+        expected[mic] = 0;
+
+    int32_t sample[MICS];
+    dec_subset.ProcessBlock(sample, &pdm_block[0][0]);
+
+    TEST_ASSERT_EQUAL_INT32_ARRAY(expected, sample, MICS);
+  }
+}
+
+extern "C" {
+
+TEST(TwoStageDecimator, active_subset_mics8) 
+{ 
+  test_TwoStageDecimator_active_subset<8>(0x5A);
+}
+
+}
+
+
+// As the active microphones change, those which stay active must carry on
+// as if nothing had changed, and those switched back on must carry on as if
+// the decimator had been primed from the block in which they were.
+template <unsigned MICS>
+static
+void test_TwoStageDecimator_active_change()
+{
+  using TDecimator = mic_array::TwoStageDecimator<MICS, STAGE2_DEC_FACTOR, 
+                                                  STAGE2_TAP_COUNT>;
+
+  srand(2731 * MICS);
+
+  constexpr unsigned BLOCKS_PER_MASK = 12;
+  const uint32_t masks[] = { TDecimator::AllChannels, 0x5A, 0xD1, 0x00, 
+                             0x2C, TDecimator::AllChannels };
+  constexpr unsigned MASKS = sizeof(masks) / sizeof(masks[0]);
+
+  // ref[0] never changes, ref[m] is primed when masks[m] is set.
+  static TDecimator ref[MASKS];
+  TDecimator dec;
+
+  dec.Init(stage1_coef, stage2_coef, stage2_shr);
+  for(int m = 0; m < MASKS; m++)
+    ref[m].Init(stage1_coef, stage2_coef, stage2_shr);
+
+  // Reference decimator whose output each microphone should match.
+  unsigned source[MICS] = {0};
+
+  for(int m = 0; m < MASKS; m++){
+    dec.SetActiveChannels(masks[m]);
+
+    for(int b = 0; b < BLOCKS_PER_MASK; b++){
+      uint32_t pdm_block[MICS][STAGE2_DEC_FACTOR];
+      for(int mic = 0; mic < MICS; mic++)
+        for(int k = 0; k < STAGE2_DEC_FACTOR; k++)
+          pdm_block[mic][k] = (((uint32_t) rand()) << 16) ^ ((uint32_t) rand());
+
+      if(m > 0 && b == 0){
+        ref[m].Prime(&pdm_block[0][0]);
+        for(int mic = 0; mic < MICS; mic++)
+          if(((masks[m] & ~masks[m-1]) >> mic) & 1)
+            source[mic] = m;
+      }
+
+      int32_t ref_sample[MASKS][MICS];
+      for(int r = 0; r <= m; r++)
+        ref[r].ProcessBlock(ref_sample[r], &pdm_block[0][0]);
+
+      int32_t expected[MICS];
+      for(int mic = 0; mic < MICS; mic++)
+        expected[mic] = ((masks[m] >> mic) & 1)? ref_sample[source[mic]][mic] : 0;
+
+      int32_t sample[MICS];
+      dec.ProcessBlock(sample, &pdm_block[0][0]);
+
+      TEST_ASSERT_EQUAL_INT32_ARRAY(expected, sample, MICS);
+    }
+  }
+}
+
+extern "C" {
+
+TEST(TwoStageDecimator, active_change_mics8) 
+{ 
+  test_TwoStageDecimator_active_change<8>(); 
+}
+
+}
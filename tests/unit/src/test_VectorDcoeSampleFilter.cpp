@@ -0,0 +1,192 @@
+// Copyright 2020-2024 XMOS LIMITED.
+// This Software is subject to the terms of the XMOS Public Licence: Version 1.
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <assert.h>
+#include <stdarg.h>
+
+#include "unity_fixture.h"
+
+#include "mic_array/dc_elimination.h"
+#include "mic_array/cpp/SampleFilter.hpp"
+
+extern "C" {
+
+TEST_GROUP_RUNNER(VectorDcoeSampleFilter) {
+  RUN_TEST_CASE(VectorDcoeSampleFilter, states1);
+  RUN_TEST_CASE(VectorDcoeSampleFilter, states5);
+  RUN_TEST_CASE(VectorDcoeSampleFilter, states8);
+  RUN_TEST_CASE(VectorDcoeSampleFilter, states13);
+  RUN_TEST_CASE(VectorDcoeSampleFilter, states16);
+  RUN_TEST_CASE(VectorDcoeSampleFilter, states5_shr1);
+  RUN_TEST_CASE(VectorDcoeSampleFilter, states13_shr10);
+  RUN_TEST_CASE(VectorDcoeSampleFilter, block3x4);
+  RUN_TEST_CASE(VectorDcoeSampleFilter, block16x6);
+  RUN_TEST_CASE(VectorDcoeSampleFilter, frame3x4);
+  RUN_TEST_CASE(VectorDcoeSampleFilter, frame16x16);
+  RUN_TEST_CASE(VectorDcoeSampleFilter, removes_dc);
+}
+
+TEST_GROUP(VectorDcoeSampleFilter);
+TEST_SETUP(VectorDcoeSampleFilter) {}
+TEST_TEAR_DOWN(VectorDcoeSampleFilter) {}
+
+}
+
+static int32_t ref_sat(int64_t a)
+{
+  return (a > INT32_MAX)? INT32_MAX : (a < -INT32_MAX)? -INT32_MAX : a;
+}
+
+// Reference for one channel: y = sat(x + w); w = sat(y - (y >> shr) - x)
+static int32_t ref_dcoe(int32_t& w, int32_t x, unsigned shr)
+{
+  const int32_t y = ref_sat((int64_t) x + w);
+  w = ref_sat((int64_t) y - (y >> shr) - x);
+  return y;
+}
+
+static int32_t rand_sample()
+{
+  // Full scale, with the occasional extreme value to exercise saturation
+  switch(rand() & 0xF){
+    case 0:  return INT32_MAX;
+    case 1:  return INT32_MIN + 1;
+    default: return (int32_t) ((uint32_t(rand()) << 17) ^ rand());
+  }
+}
+
+
+// Filter() must match the reference, with channels past the last batch of 8
+// (and the sample buffer's neighbours) left untouched.
+template <unsigned CHANS, unsigned ITER_COUNT, 
+          unsigned POLE_SHR = DCOE_DEFAULT_POLE_SHR>
+static
+void test_VectorDcoeSampleFilter()
+{
+  srand(456123 + CHANS);
+
+  mic_array::VectorDcoeSampleFilter<CHANS,POLE_SHR> filter;
+  int32_t ref_state[CHANS];
+
+  filter.Init();
+  memset(ref_state, 0, sizeof(ref_state));
+
+  for(int r = 0; r < ITER_COUNT; r++){
+    int32_t buff[CHANS + 8];
+    int32_t expected[CHANS + 8];
+
+    for(int k = 0; k < CHANS + 8; k++)
+      expected[k] = buff[k] = rand_sample();
+
+    for(int k = 0; k < CHANS; k++)
+      expected[k] = ref_dcoe(ref_state[k], buff[k], POLE_SHR);
+
+    filter.Filter(buff);
+
+    TEST_ASSERT_EQUAL_INT32_ARRAY(expected, buff, CHANS + 8);
+  }
+}
+
+extern "C" {
+TEST(VectorDcoeSampleFilter, states1)  { test_VectorDcoeSampleFilter<1,1000>();  }
+TEST(VectorDcoeSampleFilter, states5)  { test_VectorDcoeSampleFilter<5,1000>();  }
+TEST(VectorDcoeSampleFilter, states8)  { test_VectorDcoeSampleFilter<8,1000>();  }
+TEST(VectorDcoeSampleFilter, states13) { test_VectorDcoeSampleFilter<13,1000>(); }
+TEST(VectorDcoeSampleFilter, states16) { test_VectorDcoeSampleFilter<16,1000>(); }
+TEST(VectorDcoeSampleFilter, states5_shr1)   { test_VectorDcoeSampleFilter<5,1000,1>();   }
+TEST(VectorDcoeSampleFilter, states13_shr10) { test_VectorDcoeSampleFilter<13,1000,10>(); }
+}
+
+
+// FilterSamples() and FilterFrame() must give the same result as Filter() on
+// each sample.
+template <unsigned CHANS, unsigned SAMPLES, unsigned ITER_COUNT>
+static
+void test_VectorDcoeSampleFilter_block()
+{
+  srand(981237 + 17*CHANS + SAMPLES);
+
+  mic_array::VectorDcoeSampleFilter<CHANS> exp_filter;
+  mic_array::VectorDcoeSampleFilter<CHANS> filter;
+  exp_filter.Init();
+  filter.Init();
+
+  for(int r = 0; r < ITER_COUNT; r++){
+    int32_t samples[SAMPLES][CHANS];
+    int32_t expected[SAMPLES][CHANS];
+
+    for(int s = 0; s < SAMPLES; s++){
+      for(int k = 0; k < CHANS; k++)
+        expected[s][k] = samples[s][k] = rand_sample();
+      exp_filter.Filter(expected[s]);
+    }
+
+    filter.FilterSamples(samples);
+
+    TEST_ASSERT_EQUAL_INT32_ARRAY(&expected[0][0], &samples[0][0], CHANS*SAMPLES);
+  }
+}
+
+template <unsigned CHANS, unsigned SAMPLES, unsigned ITER_COUNT>
+static
+void test_VectorDcoeSampleFilter_frame()
+{
+  srand(33121 + 17*CHANS + SAMPLES);
+
+  mic_array::VectorDcoeSampleFilter<CHANS> exp_filter;
+  mic_array::VectorDcoeSampleFilter<CHANS> filter;
+  exp_filter.Init();
+  filter.Init();
+
+  for(int r = 0; r < ITER_COUNT; r++){
+    int32_t frame[CHANS][SAMPLES];
+    int32_t expected[SAMPLES][CHANS];
+
+    for(int s = 0; s < SAMPLES; s++){
+      for(int k = 0; k < CHANS; k++)
+        expected[s][k] = frame[k][s] = rand_sample();
+      exp_filter.Filter(expected[s]);
+    }
+
+    filter.FilterFrame(frame);
+
+    for(int s = 0; s < SAMPLES; s++)
+      for(int k = 0; k < CHANS; k++)
+        TEST_ASSERT_EQUAL_INT32(expected[s][k], frame[k][s]);
+  }
+}
+
+extern "C" {
+TEST(VectorDcoeSampleFilter, block3x4)   { test_VectorDcoeSampleFilter_block<3,4,300>();   }
+TEST(VectorDcoeSampleFilter, block16x6)  { test_VectorDcoeSampleFilter_block<16,6,300>();  }
+TEST(VectorDcoeSampleFilter, frame3x4)   { test_VectorDcoeSampleFilter_frame<3,4,300>();   }
+TEST(VectorDcoeSampleFilter, frame16x16) { test_VectorDcoeSampleFilter_frame<16,16,100>(); }
+
+TEST(VectorDcoeSampleFilter, removes_dc)
+{
+  constexpr unsigned CHANS = 9;
+  constexpr unsigned SAMPLES = 16;
+
+  mic_array::VectorDcoeSampleFilter<CHANS> filter;
+  filter.Init();
+
+  int32_t samples[SAMPLES][CHANS];
+
+  // After 4000 samples (far beyond the filter's time constant of 64 
+  // samples) only the truncation residue may remain.
+  for(int r = 0; r < 250; r++){
+    for(int s = 0; s < SAMPLES; s++)
+      for(int k = 0; k < CHANS; k++)
+        samples[s][k] = (k & 1)? 0x20000000 : -0x30000000 + k;
+    filter.FilterSamples(samples);
+  }
+
+  for(int k = 0; k < CHANS; k++){
+    TEST_ASSERT_INT32_WITHIN(64, 0, samples[SAMPLES-1][k]);
+  }
+}
+}
@@ -12,11 +12,17 @@
 
 #include "mic_array/util.h"
 
+#include <xcore/hwtimer.h>
+
 #define CHAN_COUNT    16
 
 TEST_GROUP_RUNNER(deinterleave16) {
   RUN_TEST_CASE(deinterleave16, case0);
   RUN_TEST_CASE(deinterleave16, case1);
+  RUN_TEST_CASE(deinterleave16, block);
+  RUN_TEST_CASE(deinterleave16, benchmark);
+  RUN_TEST_CASE(deinterleave16, ddr);
+  RUN_TEST_CASE(deinterleave16, ddr_benchmark);
 }
 
 TEST_GROUP(deinterleave16);
@@ -118,3 +124,142 @@ TEST(deinterleave16, case1)
   }
 }
 
+#define MAX_SUBBLOCKS   8
+
+// Must be the same as calling deinterleave16() on each subblock in turn.
+TEST(deinterleave16, block)
+{
+  srand(0x166E1B);
+
+  uint64_t buff_expected[MAX_SUBBLOCKS * CHAN_COUNT / 2 + 1];
+  uint64_t buff_test_vect[MAX_SUBBLOCKS * CHAN_COUNT / 2 + 1];
+  uint32_t* expected = (uint32_t*) &buff_expected[0];
+  uint32_t* test_vect = (uint32_t*) &buff_test_vect[0];
+
+  const unsigned LOOP_COUNT = 400;
+
+  for(int rep = 0; rep < LOOP_COUNT; rep++){
+
+    const unsigned subblocks = 1 + (rand() % MAX_SUBBLOCKS);
+    const unsigned words = subblocks * CHAN_COUNT;
+
+    for(int k = 0; k < words; k++)
+      expected[k] = test_vect[k] = rand();
+    // Guard word past the end
+    test_vect[words] = expected[words] = 0x5A5A5A5A;
+
+    for(int sb = 0; sb < subblocks; sb++)
+      deinterleave16(&expected[sb * CHAN_COUNT]);
+
+    deinterleave16_block(&test_vect[0], subblocks);
+
+    TEST_ASSERT_EQUAL_UINT32_ARRAY(expected, test_vect, words + 1);
+  }
+
+  // No subblocks is a no-op.
+  test_vect[0] = 0x12345678;
+  deinterleave16_block(&test_vect[0], 0);
+  TEST_ASSERT_EQUAL_HEX32(0x12345678, test_vect[0]);
+}
+
+
+// Times deinterleave16_block() against a deinterleave16() call per subblock,
+// as deinterleave_pdm_samples<16>() used to make, over a 6-subblock block
+// (decimation factor 192).
+TEST(deinterleave16, benchmark)
+{
+  const unsigned subblocks = 6;
+  const unsigned REPS = 100;
+
+  uint64_t buff[MAX_SUBBLOCKS * CHAN_COUNT / 2];
+  uint32_t* block = (uint32_t*) &buff[0];
+  for(int k = 0; k < subblocks * CHAN_COUNT; k++)
+    block[k] = rand();
+
+  uint32_t t0 = get_reference_time();
+  for(int r = 0; r < REPS; r++)
+    for(int sb = 0; sb < subblocks; sb++)
+      deinterleave16(&block[sb * CHAN_COUNT]);
+  uint32_t t1 = get_reference_time();
+  for(int r = 0; r < REPS; r++)
+    deinterleave16_block(&block[0], subblocks);
+  uint32_t t2 = get_reference_time();
+
+  const unsigned per_call = (t1 - t0) / REPS;
+  const unsigned per_block = (t2 - t1) / REPS;
+
+  printf("\n    deinterleave16() x%u: %u ticks; deinterleave16_block(): %u ticks\n",
+      subblocks, per_call, per_block);
+
+  TEST_ASSERT_LESS_OR_EQUAL_UINT32(per_call, per_block);
+}
+
+
+// Must be the same as deinterleave16_then_map() with the direct channel map.
+TEST(deinterleave16, ddr)
+{
+  srand(0xDD816);
+
+  const unsigned direct_map[CHAN_COUNT] = 
+      {0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15};
+
+  uint64_t buff_ref_src[MAX_SUBBLOCKS * CHAN_COUNT / 2];
+  uint64_t buff_test_src[MAX_SUBBLOCKS * CHAN_COUNT / 2];
+  uint32_t* ref_src = (uint32_t*) &buff_ref_src[0];
+  uint32_t* test_src = (uint32_t*) &buff_test_src[0];
+  uint32_t expected[MAX_SUBBLOCKS * CHAN_COUNT + 1];
+  uint32_t test_vect[MAX_SUBBLOCKS * CHAN_COUNT + 1];
+
+  const unsigned LOOP_COUNT = 400;
+
+  for(int rep = 0; rep < LOOP_COUNT; rep++){
+
+    const unsigned subblocks = 1 + (rand() % MAX_SUBBLOCKS);
+    const unsigned words = subblocks * CHAN_COUNT;
+
+    for(int k = 0; k < words; k++)
+      ref_src[k] = test_src[k] = rand();
+    // Guard word past the end
+    test_vect[words] = expected[words] = 0x5A5A5A5A;
+
+    deinterleave16_then_map(expected, ref_src, subblocks, direct_map, CHAN_COUNT);
+    deinterleave16_ddr(test_vect, test_src, subblocks);
+
+    TEST_ASSERT_EQUAL_UINT32_ARRAY(expected, test_vect, words + 1);
+  }
+}
+
+
+// Times deinterleave16_ddr() against deinterleave16_then_map() with the direct
+// channel map, as StandardPdmRxService used for 16 mics, over a 6-subblock
+// block (decimation factor 192).
+TEST(deinterleave16, ddr_benchmark)
+{
+  const unsigned subblocks = 6;
+  const unsigned REPS = 100;
+
+  const unsigned direct_map[CHAN_COUNT] = 
+      {0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15};
+
+  uint64_t buff[MAX_SUBBLOCKS * CHAN_COUNT / 2];
+  uint32_t* block = (uint32_t*) &buff[0];
+  uint32_t out[MAX_SUBBLOCKS * CHAN_COUNT];
+  for(int k = 0; k < subblocks * CHAN_COUNT; k++)
+    block[k] = rand();
+
+  uint32_t t0 = get_reference_time();
+  for(int r = 0; r < REPS; r++)
+    deinterleave16_then_map(out, block, subblocks, direct_map, CHAN_COUNT);
+  uint32_t t1 = get_reference_time();
+  for(int r = 0; r < REPS; r++)
+    deinterleave16_ddr(out, block, subblocks);
+  uint32_t t2 = get_reference_time();
+
+  const unsigned per_map = (t1 - t0) / REPS;
+  const unsigned per_ddr = (t2 - t1) / REPS;
+
+  printf("\n    deinterleave16_then_map(): %u ticks; deinterleave16_ddr(): %u ticks\n",
+      per_map, per_ddr);
+
+  TEST_ASSERT_LESS_OR_EQUAL_UINT32(per_map, per_ddr);
+}
@@ -12,11 +12,15 @@
 
 #include "mic_array/util.h"
 
+#include <xcore/hwtimer.h>
+
 #define CHAN_COUNT    8
 
 TEST_GROUP_RUNNER(deinterleave8) {
   RUN_TEST_CASE(deinterleave8, case0);
   RUN_TEST_CASE(deinterleave8, case1);
+  RUN_TEST_CASE(deinterleave8, block);
+  RUN_TEST_CASE(deinterleave8, benchmark);
 }
 
 TEST_GROUP(deinterleave8);
@@ -123,4 +127,74 @@ TEST(deinterleave8, case1)
     // Check result
     TEST_ASSERT_EQUAL_UINT32_ARRAY_MESSAGE(expected, test_vect, CHAN_COUNT, "");
   }
-}
\ No newline at end of file
+}
+
+#define MAX_SUBBLOCKS   8
+
+// Must be the same as calling deinterleave8() on each subblock in turn.
+TEST(deinterleave8, block)
+{
+  srand(0x86E1B);
+
+  uint64_t buff_expected[MAX_SUBBLOCKS * CHAN_COUNT / 2 + 1];
+  uint64_t buff_test_vect[MAX_SUBBLOCKS * CHAN_COUNT / 2 + 1];
+  uint32_t* expected = (uint32_t*) &buff_expected[0];
+  uint32_t* test_vect = (uint32_t*) &buff_test_vect[0];
+
+  const unsigned LOOP_COUNT = 400;
+
+  for(int rep = 0; rep < LOOP_COUNT; rep++){
+
+    const unsigned subblocks = 1 + (rand() % MAX_SUBBLOCKS);
+    const unsigned words = subblocks * CHAN_COUNT;
+
+    for(int k = 0; k < words; k++)
+      expected[k] = test_vect[k] = rand();
+    // Guard word past the end
+    test_vect[words] = expected[words] = 0x5A5A5A5A;
+
+    for(int sb = 0; sb < subblocks; sb++)
+      deinterleave8(&expected[sb * CHAN_COUNT]);
+
+    deinterleave8_block(&test_vect[0], subblocks);
+
+    TEST_ASSERT_EQUAL_UINT32_ARRAY(expected, test_vect, words + 1);
+  }
+
+  // No subblocks is a no-op.
+  test_vect[0] = 0x12345678;
+  deinterleave8_block(&test_vect[0], 0);
+  TEST_ASSERT_EQUAL_HEX32(0x12345678, test_vect[0]);
+}
+
+
+// Times deinterleave8_block() against a deinterleave8() call per subblock,
+// as deinterleave_pdm_samples<8>() used to make, over a 6-subblock block
+// (decimation factor 192).
+TEST(deinterleave8, benchmark)
+{
+  const unsigned subblocks = 6;
+  const unsigned REPS = 100;
+
+  uint64_t buff[MAX_SUBBLOCKS * CHAN_COUNT / 2];
+  uint32_t* block = (uint32_t*) &buff[0];
+  for(int k = 0; k < subblocks * CHAN_COUNT; k++)
+    block[k] = rand();
+
+  uint32_t t0 = get_reference_time();
+  for(int r = 0; r < REPS; r++)
+    for(int sb = 0; sb < subblocks; sb++)
+      deinterleave8(&block[sb * CHAN_COUNT]);
+  uint32_t t1 = get_reference_time();
+  for(int r = 0; r < REPS; r++)
+    deinterleave8_block(&block[0], subblocks);
+  uint32_t t2 = get_reference_time();
+
+  const unsigned per_call = (t1 - t0) / REPS;
+  const unsigned per_block = (t2 - t1) / REPS;
+
+  printf("\n    deinterleave8() x%u: %u ticks; deinterleave8_block(): %u ticks\n",
+      subblocks, per_call, per_block);
+
+  TEST_ASSERT_LESS_OR_EQUAL_UINT32(per_call, per_block);
+}
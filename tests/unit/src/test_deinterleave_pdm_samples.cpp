@@ -28,6 +28,19 @@ TEST_GROUP_RUNNER(deinterleave_pdm_samples) {
   RUN_TEST_CASE(deinterleave_pdm_samples, chan8_sdf1);
   RUN_TEST_CASE(deinterleave_pdm_samples, chan8_sdf4);
   RUN_TEST_CASE(deinterleave_pdm_samples, chan8_sdf6);
+  RUN_TEST_CASE(deinterleave_pdm_samples, mapped_chan1_sdf3);
+  RUN_TEST_CASE(deinterleave_pdm_samples, mapped_chan2_sdf6);
+  RUN_TEST_CASE(deinterleave_pdm_samples, mapped_chan4_sdf4);
+  RUN_TEST_CASE(deinterleave_pdm_samples, mapped_chan8_sdf1);
+  RUN_TEST_CASE(deinterleave_pdm_samples, mapped_chan8_sdf6);
+  RUN_TEST_CASE(deinterleave_pdm_samples, mapped_chan16_sdf1);
+  RUN_TEST_CASE(deinterleave_pdm_samples, mapped_chan16_sdf6);
+  RUN_TEST_CASE(deinterleave_pdm_samples, direct_chan1_sdf3);
+  RUN_TEST_CASE(deinterleave_pdm_samples, direct_chan2_sdf6);
+  RUN_TEST_CASE(deinterleave_pdm_samples, direct_chan4_sdf4);
+  RUN_TEST_CASE(deinterleave_pdm_samples, direct_chan8_sdf6);
+  RUN_TEST_CASE(deinterleave_pdm_samples, direct_chan16_sdf1);
+  RUN_TEST_CASE(deinterleave_pdm_samples, direct_chan16_sdf6);
 }
 
 TEST_GROUP(deinterleave_pdm_samples);
@@ -195,4 +208,108 @@ TEST(deinterleave_pdm_samples, chan8_sdf6) { test_deinterleave_pdm_samples<8,6>(
 
 
 
-}
\ No newline at end of file
+}
+
+
+// Output channel ch must be all of input channel map[ch]'s samples, oldest
+// first, for any map of any length (including repeated input channels).
+template <unsigned CHAN_COUNT, unsigned BLOCKS>
+static
+void test_deinterleave_pdm_samples_mapped()
+{
+  uint32_t original[CHAN_COUNT][BLOCKS];
+  uint32_t expected[BLOCKS][CHAN_COUNT];
+  // Double-word aligned, as the PDM rx buffers are.
+  alignas(8) uint32_t test_vect[BLOCKS][CHAN_COUNT];
+  uint32_t out[CHAN_COUNT + 2][BLOCKS];
+  unsigned map[CHAN_COUNT + 2];
+
+  srand((CHAN_COUNT+31)*(BLOCKS*13)+0x2178);
+
+  static constexpr unsigned LOOP_COUNT = 400;
+
+  for(int r = 0; r < LOOP_COUNT; r++){
+
+    for(int c = 0; c < CHAN_COUNT; c++)
+      for(int b = 0; b < BLOCKS; b++)
+        original[c][b] = rand();
+
+    const unsigned channels_out = 1 + (rand() % (CHAN_COUNT + 2));
+    for(int k = 0; k < channels_out; k++)
+      map[k] = rand() % CHAN_COUNT;
+
+    interleave_pdm_samples<CHAN_COUNT,BLOCKS>(&test_vect[0][0], expected, original);
+
+    memset(out, 0xA5, sizeof(out));
+
+    mic_array::deinterleave_pdm_samples_mapped<CHAN_COUNT>(&out[0][0], 
+        &test_vect[0][0], BLOCKS, map, channels_out);
+
+    for(int k = 0; k < channels_out; k++)
+      TEST_ASSERT_EQUAL_UINT32_ARRAY(&original[map[k]][0], &out[0][0] + k*BLOCKS, 
+                                      BLOCKS);
+    // Nothing past the output block is touched.
+    for(int k = channels_out * BLOCKS; k < (CHAN_COUNT + 2) * BLOCKS; k++)
+      TEST_ASSERT_EQUAL_HEX32(0xA5A5A5A5, (&out[0][0])[k]);
+  }
+}
+
+extern "C" {
+
+TEST(deinterleave_pdm_samples, mapped_chan1_sdf3)  { test_deinterleave_pdm_samples_mapped<1,3>(); }
+TEST(deinterleave_pdm_samples, mapped_chan2_sdf6)  { test_deinterleave_pdm_samples_mapped<2,6>(); }
+TEST(deinterleave_pdm_samples, mapped_chan4_sdf4)  { test_deinterleave_pdm_samples_mapped<4,4>(); }
+TEST(deinterleave_pdm_samples, mapped_chan8_sdf1)  { test_deinterleave_pdm_samples_mapped<8,1>(); }
+TEST(deinterleave_pdm_samples, mapped_chan8_sdf6)  { test_deinterleave_pdm_samples_mapped<8,6>(); }
+TEST(deinterleave_pdm_samples, mapped_chan16_sdf1) { test_deinterleave_pdm_samples_mapped<16,1>(); }
+TEST(deinterleave_pdm_samples, mapped_chan16_sdf6) { test_deinterleave_pdm_samples_mapped<16,6>(); }
+
+}
+
+
+// Output channel ch must be all of input channel ch's samples, oldest first.
+template <unsigned CHAN_COUNT, unsigned BLOCKS>
+static
+void test_deinterleave_pdm_samples_direct()
+{
+  uint32_t original[CHAN_COUNT][BLOCKS];
+  uint32_t expected[BLOCKS][CHAN_COUNT];
+  // Double-word aligned, as the PDM rx buffers are.
+  alignas(8) uint32_t test_vect[BLOCKS][CHAN_COUNT];
+  uint32_t out[CHAN_COUNT + 1][BLOCKS];
+
+  srand((CHAN_COUNT+17)*(BLOCKS*11)+0xD1EC);
+
+  static constexpr unsigned LOOP_COUNT = 400;
+
+  for(int r = 0; r < LOOP_COUNT; r++){
+
+    for(int c = 0; c < CHAN_COUNT; c++)
+      for(int b = 0; b < BLOCKS; b++)
+        original[c][b] = rand();
+
+    interleave_pdm_samples<CHAN_COUNT,BLOCKS>(&test_vect[0][0], expected, original);
+
+    memset(out, 0xA5, sizeof(out));
+
+    mic_array::deinterleave_pdm_samples_direct<CHAN_COUNT>(&out[0][0], 
+        &test_vect[0][0], BLOCKS);
+
+    TEST_ASSERT_EQUAL_UINT32_ARRAY(&original[0][0], &out[0][0], 
+                                    CHAN_COUNT*BLOCKS);
+    // Nothing past the output block is touched.
+    for(int k = 0; k < BLOCKS; k++)
+      TEST_ASSERT_EQUAL_HEX32(0xA5A5A5A5, out[CHAN_COUNT][k]);
+  }
+}
+
+extern "C" {
+
+TEST(deinterleave_pdm_samples, direct_chan1_sdf3)  { test_deinterleave_pdm_samples_direct<1,3>(); }
+TEST(deinterleave_pdm_samples, direct_chan2_sdf6)  { test_deinterleave_pdm_samples_direct<2,6>(); }
+TEST(deinterleave_pdm_samples, direct_chan4_sdf4)  { test_deinterleave_pdm_samples_direct<4,4>(); }
+TEST(deinterleave_pdm_samples, direct_chan8_sdf6)  { test_deinterleave_pdm_samples_direct<8,6>(); }
+TEST(deinterleave_pdm_samples, direct_chan16_sdf1) { test_deinterleave_pdm_samples_direct<16,1>(); }
+TEST(deinterleave_pdm_samples, direct_chan16_sdf6) { test_deinterleave_pdm_samples_direct<16,6>(); }
+
+}
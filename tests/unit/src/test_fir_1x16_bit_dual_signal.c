@@ -0,0 +1,57 @@
+// Copyright 2020-2024 XMOS LIMITED.
+// This Software is subject to the terms of the XMOS Public Licence: Version 1.
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <assert.h>
+#include <stdarg.h>
+
+#include "unity_fixture.h"
+
+#include "mic_array/etc/fir_1x16_bit.h"
+
+#define SIGNAL_WORDS    8
+#define COEF_WORDS      128
+
+TEST_GROUP_RUNNER(fir_1x16_bit_dual_signal) {
+  RUN_TEST_CASE(fir_1x16_bit_dual_signal, dual_signal);
+}
+
+TEST_GROUP(fir_1x16_bit_dual_signal);
+TEST_SETUP(fir_1x16_bit_dual_signal) {}
+TEST_TEAR_DOWN(fir_1x16_bit_dual_signal) {}
+
+
+static
+void rand_words(uint32_t buff[], unsigned count)
+{
+  for(int k = 0; k < count; k++)
+    buff[k] = (((uint32_t) rand()) << 16) ^ ((uint32_t) rand());
+}
+
+
+TEST(fir_1x16_bit_dual_signal, dual_signal)
+{
+  srand(0x2F0D5573);
+
+  uint32_t signal_a[SIGNAL_WORDS];
+  uint32_t signal_b[SIGNAL_WORDS];
+  uint32_t coef[COEF_WORDS];
+
+  for(int r = 0; r < 200; r++){
+    rand_words(signal_a, SIGNAL_WORDS);
+    rand_words(signal_b, SIGNAL_WORDS);
+    rand_words(coef, COEF_WORDS);
+
+    int32_t expected[2];
+    expected[0] = fir_1x16_bit(signal_a, coef);
+    expected[1] = fir_1x16_bit(signal_b, coef);
+
+    int32_t result[2];
+    fir_1x16_bit_dual_signal(result, signal_a, signal_b, coef);
+
+    TEST_ASSERT_EQUAL_INT32_ARRAY(expected, result, 2);
+  }
+}
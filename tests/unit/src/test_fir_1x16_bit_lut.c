@@ -0,0 +1,102 @@
+// Copyright 2022-2024 XMOS LIMITED.
+// This Software is subject to the terms of the XMOS Public Licence: Version 1.
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <assert.h>
+#include <stdarg.h>
+
+#include "unity_fixture.h"
+
+#include "mic_array/etc/fir_1x16_bit.h"
+
+TEST_GROUP_RUNNER(fir_1x16_bit_lut) {
+  RUN_TEST_CASE(fir_1x16_bit_lut, coef_bits16);
+  RUN_TEST_CASE(fir_1x16_bit_lut, coef_bits12);
+  RUN_TEST_CASE(fir_1x16_bit_lut, coef_bits8);
+  RUN_TEST_CASE(fir_1x16_bit_lut, multi);
+}
+
+TEST_GROUP(fir_1x16_bit_lut);
+TEST_SETUP(fir_1x16_bit_lut) {}
+TEST_TEAR_DOWN(fir_1x16_bit_lut) {}
+
+
+static
+void rand_words(uint32_t buff[], unsigned count)
+{
+  for(int k = 0; k < count; k++)
+    buff[k] = (((uint32_t) rand()) << 16) ^ ((uint32_t) rand());
+}
+
+
+static uint32_t table[FIR_1X16_BIT_LUT_WORDS];
+
+typedef int (*fir_func_t)(uint32_t[], const uint32_t[]);
+
+// The table must reproduce the bit-plane kernel it was built for exactly.
+static
+void test_fir_1x16_bit_lut(fir_func_t func, unsigned coef_bits)
+{
+  srand(0x1A5D0000 + coef_bits);
+
+  uint32_t signal[8];
+  uint32_t coef[128];
+
+  for(int r = 0; r < 10; r++){
+    rand_words(coef, 8 * coef_bits);
+    fir_1x16_bit_lut_init(table, coef, coef_bits);
+
+    for(int s = 0; s < 20; s++){
+      rand_words(signal, 8);
+      TEST_ASSERT_EQUAL_INT32(func(signal, coef),
+                              fir_1x16_bit_lut(signal, table));
+    }
+
+    // Silence and full scale, at which the partial sums are largest
+    for(int k = 0; k < 8; k++) signal[k] = 0x55555555;
+    TEST_ASSERT_EQUAL_INT32(func(signal, coef), fir_1x16_bit_lut(signal, table));
+    for(int k = 0; k < 8; k++) signal[k] = 0x00000000;
+    TEST_ASSERT_EQUAL_INT32(func(signal, coef), fir_1x16_bit_lut(signal, table));
+    for(int k = 0; k < 8; k++) signal[k] = 0xFFFFFFFF;
+    TEST_ASSERT_EQUAL_INT32(func(signal, coef), fir_1x16_bit_lut(signal, table));
+  }
+}
+
+
+TEST(fir_1x16_bit_lut, coef_bits16) { test_fir_1x16_bit_lut(fir_1x16_bit, 16); }
+TEST(fir_1x16_bit_lut, coef_bits12) { test_fir_1x16_bit_lut(fir_1x12_bit, 12); }
+TEST(fir_1x16_bit_lut, coef_bits8)  { test_fir_1x16_bit_lut(fir_1x8_bit, 8);   }
+
+
+#define CHANNELS    19
+#define STRIDE      10
+
+TEST(fir_1x16_bit_lut, multi)
+{
+  srand(0x1A5E0000);
+
+  uint32_t signal[CHANNELS * STRIDE];
+  uint32_t coef[128];
+
+  for(int r = 0; r < 5; r++){
+    rand_words(signal, CHANNELS * STRIDE);
+    rand_words(coef, 128);
+    fir_1x16_bit_lut_init(table, coef, 16);
+
+    int32_t expected[CHANNELS+1];
+    int32_t result[CHANNELS+1];
+
+    for(int k = 0; k < CHANNELS; k++)
+      expected[k] = fir_1x16_bit(&signal[k * STRIDE], coef);
+
+    // Nothing may be written past out[count-1]
+    expected[CHANNELS] = result[CHANNELS] = 0x12345678;
+
+    fir_1x16_bit_lut_multi(signal, table, result, CHANNELS, STRIDE);
+
+    TEST_ASSERT_EQUAL_INT32_ARRAY(expected, result, CHANNELS+1);
+  }
+}
@@ -0,0 +1,76 @@
+// Copyright 2020-2024 XMOS LIMITED.
+// This Software is subject to the terms of the XMOS Public Licence: Version 1.
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <assert.h>
+#include <stdarg.h>
+
+#include "unity_fixture.h"
+
+#include "mic_array/etc/fir_1x16_bit.h"
+
+#define COEF_WORDS      128
+
+TEST_GROUP_RUNNER(fir_1x16_bit_multi) {
+  RUN_TEST_CASE(fir_1x16_bit_multi, count1);
+  RUN_TEST_CASE(fir_1x16_bit_multi, count3);
+  RUN_TEST_CASE(fir_1x16_bit_multi, count4);
+  RUN_TEST_CASE(fir_1x16_bit_multi, count7);
+  RUN_TEST_CASE(fir_1x16_bit_multi, count16);
+  RUN_TEST_CASE(fir_1x16_bit_multi, stride14);
+  RUN_TEST_CASE(fir_1x16_bit_multi, stride16);
+}
+
+TEST_GROUP(fir_1x16_bit_multi);
+TEST_SETUP(fir_1x16_bit_multi) {}
+TEST_TEAR_DOWN(fir_1x16_bit_multi) {}
+
+
+static
+void rand_words(uint32_t buff[], unsigned count)
+{
+  for(int k = 0; k < count; k++)
+    buff[k] = (((uint32_t) rand()) << 16) ^ ((uint32_t) rand());
+}
+
+
+#define MAX_STRIDE      16
+
+static
+void test_fir_1x16_bit_multi(unsigned count, unsigned stride)
+{
+  srand(0x5F1E0000 + 32 * count + stride);
+
+  uint32_t signal[FIR_1X16_BIT_MULTI_MAX_CHANNELS * MAX_STRIDE];
+  uint32_t coef[COEF_WORDS];
+
+  for(int r = 0; r < 100; r++){
+    rand_words(signal, count * stride);
+    rand_words(coef, COEF_WORDS);
+
+    int32_t expected[FIR_1X16_BIT_MULTI_MAX_CHANNELS+1];
+    int32_t result[FIR_1X16_BIT_MULTI_MAX_CHANNELS+1];
+
+    for(int k = 0; k < count; k++)
+      expected[k] = fir_1x16_bit(&signal[k * stride], coef);
+
+    // Nothing may be written past out[count-1]
+    expected[count] = result[count] = 0x12345678;
+
+    fir_1x16_bit_multi(signal, coef, result, count, stride);
+
+    TEST_ASSERT_EQUAL_INT32_ARRAY(expected, result, count+1);
+  }
+}
+
+
+TEST(fir_1x16_bit_multi, count1)  { test_fir_1x16_bit_multi(1,  8);  }
+TEST(fir_1x16_bit_multi, count3)  { test_fir_1x16_bit_multi(3,  8);  }
+TEST(fir_1x16_bit_multi, count4)  { test_fir_1x16_bit_multi(4,  8);  }
+TEST(fir_1x16_bit_multi, count7)  { test_fir_1x16_bit_multi(7,  8);  }
+TEST(fir_1x16_bit_multi, count16) { test_fir_1x16_bit_multi(16, 8);  }
+TEST(fir_1x16_bit_multi, stride14) { test_fir_1x16_bit_multi(6, 14); }
+TEST(fir_1x16_bit_multi, stride16) { test_fir_1x16_bit_multi(16, 16); }
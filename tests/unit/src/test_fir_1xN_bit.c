@@ -0,0 +1,116 @@
+// Copyright 2022-2024 XMOS LIMITED.
+// This Software is subject to the terms of the XMOS Public Licence: Version 1.
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <assert.h>
+#include <stdarg.h>
+
+#include "unity_fixture.h"
+
+#include "mic_array/etc/fir_1x16_bit.h"
+
+TEST_GROUP_RUNNER(fir_1xN_bit) {
+  RUN_TEST_CASE(fir_1xN_bit, fir_1x16_bit);
+  RUN_TEST_CASE(fir_1xN_bit, fir_1x12_bit);
+  RUN_TEST_CASE(fir_1xN_bit, fir_1x8_bit);
+  RUN_TEST_CASE(fir_1xN_bit, fir_1x12_bit_multi);
+  RUN_TEST_CASE(fir_1xN_bit, fir_1x8_bit_multi);
+}
+
+TEST_GROUP(fir_1xN_bit);
+TEST_SETUP(fir_1xN_bit) {}
+TEST_TEAR_DOWN(fir_1xN_bit) {}
+
+
+static
+void rand_words(uint32_t buff[], unsigned count)
+{
+  for(int k = 0; k < count; k++)
+    buff[k] = (((uint32_t) rand()) << 16) ^ ((uint32_t) rand());
+}
+
+
+// Inner product of the bipolar signal with the taps represented by `planes`
+// bit-planes of coefficients, one bit at a time, scaled as by fir_1x16_bit().
+static
+int32_t fir_expected(
+    const uint32_t signal[8],
+    const uint32_t coef[],
+    unsigned planes)
+{
+  int64_t acc = 0;
+  for(int p = 0; p < planes; p++){
+    const int32_t weight = (p == planes - 1)? ((1 << p) - 1) : (1 << p);
+    int32_t plane = 0;
+    for(int i = 0; i < 256; i++){
+      const int s = (signal[i / 32] >> (i % 32)) & 1;
+      const int c = (coef[8 * p + i / 32] >> (i % 32)) & 1;
+      plane += (1 - 2*s) * (1 - 2*c);
+    }
+    acc += weight * plane;
+  }
+  return (int32_t) (((uint32_t) (acc / 2)) << (24 - planes));
+}
+
+
+typedef int (*fir_func_t)(uint32_t[], const uint32_t[]);
+typedef void (*fir_multi_func_t)(const uint32_t[], const uint32_t[],
+                                 int32_t[], unsigned, unsigned);
+
+static
+void test_fir_1xN_bit(fir_func_t func, unsigned planes)
+{
+  srand(0x1A5B0000 + planes);
+
+  uint32_t signal[8];
+  uint32_t coef[128];
+
+  for(int r = 0; r < 100; r++){
+    rand_words(signal, 8);
+    rand_words(coef, 8 * planes);
+
+    TEST_ASSERT_EQUAL_INT32(fir_expected(signal, coef, planes),
+                            func(signal, coef));
+  }
+}
+
+
+#define CHANNELS    7
+#define STRIDE      10
+
+static
+void test_fir_1xN_bit_multi(fir_multi_func_t func, unsigned planes)
+{
+  srand(0x1A5C0000 + planes);
+
+  uint32_t signal[CHANNELS * STRIDE];
+  uint32_t coef[128];
+
+  for(int r = 0; r < 20; r++){
+    rand_words(signal, CHANNELS * STRIDE);
+    rand_words(coef, 8 * planes);
+
+    int32_t expected[CHANNELS+1];
+    int32_t result[CHANNELS+1];
+
+    for(int k = 0; k < CHANNELS; k++)
+      expected[k] = fir_expected(&signal[k * STRIDE], coef, planes);
+
+    // Nothing may be written past out[count-1]
+    expected[CHANNELS] = result[CHANNELS] = 0x12345678;
+
+    func(signal, coef, result, CHANNELS, STRIDE);
+
+    TEST_ASSERT_EQUAL_INT32_ARRAY(expected, result, CHANNELS+1);
+  }
+}
+
+
+TEST(fir_1xN_bit, fir_1x16_bit)       { test_fir_1xN_bit(fir_1x16_bit, 16); }
+TEST(fir_1xN_bit, fir_1x12_bit)       { test_fir_1xN_bit(fir_1x12_bit, 12); }
+TEST(fir_1xN_bit, fir_1x8_bit)        { test_fir_1xN_bit(fir_1x8_bit, 8);   }
+TEST(fir_1xN_bit, fir_1x12_bit_multi) { test_fir_1xN_bit_multi(fir_1x12_bit_multi, 12); }
+TEST(fir_1xN_bit, fir_1x8_bit_multi)  { test_fir_1xN_bit_multi(fir_1x8_bit_multi, 8);   }
@@ -0,0 +1,116 @@
+// Copyright 2020-2024 XMOS LIMITED.
+// This Software is subject to the terms of the XMOS Public Licence: Version 1.
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <assert.h>
+#include <stdarg.h>
+
+#include "unity_fixture.h"
+
+#include "xmath/xmath.h"
+#include "mic_array/etc/fir_s16_multi.h"
+
+TEST_GROUP_RUNNER(fir_s16_multi) {
+  RUN_TEST_CASE(fir_s16_multi, count1_taps16);
+  RUN_TEST_CASE(fir_s16_multi, count1_taps65);
+  RUN_TEST_CASE(fir_s16_multi, count2_taps65);
+  RUN_TEST_CASE(fir_s16_multi, count3_taps33);
+  RUN_TEST_CASE(fir_s16_multi, count8_taps65);
+  RUN_TEST_CASE(fir_s16_multi, count16_taps17);
+  RUN_TEST_CASE(fir_s16_multi, count21_taps65);
+  RUN_TEST_CASE(fir_s16_multi, stride_gap);
+  RUN_TEST_CASE(fir_s16_multi, saturation);
+}
+
+TEST_GROUP(fir_s16_multi);
+TEST_SETUP(fir_s16_multi) {}
+TEST_TEAR_DOWN(fir_s16_multi) {}
+
+
+static
+int16_t rand_s16(unsigned shr)
+{
+  return ((int16_t) rand()) >> shr;
+}
+
+
+#define MAX_CHANNELS    24
+#define MAX_TAPS        80
+#define MAX_STRIDE      (MAX_TAPS + 16)
+
+// With no accumulator saturating, each channel's output must be the exact
+// dot product of its history and the coefficients, shifted with rounding,
+// however the channels are spread over the vector lanes.
+static
+void test_fir_s16_multi(unsigned count, unsigned taps, unsigned stride)
+{
+  srand(0x16F10000 + 128 * count + taps + stride);
+
+  const unsigned tap_blocks = (taps + 15) / 16;
+
+  int16_t WORD_ALIGNED signal[MAX_CHANNELS * MAX_STRIDE];
+  int16_t WORD_ALIGNED coef[MAX_TAPS];
+
+  for(int r = 0; r < 40; r++){
+    // Small enough that no sum of up to MAX_TAPS products exceeds 31 bits
+    for(int k = 0; k < count * stride; k++)
+      signal[k] = rand_s16(4);
+
+    for(int k = 0; k < 16 * tap_blocks; k++)
+      coef[k] = (k < taps)? rand_s16(1) : 0;
+
+    right_shift_t shr = rand() % 6;
+
+    int32_t expected[MAX_CHANNELS+1];
+    int32_t result[MAX_CHANNELS+1];
+
+    for(int c = 0; c < count; c++){
+      int64_t acc = 0;
+      for(int k = 0; k < taps; k++)
+        acc += ((int32_t) coef[k]) * signal[c * stride + k];
+      if(shr > 0)
+        acc = (acc + (((int64_t) 1) << (shr - 1))) >> shr;
+      expected[c] = (int32_t) acc;
+    }
+
+    // Nothing may be written past out[count-1]
+    expected[count] = result[count] = 0x12345678;
+
+    fir_s16_multi(result, signal, coef, count, stride, tap_blocks, shr);
+
+    TEST_ASSERT_EQUAL_INT32_ARRAY(expected, result, count+1);
+  }
+}
+
+
+TEST(fir_s16_multi, count1_taps16)  { test_fir_s16_multi(1,  16, 16); }
+TEST(fir_s16_multi, count1_taps65)  { test_fir_s16_multi(1,  65, 80); }
+TEST(fir_s16_multi, count2_taps65)  { test_fir_s16_multi(2,  65, 80); }
+TEST(fir_s16_multi, count3_taps33)  { test_fir_s16_multi(3,  33, 48); }
+TEST(fir_s16_multi, count8_taps65)  { test_fir_s16_multi(8,  65, 80); }
+TEST(fir_s16_multi, count16_taps17) { test_fir_s16_multi(16, 17, 32); }
+TEST(fir_s16_multi, count21_taps65) { test_fir_s16_multi(21, 65, 80); }
+TEST(fir_s16_multi, stride_gap)     { test_fir_s16_multi(11, 65, 94); }
+
+
+// Full scale inputs saturate the accumulators, symmetrically.
+TEST(fir_s16_multi, saturation)
+{
+  int16_t WORD_ALIGNED signal[2 * 64];
+  int16_t WORD_ALIGNED coef[64];
+
+  for(int k = 0; k < 64; k++){
+    coef[k] = 0x7FFF;
+    signal[k] = 0x7FFF;
+    signal[64 + k] = -0x7FFF;
+  }
+
+  int32_t result[2];
+  fir_s16_multi(result, signal, coef, 2, 64, 4, 0);
+
+  TEST_ASSERT_EQUAL_INT32(INT32_MAX, result[0]);
+  TEST_ASSERT_EQUAL_INT32(-INT32_MAX, result[1]);
+}
@@ -0,0 +1,92 @@
+// Copyright 2020-2024 XMOS LIMITED.
+// This Software is subject to the terms of the XMOS Public Licence: Version 1.
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <assert.h>
+#include <stdarg.h>
+
+#include "unity_fixture.h"
+
+#include "xmath/xmath.h"
+#include "mic_array/etc/fir_s32_multi.h"
+
+TEST_GROUP_RUNNER(fir_s32_multi) {
+  RUN_TEST_CASE(fir_s32_multi, count1_taps8);
+  RUN_TEST_CASE(fir_s32_multi, count2_taps65);
+  RUN_TEST_CASE(fir_s32_multi, count5_taps17);
+  RUN_TEST_CASE(fir_s32_multi, count8_taps65);
+  RUN_TEST_CASE(fir_s32_multi, count13_taps33);
+  RUN_TEST_CASE(fir_s32_multi, stride_gap);
+}
+
+TEST_GROUP(fir_s32_multi);
+TEST_SETUP(fir_s32_multi) {}
+TEST_TEAR_DOWN(fir_s32_multi) {}
+
+
+static
+int32_t rand_s32(unsigned shr)
+{
+  return ((int32_t) ((((uint32_t) rand()) << 16) ^ ((uint32_t) rand()))) >> shr;
+}
+
+
+#define MAX_CHANNELS    16
+#define MAX_TAPS        72
+#define MAX_STRIDE      (MAX_TAPS + 8)
+
+// Each channel's output must match lib_xcore_math's filter_fir_s32() with
+// the same coefficients, shift and history.
+static
+void test_fir_s32_multi(unsigned count, unsigned taps, unsigned stride)
+{
+  srand(0x32F10000 + 128 * count + taps + stride);
+
+  const unsigned tap_blocks = (taps + 7) / 8;
+
+  int32_t WORD_ALIGNED signal[MAX_CHANNELS * MAX_STRIDE];
+  int32_t WORD_ALIGNED coef[MAX_TAPS];
+  int32_t state[MAX_TAPS];
+
+  for(int r = 0; r < 40; r++){
+    for(int k = 0; k < count * stride; k++)
+      signal[k] = rand_s32(1);
+
+    for(int k = 0; k < 8 * tap_blocks; k++)
+      coef[k] = (k < taps)? rand_s32(1) : 0;
+
+    right_shift_t shr = 3 + (rand() % 6);
+
+    int32_t expected[MAX_CHANNELS+1];
+    int32_t result[MAX_CHANNELS+1];
+
+    for(int c = 0; c < count; c++){
+      filter_fir_s32_t filter;
+      memset(state, 0, sizeof(state));
+      filter_fir_s32_init(&filter, state, taps, coef, shr);
+
+      const int32_t* hist = &signal[c * stride];
+      for(int k = taps-1; k > 0; k--)
+        filter_fir_s32_add_sample(&filter, hist[k]);
+      expected[c] = filter_fir_s32(&filter, hist[0]);
+    }
+
+    // Nothing may be written past out[count-1]
+    expected[count] = result[count] = 0x12345678;
+
+    fir_s32_multi(result, signal, coef, count, stride, tap_blocks, shr);
+
+    TEST_ASSERT_EQUAL_INT32_ARRAY(expected, result, count+1);
+  }
+}
+
+
+TEST(fir_s32_multi, count1_taps8)   { test_fir_s32_multi(1,  8,  8);  }
+TEST(fir_s32_multi, count2_taps65)  { test_fir_s32_multi(2,  65, 72); }
+TEST(fir_s32_multi, count5_taps17)  { test_fir_s32_multi(5,  17, 24); }
+TEST(fir_s32_multi, count8_taps65)  { test_fir_s32_multi(8,  65, 72); }
+TEST(fir_s32_multi, count13_taps33) { test_fir_s32_multi(13, 33, 40); }
+TEST(fir_s32_multi, stride_gap)     { test_fir_s32_multi(11, 65, 78); }
@@ -0,0 +1,296 @@
+// Copyright 2020-2024 XMOS LIMITED.
+// This Software is subject to the terms of the XMOS Public Licence: Version 1.
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <assert.h>
+#include <stdarg.h>
+
+#include <xcore/thread.h>
+#include <xcore/channel.h>
+#include <xcore/hwtimer.h>
+
+#include "unity_fixture.h"
+
+#include "mic_array/cpp/Decimator.hpp"
+#include "mic_array/cpp/Util.hpp"
+#include "mic_array/dc_elimination.h"
+#include "mic_array/frame_transfer.h"
+#include "mic_array/etc/fir_1x16_bit.h"
+#include "mic_array/etc/filters_default.h"
+
+/*
+  Performance guards for the kernels on the mic array's hot paths. Each test
+  times many calls of one kernel with the reference timer, prints the mean
+  time per call in reference ticks (10 ns), and fails if it exceeds the
+  kernel's ceiling.
+
+  The ceilings are macros so that a build can tighten (or, for a slower
+  configuration, loosen) them, e.g. by adding
+  `-DKERNEL_TIMING_MAX_FIR_1X16_BIT=40` to the unit tests' compiler flags.
+  The defaults are generous, so as only to catch gross regressions on a
+  tile with few threads busy. The times include the loop around the calls.
+*/
+
+#ifndef KERNEL_TIMING_REPS
+# define KERNEL_TIMING_REPS                       (1000)
+#endif
+
+#ifndef KERNEL_TIMING_MAX_FIR_1X16_BIT
+# define KERNEL_TIMING_MAX_FIR_1X16_BIT           (100)
+#endif
+
+#ifndef KERNEL_TIMING_MAX_SHIFT_BUFFER
+# define KERNEL_TIMING_MAX_SHIFT_BUFFER           (20)
+#endif
+
+// deinterleave_pdm_samples<N>() of a 6-subblock block, N up to 8
+#ifndef KERNEL_TIMING_MAX_DEINTERLEAVE
+# define KERNEL_TIMING_MAX_DEINTERLEAVE           (600)
+#endif
+
+// deinterleave_pdm_samples<16>() of a 6-subblock block
+#ifndef KERNEL_TIMING_MAX_DEINTERLEAVE16
+# define KERNEL_TIMING_MAX_DEINTERLEAVE16         (1200)
+#endif
+
+// dcoe_filter() of 8 channels
+#ifndef KERNEL_TIMING_MAX_DCOE_FILTER
+# define KERNEL_TIMING_MAX_DCOE_FILTER            (400)
+#endif
+
+// ma_frame_tx() and ma_frame_rx() of a 4 channel, 16 sample frame
+#ifndef KERNEL_TIMING_MAX_FRAME_TX_RX
+# define KERNEL_TIMING_MAX_FRAME_TX_RX            (1000)
+#endif
+
+// ma_frame_rx_transpose() of a 4 channel, 16 sample frame
+#ifndef KERNEL_TIMING_MAX_FRAME_RX_TRANSPOSE
+# define KERNEL_TIMING_MAX_FRAME_RX_TRANSPOSE     (1500)
+#endif
+
+
+extern "C" {
+
+TEST_GROUP_RUNNER(kernel_timing) {
+  RUN_TEST_CASE(kernel_timing, fir_1x16_bit);
+  RUN_TEST_CASE(kernel_timing, shift_buffer);
+  RUN_TEST_CASE(kernel_timing, deinterleave_pdm_samples_1);
+  RUN_TEST_CASE(kernel_timing, deinterleave_pdm_samples_2);
+  RUN_TEST_CASE(kernel_timing, deinterleave_pdm_samples_4);
+  RUN_TEST_CASE(kernel_timing, deinterleave_pdm_samples_8);
+  RUN_TEST_CASE(kernel_timing, deinterleave_pdm_samples_16);
+  RUN_TEST_CASE(kernel_timing, dcoe_filter);
+  RUN_TEST_CASE(kernel_timing, ma_frame_tx_rx);
+  RUN_TEST_CASE(kernel_timing, ma_frame_rx_transpose);
+}
+
+TEST_GROUP(kernel_timing);
+TEST_SETUP(kernel_timing) {}
+TEST_TEAR_DOWN(kernel_timing) {}
+
+}
+
+
+// Print and check the mean time per call of `reps` calls taking `ticks`.
+static
+void report(const char* kernel, uint32_t ticks, unsigned reps, unsigned max)
+{
+  const unsigned per_call = ticks / reps;
+  printf("\n    %s: %u ticks per call (ceiling %u)\n", kernel, per_call, max);
+  TEST_ASSERT_LESS_OR_EQUAL_UINT32(max, per_call);
+}
+
+
+extern "C" {
+
+TEST(kernel_timing, fir_1x16_bit)
+{
+  uint32_t WORD_ALIGNED signal[8];
+  for(int k = 0; k < 8; k++)
+    signal[k] = rand();
+
+  volatile int acc = 0;
+
+  const uint32_t t0 = get_reference_time();
+  for(int r = 0; r < KERNEL_TIMING_REPS; r++)
+    acc += fir_1x16_bit(signal, stage1_coef);
+  const uint32_t t1 = get_reference_time();
+
+  report("fir_1x16_bit()", t1 - t0, KERNEL_TIMING_REPS,
+         KERNEL_TIMING_MAX_FIR_1X16_BIT);
+}
+
+
+TEST(kernel_timing, shift_buffer)
+{
+  uint32_t WORD_ALIGNED buff[9];
+  for(int k = 0; k < 9; k++)
+    buff[k] = rand();
+
+  const uint32_t t0 = get_reference_time();
+  for(int r = 0; r < KERNEL_TIMING_REPS; r++)
+    mic_array::shift_buffer(&buff[1]);
+  const uint32_t t1 = get_reference_time();
+
+  report("shift_buffer()", t1 - t0, KERNEL_TIMING_REPS,
+         KERNEL_TIMING_MAX_SHIFT_BUFFER);
+}
+
+}
+
+
+template <unsigned MIC_COUNT>
+static
+void time_deinterleave_pdm_samples(unsigned max)
+{
+  constexpr unsigned S2_DEC_FACTOR = 6;
+
+  // Double-word aligned for the 16 channel kernels
+  uint64_t buff[MIC_COUNT * S2_DEC_FACTOR / 2 + 1];
+  uint32_t* samples = (uint32_t*) &buff[0];
+  for(int k = 0; k < MIC_COUNT * S2_DEC_FACTOR; k++)
+    samples[k] = rand();
+
+  const uint32_t t0 = get_reference_time();
+  for(int r = 0; r < KERNEL_TIMING_REPS; r++)
+    mic_array::deinterleave_pdm_samples<MIC_COUNT>(samples, S2_DEC_FACTOR);
+  const uint32_t t1 = get_reference_time();
+
+  char name[40];
+  snprintf(name, sizeof(name), "deinterleave_pdm_samples<%u>()", MIC_COUNT);
+  report(name, t1 - t0, KERNEL_TIMING_REPS, max);
+}
+
+
+extern "C" {
+
+TEST(kernel_timing, deinterleave_pdm_samples_1)
+{
+  time_deinterleave_pdm_samples<1>(KERNEL_TIMING_MAX_DEINTERLEAVE);
+}
+
+TEST(kernel_timing, deinterleave_pdm_samples_2)
+{
+  time_deinterleave_pdm_samples<2>(KERNEL_TIMING_MAX_DEINTERLEAVE);
+}
+
+TEST(kernel_timing, deinterleave_pdm_samples_4)
+{
+  time_deinterleave_pdm_samples<4>(KERNEL_TIMING_MAX_DEINTERLEAVE);
+}
+
+TEST(kernel_timing, deinterleave_pdm_samples_8)
+{
+  time_deinterleave_pdm_samples<8>(KERNEL_TIMING_MAX_DEINTERLEAVE);
+}
+
+TEST(kernel_timing, deinterleave_pdm_samples_16)
+{
+  time_deinterleave_pdm_samples<16>(KERNEL_TIMING_MAX_DEINTERLEAVE16);
+}
+
+
+TEST(kernel_timing, dcoe_filter)
+{
+  constexpr unsigned CHANS = 8;
+
+  dcoe_chan_state_t state[CHANS];
+  dcoe_state_init(state, CHANS);
+
+  int32_t input[CHANS];
+  int32_t output[CHANS];
+  for(int k = 0; k < CHANS; k++)
+    input[k] = rand();
+
+  const uint32_t t0 = get_reference_time();
+  for(int r = 0; r < KERNEL_TIMING_REPS; r++)
+    dcoe_filter(output, state, input, CHANS);
+  const uint32_t t1 = get_reference_time();
+
+  report("dcoe_filter() x8", t1 - t0, KERNEL_TIMING_REPS,
+         KERNEL_TIMING_MAX_DCOE_FILTER);
+}
+
+}
+
+
+// Frames are timed on both sides of the channel, with the transmitter on
+// its own thread. Each transfer is synchronised, so both sides see the time
+// of a whole transfer.
+#define FRAME_CHANS     4
+#define FRAME_SAMPLES   16
+#define FRAME_REPS      (KERNEL_TIMING_REPS / 10)
+
+static struct {
+  channel_t c_frames;
+  uint32_t tx_ticks;
+} timing_ctx;
+
+static unsigned tx_stack[2000];
+
+static
+void timed_frame_tx(void* vframe)
+{
+  const int32_t* frame = (const int32_t*) vframe;
+
+  const uint32_t t0 = get_reference_time();
+  for(int r = 0; r < FRAME_REPS; r++)
+    ma_frame_tx(timing_ctx.c_frames.end_a, frame, FRAME_CHANS, FRAME_SAMPLES);
+  timing_ctx.tx_ticks = get_reference_time() - t0;
+
+  // Tell the receiver the time has been recorded.
+  chan_out_word(timing_ctx.c_frames.end_a, 0);
+}
+
+
+extern "C" {
+
+TEST(kernel_timing, ma_frame_tx_rx)
+{
+  static int32_t tx_frame[FRAME_CHANS][FRAME_SAMPLES];
+  int32_t rx_frame[FRAME_CHANS][FRAME_SAMPLES];
+
+  timing_ctx.c_frames = chan_alloc();
+  run_async(timed_frame_tx, &tx_frame[0][0], stack_base(tx_stack, 2000));
+
+  const uint32_t t0 = get_reference_time();
+  for(int r = 0; r < FRAME_REPS; r++)
+    ma_frame_rx(&rx_frame[0][0], timing_ctx.c_frames.end_b,
+                FRAME_CHANS, FRAME_SAMPLES);
+  const uint32_t t1 = get_reference_time();
+
+  (void) chan_in_word(timing_ctx.c_frames.end_b);
+  chan_free(timing_ctx.c_frames);
+
+  report("ma_frame_tx() 4x16", timing_ctx.tx_ticks, FRAME_REPS,
+         KERNEL_TIMING_MAX_FRAME_TX_RX);
+  report("ma_frame_rx() 4x16", t1 - t0, FRAME_REPS,
+         KERNEL_TIMING_MAX_FRAME_TX_RX);
+}
+
+
+TEST(kernel_timing, ma_frame_rx_transpose)
+{
+  static int32_t tx_frame[FRAME_CHANS][FRAME_SAMPLES];
+  int32_t rx_frame[FRAME_SAMPLES][FRAME_CHANS];
+
+  timing_ctx.c_frames = chan_alloc();
+  run_async(timed_frame_tx, &tx_frame[0][0], stack_base(tx_stack, 2000));
+
+  const uint32_t t0 = get_reference_time();
+  for(int r = 0; r < FRAME_REPS; r++)
+    ma_frame_rx_transpose(&rx_frame[0][0], timing_ctx.c_frames.end_b,
+                          FRAME_CHANS, FRAME_SAMPLES);
+  const uint32_t t1 = get_reference_time();
+
+  (void) chan_in_word(timing_ctx.c_frames.end_b);
+  chan_free(timing_ctx.c_frames);
+
+  report("ma_frame_rx_transpose() 4x16", t1 - t0, FRAME_REPS,
+         KERNEL_TIMING_MAX_FRAME_RX_TRANSPOSE);
+}
+
+}
@@ -38,6 +38,8 @@ extern "C" {
     RUN_TEST_CASE(ma_frame_tx_rx, case_4chan_16samp);
     RUN_TEST_CASE(ma_frame_tx_rx, case_4chan_256samp);
     RUN_TEST_CASE(ma_frame_tx_rx, case_4chan_1024samp);
+
+    RUN_TEST_CASE(ma_frame_tx_rx, stamped_4chan_16samp);
   }
 
   TEST_GROUP(ma_frame_tx_rx);
@@ -108,4 +110,49 @@ extern "C" {
   TEST(ma_frame_tx_rx, case_4chan_256samp)   { test_ma_frame_tx_rx<4,256>();  }
   TEST(ma_frame_tx_rx, case_4chan_1024samp)  { test_ma_frame_tx_rx<4,1024>(); }
 
-}
\ No newline at end of file
+}
+
+
+static ma_frame_header_t tx_header;
+
+template <unsigned CHANS, unsigned SAMPLE_COUNT>
+static void send_stamped_frame(void* vframe)
+{
+  int32_t* frame = (int32_t*) vframe;
+
+  ma_frame_tx_stamped(rx_ctx.c_frames.end_a, &tx_header, frame, CHANS, SAMPLE_COUNT);
+}
+
+extern "C" {
+
+  TEST(ma_frame_tx_rx, stamped_4chan_16samp)
+  {
+    constexpr unsigned CHANS = 4;
+    constexpr unsigned SAMPLE_COUNT = 16;
+
+    srand(5527);
+
+    for(int r = 0; r < 100; r++){
+      int32_t exp_frame[CHANS][SAMPLE_COUNT];
+
+      for(int c = 0; c < CHANS; c++)
+        for(int s = 0; s < SAMPLE_COUNT; s++)
+          exp_frame[c][s] = rand();
+
+      tx_header.sample_index = rand();
+      tx_header.timestamp = rand();
+
+      run_async( send_stamped_frame<CHANS,SAMPLE_COUNT>, &exp_frame[0][0], stack_start);
+
+      ma_frame_header_t header;
+      int32_t received[CHANS][SAMPLE_COUNT];
+
+      ma_frame_rx_stamped(&header, &received[0][0], rx_ctx.c_frames.end_b, CHANS, SAMPLE_COUNT);
+
+      TEST_ASSERT_EQUAL_UINT32(tx_header.sample_index, header.sample_index);
+      TEST_ASSERT_EQUAL_UINT32(tx_header.timestamp, header.timestamp);
+      TEST_ASSERT_EQUAL_INT32_ARRAY(&exp_frame[0][0], &received[0][0], CHANS * SAMPLE_COUNT);
+    }
+  }
+
+}
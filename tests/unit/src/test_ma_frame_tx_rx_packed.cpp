@@ -0,0 +1,216 @@
+// Copyright 2020-2024 XMOS LIMITED.
+// This Software is subject to the terms of the XMOS Public Licence: Version 1.
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <assert.h>
+#include <stdarg.h>
+
+#include <xcore/thread.h>
+#include <xcore/channel.h>
+#include <xcore/channel_transaction.h>
+
+#include "unity_fixture.h"
+
+#include "mic_array/frame_transfer.h"
+
+extern "C" {
+
+  static
+  struct {
+    channel_t c_frames;
+  } rx_ctx;
+
+  TEST_GROUP_RUNNER(ma_frame_tx_rx_packed) {
+    RUN_TEST_CASE(ma_frame_tx_rx_packed, s32_to_s16);
+    RUN_TEST_CASE(ma_frame_tx_rx_packed, s32_to_s16_unaligned);
+    RUN_TEST_CASE(ma_frame_tx_rx_packed, s32_to_s24);
+    RUN_TEST_CASE(ma_frame_tx_rx_packed, s32_to_f32);
+
+    RUN_TEST_CASE(ma_frame_tx_rx_packed, s16_1chan_1samp);
+    RUN_TEST_CASE(ma_frame_tx_rx_packed, s16_3chan_5samp);
+    RUN_TEST_CASE(ma_frame_tx_rx_packed, s16_4chan_256samp);
+    RUN_TEST_CASE(ma_frame_tx_rx_packed, s24_1chan_1samp);
+    RUN_TEST_CASE(ma_frame_tx_rx_packed, s24_3chan_5samp);
+    RUN_TEST_CASE(ma_frame_tx_rx_packed, s24_4chan_256samp);
+    RUN_TEST_CASE(ma_frame_tx_rx_packed, f32_1chan_1samp);
+    RUN_TEST_CASE(ma_frame_tx_rx_packed, f32_3chan_5samp);
+  }
+
+  TEST_GROUP(ma_frame_tx_rx_packed);
+
+  TEST_SETUP(ma_frame_tx_rx_packed) {
+    rx_ctx.c_frames = chan_alloc();
+  }
+
+  TEST_TEAR_DOWN(ma_frame_tx_rx_packed) {
+    chan_free(rx_ctx.c_frames);
+  }
+
+
+  static unsigned stack[8000];
+  static void* stack_start = stack_base(stack, 8000);
+
+}
+
+
+static int32_t expected_s16(int32_t v)
+{
+  int64_t r = (((int64_t) v) + 0x8000) >> 16;
+  return (r > 0x7FFF)? 0x7FFF : r;
+}
+
+static int32_t expected_s24(int32_t v)
+{
+  int64_t r = (((int64_t) v) + 0x80) >> 8;
+  return (r > 0x7FFFFF)? 0x7FFFFF : r;
+}
+
+static int32_t unpack_s24(const uint8_t* p)
+{
+  // Sign extend from bit 23
+  return ((int32_t) ((uint32_t(p[0]) << 8) | (uint32_t(p[1]) << 16) 
+                                           | (uint32_t(p[2]) << 24))) >> 8;
+}
+
+static const int32_t edge_cases[] = {
+  INT32_MAX, INT32_MAX - 0x7FFF, 0x7FFF8000, 0x7FFF7FFF, 0x7FFFFF80, 
+  0x7FFFFF7F, INT32_MIN, INT32_MIN + 1, 0, 1, -1, 0x8000, -0x8000, 0x7FFF, 
+  -0x8001, 0x80, -0x80, -0x81, 0x12345678, -0x12345678,
+};
+static constexpr unsigned EDGE_COUNT = sizeof(edge_cases)/sizeof(int32_t);
+
+
+extern "C" {
+
+  TEST(ma_frame_tx_rx_packed, s32_to_s16)
+  {
+    int32_t src[EDGE_COUNT];
+    int16_t dst[EDGE_COUNT + 1];
+    memcpy(src, edge_cases, sizeof(src));
+
+    ma_s32_to_s16(dst, src, EDGE_COUNT);
+
+    for(int k = 0; k < EDGE_COUNT; k++)
+      TEST_ASSERT_EQUAL_INT32(expected_s16(src[k]), dst[k]);
+  }
+
+  TEST(ma_frame_tx_rx_packed, s32_to_s16_unaligned)
+  {
+    int32_t src[EDGE_COUNT];
+    int16_t dst[EDGE_COUNT + 1];
+    memcpy(src, edge_cases, sizeof(src));
+
+    // dst not word-aligned, so the scalar path must give the same results
+    ma_s32_to_s16(&dst[1], src, EDGE_COUNT);
+
+    for(int k = 0; k < EDGE_COUNT; k++)
+      TEST_ASSERT_EQUAL_INT32(expected_s16(src[k]), dst[k+1]);
+  }
+
+  TEST(ma_frame_tx_rx_packed, s32_to_s24)
+  {
+    int32_t src[EDGE_COUNT];
+    uint8_t dst[3*EDGE_COUNT + 1];
+    memcpy(src, edge_cases, sizeof(src));
+
+    dst[3*EDGE_COUNT] = 0xA5;
+
+    ma_s32_to_s24(dst, src, EDGE_COUNT);
+
+    for(int k = 0; k < EDGE_COUNT; k++)
+      TEST_ASSERT_EQUAL_INT32(expected_s24(src[k]), unpack_s24(&dst[3*k]));
+
+    TEST_ASSERT_EQUAL_UINT8(0xA5, dst[3*EDGE_COUNT]);
+  }
+
+  TEST(ma_frame_tx_rx_packed, s32_to_f32)
+  {
+    int32_t src[EDGE_COUNT];
+    float dst[EDGE_COUNT + 1];
+    memcpy(src, edge_cases, sizeof(src));
+
+    dst[EDGE_COUNT] = 0.5f;
+
+    // A power of 2, so the only rounding is that of the conversion
+    ma_s32_to_f32(dst, src, EDGE_COUNT, 1.0f / 0x8000);
+
+    for(int k = 0; k < EDGE_COUNT; k++)
+      TEST_ASSERT_TRUE(dst[k] == ((float) src[k]) / 0x8000);
+
+    TEST_ASSERT_TRUE(dst[EDGE_COUNT] == 0.5f);
+
+    // Full scale maps to 1.0, to within rounding
+    const int32_t full_scale = 857718499;
+    ma_s32_to_f32(dst, &full_scale, 1, 1.0f / full_scale);
+    TEST_ASSERT_TRUE(dst[0] > 0.9999999f && dst[0] < 1.0000001f);
+  }
+
+}
+
+
+template <unsigned BYTES, unsigned CHANS, unsigned SAMPLE_COUNT>
+static void send_frame(void* vframe)
+{
+  if(BYTES == 2)
+    ma_frame_tx_s16(rx_ctx.c_frames.end_a, (int16_t*) vframe, CHANS, SAMPLE_COUNT);
+  else if(BYTES == 3)
+    ma_frame_tx_s24(rx_ctx.c_frames.end_a, (uint8_t*) vframe, CHANS, SAMPLE_COUNT);
+  else
+    ma_frame_tx_f32(rx_ctx.c_frames.end_a, (float*) vframe, CHANS, SAMPLE_COUNT);
+}
+
+
+// The packed frame sizes need not be a whole number of words, so odd shapes
+// check the trailing bytes are transferred, and nothing past the frame is 
+// written. A BYTES of 4 is a float frame.
+template <unsigned BYTES, unsigned CHANS, unsigned SAMPLE_COUNT>
+static
+void test_ma_frame_tx_rx_packed()
+{
+  srand(5641*CHANS + SAMPLE_COUNT + BYTES);
+
+  constexpr unsigned FRAME_BYTES = BYTES * CHANS * SAMPLE_COUNT;
+  constexpr unsigned LOOP_COUNT = 100;
+
+  for(int r = 0; r < LOOP_COUNT; r++){
+    uint32_t tx_buff[(FRAME_BYTES+3)/4];
+    uint8_t* exp_frame = (uint8_t*) tx_buff;
+
+    for(int k = 0; k < FRAME_BYTES; k++)
+      exp_frame[k] = rand();
+
+    run_async( send_frame<BYTES,CHANS,SAMPLE_COUNT>, exp_frame, stack_start);
+
+    uint32_t rx_buff[(FRAME_BYTES+3)/4 + 1];
+    memset(rx_buff, 0x5A, sizeof(rx_buff));
+    uint8_t* received = (uint8_t*) rx_buff;
+
+    if(BYTES == 2)
+      ma_frame_rx_s16((int16_t*) received, rx_ctx.c_frames.end_b, CHANS, SAMPLE_COUNT);
+    else if(BYTES == 3)
+      ma_frame_rx_s24(received, rx_ctx.c_frames.end_b, CHANS, SAMPLE_COUNT);
+    else
+      ma_frame_rx_f32((float*) received, rx_ctx.c_frames.end_b, CHANS, SAMPLE_COUNT);
+
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(exp_frame, received, FRAME_BYTES);
+
+    for(int k = FRAME_BYTES; k < sizeof(rx_buff); k++)
+      TEST_ASSERT_EQUAL_UINT8(0x5A, received[k]);
+  }
+}
+
+extern "C" {
+
+  TEST(ma_frame_tx_rx_packed, s16_1chan_1samp)   { test_ma_frame_tx_rx_packed<2,1,1>();   }
+  TEST(ma_frame_tx_rx_packed, s16_3chan_5samp)   { test_ma_frame_tx_rx_packed<2,3,5>();   }
+  TEST(ma_frame_tx_rx_packed, s16_4chan_256samp) { test_ma_frame_tx_rx_packed<2,4,256>(); }
+  TEST(ma_frame_tx_rx_packed, s24_1chan_1samp)   { test_ma_frame_tx_rx_packed<3,1,1>();   }
+  TEST(ma_frame_tx_rx_packed, s24_3chan_5samp)   { test_ma_frame_tx_rx_packed<3,3,5>();   }
+  TEST(ma_frame_tx_rx_packed, s24_4chan_256samp) { test_ma_frame_tx_rx_packed<3,4,256>(); }
+  TEST(ma_frame_tx_rx_packed, f32_1chan_1samp)   { test_ma_frame_tx_rx_packed<4,1,1>();   }
+  TEST(ma_frame_tx_rx_packed, f32_3chan_5samp)   { test_ma_frame_tx_rx_packed<4,3,5>();   }
+
+}
@@ -0,0 +1,190 @@
+// Copyright 2020-2024 XMOS LIMITED.
+// This Software is subject to the terms of the XMOS Public Licence: Version 1.
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <assert.h>
+#include <stdarg.h>
+
+#include <xcore/channel_streaming.h>
+#include <xcore/interrupt.h>
+#include <xcore/triggerable.h>
+
+#include "unity_fixture.h"
+
+#include "mic_array.h"
+
+extern "C" {
+
+TEST_GROUP_RUNNER(pdm_rx_isr_dual) {
+  RUN_TEST_CASE(pdm_rx_isr_dual, block_words_1);
+  RUN_TEST_CASE(pdm_rx_isr_dual, block_words_2);
+  RUN_TEST_CASE(pdm_rx_isr_dual, block_words_8);
+  RUN_TEST_CASE(pdm_rx_isr_dual, block_words_32);
+  RUN_TEST_CASE(pdm_rx_isr_dual, dropped_blocks);
+}
+
+TEST_GROUP(pdm_rx_isr_dual);
+TEST_SETUP(pdm_rx_isr_dual) {}
+TEST_TEAR_DOWN(pdm_rx_isr_dual) {}
+
+}
+
+
+#define MAX_BLOCK_WORDS   (32)
+#define BLOCK_COUNT       (6)
+
+
+typedef void (*enable_isr_t)(const port_t);
+
+// What an ISR did with the words it was given.
+typedef struct {
+  // Each block sent on c_pdm_data, as the ISR left it.
+  uint32_t blocks[BLOCK_COUNT][MAX_BLOCK_WORDS];
+  // Index of the buffer each block was sent in.
+  unsigned buffer[BLOCK_COUNT];
+  // Both buffers once all blocks were captured.
+  uint32_t buffers[2][MAX_BLOCK_WORDS];
+  // The context once all blocks were captured; the times are not compared.
+  pdm_rx_isr_context_t context;
+} isr_result_t;
+
+
+/*
+  A streaming chanend stands in for the PDM port, as in the signal tests and
+  the benchmark. The words are sent to it from this thread, and the ISR
+  interrupts it to read each of them. If `credit` is non-zero every block is
+  read back from c_pdm_data before the words of the next are sent, so the
+  ISR never has more than one block in the channel.
+*/
+static
+void run_isr(
+    enable_isr_t enable_isr,
+    const unsigned block_words,
+    const unsigned credit,
+    const uint32_t words[BLOCK_COUNT][MAX_BLOCK_WORDS],
+    isr_result_t* result)
+{
+  static uint32_t buffers[2][MAX_BLOCK_WORDS];
+  memset(buffers, 0, sizeof(buffers));
+  memset(result, 0, sizeof(isr_result_t));
+
+  streaming_channel_t c_port = s_chan_alloc();
+  streaming_channel_t c_blocks = s_chan_alloc();
+
+  pdm_rx_isr_context.p_pdm_mics = (port_t) c_port.end_b;
+  pdm_rx_isr_context.pdm_buffer[0] = &buffers[0][0];
+  pdm_rx_isr_context.pdm_buffer[1] = &buffers[1][0];
+  pdm_rx_isr_context.phase_reset = block_words - 1;
+  pdm_rx_isr_context.phase = block_words - 1;
+  pdm_rx_isr_context.c_pdm_data = c_blocks.end_a;
+  pdm_rx_isr_context.credit = credit;
+  pdm_rx_isr_context.missed_blocks = 0;
+  pdm_rx_isr_context.dropped_blocks = 0;
+  pdm_rx_isr_context.min_credit = credit;
+  pdm_rx_isr_context.sent = 0;
+  pdm_rx_isr_context.captured = 0;
+  pdm_rx_isr_context.block_index[0] = 0;
+  pdm_rx_isr_context.block_index[1] = 0;
+
+  enable_isr((port_t) c_port.end_b);
+  interrupt_unmask_all();
+
+  for(int b = 0; b < BLOCK_COUNT; b++){
+    for(int k = 0; k < block_words; k++)
+      s_chan_out_word(c_port.end_a, words[b][k]);
+
+    if(credit){
+      uint32_t* block = (uint32_t*) s_chan_in_word(c_blocks.end_b);
+      result->buffer[b] = (block == &buffers[0][0])? 0 : 1;
+      memcpy(result->blocks[b], block, block_words * sizeof(uint32_t));
+    }
+  }
+
+  // Nothing is sent while dropping blocks, so wait for the last to be counted.
+  while(((volatile unsigned*) &pdm_rx_isr_context.captured)[0] != BLOCK_COUNT);
+
+  interrupt_mask_all();
+  triggerable_disable_trigger(c_port.end_b);
+  s_chan_free(c_port);
+  s_chan_free(c_blocks);
+
+  memcpy(result->buffers, buffers, sizeof(buffers));
+  result->context = pdm_rx_isr_context;
+}
+
+
+static
+void test_pdm_rx_isr_dual(
+    const unsigned block_words,
+    const unsigned credit,
+    const unsigned seed)
+{
+  assert(block_words <= MAX_BLOCK_WORDS);
+
+  static uint32_t words[BLOCK_COUNT][MAX_BLOCK_WORDS];
+  static isr_result_t expected;
+  static isr_result_t actual;
+
+  srand(seed);
+  for(int b = 0; b < BLOCK_COUNT; b++)
+    for(int k = 0; k < block_words; k++)
+      words[b][k] = (((uint32_t) rand()) << 16) ^ ((uint32_t) rand());
+
+  run_isr(enable_pdm_rx_isr, block_words, credit, words, &expected);
+  run_isr(enable_pdm_rx_isr_dual, block_words, credit, words, &actual);
+
+  // Check the reference, so that a broken run can't pass by matching another.
+  for(int b = 0; b < BLOCK_COUNT && credit; b++){
+    TEST_ASSERT_EQUAL_UINT(b % 2, expected.buffer[b]);
+    for(int k = 0; k < block_words; k++)
+      TEST_ASSERT_EQUAL_HEX32(words[b][block_words - 1 - k],
+                              expected.blocks[b][k]);
+  }
+  TEST_ASSERT_EQUAL_UINT(BLOCK_COUNT, expected.context.captured);
+
+  for(int b = 0; b < BLOCK_COUNT; b++){
+    TEST_ASSERT_EQUAL_UINT(expected.buffer[b], actual.buffer[b]);
+    TEST_ASSERT_EQUAL_HEX32_ARRAY(expected.blocks[b], actual.blocks[b],
+                                  MAX_BLOCK_WORDS);
+  }
+  TEST_ASSERT_EQUAL_HEX32_ARRAY(&expected.buffers[0][0], &actual.buffers[0][0],
+                                2 * MAX_BLOCK_WORDS);
+
+  const pdm_rx_isr_context_t& exp = expected.context;
+  const pdm_rx_isr_context_t& act = actual.context;
+
+  TEST_ASSERT_EQUAL_UINT(exp.phase, act.phase);
+  TEST_ASSERT_EQUAL_UINT(exp.credit, act.credit);
+  TEST_ASSERT_EQUAL_UINT(exp.missed_blocks, act.missed_blocks);
+  TEST_ASSERT_EQUAL_UINT(exp.dropped_blocks, act.dropped_blocks);
+  TEST_ASSERT_EQUAL_UINT(exp.min_credit, act.min_credit);
+  TEST_ASSERT_EQUAL_UINT(exp.sent, act.sent);
+  TEST_ASSERT_EQUAL_UINT(exp.captured, act.captured);
+  TEST_ASSERT_EQUAL_UINT(exp.block_index[0], act.block_index[0]);
+  TEST_ASSERT_EQUAL_UINT(exp.block_index[1], act.block_index[1]);
+  // Buffers are swapped whether a block is sent or dropped.
+  TEST_ASSERT_EQUAL_PTR(exp.pdm_buffer[0], act.pdm_buffer[0]);
+  TEST_ASSERT_EQUAL_PTR(exp.pdm_buffer[1], act.pdm_buffer[1]);
+}
+
+
+extern "C" {
+
+TEST(pdm_rx_isr_dual, block_words_1)   { test_pdm_rx_isr_dual(1, BLOCK_COUNT, 5171); }
+TEST(pdm_rx_isr_dual, block_words_2)   { test_pdm_rx_isr_dual(2, BLOCK_COUNT, 5172); }
+TEST(pdm_rx_isr_dual, block_words_8)   { test_pdm_rx_isr_dual(8, BLOCK_COUNT, 5173); }
+TEST(pdm_rx_isr_dual, block_words_32)  { test_pdm_rx_isr_dual(32, BLOCK_COUNT, 5174); }
+
+// With no credit and missed_blocks not -1, every block is quietly dropped.
+TEST(pdm_rx_isr_dual, dropped_blocks)
+{
+  test_pdm_rx_isr_dual(8, 0, 5175);
+  TEST_ASSERT_EQUAL_UINT(BLOCK_COUNT, pdm_rx_isr_context.dropped_blocks);
+  TEST_ASSERT_EQUAL_UINT(BLOCK_COUNT, pdm_rx_isr_context.missed_blocks);
+  TEST_ASSERT_EQUAL_UINT(0, pdm_rx_isr_context.sent);
+}
+
+}